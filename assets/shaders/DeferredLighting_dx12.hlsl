@@ -81,6 +81,11 @@ struct GPULight
 
 StructuredBuffer<GPULight> gLights : register(t16);
 
+// Clustered light lists (CPU-built, see ClusteredLightBuilder): per-cluster { offset, count } into
+// gClusterLightIndices, whose first uClusterGrid.w entries are lights that reach every pixel.
+StructuredBuffer<uint2> gClusterRanges : register(t20);
+StructuredBuffer<uint> gClusterLightIndices : register(t21);
+
 // -----------------------------------------------------------------------------
 // Constants
 // -----------------------------------------------------------------------------
@@ -91,6 +96,8 @@ cbuffer Deferred : register(b0)
     float4 uCameraForward;    // xyz + pad
     float4 uShadowBias;       // x=dirBaseBiasTexels, y=spotBaseBiasTexels, z=pointBaseBiasTexels, w=slopeScaleTexels
     float4 uCounts;           // x=lightCount, y=spotShadowCount, z=pointShadowCount, w=activeReflectionProbeCount
+    float4 uClusterGrid;      // xyz=cluster grid size (0 = no clusters, loop over all lights), w=global light count
+    float4 uClusterSlices;    // x=slice scale, y=slice bias: slice = log2(viewDepth) * x + y
 }
 
 // -----------------------------------------------------------------------------
@@ -632,11 +639,28 @@ float4 PS_DeferredLighting(VSOut IN) : SV_Target0
     const float viewDist = max(0.0f, dot(worldPos - camPos, uCameraForward.xyz));
     const uint lightCount = (uint)uCounts.x;
 
+    // Light list of this pixel: all lights, or the global prefix followed by the pixel's cluster list.
+    const bool clustered = uClusterGrid.x > 0.0f;
+    uint globalCount = lightCount;
+    uint2 clusterRange = uint2(0u, 0u);
+    if (clustered)
+    {
+        const uint3 grid = (uint3)uClusterGrid.xyz;
+        const uint2 tile = min((uint2)(IN.uv * float2(grid.xy)), grid.xy - 1u);
+        const float slice = floor(log2(max(viewDist, 1e-4f)) * uClusterSlices.x + uClusterSlices.y);
+        const uint sliceIndex = (uint)clamp(slice, 0.0f, float(grid.z - 1u));
+        clusterRange = gClusterRanges[(sliceIndex * grid.y + tile.y) * grid.x + tile.x];
+        globalCount = (uint)uClusterGrid.w;
+    }
+    const uint listCount = globalCount + clusterRange.y;
+
     float3 Lo = 0.0f;
 
     [loop]
-    for (uint i = 0; i < lightCount; ++i)
+    for (uint listIndex = 0; listIndex < listCount; ++listIndex)
     {
+        const uint i = !clustered ? listIndex
+            : gClusterLightIndices[(listIndex < globalCount) ? listIndex : clusterRange.x + (listIndex - globalCount)];
         GPULight l = gLights[i];
         const uint type = (uint)l.p0.w;
 
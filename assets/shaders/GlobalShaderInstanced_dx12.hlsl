@@ -19,6 +19,11 @@ struct GPULight
 };
 StructuredBuffer<GPULight> gLights : register(t2);
 
+// Clustered light lists of the camera view (CPU-built, see ClusteredLightBuilder): per-cluster { offset, count }
+// into gClusterLightIndices, whose first uClusterGrid.w entries are lights that reach every pixel.
+StructuredBuffer<uint2> gClusterRanges : register(t20);
+StructuredBuffer<uint> gClusterLightIndices : register(t21);
+
 // Spot shadow maps (depth) - NO ARRAYS (root sig uses 1-descriptor tables per tN)
 Texture2D<float> gSpotShadow0 : register(t3);
 Texture2D<float> gSpotShadow1 : register(t4);
@@ -97,6 +102,10 @@ cbuffer PerBatchCB : register(b0)
 	float4 uTexIndices2;
 	// x=heightScale, y=minSteps, z=maxSteps, w=reserved
 	float4 uParallaxParams;
+    // xyz=cluster grid size (0 = no clusters, loop over all lights), w=global light count
+	float4 uClusterGrid;
+    // x=slice scale, y=slice bias (slice = log2(viewDepth) * x + y), zw=1/viewport size
+	float4 uClusterSlices;
 };
 
 // Flags (must match C++)
@@ -1220,9 +1229,29 @@ float4 PSMain(VSOut IN) : SV_Target0
 	const int spotShadowCount = (int) uCounts.y;
 	const int pointShadowCount = (int) uCounts.z;
 
+	// Light list of this pixel: all lights, or the global prefix followed by the pixel's cluster list.
+	// Only the camera passes fill uClusterGrid; reflection and capture views keep it zero.
+	const bool clustered = uClusterGrid.x > 0.0f;
+	uint globalCount = (uint) lightCount;
+	uint2 clusterRange = uint2(0u, 0u);
+	if (clustered)
+	{
+		const uint3 grid = (uint3) uClusterGrid.xyz;
+		const float2 screenUV = IN.posH.xy * uClusterSlices.zw;
+		const uint2 tile = min((uint2) (screenUV * float2(grid.xy)), grid.xy - 1u);
+		const float viewDist = max(0.0f, dot(IN.worldPos - uCameraAmbient.xyz, uCameraForward.xyz));
+		const float slice = floor(log2(max(viewDist, 1e-4f)) * uClusterSlices.x + uClusterSlices.y);
+		const uint sliceIndex = (uint) clamp(slice, 0.0f, float(grid.z - 1u));
+		clusterRange = gClusterRanges[(sliceIndex * grid.y + tile.y) * grid.x + tile.x];
+		globalCount = (uint) uClusterGrid.w;
+	}
+	const uint listCount = globalCount + clusterRange.y;
+
     [loop]
-	for (int i = 0; i < lightCount; ++i)
+	for (uint listIndex = 0; listIndex < listCount; ++listIndex)
 	{
+		const int i = !clustered ? (int) listIndex
+			: (int) gClusterLightIndices[(listIndex < globalCount) ? listIndex : clusterRange.x + (listIndex - globalCount)];
 		const GPULight Ld = gLights[i];
 		const int type = (int) Ld.p0.w;
 
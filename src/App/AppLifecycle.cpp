@@ -134,6 +134,7 @@ namespace appLifecycle
         app.rendererSettings.loadingOverlayVisible = true;
         app.rendererSettings.loadingOverlayProgressBar = 0.0f;
         app.renderer = std::make_unique<rendern::Renderer>(*app.device, app.rendererSettings);
+        app.renderer->SetJobSystem(app.jobSystem.get(), ComputeStreamingWorkerCount());
 
 #if defined(CORE_USE_DX12)
         if (app.requestedBackend == rhi::Backend::DirectX12 && app.debugSwapChain && app.debugWindow.hwnd)
@@ -143,7 +144,10 @@ namespace appLifecycle
 #endif
 
         app.scene.Clear();
-        app.bindless = std::make_unique<rendern::BindlessTable>(*app.device);
+        app.bindless = std::make_unique<rendern::BindlessTable>(
+            *app.device,
+            app.renderer->GetFrameSync(),
+            rendern::BindlessTableDesc{ .capacity = app.config.bindlessTextureSlots });
         app.levelInstance = std::make_unique<rendern::LevelInstance>(rendern::InstantiateLevel(
             app.scene,
             *app.assets,
@@ -185,6 +189,8 @@ namespace appLifecycle
             return true;
         }
 
+        // Meshes keep CPU occluder triangles only while occlusion culling is on.
+        app.meshIO->buildOccluders = app.rendererSettings.enableOcclusionCulling;
         appRuntime::DriveAssetStreaming(*app.assets, *app.levelInstance, *app.bindless, app.scene, app.config.uploadBudget);
 
         app.statsTimer.Tick();
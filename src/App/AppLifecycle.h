@@ -32,6 +32,8 @@ namespace appLifecycle
         int windowHeight = 1024;
         std::wstring windowTitle = L"CoreEngineModule (DX12)";
         appRuntime::UploadBudget uploadBudget{};
+        // Texture slots the bindless table reserves in the device descriptor heap (shared with per-draw SRVs).
+        std::uint32_t bindlessTextureSlots = 1024;
     };
 
 
@@ -139,6 +139,8 @@ namespace appEditor
         rendern::TranslateGizmoController translateGizmo{};
         rendern::RotateGizmoController rotateGizmo{};
         rendern::ScaleGizmoController scaleGizmo{};
+        // Synced lazily on click; unchanged items cost a compare, so static levels do not rebuild it.
+        rendern::SceneBVH pickBvh{};
     };
 
     template <typename TGizmoState>
@@ -501,9 +503,11 @@ namespace appEditor
         {
             const bool ctrlDown = input.KeyDown(VK_CONTROL) || input.KeyDown(VK_LCONTROL) || input.KeyDown(VK_RCONTROL);
 
+            interaction.pickBvh.Sync(scene);
             const rendern::PickResult pick = rendern::PickEditorObjectUnderScreenPoint(
                 scene,
                 levelInstance,
+                interaction.pickBvh,
                 mouseXF,
                 mouseYF,
                 viewportWidthF,
@@ -1,6 +1,7 @@
 module;
 
 #include <deque>
+#include <cstddef>
 #include <cstdint>
 #include <utility>
 #include <memory>
@@ -16,6 +17,7 @@ module;
 #include <functional>
 #include <algorithm>
 #include <cctype>
+#include <vector>
 
 export module core:resource_manager_mesh;
 
@@ -46,6 +48,9 @@ export namespace rendern
 		bool flipUVs{ true };
 		std::optional<std::uint32_t> submeshIndex{};
 		bool bakeNodeTransforms{ true };
+
+		// Keep CPU occluder triangles even when MeshIO::buildOccluders is off (artist-flagged occluders).
+		bool occluder{ false };
 	};
 
 
@@ -58,6 +63,16 @@ export namespace rendern
 		float sphereRadius{ 0.0f };
 	};
 
+	// Model-space triangles kept on the CPU for software occlusion culling.
+	export struct OccluderGeometry
+	{
+		std::vector<mathUtils::Vec3> positions;
+		std::vector<std::uint32_t> indices; // triangle list
+	};
+
+	// Meshes above this size are not kept as occluders (too costly to rasterize every frame).
+	export inline constexpr std::size_t kMaxOccluderTriangles = 4096;
+
 	export class MeshResource
 	{
 	public:
@@ -75,8 +90,12 @@ export namespace rendern
 		const Properties& GetProperties() const noexcept { return properties_; }
 		const MeshRHI& GetResource() const noexcept { return resource_; }
 		const MeshBounds& GetBounds() const noexcept { return bounds_; }
+		// nullptr unless occluders were requested at upload (MeshIO::buildOccluders or MeshProperties::occluder),
+		// or when the mesh is too large (or not indexed) to be used as an occluder.
+		const std::shared_ptr<const OccluderGeometry>& GetOccluder() const noexcept { return occluder_; }
 
 		void SetBounds(const MeshBounds& b) noexcept { bounds_ = b; }
+		void SetOccluder(std::shared_ptr<const OccluderGeometry> occluder) noexcept { occluder_ = std::move(occluder); }
 
 		template <typename PropertiesType>
 			requires std::same_as<std::remove_cvref_t<PropertiesType>, Properties>
@@ -97,6 +116,7 @@ export namespace rendern
 		MeshRHI resource_{};
 		Properties properties_{};
 		MeshBounds bounds_{};
+		std::shared_ptr<const OccluderGeometry> occluder_{};
 	};
 
 	export struct MeshIO
@@ -104,6 +124,10 @@ export namespace rendern
 		rhi::IRHIDevice& device;
 		IJobSystem& jobs;
 		IRenderQueue& render;
+
+		// Build CPU occluder triangles for every uploaded mesh. Follows RendererSettings::enableOcclusionCulling;
+		// meshes uploaded while it is off only get them if flagged with MeshProperties::occluder.
+		bool buildOccluders{ false };
 	};
 }
 
@@ -164,6 +188,23 @@ namespace rendern
 		b.sphereRadius = mathUtils::Length(ext);
 		return b;
 	}
+
+	std::shared_ptr<const OccluderGeometry> BuildOccluderGeometry(const MeshCPU& cpu)
+	{
+		if (cpu.indices.size() < 3 || cpu.indices.size() / 3 > kMaxOccluderTriangles)
+		{
+			return nullptr;
+		}
+
+		auto occluder = std::make_shared<OccluderGeometry>();
+		occluder->positions.reserve(cpu.vertices.size());
+		for (const auto& v : cpu.vertices)
+		{
+			occluder->positions.emplace_back(v.px, v.py, v.pz);
+		}
+		occluder->indices.assign(cpu.indices.begin(), cpu.indices.begin() + static_cast<std::ptrdiff_t>(cpu.indices.size() / 3 * 3));
+		return occluder;
+	}
 } // namespace rendern
 
 export template <>
@@ -492,6 +533,11 @@ public:
 
 			auto cpuPtr = std::make_shared<MeshCPU>(std::move(cpu));
 			const rendern::MeshBounds bounds = ComputeMeshBounds(*cpuPtr);
+			std::shared_ptr<const rendern::OccluderGeometry> occluder{};
+			if (io.buildOccluders || props.occluder)
+			{
+				occluder = rendern::BuildOccluderGeometry(*cpuPtr);
+			}
 			MeshIO ioCopy = io;
 
 			ioCopy.render.Enqueue([this,
@@ -499,6 +545,7 @@ public:
 				generation = ticket.generation,
 				cpuPtr,
 				bounds,
+				occluder = std::move(occluder),
 				props = std::move(props),
 				ioCopy]() mutable
 				{
@@ -542,6 +589,7 @@ public:
 
 					MeshEntry& entry = it->second;
 					entry.meshHandle->SetBounds(bounds);
+					entry.meshHandle->SetOccluder(occluder);
 					MeshRHI old = entry.meshHandle->ReplaceResource(std::move(gpu));
 					if (old.vertexBuffer.id != 0 || old.indexBuffer.id != 0)
 					{
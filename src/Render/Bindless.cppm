@@ -1,8 +1,17 @@
 module;
 
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
 export module core:render_bindless;
 
 import :rhi;
+import :sync;
 
 // Bindless rendering related classes and functions
 
@@ -11,15 +20,273 @@ import :rhi;
 
 export namespace rendern
 {
+	struct DescriptorRange
+	{
+		std::uint32_t first{ 0 };
+		std::uint32_t count{ 0 };
+	};
+
+	struct DescriptorAllocatorStats
+	{
+		std::uint32_t capacity{ 0 };
+		std::uint32_t live{ 0 };            // handed out and not freed
+		std::uint32_t pendingFree{ 0 };     // freed, waiting for the GPU to finish the frame that freed them
+		std::uint32_t highWater{ 0 };       // slots [0, highWater) have been used at least once
+		std::uint32_t largestFreeRun{ 0 };  // longest contiguous run available to AllocateRange()
+		float occupancy{ 0.0f };            // live / capacity
+		float fragmentation{ 0.0f };        // 1 - largestFreeRun / free slots; 0 = all free space is one run
+	};
+
+	// Dense index allocator over [0, capacity). Single slots come from a LIFO free list before the
+	// never-used tail is touched, so a steady churn of allocations keeps reusing the same indices.
+	// Frees are deferred: a slot freed during frame F becomes reusable only after Retire() is told
+	// frame F completed, and its generation is bumped immediately so stale (index, generation) pairs
+	// held by other systems can be detected.
+	class DescriptorIndexAllocator
+	{
+	public:
+		explicit DescriptorIndexAllocator(std::uint32_t capacity)
+			: state_(capacity, SlotState::Free)
+			, generations_(capacity, 0u)
+		{
+		}
+
+		std::uint32_t Capacity() const noexcept
+		{
+			return static_cast<std::uint32_t>(state_.size());
+		}
+
+		std::optional<std::uint32_t> Allocate()
+		{
+			std::uint32_t slot = 0;
+			if (!freeList_.empty())
+			{
+				slot = freeList_.back();
+				freeList_.pop_back();
+			}
+			else if (highWater_ < Capacity())
+			{
+				slot = highWater_++;
+			}
+			else
+			{
+				return std::nullopt;
+			}
+			state_[slot] = SlotState::Live;
+			++live_;
+			return slot;
+		}
+
+		// Contiguous slots for tables indexed as base + i (material texture sets). The untouched tail is
+		// preferred; otherwise the lowest run of free slots that is long enough is used.
+		std::optional<DescriptorRange> AllocateRange(std::uint32_t count)
+		{
+			if (count == 0)
+			{
+				return std::nullopt;
+			}
+
+			std::optional<std::uint32_t> first;
+			bool fromFreeList = false;
+			if (count <= Capacity() - highWater_)
+			{
+				first = highWater_;
+				highWater_ += count;
+			}
+			else
+			{
+				std::uint32_t runStart = 0;
+				std::uint32_t runLength = 0;
+				// Slots past the high-water mark are Free too, so a run may end in the untouched tail.
+				for (std::uint32_t slot = 0; slot < Capacity() && !first; ++slot)
+				{
+					if (state_[slot] != SlotState::Free)
+					{
+						runLength = 0;
+						continue;
+					}
+					if (runLength++ == 0)
+					{
+						runStart = slot;
+					}
+					if (runLength == count)
+					{
+						first = runStart;
+					}
+				}
+				if (!first)
+				{
+					return std::nullopt;
+				}
+				fromFreeList = true;
+				highWater_ = std::max(highWater_, *first + count);
+			}
+
+			for (std::uint32_t slot = *first; slot < *first + count; ++slot)
+			{
+				state_[slot] = SlotState::Live;
+			}
+			if (fromFreeList)
+			{
+				std::erase_if(freeList_, [this](std::uint32_t slot) { return state_[slot] != SlotState::Free; });
+			}
+			live_ += count;
+			return DescriptorRange{ *first, count };
+		}
+
+		// Double frees and out-of-range slots are ignored.
+		void Free(std::uint32_t slot, std::uint64_t frame) noexcept
+		{
+			FreeRange(DescriptorRange{ slot, 1 }, frame);
+		}
+
+		void FreeRange(DescriptorRange range, std::uint64_t frame) noexcept
+		{
+			if (range.count == 0 || range.first >= Capacity() || range.count > Capacity() - range.first)
+			{
+				return;
+			}
+			for (std::uint32_t slot = range.first; slot < range.first + range.count; ++slot)
+			{
+				if (state_[slot] != SlotState::Live)
+				{
+					return;
+				}
+			}
+
+			for (std::uint32_t slot = range.first; slot < range.first + range.count; ++slot)
+			{
+				state_[slot] = SlotState::PendingFree;
+				++generations_[slot];
+			}
+			live_ -= range.count;
+			pendingCount_ += range.count;
+			pending_.push_back(PendingFree{ range, frame });
+		}
+
+		// Makes every slot freed during a frame < completedFrameCount reusable.
+		void Retire(std::uint64_t completedFrameCount)
+		{
+			while (!pending_.empty() && pending_.front().frame < completedFrameCount)
+			{
+				const DescriptorRange range = pending_.front().range;
+				pending_.pop_front();
+				// Reversed so the lowest slot of the range is handed out first.
+				for (std::uint32_t i = range.count; i-- > 0;)
+				{
+					state_[range.first + i] = SlotState::Free;
+					freeList_.push_back(range.first + i);
+				}
+				pendingCount_ -= range.count;
+			}
+		}
+
+		std::uint32_t Generation(std::uint32_t slot) const noexcept
+		{
+			return slot < Capacity() ? generations_[slot] : 0u;
+		}
+
+		bool IsLive(std::uint32_t slot, std::uint32_t generation) const noexcept
+		{
+			return slot < Capacity() && state_[slot] == SlotState::Live && generations_[slot] == generation;
+		}
+
+		DescriptorAllocatorStats GetStats() const noexcept
+		{
+			DescriptorAllocatorStats stats{};
+			stats.capacity = Capacity();
+			stats.live = live_;
+			stats.pendingFree = pendingCount_;
+			stats.highWater = highWater_;
+
+			std::uint32_t run = 0;
+			for (const SlotState state : state_)
+			{
+				run = (state == SlotState::Free) ? run + 1 : 0;
+				stats.largestFreeRun = std::max(stats.largestFreeRun, run);
+			}
+
+			const std::uint32_t freeSlots = Capacity() - live_ - pendingCount_;
+			if (stats.capacity > 0)
+			{
+				stats.occupancy = static_cast<float>(live_) / static_cast<float>(stats.capacity);
+			}
+			if (freeSlots > 0)
+			{
+				stats.fragmentation = 1.0f - static_cast<float>(stats.largestFreeRun) / static_cast<float>(freeSlots);
+			}
+			return stats;
+		}
+
+	private:
+		enum class SlotState : std::uint8_t
+		{
+			Free,
+			Live,
+			PendingFree
+		};
+
+		struct PendingFree
+		{
+			DescriptorRange range;
+			std::uint64_t frame{ 0 };
+		};
+
+		std::vector<SlotState> state_;
+		std::vector<std::uint32_t> generations_;
+		std::vector<std::uint32_t> freeList_;
+		std::deque<PendingFree> pending_;
+		std::uint32_t highWater_{ 0 };
+		std::uint32_t live_{ 0 };
+		std::uint32_t pendingCount_{ 0 };
+	};
+
+	struct BindlessTableDesc
+	{
+		// Slots reserved from the device heap up front; callers size it from their texture budget.
+		std::uint32_t capacity{ 4096 };
+	};
+
+	// Texture descriptor table carved out of the device heap once at startup. Indices returned here are
+	// device descriptor indices (usable with BindTextureDesc and in shaders); the table recycles them
+	// itself, so streaming can register and unregister textures without growing the device heap.
+	// With a FrameSync, freed indices are reused only after the GPU finished the frame that freed them;
+	// without one (backends that keep resources alive for in-flight work) they are reused right away.
 	class BindlessTable
 	{
 	public:
-		explicit BindlessTable(rhi::IRHIDevice& device) 
-			: device_(device) {}
+		explicit BindlessTable(rhi::IRHIDevice& device, const FrameSync* frameSync = nullptr, BindlessTableDesc desc = {})
+			: device_(device)
+			, frameSync_(frameSync)
+			, allocator_(desc.capacity)
+		{
+			if (desc.capacity > 0)
+			{
+				base_ = device_.ReserveTextureDescriptorRange(desc.capacity);
+			}
+		}
+
+		~BindlessTable()
+		{
+			if (allocator_.Capacity() > 0)
+			{
+				device_.ReleaseTextureDescriptorRange(base_, allocator_.Capacity());
+			}
+		}
+
+		BindlessTable(const BindlessTable&) = delete;
+		BindlessTable& operator=(const BindlessTable&) = delete;
 
 		rhi::TextureDescIndex RegisterTexture(rhi::TextureHandle texture)
 		{
-			rhi::TextureDescIndex index = device_.AllocateTextureDesctiptor(texture);
+			Retire();
+			const std::optional<std::uint32_t> slot = allocator_.Allocate();
+			if (!slot)
+			{
+				throw std::runtime_error("BindlessTable: descriptor table exhausted (increase BindlessTableDesc::capacity)");
+			}
+			const rhi::TextureDescIndex index = base_ + *slot;
+			device_.UpdateTextureDescriptor(index, texture);
 			return index;
 		}
 
@@ -30,10 +297,74 @@ export namespace rendern
 
 		void UnregisterTexture(rhi::TextureDescIndex index) noexcept
 		{
-			device_.FreeTextureDescriptor(index);
+			if (Owns(index))
+			{
+				allocator_.Free(index - base_, CurrentFrame());
+			}
+		}
+
+		// Contiguous descriptor indices, initially null textures; fill them with UpdateTexture().
+		DescriptorRange ReserveRange(std::uint32_t count)
+		{
+			Retire();
+			const std::optional<DescriptorRange> range = allocator_.AllocateRange(count);
+			if (!range)
+			{
+				throw std::runtime_error("BindlessTable: no contiguous descriptor range of the requested size");
+			}
+			for (std::uint32_t i = 0; i < range->count; ++i)
+			{
+				device_.UpdateTextureDescriptor(base_ + range->first + i, rhi::TextureHandle{});
+			}
+			return DescriptorRange{ base_ + range->first, range->count };
+		}
+
+		void ReleaseRange(DescriptorRange range) noexcept
+		{
+			if (range.count > 0 && Owns(range.first))
+			{
+				allocator_.FreeRange(DescriptorRange{ range.first - base_, range.count }, CurrentFrame());
+			}
+		}
+
+		// Recycles indices whose freeing frame has completed. Registration calls it too, so calling it once
+		// per frame only keeps GetStats() current.
+		void Retire()
+		{
+			allocator_.Retire(frameSync_ ? frameSync_->GetCompletedFrameCount() : std::numeric_limits<std::uint64_t>::max());
+		}
+
+		// Bumped whenever an index is unregistered; callers caching an index can keep its generation
+		// and check IsLive() to detect that the slot was released (and possibly handed to another texture).
+		std::uint32_t Generation(rhi::TextureDescIndex index) const noexcept
+		{
+			return Owns(index) ? allocator_.Generation(index - base_) : 0u;
+		}
+
+		bool IsLive(rhi::TextureDescIndex index, std::uint32_t generation) const noexcept
+		{
+			return Owns(index) && allocator_.IsLive(index - base_, generation);
+		}
+
+		DescriptorAllocatorStats GetStats() const noexcept
+		{
+			return allocator_.GetStats();
 		}
 
 	private:
+		bool Owns(rhi::TextureDescIndex index) const noexcept
+		{
+			return index >= base_ && index - base_ < allocator_.Capacity();
+		}
+
+		std::uint64_t CurrentFrame() const noexcept
+		{
+			return frameSync_ ? frameSync_->GetCurrentFrame() : 0u;
+		}
+
 		rhi::IRHIDevice& device_;
+		const FrameSync* frameSync_{ nullptr };
+		DescriptorIndexAllocator allocator_;
+		rhi::TextureDescIndex base_{ 0 };
 	};
-}
\ No newline at end of file
+}
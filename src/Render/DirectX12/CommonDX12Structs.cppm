@@ -140,6 +140,18 @@ export namespace rendern
 		std::uint32_t lightIndex{ 0 };
 	};
 
+	// Spot/point light that gets a shadow map this frame, with its caster culling views.
+	struct ShadowLightView
+	{
+		std::uint32_t lightIndex{ 0 };
+		LightType type{ LightType::Spot };
+		mathUtils::Mat4 viewProj{};         // spot only
+		mathUtils::Vec3 pos{};              // point only
+		float range{ 10.0f };               // point only
+		std::uint32_t view{ 0 };            // spot frustum, or the point light's six faces combined
+		std::uint32_t firstFaceView{ 0 };   // point only: one view per cube face (face-by-face fallback)
+	};
+
 	struct alignas(16) ShadowConstants
 	{
 		std::array<float, 16> uMVP{}; // lightProj * lightView * model
@@ -260,12 +272,13 @@ export namespace rendern
 		}
 	};
 
-	struct BatchTemp
+	// One opaque draw waiting for the draw queue; neighbours with equal keys merge into a Batch.
+	struct BatchItemTemp
 	{
+		BatchKey key{};
 		MaterialParams material{};
 		MaterialHandle materialHandle{};
-		int reflectionProbeIndex = -1;
-		std::vector<InstanceData> inst;
+		InstanceData inst{};
 	};
 
 	struct Batch
@@ -325,8 +338,13 @@ export namespace rendern
 		std::array<float, 4> uTexIndices2{};
 		// x=heightScale, y=minSteps, z=maxSteps, w=reserved
 		std::array<float, 4> uParallaxParams{};
+
+		// Camera passes only: x,y,z = cluster grid size, w = global light count (0 grid = all lights per pixel)
+		std::array<float, 4> uClusterGrid{};
+		// x = slice scale, y = slice bias: slice = log2(viewDepth) * x + y; z,w = 1 / viewport size
+		std::array<float, 4> uClusterSlices{};
 	};
-	static_assert(sizeof(PerBatchConstants) == 336);
+	static_assert(sizeof(PerBatchConstants) == 368);
 
 	struct alignas(16) SkinnedPerDrawConstants
 	{
@@ -347,8 +365,10 @@ export namespace rendern
 		std::array<float, 4>  uParallaxParams{};
 		std::array<float, 16> uModel{};
 		std::array<float, 4>  uSkinning{};
+		std::array<float, 4>  uClusterGrid{};   // same as PerBatchConstants
+		std::array<float, 4>  uClusterSlices{};
 	};
-	static_assert(sizeof(SkinnedPerDrawConstants) == 416);
+	static_assert(sizeof(SkinnedPerDrawConstants) == 448);
 
 	struct alignas(16) SkinnedSingleMatrixPassConstants
 	{
@@ -495,8 +515,10 @@ export namespace rendern
 		std::array<float, 4>  uCameraForward{};    // xyz + pad
 		std::array<float, 4>  uShadowBias{};       // x=dirBaseBiasTexels, y=spotBaseBiasTexels, z=pointBaseBiasTexels, w=slopeScaleTexels
 		std::array<float, 4>  uCounts{};           // x = lightCount, y = spotShadowCount, z = pointShadowCount, w = activeReflectionProbeCount
+		std::array<float, 4>  uClusterGrid{};      // x,y,z = cluster grid size, w = global light count (0 grid = all lights per pixel)
+		std::array<float, 4>  uClusterSlices{};    // x = slice scale, y = slice bias: slice = log2(viewDepth) * x + y
 	};
-	static_assert(sizeof(DeferredLightingConstants) == 128);
+	static_assert(sizeof(DeferredLightingConstants) == 160);
 
 	struct ParticleDrawBatch
 	{
@@ -44,6 +44,8 @@ module;
 #include <algorithm>
 #include <cassert>
 #include <bit>
+#include <limits>
+#include <chrono>
 
 export module core:rhi_dx12;
 
@@ -243,6 +245,13 @@ export namespace rhi
         BufferHandle buffer{};
         std::size_t dstOffsetBytes{ 0 };
         std::vector<std::byte> data;
+        // Set by UpdateBufferInPlace(): caller-owned bytes that stay valid until the submit, no copy taken.
+        std::span<const std::byte> inPlace{};
+
+        std::span<const std::byte> Bytes() const noexcept
+        {
+            return data.empty() ? inPlace : std::span<const std::byte>(data);
+        }
     };
 
 #if defined(_WIN32)
@@ -35,11 +35,18 @@ export module core:renderer_dx12;
 import :rhi;
 import :scene;
 import :visibility;
+import :scene_bvh;
+import :shadow_caster_culling;
+import :occlusion_culling;
+import :clustered_lighting;
 import :math_utils;
-import :hash_utils;
+import :draw_queue;
+import :instance_stream;
 import :renderer_settings;
 import :render_core;
 import :render_graph;
+import :sync;
+import :resource_manager_core;
 import :file_system;
 import :mesh;
 import :skinned_mesh;
@@ -88,11 +95,15 @@ export namespace rendern
 		DX12Renderer(rhi::IRHIDevice& device, RendererSettings settings = {})
 			: device_(device)
 			, settings_(std::move(settings))
+			, frameSync_(device, FrameSyncDesc{ .framesInRuntime = static_cast<int>(device.GetFramesInFlight()) })
+			, uploadRing_(device, frameSync_, FrameUploadRingDesc{ .initialBytesPerFrame = kDefaultInstanceBufferSizeBytes })
 			, shaderLibrary_(device)
 			, psoCache_(device)
 			, debugDrawRenderer_(device, shaderLibrary_, psoCache_)
 			, debugTextRenderer_(device, shaderLibrary_, psoCache_)
 		{
+			LoadPipelineCacheFile(pipelineCache_, settings_.pipelineCachePath);
+			device_.SetPipelineCache(&pipelineCache_);
 			CreateResources();
 		}
 
@@ -102,6 +113,30 @@ export namespace rendern
 			EnsureReflectionCaptureResources();
 		}
 
+		// Shadow and reflection-capture passes record on these workers; nullptr records serially.
+		void SetJobSystem(IJobSystem* jobs, std::uint32_t workerCount) noexcept
+		{
+			renderGraph_.SetJobSystem(jobs, workerCount);
+			occlusionCuller_.SetJobSystem(jobs, workerCount);
+		}
+
+		// Software occlusion culling counters of the last frame that ran it (RendererSettings::enableOcclusionCulling).
+		const OcclusionCullingStats& GetOcclusionCullingStats() const noexcept
+		{
+			return occlusionCuller_.GetStats();
+		}
+
+		// Light-to-cluster assignment of the last frame (RendererSettings::enableClusteredLighting).
+		const ClusteredLightingStats& GetClusteredLightingStats() const noexcept
+		{
+			return lightClusters_.GetStats();
+		}
+
+		const FrameSync& GetFrameSync() const noexcept
+		{
+			return frameSync_;
+		}
+
 		void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData)
 		{
 #include "RendererImpl/DirectX12Renderer_RenderFrame_00_SetupCSM.inl"
@@ -295,6 +330,14 @@ export namespace rendern
 #include "RendererImpl/DirectX12Renderer_UploadLights.inl"
 		}
 
+		// Bins the lights of the last UploadLights() into the camera's cluster grid and uploads the ranges
+		// and index list read by the deferred resolve and the camera forward passes. Returns false (nothing
+		// uploaded) when disabled.
+		bool UploadLightClusters(const Camera& camera, const mathUtils::Mat4& cameraView, const mathUtils::Mat4& cameraProj)
+		{
+#include "RendererImpl/DirectX12Renderer_UploadLightClusters.inl"
+		}
+
 		void CreateResources()
 		{
 #include "RendererImpl/DirectX12Renderer_CreateResources_00_PathsSkybox.inl"
@@ -344,11 +387,13 @@ export namespace rendern
 
 			if (reflectionCube_)
 			{
+				renderGraph_.InvalidateTexture(device_, reflectionCube_);
 				device_.DestroyTexture(reflectionCube_);
 				reflectionCube_ = {};
 			}
 			if (reflectionDepthCube_)
 			{
+				renderGraph_.InvalidateTexture(device_, reflectionDepthCube_);
 				device_.DestroyTexture(reflectionDepthCube_);
 				reflectionDepthCube_ = {};
 			}
@@ -371,16 +416,19 @@ export namespace rendern
 			{
 				if (probe.cube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.cube);
 					device_.DestroyTexture(probe.cube);
 					probe.cube = {};
 				}
 				if (probe.prefilteredCube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.prefilteredCube);
 					device_.DestroyTexture(probe.prefilteredCube);
 					probe.prefilteredCube = {};
 				}
 				if (probe.depthCube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.depthCube);
 					device_.DestroyTexture(probe.depthCube);
 					probe.depthCube = {};
 				}
@@ -414,16 +462,19 @@ export namespace rendern
 
 				if (probe.cube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.cube);
 					device_.DestroyTexture(probe.cube);
 					probe.cube = {};
 				}
 				if (probe.depthCube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.depthCube);
 					device_.DestroyTexture(probe.depthCube);
 					probe.depthCube = {};
 				}
 				if (probe.prefilteredCube)
 				{
+					renderGraph_.InvalidateTexture(device_, probe.prefilteredCube);
 					device_.DestroyTexture(probe.prefilteredCube);
 					probe.prefilteredCube = {};
 				}
@@ -471,6 +522,10 @@ export namespace rendern
 
 	private:
 		static constexpr std::uint32_t kMaxLights = 64;
+		static constexpr std::uint32_t kLightClusterCount = kDefaultClusterGridX * kDefaultClusterGridY * kDefaultClusterGridZ;
+		// Worst case: every light in every cluster, plus the global prefix.
+		static constexpr std::uint32_t kMaxClusterLightIndices = kMaxLights * (kLightClusterCount + 1u);
+		static constexpr float kPointShadowNearZ = 0.01f;
 		static constexpr std::uint32_t kDefaultInstanceBufferSizeBytes = 8u * 1024u * 1024u; // 8 MB (combined shadow+main instances)
 		static constexpr std::uint32_t kDefaultSkinPaletteBufferSizeBytes = 4u * 1024u * 1024u;
 		static constexpr std::uint32_t kMaxDeferredReflectionProbes = 255u;
@@ -480,11 +535,20 @@ export namespace rendern
 		rhi::IRHIDevice& device_;
 		RendererSettings settings_{};
 
+		// Per-frame instance/particle uploads are written straight into the ring; FrameSync guards slot reuse.
+		FrameSync frameSync_;
+		FrameUploadRing uploadRing_;
+
+		// Native PSOs are compiled lazily at submit; blobs from the previous launch let the driver skip that.
+		rhi::PipelineCache pipelineCache_{ rhi::Backend::DirectX12 };
 		ShaderLibrary shaderLibrary_;
 		PSOCache psoCache_;
 		debugDraw::DebugDrawRendererDX12 debugDrawRenderer_;
 		debugText::DebugTextRendererDX12 debugTextRenderer_;
 
+		// Persistent so the frame command arena and transient textures are reused across frames.
+		renderGraph::RenderGraph renderGraph_;
+
 		// Main pass
 		std::array<rhi::PipelineHandle, 4> psoMain_{}; // idx: (UseTex?1:0)|(UseShadow?2:0)
 		std::array<rhi::PipelineHandle, 4> psoMainSkinned_{};
@@ -526,7 +590,27 @@ export namespace rendern
 		rhi::GraphicsState planarMaskState_{};
 		rhi::GraphicsState planarReflectedState_{};
 
+		// instanceBuffer_ persists across frames: only rows that differ from last frame's packing are uploaded.
 		rhi::BufferHandle instanceBuffer_{};
+		PersistentInstanceStream<InstanceData> instanceStream_;
+		InstanceSlotCache<Transform, mathUtils::Mat4> drawItemModelCache_;
+		InstanceSlotCache<Transform, mathUtils::Mat4> skinnedModelCache_;
+		SceneBVH sceneBvh_;                                  // world bounds of draw/skinned items, synced per frame
+		std::vector<std::uint32_t> drawItemViewMasks_;       // per scene.drawItems, bit 0 = camera frustum
+		std::vector<std::uint32_t> skinnedDrawItemViewMasks_; // per skinned draw item, bit 0 = camera frustum
+		// Camera occlusion culling: coarse CPU depth buffer and the camera-visible items tested against it.
+		SoftwareOcclusionCuller occlusionCuller_;
+		std::vector<Aabb> occlusionBoxes_;
+		std::vector<SceneBVHItem> occlusionItems_;
+		std::vector<std::uint8_t> occlusionVisible_;
+		// Shadow casters of this frame (opaque draw items) and their per-view culling/packing scratch.
+		CullSpheresSoA shadowCasterSpheres_;
+		std::vector<const rendern::MeshRHI*> shadowCasterMeshes_;
+		std::vector<InstanceData> shadowCasterInstances_;
+		std::vector<mathUtils::Frustum> shadowCullViews_;
+		std::vector<ShadowViewMask> shadowCasterMasks_;
+		std::vector<std::uint32_t> shadowCullScratch_;
+		ShadowViewPacking<const rendern::MeshRHI*> shadowViewPacking_;
 		rhi::BufferHandle skinPaletteBuffer_{};
 		std::uint32_t skinPaletteBufferSizeBytes_{ kDefaultSkinPaletteBufferSizeBytes };
 		std::uint32_t instanceBufferSizeBytes_{ kDefaultInstanceBufferSizeBytes };
@@ -540,6 +624,12 @@ export namespace rendern
 
 		rhi::BufferHandle lightsBuffer_{};
 		rhi::BufferHandle shadowDataBuffer_{};
+		std::vector<GPULight> gpuLights_; // last UploadLights() contents, binned by UploadLightClusters()
+
+		// Clustered lighting (t20/t21 of the deferred resolve and the camera forward passes).
+		ClusteredLightBuilder lightClusters_;
+		rhi::BufferHandle clusterRangesBuffer_{};
+		rhi::BufferHandle clusterLightIndicesBuffer_{};
 
 		rhi::BufferHandle reflectionProbeMetaBuffer_{};
 
@@ -577,7 +667,11 @@ export namespace rendern
 		std::vector<int> scratchDeferredReflectionProbeRemap_;
 
 		std::vector<TransparentDraw> transparentDrawsScratch_;
-		std::vector<InstanceData> combinedInstancesScratch_;
+		std::vector<BatchItemTemp> mainBatchItemsScratch_;
+		std::vector<BatchItemTemp> captureBatchItemsScratch_;
+		DrawQueue mainDrawQueue_;
+		DrawQueue captureDrawQueue_;
+		DrawQueue transparentDrawQueue_;
 		std::unordered_map<const SkinnedAssetBundle*, SkinnedMeshRHI> skinnedMeshCache_{};
 		std::vector<DeferredReflectionProbeGpu> deferredReflectionProbesScratch_;
 		std::vector<int> deferredReflectionProbeRemapScratch_;
@@ -250,6 +250,10 @@
                 throw std::runtime_error("DX12: SRV heap exhausted (increase SRV heap NumDescriptors).");
             }
 
+            if (idx < srvSlotFreed_.size())
+            {
+                srvSlotFreed_[idx] = false;
+            }
             return idx;
         }
 
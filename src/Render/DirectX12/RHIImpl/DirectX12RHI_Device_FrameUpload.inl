@@ -118,6 +118,88 @@
             WaitForFence(v);
         }
 
+        void QueueBufferUpdate(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes, bool inPlace)
+        {
+            if (!buffer || data.empty())
+            {
+                return;
+            }
+
+            auto* bufferEntry = buffers_.Find(buffer);
+            if (!bufferEntry)
+            {
+                return;
+            }
+
+            BufferEntry& entry = *bufferEntry;
+
+            const std::size_t end = offsetBytes + data.size();
+            if (end > entry.desc.sizeInBytes)
+                throw std::runtime_error("DX12: UpdateBuffer out of bounds");
+
+            // If we haven't submitted anything yet, it's safe to do a blocking upload.
+            if (!hasSubmitted_)
+            {
+                ImmediateUploadBuffer(entry, data, offsetBytes);
+                return;
+            }
+
+            PendingBufferUpdate u{};
+            u.buffer = buffer;
+            u.dstOffsetBytes = offsetBytes;
+            if (inPlace)
+            {
+                u.inPlace = data;
+            }
+            else
+            {
+                u.data.assign(data.begin(), data.end());
+            }
+            pendingBufferUpdates_.push_back(std::move(u));
+        }
+
+        void CreateBufferUploadRing(FrameResource& fr, std::uint32_t capacityBytes)
+        {
+            D3D12_HEAP_PROPERTIES heapProps{};
+            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+
+            D3D12_RESOURCE_DESC bufDesc{};
+            bufDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+            bufDesc.Width = static_cast<UINT64>(capacityBytes);
+            bufDesc.Height = 1;
+            bufDesc.DepthOrArraySize = 1;
+            bufDesc.MipLevels = 1;
+            bufDesc.Format = DXGI_FORMAT_UNKNOWN;
+            bufDesc.SampleDesc.Count = 1;
+            bufDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+            ComPtr<ID3D12Resource> upload;
+            ThrowIfFailed(NativeDevice()->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &bufDesc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&upload)),
+                "DX12: Create per-frame buffer upload ring failed");
+
+            void* bufMapped = nullptr;
+            ThrowIfFailed(upload->Map(0, nullptr, &bufMapped),
+                "DX12: Map per-frame buffer upload ring failed");
+
+            // The old ring may still be read by this submission: an earlier flush in the same frame can have
+            // recorded copies from it into cmdList_. Keep it alive until this submission's fence value.
+            if (fr.bufUpload)
+            {
+                deferredResources_.Defer(std::move(fr.bufUpload));
+            }
+
+            fr.bufUpload = std::move(upload);
+            fr.bufMapped = reinterpret_cast<std::byte*>(bufMapped);
+            fr.bufCapacity = capacityBytes;
+            fr.bufCursor = 0;
+        }
+
         void FlushPendingBufferUpdates()
         {
             if (pendingBufferUpdates_.empty())
@@ -125,23 +207,37 @@
 
             FrameResource& fr = CurrentFrame();
 
+            // Size the whole batch up front: a frame that outgrows its ring gets a larger one
+            // (rounded up to a power of two) instead of failing.
+            std::uint64_t required = fr.bufCursor;
             for (const PendingBufferUpdate& u : pendingBufferUpdates_)
             {
-                auto it = buffers_.find(u.buffer.id);
-                if (it == buffers_.end()) continue;
+                required += (static_cast<std::uint64_t>(u.Bytes().size()) + 15u) & ~std::uint64_t{ 15 };
+            }
+            if (required > fr.bufCapacity)
+            {
+                // Ring offsets are 32-bit; bit_ceil of anything above 2 GiB would not fit.
+                constexpr std::uint64_t kMaxRingBytes = std::uint64_t{ 1 } << 31;
+                if (required > kMaxRingBytes)
+                {
+                    throw std::runtime_error("DX12: buffer updates of one frame exceed the 2 GiB upload ring limit");
+                }
+                CreateBufferUploadRing(fr, static_cast<std::uint32_t>(std::bit_ceil(required)));
+            }
 
-                BufferEntry& dst = it->second;
-                if (!dst.resource || u.data.empty()) continue;
+            for (const PendingBufferUpdate& u : pendingBufferUpdates_)
+            {
+                auto* bufferEntry = buffers_.Find(u.buffer);
+                if (!bufferEntry) continue;
 
-                const std::uint32_t size = static_cast<std::uint32_t>(u.data.size());
-                const std::uint32_t aligned = AlignUp(size, 16u);
+                BufferEntry& dst = *bufferEntry;
+                const std::span<const std::byte> bytes = u.Bytes();
+                if (!dst.resource || bytes.empty()) continue;
 
-                if (fr.bufCursor + aligned > kPerFrameBufUploadBytes)
-                {
-                    throw std::runtime_error("DX12: per-frame buffer upload ring overflow (increase kPerFrameBufUploadBytes)");
-                }
+                const std::uint32_t size = static_cast<std::uint32_t>(bytes.size());
+                const std::uint32_t aligned = AlignUp(size, 16u);
 
-                std::memcpy(fr.bufMapped + fr.bufCursor, u.data.data(), size);
+                std::memcpy(fr.bufMapped + fr.bufCursor, bytes.data(), size);
 
                 TransitionResource(
                     cmdList_.Get(),
@@ -180,9 +276,10 @@
 
             FrameResource& fr = frames_[activeFrameIndex_];
 
-            // Wait until GPU is done with this frame resource, then recycle deferred objects/indices.
+            // Wait until GPU is done with this frame resource, then recycle every deferred object/index
+            // whose submission has completed (not only this frame's).
             WaitForFence(fr.fenceValue);
-            fr.ReleaseDeferred(freeSrv_, freeRTV_, freeDSV_);
+            RetireDeferred(fence_->GetCompletedValue());
 
             ThrowIfFailed(fr.cmdAlloc->Reset(), "DX12: cmdAlloc reset failed");
             ThrowIfFailed(cmdList_->Reset(fr.cmdAlloc.Get(), nullptr), "DX12: cmdList reset failed");
@@ -200,6 +297,19 @@
             const UINT64 v = ++fenceValue_;
             ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), "DX12: Signal failed");
             frames_[activeFrameIndex_].fenceValue = v;
+
+            deferredResources_.Seal(v);
+            deferredFreeSrv_.Seal(v);
+            deferredFreeRtv_.Seal(v);
+            deferredFreeDsv_.Seal(v);
+        }
+
+        void RetireDeferred(UINT64 completedValue)
+        {
+            deferredResources_.Retire(completedValue, [](ComPtr<ID3D12Resource>& resource) { resource.Reset(); });
+            deferredFreeSrv_.Retire(completedValue, [this](UINT index) { freeSrv_.push_back(index); });
+            deferredFreeRtv_.Retire(completedValue, [this](UINT index) { freeRTV_.push_back(index); });
+            deferredFreeDsv_.Retire(completedValue, [this](UINT index) { freeDSV_.push_back(index); });
         }
 
         void FlushGPU()
@@ -0,0 +1,39 @@
+        // Persistent pipeline cache key: everything the driver compiles into the PSO, by content.
+        // Handle ids are deliberately absent so the key (and the blob stored under it) survives a restart.
+        std::uint64_t HashPipelineCacheKey(
+            const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+            const InputLayoutEntry& layoutEntry,
+            const GraphicsState& state,
+            std::uint32_t viewInstanceCount) const
+        {
+            PipelineKeyHasher hasher;
+            auto AddBytecode = [&hasher](const D3D12_SHADER_BYTECODE& code)
+                {
+                    hasher.Add(static_cast<std::uint64_t>(code.BytecodeLength));
+                    hasher.AddBytes(std::span(static_cast<const std::byte*>(code.pShaderBytecode), code.BytecodeLength));
+                };
+
+            AddBytecode(desc.VS);
+            AddBytecode(desc.PS);
+            hasher.Add(layoutEntry.contentHash);
+            hasher.Add(state);
+            hasher.Add(static_cast<std::uint64_t>(desc.PrimitiveTopologyType));
+            hasher.Add(static_cast<std::uint64_t>(viewInstanceCount));
+            hasher.Add(static_cast<std::uint64_t>(desc.NumRenderTargets));
+            for (UINT i = 0; i < desc.NumRenderTargets; ++i)
+            {
+                hasher.Add(static_cast<std::uint64_t>(desc.RTVFormats[i]));
+            }
+            hasher.Add(static_cast<std::uint64_t>(desc.DSVFormat));
+            return hasher.Value();
+        }
+
+        // Cold path only: keep what the driver compiled so the next run can skip the compile.
+        void StorePipelineBlob(std::uint64_t cacheKey, ID3D12PipelineState* pso)
+        {
+            ComPtr<ID3DBlob> blob;
+            if (SUCCEEDED(pso->GetCachedBlob(&blob)) && blob)
+            {
+                pipelineCache_->Store(cacheKey, std::span(static_cast<const std::byte*>(blob->GetBufferPointer()), blob->GetBufferSize()));
+            }
+        }
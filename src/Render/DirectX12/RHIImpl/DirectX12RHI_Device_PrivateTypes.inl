@@ -26,6 +26,7 @@
             std::vector<std::string> semanticStorage;
             std::vector<D3D12_INPUT_ELEMENT_DESC> elems;
             std::uint32_t strideBytes{ 0 };
+            std::uint64_t contentHash{ 0 }; // PipelineKeyHasher over the RHI desc
         };
 
         struct ShaderEntry
@@ -125,8 +126,8 @@
 
         static constexpr std::uint32_t kFramesInFlight = 3;
         static constexpr UINT kPerFrameCBUploadBytes = 512u * 1024u;
-        static constexpr UINT kPerFrameBufUploadBytes = 8u * 1024u * 1024u; // 8 MB per frame buffer upload ring
-        static constexpr UINT kMaxSRVSlots = 20; // t0..t19 (room for PBR maps + env + bones)
+        static constexpr UINT kPerFrameBufUploadBytes = 8u * 1024u * 1024u; // initial 8 MB per frame buffer upload ring (grows on demand)
+        static constexpr UINT kMaxSRVSlots = 22; // t0..t21 (room for PBR maps + env + bones + light clusters)
         static constexpr UINT kSrvHeapNumDescriptors = 16384u; // CBV/SRV/UAV shader-visible heap size
 
         struct FrameResource
@@ -142,37 +143,14 @@
             ComPtr<ID3D12Resource> bufUpload;
             std::byte* bufMapped{ nullptr };
             std::uint32_t bufCursor{ 0 };
+            std::uint32_t bufCapacity{ 0 };
 
             // Fence value that marks when GPU finished using this frame resource.
             UINT64 fenceValue{ 0 };
 
-            // Deferred lifetime management:
-            //  - keep resources alive until GPU is done with this frame
-            //  - recycle descriptor indices only after the same fence is completed
-            std::vector<ComPtr<ID3D12Resource>> deferredResources;
-            std::vector<UINT> deferredFreeSrv;
-            std::vector<UINT> deferredFreeRtv;
-            std::vector<UINT> deferredFreeDsv;
-
             void ResetForRecording() noexcept
             {
                 cbCursor = 0;
                 bufCursor = 0;
             }
-
-            void ReleaseDeferred(
-                std::vector<UINT>& globalFreeSrv,
-                std::vector<UINT>& globalFreeRtv,
-                std::vector<UINT>& globalFreeDsv)
-            {
-                deferredResources.clear();
-
-                globalFreeSrv.insert(globalFreeSrv.end(), deferredFreeSrv.begin(), deferredFreeSrv.end());
-                globalFreeRtv.insert(globalFreeRtv.end(), deferredFreeRtv.begin(), deferredFreeRtv.end());
-                globalFreeDsv.insert(globalFreeDsv.end(), deferredFreeDsv.begin(), deferredFreeDsv.end());
-
-                deferredFreeSrv.clear();
-                deferredFreeRtv.clear();
-                deferredFreeDsv.clear();
-            }
         };
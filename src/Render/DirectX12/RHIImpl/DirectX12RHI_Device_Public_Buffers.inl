@@ -1,6 +1,5 @@
         BufferHandle CreateBuffer(const BufferDesc& desc) override
         {
-            BufferHandle handle{ ++nextBufId_ };
             BufferEntry bufferEntry{};
             bufferEntry.desc = desc;
 
@@ -38,41 +37,17 @@
                 AllocateStructuredBufferSRV(bufferEntry);
             }
 
-            buffers_[handle.id] = std::move(bufferEntry);
-            return handle;
+            return buffers_.Insert(std::move(bufferEntry));
         }
 
         void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
         {
-            if (!buffer || data.empty())
-            {
-                return;
-            }
-
-            auto it = buffers_.find(buffer.id);
-            if (it == buffers_.end())
-            {
-                return;
-            }
-
-            BufferEntry& entry = it->second;
-
-            const std::size_t end = offsetBytes + data.size();
-            if (end > entry.desc.sizeInBytes)
-                throw std::runtime_error("DX12: UpdateBuffer out of bounds");
-
-            // If we haven't submitted anything yet, it's safe to do a blocking upload.
-            if (!hasSubmitted_)
-            {
-                ImmediateUploadBuffer(entry, data, offsetBytes);
-                return;
-            }
+            QueueBufferUpdate(buffer, data, offsetBytes, false);
+        }
 
-            PendingBufferUpdate u{};
-            u.buffer = buffer;
-            u.dstOffsetBytes = offsetBytes;
-            u.data.assign(data.begin(), data.end());
-            pendingBufferUpdates_.push_back(std::move(u));
+        void UpdateBufferInPlace(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+        {
+            QueueBufferUpdate(buffer, data, offsetBytes, true);
         }
 
         void DestroyBuffer(BufferHandle buffer) noexcept override
@@ -82,14 +57,14 @@
                 return;
             }
 
-            auto it = buffers_.find(buffer.id);
-            if (it == buffers_.end())
+            auto* bufferEntry = buffers_.Find(buffer);
+            if (!bufferEntry)
             {
                 return;
             }
 
-            BufferEntry entry = std::move(it->second);
-            buffers_.erase(it);
+            BufferEntry entry = std::move(*bufferEntry);
+            buffers_.Erase(buffer);
 
             // Remove pending updates for this buffer.
             if (!pendingBufferUpdates_.empty())
@@ -102,14 +77,14 @@
 
             if (entry.resource && hasSubmitted_)
             {
-                CurrentFrame().deferredResources.push_back(std::move(entry.resource));
+                deferredResources_.Defer(std::move(entry.resource));
             }
 
             if (entry.hasSRV && entry.srvIndex != 0)
             {
                 if (hasSubmitted_)
                 {
-                    CurrentFrame().deferredFreeSrv.push_back(entry.srvIndex);
+                    deferredFreeSrv_.Defer(entry.srvIndex);
                 }
                 else
                 {
@@ -121,7 +96,7 @@
             {
                 if (hasSubmitted_)
                 {
-                    CurrentFrame().deferredFreeSrv.push_back(entry.srvIndexArray);
+                    deferredFreeSrv_.Defer(entry.srvIndexArray);
                 }
                 else
                 {
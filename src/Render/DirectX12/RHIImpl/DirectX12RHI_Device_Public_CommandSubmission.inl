@@ -83,19 +83,35 @@ void SubmitCommandList(CommandList&& commandList) override
                 return;
             }
 
-            auto it = textures_.find(tex.id);
-            if (it == textures_.end())
+            auto* textureEntry = textures_.Find(tex);
+            if (!textureEntry)
             {
                 return;
             }
 
             TransitionResource(
                 cmdList_.Get(),
-                it->second.resource.Get(),
-                it->second.state,
+                textureEntry->resource.Get(),
+                textureEntry->state,
                 desired);
         };
 
+    auto ToD3DResourceState = [](ResourceState state) -> D3D12_RESOURCE_STATES
+        {
+            switch (state)
+            {
+            case ResourceState::RenderTarget: return D3D12_RESOURCE_STATE_RENDER_TARGET;
+            case ResourceState::DepthWrite: return D3D12_RESOURCE_STATE_DEPTH_WRITE;
+            // Matches the lazy bind-time transitions so they become no-ops after a planned batch.
+            case ResourceState::ShaderRead: return D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+            case ResourceState::Unknown:
+            default: return D3D12_RESOURCE_STATE_COMMON;
+            }
+        };
+
+    // Reused across CommandTransitionTextures batches within this submit.
+    std::vector<D3D12_RESOURCE_BARRIER> barrierBatch;
+
     auto TransitionBackBuffer = [&](DX12SwapChain& sc, D3D12_RESOURCE_STATES desired)
         {
             TransitionResource(
@@ -109,9 +125,19 @@ void SubmitCommandList(CommandList&& commandList) override
 
     auto EnsurePSO = [&](PipelineHandle pipelineHandle, InputLayoutHandle layout) -> ID3D12PipelineState*
         {
+            auto* pipelineEntry = pipelines_.Find(pipelineHandle);
+            if (!pipelineEntry)
+            {
+                throw std::runtime_error("DX12: pipeline handle not found");
+            }
+
             // PSO cache key MUST include: shaders, state, layout, and render-target formats.
+            // Shaders rather than the pipeline handle, so pipelines created twice from the same shaders share a PSO.
             std::uint64_t key = 1469598103934665603ull; // FNV-1a offset basis
-            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineHandle.id));
+            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineEntry->vs.id));
+            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineEntry->ps.id));
+            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineEntry->topologyType));
+            key = HashPsoKeyPart(key, static_cast<std::uint64_t>(pipelineEntry->viewInstanceCount));
             key = HashPsoKeyPart(key, static_cast<std::uint64_t>(layout.id));
             key = HashPsoKeyPart(key, static_cast<std::uint64_t>(PackGraphicsStateKey(curState)));
             key = HashPsoKeyPart(key, static_cast<std::uint64_t>(curNumRT));
@@ -126,33 +152,27 @@ void SubmitCommandList(CommandList&& commandList) override
                 return it->second.Get();
             }
 
-            auto pit = pipelines_.find(pipelineHandle.id);
-            if (pit == pipelines_.end())
-            {
-                throw std::runtime_error("DX12: pipeline handle not found");
-            }
-
-            auto vsIt = shaders_.find(pit->second.vs.id);
+            auto* vsEntry = shaders_.Find(pipelineEntry->vs);
 
-            if (vsIt == shaders_.end())
+            if (!vsEntry)
             {
-                throw std::runtime_error(BuildMissingShaderMessage(pit->second, pipelineHandle, curNumRT, "vs"));
+                throw std::runtime_error(BuildMissingShaderMessage(*pipelineEntry, pipelineHandle, curNumRT, "vs"));
             }
 
             // Depth-only passes (NumRenderTargets == 0) can omit a pixel shader.
             const bool needsPS = (curNumRT > 0);
-            auto psIt = shaders_.end();
+            const ShaderEntry* psEntry = nullptr;
             if (needsPS)
             {
-                psIt = shaders_.find(pit->second.ps.id);
-                if (psIt == shaders_.end())
+                psEntry = shaders_.Find(pipelineEntry->ps);
+                if (!psEntry)
                 {
-                    throw std::runtime_error(BuildMissingShaderMessage(pit->second, pipelineHandle, curNumRT, "ps"));
+                    throw std::runtime_error(BuildMissingShaderMessage(*pipelineEntry, pipelineHandle, curNumRT, "ps"));
                 }
             }
 
-            auto layIt = layouts_.find(layout.id);
-            if (layIt == layouts_.end())
+            auto* layoutEntry = layouts_.Find(layout);
+            if (!layoutEntry)
             {
                 throw std::runtime_error("DX12: input layout handle not found");
             }
@@ -160,10 +180,10 @@ void SubmitCommandList(CommandList&& commandList) override
             D3D12_GRAPHICS_PIPELINE_STATE_DESC pipelineDesc{};
             pipelineDesc.pRootSignature = rootSig_.Get();
 
-            pipelineDesc.VS = { vsIt->second.blob->GetBufferPointer(), vsIt->second.blob->GetBufferSize() };
+            pipelineDesc.VS = { vsEntry->blob->GetBufferPointer(), vsEntry->blob->GetBufferSize() };
             if (needsPS)
             {
-                pipelineDesc.PS = { psIt->second.blob->GetBufferPointer(), psIt->second.blob->GetBufferSize() };
+                pipelineDesc.PS = { psEntry->blob->GetBufferPointer(), psEntry->blob->GetBufferSize() };
             }
             else
             {
@@ -233,8 +253,8 @@ void SubmitCommandList(CommandList&& commandList) override
             pipelineDesc.DepthStencilState.BackFace.StencilPassOp = ToD3DStencilOp(curState.depth.stencil.back.passOp);
             pipelineDesc.DepthStencilState.BackFace.StencilFunc = ToD3DCompare(curState.depth.stencil.back.compareOp);
 
-            pipelineDesc.InputLayout = { layIt->second.elems.data(), static_cast<UINT>(layIt->second.elems.size()) };
-            pipelineDesc.PrimitiveTopologyType = ToD3DTopologyType(pit->second.topologyType);
+            pipelineDesc.InputLayout = { layoutEntry->elems.data(), static_cast<UINT>(layoutEntry->elems.size()) };
+            pipelineDesc.PrimitiveTopologyType = ToD3DTopologyType(pipelineEntry->topologyType);
 
             pipelineDesc.NumRenderTargets = curNumRT;
             for (UINT i = 0; i < curNumRT; ++i)
@@ -245,9 +265,24 @@ void SubmitCommandList(CommandList&& commandList) override
 
             pipelineDesc.SampleDesc.Count = 1;
 
+            // Persistent cache: a blob compiled by an earlier run lets the driver skip compilation.
+            std::uint64_t cacheKey = 0;
+            const std::vector<std::byte>* cachedBlob = nullptr;
+            bool storeBlob = (pipelineCache_ != nullptr);
+            if (pipelineCache_)
+            {
+                cacheKey = HashPipelineCacheKey(pipelineDesc, *layoutEntry, curState, pipelineEntry->viewInstanceCount);
+                cachedBlob = pipelineCache_->Find(cacheKey);
+                if (cachedBlob)
+                {
+                    pipelineDesc.CachedPSO = { cachedBlob->data(), cachedBlob->size() };
+                }
+            }
+            const auto compileStart = std::chrono::steady_clock::now();
+
             ComPtr<ID3D12PipelineState> pso;
 
-            if (pit->second.viewInstanceCount > 1)
+            if (pipelineEntry->viewInstanceCount > 1)
             {
                 if (!device2_)
                 {
@@ -269,6 +304,7 @@ void SubmitCommandList(CommandList&& commandList) override
                 using SO_DSVFmt = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_DEPTH_STENCIL_FORMAT, DXGI_FORMAT>;
                 using SO_SampleDesc = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_SAMPLE_DESC, DXGI_SAMPLE_DESC>;
                 using SO_ViewInst = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_VIEW_INSTANCING, D3D12_VIEW_INSTANCING_DESC>;
+                using SO_CachedPSO = PSOSubobject<D3D12_PIPELINE_STATE_SUBOBJECT_TYPE_CACHED_PSO, D3D12_CACHED_PIPELINE_STATE>;
 
                 // Each stream subobject must be pointer-aligned, and its size should be a multiple of sizeof(void*)
                 // so the next Type is correctly aligned in the byte stream.
@@ -285,8 +321,9 @@ void SubmitCommandList(CommandList&& commandList) override
                 static_assert(sizeof(SO_DSVFmt) % sizeof(void*) == 0);
                 static_assert(sizeof(SO_SampleDesc) % sizeof(void*) == 0);
                 static_assert(sizeof(SO_ViewInst) % sizeof(void*) == 0);
+                static_assert(sizeof(SO_CachedPSO) % sizeof(void*) == 0);
 
-                const std::uint32_t viewCount = pit->second.viewInstanceCount;
+                const std::uint32_t viewCount = pipelineEntry->viewInstanceCount;
                 std::array<D3D12_VIEW_INSTANCE_LOCATION, 8> locations{};
                 if (viewCount > locations.size())
                 {
@@ -326,6 +363,7 @@ void SubmitCommandList(CommandList&& commandList) override
                     SO_DSVFmt     dsvFmt;
                     SO_SampleDesc sampleDesc;
                     SO_ViewInst   viewInst;
+                    SO_CachedPSO  cachedPso;
                 } stream{};
 
                 stream.rootSig.data = rootSig_.Get();
@@ -341,23 +379,42 @@ void SubmitCommandList(CommandList&& commandList) override
                 stream.dsvFmt.data = pipelineDesc.DSVFormat;
                 stream.sampleDesc.data = pipelineDesc.SampleDesc;
                 stream.viewInst.data = viDesc;
+                stream.cachedPso.data = pipelineDesc.CachedPSO;
 
                 D3D12_PIPELINE_STATE_STREAM_DESC streamDesc{};
                 streamDesc.SizeInBytes = sizeof(stream);
                 streamDesc.pPipelineStateSubobjectStream = &stream;
 
-                const HRESULT hr = device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso));
+                HRESULT hr = device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso));
+                if (FAILED(hr) && cachedBlob)
+                {
+                    // Blob from another driver/adapter: drop it and compile from scratch.
+                    pipelineCache_->Reject(cacheKey);
+                    cachedBlob = nullptr;
+                    pipelineDesc.CachedPSO = {};
+                    stream.cachedPso.data = {};
+                    hr = device2_->CreatePipelineState(&streamDesc, IID_PPV_ARGS(&pso));
+                }
                 if (FAILED(hr))
                 {
                     // View instancing is optional; fail softly so the renderer can fallback to 6-pass.
+                    // The fallback PSO is not what the view-instanced cache key describes, so it is not stored.
+                    storeBlob = false;
                     ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
                         "DX12: CreateGraphicsPipelineState failed");
                 }
             }
             else
             {
-                ThrowIfFailed(NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso)),
-                    "DX12: CreateGraphicsPipelineState failed");
+                HRESULT hr = NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso));
+                if (FAILED(hr) && cachedBlob)
+                {
+                    pipelineCache_->Reject(cacheKey);
+                    cachedBlob = nullptr;
+                    pipelineDesc.CachedPSO = {};
+                    hr = NativeDevice()->CreateGraphicsPipelineState(&pipelineDesc, IID_PPV_ARGS(&pso));
+                }
+                ThrowIfFailed(hr, "DX12: CreateGraphicsPipelineState failed");
             }
 
             if (!pso)
@@ -365,14 +422,102 @@ void SubmitCommandList(CommandList&& commandList) override
                 return nullptr;
             }
 
+            if (pipelineCache_)
+            {
+                pipelineCache_->RecordCompileTime(
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - compileStart).count());
+                if (storeBlob && !cachedBlob)
+                {
+                    StorePipelineBlob(cacheKey, pso.Get());
+                }
+            }
+
             psoCache_[key] = pso;
             return pso.Get();
         };
 
+    // PSO, input assembly and root bindings shared by DrawIndexed and the indirect draws.
+    auto PrepareIndexedDraw = [&](IndexType indexType, std::uint32_t firstIndex)
+        {
+            // PSO + RootSig
+            ID3D12PipelineState* pso = EnsurePSO(curPipe, curLayout);
+            cmdList_->SetPipelineState(pso);
+            cmdList_->SetGraphicsRootSignature(rootSig_.Get());
+
+            // IA bindings (slot0..slotN based on input layout)
+            auto* layoutEntry = layouts_.Find(curLayout);
+            if (!layoutEntry)
+            {
+                throw std::runtime_error("DX12: input layout handle not found");
+            }
+
+            std::uint32_t maxSlot = 0;
+            for (const auto& e : layoutEntry->elems)
+            {
+                maxSlot = std::max(maxSlot, static_cast<std::uint32_t>(e.InputSlot));
+            }
+
+            const std::uint32_t numVB = layoutEntry->elems.empty()
+                ? 0u
+                : (maxSlot + 1u);
+            if (numVB > kMaxVBSlots)
+            {
+                throw std::runtime_error("DX12: input layout uses more VB slots than supported");
+            }
+
+            std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots> vbv{};
+            for (std::uint32_t s = 0; s < numVB; ++s)
+            {
+                if (!vertexBuffers[s])
+                {
+                    throw std::runtime_error("DX12: missing vertex buffer binding for required slot");
+                }
+                auto* vbEntry = buffers_.Find(vertexBuffers[s]);
+                if (!vbEntry)
+                {
+                    throw std::runtime_error("DX12: vertex buffer not found");
+                }
+
+                const std::uint32_t off = vbOffsets[s];
+                vbv[s].BufferLocation = vbEntry->resource->GetGPUVirtualAddress() + off;
+                vbv[s].SizeInBytes = (UINT)(vbEntry->desc.sizeInBytes - off);
+                vbv[s].StrideInBytes = vbStrides[s];
+            }
+            cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
+            cmdList_->IASetPrimitiveTopology(currentTopology);
+
+            if (indexBuffer)
+            {
+                auto* ibEntry = buffers_.Find(indexBuffer);
+                if (!ibEntry)
+                {
+                    throw std::runtime_error("DX12: index buffer not found");
+                }
+                D3D12_INDEX_BUFFER_VIEW ibv{};
+                ibv.BufferLocation = ibEntry->resource->GetGPUVirtualAddress() + ibOffset
+                    + static_cast<UINT64>(firstIndex) * static_cast<UINT64>(IndexSizeBytes(indexType));
+                ibv.SizeInBytes = static_cast<UINT>(ibEntry->desc.sizeInBytes - ibOffset);
+                ibv.Format = (indexType == IndexType::UINT16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+
+                cmdList_->IASetIndexBuffer(&ibv);
+            }
+
+            // Root bindings: CBV (0) + SRV table (1)
+            WriteCBAndBind();
+
+            for (UINT i = 0; i < kMaxSRVSlots; ++i)
+            {
+                cmdList_->SetGraphicsRootDescriptorTable(1 + i, boundTex[i]);
+            }
+
+            constexpr UINT kBindlessRootParam = 1 + kMaxSRVSlots;
+            cmdList_->SetGraphicsRootDescriptorTable(kBindlessRootParam, srvHeap_->GetGPUDescriptorHandleForHeapStart());
+        };
+
     // Parse high-level commands and record native D3D12
-    for (auto& command : commandList.commands)
+    for (const CommandRecord& command : commandList)
     {
-        std::visit([&](auto&& cmd)
+        VisitCommand(command, [&](auto&& cmd)
             {
                 using T = std::decay_t<decltype(cmd)>;
 
@@ -380,7 +525,7 @@ void SubmitCommandList(CommandList&& commandList) override
 #include "DirectX12RHI_Device_Public_CommandSubmission_StateAndBindingCommands.inl"                  
 #include "DirectX12RHI_Device_Public_CommandSubmission_DrawAndImGuiCommands.inl"                        
 
-            }, command);
+            });
     }
 
     // Close + execute + signal fence for the current frame resource
@@ -1,79 +1,30 @@
                         else if constexpr (std::is_same_v<T, CommandDrawIndexed>)
                         {
-                            // PSO + RootSig
-                            ID3D12PipelineState* pso = EnsurePSO(curPipe, curLayout);
-                            cmdList_->SetPipelineState(pso);
-                            cmdList_->SetGraphicsRootSignature(rootSig_.Get());
-
-                            // IA bindings (slot0..slotN based on input layout)
-                            auto layIt = layouts_.find(curLayout.id);
-                            if (layIt == layouts_.end())
-                            {
-                                throw std::runtime_error("DX12: input layout handle not found");
-                            }
-
-                            std::uint32_t maxSlot = 0;
-                            for (const auto& e : layIt->second.elems)
-                            {
-                                maxSlot = std::max(maxSlot, static_cast<std::uint32_t>(e.InputSlot));
-                            }
-
-                            const std::uint32_t numVB = layIt->second.elems.empty()
-                                ? 0u
-                                : (maxSlot + 1u);
-                            if (numVB > kMaxVBSlots)
-                            {
-                                throw std::runtime_error("DX12: input layout uses more VB slots than supported");
-                            }
-
-                            std::array<D3D12_VERTEX_BUFFER_VIEW, kMaxVBSlots> vbv{};
-                            for (std::uint32_t s = 0; s < numVB; ++s)
-                            {
-                                if (!vertexBuffers[s])
-                                {
-                                    throw std::runtime_error("DX12: missing vertex buffer binding for required slot");
-                                }
-                                auto vbIt = buffers_.find(vertexBuffers[s].id);
-                                if (vbIt == buffers_.end())
-                                {
-                                    throw std::runtime_error("DX12: vertex buffer not found");
-                                }
-
-                                const std::uint32_t off = vbOffsets[s];
-                                vbv[s].BufferLocation = vbIt->second.resource->GetGPUVirtualAddress() + off;
-                                vbv[s].SizeInBytes = (UINT)(vbIt->second.desc.sizeInBytes - off);
-                                vbv[s].StrideInBytes = vbStrides[s];
-                            }
-                            cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
-                            cmdList_->IASetPrimitiveTopology(currentTopology);
+                            PrepareIndexedDraw(cmd.indexType, cmd.firstIndex);
+                            cmdList_->DrawIndexedInstanced(cmd.indexCount, cmd.instanceCount, 0, cmd.baseVertex, cmd.firstInstance);
+                        }
+                        else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+                        {
+                            // Records carry StartIndexLocation themselves, so the index buffer view starts at the bound offset.
+                            PrepareIndexedDraw(cmd.indexType, 0);
 
-                            if (indexBuffer)
+                            auto* argsEntry = buffers_.Find(cmd.argsBuffer);
+                            if (!argsEntry || !argsEntry->resource)
                             {
-                                auto ibIt = buffers_.find(indexBuffer.id);
-                                if (ibIt == buffers_.end())
-                                {
-                                    throw std::runtime_error("DX12: index buffer not found");
-                                }
-                                D3D12_INDEX_BUFFER_VIEW ibv{};
-                                ibv.BufferLocation = ibIt->second.resource->GetGPUVirtualAddress() + ibOffset
-                                    + static_cast<UINT64>(cmd.firstIndex) * static_cast<UINT64>(IndexSizeBytes(cmd.indexType));
-                                ibv.SizeInBytes = static_cast<UINT>(ibIt->second.desc.sizeInBytes - ibOffset);
-                                ibv.Format = (cmd.indexType == IndexType::UINT16) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
-
-                                cmdList_->IASetIndexBuffer(&ibv);
+                                throw std::runtime_error("DX12: indirect argument buffer not found");
                             }
-
-                            // Root bindings: CBV (0) + SRV table (1)
-                            WriteCBAndBind();
-
-                            for (UINT i = 0; i < kMaxSRVSlots; ++i)
+                            if ((argsEntry->state & D3D12_RESOURCE_STATE_INDIRECT_ARGUMENT) == 0)
                             {
-                                cmdList_->SetGraphicsRootDescriptorTable(1 + i, boundTex[i]);
+                                TransitionResource(cmdList_.Get(), argsEntry->resource.Get(), argsEntry->state, D3D12_RESOURCE_STATE_GENERIC_READ);
                             }
 
-                            constexpr UINT kBindlessRootParam = 1 + kMaxSRVSlots;
-                            cmdList_->SetGraphicsRootDescriptorTable(kBindlessRootParam, srvHeap_->GetGPUDescriptorHandleForHeapStart());
-                            cmdList_->DrawIndexedInstanced(cmd.indexCount, cmd.instanceCount, 0, cmd.baseVertex, cmd.firstInstance);
+                            cmdList_->ExecuteIndirect(
+                                DrawIndexedCommandSignature(cmd.strideBytes),
+                                cmd.drawCount,
+                                argsEntry->resource.Get(),
+                                static_cast<UINT64>(cmd.argsOffsetBytes),
+                                nullptr,
+                                0);
                         }
                         else if constexpr (std::is_same_v<T, CommandDraw>)
                         {
@@ -82,18 +33,18 @@
                             cmdList_->SetGraphicsRootSignature(rootSig_.Get());
 
                             // IA bindings (slot0..slotN based on input layout)
-                            auto layIt = layouts_.find(curLayout.id);
-                            if (layIt == layouts_.end())
+                            auto* layoutEntry = layouts_.Find(curLayout);
+                            if (!layoutEntry)
                             {
                                 throw std::runtime_error("DX12: input layout handle not found");
                             }
 
                             std::uint32_t maxSlot = 0;
-                            for (const auto& e : layIt->second.elems)
+                            for (const auto& e : layoutEntry->elems)
                             {
                                 maxSlot = std::max(maxSlot, static_cast<std::uint32_t>(e.InputSlot));
                             }
-                            const std::uint32_t numVB = layIt->second.elems.empty()
+                            const std::uint32_t numVB = layoutEntry->elems.empty()
                                 ? 0u
                                 : (maxSlot + 1u);
                             if (numVB > kMaxVBSlots)
@@ -108,15 +59,15 @@
                                 {
                                     throw std::runtime_error("DX12: missing vertex buffer binding for required slot");
                                 }
-                                auto vbIt = buffers_.find(vertexBuffers[s].id);
-                                if (vbIt == buffers_.end())
+                                auto* vbEntry = buffers_.Find(vertexBuffers[s]);
+                                if (!vbEntry)
                                 {
                                     throw std::runtime_error("DX12: vertex buffer not found");
                                 }
 
                                 const std::uint32_t off = vbOffsets[s];
-                                vbv[s].BufferLocation = vbIt->second.resource->GetGPUVirtualAddress() + off;
-                                vbv[s].SizeInBytes = (UINT)(vbIt->second.desc.sizeInBytes - off);
+                                vbv[s].BufferLocation = vbEntry->resource->GetGPUVirtualAddress() + off;
+                                vbv[s].SizeInBytes = (UINT)(vbEntry->desc.sizeInBytes - off);
                                 vbv[s].StrideInBytes = vbStrides[s];
                             }
                             cmdList_->IASetVertexBuffers(0, numVB, vbv.data());
@@ -150,21 +101,21 @@
                         {
                             if (cmd.slot < boundTex.size())
                             {
-                                auto it = textures_.find(cmd.texture.id);
-                                if (it == textures_.end())
+                                auto* textureEntry = textures_.Find(cmd.texture);
+                                if (!textureEntry)
                                 {
                                     throw std::runtime_error("DX12: BindTexture2DArray: texture not found in textures_ map");
                                 }
 
                                 // Ensure an Array SRV exists for cube textures.
-                                if (!it->second.hasSRVArray)
+                                if (!textureEntry->hasSRVArray)
                                 {
-                                    const auto desc = it->second.resource->GetDesc();
-                                    AllocateSRV_CubeAsArray(it->second, it->second.srvFormat, desc.MipLevels);
+                                    const auto desc = textureEntry->resource->GetDesc();
+                                    AllocateSRV_CubeAsArray(*textureEntry, textureEntry->srvFormat, desc.MipLevels);
                                 }
 
                                 TransitionTexture(cmd.texture, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
-                                boundTex[cmd.slot] = it->second.srvGpuArray;
+                                boundTex[cmd.slot] = textureEntry->srvGpuArray;
                             }
                             }
                         else
@@ -40,13 +40,13 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
             const TextureHandle depthTex = sc->GetDepthTexture();
             if (depthTex)
             {
-                auto it = textures_.find(depthTex.id);
-                if (it == textures_.end())
+                auto* textureEntry = textures_.Find(depthTex);
+                if (!textureEntry)
                 {
                     throw std::runtime_error("DX12: CommandBeginPass: swapchain depth texture not found");
                 }
 
-                auto& te = it->second;
+                auto& te = *textureEntry;
                 if (!te.hasDSV)
                 {
                     throw std::runtime_error("DX12: CommandBeginPass: swapchain depth texture has no DSV");
@@ -86,13 +86,13 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
     else
     {
         // ----- Offscreen framebuffer pass -----
-        auto fbIt = framebuffers_.find(pass.frameBuffer.id);
-        if (fbIt == framebuffers_.end())
+        auto* fbEntry = framebuffers_.Find(pass.frameBuffer);
+        if (!fbEntry)
         {
             throw std::runtime_error("DX12: CommandBeginPass: framebuffer not found");
         }
 
-        const FramebufferEntry& fb = fbIt->second;
+        const FramebufferEntry& fb = *fbEntry;
 
         // Color (0..8 RT)
         if (fb.colorCount > 0)
@@ -104,12 +104,12 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
                 {
                     throw std::runtime_error("DX12: CommandBeginPass: cubemap render requires exactly one color attachment");
                 }
-                auto it = textures_.find(fb.colors[0].id);
-                if (it == textures_.end())
+                auto* textureEntry = textures_.Find(fb.colors[0]);
+                if (!textureEntry)
                 {
                     throw std::runtime_error("DX12: CommandBeginPass: framebuffer color texture not found");
                 }
-                auto& te = it->second;
+                auto& te = *textureEntry;
                 if (fb.colorCubeAllFaces)
                 {
                     if (!te.hasRTVAllFaces)
@@ -169,12 +169,12 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
                     {
                         throw std::runtime_error("DX12: CommandBeginPass: framebuffer color attachment is null");
                     }
-                    auto it = textures_.find(th.id);
-                    if (it == textures_.end())
+                    auto* textureEntry = textures_.Find(th);
+                    if (!textureEntry)
                     {
                         throw std::runtime_error("DX12: CommandBeginPass: framebuffer color texture not found");
                     }
-                    auto& te = it->second;
+                    auto& te = *textureEntry;
                     if (!te.hasRTV)
                     {
                         throw std::runtime_error("DX12: CommandBeginPass: color texture has no RTV");
@@ -193,13 +193,13 @@ if constexpr (std::is_same_v<T, CommandBeginPass>)
         // Depth
         if (fb.depth)
         {
-            auto it = textures_.find(fb.depth.id);
-            if (it == textures_.end())
+            auto* textureEntry = textures_.Find(fb.depth);
+            if (!textureEntry)
             {
                 throw std::runtime_error("DX12: CommandBeginPass: framebuffer depth texture not found");
             }
 
-            auto& te = it->second;
+            auto& te = *textureEntry;
 
             if (fb.colorCubeAllFaces && te.hasDSVAllFaces)
             {
@@ -272,6 +272,42 @@ else if constexpr (std::is_same_v<T, CommandEndPass>)
         TransitionBackBuffer(*curSwapChain, D3D12_RESOURCE_STATE_PRESENT);
     }
 }
+else if constexpr (std::is_same_v<T, CommandTransitionTextures>)
+{
+    // Planned by the render graph: issue the whole batch with one ResourceBarrier call.
+    // The tracked state stays authoritative for StateBefore, so Unknown sources and
+    // textures touched outside the graph are still handled correctly.
+    barrierBatch.clear();
+    for (const TextureBarrier& planned : cmd.barriers)
+    {
+        auto* textureEntry = textures_.Find(planned.texture);
+        if (!textureEntry || !textureEntry->resource)
+        {
+            continue;
+        }
+
+        const D3D12_RESOURCE_STATES desired = ToD3DResourceState(planned.after);
+        if (textureEntry->state == desired)
+        {
+            continue;
+        }
+
+        D3D12_RESOURCE_BARRIER barrier{};
+        barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource = textureEntry->resource.Get();
+        barrier.Transition.StateBefore = textureEntry->state;
+        barrier.Transition.StateAfter = desired;
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrierBatch.push_back(barrier);
+        textureEntry->state = desired;
+    }
+
+    if (!barrierBatch.empty())
+    {
+        cmdList_->ResourceBarrier(static_cast<UINT>(barrierBatch.size()), barrierBatch.data());
+    }
+}
 else if constexpr (std::is_same_v<T, CommandSetViewport>)
 {
     D3D12_VIEWPORT viewport{};
@@ -38,13 +38,13 @@
                         {
                             if (cmd.slot < boundTex.size())
                             {
-                                auto it = textures_.find(cmd.texture.id);
-                                if (it == textures_.end())
+                                auto* textureEntry = textures_.Find(cmd.texture);
+                                if (!textureEntry)
                                 {
                                     throw std::runtime_error("DX12: BindTexture2D: texture not found in textures_ map");
                                 }
 
-                                if (!it->second.hasSRV)
+                                if (!textureEntry->hasSRV)
                                 {
                                     throw std::runtime_error("DX12: BindTexture2D: texture has no SRV");
                                 }
@@ -57,13 +57,13 @@
                         {
                             if (cmd.slot < boundTex.size())
                             {
-                                auto it = textures_.find(cmd.texture.id);
-                                if (it == textures_.end())
+                                auto* textureEntry = textures_.Find(cmd.texture);
+                                if (!textureEntry)
                                 {
                                     throw std::runtime_error("DX12: BindTextureCube: texture not found in textures_ map");
                                 }
 
-                                if (!it->second.hasSRV)
+                                if (!textureEntry->hasSRV)
                                 {
                                     throw std::runtime_error("DX12: BindTextureCube: texture has no SRV");
                                 }
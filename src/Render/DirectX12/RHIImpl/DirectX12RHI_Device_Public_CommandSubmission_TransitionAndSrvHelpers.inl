@@ -5,12 +5,11 @@ auto ResolveTextureHandleFromDesc = [&](TextureDescIndex idx) -> TextureHandle
             return {};
         }
 
-        auto it = descToTex_.find(idx);
-        if (it == descToTex_.end())
+        if (idx >= descToTex_.size() || !descToTex_[idx])
         {
             throw std::runtime_error("DX12: TextureDescIndex not mapped");
         }
-        return it->second;
+        return *descToTex_[idx];
     };
 
 auto GetTextureSRV = [&](TextureHandle textureHandle) -> D3D12_GPU_DESCRIPTOR_HANDLE
@@ -19,16 +18,16 @@ auto GetTextureSRV = [&](TextureHandle textureHandle) -> D3D12_GPU_DESCRIPTOR_HA
         {
             return srvHeap_->GetGPUDescriptorHandleForHeapStart();
         }
-        auto it = textures_.find(textureHandle.id);
-        if (it == textures_.end())
+        auto* textureEntry = textures_.Find(textureHandle);
+        if (!textureEntry)
         {
             return srvHeap_->GetGPUDescriptorHandleForHeapStart();
         }
-        if (!it->second.hasSRV)
+        if (!textureEntry->hasSRV)
         {
             return srvHeap_->GetGPUDescriptorHandleForHeapStart();
         }
-        return it->second.srvGpu;
+        return textureEntry->srvGpu;
     };
 
 auto NullBufferSRV = [&]() -> D3D12_GPU_DESCRIPTOR_HANDLE
@@ -45,16 +44,16 @@ auto GetBufferSRV = [&](BufferHandle bufferHandle) -> D3D12_GPU_DESCRIPTOR_HANDL
             return NullBufferSRV();
         }
 
-        auto it = buffers_.find(bufferHandle.id);
-        if (it == buffers_.end())
+        auto* bufferEntry = buffers_.Find(bufferHandle);
+        if (!bufferEntry)
         {
             return NullBufferSRV();
         }
 
-        if (!it->second.hasSRV)
+        if (!bufferEntry->hasSRV)
         {
             return NullBufferSRV();
         }
 
-        return it->second.srvGpu;
+        return bufferEntry->srvGpu;
     };
\ No newline at end of file
@@ -43,24 +43,7 @@
                     "DX12: Map per-frame constant upload buffer failed");
 
                 // Per-frame buffer upload ring (persistently mapped).
-                D3D12_RESOURCE_DESC bufDesc = resourceDesc;
-                bufDesc.Width = static_cast<UINT64>(kPerFrameBufUploadBytes);
-
-                ThrowIfFailed(NativeDevice()->CreateCommittedResource(
-                    &heapProps,
-                    D3D12_HEAP_FLAG_NONE,
-                    &bufDesc,
-                    D3D12_RESOURCE_STATE_GENERIC_READ,
-                    nullptr,
-                    IID_PPV_ARGS(&frames_[i].bufUpload)),
-                    "DX12: Create per-frame buffer upload ring failed");
-
-                void* bufMapped = nullptr;
-                ThrowIfFailed(frames_[i].bufUpload->Map(0, nullptr, &bufMapped),
-                    "DX12: Map per-frame buffer upload ring failed");
-
-                frames_[i].bufMapped = reinterpret_cast<std::byte*>(bufMapped);
-                frames_[i].bufCursor = 0;
+                CreateBufferUploadRing(frames_[i], kPerFrameBufUploadBytes);
 
                 frames_[i].cbMapped = reinterpret_cast<std::byte*>(mapped);
                 frames_[i].cbCursor = 0;
@@ -159,12 +142,13 @@
                     fr.bufMapped = nullptr;
                 }
 
-                fr.deferredResources.clear();
-                fr.deferredFreeSrv.clear();
-                fr.deferredFreeRtv.clear();
-                fr.deferredFreeDsv.clear();
             }
 
+            deferredResources_.Clear();
+            deferredFreeSrv_.Clear();
+            deferredFreeRtv_.Clear();
+            deferredFreeDsv_.Clear();
+
             if (fenceEvent_)
             {
                 CloseHandle(fenceEvent_);
@@ -176,29 +160,29 @@
 
         void ReplaceSampledTextureResource(rhi::TextureHandle textureHandle, ID3D12Resource* newRes, DXGI_FORMAT fmt, UINT mipLevels)
         {
-            auto it = textures_.find(textureHandle.id);
-            if (it == textures_.end())
+            auto* textureEntry = textures_.Find(textureHandle);
+            if (!textureEntry)
             {
                 throw std::runtime_error("DX12: ReplaceSampledTextureResource: texture handle not found");
             }
 
-            it->second.resource.Reset();
-            it->second.resource.Attach(newRes); // takes ownership (AddRef already implied by Attach contract)
+            textureEntry->resource.Reset();
+            textureEntry->resource.Attach(newRes); // takes ownership (AddRef already implied by Attach contract)
 
             // Keep the same descriptor slot if we already had an SRV; just rewrite it.
-            if (it->second.hasSRV && it->second.srvIndex != 0)
+            if (textureEntry->hasSRV && textureEntry->srvIndex != 0)
             {
                 D3D12_CPU_DESCRIPTOR_HANDLE cpu = srvHeap_->GetCPUDescriptorHandleForHeapStart();
-                cpu.ptr += static_cast<SIZE_T>(it->second.srvIndex) * srvInc_;
+                cpu.ptr += static_cast<SIZE_T>(textureEntry->srvIndex) * srvInc_;
 
                 D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
                 srvDesc.Format = fmt;
                 srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                srvDesc.ViewDimension = (it->second.type == TextureEntry::Type::Cube)
+                srvDesc.ViewDimension = (textureEntry->type == TextureEntry::Type::Cube)
                     ? D3D12_SRV_DIMENSION_TEXTURECUBE
                     : D3D12_SRV_DIMENSION_TEXTURE2D;
 
-                if (it->second.type == TextureEntry::Type::Cube)
+                if (textureEntry->type == TextureEntry::Type::Cube)
                 {
                     srvDesc.TextureCube.MostDetailedMip = 0;
                     srvDesc.TextureCube.MipLevels = mipLevels;
@@ -213,19 +197,19 @@
                 }
 
                 const D3D12_RESOURCE_DESC resourceDesc = newRes->GetDesc();
-                it->second.extent = Extent2D{
+                textureEntry->extent = Extent2D{
                     static_cast<std::uint32_t>(resourceDesc.Width),
                     static_cast<std::uint32_t>(resourceDesc.Height) };
-                it->second.resourceFormat = resourceDesc.Format;
-                it->second.srvFormat = fmt;
-                it->second.state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+                textureEntry->resourceFormat = resourceDesc.Format;
+                textureEntry->srvFormat = fmt;
+                textureEntry->state = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
 
-                NativeDevice()->CreateShaderResourceView(it->second.resource.Get(), &srvDesc, cpu);
+                NativeDevice()->CreateShaderResourceView(textureEntry->resource.Get(), &srvDesc, cpu);
             }
             else
             {
-                it->second.hasSRV = false;
-                AllocateSRV(it->second, fmt, mipLevels);
+                textureEntry->hasSRV = false;
+                AllocateSRV(*textureEntry, fmt, mipLevels);
             }
         } /// DX12Device
 
@@ -236,7 +220,6 @@
                 return {};
             }
 
-            TextureHandle textureHandle{ ++nextTexId_ };
             TextureEntry textureEntry{};
 
             const D3D12_RESOURCE_DESC resourceDesc = res->GetDesc();
@@ -253,8 +236,7 @@
 
             AllocateSRV(textureEntry, fmt, mipLevels);
 
-            textures_[textureHandle.id] = std::move(textureEntry);
-            return textureHandle;
+            return textures_.Insert(std::move(textureEntry));
         }
 
         TextureHandle RegisterSampledTextureCube(ID3D12Resource* res, DXGI_FORMAT fmt, UINT mipLevels)
@@ -264,7 +246,6 @@
                 return {};
             }
 
-            TextureHandle textureHandle{ ++nextTexId_ };
             TextureEntry textureEntry{};
 
             const D3D12_RESOURCE_DESC resourceDesc = res->GetDesc();
@@ -282,8 +263,7 @@
 
             AllocateSRV(textureEntry, fmt, mipLevels);
 
-            textures_[textureHandle.id] = std::move(textureEntry);
-            return textureHandle;
+            return textures_.Insert(std::move(textureEntry));
         }
 
         std::string_view GetName() const override
@@ -300,6 +280,11 @@
             return Backend::DirectX12;
         }
 
+        std::uint32_t GetFramesInFlight() const noexcept override
+        {
+            return kFramesInFlight;
+        }
+
         bool SupportsShaderModel6() const override
         {
             return supportsSM6_1_;
@@ -23,6 +23,10 @@
             }
 
             // Keep mapping for transitions / validation.
+            if (idx >= descToTex_.size())
+            {
+                descToTex_.resize(static_cast<std::size_t>(idx) + 1u);
+            }
             descToTex_[idx] = tex;
 
             D3D12_CPU_DESCRIPTOR_HANDLE dst = srvHeap_->GetCPUDescriptorHandleForHeapStart();
@@ -36,13 +40,13 @@
                 return;
             }
 
-            auto it = textures_.find(tex.id);
-            if (it == textures_.end())
+            auto* textureEntry = textures_.Find(tex);
+            if (!textureEntry)
             {
                 throw std::runtime_error("DX12: UpdateTextureDescriptor: texture not found");
             }
 
-            auto& te = it->second;
+            auto& te = *textureEntry;
             if (!te.resource)
             {
                 throw std::runtime_error("DX12: UpdateTextureDescriptor: texture has no resource");
@@ -80,13 +84,28 @@
 
         void FreeTextureDescriptor(TextureDescIndex index) noexcept override
         {
-            descToTex_.erase(index);
-
             if (index == 0 || static_cast<UINT>(index) >= kSrvHeapNumDescriptors)
             {
                 return;
             }
 
+            // A second free would queue the slot twice and hand it to two owners later.
+            if (srvSlotFreed_.empty())
+            {
+                srvSlotFreed_.resize(kSrvHeapNumDescriptors, false);
+            }
+            assert(!srvSlotFreed_[index] && "FreeTextureDescriptor: slot freed twice");
+            if (srvSlotFreed_[index])
+            {
+                return;
+            }
+            srvSlotFreed_[index] = true;
+
+            if (index < descToTex_.size())
+            {
+                descToTex_[index].reset();
+            }
+
             // Overwrite freed slot with null Texture2D SRV (slot 0).
             D3D12_CPU_DESCRIPTOR_HANDLE dst = srvHeap_->GetCPUDescriptorHandleForHeapStart();
             dst.ptr += static_cast<SIZE_T>(index) * srvInc_;
@@ -95,33 +114,88 @@
             NativeDevice()->CopyDescriptorsSimple(1, dst, src, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
             // Recycle after GPU fence for safety.
-            CurrentFrame().deferredFreeSrv.push_back(static_cast<UINT>(index));
+            deferredFreeSrv_.Defer(static_cast<UINT>(index));
+        }
+
+        TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+        {
+            // Always carved from the untouched tail of the heap: recycled slots are scattered.
+            const UINT first = nextSrvIndex_;
+            if (count > kSrvHeapNumDescriptors - first)
+            {
+                throw std::runtime_error("DX12: ReserveTextureDescriptorRange: SRV heap exhausted (increase SRV heap NumDescriptors).");
+            }
+            nextSrvIndex_ += count;
+
+            for (UINT i = 0; i < count; ++i)
+            {
+                UpdateTextureDescriptor(static_cast<TextureDescIndex>(first + i), TextureHandle{});
+            }
+            return static_cast<TextureDescIndex>(first);
         }
 
-        // ---------------- Fences (minimal impl) ----------------
+        void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+        {
+            for (std::uint32_t i = 0; i < count; ++i)
+            {
+                FreeTextureDescriptor(first + i);
+            }
+        }
+
+        // ---------------- Fences (values on the queue timeline) ----------------
+        static constexpr UINT64 kFenceNotSignaled = std::numeric_limits<UINT64>::max();
+
         FenceHandle CreateFence(bool signaled = false) override
         {
-            const auto id = ++nextFenceId_;
-            fences_[id] = signaled;
-            return FenceHandle{ id };
+            return fences_.Emplace(signaled ? UINT64{ 0 } : kFenceNotSignaled);
         }
 
         void DestroyFence(FenceHandle fence) noexcept override
         {
-            fences_.erase(fence.id);
+            fences_.Erase(fence);
         }
 
+        // Completes once the GPU finished everything submitted before this call.
         void SignalFence(FenceHandle fence) override
         {
-            fences_[fence.id] = true;
+            if (UINT64* value = fences_.Find(fence))
+            {
+                *value = SignalTimeline();
+            }
         }
 
-        void WaitFence(FenceHandle) override {}
+        void WaitFence(FenceHandle fence) override
+        {
+            const UINT64* value = fences_.Find(fence);
+            // Waiting on a fence nobody signaled would never return; treat it like an unknown fence.
+            if (value && *value != kFenceNotSignaled)
+            {
+                WaitForFence(*value);
+            }
+        }
 
         bool IsFenceSignaled(FenceHandle fence) override
         {
-            auto it = fences_.find(fence.id);
-            return it != fences_.end() && it->second;
+            const UINT64* value = fences_.Find(fence);
+            return value && *value != kFenceNotSignaled && fence_->GetCompletedValue() >= *value;
+        }
+
+        // ---------------- Timeline (shares fence_ with frame submission) ----------------
+        std::uint64_t SignalTimeline() override
+        {
+            const UINT64 v = ++fenceValue_;
+            ThrowIfFailed(NativeQueue()->Signal(fence_.Get(), v), "DX12: SignalTimeline - Signal failed");
+            return v;
+        }
+
+        std::uint64_t GetCompletedTimelineValue() override
+        {
+            return fence_->GetCompletedValue();
+        }
+
+        void WaitTimelineValue(std::uint64_t value) override
+        {
+            WaitForFence(value);
         }
 
         ID3D12Device* NativeDevice() const
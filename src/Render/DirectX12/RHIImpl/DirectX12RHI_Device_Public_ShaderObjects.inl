@@ -1,8 +1,8 @@
         InputLayoutHandle CreateInputLayout(const InputLayoutDesc& desc) override
         {
-            InputLayoutHandle handle{ ++nextLayoutId_ };
             InputLayoutEntry inputLayoutEntry{};
             inputLayoutEntry.strideBytes = desc.strideBytes;
+            inputLayoutEntry.contentHash = PipelineKeyHasher{}.Add(desc).Value();
 
             inputLayoutEntry.semanticStorage.reserve(desc.attributes.size());
             inputLayoutEntry.elems.reserve(desc.attributes.size());
@@ -27,19 +27,17 @@
                 inputLayoutEntry.elems.push_back(elemDesc);
             }
 
-            layouts_[handle.id] = std::move(inputLayoutEntry);
-            return handle;
+            return layouts_.Insert(std::move(inputLayoutEntry));
         }
 
         void DestroyInputLayout(InputLayoutHandle layout) noexcept override
         {
-            layouts_.erase(layout.id);
+            layouts_.Erase(layout);
         }
 
         // ---------------- Shaders / Pipelines ----------------
         ShaderHandle CreateShader(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode) override
         {
-            ShaderHandle handle{ ++nextShaderId_ };
             ShaderEntry shaderEntry{};
             shaderEntry.stage = stage;
             shaderEntry.name = std::string(debugName);
@@ -88,19 +86,23 @@
             }
 
             shaderEntry.blob = code;
-            shaders_[handle.id] = std::move(shaderEntry);
-            return handle;
+            return shaders_.Insert(std::move(shaderEntry));
         }
 
         void DestroyShader(ShaderHandle shader) noexcept override
         {
-            shaders_.erase(shader.id);
+            shaders_.Erase(shader);
         }
 
         void DestroyPipeline(PipelineHandle pso) noexcept override
         {
-            pipelines_.erase(pso.id);
+            pipelines_.Erase(pso);
             // TODO: PSO cache entries - it can be cleared indpendtly - but right here it is ok
         }
 
+        void SetPipelineCache(PipelineCache* cache) override
+        {
+            pipelineCache_ = cache;
+        }
+
         // ---------------- Submission ----------------
@@ -58,14 +58,12 @@
                 throw std::runtime_error(msg);
             }
 
-            ShaderHandle handle{ ++nextShaderId_ };
             ShaderEntry shaderEntry{};
             shaderEntry.stage = stage;
             shaderEntry.name = std::string(debugName);
             shaderEntry.blob = code;
 
-            shaders_[handle.id] = std::move(shaderEntry);
-            return handle;
+            return shaders_.Insert(std::move(shaderEntry));
 #else
             // Built without dxcapi.h; cannot compile SM6 shaders.
             std::string msg = "DX12: SM6.1 shader requested, but this build has CORE_DX12_HAS_DXC=0 (shader='";
@@ -93,7 +91,7 @@
                 msg += "')";
                 throw std::runtime_error(msg);
             }
-            if (shaders_.find(vertexShader.id) == shaders_.end())
+            if (!shaders_.Contains(vertexShader))
             {
                 std::string msg = "DX12: CreatePipelineEx: vertex shader handle not found (pipeline='";
                 msg += std::string(debugName);
@@ -102,7 +100,7 @@
                 msg += ")";
                 throw std::runtime_error(msg);
             }
-            if (pixelShader && shaders_.find(pixelShader.id) == shaders_.end())
+            if (pixelShader && !shaders_.Contains(pixelShader))
             {
                 std::string msg = "DX12: CreatePipelineEx: pixel shader handle not found (pipeline='";
                 msg += std::string(debugName);
@@ -112,15 +110,13 @@
                 throw std::runtime_error(msg);
             }
 
-            PipelineHandle handle{ ++nextPsoId_ };
             PipelineEntry pipelineEntry{};
             pipelineEntry.debugName = std::string(debugName);
             pipelineEntry.vs = vertexShader;
             pipelineEntry.ps = pixelShader;
             pipelineEntry.topologyType = topologyType;
             pipelineEntry.viewInstanceCount = viewInstanceCount;
-            pipelines_[handle.id] = std::move(pipelineEntry);
-            return handle;
+            return pipelines_.Insert(std::move(pipelineEntry));
         }
 
         PipelineHandle CreatePipeline(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType) override
@@ -1,6 +1,5 @@
         TextureHandle CreateTexture2D(Extent2D extent, Format format) override
         {
-            TextureHandle textureHandle{ ++nextTexId_ };
             TextureEntry textureEntry{};
             textureEntry.extent = extent;
             textureEntry.format = format;
@@ -108,13 +107,11 @@
                 AllocateSRV(textureEntry, dxFmt, 1);
             }
 
-            textures_[textureHandle.id] = std::move(textureEntry);
-            return textureHandle;
+            return textures_.Insert(std::move(textureEntry));
         }
 
         TextureHandle CreateTextureCube(Extent2D extent, Format format) override
         {
-            TextureHandle textureHandle{ ++nextTexId_ };
             TextureEntry textureEntry{};
             textureEntry.extent = extent;
             textureEntry.format = format;
@@ -260,8 +257,7 @@
                 AllocateSRV(textureEntry, dxFmt, mipLevels);
             }
 
-            textures_[textureHandle.id] = std::move(textureEntry);
-            return textureHandle;
+            return textures_.Insert(std::move(textureEntry));
         }
 
         void DestroyTexture(TextureHandle texture) noexcept override
@@ -271,67 +267,66 @@
                 return;
             }
 
-            auto it = textures_.find(texture.id);
-            if (it == textures_.end())
+            auto* textureEntry = textures_.Find(texture);
+            if (!textureEntry)
             {
                 return;
             }
 
-            TextureEntry entry = std::move(it->second);
-            textures_.erase(it);
+            TextureEntry entry = std::move(*textureEntry);
+            textures_.Erase(texture);
 
             // Keep the resource alive until GPU finishes the frame that referenced it.
             if (entry.resource)
             {
-                CurrentFrame().deferredResources.push_back(std::move(entry.resource));
+                deferredResources_.Defer(std::move(entry.resource));
             }
 
             // Recycle SRV index after the frame fence is completed (see BeginFrame()).
             if (entry.hasSRV && entry.srvIndex != 0)
             {
-                CurrentFrame().deferredFreeSrv.push_back(entry.srvIndex);
+                deferredFreeSrv_.Defer(entry.srvIndex);
             }
             // If we also created a cube-as-array SRV, recycle it too.
             if (entry.hasSRVArray && entry.srvIndexArray != 0)
             {
-                CurrentFrame().deferredFreeSrv.push_back(entry.srvIndexArray);
+                deferredFreeSrv_.Defer(entry.srvIndexArray);
             }
             if (entry.hasRTV)
             {
-                CurrentFrame().deferredFreeRtv.push_back(entry.rtvIndex);
+                deferredFreeRtv_.Defer(entry.rtvIndex);
             }
             if (entry.hasRTVFaces)
             {
                 for (UINT idx : entry.rtvIndexFaces)
                 {
-                    CurrentFrame().deferredFreeRtv.push_back(idx);
+                    deferredFreeRtv_.Defer(idx);
                 }
                 if (entry.rtvIndexMipFaces.size() > 6u)
                 {
                     for (std::size_t i = 6; i < entry.rtvIndexMipFaces.size(); ++i)
                     {
-                        CurrentFrame().deferredFreeRtv.push_back(entry.rtvIndexMipFaces[i]);
+                        deferredFreeRtv_.Defer(entry.rtvIndexMipFaces[i]);
                     }
                 }
             }
             if (entry.hasRTVAllFaces)
             {
-                CurrentFrame().deferredFreeRtv.push_back(entry.rtvIndexAllFaces);
+                deferredFreeRtv_.Defer(entry.rtvIndexAllFaces);
             }
             if (entry.hasDSV)
             {
-                CurrentFrame().deferredFreeDsv.push_back(entry.dsvIndex);
+                deferredFreeDsv_.Defer(entry.dsvIndex);
             }
             if (entry.hasDSVAllFaces)
             {
-                CurrentFrame().deferredFreeDsv.push_back(entry.dsvIndexAllFaces);
+                deferredFreeDsv_.Defer(entry.dsvIndexAllFaces);
             }
         }
 
         // ---------------- Framebuffers ----------------
         FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) override
         {
-            FrameBufferHandle frameBuffer{ ++nextFBId_ };
             FramebufferEntry frameBufEntry{};
             if (color.id != 0)
             {
@@ -339,14 +334,12 @@
                 frameBufEntry.colorCount = 1u;
             }
             frameBufEntry.depth = depth;
-            framebuffers_[frameBuffer.id] = frameBufEntry;
-            return frameBuffer;
+            return framebuffers_.Insert(frameBufEntry);
         }
 
 
         FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth) override
         {
-            FrameBufferHandle frameBuffer{ ++nextFBId_ };
             FramebufferEntry frameBufEntry{};
             const std::size_t count = std::min<std::size_t>(colors.size(), FramebufferEntry::kMaxColorAttachments);
             frameBufEntry.colorCount = static_cast<std::uint32_t>(count);
@@ -357,46 +350,39 @@
             }
 
             frameBufEntry.depth = depth;
-            framebuffers_[frameBuffer.id] = frameBufEntry;
-            return frameBuffer;
+            return framebuffers_.Insert(frameBufEntry);
         }
 
         FrameBufferHandle CreateFramebufferCube(TextureHandle colorCube, TextureHandle depthCube) override
         {
-            FrameBufferHandle frameBuffer{ ++nextFBId_ };
             FramebufferEntry frameBufEntry{};
             frameBufEntry.colors[0] = colorCube;
             frameBufEntry.colorCount = 1u;
             frameBufEntry.depth = depthCube;
             frameBufEntry.colorCubeAllFaces = true;
-            framebuffers_[frameBuffer.id] = frameBufEntry;
-            return frameBuffer;
+            return framebuffers_.Insert(frameBufEntry);
         }
 
         FrameBufferHandle CreateFramebufferCubeFace(TextureHandle colorCube, std::uint32_t faceIndex, TextureHandle depth) override
         {
-            FrameBufferHandle frameBuffer{ ++nextFBId_ };
             FramebufferEntry frameBufEntry{};
             frameBufEntry.colors[0] = colorCube;
             frameBufEntry.colorCount = 1u;
             frameBufEntry.depth = depth;
             frameBufEntry.colorCubeFace = faceIndex;
             frameBufEntry.colorCubeMip = 0u;
-            framebuffers_[frameBuffer.id] = frameBufEntry;
-            return frameBuffer;
+            return framebuffers_.Insert(frameBufEntry);
         }
 
         FrameBufferHandle CreateFramebufferCubeFaceMip(TextureHandle colorCube, std::uint32_t faceIndex, std::uint32_t mipLevel, TextureHandle depth) override
         {
-            FrameBufferHandle frameBuffer{ ++nextFBId_ };
             FramebufferEntry frameBufEntry{};
             frameBufEntry.colors[0] = colorCube;
             frameBufEntry.colorCount = 1u;
             frameBufEntry.depth = depth;
             frameBufEntry.colorCubeFace = faceIndex;
             frameBufEntry.colorCubeMip = mipLevel;
-            framebuffers_[frameBuffer.id] = frameBufEntry;
-            return frameBuffer;
+            return framebuffers_.Insert(frameBufEntry);
         }
 
         void DestroyFramebuffer(FrameBufferHandle frameBuffer) noexcept override
@@ -405,7 +391,7 @@
             {
                 return;
             }
-            framebuffers_.erase(frameBuffer.id);
+            framebuffers_.Erase(frameBuffer);
         }
 
         // ---------------- Buffers ----------------
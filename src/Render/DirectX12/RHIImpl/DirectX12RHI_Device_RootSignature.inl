@@ -27,6 +27,10 @@ void CreateRootSignature()
     //  t18 env cube alias as Texture2DArray<float4> (same resource, 6 slices)
     //  t19 bone palette (StructuredBuffer<float4x4>) for GPU skinning in vertex shaders
     //
+    //  Deferred lighting resolve (DeferredLighting_dx12.hlsl):
+    //  t20 per-cluster light ranges (StructuredBuffer<uint2>: offset, count)
+    //  t21 clustered light indices (StructuredBuffer<uint>)
+    //
     // Bindless SRV array for SM6 shaders lives in space1:
     //  Texture2D gBindlessTex[] : register(t0, space1);
     //
@@ -207,3 +211,25 @@ void CreateRootSignature()
         IID_PPV_ARGS(rootSig_.ReleaseAndGetAddressOf())),
         "DX12: CreateRootSignature failed");
 }
+
+// Draw-only signature: no root arguments change per record, so no root signature is attached.
+ID3D12CommandSignature* DrawIndexedCommandSignature(UINT strideBytes)
+{
+    if (auto it = drawIndexedSignatures_.find(strideBytes); it != drawIndexedSignatures_.end())
+    {
+        return it->second.Get();
+    }
+
+    D3D12_INDIRECT_ARGUMENT_DESC argument{};
+    argument.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+    D3D12_COMMAND_SIGNATURE_DESC desc{};
+    desc.ByteStride = strideBytes;
+    desc.NumArgumentDescs = 1;
+    desc.pArgumentDescs = &argument;
+
+    ComPtr<ID3D12CommandSignature> signature;
+    ThrowIfFailed(NativeDevice()->CreateCommandSignature(&desc, nullptr, IID_PPV_ARGS(&signature)),
+        "DX12: CreateCommandSignature failed");
+    return drawIndexedSignatures_.emplace(strideBytes, std::move(signature)).first->second.Get();
+}
@@ -42,6 +42,8 @@ UINT srvInc_{ 0 };
 
 UINT nextSrvIndex_{ 1 };
 std::vector<UINT> freeSrv_;
+// Texture descriptor slots freed and not yet handed out again (pending the fence or on freeSrv_).
+std::vector<bool> srvSlotFreed_;
 
 // RTV/DSV heaps for transient textures (swapchain has its own RTV/DSV)
 ComPtr<ID3D12DescriptorHeap> rtvHeap_;
@@ -53,27 +55,30 @@ UINT nextDSV_{ 0 };
 std::vector<UINT> freeRTV_;
 std::vector<UINT> freeDSV_;
 
+// Objects released while the GPU may still use them, keyed by the fence value of the submission that
+// retires them (sealed in EndFrame(), retired once fence_ reaches the value).
+DeferredReleaseQueue<ComPtr<ID3D12Resource>> deferredResources_;
+DeferredReleaseQueue<UINT> deferredFreeSrv_;
+DeferredReleaseQueue<UINT> deferredFreeRtv_;
+DeferredReleaseQueue<UINT> deferredFreeDsv_;
+
 // Resource tables
-std::uint32_t nextBufId_{ 1 };
-std::uint32_t nextTexId_{ 1 };
-std::uint32_t nextShaderId_{ 1 };
-std::uint32_t nextPsoId_{ 1 };
-std::uint32_t nextLayoutId_{ 1 };
-std::uint32_t nextFBId_{ 1 };
-std::uint32_t nextDescId_{ 0 };
-std::uint32_t nextFenceId_{ 1 };
-
-std::unordered_map<std::uint32_t, BufferEntry> buffers_;
-std::unordered_map<std::uint32_t, TextureEntry> textures_;
-std::unordered_map<std::uint32_t, ShaderEntry> shaders_;
-std::unordered_map<std::uint32_t, PipelineEntry> pipelines_;
-std::unordered_map<std::uint32_t, InputLayoutEntry> layouts_;
-std::unordered_map<std::uint32_t, FramebufferEntry> framebuffers_;
-
-std::unordered_map<TextureDescIndex, TextureHandle> descToTex_;
-std::unordered_map<std::uint32_t, bool> fences_;
+HandlePool<BufferTag, BufferEntry> buffers_;
+HandlePool<TextureTag, TextureEntry> textures_;
+HandlePool<ShaderTag, ShaderEntry> shaders_;
+HandlePool<PipelineTag, PipelineEntry> pipelines_;
+HandlePool<InputLayoutTag, InputLayoutEntry> layouts_;
+HandlePool<FrameBufferTag, FramebufferEntry> framebuffers_;
+// Timeline value each fence was signaled at (kFenceNotSignaled until SignalFence()).
+HandlePool<FenceTag, UINT64> fences_;
+
+// SRV heap slot -> texture, for transitions / validation (empty = unmapped).
+std::vector<std::optional<TextureHandle>> descToTex_;
 
 
 std::vector<PendingBufferUpdate> pendingBufferUpdates_;
 
-std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> psoCache_;
\ No newline at end of file
+std::unordered_map<std::uint64_t, ComPtr<ID3D12PipelineState>> psoCache_;
+// ExecuteIndirect signatures for DrawIndexedIndirectArgs records, keyed by record stride.
+std::unordered_map<UINT, ComPtr<ID3D12CommandSignature>> drawIndexedSignatures_;
+PipelineCache* pipelineCache_{ nullptr }; // optional, owned by the renderer
\ No newline at end of file
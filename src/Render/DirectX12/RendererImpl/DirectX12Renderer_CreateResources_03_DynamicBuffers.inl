@@ -12,6 +12,25 @@
 					lightsBuffer_ = device_.CreateBuffer(ld);
 				}
 
+				// Clustered lighting (t20 per-cluster {offset, count}, t21 light indices), sized for the worst case.
+				{
+					rhi::BufferDesc rd{};
+					rd.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					rd.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					rd.sizeInBytes = sizeof(ClusterRange) * kLightClusterCount;
+					rd.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(ClusterRange));
+					rd.debugName = "LightClusterRangesSB";
+					clusterRangesBuffer_ = device_.CreateBuffer(rd);
+
+					rhi::BufferDesc id{};
+					id.bindFlag = rhi::BufferBindFlag::StructuredBuffer;
+					id.usageFlag = rhi::BufferUsageFlag::Dynamic;
+					id.sizeInBytes = sizeof(std::uint32_t) * kMaxClusterLightIndices;
+					id.structuredStrideBytes = static_cast<std::uint32_t>(sizeof(std::uint32_t));
+					id.debugName = "LightClusterIndicesSB";
+					clusterLightIndicesBuffer_ = device_.CreateBuffer(id);
+				}
+
 
 				// Shadow metadata structured buffer (t11) — holds spot VP rows + indices/bias, and point pos/range + indices/bias.
 				{
@@ -54,6 +73,7 @@
 					id.sizeInBytes = instanceBufferSizeBytes_;
 					id.debugName = "InstanceVB";
 					instanceBuffer_ = device_.CreateBuffer(id);
+					instanceStream_.Invalidate();
 				}
 
 				// Editor selection highlight: single-instance model matrix VB (slot1).
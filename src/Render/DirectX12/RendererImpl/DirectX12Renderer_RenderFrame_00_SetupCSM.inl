@@ -1,4 +1,9 @@
-			renderGraph::RenderGraph graph;
+			frameSync_.BeginFrame();
+			uploadRing_.BeginFrame();
+
+			renderGraph::RenderGraph& graph = renderGraph_;
+			graph.Reset();
+			graph.SetOptimizeCommandLists(settings_.optimizeCommandLists);
 
 			// -------------------------------------------------------------------------
 			// IMPORTANT (DX12): UpdateBuffer() is flushed at the beginning of SubmitCommandList().
@@ -52,6 +57,9 @@
 			const mathUtils::Frustum cameraFrustum = mathUtils::ExtractFrustumRH_ZO(cameraViewProj);
 			const bool doFrustumCulling = settings_.enableFrustumCulling;
 
+			// Light clusters for the camera lighting passes (t20/t21); false = every pixel loops over all lights.
+			const bool clusteredLighting = UploadLightClusters(scene.camera, cameraView, cameraProj);
+
 			// Limit how far we render directional shadows to keep resolution usable.
 			const float shadowFar = std::min(scene.camera.farZ, settings_.dirShadowDistance);
 			const float shadowNear = std::max(scene.camera.nearZ, 0.05f);
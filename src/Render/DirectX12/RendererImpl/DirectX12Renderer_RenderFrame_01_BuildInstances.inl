@@ -1,3 +1,5 @@
-#include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_ShadowAndLayeredShadow.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_ShadowCasters.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_CameraCulling.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_MainTransparentReflectionPacking.inl"
+#include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_ShadowViews.inl"
 #include "RendererImpl/DirectX12Renderer_RenderFrame_01_BuildInstances_FinalizeAndUpload.inl"
\ No newline at end of file
@@ -0,0 +1,84 @@
+// ---- Camera culling: bit 0 of drawItemViewMasks_ / skinnedDrawItemViewMasks_ ----
+// Camera culling walks the scene BVH once instead of testing every draw item in the packing loops.
+if (doFrustumCulling)
+{
+	drawItemViewMasks_.assign(scene.drawItems.size(), 0u);
+	skinnedDrawItemViewMasks_.assign(scene.GetSkinnedDrawItems().size(), 0u);
+	sceneBvh_.QueryFrustum(cameraFrustum, [this](SceneBVHItem bvhItem)
+		{
+			auto& masks = (bvhItem.kind == SceneBVHItemKind::DrawItem) ? drawItemViewMasks_ : skinnedDrawItemViewMasks_;
+			masks[bvhItem.index] |= 1u;
+		});
+}
+
+// Software occlusion: frustum-visible opaque meshes that kept CPU triangles are occluder candidates
+// (artist-flagged ones first, then the largest on screen). Every frustum-visible item whose world box
+// is hidden behind the rasterized occluders loses its camera bit.
+if (doFrustumCulling && settings_.enableOcclusionCulling)
+{
+	occlusionCuller_.BeginFrame(cameraViewProj);
+	for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
+	{
+		const auto& item = scene.drawItems[drawItemIndex];
+		if ((drawItemViewMasks_[drawItemIndex] & 1u) == 0u || !item.mesh || item.mesh->GetResource().indexCount == 0)
+		{
+			continue;
+		}
+		const std::shared_ptr<const OccluderGeometry>& occluder = item.mesh->GetOccluder();
+		const auto& bounds = item.mesh->GetBounds();
+		if (!occluder || bounds.sphereRadius <= 0.0f)
+		{
+			continue;
+		}
+		if (item.material.id != 0)
+		{
+			const auto& mat = scene.GetMaterial(item.material);
+			const MaterialPerm perm = EffectivePerm(mat);
+			if (HasFlag(perm, MaterialPerm::Transparent) || HasFlag(perm, MaterialPerm::PlanarMirror) || mat.params.baseColor.w < 0.999f)
+			{
+				continue;
+			}
+		}
+
+		const mathUtils::Mat4& model = CachedModel(drawItemModelCache_, drawItemIndex, item.transform);
+		const WorldSphere world = TransformSphere(bounds.sphereCenter, bounds.sphereRadius, model);
+		occlusionCuller_.AddOccluder(occluder->positions, occluder->indices, model, world.center, world.radius, item.occluder);
+	}
+	occlusionCuller_.RasterizeOccluders(settings_.occlusionMaxOccluders);
+
+	occlusionBoxes_.clear();
+	occlusionItems_.clear();
+	auto AddOccludee = [this](SceneBVHItem bvhItem)
+		{
+			if (const Aabb* box = sceneBvh_.TryGetWorldBounds(bvhItem))
+			{
+				occlusionBoxes_.push_back(*box);
+				occlusionItems_.push_back(bvhItem);
+			}
+		};
+	for (std::uint32_t index = 0; index < static_cast<std::uint32_t>(drawItemViewMasks_.size()); ++index)
+	{
+		if ((drawItemViewMasks_[index] & 1u) != 0u)
+		{
+			AddOccludee(SceneBVHItem{ SceneBVHItemKind::DrawItem, index });
+		}
+	}
+	for (std::uint32_t index = 0; index < static_cast<std::uint32_t>(skinnedDrawItemViewMasks_.size()); ++index)
+	{
+		if ((skinnedDrawItemViewMasks_[index] & 1u) != 0u)
+		{
+			AddOccludee(SceneBVHItem{ SceneBVHItemKind::SkinnedDrawItem, index });
+		}
+	}
+
+	occlusionVisible_.resize(occlusionBoxes_.size());
+	occlusionCuller_.TestVisibility(occlusionBoxes_, occlusionVisible_);
+	for (std::size_t i = 0; i < occlusionItems_.size(); ++i)
+	{
+		if (occlusionVisible_[i] == 0u)
+		{
+			auto& masks = (occlusionItems_[i].kind == SceneBVHItemKind::DrawItem) ? drawItemViewMasks_ : skinnedDrawItemViewMasks_;
+			masks[occlusionItems_[i].index] &= ~1u;
+		}
+	}
+}
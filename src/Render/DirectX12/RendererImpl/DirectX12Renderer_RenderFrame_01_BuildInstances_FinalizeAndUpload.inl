@@ -1,23 +1,26 @@
 // ---- Combine and upload once ----
+// Camera-independent groups lead (layered point shadows, layered reflection capture, the no-cull capture packing),
+// so their bases only move when the scene or the lights change. The shadow packing ends with the cascade and
+// pre-depth views, and the camera-culled groups come last.
 auto AlignUpU32 = [](std::uint32_t v, std::uint32_t a) -> std::uint32_t
 	{
 		return (v + (a - 1u)) / a * a;
 	};
-const std::uint32_t shadowBase = 0;
-const std::uint32_t mainBase = static_cast<std::uint32_t>(shadowInstances.size());
-const std::uint32_t captureMainBase = static_cast<std::uint32_t>(shadowInstances.size() + mainInstances.size());
-const std::uint32_t transparentBase = captureMainBase + static_cast<std::uint32_t>(captureMainInstancesNoCull.size());
-const std::uint32_t planarMirrorBase = transparentBase + static_cast<std::uint32_t>(transparentInstances.size());
-
-const std::uint32_t transparentEnd =
-planarMirrorBase + static_cast<std::uint32_t>(planarMirrorInstances.size());
-const std::uint32_t layeredShadowBase = AlignUpU32(transparentEnd, 6u);
+const std::uint32_t layeredShadowBase = 0;
 const std::uint32_t layeredReflectionBase =
 AlignUpU32(layeredShadowBase + static_cast<std::uint32_t>(shadowInstancesLayered.size()), 6u);
+const std::uint32_t captureMainBase = layeredReflectionBase + static_cast<std::uint32_t>(reflectionInstancesLayered.size());
+const std::uint32_t shadowBase = captureMainBase + static_cast<std::uint32_t>(captureMainInstancesNoCull.size());
+const std::uint32_t planarMirrorBase = shadowBase + static_cast<std::uint32_t>(shadowInstances.size());
+const std::uint32_t mainBase = planarMirrorBase + static_cast<std::uint32_t>(planarMirrorInstances.size());
+const std::uint32_t transparentBase = mainBase + static_cast<std::uint32_t>(mainInstances.size());
 
-for (auto& sbatch : shadowBatches)
+for (auto& viewBatches : shadowViewBatches)
 {
-	sbatch.instanceOffset += shadowBase;
+	for (auto& sbatch : viewBatches)
+	{
+		sbatch.instanceOffset += shadowBase;
+	}
 }
 for (auto& mbatch : mainBatches)
 {
@@ -27,9 +30,12 @@ for (auto& cbatch : captureMainBatchesNoCull)
 {
 	cbatch.instanceOffset += captureMainBase;
 }
-for (auto& lbatch : shadowBatchesLayered)
+for (auto& lightBatches : shadowBatchesLayered)
 {
-	lbatch.instanceOffset += layeredShadowBase;
+	for (auto& lbatch : lightBatches)
+	{
+		lbatch.instanceOffset += layeredShadowBase;
+	}
 }
 for (auto& rbatch : reflectionBatchesLayered)
 {
@@ -40,11 +46,26 @@ for (auto& mirrorDraw : planarMirrorDraws)
 	mirrorDraw.instanceOffset = planarMirrorBase + mirrorDraw.instanceOffset;
 }
 
+// Far -> near through the same radix-sorted queue the opaque batches use (translucent keys lead with inverted depth).
+transparentDrawQueue_.Clear();
+transparentDrawQueue_.Reserve(transparentTmp.size());
+for (std::size_t transparentIndex = 0; transparentIndex < transparentTmp.size(); ++transparentIndex)
+{
+	const TransparentTemp& transparentInst = transparentTmp[transparentIndex];
+	DrawKeyFields fields{};
+	fields.material = transparentInst.materialHandle.id;
+	fields.mesh = transparentInst.mesh->vertexBuffer.id;
+	fields.depth = transparentInst.dist2;
+	transparentDrawQueue_.Push(drawKey::Translucent(fields), static_cast<std::uint32_t>(transparentIndex));
+}
+transparentDrawQueue_.Sort();
+
 transparentDrawsScratch_.clear();
 transparentDrawsScratch_.reserve(transparentTmp.size());
 auto& transparentDraws = transparentDrawsScratch_;
-for (const auto& transparentInst : transparentTmp)
+for (const DrawQueue::Item& queued : transparentDrawQueue_.Items())
 {
+	const TransparentTemp& transparentInst = transparentTmp[queued.index];
 	TransparentDraw transparentDraw{};
 	transparentDraw.mesh = transparentInst.mesh;
 	transparentDraw.material = transparentInst.material;
@@ -54,63 +75,61 @@ for (const auto& transparentInst : transparentTmp)
 	transparentDraws.push_back(transparentDraw);
 }
 
-std::sort(transparentDraws.begin(), transparentDraws.end(),
-	[](const TransparentDraw& first, const TransparentDraw& second)
+const std::uint32_t finalCount = transparentBase + static_cast<std::uint32_t>(transparentInstances.size());
+
+// Pack every group into the persistent stream; Commit() below uploads only the rows that differ from last frame.
+// Packing order is deterministic (sorted batches), so a static scene seen from a static camera uploads nothing,
+// and a moving camera only dirties the rows from shadowBase on.
+const std::span<InstanceData> combinedInstances = instanceStream_.BeginFrame(finalCount);
+auto combinedCursor = combinedInstances.begin();
+auto AppendInstances = [&combinedCursor](const auto& group)
 	{
-		return first.dist2 > second.dist2; // far -> near
-	});
+		combinedCursor = std::copy(group.begin(), group.end(), combinedCursor);
+	};
+auto PadInstancesTo = [&combinedCursor, &combinedInstances](std::uint32_t base)
+	{
+		const auto baseIt = combinedInstances.begin() + base;
+		std::fill(combinedCursor, baseIt, InstanceData{});
+		combinedCursor = baseIt;
+	};
+
+// 1) layered shadow
+AppendInstances(shadowInstancesLayered);
+
+// 2) pad up to layeredReflectionBase (layered groups start on a multiple of six faces)
+PadInstancesTo(layeredReflectionBase);
+
+// 3) layered reflection, then the no-cull capture packing
+AppendInstances(reflectionInstancesLayered);
+AppendInstances(captureMainInstancesNoCull);
 
-combinedInstancesScratch_.clear();
-auto& combinedInstances = combinedInstancesScratch_;
-const std::uint32_t finalCount =
-layeredReflectionBase + static_cast<std::uint32_t>(reflectionInstancesLayered.size());
-
-combinedInstances.clear();
-combinedInstances.reserve(finalCount);
-
-// 1) normal groups
-combinedInstances.insert(combinedInstances.end(), shadowInstances.begin(), shadowInstances.end());
-combinedInstances.insert(combinedInstances.end(), mainInstances.begin(), mainInstances.end());
-combinedInstances.insert(combinedInstances.end(), captureMainInstancesNoCull.begin(), captureMainInstancesNoCull.end());
-combinedInstances.insert(combinedInstances.end(), transparentInstances.begin(), transparentInstances.end());
-combinedInstances.insert(combinedInstances.end(), planarMirrorInstances.begin(), planarMirrorInstances.end());
-
-// 2) pad up to layeredShadowBase (between transparent/planar-mirror and layered shadow)
-if (combinedInstances.size() < layeredShadowBase)
-	combinedInstances.resize(layeredShadowBase);
-
-// 3) layered shadow
-combinedInstances.insert(combinedInstances.end(),
-	shadowInstancesLayered.begin(), shadowInstancesLayered.end());
-
-// 4) pad up to layeredReflectionBase (between layered shadow and layered reflection)
-if (combinedInstances.size() < layeredReflectionBase)
-	combinedInstances.resize(layeredReflectionBase);
-
-// 5) layered reflection
-combinedInstances.insert(combinedInstances.end(),
-	reflectionInstancesLayered.begin(), reflectionInstancesLayered.end());
-
-assert(shadowBase == 0u);
-assert(mainBase == shadowInstances.size());
-assert(captureMainBase == shadowInstances.size() + mainInstances.size());
-assert(transparentBase == captureMainBase + captureMainInstancesNoCull.size());
-assert(planarMirrorBase == transparentBase + transparentInstances.size());
-assert(layeredShadowBase >= planarMirrorBase + planarMirrorInstances.size());
+// 4) camera-dependent groups
+AppendInstances(shadowInstances);
+AppendInstances(planarMirrorInstances);
+AppendInstances(mainInstances);
+AppendInstances(transparentInstances);
+
+assert(layeredShadowBase == 0u);
 assert(layeredReflectionBase >= layeredShadowBase + shadowInstancesLayered.size());
-assert(combinedInstances.size() == finalCount);
+assert(captureMainBase == layeredReflectionBase + reflectionInstancesLayered.size());
+assert(shadowBase == captureMainBase + captureMainInstancesNoCull.size());
+assert(planarMirrorBase == shadowBase + shadowInstances.size());
+assert(mainBase == planarMirrorBase + planarMirrorInstances.size());
+assert(transparentBase == mainBase + mainInstances.size());
+assert(combinedCursor == combinedInstances.end());
 
 const std::uint32_t instStride = static_cast<std::uint32_t>(sizeof(InstanceData));
 std::uint32_t particleCount = 0u;
 
-if (!combinedInstances.empty())
+if (combinedInstances.size() * sizeof(InstanceData) > instanceBufferSizeBytes_)
 {
-	const std::size_t bytes = combinedInstances.size() * sizeof(InstanceData);
-	if (bytes > instanceBufferSizeBytes_)
-	{
-		throw std::runtime_error("DX12Renderer: instance buffer overflow (increase instanceBufferSizeBytes_)");
-	}
-	device_.UpdateBuffer(instanceBuffer_, std::as_bytes(std::span{ combinedInstances }));
+	throw std::runtime_error("DX12Renderer: instance buffer overflow (increase instanceBufferSizeBytes_)");
+}
+for (const InstanceRange& dirtyRange : instanceStream_.Commit())
+{
+	const std::span<InstanceData> dirtyRows = uploadRing_.Allocate<InstanceData>(dirtyRange.count);
+	std::copy_n(instanceStream_.Rows().begin() + dirtyRange.first, dirtyRange.count, dirtyRows.begin());
+	uploadRing_.Upload(instanceBuffer_, dirtyRows, static_cast<std::size_t>(dirtyRange.first) * sizeof(InstanceData));
 }
 
 if (!skinnedPaletteMatrices.empty())
@@ -156,23 +175,23 @@ std::sort(particlePacked.begin(), particlePacked.end(),
 		return a.first < b.first;
 	});
 
-std::vector<ParticleInstanceData> particleInstances;
-particleInstances.reserve(particlePacked.size());
-for (const auto& entry : particlePacked)
+const std::span<ParticleInstanceData> particleInstances = uploadRing_.Allocate<ParticleInstanceData>(particlePacked.size());
+for (std::size_t particleIndex = 0; particleIndex < particlePacked.size(); ++particleIndex)
 {
+	const auto& entry = particlePacked[particleIndex];
 	if (particleBatches_.empty() || particleBatches_.back().textureDescIndex != entry.first)
 	{
-		particleBatches_.push_back(ParticleDrawBatch{ .textureDescIndex = entry.first, .instanceOffset = static_cast<std::uint32_t>(particleInstances.size()), .instanceCount = 0u });
+		particleBatches_.push_back(ParticleDrawBatch{ .textureDescIndex = entry.first, .instanceOffset = static_cast<std::uint32_t>(particleIndex), .instanceCount = 0u });
 	}
 
-	particleInstances.push_back(entry.second);
+	particleInstances[particleIndex] = entry.second;
 	++particleBatches_.back().instanceCount;
 }
 
 particleCount = static_cast<std::uint32_t>(particleInstances.size());
 if (particleCount > 0u)
 {
-	device_.UpdateBuffer(particleInstanceBuffer_, std::as_bytes(std::span{ particleInstances }));
+	uploadRing_.Upload(particleInstanceBuffer_, particleInstances);
 }
 
 if (settings_.debugPrintDrawCalls)
@@ -184,6 +203,23 @@ if (settings_.debugPrintDrawCalls)
 			<< " (instances main: " << mainInstances.size()
 			<< ", shadow: " << shadowInstances.size() << ")"
 			<< " | DepthPrepass: " << (settings_.enableDepthPrepass ? "ON" : "OFF")
-			<< " (draw calls: " << shadowBatches.size() << ")\n";
+			<< " (draw calls: " << shadowBatches.size() << ")"
+			<< " | redundant commands removed last frame: " << renderGraph_.GetCommandListOptimizeStats().RemovedCommands() << "\n";
+		if (settings_.enableOcclusionCulling && doFrustumCulling)
+		{
+			const OcclusionCullingStats& occlusion = occlusionCuller_.GetStats();
+			std::cout << "[DX12] Occlusion: " << occlusion.objectsCulled << "/" << occlusion.objectsTested << " culled"
+				<< " | occluders: " << occlusion.occludersRasterized << "/" << occlusion.occluderCandidates
+				<< " (" << occlusion.trianglesRasterized << " tris)"
+				<< " | raster " << occlusion.rasterMs << " ms, test " << occlusion.testMs << " ms\n";
+		}
+		if (clusteredLighting)
+		{
+			const ClusteredLightingStats& clusters = lightClusters_.GetStats();
+			std::cout << "[DX12] Light clusters: " << clusters.occupiedClusters << "/" << lightClusters_.GetClusterCount() << " occupied"
+				<< " | indices: " << clusters.clusterLightIndices << " (max " << clusters.maxLightsPerCluster << " per cluster)"
+				<< " | lights: " << clusters.pointLights << " point, " << clusters.spotLights << " spot, " << clusters.globalLights << " global"
+				<< " | build " << clusters.buildMs << " ms\n";
+		}
 	}
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
-std::unordered_map<BatchKey, BatchTemp, hashUtils::BatchKeyHash, BatchKeyEq> mainTmp;
+std::vector<BatchItemTemp>& mainTmp = mainBatchItemsScratch_;
+mainTmp.clear();
 mainTmp.reserve(scene.drawItems.size());
+mainDrawQueue_.Clear();
 
 std::vector<InstanceData> transparentInstances;
 transparentInstances.reserve(scene.drawItems.size());
@@ -55,11 +57,25 @@ EnsureReflectionProbeResources(reflectiveOwnerDrawItems_.size());
 // NOTE: mainTmp is camera-culled (IsVisible), but reflection capture must NOT depend on the camera.
 // We therefore build an additional "no-cull" packing for reflection capture / cube atlas.
 const bool buildCaptureNoCull = settings_.enableReflectionCapture || settings_.ShowCubeAtlas || settings_.enablePlanarReflections;
-std::unordered_map<BatchKey, BatchTemp, hashUtils::BatchKeyHash, BatchKeyEq> captureTmp;
+std::vector<BatchItemTemp>& captureTmp = captureBatchItemsScratch_;
+captureTmp.clear();
+captureDrawQueue_.Clear();
 if (buildCaptureNoCull)
 {
 	captureTmp.reserve(scene.drawItems.size());
 }
+
+// Opaque draws are sorted by a 64-bit key (pipeline/permutation, material, mesh, then front-to-back depth)
+// so equal draw state ends up adjacent and batches fall out of one linear walk.
+auto MakeOpaqueDrawKey = [](const BatchKey& key, MaterialHandle materialHandle, float dist2) -> std::uint64_t
+	{
+		DrawKeyFields fields{};
+		fields.pipeline = key.permBits | (key.envSource << 5u) | (static_cast<std::uint32_t>(key.reflectionProbeIndex + 1) << 7u);
+		fields.material = materialHandle.id;
+		fields.mesh = key.mesh->vertexBuffer.id;
+		fields.depth = dist2;
+		return drawKey::Opaque(fields);
+	};
 for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
 {
 	const auto& item = scene.drawItems[drawItemIndex];
@@ -69,10 +85,10 @@ for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++dr
 		continue;
 	}
 
-	const mathUtils::Mat4 model = item.transform.ToMatrix();
+	const mathUtils::Mat4& model = CachedModel(drawItemModelCache_, drawItemIndex, item.transform);
 	// Camera visibility is used only for MAIN/transparent lists.
 	// Reflection capture uses a separate no-cull packing (captureTmp).
-	const bool visibleInMain = IsVisible(item.mesh.get(), model, cameraFrustum, doFrustumCulling);
+	const bool visibleInMain = !doFrustumCulling || (drawItemViewMasks_[drawItemIndex] & 1u) != 0u;
 
 	BatchKey key{};
 	key.mesh = mesh;
@@ -138,17 +154,15 @@ for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++dr
 	inst.i2 = model[2];
 	inst.i3 = model[3];
 
-	// Reflection-capture packing is NO-CULL: add before camera-cull so capture does not depend on the editor camera
+	const mathUtils::Vec3 originToCamera = mathUtils::Vec3(model[3].x, model[3].y, model[3].z) - camPos;
+	const float originDist2 = mathUtils::Dot(originToCamera, originToCamera);
+
+	// Reflection-capture packing is NO-CULL: add before camera-cull so capture does not depend on the editor camera.
+	// No depth in its key either: the stable sort keeps scene order, so the packed rows stay put while the camera moves.
 	if (buildCaptureNoCull && !isTransparent)
 	{
-		auto& bucket = captureTmp[key];
-		if (bucket.inst.empty())
-		{
-			bucket.materialHandle = item.material;
-			bucket.material = params;
-			bucket.reflectionProbeIndex = key.reflectionProbeIndex;
-		}
-		bucket.inst.push_back(inst);
+		captureDrawQueue_.Push(MakeOpaqueDrawKey(key, item.material, 0.0f), static_cast<std::uint32_t>(captureTmp.size()));
+		captureTmp.push_back(BatchItemTemp{ key, params, item.material, inst });
 	}
 
 	// Main pass: camera-culled.
@@ -204,14 +218,8 @@ for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++dr
 		continue;
 	}
 
-	auto& bucket = mainTmp[key];
-	if (bucket.inst.empty())
-	{
-		bucket.materialHandle = item.material;
-		bucket.material = params; // representative material for this batch
-		bucket.reflectionProbeIndex = key.reflectionProbeIndex;
-	}
-	bucket.inst.push_back(inst);
+	mainDrawQueue_.Push(MakeOpaqueDrawKey(key, item.material, originDist2), static_cast<std::uint32_t>(mainTmp.size()));
+	mainTmp.push_back(BatchItemTemp{ key, params, item.material, inst });
 }
 
 for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawItems().size(); ++skinnedDrawIndex)
@@ -225,8 +233,8 @@ for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawIt
 	{
 		continue;
 	}
-	const mathUtils::Mat4 model = item.transform.ToMatrix();
-	if (!IsVisible(item.asset.get(), model, cameraFrustum, doFrustumCulling))
+	const mathUtils::Mat4& model = CachedModel(skinnedModelCache_, skinnedDrawIndex, item.transform);
+	if (doFrustumCulling && (skinnedDrawItemViewMasks_[skinnedDrawIndex] & 1u) == 0u)
 	{
 		continue;
 	}
@@ -300,31 +308,37 @@ for (std::size_t skinnedDrawIndex = 0; skinnedDrawIndex < scene.GetSkinnedDrawIt
 	}
 }
 
-std::vector<InstanceData> mainInstances;
-mainInstances.reserve(scene.drawItems.size());
-
-std::vector<Batch> mainBatches;
-mainBatches.reserve(mainTmp.size());
-
-for (auto& [key, bt] : mainTmp)
-{
-	if (bt.inst.empty())
+// Sorted walk: a new batch starts whenever the full BatchKey of the next draw differs. Key bit collisions
+// (truncated ids) can only split a batch, never merge different materials or meshes.
+auto BuildSortedBatches = [](DrawQueue& queue, const std::vector<BatchItemTemp>& items,
+	std::vector<InstanceData>& outInstances, std::vector<Batch>& outBatches)
 	{
-		continue;
-	}
-
-	Batch batch{};
-	batch.mesh = key.mesh;
-	batch.materialHandle = bt.materialHandle;
-	batch.material = bt.material;
-	batch.instanceOffset = static_cast<std::uint32_t>(mainInstances.size());
-	batch.instanceCount = static_cast<std::uint32_t>(bt.inst.size());
+		queue.Sort();
+		const BatchKey* batchKey = nullptr;
+		for (const DrawQueue::Item& queued : queue.Items())
+		{
+			const BatchItemTemp& bt = items[queued.index];
+			if (!batchKey || !BatchKeyEq{}(*batchKey, bt.key))
+			{
+				Batch batch{};
+				batch.mesh = bt.key.mesh;
+				batch.materialHandle = bt.materialHandle;
+				batch.material = bt.material; // representative material for this batch
+				batch.instanceOffset = static_cast<std::uint32_t>(outInstances.size());
+				batch.reflectionProbeIndex = bt.key.reflectionProbeIndex;
+				outBatches.push_back(batch);
+				batchKey = &bt.key;
+			}
+			outInstances.push_back(bt.inst);
+			++outBatches.back().instanceCount;
+		}
+	};
 
-	batch.reflectionProbeIndex = bt.reflectionProbeIndex;
+std::vector<InstanceData> mainInstances;
+mainInstances.reserve(mainTmp.size());
 
-	mainInstances.insert(mainInstances.end(), bt.inst.begin(), bt.inst.end());
-	mainBatches.push_back(batch);
-}
+std::vector<Batch> mainBatches;
+BuildSortedBatches(mainDrawQueue_, mainTmp, mainInstances, mainBatches);
 
 // ---- Reflection-capture no-cull packing (opaque) ----
 std::vector<InstanceData> captureMainInstancesNoCull;
@@ -332,25 +346,8 @@ std::vector<Batch> captureMainBatchesNoCull;
 
 if (buildCaptureNoCull && !captureTmp.empty())
 {
-	captureMainInstancesNoCull.reserve(scene.drawItems.size());
-	captureMainBatchesNoCull.reserve(captureTmp.size());
-
-	for (auto& [key, bt] : captureTmp)
-	{
-		if (bt.inst.empty())
-			continue;
-
-		Batch batch{};
-		batch.mesh = key.mesh;
-		batch.materialHandle = bt.materialHandle;
-		batch.material = bt.material;
-		batch.instanceOffset = static_cast<std::uint32_t>(captureMainInstancesNoCull.size());
-		batch.instanceCount = static_cast<std::uint32_t>(bt.inst.size());
-		batch.reflectionProbeIndex = bt.reflectionProbeIndex;
-
-		captureMainInstancesNoCull.insert(captureMainInstancesNoCull.end(), bt.inst.begin(), bt.inst.end());
-		captureMainBatchesNoCull.push_back(batch);
-	}
+	captureMainInstancesNoCull.reserve(captureTmp.size());
+	BuildSortedBatches(captureDrawQueue_, captureTmp, captureMainInstancesNoCull, captureMainBatchesNoCull);
 }
 
 // ---- Optional: layered reflection-capture packing (duplicate MAIN instances x6 for cubemap slices) ----
@@ -0,0 +1,73 @@
+// ---------------- Build instance draw lists (ONE upload) ----------------
+// We build two packings:
+//   1) Shadow packing: opaque casters culled per shadow view and batched per mesh (directional/spot/point
+//      shadow passes and the depth pre-pass, see ..._ShadowViews.inl)
+//   2) Main packing: per-(mesh+material params) batching (used by MainPass)
+//
+// Then we concatenate them into the persistent instanceBuffer_; only rows that changed since last frame are uploaded.
+// ---- Shadow casters (culled and packed per view once the main packing is known) ----
+shadowCasterSpheres_.Clear();
+shadowCasterSpheres_.Reserve(scene.drawItems.size());
+shadowCasterMeshes_.clear();
+shadowCasterInstances_.clear();
+
+// Model matrices are cached per draw item and rebuilt only for items whose transform changed.
+drawItemModelCache_.BeginFrame(scene.drawItems.size());
+skinnedModelCache_.BeginFrame(scene.GetSkinnedDrawItems().size());
+auto CachedModel = [](auto& cache, std::size_t index, const Transform& transform) -> const mathUtils::Mat4&
+	{
+		return cache.Get(index, transform, [&transform] { return transform.ToMatrix(); });
+	};
+
+// The scene BVH is refreshed once per frame (unchanged items cost one compare); camera culling queries it.
+sceneBvh_.Sync(scene);
+
+for (std::size_t drawItemIndex = 0; drawItemIndex < scene.drawItems.size(); ++drawItemIndex)
+{
+	const auto& item = scene.drawItems[drawItemIndex];
+	const rendern::MeshRHI* mesh = item.mesh ? &item.mesh->GetResource() : nullptr;
+	if (!mesh || mesh->indexCount == 0)
+	{
+		continue;
+	}
+	const mathUtils::Mat4& model = CachedModel(drawItemModelCache_, drawItemIndex, item.transform);
+	// IMPORTANT: exclude alpha-blended objects from shadow casting
+	MaterialParams params{};
+	MaterialPerm perm = MaterialPerm::UseShadow;
+	std::uint32_t itemEnvSource = 0u;
+
+	if (item.material.id != 0)
+	{
+		const auto& mat = scene.GetMaterial(item.material);
+		itemEnvSource = static_cast<std::uint32_t>(mat.envSource);
+		params = mat.params;
+		perm = EffectivePerm(mat);
+	}
+	else
+	{
+		params.baseColor = { 1,1,1,1 };
+		params.shininess = 32.0f;
+		params.specStrength = 0.2f;
+		params.shadowBias = 0.0f;
+		params.albedoDescIndex = 0;
+		perm = MaterialPerm::UseShadow;
+	}
+
+	const bool isTransparent = HasFlag(perm, MaterialPerm::Transparent) || (params.baseColor.w < 0.999f);
+	const bool isPlanarMirror = HasFlag(perm, MaterialPerm::PlanarMirror);
+	if (isTransparent || isPlanarMirror)
+	{
+		continue;
+	}
+
+	InstanceData inst{};
+	inst.i0 = model[0];
+	inst.i1 = model[1];
+	inst.i2 = model[2];
+	inst.i3 = model[3];
+
+	const auto& bounds = item.mesh->GetBounds();
+	shadowCasterSpheres_.PushLocal(bounds.sphereCenter, bounds.sphereRadius, model);
+	shadowCasterMeshes_.push_back(mesh);
+	shadowCasterInstances_.push_back(inst);
+}
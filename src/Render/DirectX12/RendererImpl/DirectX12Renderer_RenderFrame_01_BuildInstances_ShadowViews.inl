@@ -0,0 +1,161 @@
+// ---- Shadow views: cull casters against every view at once, then pack per-view instance ranges ----
+// Light views come first: one per spot shadow and, per point shadow, its six faces combined plus one view per
+// face. The camera-dependent views follow (one per directional cascade, extruded towards the light, then the
+// depth pre-pass), so the packing of static casters for static lights keeps its rows while the camera moves.
+shadowCullViews_.clear();
+auto AddShadowView = [this](const mathUtils::Frustum& frustum) -> std::uint32_t
+	{
+		shadowCullViews_.push_back(frustum);
+		return static_cast<std::uint32_t>(shadowCullViews_.size() - 1);
+	};
+
+ShadowViewMask shadowViewsToPack{ 0 };
+
+// Point shadows prefer one layered pass (SV_RenderTargetArrayIndex), then SV_ViewID, then six face passes.
+// Skinned casters are only drawn by the face-by-face path.
+const bool haveSkinnedShadowDraws = !skinnedOpaqueDraws.empty();
+const bool pointShadowUseLayered =
+	!disablePointShadowLayered_ && static_cast<bool>(psoPointShadowLayered_) &&
+	device_.SupportsShaderModel6() && device_.SupportsVPAndRTArrayIndexFromAnyShader() && !haveSkinnedShadowDraws;
+const bool pointShadowUseVI =
+	!pointShadowUseLayered && !disablePointShadowVI_ && static_cast<bool>(psoPointShadowVI_) && !haveSkinnedShadowDraws;
+
+// Collect up to kMaxSpotShadows / kMaxPointShadows from scene.lights (index aligns with UploadLights()).
+std::vector<ShadowLightView> shadowLightViews;
+{
+	std::uint32_t spotCount = 0;
+	std::uint32_t pointCount = 0;
+	for (std::uint32_t lightIndex = 0; lightIndex < static_cast<std::uint32_t>(scene.lights.size()) && lightIndex < kMaxLights; ++lightIndex)
+	{
+		const auto& light = scene.lights[lightIndex];
+		if (light.type == LightType::Spot && spotCount < kMaxSpotShadows)
+		{
+			const mathUtils::Vec3 lightDirLocal = mathUtils::Normalize(light.direction);
+			const mathUtils::Vec3 upVector = (std::abs(mathUtils::Dot(lightDirLocal, mathUtils::Vec3(0, 1, 0))) > 0.99f)
+				? mathUtils::Vec3(0, 0, 1)
+				: mathUtils::Vec3(0, 1, 0);
+
+			const mathUtils::Mat4 lightView = mathUtils::LookAt(light.position, light.position + lightDirLocal, upVector);
+
+			const float outerHalf = std::max(1.0f, light.outerHalfAngleDeg);
+			const float farZ = std::max(1.0f, light.range);
+			const float nearZ = std::max(0.5f, farZ * 0.02f);
+			const mathUtils::Mat4 lightProj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(outerHalf * 2.0f), 1.0f, nearZ, farZ);
+
+			ShadowLightView spot{};
+			spot.lightIndex = lightIndex;
+			spot.type = LightType::Spot;
+			spot.viewProj = lightProj * lightView;
+			spot.view = AddShadowView(mathUtils::ExtractFrustumRH_ZO(spot.viewProj));
+			shadowViewsToPack |= ShadowViewMask{ 1 } << spot.view;
+			shadowLightViews.push_back(spot);
+			++spotCount;
+		}
+		else if (light.type == LightType::Point && pointCount < kMaxPointShadows)
+		{
+			ShadowLightView point{};
+			point.lightIndex = lightIndex;
+			point.type = LightType::Point;
+			point.pos = light.position;
+			point.range = std::max(1.0f, light.range);
+			point.view = AddShadowView(PointLightFrustum(point.pos, point.range));
+			point.firstFaceView = static_cast<std::uint32_t>(shadowCullViews_.size());
+
+			const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, kPointShadowNearZ, point.range);
+			for (int face = 0; face < 6; ++face)
+			{
+				AddShadowView(mathUtils::ExtractFrustumRH_ZO(proj90 * CubeFaceViewRH(point.pos, face)));
+			}
+
+			if (pointShadowUseLayered || pointShadowUseVI)
+			{
+				shadowViewsToPack |= ShadowViewMask{ 1 } << point.view;
+			}
+			else
+			{
+				shadowViewsToPack |= ShadowViewMask{ 0x3F } << point.firstFaceView;
+			}
+			shadowLightViews.push_back(point);
+			++pointCount;
+		}
+	}
+}
+
+const std::uint32_t firstCascadeView = static_cast<std::uint32_t>(shadowCullViews_.size());
+for (std::uint32_t cascade = 0; cascade < dirCascadeCount; ++cascade)
+{
+	shadowViewsToPack |= ShadowViewMask{ 1 } << AddShadowView(ExtrudedCascadeFrustum(dirCascadeVP[cascade]));
+}
+
+const bool doDepthPrepassView = settings_.enableDepthPrepass && !settings_.enableDeferred;
+const std::uint32_t preDepthView = AddShadowView(doFrustumCulling ? cameraFrustum : UnboundedFrustum());
+if (doDepthPrepassView)
+{
+	shadowViewsToPack |= ShadowViewMask{ 1 } << preDepthView;
+}
+
+const std::uint32_t shadowViewCount = static_cast<std::uint32_t>(shadowCullViews_.size());
+shadowCasterMasks_.resize(shadowCasterSpheres_.Size());
+CullShadowCasters(shadowCasterSpheres_, shadowCullViews_, shadowCasterMasks_, shadowCullScratch_);
+shadowViewPacking_.Build(shadowCasterMeshes_, shadowCasterMasks_, shadowViewCount, shadowViewsToPack);
+
+// Instances are laid out exactly like the packing's caster list: view after view, grouped by mesh.
+std::vector<InstanceData> shadowInstances;
+shadowInstances.reserve(shadowViewPacking_.GetCasters().size());
+for (const std::uint32_t caster : shadowViewPacking_.GetCasters())
+{
+	shadowInstances.push_back(shadowCasterInstances_[caster]);
+}
+
+std::vector<std::vector<ShadowBatch>> shadowViewBatches(shadowViewCount);
+for (std::uint32_t view = 0; view < shadowViewCount; ++view)
+{
+	const auto packedBatches = shadowViewPacking_.GetBatches(view);
+	shadowViewBatches[view].reserve(packedBatches.size());
+	for (const auto& packed : packedBatches)
+	{
+		shadowViewBatches[view].push_back(ShadowBatch{ packed.mesh, packed.first, packed.count });
+	}
+}
+
+// Depth pre-pass draws the camera view of the shadow packing.
+const std::vector<ShadowBatch>& shadowBatches = shadowViewBatches[preDepthView];
+
+// ---- Optional: layered point-shadow packing (duplicate instances x6 for cubemap slices) ----
+// Layered point shadow renders into a Texture2DArray(6) in a single pass and uses
+// SV_RenderTargetArrayIndex in VS. The shader assumes instance data is duplicated 6 times:
+// for each original instance we emit faces 0..5 in order. Each point light gets its own culled range.
+std::vector<InstanceData> shadowInstancesLayered;
+std::vector<std::vector<ShadowBatch>> shadowBatchesLayered(shadowLightViews.size());
+if (pointShadowUseLayered)
+{
+	constexpr std::uint32_t kPointShadowFaces = 6u;
+	for (std::size_t shadowLight = 0; shadowLight < shadowLightViews.size(); ++shadowLight)
+	{
+		if (shadowLightViews[shadowLight].type != LightType::Point)
+		{
+			continue;
+		}
+
+		for (const ShadowBatch& sb : shadowViewBatches[shadowLightViews[shadowLight].view])
+		{
+			ShadowBatch lb{};
+			lb.mesh = sb.mesh;
+			lb.instanceOffset = static_cast<std::uint32_t>(shadowInstancesLayered.size());
+			lb.instanceCount = sb.instanceCount * kPointShadowFaces;
+
+			const std::uint32_t begin = sb.instanceOffset;
+			const std::uint32_t end = begin + sb.instanceCount;
+			for (std::uint32_t i = begin; i < end; ++i)
+			{
+				const InstanceData& inst = shadowInstances[i];
+				for (std::uint32_t face = 0; face < kPointShadowFaces; ++face)
+				{
+					shadowInstancesLayered.push_back(inst);
+				}
+			}
+
+			shadowBatchesLayered[shadowLight].push_back(lb);
+		}
+	}
+}
@@ -178,6 +178,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 				att.colorCubeFace = static_cast<std::uint32_t>(face);
 				att.depth = depthTmp;
 				att.clearDesc = clearColorDepth;
+				att.recordInParallel = true;
 
 				mathUtils::Mat4 view = CubeFaceViewRH(probe.capturePos, face);
 				view[3] = mathUtils::Vec4(0, 0, 0, 1);
@@ -219,6 +220,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			att.colorCubeAllFaces = true;
 			att.depth = depthCubeRG;
 			att.clearDesc = meshClear;
+			att.recordInParallel = true;
 
 			ReflectionCaptureConstants base{};
 			for (int face = 0; face < 6; ++face)
@@ -278,6 +280,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 			att.colorCubeAllFaces = true;
 			att.depth = depthCubeRG;
 			att.clearDesc = meshClear;
+			att.recordInParallel = true;
 
 			ReflectionCaptureConstants base{};
 			for (int face = 0; face < 6; ++face)
@@ -339,6 +342,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 				att.colorCubeFace = static_cast<std::uint32_t>(face);
 				att.depth = depthTmp;
 				att.clearDesc = meshClear;
+				att.recordInParallel = true;
 
 				const mathUtils::Mat4 view = CubeFaceViewRH(probe.capturePos, face);
 				const mathUtils::Mat4 vp = proj90 * view;
@@ -444,6 +448,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 				att.clearDesc.clearColor = false;
 				att.clearDesc.clearDepth = false;
 				att.clearDesc.clearStencil = false;
+				att.reads = { sourceCube };
 
 				const ReflectionProbePrefilterConstants constants{ .uFaceRoughnessMip = { static_cast<float>(face), 0.0f, 0.0f, 1.0f } };
 				const std::string passName =
@@ -480,6 +485,7 @@ if (settings_.enableReflectionCapture && psoReflectionCapture_ && !reflectiveOwn
 					att.clearDesc.clearColor = false;
 					att.clearDesc.clearDepth = false;
 					att.clearDesc.clearStencil = false;
+					att.reads = { sourceCube };
 
 					const ReflectionProbePrefilterConstants constants{ .uFaceRoughnessMip = { static_cast<float>(face), roughness, static_cast<float>(mip), 0.0f } };
 					const std::string passName =
@@ -60,7 +60,7 @@
 				}
 			};
 
-			// ---------------- Create shadow passes (all reuse shadowBatches) ----------------
+			// ---------------- Create shadow passes (each draws its own culled view of the shadow packing) ----------------
 			// Directional CSM atlas (depth-only). We clear the whole atlas once, then render each cascade
 			// into its own 2048x2048 viewport tile.
 			for (std::uint32_t cascade = 0; cascade < dirCascadeCount; ++cascade)
@@ -74,6 +74,7 @@
 				att.useSwapChainBackbuffer = false;
 				att.depth = shadowRG;
 				att.clearDesc = clear;
+				att.recordInParallel = true;
 
 				SingleMatrixPassConstants shadowPassConstants{};
 
@@ -87,7 +88,7 @@
 
 				const char* passName = (cascade == 0u) ? "DirShadow_C0" : (cascade == 1u) ? "DirShadow_C1" : "DirShadow_C2";
 				graph.AddPass(passName, std::move(att),
-					[this, DrawSkinnedShadowPass, shadowPassConstants, shadowBatches, skinnedOpaqueDraws, instStride, vpX, vpY, vpW, vpH, cascadeVP = dirCascadeVP[cascade]](renderGraph::PassContext& ctx) mutable
+					[this, DrawSkinnedShadowPass, shadowPassConstants, shadowBatches = shadowViewBatches[firstCascadeView + cascade], skinnedOpaqueDraws, instStride, vpX, vpY, vpW, vpH, cascadeVP = dirCascadeVP[cascade]](renderGraph::PassContext& ctx) mutable
 					{
 						ctx.commandList.SetViewport(vpX, vpY, vpW, vpH);
 
@@ -102,17 +103,12 @@
 					});
 			}
 
-			// Collect up to kMaxSpotShadows / kMaxPointShadows from scene.lights (index aligns with UploadLights()).
-			for (std::uint32_t lightIndex = 0; lightIndex < static_cast<std::uint32_t>(scene.lights.size()); ++lightIndex)
+			// Spot/point shadow maps for the lights selected (and culled against) in the shadow view packing.
+			for (std::size_t shadowLight = 0; shadowLight < shadowLightViews.size(); ++shadowLight)
 			{
-				if (lightIndex >= kMaxLights)
-				{
-					break;
-				}
-
-				const auto& light = scene.lights[lightIndex];
+				const ShadowLightView& shadowView = shadowLightViews[shadowLight];
 
-				if (light.type == LightType::Spot && spotShadows.size() < kMaxSpotShadows)
+				if (shadowView.type == LightType::Spot)
 				{
 					const rhi::Extent2D ext{ 1024, 1024 };
 					const auto rg = graph.CreateTexture(renderGraph::RGTextureDesc{
@@ -122,23 +118,12 @@
 						.debugName = "SpotShadowMap"
 						});
 
-					mathUtils::Vec3 lightDirLocal = mathUtils::Normalize(light.direction);
-					mathUtils::Vec3 upVector = (std::abs(mathUtils::Dot(lightDirLocal, mathUtils::Vec3(0, 1, 0))) > 0.99f)
-						? mathUtils::Vec3(0, 0, 1)
-						: mathUtils::Vec3(0, 1, 0);
-
-					mathUtils::Mat4 lightView = mathUtils::LookAt(light.position, light.position + lightDirLocal, upVector);
-
-					const float outerHalf = std::max(1.0f, light.outerHalfAngleDeg);
-					const float farZ = std::max(1.0f, light.range);
-					const float nearZ = std::max(0.5f, farZ * 0.02f);
-					const mathUtils::Mat4 lightProj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(outerHalf * 2.0f), 1.0f, nearZ, farZ);
-					const mathUtils::Mat4 lightViewProj = lightProj * lightView;
+					const mathUtils::Mat4& lightViewProj = shadowView.viewProj;
 
 					SpotShadowRec rec{};
 					rec.tex = rg;
 					rec.viewProj = lightViewProj;
-					rec.lightIndex = lightIndex;
+					rec.lightIndex = shadowView.lightIndex;
 					spotShadows.push_back(rec);
 
 					rhi::ClearDesc clear{};
@@ -150,6 +135,7 @@
 					att.useSwapChainBackbuffer = false;
 					att.depth = rg;
 					att.clearDesc = clear;
+					att.recordInParallel = true;
 
 					const std::string passName = "SpotShadowPass_" + std::to_string(static_cast<int>(spotShadows.size() - 1));
 
@@ -158,7 +144,7 @@
 					std::memcpy(spotPassConstants.uLightViewProj.data(), mathUtils::ValuePtr(lightViewProjTranspose), sizeof(float) * 16);
 
 					graph.AddPass(passName, std::move(att),
-						[this, DrawSkinnedShadowPass, spotPassConstants, shadowBatches, skinnedOpaqueDraws, instStride, lightViewProj](renderGraph::PassContext& ctx) mutable
+						[this, DrawSkinnedShadowPass, spotPassConstants, shadowBatches = shadowViewBatches[shadowView.view], skinnedOpaqueDraws, instStride, lightViewProj](renderGraph::PassContext& ctx) mutable
 						{
 							ctx.commandList.SetViewport(0, 0,
 								static_cast<int>(ctx.passExtent.width),
@@ -174,18 +160,12 @@
 
 						});
 				}
-				else if (light.type == LightType::Point && pointShadows.size() < kMaxPointShadows)
+				else
 				{
 					// Point shadows use a cubemap R32_FLOAT distance map (color) + depth for rasterization.
-					// Prefer layered one-pass (SV_RenderTargetArrayIndex). If unavailable, try VI (SV_ViewID).
-					// Otherwise we fall back to 6 separate passes (face-by-face).
-					const bool haveSkinnedShadowDraws = !skinnedOpaqueDraws.empty();
-					bool useLayered =
-						(!disablePointShadowLayered_) &&
-						static_cast<bool>(psoPointShadowLayered_) &&
-						device_.SupportsVPAndRTArrayIndexFromAnyShader() && !haveSkinnedShadowDraws;
-
-					bool useVI = (!disablePointShadowVI_) && static_cast<bool>(psoPointShadowVI_) && !haveSkinnedShadowDraws;
+					// The layered / SV_ViewID / face-by-face choice is made with the shadow view packing.
+					const bool useLayered = pointShadowUseLayered;
+					const bool useVI = pointShadowUseVI;
 
 					const rhi::Extent2D cubeExtent{ 2048, 2048 };
 					const auto cube = graph.CreateTexture(renderGraph::RGTextureDesc{
@@ -221,13 +201,12 @@
 					PointShadowRec rec{};
 					rec.cube = cube;
 					rec.depthTmp = depth;
-					rec.pos = light.position;
-					rec.range = std::max(1.0f, light.range);
-					rec.lightIndex = lightIndex;
+					rec.pos = shadowView.pos;
+					rec.range = shadowView.range;
+					rec.lightIndex = shadowView.lightIndex;
 					pointShadows.push_back(rec);
 
-					const float pointNearZ = 0.01f;
-					const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, pointNearZ, rec.range);
+					const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, kPointShadowNearZ, rec.range);
 
 					if (useLayered)
 					{
@@ -244,6 +223,7 @@
 						att.colorCubeAllFaces = true;
 						att.depth = depth;
 						att.clearDesc = clear;
+						att.recordInParallel = true;
 
 						const std::string passName =
 							"PointShadowPassLayered_" + std::to_string(static_cast<int>(pointShadows.size() - 1));
@@ -262,7 +242,7 @@
 						pointShadowConstants.uMisc = { 0, 0, 0, 0 };
 
 						graph.AddPass(passName, std::move(att),
-							[this, pointShadowConstants, shadowBatchesLayered, instStride](renderGraph::PassContext& ctx) mutable
+							[this, pointShadowConstants, layeredBatches = shadowBatchesLayered[shadowLight], instStride](renderGraph::PassContext& ctx) mutable
 							{
 								ctx.commandList.SetViewport(0, 0,
 									static_cast<int>(ctx.passExtent.width),
@@ -270,7 +250,7 @@
 								ctx.commandList.SetState(pointShadowState_);
 								ctx.commandList.BindPipeline(psoPointShadowLayered_);
 								ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &pointShadowConstants, 1 }));
-								this->DrawInstancedShadowBatches(ctx.commandList, shadowBatchesLayered, instStride);
+								this->DrawInstancedShadowBatches(ctx.commandList, layeredBatches, instStride);
 							});
 
 					}
@@ -289,6 +269,7 @@
 						att.colorCubeAllFaces = true;
 						att.depth = depth;
 						att.clearDesc = clear;
+						att.recordInParallel = true;
 
 						const std::string passName =
 							"PointShadowPassVI_" + std::to_string(static_cast<int>(pointShadows.size() - 1));
@@ -306,7 +287,7 @@
 						pointShadowConstants.uMisc = { 0, 0, 0, 0 };
 
 						graph.AddPass(passName, std::move(att),
-							[this, pointShadowConstants, shadowBatches, instStride](renderGraph::PassContext& ctx) mutable
+							[this, pointShadowConstants, shadowBatches = shadowViewBatches[shadowView.view], instStride](renderGraph::PassContext& ctx) mutable
 							{
 								ctx.commandList.SetViewport(0, 0,
 									static_cast<int>(ctx.passExtent.width),
@@ -341,6 +322,7 @@
 							att.colorCubeFace = static_cast<std::uint32_t>(face);
 							att.depth = depth;
 							att.clearDesc = clear;
+							att.recordInParallel = true;
 
 							const std::string passName =
 								"PointShadowPass_" + std::to_string(static_cast<int>(pointShadows.size() - 1)) +
@@ -355,7 +337,7 @@
 
 
 							graph.AddPass(passName, std::move(att),
-								[this, DrawSkinnedPointShadowFacePass, pointShadowConstants, shadowBatches, skinnedOpaqueDraws, instStride, faceViewProj, lightPos = rec.pos, lightRange = rec.range](renderGraph::PassContext& ctx) mutable
+								[this, DrawSkinnedPointShadowFacePass, pointShadowConstants, shadowBatches = shadowViewBatches[shadowView.firstFaceView + static_cast<std::uint32_t>(face)], skinnedOpaqueDraws, instStride, faceViewProj, lightPos = rec.pos, lightRange = rec.range](renderGraph::PassContext& ctx) mutable
 								{
 									ctx.commandList.SetViewport(0, 0,
 										static_cast<int>(ctx.passExtent.width),
@@ -431,3 +413,15 @@
 				device_.UpdateBuffer(shadowDataBuffer_, std::as_bytes(std::span{ &sd, 1 }));
 			}
 
+			// Shadow maps sampled by the lit passes; listed as pass reads so the render graph keeps the shadow passes alive.
+			std::vector<renderGraph::RGTexture> shadowMapReads;
+			shadowMapReads.reserve(1 + spotShadows.size() + pointShadows.size());
+			shadowMapReads.push_back(shadowRG);
+			for (const auto& spotShadow : spotShadows)
+			{
+				shadowMapReads.push_back(spotShadow.tex);
+			}
+			for (const auto& pointShadow : pointShadows)
+			{
+				shadowMapReads.push_back(pointShadow.cube);
+			}
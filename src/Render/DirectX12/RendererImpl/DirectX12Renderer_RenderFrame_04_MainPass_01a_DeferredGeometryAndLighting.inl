@@ -71,6 +71,16 @@
 	static_cast<float>(pointShadows.size()),
 	static_cast<float>(activeReflectionProbeCount)
 	};
+	if (clusteredLighting)
+	{
+		deferredConstants.uClusterGrid = {
+			static_cast<float>(lightClusters_.GetGridX()),
+			static_cast<float>(lightClusters_.GetGridY()),
+			static_cast<float>(lightClusters_.GetGridZ()),
+			static_cast<float>(lightClusters_.GetGlobalLightCount())
+		};
+		deferredConstants.uClusterSlices = { lightClusters_.GetSliceScale(), lightClusters_.GetSliceBias(), 0.0f, 0.0f };
+	}
 
 	// Import swapchain depth as an external RenderGraph texture so offscreen passes can use it.
 	const auto depthRG = graph.ImportTexture(
@@ -452,6 +462,7 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		att.reads = { gbuf1, depthRG };
 
 		graph.AddPass("SSAO", std::move(att),
 			[this, &scene, depthRG, gbuf1, ssaoRaw](renderGraph::PassContext& ctx)
@@ -500,6 +511,7 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		att.reads = { ssaoRaw, depthRG };
 
 		graph.AddPass("SSAOBlur", std::move(att),
 			[this, depthRG, ssaoRaw, ssaoBlur](renderGraph::PassContext& ctx)
@@ -541,9 +553,11 @@
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
 		att.clearDesc.color = { 0.0f, 0.0f, 0.0f, 1.0f };
+		att.reads = shadowMapReads;
+		att.reads.insert(att.reads.end(), { gbuf0, gbuf1, gbuf2, gbuf3, depthRG, ssaoBlur });
 
 		graph.AddPass("DeferredLighting", std::move(att),
-			[this, &scene, gbuf0, gbuf1, gbuf2, gbuf3, depthRG, shadowRG, spotShadows, pointShadows, deferredConstants, ssaoBlur, activeReflectionProbeCount](renderGraph::PassContext& ctx)
+			[this, &scene, gbuf0, gbuf1, gbuf2, gbuf3, depthRG, shadowRG, spotShadows, pointShadows, deferredConstants, ssaoBlur, activeReflectionProbeCount, clusteredLighting](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 
@@ -590,6 +604,13 @@
 					ctx.commandList.BindStructuredBufferSRV(19, reflectionProbeMetaBuffer_);
 				}
 
+				// Light clusters: t20 per-cluster {offset, count}, t21 light indices
+				if (clusteredLighting)
+				{
+					ctx.commandList.BindStructuredBufferSRV(20, clusterRangesBuffer_);
+					ctx.commandList.BindStructuredBufferSRV(21, clusterLightIndicesBuffer_);
+				}
+
 				ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &deferredConstants, 1 }));
 				ctx.commandList.Draw(3);
 			});
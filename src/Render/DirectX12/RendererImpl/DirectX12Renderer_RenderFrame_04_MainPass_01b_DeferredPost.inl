@@ -78,6 +78,7 @@ if (settings_.enableFog && psoFog_)
 	att.clearDesc.clearStencil = false;
 
 	const auto sceneColorIn = sceneColorAfterFog;
+	att.reads = { sceneColorIn, depthRG };
 	graph.AddPass("DeferredFog", std::move(att),
 		[this, depthRG, sceneColorIn, sceneColorFog, c](renderGraph::PassContext& ctx)
 		{
@@ -54,6 +54,7 @@ if (!transparentDraws.empty())
 	att.clearDesc.clearColor = false;
 	att.clearDesc.clearDepth = false;
 	att.clearDesc.clearStencil = false;
+	att.reads = shadowMapReads;
 
 	graph.AddPass("DeferredTransparent", std::move(att),
 		[this, &scene,
@@ -71,6 +72,8 @@ if (!transparentDraws.empty())
 		FillMainPassMaterialTextureIndices,
 		FillPerBatchViewLightingConstants,
 		ResetPerBatchEnvProbeBox,
+		FillCameraClusterConstants,
+		BindCameraClusterBuffers,
 		instStride](renderGraph::PassContext& ctx)
 	{
 		const auto extent = ctx.passExtent;
@@ -119,6 +122,9 @@ if (!transparentDraws.empty())
 		// Bind lights (t2 StructuredBuffer SRV)
 		ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
 
+		// Light clusters of the camera view (t20/t21)
+		BindCameraClusterBuffers(ctx.commandList);
+
 		for (const TransparentDraw& batchTransparent : transparentDraws)
 		{
 			if (!batchTransparent.mesh)
@@ -166,6 +172,7 @@ if (!transparentDraws.empty())
 				settings_.shadowSlopeScaleTexels
 			};
 			ResetPerBatchEnvProbeBox(constants);
+			FillCameraClusterConstants(constants, extent);
 
 			ctx.commandList.BindInputLayout(batchTransparent.mesh->layoutInstanced);
 			ctx.commandList.BindVertexBuffer(0, batchTransparent.mesh->vertexBuffer, batchTransparent.mesh->vertexStrideBytes, 0);
@@ -306,6 +313,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor };
 
 		graph.AddPass("DeferredBloomExtract", std::move(att),
 			[this, finalSceneColor, c](renderGraph::PassContext& ctx)
@@ -337,6 +345,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { bloomExtract };
 
 		graph.AddPass("DeferredBloomBlurX", std::move(att),
 			[this, bloomExtract, c](renderGraph::PassContext& ctx)
@@ -368,6 +377,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { bloomBlurX };
 
 		graph.AddPass("DeferredBloomBlurY", std::move(att),
 			[this, bloomBlurX, c](renderGraph::PassContext& ctx)
@@ -394,6 +404,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor, bloomBlurY };
 
 		graph.AddPass("DeferredBloomComposite", std::move(att),
 			[this, finalSceneColor, bloomBlurY, c](renderGraph::PassContext& ctx)
@@ -439,6 +450,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor };
 
 
 		graph.AddPass("DeferredPresentLdr", std::move(att),
@@ -477,7 +489,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 				}
 			});
 
-		graph.AddSwapChainPass("DeferredPresentFXAA", clear,
+		graph.AddSwapChainPass("DeferredPresentFXAA", clear, { presentLdr },
 			[this, presentLdr](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
@@ -513,7 +525,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 	}
 	else
 	{
-		graph.AddSwapChainPass("DeferredPresent", clear,
+		graph.AddSwapChainPass("DeferredPresent", clear, { finalSceneColor },
 			[this, finalSceneColor](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
@@ -52,6 +52,7 @@ if (canForwardSSAO)
 	att.colors = { ssaoRaw };
 	att.clearDesc.clearColor = true;
 	att.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	att.reads = { depthRG };
 
 	graph.AddPass("ForwardSSAO", std::move(att),
 		[this, &scene, depthRG](renderGraph::PassContext& ctx)
@@ -90,6 +91,7 @@ if (canForwardSSAO)
 	blurAtt.colors = { forwardSSAOBlur };
 	blurAtt.clearDesc.clearColor = true;
 	blurAtt.clearDesc.color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	blurAtt.reads = { ssaoRaw, depthRG };
 
 	graph.AddPass("ForwardSSAOBlur", std::move(blurAtt),
 		[this, depthRG, ssaoRaw, forwardSSAOBlur](renderGraph::PassContext& ctx)
@@ -129,6 +131,7 @@ mainAtt.useSwapChainBackbuffer = false;
 mainAtt.colors = { forwardSceneColor };
 mainAtt.depth = depthRG;
 mainAtt.clearDesc = clearDesc;
+mainAtt.reads = shadowMapReads;
 
 graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	this,
@@ -148,6 +151,8 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	FillMainPassMaterialTextureIndices,
 	BuildMainPassMaterialFlags,
 	ComputeForwardGBufferReflectionMeta,
+	FillCameraClusterConstants,
+	BindCameraClusterBuffers,
 	doDepthPrepass](renderGraph::PassContext& ctx)
 {
 	const auto extent = ctx.passExtent;
@@ -218,6 +223,9 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	// Bind lights (t2 StructuredBuffer SRV)
 	ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
 
+	// Light clusters of the camera view (t20/t21)
+	BindCameraClusterBuffers(ctx.commandList);
+
 	for (const Batch& batch : mainBatches)
 	{
 		if (!batch.mesh || batch.instanceCount == 0)
@@ -279,6 +287,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 
 		constants.uEnvProbeBoxMin = { 0.0f, 0.0f, 0.0f, envSourceForGBuffer };
 		constants.uEnvProbeBoxMax = { 0.0f, 0.0f, 0.0f, probeIdxNForGBuffer };
+		FillCameraClusterConstants(constants, extent);
 
 		// IA (instanced)
 		ctx.commandList.BindInputLayout(batch.mesh->layoutInstanced);
@@ -348,6 +357,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		const mathUtils::Mat4 modelT = mathUtils::Transpose(draw.model);
 		std::memcpy(constants.uModel.data(), mathUtils::ValuePtr(modelT), sizeof(float) * 16);
 		constants.uSkinning = { static_cast<float>(draw.paletteOffset), static_cast<float>(draw.boneCount), 0.0f, 0.0f };
+		FillCameraClusterConstants(constants, extent);
 
 		ctx.commandList.BindInputLayout(draw.mesh->layout);
 		ctx.commandList.BindVertexBuffer(0, draw.mesh->vertexBuffer, draw.mesh->vertexStrideBytes, 0);
@@ -371,6 +381,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 	transparentAtt.clearDesc.clearColor = false;
 	transparentAtt.clearDesc.clearDepth = false;
 	transparentAtt.clearDesc.clearStencil = false;
+	transparentAtt.reads = shadowMapReads;
 
 	graph.AddPass("ForwardTransparentPass", std::move(transparentAtt), [
 		this,
@@ -394,6 +405,8 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		FillMainPassMaterialTextureIndices,
 		FillPerBatchViewLightingConstants,
 		ResetPerBatchEnvProbeBox,
+		FillCameraClusterConstants,
+		BindCameraClusterBuffers,
 		particleCount,
 		doDepthPrepass](renderGraph::PassContext& ctx)
 	{
@@ -425,6 +438,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 		}
 		ctx.commandList.BindStructuredBufferSRV(11, shadowDataBuffer_);
 		ctx.commandList.BindStructuredBufferSRV(2, lightsBuffer_);
+		BindCameraClusterBuffers(ctx.commandList);
 
 	// If selected objects are opaque, draw outline/highlight BEFORE transparent objects
 	// so transparent surfaces still blend on top.
@@ -494,6 +508,7 @@ graph.AddPass("ForwardOpaquePass", std::move(mainAtt), [
 				settings_.shadowSlopeScaleTexels
 			};
 			ResetPerBatchEnvProbeBox(constants);
+			FillCameraClusterConstants(constants, extent);
 
 			ctx.commandList.BindInputLayout(batchTransparent.mesh->layoutInstanced);
 			ctx.commandList.BindVertexBuffer(0, batchTransparent.mesh->vertexBuffer, batchTransparent.mesh->vertexStrideBytes, 0);
@@ -545,6 +560,7 @@ if (canForwardSSAO)
 	aoAtt.clearDesc.clearColor = false;
 	aoAtt.clearDesc.clearDepth = false;
 	aoAtt.clearDesc.clearStencil = false;
+	aoAtt.reads = { forwardSceneColorAfterPost, forwardSSAOBlur };
 
 	const auto sceneColorIn = forwardSceneColorAfterPost;
 	graph.AddPass("ForwardSSAOComposite", std::move(aoAtt),
@@ -588,6 +604,7 @@ if (settings_.enableFog && psoFog_)
 	fogAtt.clearDesc.clearColor = false;
 	fogAtt.clearDesc.clearDepth = false;
 	fogAtt.clearDesc.clearStencil = false;
+	fogAtt.reads = { forwardSceneColorAfterPost, depthRG };
 
 	const auto sceneColorIn = forwardSceneColorAfterPost;
 	graph.AddPass("ForwardFog", std::move(fogAtt),
@@ -666,6 +683,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor };
 
 		graph.AddPass("ForwardBloomExtract", std::move(att),
 			[this, finalSceneColor, c](renderGraph::PassContext& ctx)
@@ -697,6 +715,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { bloomExtract };
 
 		graph.AddPass("ForwardBloomBlurX", std::move(att),
 			[this, bloomExtract, c](renderGraph::PassContext& ctx)
@@ -728,6 +747,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { bloomBlurX };
 
 		graph.AddPass("ForwardBloomBlurY", std::move(att),
 			[this, bloomBlurX, c](renderGraph::PassContext& ctx)
@@ -754,6 +774,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor, bloomBlurY };
 
 		graph.AddPass("ForwardBloomComposite", std::move(att),
 			[this, finalSceneColor, bloomBlurY, c](renderGraph::PassContext& ctx)
@@ -797,6 +818,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 		att.clearDesc.clearColor = false;
 		att.clearDesc.clearDepth = false;
 		att.clearDesc.clearStencil = false;
+		att.reads = { finalSceneColor };
 
 		graph.AddPass("ForwardPresentLdr", std::move(att), [this, finalSceneColor](renderGraph::PassContext& ctx)
 			{
@@ -829,7 +851,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 				}
 			});
 
-		graph.AddSwapChainPass("ForwardPresentFXAA", clear, [this, presentLdr](renderGraph::PassContext& ctx)
+		graph.AddSwapChainPass("ForwardPresentFXAA", clear, { presentLdr }, [this, presentLdr](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 				ctx.commandList.SetViewport(0, 0, static_cast<int>(extent.width), static_cast<int>(extent.height));
@@ -859,7 +881,7 @@ if (settings_.enableHDR && settings_.enableBloom &&
 	}
 	else
 	{
-		graph.AddSwapChainPass("ForwardPresent", clear, [this, finalSceneColor](renderGraph::PassContext& ctx)
+		graph.AddSwapChainPass("ForwardPresent", clear, { finalSceneColor }, [this, finalSceneColor](renderGraph::PassContext& ctx)
 			{
 				const auto extent = ctx.passExtent;
 				ctx.commandList.SetViewport(0, 0, static_cast<int>(extent.width), static_cast<int>(extent.height));
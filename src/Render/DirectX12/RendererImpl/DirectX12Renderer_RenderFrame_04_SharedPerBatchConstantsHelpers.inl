@@ -32,4 +32,35 @@ auto ApplyPerBatchReflectionProbeBox = [&](PerBatchConstants& constants, int ref
 		const float h = settings_.reflectionProbeBoxHalfExtent;
 		constants.uEnvProbeBoxMin = { probe.capturePos.x - h, probe.capturePos.y - h, probe.capturePos.z - h, 0.0f };
 		constants.uEnvProbeBoxMax = { probe.capturePos.x + h, probe.capturePos.y + h, probe.capturePos.z + h, 0.0f };
-	};
\ No newline at end of file
+	};
+
+// Camera forward passes only: points the shader at this frame's light clusters (t20/t21). Reflection and capture
+// views leave the grid zero, so their pixels loop over every light.
+auto FillCameraClusterConstants = [&](auto& constants, const rhi::Extent2D& extent)
+	{
+		if (!clusteredLighting || extent.width == 0 || extent.height == 0)
+		{
+			return;
+		}
+		constants.uClusterGrid = {
+			static_cast<float>(lightClusters_.GetGridX()),
+			static_cast<float>(lightClusters_.GetGridY()),
+			static_cast<float>(lightClusters_.GetGridZ()),
+			static_cast<float>(lightClusters_.GetGlobalLightCount())
+		};
+		constants.uClusterSlices = {
+			lightClusters_.GetSliceScale(),
+			lightClusters_.GetSliceBias(),
+			1.0f / static_cast<float>(extent.width),
+			1.0f / static_cast<float>(extent.height)
+		};
+	};
+
+auto BindCameraClusterBuffers = [&](rhi::CommandList& commandList)
+	{
+		if (clusteredLighting)
+		{
+			commandList.BindStructuredBufferSRV(20, clusterRangesBuffer_);
+			commandList.BindStructuredBufferSRV(21, clusterLightIndicesBuffer_);
+		}
+	};
@@ -150,6 +150,7 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			att.clearDesc.depth = 1.0f;
 			att.clearDesc.clearStencil = true;
 			att.clearDesc.stencil = 0;
+			att.reads = shadowMapReads;
 
 			graph.AddPass(std::string("PlanarReflScene_") + std::to_string(mirrorIndex), std::move(att),
 				[
@@ -438,6 +439,7 @@ if (settings_.enablePlanarReflections && !planarMirrorDraws.empty())
 			att.clearDesc.clearColor = false;
 			att.clearDesc.clearDepth = false;
 			att.clearDesc.clearStencil = false;
+			att.reads = { maskTex, reflColor };
 
 			graph.AddPass(std::string("PlanarComposite_") + std::to_string(mirrorIndex), std::move(att),
 				[this, maskTex, reflColor](renderGraph::PassContext& ctx)
@@ -911,7 +911,7 @@ if (settings_.ShowCubeAtlas)
 
 		const auto cubeRG = *debugCubeRG;
 
-		graph.AddSwapChainPass("DebugPointShadowAtlas", clear,
+		graph.AddSwapChainPass("DebugPointShadowAtlas", clear, { cubeRG },
 			[this, cubeRG, debugInvRange, debugInvert, debugMode](renderGraph::PassContext& ctx)
 			{
 				struct alignas(16) DebugCubeAtlasCB
@@ -1081,4 +1081,5 @@ if (!textList.Empty())
 }
 
 graph.Execute(device_, swapChain);
-swapChain.Present();
\ No newline at end of file
+swapChain.Present();
+frameSync_.EndFrame();
@@ -1,3 +1,6 @@
+// Let in-flight frames finish and run their deferred releases before tearing resources down.
+frameSync_.WaitIdle();
+
 if (fullscreenLayout_.id != 0)
 {
 	device_.DestroyInputLayout(fullscreenLayout_);
@@ -23,6 +26,14 @@ if (lightsBuffer_)
 {
 	device_.DestroyBuffer(lightsBuffer_);
 }
+if (clusterRangesBuffer_)
+{
+	device_.DestroyBuffer(clusterRangesBuffer_);
+}
+if (clusterLightIndicesBuffer_)
+{
+	device_.DestroyBuffer(clusterLightIndicesBuffer_);
+}
 if (shadowDataBuffer_)
 {
 	device_.DestroyBuffer(shadowDataBuffer_);
@@ -81,5 +92,16 @@ DestroyMesh(device_, skyboxMesh_);
 DestroyMesh(device_, particleMesh_);
 debugDrawRenderer_.Shutdown();
 debugTextRenderer_.Shutdown();
+renderGraph_.ReleaseTransientResources(device_);
 psoCache_.ClearCache();
-shaderLibrary_.ClearCache();
\ No newline at end of file
+shaderLibrary_.ClearCache();
+
+device_.SetPipelineCache(nullptr);
+if (settings_.debugPrintDrawCalls)
+{
+	const rhi::PipelineCacheStats pipelineStats = pipelineCache_.GetStats();
+	std::cout << "[DX12] Pipeline cache: " << pipelineStats.hits << " warm, " << pipelineStats.misses << " cold"
+		<< " (" << pipelineStats.rejected << " rejected), " << pipelineStats.compileMs << " ms creating PSOs, "
+		<< pipelineStats.loadedEntries << " entries loaded\n";
+}
+SavePipelineCacheFile(pipelineCache_, settings_.pipelineCachePath);
\ No newline at end of file
@@ -0,0 +1,37 @@
+			if (!settings_.enableClusteredLighting || !clusterRangesBuffer_ || !clusterLightIndicesBuffer_)
+			{
+				return false;
+			}
+
+			// Slices cover the whole camera depth range, so no lit pixel of the camera view lies beyond them.
+			const float nearZ = std::max(camera.nearZ, 1e-3f);
+			const float farZ = std::max(camera.farZ, nearZ * 2.0f);
+			lightClusters_.BeginFrame(cameraView, cameraProj, nearZ, farZ);
+
+			for (std::uint32_t lightIndex = 0; lightIndex < static_cast<std::uint32_t>(gpuLights_.size()); ++lightIndex)
+			{
+				const GPULight& light = gpuLights_[lightIndex];
+				const mathUtils::Vec3 position{ light.p0[0], light.p0[1], light.p0[2] };
+				const float range = light.p2[3];
+				switch (static_cast<LightType>(static_cast<std::uint32_t>(light.p0[3])))
+				{
+				case LightType::Point:
+					lightClusters_.AddPointLight(lightIndex, position, range);
+					break;
+				case LightType::Spot:
+					lightClusters_.AddSpotLight(lightIndex, position, mathUtils::Vec3{ light.p1[0], light.p1[1], light.p1[2] }, range, light.p3[1]);
+					break;
+				default:
+					lightClusters_.AddGlobalLight(lightIndex);
+					break;
+				}
+			}
+			lightClusters_.Build();
+
+			device_.UpdateBuffer(clusterRangesBuffer_, std::as_bytes(lightClusters_.GetClusterRanges()));
+			const std::span<const std::uint32_t> indices = lightClusters_.GetLightIndices();
+			if (!indices.empty())
+			{
+				device_.UpdateBuffer(clusterLightIndicesBuffer_, std::as_bytes(indices));
+			}
+			return true;
@@ -1,4 +1,5 @@
-			std::vector<GPULight> gpu;
+			std::vector<GPULight>& gpu = gpuLights_;
+			gpu.clear();
 			gpu.reserve(std::min<std::size_t>(scene.lights.size(), kMaxLights));
 
 			for (const auto& light : scene.lights)
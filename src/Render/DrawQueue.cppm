@@ -0,0 +1,188 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+export module core:draw_queue;
+
+export namespace rendern
+{
+	// Fields packed into a 64-bit draw sort key. Ids are compact per-frame values chosen by the caller;
+	// bits beyond a field's width are dropped, which only costs ordering quality, never correctness,
+	// as long as batching compares the real draw state of neighbours after sorting.
+	struct DrawKeyFields
+	{
+		std::uint32_t pass{ 0 };      // 4 bits: main, capture, shadow, ...
+		std::uint32_t pipeline{ 0 };  // 12 bits: PSO / shader permutation
+		std::uint32_t material{ 0 };  // 16 bits
+		std::uint32_t mesh{ 0 };      // 15 bits (opaque), 7 bits (translucent)
+		float depth{ 0.0f };          // view depth or squared distance; negative and NaN clamp to 0
+	};
+
+	// Bit layout, most significant first:
+	//   opaque:      pass:4 | 0:1 | pipeline:12 | material:16 | mesh:15 | depth:16   (state first, then front to back)
+	//   translucent: pass:4 | 1:1 | ~depth:24   | pipeline:12 | material:16 | mesh:7 (back to front, then state)
+	// Both flavours share one queue: within a pass every translucent draw sorts after every opaque one.
+	namespace drawKey
+	{
+		inline constexpr std::uint32_t kPassBits = 4;
+		inline constexpr std::uint32_t kPipelineBits = 12;
+		inline constexpr std::uint32_t kMaterialBits = 16;
+		inline constexpr std::uint32_t kOpaqueMeshBits = 15;
+		inline constexpr std::uint32_t kOpaqueDepthBits = 16;
+		inline constexpr std::uint32_t kTranslucentDepthBits = 24;
+		inline constexpr std::uint32_t kTranslucentMeshBits = 7;
+
+		inline constexpr std::uint32_t kPassShift = 60;
+		inline constexpr std::uint64_t kTranslucentBit = 1ull << 59;
+
+		constexpr std::uint64_t Field(std::uint32_t value, std::uint32_t bits, std::uint32_t shift) noexcept
+		{
+			return (static_cast<std::uint64_t>(value) & ((1ull << bits) - 1ull)) << shift;
+		}
+
+		// Positive IEEE floats order like their bit patterns, so the top bits are a log-scale
+		// quantization that needs no near/far range.
+		constexpr std::uint32_t QuantizeDepth(float depth, std::uint32_t bits) noexcept
+		{
+			if (!(depth > 0.0f))
+			{
+				return 0u;
+			}
+			return std::bit_cast<std::uint32_t>(depth) >> (31u - bits);
+		}
+
+		constexpr std::uint64_t Opaque(const DrawKeyFields& f) noexcept
+		{
+			return Field(f.pass, kPassBits, kPassShift)
+				| Field(f.pipeline, kPipelineBits, 47)
+				| Field(f.material, kMaterialBits, 31)
+				| Field(f.mesh, kOpaqueMeshBits, 16)
+				| Field(QuantizeDepth(f.depth, kOpaqueDepthBits), kOpaqueDepthBits, 0);
+		}
+
+		constexpr std::uint64_t Translucent(const DrawKeyFields& f) noexcept
+		{
+			const std::uint32_t farFirst = ~QuantizeDepth(f.depth, kTranslucentDepthBits);
+			return Field(f.pass, kPassBits, kPassShift)
+				| kTranslucentBit
+				| Field(farFirst, kTranslucentDepthBits, 35)
+				| Field(f.pipeline, kPipelineBits, 23)
+				| Field(f.material, kMaterialBits, 7)
+				| Field(f.mesh, kTranslucentMeshBits, 0);
+		}
+
+		constexpr std::uint32_t Pass(std::uint64_t key) noexcept
+		{
+			return static_cast<std::uint32_t>(key >> kPassShift);
+		}
+
+		constexpr bool IsTranslucent(std::uint64_t key) noexcept
+		{
+			return (key & kTranslucentBit) != 0;
+		}
+	}
+
+	// Flat list of (key, payload index) pairs sorted with an LSD radix sort. Payloads stay in the caller's
+	// arrays; after Sort() the caller walks Items() in order and merges neighbours into batches.
+	class DrawQueue
+	{
+	public:
+		struct Item
+		{
+			std::uint64_t key{ 0 };
+			std::uint32_t index{ 0 };
+		};
+
+		void Clear() noexcept
+		{
+			items_.clear();
+		}
+
+		void Reserve(std::size_t count)
+		{
+			items_.reserve(count);
+		}
+
+		void Push(std::uint64_t key, std::uint32_t index)
+		{
+			items_.push_back(Item{ key, index });
+		}
+
+		// Stable ascending sort over 8-bit digits. All digit histograms are built in one pass and
+		// digits that are identical across the whole queue are skipped, so keys with unused high
+		// fields (single pass, few pipelines) cost fewer than 8 scatter passes.
+		void Sort()
+		{
+			const std::size_t count = items_.size();
+			if (count < 2)
+			{
+				return;
+			}
+
+			std::array<std::array<std::uint32_t, 256>, 8> histograms{};
+			for (const Item& item : items_)
+			{
+				for (std::size_t digit = 0; digit < 8; ++digit)
+				{
+					++histograms[digit][(item.key >> (digit * 8)) & 0xFFu];
+				}
+			}
+
+			scratch_.resize(count);
+			Item* src = items_.data();
+			Item* dst = scratch_.data();
+			for (std::size_t digit = 0; digit < 8; ++digit)
+			{
+				std::array<std::uint32_t, 256>& histogram = histograms[digit];
+				const std::uint32_t firstBucket = static_cast<std::uint32_t>((src[0].key >> (digit * 8)) & 0xFFu);
+				if (histogram[firstBucket] == count)
+				{
+					continue;
+				}
+
+				std::uint32_t offset = 0;
+				for (std::uint32_t& bucket : histogram)
+				{
+					const std::uint32_t size = bucket;
+					bucket = offset;
+					offset += size;
+				}
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					dst[histogram[(src[i].key >> (digit * 8)) & 0xFFu]++] = src[i];
+				}
+				std::swap(src, dst);
+			}
+
+			if (src != items_.data())
+			{
+				items_.swap(scratch_);
+			}
+		}
+
+		std::span<const Item> Items() const noexcept
+		{
+			return items_;
+		}
+
+		std::size_t Size() const noexcept
+		{
+			return items_.size();
+		}
+
+		bool Empty() const noexcept
+		{
+			return items_.empty();
+		}
+
+	private:
+		std::vector<Item> items_;
+		std::vector<Item> scratch_;
+	};
+}
@@ -1,6 +1,15 @@
 module;
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 export module core:render_gpu_memory;
 
@@ -14,13 +23,38 @@ import :rhi;
 
 export namespace renderer
 {
-	struct BufferAllocation 
+	struct BufferAllocation
 	{
 		rhi::BufferHandle buffer;
 		std::size_t offsetBytes;
 		std::size_t sizeInBytes;
 	};
 
+	struct GPUMemoryStats
+	{
+		std::size_t blockCount{ 0 };
+		std::size_t reservedBytes{ 0 };		// backing blocks
+		std::size_t usedBytes{ 0 };			// sub-allocations, including alignment padding
+		std::size_t allocationCount{ 0 };
+		std::size_t freeRangeCount{ 0 };
+		std::size_t largestFreeRangeBytes{ 0 };
+		std::size_t contiguousFreeBytes{ 0 };	// sum over blocks of each block's largest free range
+		std::size_t dedicatedCount{ 0 };	// buffers that bypass the blocks (too large / not poolable)
+		std::size_t dedicatedBytes{ 0 };
+
+		double Utilization() const noexcept
+		{
+			return reservedBytes == 0 ? 0.0 : static_cast<double>(usedBytes) / static_cast<double>(reservedBytes);
+		}
+
+		// 0 when every block's free space is one range, towards 1 as it splinters.
+		double Fragmentation() const noexcept
+		{
+			const std::size_t freeBytes = reservedBytes - usedBytes;
+			return freeBytes == 0 ? 0.0 : 1.0 - static_cast<double>(contiguousFreeBytes) / static_cast<double>(freeBytes);
+		}
+	};
+
 	class IGPUMemoryAllocator
 	{
 	public:
@@ -28,6 +62,7 @@ export namespace renderer
 
 		virtual BufferAllocation AllocateBuffer(const rhi::BufferDesc& desc) = 0;
 		virtual void FreeBuffer(const BufferAllocation& allocation) noexcept = 0;
+		virtual GPUMemoryStats GetStats() const { return {}; }
 	};
 
 	class NullGPUMemoryAllocator final : public IGPUMemoryAllocator
@@ -51,4 +86,498 @@ export namespace renderer
 	private:
 		rhi::IRHIDevice& device_;
 	};
-}
\ No newline at end of file
+
+	// Two-level segregated fit (TLSF) range allocator over [0, capacity). Sizes and offsets are kept in
+	// `granularity` units; free ranges sit in 16 linear size classes per power of two, and two bitmaps
+	// find a large-enough class in O(1). Freed ranges merge with free physical neighbours immediately.
+	// Purely CPU-side: it hands out offsets, the caller owns the memory.
+	class TlsfRangeAllocator
+	{
+	public:
+		TlsfRangeAllocator(std::size_t capacityBytes, std::size_t granularityBytes)
+			: granularity_(granularityBytes)
+		{
+			if (granularity_ == 0 || !std::has_single_bit(granularity_))
+			{
+				throw std::runtime_error("TlsfRangeAllocator: granularity must be a power of two");
+			}
+			capacityUnits_ = capacityBytes / granularity_;
+			if (capacityUnits_ == 0)
+			{
+				throw std::runtime_error("TlsfRangeAllocator: capacity is smaller than the granularity");
+			}
+			freeHeads_.fill(kNull);
+
+			const std::uint32_t node = NewNode();
+			nodes_[node].offset = 0;
+			nodes_[node].size = capacityUnits_;
+			InsertFree(node);
+		}
+
+		// Returns the byte offset of a range of at least `sizeBytes`, aligned to `alignmentBytes`
+		// (rounded up to the granularity), or nullopt when no free range is large enough.
+		std::optional<std::size_t> Allocate(std::size_t sizeBytes, std::size_t alignmentBytes = 0)
+		{
+			const std::size_t alignUnits = std::max<std::size_t>(1, std::bit_ceil(std::max(alignmentBytes, granularity_)) / granularity_);
+			const std::size_t units = std::max<std::size_t>(1, (sizeBytes + granularity_ - 1) / granularity_);
+			const std::size_t searchUnits = units + alignUnits - 1;
+			if (searchUnits > capacityUnits_)
+			{
+				return std::nullopt;
+			}
+
+			std::uint32_t node = FindFree(searchUnits);
+			if (node == kNull)
+			{
+				node = FindFreeInOwnClass(searchUnits);
+			}
+			if (node == kNull)
+			{
+				return std::nullopt;
+			}
+			RemoveFree(node);
+
+			// Leading padding goes back as its own free range (its left neighbour is in use, otherwise
+			// the two would have been merged).
+			const std::size_t aligned = (nodes_[node].offset + alignUnits - 1) / alignUnits * alignUnits;
+			std::uint32_t used = node;
+			if (aligned != nodes_[node].offset)
+			{
+				used = Split(node, aligned - nodes_[node].offset);
+				InsertFree(node);
+			}
+			if (nodes_[used].size > units)
+			{
+				const std::uint32_t tail = Split(used, units);
+				InsertFree(tail);
+			}
+
+			nodes_[used].free = false;
+			usedUnits_ += nodes_[used].size;
+			++allocationCount_;
+			const std::size_t offsetBytes = nodes_[used].offset * granularity_;
+			liveByOffset_.emplace(offsetBytes, used);
+			return offsetBytes;
+		}
+
+		// Returns false for offsets that were not handed out by Allocate().
+		bool Free(std::size_t offsetBytes) noexcept
+		{
+			auto it = liveByOffset_.find(offsetBytes);
+			if (it == liveByOffset_.end())
+			{
+				return false;
+			}
+			std::uint32_t node = it->second;
+			liveByOffset_.erase(it);
+
+			usedUnits_ -= nodes_[node].size;
+			--allocationCount_;
+			nodes_[node].free = true;
+
+			if (const std::uint32_t prev = nodes_[node].prevPhys; prev != kNull && nodes_[prev].free)
+			{
+				RemoveFree(prev);
+				Merge(prev, node);
+				node = prev;
+			}
+			if (const std::uint32_t next = nodes_[node].nextPhys; next != kNull && nodes_[next].free)
+			{
+				RemoveFree(next);
+				Merge(node, next);
+			}
+			InsertFree(node);
+			return true;
+		}
+
+		std::size_t CapacityBytes() const noexcept { return capacityUnits_ * granularity_; }
+		std::size_t UsedBytes() const noexcept { return usedUnits_ * granularity_; }
+		std::size_t FreeBytes() const noexcept { return (capacityUnits_ - usedUnits_) * granularity_; }
+		std::size_t AllocationCount() const noexcept { return allocationCount_; }
+		std::size_t FreeRangeCount() const noexcept { return freeRangeCount_; }
+		bool Empty() const noexcept { return allocationCount_ == 0; }
+
+		std::size_t LargestFreeRangeBytes() const noexcept
+		{
+			if (flBitmap_ == 0)
+			{
+				return 0;
+			}
+			const std::uint32_t fl = static_cast<std::uint32_t>(std::bit_width(flBitmap_) - 1);
+			const std::uint32_t sl = static_cast<std::uint32_t>(std::bit_width(slBitmaps_[fl]) - 1);
+			std::size_t largest = 0;
+			for (std::uint32_t node = freeHeads_[fl * kSlCount + sl]; node != kNull; node = nodes_[node].nextFree)
+			{
+				largest = std::max(largest, nodes_[node].size);
+			}
+			return largest * granularity_;
+		}
+
+	private:
+		static constexpr std::uint32_t kNull = std::numeric_limits<std::uint32_t>::max();
+		static constexpr std::uint32_t kSlLog2 = 4;
+		static constexpr std::uint32_t kSlCount = 1u << kSlLog2;
+		static constexpr std::uint32_t kFlCount = 64 - kSlLog2 + 1;
+
+		struct Node
+		{
+			std::size_t offset{ 0 };	// units
+			std::size_t size{ 0 };		// units
+			std::uint32_t prevPhys{ kNull };
+			std::uint32_t nextPhys{ kNull };
+			std::uint32_t prevFree{ kNull };
+			std::uint32_t nextFree{ kNull };
+			bool free{ false };
+		};
+
+		static void Mapping(std::size_t units, std::uint32_t& fl, std::uint32_t& sl) noexcept
+		{
+			if (units < kSlCount)
+			{
+				fl = 0;
+				sl = static_cast<std::uint32_t>(units);
+				return;
+			}
+			const std::uint32_t msb = static_cast<std::uint32_t>(std::bit_width(units) - 1);
+			sl = static_cast<std::uint32_t>(units >> (msb - kSlLog2)) ^ kSlCount;
+			fl = msb - kSlLog2 + 1;
+		}
+
+		// First free range whose class guarantees >= units (the request is rounded up to the next class).
+		std::uint32_t FindFree(std::size_t units) const noexcept
+		{
+			if (units >= kSlCount)
+			{
+				const std::uint32_t msb = static_cast<std::uint32_t>(std::bit_width(units) - 1);
+				units += (std::size_t{ 1 } << (msb - kSlLog2)) - 1;
+			}
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			Mapping(units, fl, sl);
+			if (fl >= kFlCount)
+			{
+				return kNull;
+			}
+
+			std::uint32_t slMap = slBitmaps_[fl] & (~0u << sl);
+			if (slMap == 0)
+			{
+				const std::uint64_t flMap = (fl + 1 < 64) ? (flBitmap_ & (~std::uint64_t{ 0 } << (fl + 1))) : 0;
+				if (flMap == 0)
+				{
+					return kNull;
+				}
+				fl = static_cast<std::uint32_t>(std::countr_zero(flMap));
+				slMap = slBitmaps_[fl];
+			}
+			sl = static_cast<std::uint32_t>(std::countr_zero(slMap));
+			return freeHeads_[fl * kSlCount + sl];
+		}
+
+		// Good-fit lookup above skips the request's own class; fall back to scanning it so a request that
+		// only fits a range of its own class (e.g. the whole capacity) still succeeds.
+		std::uint32_t FindFreeInOwnClass(std::size_t units) const noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			Mapping(units, fl, sl);
+			if (fl >= kFlCount)
+			{
+				return kNull;
+			}
+			for (std::uint32_t node = freeHeads_[fl * kSlCount + sl]; node != kNull; node = nodes_[node].nextFree)
+			{
+				if (nodes_[node].size >= units)
+				{
+					return node;
+				}
+			}
+			return kNull;
+		}
+
+		void InsertFree(std::uint32_t node) noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			Mapping(nodes_[node].size, fl, sl);
+			std::uint32_t& head = freeHeads_[fl * kSlCount + sl];
+
+			nodes_[node].free = true;
+			nodes_[node].prevFree = kNull;
+			nodes_[node].nextFree = head;
+			if (head != kNull)
+			{
+				nodes_[head].prevFree = node;
+			}
+			head = node;
+			flBitmap_ |= std::uint64_t{ 1 } << fl;
+			slBitmaps_[fl] |= 1u << sl;
+			++freeRangeCount_;
+		}
+
+		void RemoveFree(std::uint32_t node) noexcept
+		{
+			std::uint32_t fl = 0;
+			std::uint32_t sl = 0;
+			Mapping(nodes_[node].size, fl, sl);
+			std::uint32_t& head = freeHeads_[fl * kSlCount + sl];
+
+			const Node& n = nodes_[node];
+			if (n.prevFree != kNull)
+			{
+				nodes_[n.prevFree].nextFree = n.nextFree;
+			}
+			else
+			{
+				head = n.nextFree;
+			}
+			if (n.nextFree != kNull)
+			{
+				nodes_[n.nextFree].prevFree = n.prevFree;
+			}
+			if (head == kNull)
+			{
+				slBitmaps_[fl] &= ~(1u << sl);
+				if (slBitmaps_[fl] == 0)
+				{
+					flBitmap_ &= ~(std::uint64_t{ 1 } << fl);
+				}
+			}
+			nodes_[node].free = false;
+			--freeRangeCount_;
+		}
+
+		// Cuts `node` after `units`; returns the new right-hand node (not in any free list).
+		std::uint32_t Split(std::uint32_t node, std::size_t units)
+		{
+			const std::uint32_t right = NewNode();
+			Node& left = nodes_[node];
+			Node& r = nodes_[right];
+			r.offset = left.offset + units;
+			r.size = left.size - units;
+			r.prevPhys = node;
+			r.nextPhys = left.nextPhys;
+			if (left.nextPhys != kNull)
+			{
+				nodes_[left.nextPhys].prevPhys = right;
+			}
+			left.size = units;
+			left.nextPhys = right;
+			return right;
+		}
+
+		// Absorbs `right` (the physical successor of `left`) into `left`.
+		void Merge(std::uint32_t left, std::uint32_t right) noexcept
+		{
+			nodes_[left].size += nodes_[right].size;
+			nodes_[left].nextPhys = nodes_[right].nextPhys;
+			if (nodes_[right].nextPhys != kNull)
+			{
+				nodes_[nodes_[right].nextPhys].prevPhys = left;
+			}
+			nodes_[right] = Node{};
+			recycledNodes_.push_back(right);
+		}
+
+		std::uint32_t NewNode()
+		{
+			if (!recycledNodes_.empty())
+			{
+				const std::uint32_t node = recycledNodes_.back();
+				recycledNodes_.pop_back();
+				return node;
+			}
+			nodes_.emplace_back();
+			return static_cast<std::uint32_t>(nodes_.size() - 1);
+		}
+
+		std::size_t granularity_{ 1 };
+		std::size_t capacityUnits_{ 0 };
+		std::size_t usedUnits_{ 0 };
+		std::size_t allocationCount_{ 0 };
+		std::size_t freeRangeCount_{ 0 };
+
+		std::uint64_t flBitmap_{ 0 };
+		std::array<std::uint32_t, kFlCount> slBitmaps_{};
+		std::array<std::uint32_t, kFlCount * kSlCount> freeHeads_{};
+
+		std::vector<Node> nodes_;
+		std::vector<std::uint32_t> recycledNodes_;
+		std::unordered_map<std::size_t, std::uint32_t> liveByOffset_;
+	};
+
+	struct SubAllocatorDesc
+	{
+		std::size_t blockSizeBytes{ 32ull * 1024ull * 1024ull };
+		// Offsets handed out are multiples of this (covers vertex/index offset rules of every backend).
+		std::size_t alignmentBytes{ 256 };
+	};
+
+	// Sub-allocates vertex and index buffers out of large backing buffers, one block list per
+	// (bind flag, usage) class. Constant/uniform/structured buffers and requests larger than a block
+	// get dedicated buffers: their views cover the whole resource.
+	//
+	// Works on any IRHIDevice. Callers bind `allocation.buffer` with `allocation.offsetBytes` and
+	// upload with `UpdateBuffer(buffer, data, offsetBytes)`. Empty blocks are kept for reuse until
+	// ReleaseEmptyBlocks().
+	class SubAllocatingGPUMemoryAllocator final : public IGPUMemoryAllocator
+	{
+	public:
+		explicit SubAllocatingGPUMemoryAllocator(rhi::IRHIDevice& device, SubAllocatorDesc desc = {})
+			: device_(device)
+			, desc_(desc)
+		{
+			if (desc_.alignmentBytes == 0 || !std::has_single_bit(desc_.alignmentBytes) || desc_.blockSizeBytes < desc_.alignmentBytes)
+			{
+				throw std::runtime_error("SubAllocatingGPUMemoryAllocator: invalid block size / alignment");
+			}
+			// Blocks hold whole alignment units only; keep the size the range allocator can actually hand out.
+			desc_.blockSizeBytes -= desc_.blockSizeBytes % desc_.alignmentBytes;
+		}
+
+		~SubAllocatingGPUMemoryAllocator() override
+		{
+			for (Block& block : blocks_)
+			{
+				device_.DestroyBuffer(block.buffer);
+			}
+		}
+
+		SubAllocatingGPUMemoryAllocator(const SubAllocatingGPUMemoryAllocator&) = delete;
+		SubAllocatingGPUMemoryAllocator& operator=(const SubAllocatingGPUMemoryAllocator&) = delete;
+
+		BufferAllocation AllocateBuffer(const rhi::BufferDesc& desc) override
+		{
+			if (!IsPoolable(desc))
+			{
+				return AllocateDedicated(desc);
+			}
+
+			for (Block& block : blocks_)
+			{
+				if (block.bindFlag != desc.bindFlag || block.usageFlag != desc.usageFlag)
+				{
+					continue;
+				}
+				if (const std::optional<std::size_t> offset = block.ranges.Allocate(desc.sizeInBytes))
+				{
+					return BufferAllocation{ .buffer = block.buffer, .offsetBytes = *offset, .sizeInBytes = desc.sizeInBytes };
+				}
+			}
+
+			rhi::BufferDesc blockDesc{};
+			blockDesc.bindFlag = desc.bindFlag;
+			blockDesc.usageFlag = desc.usageFlag;
+			blockDesc.sizeInBytes = desc_.blockSizeBytes;
+			blockDesc.debugName = "GPUMemoryBlock";
+
+			Block& block = blocks_.emplace_back(Block{
+				.buffer = device_.CreateBuffer(blockDesc),
+				.bindFlag = desc.bindFlag,
+				.usageFlag = desc.usageFlag,
+				.ranges = TlsfRangeAllocator(desc_.blockSizeBytes, desc_.alignmentBytes) });
+
+			if (const std::optional<std::size_t> offset = block.ranges.Allocate(desc.sizeInBytes))
+			{
+				return BufferAllocation{ .buffer = block.buffer, .offsetBytes = *offset, .sizeInBytes = desc.sizeInBytes };
+			}
+
+			// Not expected for poolable sizes; never hand out an offset the block cannot back.
+			device_.DestroyBuffer(block.buffer);
+			blocks_.pop_back();
+			return AllocateDedicated(desc);
+		}
+
+		void FreeBuffer(const BufferAllocation& allocation) noexcept override
+		{
+			if (allocation.buffer.id == 0)
+			{
+				return;
+			}
+
+			for (Block& block : blocks_)
+			{
+				if (block.buffer == allocation.buffer)
+				{
+					block.ranges.Free(allocation.offsetBytes);
+					return;
+				}
+			}
+
+			if (auto it = std::find(dedicated_.begin(), dedicated_.end(), allocation.buffer); it != dedicated_.end())
+			{
+				*it = dedicated_.back();
+				dedicated_.pop_back();
+				dedicatedBytes_ -= allocation.sizeInBytes;
+				device_.DestroyBuffer(allocation.buffer);
+			}
+		}
+
+		// Destroys backing buffers that hold no allocations. Returns the number released.
+		std::size_t ReleaseEmptyBlocks() noexcept
+		{
+			const std::size_t before = blocks_.size();
+			std::erase_if(blocks_, [this](const Block& block)
+				{
+					if (!block.ranges.Empty())
+					{
+						return false;
+					}
+					device_.DestroyBuffer(block.buffer);
+					return true;
+				});
+			return before - blocks_.size();
+		}
+
+		GPUMemoryStats GetStats() const override
+		{
+			GPUMemoryStats stats{};
+			stats.blockCount = blocks_.size();
+			stats.dedicatedCount = dedicated_.size();
+			stats.dedicatedBytes = dedicatedBytes_;
+			for (const Block& block : blocks_)
+			{
+				stats.reservedBytes += block.ranges.CapacityBytes();
+				stats.usedBytes += block.ranges.UsedBytes();
+				stats.allocationCount += block.ranges.AllocationCount();
+				stats.freeRangeCount += block.ranges.FreeRangeCount();
+				const std::size_t largest = block.ranges.LargestFreeRangeBytes();
+				stats.largestFreeRangeBytes = std::max(stats.largestFreeRangeBytes, largest);
+				stats.contiguousFreeBytes += largest;
+			}
+			return stats;
+		}
+
+		const SubAllocatorDesc& GetDesc() const noexcept { return desc_; }
+
+	private:
+		struct Block
+		{
+			rhi::BufferHandle buffer{};
+			rhi::BufferBindFlag bindFlag{};
+			rhi::BufferUsageFlag usageFlag{};
+			TlsfRangeAllocator ranges;
+		};
+
+		// desc_.blockSizeBytes is already rounded down to the alignment, i.e. the usable capacity of a block.
+		bool IsPoolable(const rhi::BufferDesc& desc) const noexcept
+		{
+			const bool geometry = desc.bindFlag == rhi::BufferBindFlag::VertexBuffer || desc.bindFlag == rhi::BufferBindFlag::IndexBuffer;
+			return geometry && desc.sizeInBytes != 0 && desc.sizeInBytes <= desc_.blockSizeBytes;
+		}
+
+		BufferAllocation AllocateDedicated(const rhi::BufferDesc& desc)
+		{
+			const rhi::BufferHandle buffer = device_.CreateBuffer(desc);
+			dedicated_.push_back(buffer);
+			dedicatedBytes_ += desc.sizeInBytes;
+			return BufferAllocation{ .buffer = buffer, .offsetBytes = 0, .sizeInBytes = desc.sizeInBytes };
+		}
+
+		rhi::IRHIDevice& device_;
+		SubAllocatorDesc desc_{};
+		std::vector<Block> blocks_;
+		std::vector<rhi::BufferHandle> dedicated_;
+		std::size_t dedicatedBytes_{ 0 };
+	};
+}
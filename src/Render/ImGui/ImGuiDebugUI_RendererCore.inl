@@ -313,8 +313,13 @@ namespace rendern::ui
 
         ImGui::Checkbox("Depth prepass", &rs.enableDepthPrepass);
         ImGui::Checkbox("Deferred (experimental)", &rs.enableDeferred);
+        ImGui::Checkbox("Clustered lighting", &rs.enableClusteredLighting);
         ImGui::Checkbox("Frustum culling", &rs.enableFrustumCulling);
+        ImGui::BeginDisabled(!rs.enableFrustumCulling);
+        ImGui::Checkbox("Occlusion culling (CPU)", &rs.enableOcclusionCulling);
+        ImGui::EndDisabled();
         ImGui::Checkbox("Debug print draw calls", &rs.debugPrintDrawCalls);
+        ImGui::Checkbox("Optimize command lists", &rs.optimizeCommandLists);
 
         DrawSSAOSection(rs);
         DrawFogSection(rs);
@@ -0,0 +1,205 @@
+module;
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+export module core:instance_stream;
+
+export namespace rendern
+{
+	// Rows [first, first + count) of a persistent GPU buffer.
+	struct InstanceRange
+	{
+		std::uint32_t first{ 0 };
+		std::uint32_t count{ 0 };
+	};
+
+	struct InstanceSlotCacheStats
+	{
+		std::uint32_t slots{ 0 };
+		std::uint32_t rebuilt{ 0 };  // Get() calls this frame whose key changed (or slot was new)
+		std::uint32_t reused{ 0 };   // Get() calls this frame answered from the slot
+	};
+
+	// One persistent slot per object index (draw item, skinned item, ...). A slot keeps the key it was
+	// built from and the derived value; Get() rebuilds the value only when the key compares unequal, so
+	// static objects pay one comparison per frame instead of re-deriving their instance data.
+	// Keys are compared with operator==; an object that moved to a different index simply rebuilds.
+	template <typename Key, typename Value>
+	class InstanceSlotCache
+	{
+	public:
+		// Call once per frame with the current object count; slots past it are dropped.
+		void BeginFrame(std::size_t slotCount)
+		{
+			slots_.resize(slotCount);
+			stats_ = InstanceSlotCacheStats{};
+			stats_.slots = static_cast<std::uint32_t>(slotCount);
+		}
+
+		template <typename Build>
+		const Value& Get(std::size_t slot, const Key& key, Build&& build)
+		{
+			if (slot >= slots_.size())
+			{
+				slots_.resize(slot + 1);
+				stats_.slots = static_cast<std::uint32_t>(slots_.size());
+			}
+
+			Slot& entry = slots_[slot];
+			if (entry.valid && entry.key == key)
+			{
+				++stats_.reused;
+				return entry.value;
+			}
+
+			entry.key = key;
+			entry.value = build();
+			entry.valid = true;
+			++stats_.rebuilt;
+			return entry.value;
+		}
+
+		void Invalidate() noexcept
+		{
+			for (Slot& entry : slots_)
+			{
+				entry.valid = false;
+			}
+		}
+
+		const InstanceSlotCacheStats& GetStats() const noexcept
+		{
+			return stats_;
+		}
+
+	private:
+		struct Slot
+		{
+			Key key{};
+			Value value{};
+			bool valid{ false };
+		};
+
+		std::vector<Slot> slots_;
+		InstanceSlotCacheStats stats_{};
+	};
+
+	struct PersistentInstanceStreamDesc
+	{
+		// Clean rows between two dirty runs that are re-uploaded anyway to save a copy command.
+		std::uint32_t mergeGapRows{ 4 };
+		// More dirty ranges than this collapse into one range spanning all of them.
+		std::uint32_t maxRanges{ 64 };
+	};
+
+	struct InstanceStreamStats
+	{
+		std::uint32_t rows{ 0 };           // rows written this frame
+		std::uint32_t dirtyRows{ 0 };      // rows that differ from what the GPU buffer holds
+		std::uint32_t ranges{ 0 };         // upload ranges returned by Commit()
+		std::size_t uploadedBytes{ 0 };    // bytes covered by those ranges (dirty rows + merged gaps)
+		std::size_t skippedBytes{ 0 };     // bytes a full re-upload would have sent on top of that
+	};
+
+	// CPU mirror of a GPU instance buffer that persists across frames. Each frame the caller writes the
+	// complete packing into the span from BeginFrame(); Commit() compares it row by row with what was
+	// uploaded before and returns only the ranges that changed. The buffer must be one whose contents
+	// survive between frames (updates ordered with GPU reads, e.g. a default-heap buffer fed by copies);
+	// call Invalidate() whenever it is (re)created so the next Commit() uploads everything.
+	template <typename Row>
+	class PersistentInstanceStream
+	{
+		static_assert(std::is_trivially_copyable_v<Row>, "PersistentInstanceStream compares rows bytewise");
+
+	public:
+		explicit PersistentInstanceStream(PersistentInstanceStreamDesc desc = {})
+			: desc_(desc)
+		{
+		}
+
+		// Storage for this frame's `count` rows; every row must be written before Commit().
+		std::span<Row> BeginFrame(std::size_t count)
+		{
+			pending_.resize(count);
+			return pending_;
+		}
+
+		std::span<const InstanceRange> Commit()
+		{
+			ranges_.clear();
+			stats_ = InstanceStreamStats{};
+			stats_.rows = static_cast<std::uint32_t>(pending_.size());
+
+			const std::size_t count = pending_.size();
+			const std::size_t comparable = valid_ ? std::min(count, uploaded_.size()) : 0;
+			for (std::size_t row = 0; row < count; ++row)
+			{
+				if (row < comparable && std::memcmp(&pending_[row], &uploaded_[row], sizeof(Row)) == 0)
+				{
+					continue;
+				}
+
+				++stats_.dirtyRows;
+				const std::uint32_t index = static_cast<std::uint32_t>(row);
+				if (!ranges_.empty() && index - (ranges_.back().first + ranges_.back().count) <= desc_.mergeGapRows)
+				{
+					ranges_.back().count = index + 1 - ranges_.back().first;
+				}
+				else
+				{
+					ranges_.push_back(InstanceRange{ index, 1 });
+				}
+			}
+
+			if (ranges_.size() > std::max<std::uint32_t>(1, desc_.maxRanges))
+			{
+				const std::uint32_t first = ranges_.front().first;
+				const std::uint32_t end = ranges_.back().first + ranges_.back().count;
+				ranges_.assign(1, InstanceRange{ first, end - first });
+			}
+
+			std::size_t uploadedRows = 0;
+			for (const InstanceRange& range : ranges_)
+			{
+				uploadedRows += range.count;
+			}
+			stats_.ranges = static_cast<std::uint32_t>(ranges_.size());
+			stats_.uploadedBytes = uploadedRows * sizeof(Row);
+			stats_.skippedBytes = (count - uploadedRows) * sizeof(Row);
+
+			uploaded_.swap(pending_);
+			valid_ = true;
+			return ranges_;
+		}
+
+		// What the GPU buffer holds once the ranges from the last Commit() are uploaded.
+		std::span<const Row> Rows() const noexcept
+		{
+			return uploaded_;
+		}
+
+		void Invalidate() noexcept
+		{
+			valid_ = false;
+		}
+
+		const InstanceStreamStats& GetStats() const noexcept
+		{
+			return stats_;
+		}
+
+	private:
+		PersistentInstanceStreamDesc desc_{};
+		std::vector<Row> uploaded_;
+		std::vector<Row> pending_;
+		std::vector<InstanceRange> ranges_;
+		InstanceStreamStats stats_{};
+		bool valid_{ false };
+	};
+}
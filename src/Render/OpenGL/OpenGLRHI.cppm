@@ -6,6 +6,7 @@ module;
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <span>
@@ -138,14 +139,19 @@ namespace rhi
 		{
 			InvalidateVaoCache();
 
-			for (auto& [_, fence] : fences_)
-			{
-				if (fence.sync)
+			fences_.ForEach([](rhi::FenceHandle, GLFence& fence)
 				{
-					glDeleteSync(fence.sync);
-				}
+					if (fence.sync)
+					{
+						glDeleteSync(fence.sync);
+					}
+				});
+			fences_.Clear();
+
+			for (const PendingTimelineValue& pending : timelinePending_)
+			{
+				glDeleteSync(pending.sync);
 			}
-			fences_.clear();
 		}
 
 		Backend GetBackend() const noexcept override
@@ -167,21 +173,37 @@ namespace rhi
 		GLDeviceDesc desc_{};
 		std::string name_;
 
-		// Buffer targets: buffer id -> GL target
-		std::unordered_map<GLuint, GLenum> bufferTargets_{};
-		// Input layouts (1-based handle id -> vector[id-1])
-		std::vector<GLInputLayout> inputLayouts_{};
+		// Buffer targets indexed by GL buffer name (GL names are small and reused; 0 = unknown)
+		std::vector<GLenum> bufferTargets_{};
+		// Input layouts
+		HandlePool<InputLayoutTag, GLInputLayout> inputLayouts_{};
 
 		// Descriptor indices (0 invalid)
 		std::vector<TextureHandle> textureDescriptions_{ TextureHandle{} };
 		std::vector<TextureDescIndex> freeTextureDescIndices_;
+		std::vector<bool> textureDescFreed_;
 
 		// Fence storage
-		std::uint32_t nextFenceId_{ 0 };
-		std::unordered_map<std::uint32_t, GLFence> fences_{};
+		HandlePool<FenceTag, GLFence> fences_{};
 
-		// Current program + uniform location cache per program
-		std::unordered_map<GLuint, std::unordered_map<std::string, GLint>> uniformLocationCache_{};
+		// Timeline values signaled but not yet seen complete, oldest first
+		struct PendingTimelineValue
+		{
+			std::uint64_t value{ 0 };
+			GLsync sync{ nullptr };
+		};
+		std::deque<PendingTimelineValue> timelinePending_{};
+		std::uint64_t timelineSignaled_{ 0 };
+		std::uint64_t timelineCompleted_{ 0 };
+
+		// Current program + uniform id -> location table per program (sorted by id, built on first bind)
+		struct UniformLocation
+		{
+			rhi::UniformId id{};
+			GLint location{ -1 };
+		};
+		std::unordered_map<GLuint, std::vector<UniformLocation>> programUniforms_{};
+		const std::vector<UniformLocation>* currentUniforms_{ nullptr };
 		GLuint currentProgram_{ 0 };
 
 		GLenum currentTopology_{ GL_TRIANGLES };
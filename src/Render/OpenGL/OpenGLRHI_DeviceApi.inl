@@ -152,6 +152,10 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			glGenBuffers(1, &bufferId);
 
 			const GLenum target = BufferTargetFor(desc.bindFlag);
+			if (bufferId >= bufferTargets_.size())
+			{
+				bufferTargets_.resize(static_cast<std::size_t>(bufferId) + 1u, 0);
+			}
 			bufferTargets_[bufferId] = target;
 
 			glBindBuffer(target, bufferId);
@@ -182,7 +186,10 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			if (bufferId != 0)
 			{
 				glDeleteBuffers(1, &bufferId);
-				bufferTargets_.erase(bufferId);
+				if (bufferId < bufferTargets_.size())
+				{
+					bufferTargets_[bufferId] = 0;
+				}
 			}
 			InvalidateVaoCache();
 		}
@@ -217,28 +224,18 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				glLayout.attribs.push_back(out);
 			}
 
-			const std::uint32_t layoutId = static_cast<std::uint32_t>(inputLayouts_.size()) + 1u;
-			inputLayouts_.push_back(std::move(glLayout));
+			const rhi::InputLayoutHandle layout = inputLayouts_.Insert(std::move(glLayout));
 
 			InvalidateVaoCache();
-			return rhi::InputLayoutHandle{ layoutId };
+			return layout;
 		}
 
 		void DestroyInputLayout(InputLayoutHandle layout) noexcept override
 		{
-			const std::uint32_t layoutId = layout.id;
-			if (layoutId == 0)
+			if (inputLayouts_.Erase(layout))
 			{
-				return;
+				InvalidateVaoCache();
 			}
-
-			const std::size_t idx = static_cast<std::size_t>(layoutId - 1);
-			if (idx < inputLayouts_.size())
-			{
-				inputLayouts_[idx] = GLInputLayout{};
-			}
-
-			InvalidateVaoCache();
 		}
 
 		// ---------------- Shaders / Pipeline ----------------
@@ -298,6 +295,12 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			GLuint programId = static_cast<GLuint>(pso.id);
 			if (programId != 0)
 			{
+				if (currentProgram_ == programId)
+				{
+					currentProgram_ = 0;
+					currentUniforms_ = nullptr;
+				}
+				programUniforms_.erase(programId);
 				glDeleteProgram(programId);
 			}
 		}
@@ -305,9 +308,9 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 		// ---------------- Command submission ----------------
 		void SubmitCommandList(CommandList&& commandList) override
 		{
-			for (const auto& command : commandList.commands)
+			for (const CommandRecord& command : commandList)
 			{
-				std::visit([this](auto&& cmd) { ExecuteOnce(cmd); }, command);
+				VisitCommand(command, [this](auto&& cmd) { ExecuteOnce(cmd); });
 			}
 		}
 
@@ -318,6 +321,7 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			{
 				const TextureDescIndex index = freeTextureDescIndices_.back();
 				freeTextureDescIndices_.pop_back();
+				textureDescFreed_[index] = false;
 				textureDescriptions_[index] = texture;
 				return index;
 
@@ -349,17 +353,34 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				return;
 			}
 			const size_t vecIndex = static_cast<size_t>(index);
-			if (vecIndex < textureDescriptions_.size())
+			// Freeing a slot twice would put it on the free list twice and hand it to two owners.
+			if (vecIndex < textureDescriptions_.size() && !(vecIndex < textureDescFreed_.size() && textureDescFreed_[vecIndex]))
 			{
 				textureDescriptions_[vecIndex] = TextureHandle{};
 				freeTextureDescIndices_.push_back(index);
+				textureDescFreed_.resize(std::max(textureDescFreed_.size(), vecIndex + 1), false);
+				textureDescFreed_[vecIndex] = true;
+			}
+		}
+
+		TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+		{
+			const TextureDescIndex first = static_cast<TextureDescIndex>(textureDescriptions_.size());
+			textureDescriptions_.resize(textureDescriptions_.size() + count);
+			return first;
+		}
+
+		void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+		{
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				FreeTextureDescriptor(first + i);
 			}
 		}
 
 		// ---------------- Fences ----------------
 		FenceHandle CreateFence(bool signaled = false) override
 		{
-			const std::uint32_t fenceId = ++nextFenceId_;
 			GLFence fence;
 			fence.signaled = signaled;
 
@@ -369,25 +390,18 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 				glFlush();
 			}
 
-			fences_[fenceId] = fence;
-			return FenceHandle{ fenceId };
+			return fences_.Insert(fence);
 		}
 
 		void DestroyFence(FenceHandle fence) noexcept override
 		{
-			const std::uint32_t fenceId = fence.id;
-			if (fenceId == 0)
-			{
-				return;
-			}
-
-			if (auto it = fences_.find(fenceId); it != fences_.end())
+			if (GLFence* ptrFence = GetFence(fence))
 			{
-				if (it->second.sync)
+				if (ptrFence->sync)
 				{
-					glDeleteSync(it->second.sync);
+					glDeleteSync(ptrFence->sync);
 				}
-				fences_.erase(it);
+				fences_.Erase(fence);
 			}
 		}
 
@@ -431,6 +445,10 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			while (true)
 			{
 				const GLenum res = glClientWaitSync(ptrFence->sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+				if (res == GL_WAIT_FAILED)
+				{
+					throw std::runtime_error("OpenGL: WaitFence: glClientWaitSync failed");
+				}
 				if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED)
 				{
 					break;
@@ -470,3 +488,48 @@ void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
 			}
 			return false;
 		}
+
+		// ---------------- Timeline ----------------
+		// One GL sync object per pending value; values complete in submission order.
+		std::uint64_t SignalTimeline() override
+		{
+			const std::uint64_t value = ++timelineSignaled_;
+			timelinePending_.push_back(PendingTimelineValue{ value, glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0) });
+			glFlush();
+			return value;
+		}
+
+		std::uint64_t GetCompletedTimelineValue() override
+		{
+			while (!timelinePending_.empty())
+			{
+				const GLenum res = glClientWaitSync(timelinePending_.front().sync, 0, 0);
+				if (res == GL_WAIT_FAILED)
+				{
+					throw std::runtime_error("OpenGL: GetCompletedTimelineValue: glClientWaitSync failed");
+				}
+				if (res != GL_ALREADY_SIGNALED && res != GL_CONDITION_SATISFIED)
+				{
+					break;
+				}
+				PopCompletedTimelineValue();
+			}
+			return timelineCompleted_;
+		}
+
+		void WaitTimelineValue(std::uint64_t value) override
+		{
+			while (timelineCompleted_ < value && !timelinePending_.empty())
+			{
+				const GLenum res = glClientWaitSync(timelinePending_.front().sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+				if (res == GL_WAIT_FAILED)
+				{
+					// A failed wait never succeeds on retry (lost context or bad sync); do not spin on it.
+					throw std::runtime_error("OpenGL: WaitTimelineValue: glClientWaitSync failed");
+				}
+				if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED)
+				{
+					PopCompletedTimelineValue();
+				}
+			}
+		}
@@ -1,24 +1,15 @@
 		GLenum BufferTargetForId(GLuint bufferId) const
 		{
-			if (auto it = bufferTargets_.find(bufferId); it != bufferTargets_.end())
+			if (bufferId < bufferTargets_.size() && bufferTargets_[bufferId] != 0)
 			{
-				return it->second;
+				return bufferTargets_[bufferId];
 			}
 			return GL_ARRAY_BUFFER;
 		}
 
 		const GLInputLayout* GetLayout(rhi::InputLayoutHandle handle) const
 		{
-			const std::size_t idx = static_cast<std::size_t>(handle.id - 1);
-			if (handle.id == 0 || idx >= inputLayouts_.size())
-			{
-				return nullptr;
-			}
-			if (inputLayouts_[idx].strideBytes == 0 && inputLayouts_[idx].attribs.empty())
-			{
-				return nullptr;
-			}
-			return &inputLayouts_[idx];
+			return inputLayouts_.Find(handle);
 		}
 
 		TextureHandle ResolveTextureDesc(TextureDescIndex index)
@@ -33,15 +24,14 @@
 
 		GLFence* GetFence(rhi::FenceHandle handle)
 		{
-			if (handle.id == 0)
-			{
-				return nullptr;
-			}
-			if (auto it = fences_.find(handle.id); it != fences_.end())
-			{
-				return &it->second;
-			}
-			return nullptr;
+			return fences_.Find(handle);
+		}
+
+		void PopCompletedTimelineValue() noexcept
+		{
+			timelineCompleted_ = timelinePending_.front().value;
+			glDeleteSync(timelinePending_.front().sync);
+			timelinePending_.pop_front();
 		}
 
 		void InvalidateVaoCache()
@@ -205,57 +195,90 @@
 			}
 		}
 
-		GLint GetUniformLocationCached(const std::string& name)
+		// Enumerates the program's active uniforms once and keys their locations by UniformId, so setting a
+		// uniform is a binary search over a handful of entries instead of glGetUniformLocation per call.
+		// Arrays are reachable both as "name" and "name[i]".
+		const std::vector<UniformLocation>& UniformTableFor(GLuint programId)
 		{
-			if (currentProgram_ == 0)
+			auto [it, inserted] = programUniforms_.try_emplace(programId);
+			if (!inserted)
 			{
-				return -1;
+				return it->second;
 			}
 
-			auto& uCache = uniformLocationCache_[currentProgram_];
-			if (auto it = uCache.find(name); it != uCache.end())
-			{
-				return it->second;
+			std::vector<UniformLocation>& table = it->second;
+			auto Add = [&table](std::string_view name, GLint location)
+				{
+					if (location != -1)
+					{
+						table.push_back(UniformLocation{ rhi::UniformId::FromName(name), location });
+					}
+				};
+
+			GLint activeCount = 0;
+			GLint maxNameLength = 0;
+			glGetProgramiv(programId, GL_ACTIVE_UNIFORMS, &activeCount);
+			glGetProgramiv(programId, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+			std::string name(static_cast<std::size_t>(std::max(maxNameLength, 1)), '\0');
+			for (GLint index = 0; index < activeCount; ++index)
+			{
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(programId, static_cast<GLuint>(index), static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+				const std::string_view activeName(name.data(), static_cast<std::size_t>(length));
+				const GLint location = glGetUniformLocation(programId, name.c_str());
+				Add(activeName, location);
+
+				// Uniform-block members report no location and are skipped by Add().
+				if (activeName.ends_with("[0]") && location != -1)
+				{
+					const std::string base(activeName.substr(0, activeName.size() - 3));
+					Add(base, location);
+					for (GLint element = 1; element < size; ++element)
+					{
+						const std::string elementName = base + "[" + std::to_string(element) + "]";
+						Add(elementName, glGetUniformLocation(programId, elementName.c_str()));
+					}
+				}
 			}
 
-			GLint loc = glGetUniformLocation(currentProgram_, name.c_str());
-			uCache.emplace(name, loc);
-			return loc;
+			std::sort(table.begin(), table.end(), [](const UniformLocation& a, const UniformLocation& b) { return a.id < b.id; });
+			return table;
 		}
 
-		void SetUniformIntImpl(const std::string& name, int value)
+		GLint FindUniformLocation(rhi::UniformId id) const noexcept
 		{
-			if (currentProgram_ == 0)
+			if (currentUniforms_ == nullptr)
 			{
-				return;
+				return -1;
 			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const auto it = std::lower_bound(currentUniforms_->begin(), currentUniforms_->end(), id,
+				[](const UniformLocation& entry, rhi::UniformId key) { return entry.id < key; });
+			return (it != currentUniforms_->end() && it->id == id) ? it->location : -1;
+		}
+
+		void SetUniformIntImpl(rhi::UniformId id, int value)
+		{
+			const GLint location = FindUniformLocation(id);
 			if (location != -1)
 			{
 				glUniform1i(location, value);
 			}
 		}
 
-		void SetUniformFloat4Impl(const std::string& name, const std::array<float, 4>& value)
+		void SetUniformFloat4Impl(rhi::UniformId id, const std::array<float, 4>& value)
 		{
-			if (currentProgram_ == 0)
-			{
-				return;
-			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const GLint location = FindUniformLocation(id);
 			if (location != -1)
 			{
 				glUniform4f(location, value[0], value[1], value[2], value[3]);
 			}
 		}
 
-		void SetUniformMat4Impl(const std::string& name, const std::array<float, 16>& value)
+		void SetUniformMat4Impl(rhi::UniformId id, const std::array<float, 16>& value)
 		{
-			if (currentProgram_ == 0)
-			{
-				return;
-			}
-			GLint location = glGetUniformLocation(currentProgram_, name.c_str());
+			const GLint location = FindUniformLocation(id);
 			if (location != -1)
 			{
 				glUniformMatrix4fv(location, 1, GL_FALSE, value.data());
@@ -323,6 +346,7 @@
 			{
 				glUseProgram(programId);
 				currentProgram_ = programId;
+				currentUniforms_ = programId != 0 ? &UniformTableFor(programId) : nullptr;
 			}
 		}
 
@@ -375,17 +399,17 @@
 
 		void ExecuteOnce(const CommandSetUniformInt& cmd)
 		{
-			SetUniformIntImpl(cmd.name, cmd.value);
+			SetUniformIntImpl(cmd.id, cmd.value);
 		}
 
 		void ExecuteOnce(const CommandUniformFloat4& cmd)
 		{
-			SetUniformFloat4Impl(cmd.name, cmd.value);
+			SetUniformFloat4Impl(cmd.id, cmd.value);
 		}
 
 		void ExecuteOnce(const CommandUniformMat4& cmd)
 		{
-			SetUniformMat4Impl(cmd.name, cmd.value);
+			SetUniformMat4Impl(cmd.id, cmd.value);
 		}
 
 		void ExecuteOnce(const CommandSetConstants& /*cmd*/)
@@ -426,6 +450,35 @@
 			}
 		}
 
+		void ExecuteOnce(const CommandDrawIndexedIndirect& cmd)
+		{
+			if (!GLEW_VERSION_4_3 && !GLEW_ARB_multi_draw_indirect)
+			{
+				throw std::runtime_error("OpenGLRHI: MultiDrawIndexedIndirect requires GL 4.3 or ARB_multi_draw_indirect.");
+			}
+			// GL reads firstIndex relative to the start of the element buffer; there is no per-draw base offset.
+			if (indexBuffer_.offsetBytes != 0)
+			{
+				throw std::runtime_error("OpenGLRHI: indirect draws require the index buffer to be bound at offset 0.");
+			}
+
+			const GLuint vao = GetOrCreateVAO(true);
+			if (boundVao_ != vao)
+			{
+				glBindVertexArray(vao);
+				boundVao_ = vao;
+			}
+
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, static_cast<GLuint>(cmd.argsBuffer.id));
+			glMultiDrawElementsIndirect(
+				currentTopology_,
+				ToGLIndexType(cmd.indexType),
+				reinterpret_cast<const void*>(static_cast<std::uintptr_t>(cmd.argsOffsetBytes)),
+				static_cast<GLsizei>(cmd.drawCount),
+				static_cast<GLsizei>(cmd.strideBytes));
+			glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+		}
+
 		void ExecuteOnce(const CommandDraw& cmd)
 		{
 			const GLuint vao = GetOrCreateVAO(false);
@@ -465,3 +518,8 @@
 		{
 			// DX12-only command. Other backends intentionally ignore it.
 		}
+
+		void ExecuteOnce(const CommandTransitionTextures& /*cmd*/)
+		{
+			// GL orders render-to-texture and sampling implicitly; nothing to do.
+		}
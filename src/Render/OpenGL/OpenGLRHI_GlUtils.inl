@@ -210,6 +210,8 @@ namespace
 			return GL_UNIFORM_BUFFER;
 		case rhi::BufferBindFlag::StructuredBuffer:
 			return GL_SHADER_STORAGE_BUFFER;
+		case rhi::BufferBindFlag::IndirectArgs:
+			return GL_DRAW_INDIRECT_BUFFER;
 		default:
 			return GL_ARRAY_BUFFER;
 		}
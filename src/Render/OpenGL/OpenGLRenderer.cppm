@@ -45,7 +45,9 @@ export namespace rendern
 
 		void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene)
 		{
-			renderGraph::RenderGraph graph;
+			renderGraph::RenderGraph& graph = renderGraph_;
+			graph.Reset();
+			graph.SetOptimizeCommandLists(settings_.optimizeCommandLists);
 
 			rhi::ClearDesc clearDesc{};
 			clearDesc.clearColor = true;
@@ -265,6 +267,7 @@ export namespace rendern
 		{
 			DestroyMesh(device_, skyboxMesh_);
 			DestroyMesh(device_, mesh_);
+			renderGraph_.ReleaseTransientResources(device_);
 			psoCache_.ClearCache();
 			shaderLibrary_.ClearCache();
 		}
@@ -408,6 +411,7 @@ export namespace rendern
 
 		ShaderLibrary shaderLibrary_;
 		PSOCache psoCache_;
+		renderGraph::RenderGraph renderGraph_;
 
 		MeshRHI mesh_{}; // fallback-only
 		rhi::PipelineHandle psoNoTex_{};
@@ -6,11 +6,18 @@ module;
 #include <string>
 #include <memory>
 #include <array>
-#include <variant>
+#include <string_view>
+#include <iterator>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
 #include <span>
-#include <unordered_map>
 #include <cstring>
 #include <stdexcept>
+#include <unordered_map>
+#include <deque>
 
 export module core:rhi;
 
@@ -20,7 +27,8 @@ export namespace rhi
 	{
 		Null,
 		OpenGL,
-		DirectX12
+		DirectX12,
+		Software
 	};
 
 	template <typename Tag>
@@ -48,6 +56,219 @@ export namespace rhi
 	using FenceHandle = Handle<FenceTag>;
 	using InputLayoutHandle = Handle<InputLayoutTag>;
 
+	// Uniform name as a 64-bit FNV-1a hash. String literals convert at compile time, so recording a
+	// uniform stores 8 bytes and never touches the name; backends map ids to locations once per program.
+	// Names that only exist at runtime go through FromName().
+	struct UniformId
+	{
+		std::uint64_t value{ 0 };
+
+		constexpr UniformId() noexcept = default;
+
+		template <std::size_t N>
+		consteval UniformId(const char (&name)[N]) noexcept
+			: value(Hash(std::string_view(name, N - 1)))
+		{
+		}
+
+		static constexpr UniformId FromName(std::string_view name) noexcept
+		{
+			UniformId id;
+			id.value = Hash(name);
+			return id;
+		}
+
+		static constexpr std::uint64_t Hash(std::string_view name) noexcept
+		{
+			std::uint64_t hash = 14695981039346656037ull;
+			for (const char c : name)
+			{
+				hash ^= static_cast<std::uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		explicit operator bool() const noexcept { return value != 0; }
+		friend bool operator==(const UniformId&, const UniformId&) noexcept = default;
+		friend auto operator<=>(const UniformId&, const UniformId&) noexcept = default;
+	};
+
+	// Slot map backing device objects. A pooled handle id packs the slot index (low bits) and the
+	// slot generation (high bits, never 0, so id 0 stays invalid). Destroying an object bumps the
+	// generation, so stale handles miss in Find() instead of aliasing whatever reuses the slot.
+	// A slot whose generation would wrap is retired instead of reused, and Clear() keeps generations,
+	// so no handle is ever handed out twice.
+	// Slots live in fixed-size pages: lookup is two array indexings, and references to objects stay
+	// valid while other objects are added.
+	template <typename Tag, typename T>
+	class HandlePool
+	{
+	public:
+		using HandleType = Handle<Tag>;
+
+		static constexpr std::uint32_t kIndexBits = 20;
+		static constexpr std::uint32_t kIndexMask = (1u << kIndexBits) - 1u;
+		static constexpr std::uint32_t kGenerationMask = (1u << (32u - kIndexBits)) - 1u;
+		static constexpr std::uint32_t kMaxSlots = kIndexMask + 1u;
+
+		static constexpr std::uint32_t IndexOf(HandleType handle) noexcept { return handle.id & kIndexMask; }
+		static constexpr std::uint32_t GenerationOf(HandleType handle) noexcept { return handle.id >> kIndexBits; }
+
+		template <typename... Args>
+		HandleType Emplace(Args&&... args)
+		{
+			std::uint32_t index = 0;
+			if (!freeSlots_.empty())
+			{
+				index = freeSlots_.back();
+				freeSlots_.pop_back();
+			}
+			else
+			{
+				if (slotCount_ == kMaxSlots)
+				{
+					throw std::runtime_error("HandlePool: out of slots");
+				}
+				if ((slotCount_ & kPageMask) == 0)
+				{
+					pages_.push_back(std::make_unique<Slot[]>(kPageSize));
+				}
+				index = slotCount_++;
+			}
+
+			Slot& slot = SlotAt(index);
+			slot.value.emplace(std::forward<Args>(args)...);
+			++size_;
+			return HandleType{ (slot.generation << kIndexBits) | index };
+		}
+
+		HandleType Insert(T value)
+		{
+			return Emplace(std::move(value));
+		}
+
+		// nullptr for null, destroyed or foreign handles.
+		T* Find(HandleType handle) noexcept
+		{
+			Slot* slot = Resolve(handle);
+			return slot ? &*slot->value : nullptr;
+		}
+		const T* Find(HandleType handle) const noexcept
+		{
+			return const_cast<HandlePool*>(this)->Find(handle);
+		}
+
+		bool Contains(HandleType handle) const noexcept
+		{
+			return Find(handle) != nullptr;
+		}
+
+		// Destroys the object and retires the handle. Returns false for stale handles.
+		bool Erase(HandleType handle) noexcept
+		{
+			Slot* slot = Resolve(handle);
+			if (!slot)
+			{
+				return false;
+			}
+
+			slot->value.reset();
+			Recycle(*slot, IndexOf(handle));
+			--size_;
+			return true;
+		}
+
+		// Destroys every object. Slots are recycled like in Erase(), so handles from before the
+		// Clear() stay stale; the pages are kept for reuse.
+		void Clear() noexcept
+		{
+			freeSlots_.clear();
+			for (std::uint32_t index = slotCount_; index-- > 0;)
+			{
+				Slot& slot = SlotAt(index);
+				if (slot.value)
+				{
+					slot.value.reset();
+					Recycle(slot, index);
+				}
+				else if (slot.generation != kRetiredGeneration)
+				{
+					freeSlots_.push_back(index);
+				}
+			}
+			size_ = 0;
+		}
+
+		std::size_t Size() const noexcept { return size_; }
+		// Slots whose generation ran out; they are never handed out again.
+		std::uint32_t RetiredSlots() const noexcept { return retiredSlots_; }
+		bool Empty() const noexcept { return size_ == 0; }
+
+		// Calls `fn(HandleType, T&)` for every live object in slot order.
+		template <typename Fn>
+		void ForEach(Fn&& fn)
+		{
+			for (std::uint32_t index = 0; index < slotCount_; ++index)
+			{
+				Slot& slot = SlotAt(index);
+				if (slot.value)
+				{
+					fn(HandleType{ (slot.generation << kIndexBits) | index }, *slot.value);
+				}
+			}
+		}
+
+	private:
+		static constexpr std::uint32_t kPageBits = 8;
+		static constexpr std::uint32_t kPageSize = 1u << kPageBits;
+		static constexpr std::uint32_t kPageMask = kPageSize - 1u;
+
+		// Generation 0 never appears in a handle, so it marks retired slots.
+		static constexpr std::uint32_t kRetiredGeneration = 0;
+
+		struct Slot
+		{
+			std::optional<T> value{};
+			std::uint32_t generation{ 1 };
+		};
+
+		// `slot` was just emptied: bump its generation and make it reusable, or retire it for good.
+		void Recycle(Slot& slot, std::uint32_t index)
+		{
+			if (slot.generation == kGenerationMask)
+			{
+				slot.generation = kRetiredGeneration;
+				++retiredSlots_;
+				return;
+			}
+			++slot.generation;
+			freeSlots_.push_back(index);
+		}
+
+		Slot& SlotAt(std::uint32_t index) noexcept
+		{
+			return pages_[index >> kPageBits][index & kPageMask];
+		}
+
+		Slot* Resolve(HandleType handle) noexcept
+		{
+			const std::uint32_t index = IndexOf(handle);
+			if (!handle || index >= slotCount_)
+			{
+				return nullptr;
+			}
+			Slot& slot = SlotAt(index);
+			return (slot.value && slot.generation == GenerationOf(handle)) ? &slot : nullptr;
+		}
+
+		std::vector<std::unique_ptr<Slot[]>> pages_{};
+		std::vector<std::uint32_t> freeSlots_{};
+		std::uint32_t slotCount_{ 0 };
+		std::uint32_t retiredSlots_{ 0 };
+		std::size_t size_{ 0 };
+	};
+
 	enum class Format : std::uint8_t
 	{
 		Unknown,
@@ -83,7 +304,8 @@ export namespace rhi
 		IndexBuffer,
 		ConstantBuffer,
 		UniformBuffer,
-		StructuredBuffer
+		StructuredBuffer,
+		IndirectArgs      // DrawIndexedIndirectArgs records read by DrawIndexedIndirect / MultiDrawIndexedIndirect
 	};
 
 	enum class BufferUsageFlag : std::uint8_t
@@ -209,6 +431,8 @@ export namespace rhi
 		StencilOp depthFailOp{ StencilOp::Keep };
 		StencilOp passOp{ StencilOp::Keep };
 		CompareOp compareOp{ CompareOp::Always };
+
+		friend bool operator==(const StencilFaceState&, const StencilFaceState&) noexcept = default;
 	};
 
 	struct StencilState
@@ -218,6 +442,8 @@ export namespace rhi
 		std::uint8_t writeMask{ 0xFF };
 		StencilFaceState front{};
 		StencilFaceState back{};
+
+		friend bool operator==(const StencilState&, const StencilState&) noexcept = default;
 	};
 
 	struct DepthState
@@ -226,12 +452,16 @@ export namespace rhi
 		bool writeEnable{ true };
 		CompareOp depthCompareOp{ CompareOp::LessEqual };
 		StencilState stencil{};
+
+		friend bool operator==(const DepthState&, const DepthState&) noexcept = default;
 	};
 
 	struct RasterizerState
 	{
 		CullMode cullMode{ CullMode::Back };
 		FrontFace frontFace{ FrontFace::CounterClockwise };
+
+		friend bool operator==(const RasterizerState&, const RasterizerState&) noexcept = default;
 	};
 
 	enum class BlendMode : std::uint8_t
@@ -244,6 +474,8 @@ export namespace rhi
 	{
 		bool enable{ false };
 		BlendMode mode{ BlendMode::Alpha };
+
+		friend bool operator==(const BlendState&, const BlendState&) noexcept = default;
 	};
 
 	struct GraphicsState
@@ -251,6 +483,8 @@ export namespace rhi
 		DepthState depth{};
 		RasterizerState rasterizer{};
 		BlendState blend{};
+
+		friend bool operator==(const GraphicsState&, const GraphicsState&) noexcept = default;
 	};
 
 	struct ClearDesc
@@ -283,16 +517,74 @@ export namespace rhi
 	};
 
 	//------------------------ Command Stream ------------------------/
+	//
+	// Commands are recorded into a linear byte arena as tightly packed, variable-size records:
+	//   [CommandHeader][padding up to alignof(payload)][payload][optional tail bytes]
+	// Every payload is trivially copyable, so the arena can grow with memcpy and be reset
+	// each frame without touching the heap again once it reached its steady-state capacity.
+	// Backends replay a list with `for (const CommandRecord& record : commandList)` + VisitCommand().
+
+	enum class CommandType : std::uint8_t
+	{
+		BeginPass,
+		EndPass,
+		SetViewport,
+		SetState,
+		SetStencilRef,
+		SetPrimitiveTopology,
+		BindPipeline,
+		BindInputLayout,
+		BindVertexBuffer,
+		BindIndexBuffer,
+		BindTexture2D,
+		BindTextureCube,
+		BindTextureDesc,
+		BindStructuredBufferSRV,
+		SetUniformInt,
+		SetUniformFloat4,
+		SetUniformMat4,
+		SetConstants,
+		DX12ImGuiRender,
+		DrawIndexed,
+		Draw,
+		BindTexture2DArray,
+		TransitionTextures,
+		DrawIndexedIndirect,
+
+		Count
+	};
+
+	// Coarse resource states the render graph plans transitions between.
+	// Unknown means "whatever state the backend tracked last"; backends treat it as a wildcard source.
+	enum class ResourceState : std::uint8_t
+	{
+		Unknown,
+		RenderTarget,
+		DepthWrite,
+		ShaderRead
+	};
+
+	struct TextureBarrier
+	{
+		TextureHandle texture{};
+		ResourceState before{ ResourceState::Unknown };
+		ResourceState after{ ResourceState::Unknown };
+
+		friend bool operator==(const TextureBarrier&, const TextureBarrier&) noexcept = default;
+	};
 
 	struct CommandBeginPass
 	{
+		static constexpr CommandType kType = CommandType::BeginPass;
 		BeginPassDesc desc{};
 	};
 	struct CommandEndPass
 	{
+		static constexpr CommandType kType = CommandType::EndPass;
 	};
 	struct CommandSetViewport
 	{
+		static constexpr CommandType kType = CommandType::SetViewport;
 		int x{ 0 };
 		int y{ 0 };
 		int width{ 0 };
@@ -300,26 +592,32 @@ export namespace rhi
 	};
 	struct CommandSetState
 	{
+		static constexpr CommandType kType = CommandType::SetState;
 		GraphicsState state{};
 	};
 	struct CommandSetStencilRef
 	{
+		static constexpr CommandType kType = CommandType::SetStencilRef;
 		std::uint32_t ref{ 0 };
 	};
 	struct CommandSetPrimitiveTopology
 	{
+		static constexpr CommandType kType = CommandType::SetPrimitiveTopology;
 		PrimitiveTopology topology{ PrimitiveTopology::TriangleList };
 	};
 	struct CommandBindPipeline
 	{
+		static constexpr CommandType kType = CommandType::BindPipeline;
 		PipelineHandle pso{};
 	};
 	struct CommandBindInputLayout
 	{
+		static constexpr CommandType kType = CommandType::BindInputLayout;
 		InputLayoutHandle layout{};
 	};
 	struct CommandBindVertexBuffer
 	{
+		static constexpr CommandType kType = CommandType::BindVertexBuffer;
 		std::uint32_t slot{ 0 };
 		BufferHandle buffer{};
 		std::uint32_t strideBytes{ 0 };
@@ -327,65 +625,77 @@ export namespace rhi
 	};
 	struct CommandBindIndexBuffer
 	{
+		static constexpr CommandType kType = CommandType::BindIndexBuffer;
 		BufferHandle buffer{};
 		IndexType indexType{ IndexType::UINT16 };
 		std::uint32_t offsetBytes{ 0 };
 	};
 	struct CommnadBindTexture2D
 	{
+		static constexpr CommandType kType = CommandType::BindTexture2D;
 		std::uint32_t slot{ 0 };
 		TextureHandle texture{};
 	};
 	struct CommandBindTextureCube
 	{
+		static constexpr CommandType kType = CommandType::BindTextureCube;
 		std::uint32_t slot{ 0 };
 		TextureHandle texture{};
 	};
 	struct CommandTextureDesc
 	{
+		static constexpr CommandType kType = CommandType::BindTextureDesc;
 		std::uint32_t slot{ 0 };
 		TextureDescIndex texture{};
 	};
 	struct CommandBindStructuredBufferSRV
 	{
+		static constexpr CommandType kType = CommandType::BindStructuredBufferSRV;
 		std::uint32_t slot{ 0 };
 		BufferHandle buffer{};
 	};
 
+	// Uniforms addressed by hashed name; see UniformId.
 	struct CommandSetUniformInt
 	{
-		std::string name{};
+		static constexpr CommandType kType = CommandType::SetUniformInt;
+		UniformId id{};
 		int value{ 0 };
 	};
 	struct CommandUniformFloat4
 	{
-		std::string name{};
+		static constexpr CommandType kType = CommandType::SetUniformFloat4;
+		UniformId id{};
 		std::array<float, 4> value{};
 	};
 	struct CommandUniformMat4
 	{
-		std::string name{};
+		static constexpr CommandType kType = CommandType::SetUniformMat4;
+		UniformId id{};
 		std::array<float, 16> value{};
 	};
 
 	// Backend-agnostic small constant block ("push constants" style).
 	// DX12 uses it to feed a per-draw constant buffer without interpreting names.
 	// OpenGL can ignore it or emulate it later via UBOs.
+	// `data` is a view into the command arena (only `size` bytes are stored, not the full 512).
 	struct CommandSetConstants
 	{
 		std::uint32_t slot{ 0 };   // backend-defined slot (DX12 root parameter index)
 		std::uint32_t size{ 0 };   // bytes used in `data`
-		std::array<std::byte, 512> data{};
+		std::span<const std::byte> data{};
 	};
 
 	// DX12-only: render Dear ImGui draw data into the current render target.
 	// Other backends may ignore this command.
 	struct CommandDX12ImGuiRender
 	{
+		static constexpr CommandType kType = CommandType::DX12ImGuiRender;
 		const void* drawData{ nullptr }; // ImDrawData*
 	};
 	struct CommandDrawIndexed
 	{
+		static constexpr CommandType kType = CommandType::DrawIndexed;
 		std::uint32_t indexCount{ 0 };
 		IndexType indexType{ IndexType::UINT16 };
 		std::uint32_t firstIndex{ 0 };
@@ -395,123 +705,366 @@ export namespace rhi
 	};
 	struct CommandDraw
 	{
+		static constexpr CommandType kType = CommandType::Draw;
 		std::uint32_t vertexCount{ 0 };
 		std::uint32_t firstVertex{ 0 };
 		uint32_t instanceCount{ 1 };
 		uint32_t firstInstance{ 0 };
 	};
 
+	// One indexed draw as the GPU reads it from an IndirectArgs buffer. The layout matches both
+	// D3D12_DRAW_INDEXED_ARGUMENTS and GL's DrawElementsIndirectCommand, so buffers are uploaded as is.
+	// firstIndex is relative to the bound index buffer offset.
+	struct DrawIndexedIndirectArgs
+	{
+		std::uint32_t indexCount{ 0 };
+		std::uint32_t instanceCount{ 1 };
+		std::uint32_t firstIndex{ 0 };
+		std::int32_t baseVertex{ 0 };
+		std::uint32_t firstInstance{ 0 };
+	};
+	static_assert(sizeof(DrawIndexedIndirectArgs) == 20, "DrawIndexedIndirectArgs must match the native indirect layouts");
+
+	// `drawCount` records of `strideBytes` each, starting at `argsOffsetBytes` of `argsBuffer`.
+	struct CommandDrawIndexedIndirect
+	{
+		static constexpr CommandType kType = CommandType::DrawIndexedIndirect;
+		BufferHandle argsBuffer{};
+		std::uint32_t argsOffsetBytes{ 0 };
+		std::uint32_t drawCount{ 1 };
+		std::uint32_t strideBytes{ sizeof(DrawIndexedIndirectArgs) };
+		IndexType indexType{ IndexType::UINT16 };
+	};
+
 	struct CommandBindTexture2DArray
 	{
+		static constexpr CommandType kType = CommandType::BindTexture2DArray;
 		std::uint32_t slot{ 0 };
 		TextureHandle texture{};
 	};
 
-	using Command = std::variant <
-		CommandBeginPass,
-		CommandEndPass,
-		CommandSetViewport,
-		CommandSetState,
-		CommandSetStencilRef,
-		CommandSetPrimitiveTopology,
-		CommandBindPipeline,
-		CommandBindInputLayout,
-		CommandBindVertexBuffer,
-		CommandBindIndexBuffer,
-		CommnadBindTexture2D,
-		CommandBindTextureCube,
-		CommandTextureDesc,
-		CommandBindStructuredBufferSRV,
-		CommandSetUniformInt,
-		CommandUniformFloat4,
-		CommandUniformMat4,
-		CommandSetConstants,
-		CommandDX12ImGuiRender,
-		CommandDrawIndexed,
-		CommandDraw,
-		CommandBindTexture2DArray > ;
-
-	struct CommandList
-	{
-		std::vector<Command> commands;
+	// One batch of texture transitions, recorded outside passes by the render graph.
+	// `barriers` is a view into the command arena.
+	struct CommandTransitionTextures
+	{
+		std::span<const TextureBarrier> barriers{};
+	};
+
+	namespace detail
+	{
+		// Fixed-size parts of the variable-length commands as they are laid out in the arena.
+		// The trailing bytes (constant payload, barriers) follow the struct directly.
+		struct SetConstantsRecord
+		{
+			static constexpr CommandType kType = CommandType::SetConstants;
+			std::uint32_t slot{ 0 };
+			std::uint32_t size{ 0 };
+		};
+		struct TransitionTexturesRecord
+		{
+			static constexpr CommandType kType = CommandType::TransitionTextures;
+			std::uint32_t count{ 0 };
+		};
+
+		constexpr std::size_t AlignUp(std::size_t value, std::size_t alignment) noexcept
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+	}
+
+	struct CommandHeader
+	{
+		CommandType type{ CommandType::Count };
+		std::uint8_t payloadOffset{ 0 }; // bytes from the start of the record to the payload
+		std::uint16_t sizeBytes{ 0 };    // total record size, including header, padding and tail
+	};
+
+	// 8 keeps every payload aligned when whole lists are appended with one memcpy (CommandList::Append).
+	inline constexpr std::size_t kCommandRecordAlignment = 8;
+	inline constexpr std::size_t kMaxCommandRecordBytes = 0xFFFFu;
+
+	// Growable byte arena. Reset() keeps the capacity so steady-state frames never allocate.
+	class CommandArena
+	{
+	public:
+		CommandArena() = default;
+
+		CommandArena(const CommandArena& other)
+		{
+			Reserve(other.size_);
+			if (other.size_ != 0)
+			{
+				std::memcpy(storage_.get(), other.storage_.get(), other.size_);
+			}
+			size_ = other.size_;
+		}
+
+		CommandArena& operator=(const CommandArena& other)
+		{
+			if (this != &other)
+			{
+				size_ = 0;
+				Reserve(other.size_);
+				if (other.size_ != 0)
+				{
+					std::memcpy(storage_.get(), other.storage_.get(), other.size_);
+				}
+				size_ = other.size_;
+			}
+			return *this;
+		}
+
+		CommandArena(CommandArena&& other) noexcept
+			: storage_(std::move(other.storage_))
+			, size_(std::exchange(other.size_, 0))
+			, capacity_(std::exchange(other.capacity_, 0))
+		{
+		}
+
+		CommandArena& operator=(CommandArena&& other) noexcept
+		{
+			storage_ = std::move(other.storage_);
+			size_ = std::exchange(other.size_, 0);
+			capacity_ = std::exchange(other.capacity_, 0);
+			return *this;
+		}
+
+		std::byte* Allocate(std::size_t bytes)
+		{
+			if (size_ + bytes > capacity_)
+			{
+				Reserve(std::max(size_ + bytes, std::max<std::size_t>(capacity_ * 2, kInitialCapacityBytes)));
+			}
+			std::byte* ptr = storage_.get() + size_;
+			size_ += bytes;
+			return ptr;
+		}
+
+		void Reserve(std::size_t capacityBytes)
+		{
+			if (capacityBytes <= capacity_)
+			{
+				return;
+			}
+			auto grown = std::make_unique_for_overwrite<std::byte[]>(capacityBytes);
+			if (size_ != 0)
+			{
+				std::memcpy(grown.get(), storage_.get(), size_);
+			}
+			storage_ = std::move(grown);
+			capacity_ = capacityBytes;
+		}
+
+		void Reset() noexcept
+		{
+			size_ = 0;
+		}
+
+		const std::byte* Data() const noexcept { return storage_.get(); }
+		std::size_t Size() const noexcept { return size_; }
+		std::size_t Capacity() const noexcept { return capacity_; }
+
+	private:
+		static constexpr std::size_t kInitialCapacityBytes = 16u * 1024u;
+
+		std::unique_ptr<std::byte[]> storage_{};
+		std::size_t size_{ 0 };
+		std::size_t capacity_{ 0 };
+	};
+
+	// Read-only view of one record inside a CommandList.
+	class CommandRecord
+	{
+	public:
+		explicit CommandRecord(const std::byte* record) noexcept : record_(record) {}
+
+		CommandType Type() const noexcept { return Header().type; }
+		std::size_t SizeBytes() const noexcept { return Header().sizeBytes; }
+		std::span<const std::byte> Bytes() const noexcept { return { record_, SizeBytes() }; }
+
+		template <typename T>
+		const T& Payload() const noexcept
+		{
+			return *std::launder(reinterpret_cast<const T*>(record_ + Header().payloadOffset));
+		}
+
+		// Bytes stored right after the fixed-size payload `T`.
+		template <typename T>
+		const std::byte* Tail() const noexcept
+		{
+			return record_ + Header().payloadOffset + sizeof(T);
+		}
+
+	private:
+		const CommandHeader& Header() const noexcept
+		{
+			return *std::launder(reinterpret_cast<const CommandHeader*>(record_));
+		}
+
+		const std::byte* record_{ nullptr };
+	};
+
+	class CommandIterator
+	{
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = CommandRecord;
+		using difference_type = std::ptrdiff_t;
+		using pointer = void;
+		using reference = CommandRecord;
+
+		CommandIterator() = default;
+		explicit CommandIterator(const std::byte* cursor) noexcept : cursor_(cursor) {}
+
+		CommandRecord operator*() const noexcept { return CommandRecord(cursor_); }
+
+		CommandIterator& operator++() noexcept
+		{
+			cursor_ += CommandRecord(cursor_).SizeBytes();
+			return *this;
+		}
+		CommandIterator operator++(int) noexcept
+		{
+			CommandIterator prev = *this;
+			++(*this);
+			return prev;
+		}
+
+		friend bool operator==(const CommandIterator&, const CommandIterator&) noexcept = default;
+
+	private:
+		const std::byte* cursor_{ nullptr };
+	};
+
+	// Decodes a record and calls `visitor(const CommandX&)` with the matching command type.
+	template <typename Visitor>
+	void VisitCommand(const CommandRecord& record, Visitor&& visitor)
+	{
+		switch (record.Type())
+		{
+		case CommandType::BeginPass: visitor(record.Payload<CommandBeginPass>()); break;
+		case CommandType::EndPass: visitor(record.Payload<CommandEndPass>()); break;
+		case CommandType::SetViewport: visitor(record.Payload<CommandSetViewport>()); break;
+		case CommandType::SetState: visitor(record.Payload<CommandSetState>()); break;
+		case CommandType::SetStencilRef: visitor(record.Payload<CommandSetStencilRef>()); break;
+		case CommandType::SetPrimitiveTopology: visitor(record.Payload<CommandSetPrimitiveTopology>()); break;
+		case CommandType::BindPipeline: visitor(record.Payload<CommandBindPipeline>()); break;
+		case CommandType::BindInputLayout: visitor(record.Payload<CommandBindInputLayout>()); break;
+		case CommandType::BindVertexBuffer: visitor(record.Payload<CommandBindVertexBuffer>()); break;
+		case CommandType::BindIndexBuffer: visitor(record.Payload<CommandBindIndexBuffer>()); break;
+		case CommandType::BindTexture2D: visitor(record.Payload<CommnadBindTexture2D>()); break;
+		case CommandType::BindTextureCube: visitor(record.Payload<CommandBindTextureCube>()); break;
+		case CommandType::BindTextureDesc: visitor(record.Payload<CommandTextureDesc>()); break;
+		case CommandType::BindStructuredBufferSRV: visitor(record.Payload<CommandBindStructuredBufferSRV>()); break;
+		case CommandType::SetUniformInt: visitor(record.Payload<CommandSetUniformInt>()); break;
+		case CommandType::SetUniformFloat4: visitor(record.Payload<CommandUniformFloat4>()); break;
+		case CommandType::SetUniformMat4: visitor(record.Payload<CommandUniformMat4>()); break;
+		case CommandType::SetConstants:
+		{
+			const auto& rec = record.Payload<detail::SetConstantsRecord>();
+			const CommandSetConstants cmd{
+				rec.slot,
+				rec.size,
+				std::span<const std::byte>(record.Tail<detail::SetConstantsRecord>(), rec.size) };
+			visitor(cmd);
+			break;
+		}
+		case CommandType::DX12ImGuiRender: visitor(record.Payload<CommandDX12ImGuiRender>()); break;
+		case CommandType::DrawIndexed: visitor(record.Payload<CommandDrawIndexed>()); break;
+		case CommandType::Draw: visitor(record.Payload<CommandDraw>()); break;
+		case CommandType::DrawIndexedIndirect: visitor(record.Payload<CommandDrawIndexedIndirect>()); break;
+		case CommandType::BindTexture2DArray: visitor(record.Payload<CommandBindTexture2DArray>()); break;
+		case CommandType::TransitionTextures:
+		{
+			const auto& rec = record.Payload<detail::TransitionTexturesRecord>();
+			const CommandTransitionTextures cmd{
+				std::span<const TextureBarrier>(
+					std::launder(reinterpret_cast<const TextureBarrier*>(record.Tail<detail::TransitionTexturesRecord>())), rec.count) };
+			visitor(cmd);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	class CommandList
+	{
+	public:
+		static constexpr std::size_t kMaxConstantsBytes = 512;
 
 		void BeginPass(const BeginPassDesc& desc)
 		{
-			commands.emplace_back(CommandBeginPass{ desc });
+			Emit(CommandBeginPass{ desc });
 		}
 		void EndPass()
 		{
-			commands.emplace_back(CommandEndPass{});
+			Emit(CommandEndPass{});
 		}
 		void SetViewport(int x, int y, int width, int height)
 		{
-			commands.emplace_back(CommandSetViewport{ x, y, width, height });
+			Emit(CommandSetViewport{ x, y, width, height });
 		}
 		void SetState(const GraphicsState& state)
 		{
-			commands.emplace_back(CommandSetState{ state });
+			Emit(CommandSetState{ state });
 		}
 		void SetStencilRef(std::uint32_t ref)
 		{
-			commands.emplace_back(CommandSetStencilRef{ ref });
+			Emit(CommandSetStencilRef{ ref });
 		}
 		void SetPrimitiveTopology(PrimitiveTopology topology)
 		{
-			commands.emplace_back(CommandSetPrimitiveTopology{ topology });
+			Emit(CommandSetPrimitiveTopology{ topology });
 		}
 		void BindPipeline(PipelineHandle pso)
 		{
-			commands.emplace_back(CommandBindPipeline{ pso });
+			Emit(CommandBindPipeline{ pso });
 		}
 		void BindInputLayout(InputLayoutHandle layout)
 		{
-			commands.emplace_back(CommandBindInputLayout{ layout });
+			Emit(CommandBindInputLayout{ layout });
 		}
 		void BindVertexBuffer(std::uint32_t slot, BufferHandle buffer, std::uint32_t strideBytes = 0, std::uint32_t offsetBytes = 0)
 		{
-			commands.emplace_back(CommandBindVertexBuffer{ slot, buffer, strideBytes, offsetBytes });
+			Emit(CommandBindVertexBuffer{ slot, buffer, strideBytes, offsetBytes });
 		}
 		void BindIndexBuffer(BufferHandle buffer, IndexType indexType, std::uint32_t offsetBytes = 0)
 		{
-			commands.emplace_back(CommandBindIndexBuffer{ buffer, indexType, offsetBytes });
+			Emit(CommandBindIndexBuffer{ buffer, indexType, offsetBytes });
 		}
 		void BindTexture2D(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommnadBindTexture2D{ slot, texture });
+			Emit(CommnadBindTexture2D{ slot, texture });
 		}
 		void BindTextureCube(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommandBindTextureCube{ slot, texture });
+			Emit(CommandBindTextureCube{ slot, texture });
 		}
 		void BindTextureDesc(std::uint32_t slot, TextureDescIndex textureIndex)
 		{
-			commands.emplace_back(CommandTextureDesc{ slot, textureIndex });
+			Emit(CommandTextureDesc{ slot, textureIndex });
 		}
-		void SetUniformInt(std::string name, int value)
+		void SetUniformInt(UniformId id, int value)
 		{
-			commands.emplace_back(CommandSetUniformInt{ std::move(name), value });
+			Emit(CommandSetUniformInt{ id, value });
 		}
-		void SetUniformFloat4(std::string name, std::array<float, 4> value)
+		void SetUniformFloat4(UniformId id, std::array<float, 4> value)
 		{
-			commands.emplace_back(CommandUniformFloat4{ std::string(name), value });
+			Emit(CommandUniformFloat4{ id, value });
 		}
-		void SetUniformMat4(std::string_view name, const std::array<float, 16>& v)
+		void SetUniformMat4(UniformId id, const std::array<float, 16>& v)
 		{
-			commands.emplace_back(CommandUniformMat4{ std::string(name), v });
+			Emit(CommandUniformMat4{ id, v });
 		}
 		void SetConstants(std::uint32_t slot, std::span<const std::byte> bytes)
 		{
-			if (bytes.size() > 512)
+			if (bytes.size() > kMaxConstantsBytes)
 			{
 				throw std::runtime_error("CommandList::SetConstants: payload too large (max 512 bytes)");
 			}
 
-			CommandSetConstants cmd{};
-			cmd.slot = slot;
-			cmd.size = static_cast<std::uint32_t>(bytes.size());
-			if (!bytes.empty())
-				std::memcpy(cmd.data.data(), bytes.data(), bytes.size());
-			commands.emplace_back(std::move(cmd));
+			Emit(detail::SetConstantsRecord{ slot, static_cast<std::uint32_t>(bytes.size()) }, bytes);
 		}
 		void DrawIndexed(
 			std::uint32_t indexCount,
@@ -521,7 +1074,7 @@ export namespace rhi
 			uint32_t instanceCount = 1,
 			uint32_t firstInstance = 0)
 		{
-			commands.emplace_back(CommandDrawIndexed{ indexCount, indexType, firstIndex, baseVertex, instanceCount, firstInstance });
+			Emit(CommandDrawIndexed{ indexCount, indexType, firstIndex, baseVertex, instanceCount, firstInstance });
 		}
 		void Draw(
 			std::uint32_t vertexCount,
@@ -529,62 +1082,999 @@ export namespace rhi
 			uint32_t instanceCount = 1,
 			uint32_t firstInstance = 0)
 		{
-			commands.emplace_back(CommandDraw{ vertexCount, firstVertex, instanceCount, firstInstance });
+			Emit(CommandDraw{ vertexCount, firstVertex, instanceCount, firstInstance });
+		}
+		// Draw arguments are read by the GPU from `argsBuffer` (BufferBindFlag::IndirectArgs) at submit time.
+		void DrawIndexedIndirect(IndexType indexType, BufferHandle argsBuffer, std::uint32_t argsOffsetBytes = 0)
+		{
+			MultiDrawIndexedIndirect(indexType, argsBuffer, 1, argsOffsetBytes);
+		}
+		// `drawCount` consecutive argument records sharing every binding; a zero count is dropped.
+		void MultiDrawIndexedIndirect(
+			IndexType indexType,
+			BufferHandle argsBuffer,
+			std::uint32_t drawCount,
+			std::uint32_t argsOffsetBytes = 0,
+			std::uint32_t strideBytes = sizeof(DrawIndexedIndirectArgs))
+		{
+			if (drawCount == 0)
+			{
+				return;
+			}
+			Emit(CommandDrawIndexedIndirect{ argsBuffer, argsOffsetBytes, drawCount, strideBytes, indexType });
 		}
 		void BindStructuredBufferSRV(std::uint32_t slot, BufferHandle buffer)
 		{
-			commands.emplace_back(CommandBindStructuredBufferSRV{ slot, buffer });
+			Emit(CommandBindStructuredBufferSRV{ slot, buffer });
 		}
 		void DX12ImGuiRender(const void* drawData)
 		{
-			commands.emplace_back(CommandDX12ImGuiRender{ drawData });
+			Emit(CommandDX12ImGuiRender{ drawData });
 		}
 		void BindTexture2DArray(std::uint32_t slot, TextureHandle texture)
 		{
-			commands.emplace_back(CommandBindTexture2DArray{ slot, texture });
+			Emit(CommandBindTexture2DArray{ slot, texture });
+		}
+		// Must be recorded outside BeginPass/EndPass. Empty batches are dropped.
+		void TransitionTextures(std::span<const TextureBarrier> barriers)
+		{
+			if (barriers.empty())
+			{
+				return;
+			}
+			Emit(detail::TransitionTexturesRecord{ static_cast<std::uint32_t>(barriers.size()) }, std::as_bytes(barriers));
 		}
-	};
 
-	// ------------------------ RHI interfaces ------------------------ //
+		// Appends every record of `other`; used to stitch lists recorded on different threads.
+		void Append(const CommandList& other)
+		{
+			if (other.arena_.Size() == 0)
+			{
+				return;
+			}
+			std::byte* dst = arena_.Allocate(other.arena_.Size());
+			std::memcpy(dst, other.arena_.Data(), other.arena_.Size());
+			commandCount_ += other.commandCount_;
+		}
 
-	class IRHISwapChain
-	{
-	public:
-		virtual ~IRHISwapChain() = default;
-		virtual SwapChainDesc GetDesc() const = 0;
-		virtual FrameBufferHandle GetCurrentBackBuffer() const = 0;
-		virtual TextureHandle GetDepthTexture() const = 0;
-		virtual void Present() = 0;
-		virtual void Resize(Extent2D newExtent) = 0;
-	};
+		// Copies one record verbatim (e.g. from another list while filtering it).
+		void AppendRecord(const CommandRecord& record)
+		{
+			const std::span<const std::byte> bytes = record.Bytes();
+			std::memcpy(arena_.Allocate(bytes.size()), bytes.data(), bytes.size());
+			++commandCount_;
+		}
 
-	class IRHIDevice
-	{
-	public:
-		virtual ~IRHIDevice() = default;
+		// Drops all recorded commands but keeps the arena capacity for the next frame.
+		void Reset() noexcept
+		{
+			arena_.Reset();
+			commandCount_ = 0;
+		}
 
-		virtual Backend GetBackend() const noexcept = 0;
+		void Reserve(std::size_t bytes)
+		{
+			arena_.Reserve(bytes);
+		}
 
-		virtual std::string_view GetName() const = 0;
+		bool Empty() const noexcept { return commandCount_ == 0; }
+		std::size_t Size() const noexcept { return commandCount_; }
+		std::size_t SizeBytes() const noexcept { return arena_.Size(); }
+		std::size_t CapacityBytes() const noexcept { return arena_.Capacity(); }
 
-		// Optional UI hooks (Dear ImGui). Default is no-op.
-		virtual void InitImGui([[maybe_unused]] void* hwnd, [[maybe_unused]] int framesInFlight, [[maybe_unused]] Format rtvFormat) {}
-		virtual void ImGuiNewFrame() {}
-		virtual void ShutdownImGui() {}
-		virtual void WaitIdle() {}
+		// Raw record bytes (e.g. for capture files). They stay decodable when copied to any 8-byte aligned base.
+		std::span<const std::byte> Bytes() const noexcept { return { arena_.Data(), arena_.Size() }; }
 
-		// Textures
-		virtual TextureHandle CreateTexture2D(Extent2D extendt, Format format) = 0;
-		virtual TextureHandle CreateTextureCube(Extent2D extent, Format format) = 0;
-		virtual void DestroyTexture(TextureHandle texture) noexcept = 0;
+		CommandIterator begin() const noexcept { return CommandIterator(arena_.Data()); }
+		CommandIterator end() const noexcept { return CommandIterator(arena_.Data() + arena_.Size()); }
 
-		// Framebuffers
-		virtual FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) = 0;
-		// Multiple render targets (MRT). 0 colors means depth-only pass.
-		// Default implementation falls back to the single-color CreateFramebuffer() and will throw for colors.size() > 1.
-		virtual FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth)
+	private:
+		template <typename T>
+		void Emit(const T& payload, std::span<const std::byte> tail = {})
 		{
-			if (colors.empty())
+			static_assert(std::is_trivially_copyable_v<T>, "command payloads must be trivially copyable");
+
+			const std::size_t recordStart = arena_.Size();
+			const std::size_t payloadOffset = detail::AlignUp(recordStart + sizeof(CommandHeader), alignof(T)) - recordStart;
+			const std::size_t recordSize = detail::AlignUp(payloadOffset + sizeof(T) + tail.size(), kCommandRecordAlignment);
+			if (recordSize > kMaxCommandRecordBytes)
+			{
+				throw std::runtime_error("CommandList: command record too large");
+			}
+
+			std::byte* record = arena_.Allocate(recordSize);
+			::new (static_cast<void*>(record)) CommandHeader{ T::kType, static_cast<std::uint8_t>(payloadOffset), static_cast<std::uint16_t>(recordSize) };
+			::new (static_cast<void*>(record + payloadOffset)) T(payload);
+
+			if (!tail.empty())
+			{
+				std::memcpy(record + payloadOffset + sizeof(T), tail.data(), tail.size());
+			}
+			++commandCount_;
+		}
+
+		CommandArena arena_{};
+		std::size_t commandCount_{ 0 };
+	};
+
+	struct CommandListOptimizeStats
+	{
+		std::size_t inputCommands{ 0 };
+		std::size_t outputCommands{ 0 };
+		std::size_t redundantState{ 0 };      // SetState / SetStencilRef / SetPrimitiveTopology / SetViewport
+		std::size_t redundantBindings{ 0 };   // pipeline, input layout, vertex/index buffers, texture and SRV slots
+		std::size_t redundantConstants{ 0 };  // SetConstants equal to the block that is already set
+		std::size_t mergedConstants{ 0 };     // SetConstants overwritten before any draw read them
+
+		std::size_t RemovedCommands() const noexcept { return inputCommands - outputCommands; }
+	};
+
+	namespace detail
+	{
+		// Mirror of what the backends latch between draws. Everything starts (and is reset to) "unknown",
+		// so the first command after a reset is always kept.
+		class RedundantCommandFilter
+		{
+		public:
+			RedundantCommandFilter(CommandList& output, CommandListOptimizeStats& stats) noexcept
+				: output_(output)
+				, stats_(stats)
+			{
+			}
+
+			void Process(const CommandRecord& record)
+			{
+				bool keep = true;
+				VisitCommand(record, [&]<typename T>(const T& cmd)
+					{
+						keep = Filter(record, cmd);
+					});
+				if (keep)
+				{
+					output_.AppendRecord(record);
+				}
+			}
+
+			void Finish()
+			{
+				FlushConstants();
+			}
+
+		private:
+			static constexpr std::size_t kTrackedVertexBufferSlots = 8;
+			static constexpr std::size_t kTrackedShaderSlots = 32;
+
+			struct SlotBinding
+			{
+				CommandType kind{ CommandType::Count }; // Count = unknown
+				std::uint32_t id{ 0 };
+
+				friend bool operator==(const SlotBinding&, const SlotBinding&) noexcept = default;
+			};
+
+			template <typename V>
+			static bool Latch(std::optional<V>& bound, const V& value) noexcept
+			{
+				if (bound && *bound == value)
+				{
+					return false;
+				}
+				bound = value;
+				return true;
+			}
+
+			bool Redundant(std::size_t& counter) noexcept
+			{
+				++counter;
+				return false;
+			}
+
+			bool Filter(const CommandRecord&, const CommandSetState& cmd)
+			{
+				return Latch(state_, cmd.state) || Redundant(stats_.redundantState);
+			}
+			bool Filter(const CommandRecord&, const CommandSetStencilRef& cmd)
+			{
+				return Latch(stencilRef_, cmd.ref) || Redundant(stats_.redundantState);
+			}
+			bool Filter(const CommandRecord&, const CommandSetPrimitiveTopology& cmd)
+			{
+				return Latch(topology_, cmd.topology) || Redundant(stats_.redundantState);
+			}
+			bool Filter(const CommandRecord&, const CommandSetViewport& cmd)
+			{
+				return Latch(viewport_, std::array<int, 4>{ cmd.x, cmd.y, cmd.width, cmd.height }) || Redundant(stats_.redundantState);
+			}
+			bool Filter(const CommandRecord&, const CommandBindPipeline& cmd)
+			{
+				return Latch(pipeline_, cmd.pso) || Redundant(stats_.redundantBindings);
+			}
+			bool Filter(const CommandRecord&, const CommandBindInputLayout& cmd)
+			{
+				return Latch(layout_, cmd.layout) || Redundant(stats_.redundantBindings);
+			}
+			bool Filter(const CommandRecord&, const CommandBindVertexBuffer& cmd)
+			{
+				if (cmd.slot >= kTrackedVertexBufferSlots)
+				{
+					return true;
+				}
+				const std::array<std::uint32_t, 3> binding{ cmd.buffer.id, cmd.strideBytes, cmd.offsetBytes };
+				return Latch(vertexBuffers_[cmd.slot], binding) || Redundant(stats_.redundantBindings);
+			}
+			bool Filter(const CommandRecord&, const CommandBindIndexBuffer& cmd)
+			{
+				const std::array<std::uint32_t, 3> binding{ cmd.buffer.id, static_cast<std::uint32_t>(cmd.indexType), cmd.offsetBytes };
+				return Latch(indexBuffer_, binding) || Redundant(stats_.redundantBindings);
+			}
+			// Textures and structured buffers share the backends' shader-resource slot tables.
+			bool Filter(const CommandRecord&, const CommnadBindTexture2D& cmd) { return BindSlot(cmd.kType, cmd.slot, cmd.texture.id); }
+			bool Filter(const CommandRecord&, const CommandBindTextureCube& cmd) { return BindSlot(cmd.kType, cmd.slot, cmd.texture.id); }
+			bool Filter(const CommandRecord&, const CommandBindTexture2DArray& cmd) { return BindSlot(cmd.kType, cmd.slot, cmd.texture.id); }
+			bool Filter(const CommandRecord&, const CommandTextureDesc& cmd) { return BindSlot(cmd.kType, cmd.slot, cmd.texture); }
+			bool Filter(const CommandRecord&, const CommandBindStructuredBufferSRV& cmd) { return BindSlot(cmd.kType, cmd.slot, cmd.buffer.id); }
+
+			bool Filter(const CommandRecord& record, const CommandSetConstants& cmd)
+			{
+				// Held back until something may read it, so a later block for the same slot can replace it.
+				if (pendingConstants_)
+				{
+					if (pendingConstantsSlot_ == cmd.slot)
+					{
+						++stats_.mergedConstants;
+					}
+					else
+					{
+						FlushConstants();
+					}
+				}
+				pendingConstants_ = record;
+				pendingConstantsSlot_ = cmd.slot;
+				return false;
+			}
+
+			bool Filter(const CommandRecord&, const CommandDrawIndexed&)
+			{
+				FlushConstants();
+				return true;
+			}
+			bool Filter(const CommandRecord&, const CommandDraw&)
+			{
+				FlushConstants();
+				return true;
+			}
+			bool Filter(const CommandRecord&, const CommandDrawIndexedIndirect&)
+			{
+				FlushConstants();
+				return true;
+			}
+
+			// Name-based uniforms are applied immediately to the bound program; their order is kept as is.
+			bool Filter(const CommandRecord&, const CommandSetUniformInt&) { return true; }
+			bool Filter(const CommandRecord&, const CommandUniformFloat4&) { return true; }
+			bool Filter(const CommandRecord&, const CommandUniformMat4&) { return true; }
+
+			// Pass boundaries, barriers and ImGui may change what the backend has bound (GL BeginPass sets the
+			// viewport, a texture rendered to needs its read transition again, ImGui rebinds everything).
+			template <typename T>
+			bool Filter(const CommandRecord&, const T&)
+			{
+				FlushConstants();
+				ForgetBindings();
+				return true;
+			}
+
+			bool BindSlot(CommandType kind, std::uint32_t slot, std::uint32_t id)
+			{
+				if (slot >= kTrackedShaderSlots)
+				{
+					return true;
+				}
+				const SlotBinding binding{ kind, id };
+				if (shaderSlots_[slot] == binding)
+				{
+					++stats_.redundantBindings;
+					return false;
+				}
+				shaderSlots_[slot] = binding;
+				return true;
+			}
+
+			void FlushConstants()
+			{
+				if (!pendingConstants_)
+				{
+					return;
+				}
+
+				const auto& rec = pendingConstants_->Payload<detail::SetConstantsRecord>();
+				const std::byte* bytes = pendingConstants_->Tail<detail::SetConstantsRecord>();
+				const bool same = constantsKnown_
+					&& constantsSlot_ == rec.slot
+					&& constantsSize_ == rec.size
+					&& std::memcmp(constants_.data(), bytes, rec.size) == 0;
+				if (same)
+				{
+					++stats_.redundantConstants;
+				}
+				else
+				{
+					output_.AppendRecord(*pendingConstants_);
+					constantsKnown_ = true;
+					constantsSlot_ = rec.slot;
+					constantsSize_ = rec.size;
+					std::memcpy(constants_.data(), bytes, rec.size);
+				}
+				pendingConstants_.reset();
+			}
+
+			void ForgetBindings() noexcept
+			{
+				state_.reset();
+				stencilRef_.reset();
+				topology_.reset();
+				viewport_.reset();
+				pipeline_.reset();
+				layout_.reset();
+				indexBuffer_.reset();
+				for (auto& vertexBuffer : vertexBuffers_)
+				{
+					vertexBuffer.reset();
+				}
+				shaderSlots_.fill(SlotBinding{});
+				constantsKnown_ = false;
+			}
+
+			CommandList& output_;
+			CommandListOptimizeStats& stats_;
+
+			std::optional<GraphicsState> state_;
+			std::optional<std::uint32_t> stencilRef_;
+			std::optional<PrimitiveTopology> topology_;
+			std::optional<std::array<int, 4>> viewport_;
+			std::optional<PipelineHandle> pipeline_;
+			std::optional<InputLayoutHandle> layout_;
+			std::array<std::optional<std::array<std::uint32_t, 3>>, kTrackedVertexBufferSlots> vertexBuffers_{};
+			std::optional<std::array<std::uint32_t, 3>> indexBuffer_;
+			std::array<SlotBinding, kTrackedShaderSlots> shaderSlots_{};
+
+			std::optional<CommandRecord> pendingConstants_;
+			std::uint32_t pendingConstantsSlot_{ 0 };
+			bool constantsKnown_{ false };
+			std::uint32_t constantsSlot_{ 0 };
+			std::uint32_t constantsSize_{ 0 };
+			std::array<std::byte, CommandList::kMaxConstantsBytes> constants_{};
+		};
+	}
+
+	// Backend-agnostic cleanup of a recorded list: re-binding what is already bound and SetConstants blocks
+	// that no draw observed are dropped, everything else is copied in order. `output` is reset first; pass a
+	// list that lives across frames so its arena is reused.
+	inline CommandListOptimizeStats OptimizeCommandList(const CommandList& input, CommandList& output)
+	{
+		output.Reset();
+		output.Reserve(input.SizeBytes());
+
+		CommandListOptimizeStats stats{};
+		stats.inputCommands = input.Size();
+		detail::RedundantCommandFilter filter(output, stats);
+		for (const CommandRecord record : input)
+		{
+			filter.Process(record);
+		}
+		filter.Finish();
+		stats.outputCommands = output.Size();
+		return stats;
+	}
+
+	//------------------------ Indirect draws ------------------------/
+	//
+	// IndirectDrawBuilder turns state-sorted batches into the argument records of an IndirectArgs buffer
+	// plus "runs": consecutive draws that share every binding and can be issued with one
+	// MultiDrawIndexedIndirect. IndirectDrawValidator is the CPU-side check the null and recording
+	// devices run on every submitted indirect draw.
+
+	struct IndirectDrawRun
+	{
+		std::uint64_t stateKey{ 0 };   // caller-defined: everything draws must share to go in one command
+		std::uint32_t firstDraw{ 0 };  // index into IndirectDrawBuilder::Args()
+		std::uint32_t drawCount{ 0 };
+	};
+
+	class IndirectDrawBuilder
+	{
+	public:
+		void Clear() noexcept
+		{
+			args_.clear();
+			runs_.clear();
+			mergedDraws_ = 0;
+		}
+
+		void Reserve(std::size_t draws)
+		{
+			args_.reserve(draws);
+		}
+
+		// Draws must arrive sorted by state (e.g. in DrawQueue order): a new run starts whenever `stateKey`
+		// changes. A draw of the same index range whose instances directly follow the previous draw's is
+		// folded into it as extra instances.
+		void Add(std::uint64_t stateKey, const DrawIndexedIndirectArgs& args)
+		{
+			if (args.indexCount == 0 || args.instanceCount == 0)
+			{
+				return;
+			}
+
+			if (!runs_.empty() && runs_.back().stateKey == stateKey)
+			{
+				DrawIndexedIndirectArgs& previous = args_.back();
+				if (previous.indexCount == args.indexCount
+					&& previous.firstIndex == args.firstIndex
+					&& previous.baseVertex == args.baseVertex
+					&& previous.firstInstance + previous.instanceCount == args.firstInstance)
+				{
+					previous.instanceCount += args.instanceCount;
+					++mergedDraws_;
+					return;
+				}
+				++runs_.back().drawCount;
+			}
+			else
+			{
+				runs_.push_back(IndirectDrawRun{ stateKey, static_cast<std::uint32_t>(args_.size()), 1 });
+			}
+			args_.push_back(args);
+		}
+
+		std::span<const DrawIndexedIndirectArgs> Args() const noexcept
+		{
+			return args_;
+		}
+
+		// What to upload into the IndirectArgs buffer.
+		std::span<const std::byte> Bytes() const noexcept
+		{
+			return std::as_bytes(std::span(args_));
+		}
+
+		std::span<const IndirectDrawRun> Runs() const noexcept
+		{
+			return runs_;
+		}
+
+		std::size_t MergedDraws() const noexcept
+		{
+			return mergedDraws_;
+		}
+
+		// Issues `run` from args uploaded at `argsBaseOffsetBytes` of `argsBuffer`; the caller binds the
+		// run's state first.
+		void RecordRun(CommandList& commandList, const IndirectDrawRun& run, IndexType indexType, BufferHandle argsBuffer, std::uint32_t argsBaseOffsetBytes = 0) const
+		{
+			commandList.MultiDrawIndexedIndirect(
+				indexType,
+				argsBuffer,
+				run.drawCount,
+				argsBaseOffsetBytes + run.firstDraw * static_cast<std::uint32_t>(sizeof(DrawIndexedIndirectArgs)));
+		}
+
+	private:
+		std::vector<DrawIndexedIndirectArgs> args_;
+		std::vector<IndirectDrawRun> runs_;
+		std::size_t mergedDraws_{ 0 };
+	};
+
+	struct IndirectDrawStats
+	{
+		std::uint64_t commands{ 0 };  // DrawIndexedIndirect / MultiDrawIndexedIndirect commands validated
+		std::uint64_t draws{ 0 };     // argument records they consume
+	};
+
+	// Mirrors buffer creation and updates (keeping the bytes of IndirectArgs buffers, which are small) and
+	// throws std::runtime_error for an indirect draw that would read outside its argument buffer, reads a
+	// buffer not created as IndirectArgs, or whose recorded index ranges overrun the bound index buffer.
+	class IndirectDrawValidator
+	{
+	public:
+		void OnCreateBuffer(BufferHandle buffer, const BufferDesc& desc)
+		{
+			TrackedBuffer& tracked = buffers_[buffer.id];
+			tracked.bindFlag = desc.bindFlag;
+			tracked.sizeInBytes = desc.sizeInBytes;
+			tracked.contents.assign(desc.bindFlag == BufferBindFlag::IndirectArgs ? desc.sizeInBytes : 0u, std::byte{ 0 });
+		}
+
+		void OnUpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes)
+		{
+			const auto it = buffers_.find(buffer.id);
+			if (it == buffers_.end() || it->second.bindFlag != BufferBindFlag::IndirectArgs)
+			{
+				return;
+			}
+			std::vector<std::byte>& contents = it->second.contents;
+			if (offsetBytes > contents.size() || data.size() > contents.size() - offsetBytes)
+			{
+				throw std::runtime_error("IndirectDrawValidator: update writes past the end of an IndirectArgs buffer");
+			}
+			std::memcpy(contents.data() + offsetBytes, data.data(), data.size());
+		}
+
+		void OnDestroyBuffer(BufferHandle buffer) noexcept
+		{
+			buffers_.erase(buffer.id);
+		}
+
+		void Validate(const CommandList& commandList)
+		{
+			CommandBindIndexBuffer indexBuffer{};
+			for (const CommandRecord& record : commandList)
+			{
+				VisitCommand(record, [&]<typename T>(const T& cmd)
+					{
+						if constexpr (std::is_same_v<T, CommandBindIndexBuffer>)
+						{
+							indexBuffer = cmd;
+						}
+						else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+						{
+							ValidateDraw(cmd, indexBuffer);
+						}
+					});
+			}
+		}
+
+		const IndirectDrawStats& GetStats() const noexcept
+		{
+			return stats_;
+		}
+
+	private:
+		struct TrackedBuffer
+		{
+			BufferBindFlag bindFlag{ BufferBindFlag::VertexBuffer };
+			std::size_t sizeInBytes{ 0 };
+			std::vector<std::byte> contents;
+		};
+
+		void ValidateDraw(const CommandDrawIndexedIndirect& cmd, const CommandBindIndexBuffer& indexBuffer)
+		{
+			if (cmd.drawCount == 0)
+			{
+				return;
+			}
+			const auto args = buffers_.find(cmd.argsBuffer.id);
+			if (args == buffers_.end())
+			{
+				throw std::runtime_error("IndirectDrawValidator: indirect draw reads an unknown or destroyed argument buffer");
+			}
+			if (args->second.bindFlag != BufferBindFlag::IndirectArgs)
+			{
+				throw std::runtime_error("IndirectDrawValidator: argument buffer was not created with BufferBindFlag::IndirectArgs");
+			}
+			if (cmd.argsOffsetBytes % 4 != 0 || cmd.strideBytes % 4 != 0 || cmd.strideBytes < sizeof(DrawIndexedIndirectArgs))
+			{
+				throw std::runtime_error("IndirectDrawValidator: argument offset and stride must be 4-byte aligned and stride >= sizeof(DrawIndexedIndirectArgs)");
+			}
+			const std::uint64_t end = static_cast<std::uint64_t>(cmd.argsOffsetBytes)
+				+ static_cast<std::uint64_t>(cmd.drawCount - 1) * cmd.strideBytes
+				+ sizeof(DrawIndexedIndirectArgs);
+			if (end > args->second.sizeInBytes)
+			{
+				throw std::runtime_error("IndirectDrawValidator: indirect draw reads past the end of its argument buffer");
+			}
+			if (!indexBuffer.buffer)
+			{
+				throw std::runtime_error("IndirectDrawValidator: indexed indirect draw without an index buffer bound");
+			}
+			if (indexBuffer.indexType != cmd.indexType)
+			{
+				throw std::runtime_error("IndirectDrawValidator: indirect draw index type differs from the bound index buffer");
+			}
+
+			const auto indices = buffers_.find(indexBuffer.buffer.id);
+			if (indices != buffers_.end())
+			{
+				const std::uint64_t indexSize = (cmd.indexType == IndexType::UINT16) ? 2u : 4u;
+				const std::uint64_t available = indices->second.sizeInBytes > indexBuffer.offsetBytes
+					? (indices->second.sizeInBytes - indexBuffer.offsetBytes) / indexSize
+					: 0u;
+				for (std::uint32_t draw = 0; draw < cmd.drawCount; ++draw)
+				{
+					DrawIndexedIndirectArgs record{};
+					std::memcpy(&record, args->second.contents.data() + cmd.argsOffsetBytes + static_cast<std::size_t>(draw) * cmd.strideBytes, sizeof(record));
+					if (record.indexCount != 0 && record.instanceCount != 0
+						&& static_cast<std::uint64_t>(record.firstIndex) + record.indexCount > available)
+					{
+						throw std::runtime_error("IndirectDrawValidator: indirect draw record reads past the end of the bound index buffer");
+					}
+				}
+			}
+
+			++stats_.commands;
+			stats_.draws += cmd.drawCount;
+		}
+
+		std::unordered_map<std::uint32_t, TrackedBuffer> buffers_;
+		IndirectDrawStats stats_{};
+	};
+
+	//------------------------ Pipeline Cache ------------------------/
+	//
+	// Content-addressed store for compiled backend pipelines (DX12 cached PSO blobs). Keys hash what
+	// defines the native object - shader bytecode, input layout, GraphicsState, topology, view-instance
+	// count and attachment formats - never handle ids, so a cache serialized by one run is valid for
+	// the next. Devices look a blob up before compiling and store what they compiled; the owner of the
+	// cache decides where Serialize()/Deserialize() bytes live.
+
+	// FNV-1a over the fields fed to it. Field-wise on purpose: hashing whole structs would hash padding.
+	class PipelineKeyHasher
+	{
+	public:
+		PipelineKeyHasher& AddBytes(std::span<const std::byte> bytes) noexcept
+		{
+			for (const std::byte b : bytes)
+			{
+				hash_ ^= static_cast<std::uint8_t>(b);
+				hash_ *= kPrime;
+			}
+			return *this;
+		}
+
+		PipelineKeyHasher& Add(std::uint64_t value) noexcept
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				hash_ ^= static_cast<std::uint8_t>((value >> (i * 8)) & 0xffu);
+				hash_ *= kPrime;
+			}
+			return *this;
+		}
+
+		PipelineKeyHasher& Add(std::string_view text) noexcept
+		{
+			Add(static_cast<std::uint64_t>(text.size()));
+			return AddBytes(std::as_bytes(std::span(text.data(), text.size())));
+		}
+
+		PipelineKeyHasher& Add(const StencilFaceState& face) noexcept
+		{
+			Add(static_cast<std::uint64_t>(face.failOp));
+			Add(static_cast<std::uint64_t>(face.depthFailOp));
+			Add(static_cast<std::uint64_t>(face.passOp));
+			return Add(static_cast<std::uint64_t>(face.compareOp));
+		}
+
+		PipelineKeyHasher& Add(const GraphicsState& state) noexcept
+		{
+			Add(static_cast<std::uint64_t>(state.rasterizer.cullMode));
+			Add(static_cast<std::uint64_t>(state.rasterizer.frontFace));
+			Add(static_cast<std::uint64_t>(state.depth.testEnable));
+			Add(static_cast<std::uint64_t>(state.depth.writeEnable));
+			Add(static_cast<std::uint64_t>(state.depth.depthCompareOp));
+			Add(static_cast<std::uint64_t>(state.depth.stencil.enable));
+			Add(static_cast<std::uint64_t>(state.depth.stencil.readMask));
+			Add(static_cast<std::uint64_t>(state.depth.stencil.writeMask));
+			Add(state.depth.stencil.front);
+			Add(state.depth.stencil.back);
+			Add(static_cast<std::uint64_t>(state.blend.enable));
+			return Add(static_cast<std::uint64_t>(state.blend.mode));
+		}
+
+		PipelineKeyHasher& Add(const InputLayoutDesc& layout) noexcept
+		{
+			Add(static_cast<std::uint64_t>(layout.strideBytes));
+			Add(static_cast<std::uint64_t>(layout.attributes.size()));
+			for (const VertexAttributeDesc& attribute : layout.attributes)
+			{
+				Add(static_cast<std::uint64_t>(attribute.semantic));
+				Add(static_cast<std::uint64_t>(attribute.semanticIndex));
+				Add(static_cast<std::uint64_t>(attribute.format));
+				Add(static_cast<std::uint64_t>(attribute.inputSlot));
+				Add(static_cast<std::uint64_t>(attribute.offsetBytes));
+				Add(static_cast<std::uint64_t>(attribute.normalized));
+			}
+			return *this;
+		}
+
+		std::uint64_t Value() const noexcept
+		{
+			return hash_;
+		}
+
+	private:
+		static constexpr std::uint64_t kPrime = 1099511628211ull;
+		std::uint64_t hash_{ 1469598103934665603ull };
+	};
+
+	struct PipelineCacheStats
+	{
+		std::size_t entries{ 0 };
+		std::size_t blobBytes{ 0 };
+		std::size_t loadedEntries{ 0 };  // accepted by the last Deserialize()
+		std::uint64_t hits{ 0 };         // native pipelines built from a cached blob
+		std::uint64_t misses{ 0 };       // native pipelines compiled from scratch
+		std::uint64_t rejected{ 0 };     // blobs the driver refused (driver/adapter changed); recompiled
+		double compileMs{ 0.0 };         // time backends spent creating native pipelines, warm or cold
+	};
+
+	class PipelineCache
+	{
+	public:
+		explicit PipelineCache(Backend backend) : backend_(backend) {}
+
+		Backend GetBackend() const noexcept
+		{
+			return backend_;
+		}
+
+		// Blob for `key`, or nullptr. Counts a hit or a miss.
+		const std::vector<std::byte>* Find(std::uint64_t key)
+		{
+			if (auto it = blobs_.find(key); it != blobs_.end())
+			{
+				++stats_.hits;
+				return &it->second;
+			}
+			++stats_.misses;
+			return nullptr;
+		}
+
+		void Store(std::uint64_t key, std::span<const std::byte> blob)
+		{
+			std::vector<std::byte>& stored = blobs_[key];
+			stats_.blobBytes = stats_.blobBytes - stored.size() + blob.size();
+			stored.assign(blob.begin(), blob.end());
+			dirty_ = true;
+		}
+
+		// The backend could not use the blob it found: forget it, and turn the counted hit into a miss.
+		void Reject(std::uint64_t key)
+		{
+			if (auto it = blobs_.find(key); it != blobs_.end())
+			{
+				stats_.blobBytes -= it->second.size();
+				blobs_.erase(it);
+				dirty_ = true;
+			}
+			++stats_.rejected;
+			if (stats_.hits > 0)
+			{
+				--stats_.hits;
+			}
+			++stats_.misses;
+		}
+
+		void RecordCompileTime(double milliseconds) noexcept
+		{
+			stats_.compileMs += milliseconds;
+		}
+
+		void Clear()
+		{
+			dirty_ = !blobs_.empty();
+			blobs_.clear();
+			stats_.blobBytes = 0;
+		}
+
+		bool IsDirty() const noexcept
+		{
+			return dirty_;
+		}
+
+		PipelineCacheStats GetStats() const noexcept
+		{
+			PipelineCacheStats stats = stats_;
+			stats.entries = blobs_.size();
+			return stats;
+		}
+
+		// Layout: header, then per entry { u64 key, u64 size, size bytes }.
+		std::vector<std::byte> Serialize()
+		{
+			std::vector<std::byte> bytes;
+			bytes.reserve(sizeof(FileHeader) + blobs_.size() * 16 + stats_.blobBytes);
+
+			FileHeader header{};
+			header.backend = static_cast<std::uint32_t>(backend_);
+			header.entryCount = static_cast<std::uint32_t>(blobs_.size());
+			Append(bytes, header);
+			for (const auto& [key, blob] : blobs_)
+			{
+				Append(bytes, key);
+				Append(bytes, static_cast<std::uint64_t>(blob.size()));
+				bytes.insert(bytes.end(), blob.begin(), blob.end());
+			}
+			dirty_ = false;
+			return bytes;
+		}
+
+		// Replaces the contents with a serialized cache. A cache from another backend, another format
+		// version or a truncated file is dropped as a whole and false is returned: a cold start, not an error.
+		bool Deserialize(std::span<const std::byte> bytes)
+		{
+			blobs_.clear();
+			stats_.blobBytes = 0;
+			stats_.loadedEntries = 0;
+			dirty_ = false;
+
+			std::size_t cursor = 0;
+			FileHeader header{};
+			const FileHeader expected{};
+			if (!Read(bytes, cursor, header) || header.magic != expected.magic || header.version != expected.version
+				|| header.backend != static_cast<std::uint32_t>(backend_))
+			{
+				return false;
+			}
+
+			std::unordered_map<std::uint64_t, std::vector<std::byte>> loaded;
+			loaded.reserve(header.entryCount);
+			for (std::uint32_t i = 0; i < header.entryCount; ++i)
+			{
+				std::uint64_t key = 0;
+				std::uint64_t size = 0;
+				if (!Read(bytes, cursor, key) || !Read(bytes, cursor, size) || size > bytes.size() - cursor)
+				{
+					return false;
+				}
+				const auto first = bytes.begin() + static_cast<std::ptrdiff_t>(cursor);
+				loaded[key].assign(first, first + static_cast<std::ptrdiff_t>(size));
+				cursor += static_cast<std::size_t>(size);
+				stats_.blobBytes += static_cast<std::size_t>(size);
+			}
+
+			blobs_ = std::move(loaded);
+			stats_.loadedEntries = blobs_.size();
+			return true;
+		}
+
+	private:
+		struct FileHeader
+		{
+			std::uint32_t magic{ 0x43505352u }; // "RSPC"
+			std::uint32_t version{ 1 };
+			std::uint32_t backend{ 0 };
+			std::uint32_t entryCount{ 0 };
+		};
+
+		template <typename T>
+		static void Append(std::vector<std::byte>& bytes, const T& value)
+		{
+			const auto* first = reinterpret_cast<const std::byte*>(&value);
+			bytes.insert(bytes.end(), first, first + sizeof(T));
+		}
+
+		template <typename T>
+		static bool Read(std::span<const std::byte> bytes, std::size_t& cursor, T& value)
+		{
+			if (bytes.size() - cursor < sizeof(T))
+			{
+				return false;
+			}
+			std::memcpy(&value, bytes.data() + cursor, sizeof(T));
+			cursor += sizeof(T);
+			return true;
+		}
+
+		Backend backend_;
+		std::unordered_map<std::uint64_t, std::vector<std::byte>> blobs_;
+		PipelineCacheStats stats_{};
+		bool dirty_{ false };
+	};
+
+	// Objects whose release must wait for a GPU timeline value. Defer(item) adds to an open batch that the
+	// next Seal(value) closes, for code that learns the value only when the frame is submitted; Defer(value, item)
+	// is for work whose value is already known (async uploads). Retire() hands back everything whose value
+	// has completed, oldest first.
+	template <typename T>
+	class DeferredReleaseQueue
+	{
+	public:
+		void Defer(T item)
+		{
+			open_.push_back(std::move(item));
+		}
+
+		void Defer(std::uint64_t value, T item)
+		{
+			// Values are almost always the newest; keep the queue sorted without a full sort.
+			auto it = sealed_.end();
+			while (it != sealed_.begin() && std::prev(it)->value > value)
+			{
+				--it;
+			}
+			sealed_.insert(it, Entry{ value, std::move(item) });
+		}
+
+		void Seal(std::uint64_t value)
+		{
+			for (T& item : open_)
+			{
+				Defer(value, std::move(item));
+			}
+			open_.clear();
+		}
+
+		template <typename Fn>
+		std::size_t Retire(std::uint64_t completedValue, Fn&& release)
+		{
+			std::size_t retired = 0;
+			while (!sealed_.empty() && sealed_.front().value <= completedValue)
+			{
+				T item = std::move(sealed_.front().item);
+				sealed_.pop_front();
+				release(item);
+				++retired;
+			}
+			return retired;
+		}
+
+		std::size_t PendingCount() const noexcept
+		{
+			return open_.size() + sealed_.size();
+		}
+
+		void Clear() noexcept
+		{
+			open_.clear();
+			sealed_.clear();
+		}
+
+	private:
+		struct Entry
+		{
+			std::uint64_t value{ 0 };
+			T item;
+		};
+
+		std::vector<T> open_;
+		std::deque<Entry> sealed_;
+	};
+
+	// ------------------------ RHI interfaces ------------------------ //
+
+	class IRHISwapChain
+	{
+	public:
+		virtual ~IRHISwapChain() = default;
+		virtual SwapChainDesc GetDesc() const = 0;
+		virtual FrameBufferHandle GetCurrentBackBuffer() const = 0;
+		virtual TextureHandle GetDepthTexture() const = 0;
+		virtual void Present() = 0;
+		virtual void Resize(Extent2D newExtent) = 0;
+	};
+
+	class IRHIDevice
+	{
+	public:
+		virtual ~IRHIDevice() = default;
+
+		virtual Backend GetBackend() const noexcept = 0;
+
+		virtual std::string_view GetName() const = 0;
+
+		// Frames the backend keeps in flight (per-frame command allocators, upload pages, ...). Frame pacing
+		// above the RHI should not run further ahead than this.
+		virtual std::uint32_t GetFramesInFlight() const noexcept { return 2; }
+
+		// Optional UI hooks (Dear ImGui). Default is no-op.
+		virtual void InitImGui([[maybe_unused]] void* hwnd, [[maybe_unused]] int framesInFlight, [[maybe_unused]] Format rtvFormat) {}
+		virtual void ImGuiNewFrame() {}
+		virtual void ShutdownImGui() {}
+		virtual void WaitIdle() {}
+
+		// Textures
+		virtual TextureHandle CreateTexture2D(Extent2D extendt, Format format) = 0;
+		virtual TextureHandle CreateTextureCube(Extent2D extent, Format format) = 0;
+		virtual void DestroyTexture(TextureHandle texture) noexcept = 0;
+
+		// Framebuffers
+		virtual FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) = 0;
+		// Multiple render targets (MRT). 0 colors means depth-only pass.
+		// Default implementation falls back to the single-color CreateFramebuffer() and will throw for colors.size() > 1.
+		virtual FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth)
+		{
+			if (colors.empty())
 			{
 				return CreateFramebuffer(TextureHandle{}, depth);
 			}
@@ -609,6 +2099,12 @@ export namespace rhi
 		// Buffers
 		virtual BufferHandle CreateBuffer(const BufferDesc& desc) = 0;
 		virtual void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) = 0;
+		// Like UpdateBuffer(), but the backend may read `data` in place instead of copying it. The caller keeps
+		// the bytes alive and unchanged until the next SubmitCommandList() returns (FrameUploadRing memory does).
+		virtual void UpdateBufferInPlace(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0)
+		{
+			UpdateBuffer(buffer, data, offsetBytes);
+		}
 		virtual void DestroyBuffer(BufferHandle buffer) noexcept = 0;
 
 		// Input layouts (API-neutral)
@@ -646,6 +2142,10 @@ export namespace rhi
 		}
 		virtual void DestroyPipeline(PipelineHandle pso) noexcept = 0;
 
+		// Optional persistent store for compiled pipelines; nullptr detaches. Not owned, must outlive its use.
+		// Backends without cacheable pipeline binaries ignore it.
+		virtual void SetPipelineCache([[maybe_unused]] PipelineCache* cache) {}
+
 		// Submission
 		virtual void SubmitCommandList(CommandList&& commandList) = 0;
 
@@ -653,6 +2153,10 @@ export namespace rhi
 		virtual TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) = 0;
 		virtual void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) = 0;
 		virtual void FreeTextureDescriptor(TextureDescIndex index) noexcept = 0;
+		// Contiguous block of `count` indices handed to the caller for its own sub-allocation (bindless tables).
+		// Every slot starts as the null texture and is only written through UpdateTextureDescriptor().
+		virtual TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) = 0;
+		virtual void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept = 0;
 
 		// Synchronization
 		virtual FenceHandle CreateFence(bool signaled = false) = 0;
@@ -660,9 +2164,23 @@ export namespace rhi
 		virtual void SignalFence(FenceHandle fence) = 0;
 		virtual void WaitFence(FenceHandle fence) = 0;
 		virtual bool IsFenceSignaled(FenceHandle fence) = 0;
+
+		// Timeline on the graphics queue: SignalTimeline() enqueues the next value of a monotonically increasing
+		// 64-bit counter behind all work submitted so far and returns it; the value completes when that work does.
+		virtual std::uint64_t SignalTimeline() = 0;
+		virtual std::uint64_t GetCompletedTimelineValue() = 0;
+		virtual void WaitTimelineValue(std::uint64_t value) = 0;
+	};
+
+	struct NullDeviceDesc
+	{
+		// Simulated GPU lag: a timeline value completes once this many newer values have been signaled,
+		// or earlier when the CPU waits for it. 0 = the GPU keeps up instantly.
+		std::uint32_t gpuLatencySignals{ 0 };
+		std::uint32_t framesInFlight{ 2 };
 	};
 
-	std::unique_ptr<IRHIDevice> CreateNullDevice();
+	std::unique_ptr<IRHIDevice> CreateNullDevice(NullDeviceDesc desc = {});
 	std::unique_ptr<IRHISwapChain> CreateNullSwapChain(IRHIDevice& device, SwapChainDesc desc);
 }
 
@@ -699,6 +2217,11 @@ namespace rhi
 	class NullDevice : public rhi::IRHIDevice
 	{
 	public:
+		explicit NullDevice(NullDeviceDesc desc = {})
+			: desc_(desc)
+		{
+		}
+
 		std::string_view GetName() const override
 		{
 			return "Null RHI Device";
@@ -709,112 +2232,215 @@ namespace rhi
 			return Backend::Null;
 		}
 
+		std::uint32_t GetFramesInFlight() const noexcept override
+		{
+			return desc_.framesInFlight;
+		}
+
 		TextureHandle CreateTexture2D(Extent2D, Format) override
 		{
-			TextureHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return textures_.Emplace();
 		}
 		TextureHandle CreateTextureCube(Extent2D, Format) override
 		{
-			TextureHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return textures_.Emplace();
+		}
+		void DestroyTexture(TextureHandle texture) noexcept override
+		{
+			textures_.Erase(texture);
 		}
-		void DestroyTexture(TextureHandle) noexcept override {}
 
 		FrameBufferHandle CreateFramebuffer(TextureHandle, TextureHandle) override
 		{
-			FrameBufferHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return framebuffers_.Emplace();
+		}
+		FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle>, TextureHandle) override
+		{
+			return framebuffers_.Emplace();
 		}
 		FrameBufferHandle CreateFramebufferCubeFace(TextureHandle, std::uint32_t, TextureHandle) override
 		{
-			FrameBufferHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return framebuffers_.Emplace();
 		}
 		FrameBufferHandle CreateFramebufferCubeFaceMip(TextureHandle, std::uint32_t, std::uint32_t, TextureHandle) override
 		{
-			FrameBufferHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return framebuffers_.Emplace();
+		}
+		void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
+		{
+			framebuffers_.Erase(framebuffer);
 		}
-		void DestroyFramebuffer(FrameBufferHandle) noexcept override {}
 
-		BufferHandle CreateBuffer(const BufferDesc&) override
+		BufferHandle CreateBuffer(const BufferDesc& desc) override
+		{
+			const BufferHandle buffer = buffers_.Emplace();
+			indirectValidator_.OnCreateBuffer(buffer, desc);
+			return buffer;
+		}
+		void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
 		{
-			BufferHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+		}
+		void DestroyBuffer(BufferHandle buffer) noexcept override
+		{
+			buffers_.Erase(buffer);
+			indirectValidator_.OnDestroyBuffer(buffer);
 		}
-		void UpdateBuffer(BufferHandle, std::span<const std::byte>, std::size_t) override {}
-		void DestroyBuffer(BufferHandle) noexcept override {}
 
 		InputLayoutHandle CreateInputLayout(const InputLayoutDesc&) override
 		{
-			InputLayoutHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			return layouts_.Emplace();
+		}
+		void DestroyInputLayout(InputLayoutHandle layout) noexcept override
+		{
+			layouts_.Erase(layout);
 		}
-		void DestroyInputLayout(InputLayoutHandle) noexcept override {}
 
 		virtual void BindInputLayout(InputLayoutHandle layout) {}
 		virtual void BindVertexBuffer(std::uint32_t slot, BufferHandle vertexBuffer, std::uint32_t strideBytes, std::uint32_t offsetBytes) {}
 		virtual void BindIndexBuffer(BufferHandle indexBuffer, IndexType indexTtype, std::uint32_t offsetBytes) {}
 
-		ShaderHandle CreateShader(ShaderStage stage, std::string_view, std::string_view) override
+		ShaderHandle CreateShader(ShaderStage stage, std::string_view, std::string_view sourceOrBytecode) override
+		{
+			return shaders_.Emplace(PipelineKeyHasher{}.Add(static_cast<std::uint64_t>(stage)).Add(sourceOrBytecode).Value());
+		}
+		void DestroyShader(ShaderHandle shader) noexcept override
+		{
+			shaders_.Erase(shader);
+		}
+
+		PipelineHandle CreatePipeline(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType) override
+		{
+			return CreatePipelineEx(debugName, vertexShader, pixelShader, topologyType, 1);
+		}
+		// Null pipelines are "compiled" eagerly: the cache sees one lookup per created pipeline, keyed by
+		// shader source, topology and view-instance count, so warm/cold runs can be compared headless.
+		PipelineHandle CreatePipelineEx(std::string_view, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType, std::uint32_t viewInstanceCount) override
+		{
+			if (pipelineCache_)
+			{
+				const std::uint64_t* vsHash = shaders_.Find(vertexShader);
+				const std::uint64_t* psHash = shaders_.Find(pixelShader);
+				const std::uint64_t key = PipelineKeyHasher{}
+					.Add(vsHash ? *vsHash : 0u)
+					.Add(psHash ? *psHash : 0u)
+					.Add(static_cast<std::uint64_t>(topologyType))
+					.Add(static_cast<std::uint64_t>(viewInstanceCount))
+					.Value();
+				if (!pipelineCache_->Find(key))
+				{
+					pipelineCache_->Store(key, std::as_bytes(std::span(&key, 1)));
+				}
+			}
+			return pipelines_.Emplace();
+		}
+		void DestroyPipeline(PipelineHandle pipeline) noexcept override
+		{
+			pipelines_.Erase(pipeline);
+		}
+
+		void SetPipelineCache(PipelineCache* cache) override
 		{
-			ShaderHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			pipelineCache_ = cache;
 		}
-		void DestroyShader(ShaderHandle) noexcept override {}
 
-		PipelineHandle CreatePipeline(std::string_view, ShaderHandle, ShaderHandle, PrimitiveTopologyType) override
+		void SubmitCommandList(CommandList&& commandList) override
 		{
-			PipelineHandle handle{};
-			handle.id = ++nextId_;
-			return handle;
+			// Argument buffers are checked the way a GPU would read them, before anything "executes".
+			indirectValidator_.Validate(commandList);
+
+			// Walk the stream like a real backend would, so headless runs pay the decode cost.
+			for (const CommandRecord& record : commandList)
+			{
+				VisitCommand(record, [this]<typename T>(const T& cmd)
+					{
+						if constexpr (std::is_same_v<T, CommandDrawIndexed> || std::is_same_v<T, CommandDraw>)
+						{
+							++submittedDraws_;
+						}
+						else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+						{
+							submittedDraws_ += cmd.drawCount;
+						}
+					});
+				++submittedCommands_;
+			}
 		}
-		void DestroyPipeline(PipelineHandle pipeline) noexcept override {}
 
-		void SubmitCommandList(CommandList&& commandList) override {}
+		const IndirectDrawStats& GetIndirectDrawStats() const noexcept
+		{
+			return indirectValidator_.GetStats();
+		}
 
 		TextureDescIndex AllocateTextureDesctiptor(TextureHandle tex) override
 		{
-			const auto idx = ++nextDescId_;
+			TextureDescIndex idx = 0;
+			if (!freeDescIndices_.empty())
+			{
+				idx = freeDescIndices_.back();
+				freeDescIndices_.pop_back();
+				descFreed_[idx] = false;
+			}
+			else
+			{
+				idx = static_cast<TextureDescIndex>(descToTex_.size());
+				descToTex_.emplace_back();
+			}
 			descToTex_[idx] = tex;
 			return idx;
 		}
 
 		void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) override
 		{
-			descToTex_[index] = texture;
+			if (index != 0 && index < descToTex_.size())
+			{
+				descToTex_[index] = texture;
+			}
 		}
 
 		void FreeTextureDescriptor(TextureDescIndex index) noexcept override
 		{
-			descToTex_.erase(index);
+			// Freeing a slot twice would put it on the free list twice and hand it to two owners.
+			if (index != 0 && index < descToTex_.size() && !(index < descFreed_.size() && descFreed_[index]))
+			{
+				descToTex_[index] = {};
+				freeDescIndices_.push_back(index);
+				descFreed_.resize(std::max<std::size_t>(descFreed_.size(), index + 1u), false);
+				descFreed_[index] = true;
+			}
+		}
+
+		TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+		{
+			const TextureDescIndex first = static_cast<TextureDescIndex>(descToTex_.size());
+			descToTex_.resize(descToTex_.size() + count);
+			return first;
+		}
+
+		void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+		{
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				FreeTextureDescriptor(first + i);
+			}
 		}
 
 		FenceHandle CreateFence(bool signaled = false) override
 		{
-			FenceHandle handle{};
-			handle.id = ++nextFenceId_;
-			fenceSignaled_[handle.id] = signaled;
-			return handle;
+			return fences_.Emplace(signaled);
 		}
 
 		void DestroyFence(FenceHandle fence) noexcept override
 		{
-			fenceSignaled_.erase(fence.id);
+			fences_.Erase(fence);
 		}
 
 		void SignalFence(FenceHandle fence) override
 		{
-			fenceSignaled_[fence.id] = true;
+			if (bool* signaled = fences_.Find(fence))
+			{
+				*signaled = true;
+			}
 		}
 
 		void WaitFence(FenceHandle fence) override
@@ -824,24 +2450,64 @@ namespace rhi
 
 		bool IsFenceSignaled(FenceHandle fence) override
 		{
-			if (auto it = fenceSignaled_.find(fence.id); it != fenceSignaled_.end())
+			if (const bool* signaled = fences_.Find(fence))
 			{
-				return it->second;
+				return *signaled;
 			}
 			return true;
 		}
 
+		std::uint64_t SignalTimeline() override
+		{
+			++timelineSignaled_;
+			if (timelineSignaled_ > desc_.gpuLatencySignals)
+			{
+				timelineCompleted_ = std::max(timelineCompleted_, timelineSignaled_ - desc_.gpuLatencySignals);
+			}
+			return timelineSignaled_;
+		}
+
+		std::uint64_t GetCompletedTimelineValue() override
+		{
+			return timelineCompleted_;
+		}
+
+		void WaitTimelineValue(std::uint64_t value) override
+		{
+			// The CPU blocks until the simulated GPU catches up; a value never signaled cannot complete.
+			timelineCompleted_ = std::max(timelineCompleted_, std::min(value, timelineSignaled_));
+		}
+
 	private:
-		std::uint32_t nextId_{ 100 };
-		std::uint32_t nextDescId_{ 0 };
-		std::uint32_t nextFenceId_{ 0 };
-		std::unordered_map<TextureDescIndex, TextureHandle> descToTex_{};
-		std::unordered_map<std::uint32_t, bool> fenceSignaled_{};
+		std::uint64_t submittedCommands_{ 0 };
+		std::uint64_t submittedDraws_{ 0 };
+
+		// The null device keeps no per-object data, but pooled handles still catch use-after-destroy.
+		struct NullObject {};
+		HandlePool<TextureTag, NullObject> textures_{};
+		HandlePool<BufferTag, NullObject> buffers_{};
+		HandlePool<ShaderTag, std::uint64_t> shaders_{}; // source hash, for pipeline cache keys
+		HandlePool<PipelineTag, NullObject> pipelines_{};
+		HandlePool<FrameBufferTag, NullObject> framebuffers_{};
+		HandlePool<InputLayoutTag, NullObject> layouts_{};
+		HandlePool<FenceTag, bool> fences_{};
+		IndirectDrawValidator indirectValidator_{};
+
+		// Descriptor index -> texture (index 0 is the null descriptor).
+		std::vector<TextureHandle> descToTex_{ TextureHandle{} };
+		std::vector<TextureDescIndex> freeDescIndices_{};
+		std::vector<bool> descFreed_{};
+
+		PipelineCache* pipelineCache_{ nullptr };
+
+		NullDeviceDesc desc_{};
+		std::uint64_t timelineSignaled_{ 0 };
+		std::uint64_t timelineCompleted_{ 0 };
 	};
 
-	std::unique_ptr<IRHIDevice> CreateNullDevice()
+	std::unique_ptr<IRHIDevice> CreateNullDevice(NullDeviceDesc desc)
 	{
-		return std::make_unique<NullDevice>();
+		return std::make_unique<NullDevice>(desc);
 	}
 
 	std::unique_ptr<IRHISwapChain> CreateNullSwapChain(IRHIDevice& device, SwapChainDesc desc)
@@ -0,0 +1,1221 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+export module core:rhi_capture;
+
+import :rhi;
+
+// Headless capture/replay of RHI traffic.
+//
+// RecordingDevice decorates any IRHIDevice and serializes resource creation, buffer uploads and
+// submitted command streams into a compact binary capture. CaptureReplayer feeds a capture back
+// into any IRHIDevice (typically NullDevice on CI), remapping handles on the fly and reporting
+// per-command-type counts, draw counts and upload sizes so regressions can be caught without a GPU.
+//
+// File layout:
+//   CaptureFileHeader
+//   { [CaptureOp : u8][payloadBytes : u32][payload] }*
+
+export namespace rhi
+{
+	enum class CaptureOp : std::uint8_t
+	{
+		CreateTexture2D = 1,
+		CreateTextureCube,
+		DestroyTexture,
+		CreateFramebuffer,
+		CreateFramebufferMRT,
+		CreateFramebufferCubeFace,
+		CreateFramebufferCubeFaceMip,
+		CreateFramebufferCube,
+		DestroyFramebuffer,
+		CreateBuffer,
+		UpdateBuffer,
+		DestroyBuffer,
+		CreateInputLayout,
+		DestroyInputLayout,
+		CreateShader,
+		DestroyShader,
+		CreatePipeline,
+		DestroyPipeline,
+		SubmitCommandList,
+		AllocateTextureDescriptor,
+		UpdateTextureDescriptor,
+		FreeTextureDescriptor,
+		CreateFence,
+		DestroyFence,
+		SignalFence,
+		WaitFence,
+		ReserveTextureDescriptorRange,
+		ReleaseTextureDescriptorRange,
+		SignalTimeline,
+		WaitTimelineValue
+	};
+
+	struct CaptureFileHeader
+	{
+		std::array<char, 8> magic{ 'R', 'H', 'I', 'C', 'A', 'P', 'T', 0 };
+		std::uint32_t version{ 1 };
+		// Command payloads are stored as raw records, so producer and consumer must agree on their layout.
+		std::uint32_t layoutFingerprint{ 0 };
+	};
+
+	std::uint32_t CommandLayoutFingerprint() noexcept
+	{
+		std::uint32_t hash = 2166136261u; // FNV-1a
+		auto Mix = [&hash](std::size_t value)
+			{
+				hash ^= static_cast<std::uint32_t>(value);
+				hash *= 16777619u;
+			};
+		auto MixType = [&Mix]<typename T>(std::type_identity<T>)
+			{
+				Mix(sizeof(T));
+				Mix(alignof(T));
+			};
+
+		MixType(std::type_identity<CommandHeader>{});
+		MixType(std::type_identity<CommandBeginPass>{});
+		MixType(std::type_identity<CommandSetViewport>{});
+		MixType(std::type_identity<CommandSetState>{});
+		MixType(std::type_identity<CommandBindVertexBuffer>{});
+		MixType(std::type_identity<CommandBindIndexBuffer>{});
+		MixType(std::type_identity<CommandDrawIndexed>{});
+		MixType(std::type_identity<CommandDraw>{});
+		MixType(std::type_identity<CommandDrawIndexedIndirect>{});
+		MixType(std::type_identity<CommandUniformMat4>{});
+		// Uniform ids are stored hashed; a different hash function must not replay old captures.
+		Mix(static_cast<std::size_t>(UniformId::Hash("uMVP")));
+		MixType(std::type_identity<detail::SetConstantsRecord>{});
+		MixType(std::type_identity<detail::TransitionTexturesRecord>{});
+		MixType(std::type_identity<TextureBarrier>{});
+		Mix(kCommandRecordAlignment);
+		Mix(static_cast<std::size_t>(CommandType::Count));
+		return hash;
+	}
+
+	class CaptureWriter
+	{
+	public:
+		CaptureWriter()
+		{
+			CaptureFileHeader header{};
+			header.layoutFingerprint = CommandLayoutFingerprint();
+			Write(header);
+		}
+
+		void BeginRecord(CaptureOp op)
+		{
+			Write(op);
+			recordSizeOffset_ = bytes_.size();
+			Write(std::uint32_t{ 0 });
+		}
+
+		void EndRecord()
+		{
+			const std::uint32_t payloadBytes = static_cast<std::uint32_t>(bytes_.size() - recordSizeOffset_ - sizeof(std::uint32_t));
+			std::memcpy(bytes_.data() + recordSizeOffset_, &payloadBytes, sizeof(payloadBytes));
+		}
+
+		template <typename T>
+		void Write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			const auto* src = reinterpret_cast<const std::byte*>(&value);
+			bytes_.insert(bytes_.end(), src, src + sizeof(T));
+		}
+
+		void WriteBytes(std::span<const std::byte> data)
+		{
+			Write(static_cast<std::uint64_t>(data.size()));
+			bytes_.insert(bytes_.end(), data.begin(), data.end());
+		}
+
+		void WriteString(std::string_view text)
+		{
+			WriteBytes(std::as_bytes(std::span<const char>(text.data(), text.size())));
+		}
+
+		const std::vector<std::byte>& Bytes() const noexcept { return bytes_; }
+
+	private:
+		std::vector<std::byte> bytes_;
+		std::size_t recordSizeOffset_{ 0 };
+	};
+
+	class CaptureReader
+	{
+	public:
+		explicit CaptureReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+		bool AtEnd() const noexcept { return cursor_ >= bytes_.size(); }
+
+		template <typename T>
+		T Read()
+		{
+			static_assert(std::is_trivially_copyable_v<T>);
+			T value{};
+			std::memcpy(&value, Take(sizeof(T)).data(), sizeof(T));
+			return value;
+		}
+
+		std::span<const std::byte> ReadBytes()
+		{
+			const auto size = Read<std::uint64_t>();
+			return Take(static_cast<std::size_t>(size));
+		}
+
+		std::string_view ReadString()
+		{
+			const auto data = ReadBytes();
+			return std::string_view(reinterpret_cast<const char*>(data.data()), data.size());
+		}
+
+		std::span<const std::byte> Take(std::size_t size)
+		{
+			if (size > bytes_.size() - cursor_)
+			{
+				throw std::runtime_error("RHI capture: unexpected end of data");
+			}
+			const auto out = bytes_.subspan(cursor_, size);
+			cursor_ += size;
+			return out;
+		}
+
+	private:
+		std::span<const std::byte> bytes_;
+		std::size_t cursor_{ 0 };
+	};
+
+	// Forwards everything to `inner` and writes a capture record for every call that changes GPU state.
+	class RecordingDevice final : public IRHIDevice
+	{
+	public:
+		explicit RecordingDevice(IRHIDevice& inner) : inner_(inner) {}
+
+		Backend GetBackend() const noexcept override { return inner_.GetBackend(); }
+		std::string_view GetName() const override { return "Recording RHI Device"; }
+		std::uint32_t GetFramesInFlight() const noexcept override { return inner_.GetFramesInFlight(); }
+
+		void InitImGui(void* hwnd, int framesInFlight, Format rtvFormat) override { inner_.InitImGui(hwnd, framesInFlight, rtvFormat); }
+		void ImGuiNewFrame() override { inner_.ImGuiNewFrame(); }
+		void ShutdownImGui() override { inner_.ShutdownImGui(); }
+		void WaitIdle() override { inner_.WaitIdle(); }
+
+		// Textures
+		TextureHandle CreateTexture2D(Extent2D extent, Format format) override
+		{
+			const TextureHandle texture = inner_.CreateTexture2D(extent, format);
+			Record(CaptureOp::CreateTexture2D, texture.id, extent, format);
+			return texture;
+		}
+		TextureHandle CreateTextureCube(Extent2D extent, Format format) override
+		{
+			const TextureHandle texture = inner_.CreateTextureCube(extent, format);
+			Record(CaptureOp::CreateTextureCube, texture.id, extent, format);
+			return texture;
+		}
+		void DestroyTexture(TextureHandle texture) noexcept override
+		{
+			inner_.DestroyTexture(texture);
+			RecordNoExcept(CaptureOp::DestroyTexture, texture.id);
+		}
+
+		// Framebuffers
+		FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) override
+		{
+			const FrameBufferHandle frameBuffer = inner_.CreateFramebuffer(color, depth);
+			Record(CaptureOp::CreateFramebuffer, frameBuffer.id, color.id, depth.id);
+			return frameBuffer;
+		}
+		FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth) override
+		{
+			const FrameBufferHandle frameBuffer = inner_.CreateFramebufferMRT(colors, depth);
+			writer_.BeginRecord(CaptureOp::CreateFramebufferMRT);
+			writer_.Write(frameBuffer.id);
+			writer_.Write(depth.id);
+			writer_.WriteBytes(std::as_bytes(colors));
+			writer_.EndRecord();
+			return frameBuffer;
+		}
+		FrameBufferHandle CreateFramebufferCubeFace(TextureHandle colorCube, std::uint32_t faceIndex, TextureHandle depth) override
+		{
+			const FrameBufferHandle frameBuffer = inner_.CreateFramebufferCubeFace(colorCube, faceIndex, depth);
+			Record(CaptureOp::CreateFramebufferCubeFace, frameBuffer.id, colorCube.id, faceIndex, depth.id);
+			return frameBuffer;
+		}
+		FrameBufferHandle CreateFramebufferCubeFaceMip(TextureHandle colorCube, std::uint32_t faceIndex, std::uint32_t mipLevel, TextureHandle depth) override
+		{
+			const FrameBufferHandle frameBuffer = inner_.CreateFramebufferCubeFaceMip(colorCube, faceIndex, mipLevel, depth);
+			Record(CaptureOp::CreateFramebufferCubeFaceMip, frameBuffer.id, colorCube.id, faceIndex, mipLevel, depth.id);
+			return frameBuffer;
+		}
+		FrameBufferHandle CreateFramebufferCube(TextureHandle colorCube, TextureHandle depthCube) override
+		{
+			const FrameBufferHandle frameBuffer = inner_.CreateFramebufferCube(colorCube, depthCube);
+			Record(CaptureOp::CreateFramebufferCube, frameBuffer.id, colorCube.id, depthCube.id);
+			return frameBuffer;
+		}
+		void DestroyFramebuffer(FrameBufferHandle frameBuffer) noexcept override
+		{
+			inner_.DestroyFramebuffer(frameBuffer);
+			RecordNoExcept(CaptureOp::DestroyFramebuffer, frameBuffer.id);
+		}
+
+		// Buffers
+		BufferHandle CreateBuffer(const BufferDesc& desc) override
+		{
+			const BufferHandle buffer = inner_.CreateBuffer(desc);
+			indirectValidator_.OnCreateBuffer(buffer, desc);
+			writer_.BeginRecord(CaptureOp::CreateBuffer);
+			writer_.Write(buffer.id);
+			writer_.Write(desc.bindFlag);
+			writer_.Write(desc.usageFlag);
+			writer_.Write(static_cast<std::uint64_t>(desc.sizeInBytes));
+			writer_.Write(desc.structuredStrideBytes);
+			writer_.WriteString(desc.debugName);
+			writer_.EndRecord();
+			return buffer;
+		}
+		void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+		{
+			inner_.UpdateBuffer(buffer, data, offsetBytes);
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+			writer_.BeginRecord(CaptureOp::UpdateBuffer);
+			writer_.Write(buffer.id);
+			writer_.Write(static_cast<std::uint64_t>(offsetBytes));
+			writer_.WriteBytes(data);
+			writer_.EndRecord();
+		}
+		void UpdateBufferInPlace(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+		{
+			// Replays as a plain UpdateBuffer: the recorded bytes are owned by the capture.
+			inner_.UpdateBufferInPlace(buffer, data, offsetBytes);
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+			writer_.BeginRecord(CaptureOp::UpdateBuffer);
+			writer_.Write(buffer.id);
+			writer_.Write(static_cast<std::uint64_t>(offsetBytes));
+			writer_.WriteBytes(data);
+			writer_.EndRecord();
+		}
+		void DestroyBuffer(BufferHandle buffer) noexcept override
+		{
+			inner_.DestroyBuffer(buffer);
+			indirectValidator_.OnDestroyBuffer(buffer);
+			RecordNoExcept(CaptureOp::DestroyBuffer, buffer.id);
+		}
+
+		// Input layouts
+		InputLayoutHandle CreateInputLayout(const InputLayoutDesc& desc) override
+		{
+			const InputLayoutHandle layout = inner_.CreateInputLayout(desc);
+			writer_.BeginRecord(CaptureOp::CreateInputLayout);
+			writer_.Write(layout.id);
+			writer_.Write(desc.strideBytes);
+			writer_.WriteBytes(std::as_bytes(std::span(desc.attributes)));
+			writer_.WriteString(desc.debugName);
+			writer_.EndRecord();
+			return layout;
+		}
+		void DestroyInputLayout(InputLayoutHandle layout) noexcept override
+		{
+			inner_.DestroyInputLayout(layout);
+			RecordNoExcept(CaptureOp::DestroyInputLayout, layout.id);
+		}
+
+		// Shaders and pipelines
+		bool SupportsShaderModel6() const override { return inner_.SupportsShaderModel6(); }
+		bool SupportsViewInstancing() const override { return inner_.SupportsViewInstancing(); }
+		bool SupportsVPAndRTArrayIndexFromAnyShader() const override { return inner_.SupportsVPAndRTArrayIndexFromAnyShader(); }
+
+		ShaderHandle CreateShader(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode) override
+		{
+			const ShaderHandle shader = inner_.CreateShader(stage, debugName, sourceOrBytecode);
+			RecordShader(shader, stage, debugName, sourceOrBytecode, ShaderModel::SM5_1);
+			return shader;
+		}
+		ShaderHandle CreateShaderEx(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode, ShaderModel shaderModel) override
+		{
+			const ShaderHandle shader = inner_.CreateShaderEx(stage, debugName, sourceOrBytecode, shaderModel);
+			RecordShader(shader, stage, debugName, sourceOrBytecode, shaderModel);
+			return shader;
+		}
+		void DestroyShader(ShaderHandle shader) noexcept override
+		{
+			inner_.DestroyShader(shader);
+			RecordNoExcept(CaptureOp::DestroyShader, shader.id);
+		}
+
+		PipelineHandle CreatePipeline(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType = PrimitiveTopologyType::Triangle) override
+		{
+			const PipelineHandle pipeline = inner_.CreatePipeline(debugName, vertexShader, pixelShader, topologyType);
+			RecordPipeline(pipeline, debugName, vertexShader, pixelShader, topologyType, 1);
+			return pipeline;
+		}
+		PipelineHandle CreatePipelineEx(
+			std::string_view debugName,
+			ShaderHandle vertexShader,
+			ShaderHandle pixelShader,
+			PrimitiveTopologyType topologyType,
+			std::uint32_t viewInstanceCount) override
+		{
+			const PipelineHandle pipeline = inner_.CreatePipelineEx(debugName, vertexShader, pixelShader, topologyType, viewInstanceCount);
+			RecordPipeline(pipeline, debugName, vertexShader, pixelShader, topologyType, viewInstanceCount);
+			return pipeline;
+		}
+		void DestroyPipeline(PipelineHandle pso) noexcept override
+		{
+			inner_.DestroyPipeline(pso);
+			RecordNoExcept(CaptureOp::DestroyPipeline, pso.id);
+		}
+		void SetPipelineCache(PipelineCache* cache) override
+		{
+			inner_.SetPipelineCache(cache);
+		}
+
+		// Submission
+		void SubmitCommandList(CommandList&& commandList) override
+		{
+			// A capture must never contain an indirect draw that could not be replayed safely.
+			indirectValidator_.Validate(commandList);
+			writer_.BeginRecord(CaptureOp::SubmitCommandList);
+			writer_.Write(static_cast<std::uint64_t>(commandList.Size()));
+			writer_.WriteBytes(commandList.Bytes());
+			writer_.EndRecord();
+			inner_.SubmitCommandList(std::move(commandList));
+		}
+
+		// Bindless-style descriptor indices
+		TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) override
+		{
+			const TextureDescIndex index = inner_.AllocateTextureDesctiptor(texture);
+			Record(CaptureOp::AllocateTextureDescriptor, index, texture.id);
+			return index;
+		}
+		void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) override
+		{
+			inner_.UpdateTextureDescriptor(index, texture);
+			Record(CaptureOp::UpdateTextureDescriptor, index, texture.id);
+		}
+		void FreeTextureDescriptor(TextureDescIndex index) noexcept override
+		{
+			inner_.FreeTextureDescriptor(index);
+			RecordNoExcept(CaptureOp::FreeTextureDescriptor, index);
+		}
+		TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+		{
+			const TextureDescIndex first = inner_.ReserveTextureDescriptorRange(count);
+			Record(CaptureOp::ReserveTextureDescriptorRange, first, count);
+			return first;
+		}
+		void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+		{
+			inner_.ReleaseTextureDescriptorRange(first, count);
+			RecordNoExcept(CaptureOp::ReleaseTextureDescriptorRange, first, count);
+		}
+
+		// Synchronization
+		FenceHandle CreateFence(bool signaled = false) override
+		{
+			const FenceHandle fence = inner_.CreateFence(signaled);
+			Record(CaptureOp::CreateFence, fence.id, signaled);
+			return fence;
+		}
+		void DestroyFence(FenceHandle fence) noexcept override
+		{
+			inner_.DestroyFence(fence);
+			RecordNoExcept(CaptureOp::DestroyFence, fence.id);
+		}
+		void SignalFence(FenceHandle fence) override
+		{
+			inner_.SignalFence(fence);
+			Record(CaptureOp::SignalFence, fence.id);
+		}
+		void WaitFence(FenceHandle fence) override
+		{
+			inner_.WaitFence(fence);
+			Record(CaptureOp::WaitFence, fence.id);
+		}
+		bool IsFenceSignaled(FenceHandle fence) override
+		{
+			return inner_.IsFenceSignaled(fence);
+		}
+		std::uint64_t SignalTimeline() override
+		{
+			const std::uint64_t value = inner_.SignalTimeline();
+			Record(CaptureOp::SignalTimeline, value);
+			return value;
+		}
+		std::uint64_t GetCompletedTimelineValue() override
+		{
+			return inner_.GetCompletedTimelineValue();
+		}
+		void WaitTimelineValue(std::uint64_t value) override
+		{
+			inner_.WaitTimelineValue(value);
+			Record(CaptureOp::WaitTimelineValue, value);
+		}
+
+		// Capture output
+		const std::vector<std::byte>& GetCaptureBytes() const noexcept { return writer_.Bytes(); }
+		const IndirectDrawStats& GetIndirectDrawStats() const noexcept { return indirectValidator_.GetStats(); }
+
+		void SaveCapture(const std::filesystem::path& path) const
+		{
+			std::ofstream file(path, std::ios::binary | std::ios::trunc);
+			if (!file)
+			{
+				throw std::runtime_error("RecordingDevice: failed to open capture file for writing: " + path.string());
+			}
+			const auto& bytes = writer_.Bytes();
+			file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		}
+
+	private:
+		template <typename... Args>
+		void Record(CaptureOp op, const Args&... args)
+		{
+			writer_.BeginRecord(op);
+			(writer_.Write(args), ...);
+			writer_.EndRecord();
+		}
+
+		// Destroy paths are noexcept; losing a capture record is preferable to terminating.
+		template <typename... Args>
+		void RecordNoExcept(CaptureOp op, const Args&... args) noexcept
+		{
+			try
+			{
+				Record(op, args...);
+			}
+			catch (...)
+			{
+			}
+		}
+
+		void RecordShader(ShaderHandle shader, ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode, ShaderModel shaderModel)
+		{
+			writer_.BeginRecord(CaptureOp::CreateShader);
+			writer_.Write(shader.id);
+			writer_.Write(stage);
+			writer_.Write(shaderModel);
+			writer_.WriteString(debugName);
+			writer_.WriteString(sourceOrBytecode);
+			writer_.EndRecord();
+		}
+
+		void RecordPipeline(
+			PipelineHandle pipeline,
+			std::string_view debugName,
+			ShaderHandle vertexShader,
+			ShaderHandle pixelShader,
+			PrimitiveTopologyType topologyType,
+			std::uint32_t viewInstanceCount)
+		{
+			writer_.BeginRecord(CaptureOp::CreatePipeline);
+			writer_.Write(pipeline.id);
+			writer_.Write(vertexShader.id);
+			writer_.Write(pixelShader.id);
+			writer_.Write(topologyType);
+			writer_.Write(viewInstanceCount);
+			writer_.WriteString(debugName);
+			writer_.EndRecord();
+		}
+
+		IRHIDevice& inner_;
+		CaptureWriter writer_;
+		IndirectDrawValidator indirectValidator_;
+	};
+
+	struct CaptureReplayOptions
+	{
+		// Time the replayer's own decode + re-encode per command type (adds a clock read per command).
+		// This is replay cost only; see timeTargetCommandTypes for the target device's cost.
+		bool timeCommandTypes{ false };
+		// Split every replayed list into runs of one command type and time target.SubmitCommandList() per run,
+		// attributing the target device's CPU cost to command types. Runs cut passes apart, so this only suits
+		// targets that keep bound state across submits (e.g. NullDevice), not ValidationDevice or GPU backends.
+		bool timeTargetCommandTypes{ false };
+		// Called with every captured record before it is re-emitted; handles are still the capture's ids.
+		std::function<void(const CommandRecord&)> onCommand{};
+		// Run OptimizeCommandList() on every replayed list before submitting it.
+		bool optimizeCommandLists{ false };
+	};
+
+	struct CaptureSubmitStats
+	{
+		std::uint64_t commands{ 0 };
+		std::uint64_t draws{ 0 };
+		std::uint64_t instances{ 0 };
+		std::uint64_t uploadBytes{ 0 }; // UpdateBuffer bytes issued since the previous submit
+		std::uint64_t removedCommands{ 0 }; // dropped by OptimizeCommandList (optimizeCommandLists only)
+		double submitMs{ 0.0 };         // time spent inside target.SubmitCommandList() (all runs together)
+		std::uint64_t targetRuns{ 0 };  // single-type lists submitted (timeTargetCommandTypes only)
+	};
+
+	struct CaptureReplayStats
+	{
+		static constexpr std::size_t kCommandTypeCount = static_cast<std::size_t>(CommandType::Count);
+
+		std::uint64_t resourcesCreated{ 0 };
+		std::uint64_t bufferUpdates{ 0 };
+		std::uint64_t uploadBytes{ 0 };
+		std::uint64_t submits{ 0 };
+		std::uint64_t commands{ 0 };
+		std::uint64_t draws{ 0 };
+		std::uint64_t instances{ 0 };
+		std::uint64_t removedCommands{ 0 };
+		double pipelineCreateMs{ 0.0 }; // CreateShader + CreatePipeline replay; warm vs cold pipeline cache
+		std::array<std::uint64_t, kCommandTypeCount> commandCounts{};
+		std::array<std::uint64_t, kCommandTypeCount> commandNanoseconds{};       // replay decode + re-encode (timeCommandTypes)
+		std::array<std::uint64_t, kCommandTypeCount> targetCommandNanoseconds{}; // target submit time (timeTargetCommandTypes)
+		std::vector<CaptureSubmitStats> perSubmit;
+
+		std::uint64_t CountOf(CommandType type) const noexcept
+		{
+			return commandCounts[static_cast<std::size_t>(type)];
+		}
+	};
+
+	class CaptureReplayer
+	{
+	public:
+		explicit CaptureReplayer(std::vector<std::byte> bytes) : bytes_(std::move(bytes))
+		{
+			CaptureReader reader(bytes_);
+			const auto header = reader.Read<CaptureFileHeader>();
+			const CaptureFileHeader expected{};
+			if (header.magic != expected.magic)
+			{
+				throw std::runtime_error("RHI capture: bad magic");
+			}
+			if (header.version != expected.version)
+			{
+				throw std::runtime_error("RHI capture: unsupported version");
+			}
+			if (header.layoutFingerprint != CommandLayoutFingerprint())
+			{
+				throw std::runtime_error("RHI capture: command layout mismatch (captured by an incompatible build)");
+			}
+		}
+
+		static CaptureReplayer FromFile(const std::filesystem::path& path)
+		{
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			if (!file)
+			{
+				throw std::runtime_error("CaptureReplayer: failed to open capture file: " + path.string());
+			}
+			const auto size = static_cast<std::size_t>(file.tellg());
+			std::vector<std::byte> bytes(size);
+			file.seekg(0);
+			file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(size));
+			return CaptureReplayer(std::move(bytes));
+		}
+
+		CaptureReplayStats Replay(IRHIDevice& target, IRHISwapChain& swapChain, CaptureReplayOptions options = {})
+		{
+			ResetMaps();
+
+			CaptureReplayStats stats{};
+			std::uint64_t pendingUploadBytes = 0;
+
+			CaptureReader reader(bytes_);
+			reader.Read<CaptureFileHeader>();
+
+			while (!reader.AtEnd())
+			{
+				const auto op = reader.Read<CaptureOp>();
+				const auto payloadBytes = reader.Read<std::uint32_t>();
+				CaptureReader payload(reader.Take(payloadBytes));
+
+				switch (op)
+				{
+				case CaptureOp::CreateTexture2D:
+				case CaptureOp::CreateTextureCube:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto extent = payload.Read<Extent2D>();
+					const auto format = payload.Read<Format>();
+					const TextureHandle texture = (op == CaptureOp::CreateTexture2D)
+						? target.CreateTexture2D(extent, format)
+						: target.CreateTextureCube(extent, format);
+					textures_[id] = texture.id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::DestroyTexture:
+					target.DestroyTexture(Take<TextureHandle>(textures_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::CreateFramebuffer:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto color = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					const auto depth = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					framebuffers_[id] = target.CreateFramebuffer(color, depth).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::CreateFramebufferMRT:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto depth = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					const auto colorBytes = payload.ReadBytes();
+					std::vector<TextureHandle> colors(colorBytes.size() / sizeof(TextureHandle));
+					std::memcpy(colors.data(), colorBytes.data(), colors.size() * sizeof(TextureHandle));
+					for (TextureHandle& color : colors)
+					{
+						color = Map<TextureHandle>(textures_, color.id);
+					}
+					framebuffers_[id] = target.CreateFramebufferMRT(colors, depth).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::CreateFramebufferCubeFace:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto color = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					const auto face = payload.Read<std::uint32_t>();
+					const auto depth = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					framebuffers_[id] = target.CreateFramebufferCubeFace(color, face, depth).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::CreateFramebufferCubeFaceMip:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto color = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					const auto face = payload.Read<std::uint32_t>();
+					const auto mip = payload.Read<std::uint32_t>();
+					const auto depth = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					framebuffers_[id] = target.CreateFramebufferCubeFaceMip(color, face, mip, depth).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::CreateFramebufferCube:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto color = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					const auto depth = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					framebuffers_[id] = target.CreateFramebufferCube(color, depth).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::DestroyFramebuffer:
+					target.DestroyFramebuffer(Take<FrameBufferHandle>(framebuffers_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::CreateBuffer:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					BufferDesc desc{};
+					desc.bindFlag = payload.Read<BufferBindFlag>();
+					desc.usageFlag = payload.Read<BufferUsageFlag>();
+					desc.sizeInBytes = static_cast<std::size_t>(payload.Read<std::uint64_t>());
+					desc.structuredStrideBytes = payload.Read<std::uint32_t>();
+					desc.debugName = std::string(payload.ReadString());
+					buffers_[id] = target.CreateBuffer(desc).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::UpdateBuffer:
+				{
+					const auto buffer = Map<BufferHandle>(buffers_, payload.Read<std::uint32_t>());
+					const auto offset = payload.Read<std::uint64_t>();
+					const auto data = payload.ReadBytes();
+					target.UpdateBuffer(buffer, data, static_cast<std::size_t>(offset));
+					++stats.bufferUpdates;
+					stats.uploadBytes += data.size();
+					pendingUploadBytes += data.size();
+					break;
+				}
+				case CaptureOp::DestroyBuffer:
+					target.DestroyBuffer(Take<BufferHandle>(buffers_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::CreateInputLayout:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					InputLayoutDesc desc{};
+					desc.strideBytes = payload.Read<std::uint32_t>();
+					const auto attributeBytes = payload.ReadBytes();
+					desc.attributes.resize(attributeBytes.size() / sizeof(VertexAttributeDesc));
+					std::memcpy(desc.attributes.data(), attributeBytes.data(), desc.attributes.size() * sizeof(VertexAttributeDesc));
+					desc.debugName = std::string(payload.ReadString());
+					layouts_[id] = target.CreateInputLayout(desc).id;
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::DestroyInputLayout:
+					target.DestroyInputLayout(Take<InputLayoutHandle>(layouts_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::CreateShader:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto stage = payload.Read<ShaderStage>();
+					const auto shaderModel = payload.Read<ShaderModel>();
+					const auto debugName = payload.ReadString();
+					const auto source = payload.ReadString();
+					const auto start = std::chrono::steady_clock::now();
+					shaders_[id] = target.CreateShaderEx(stage, debugName, source, shaderModel).id;
+					stats.pipelineCreateMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::DestroyShader:
+					target.DestroyShader(Take<ShaderHandle>(shaders_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::CreatePipeline:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto vs = Map<ShaderHandle>(shaders_, payload.Read<std::uint32_t>());
+					const auto ps = Map<ShaderHandle>(shaders_, payload.Read<std::uint32_t>());
+					const auto topologyType = payload.Read<PrimitiveTopologyType>();
+					const auto viewInstanceCount = payload.Read<std::uint32_t>();
+					const auto debugName = payload.ReadString();
+					const auto start = std::chrono::steady_clock::now();
+					pipelines_[id] = target.CreatePipelineEx(debugName, vs, ps, topologyType, viewInstanceCount).id;
+					stats.pipelineCreateMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+					++stats.resourcesCreated;
+					break;
+				}
+				case CaptureOp::DestroyPipeline:
+					target.DestroyPipeline(Take<PipelineHandle>(pipelines_, payload.Read<std::uint32_t>()));
+					break;
+
+				case CaptureOp::SubmitCommandList:
+				{
+					payload.Read<std::uint64_t>(); // recorded command count (informational)
+					CaptureSubmitStats submit = ReplayCommandStream(payload.ReadBytes(), swapChain, stats, options);
+					submit.uploadBytes = pendingUploadBytes;
+					pendingUploadBytes = 0;
+
+					CommandList* submitList = &replayList_;
+					if (options.optimizeCommandLists)
+					{
+						submit.removedCommands = OptimizeCommandList(replayList_, optimizedList_).RemovedCommands();
+						stats.removedCommands += submit.removedCommands;
+						submitList = &optimizedList_;
+					}
+
+					if (options.timeTargetCommandTypes)
+					{
+						SubmitPerCommandType(target, *submitList, stats, submit);
+					}
+					else
+					{
+						const auto start = std::chrono::steady_clock::now();
+						target.SubmitCommandList(std::move(*submitList));
+						const auto end = std::chrono::steady_clock::now();
+						submit.submitMs = std::chrono::duration<double, std::milli>(end - start).count();
+					}
+
+					++stats.submits;
+					stats.perSubmit.push_back(submit);
+					break;
+				}
+
+				case CaptureOp::AllocateTextureDescriptor:
+				{
+					const auto index = payload.Read<TextureDescIndex>();
+					const auto texture = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					descriptors_[index] = target.AllocateTextureDesctiptor(texture);
+					break;
+				}
+				case CaptureOp::UpdateTextureDescriptor:
+				{
+					const auto index = payload.Read<TextureDescIndex>();
+					const auto texture = Map<TextureHandle>(textures_, payload.Read<std::uint32_t>());
+					target.UpdateTextureDescriptor(MapIndex(descriptors_, index), texture);
+					break;
+				}
+				case CaptureOp::FreeTextureDescriptor:
+				{
+					const auto index = payload.Read<TextureDescIndex>();
+					target.FreeTextureDescriptor(MapIndex(descriptors_, index));
+					descriptors_.erase(index);
+					break;
+				}
+				case CaptureOp::ReserveTextureDescriptorRange:
+				{
+					const auto first = payload.Read<TextureDescIndex>();
+					const auto count = payload.Read<std::uint32_t>();
+					const TextureDescIndex mappedFirst = target.ReserveTextureDescriptorRange(count);
+					for (std::uint32_t i = 0; i < count; ++i)
+					{
+						descriptors_[first + i] = mappedFirst + i;
+					}
+					break;
+				}
+				case CaptureOp::ReleaseTextureDescriptorRange:
+				{
+					const auto first = payload.Read<TextureDescIndex>();
+					const auto count = payload.Read<std::uint32_t>();
+					target.ReleaseTextureDescriptorRange(MapIndex(descriptors_, first), count);
+					for (std::uint32_t i = 0; i < count; ++i)
+					{
+						descriptors_.erase(first + i);
+					}
+					break;
+				}
+
+				case CaptureOp::CreateFence:
+				{
+					const auto id = payload.Read<std::uint32_t>();
+					const auto signaled = payload.Read<bool>();
+					fences_[id] = target.CreateFence(signaled).id;
+					break;
+				}
+				case CaptureOp::DestroyFence:
+					target.DestroyFence(Take<FenceHandle>(fences_, payload.Read<std::uint32_t>()));
+					break;
+				case CaptureOp::SignalFence:
+					target.SignalFence(Map<FenceHandle>(fences_, payload.Read<std::uint32_t>()));
+					break;
+				case CaptureOp::WaitFence:
+					target.WaitFence(Map<FenceHandle>(fences_, payload.Read<std::uint32_t>()));
+					break;
+				case CaptureOp::SignalTimeline:
+				{
+					const auto value = payload.Read<std::uint64_t>();
+					timelineValues_[value] = target.SignalTimeline();
+					break;
+				}
+				case CaptureOp::WaitTimelineValue:
+				{
+					// Values are per device; wait for the one the replay signaled in place of the captured one.
+					if (auto it = timelineValues_.find(payload.Read<std::uint64_t>()); it != timelineValues_.end())
+					{
+						target.WaitTimelineValue(it->second);
+					}
+					break;
+				}
+
+				default:
+					// Unknown record (newer producer): the size prefix lets us skip it.
+					break;
+				}
+			}
+
+			return stats;
+		}
+
+	private:
+		using IdMap = std::unordered_map<std::uint32_t, std::uint32_t>;
+
+		template <typename HandleT>
+		static HandleT Map(const IdMap& map, std::uint32_t capturedId)
+		{
+			HandleT handle{};
+			if (auto it = map.find(capturedId); it != map.end())
+			{
+				handle.id = it->second;
+			}
+			return handle;
+		}
+
+		template <typename HandleT>
+		static HandleT Take(IdMap& map, std::uint32_t capturedId)
+		{
+			const HandleT handle = Map<HandleT>(map, capturedId);
+			map.erase(capturedId);
+			return handle;
+		}
+
+		static TextureDescIndex MapIndex(const IdMap& map, TextureDescIndex capturedIndex)
+		{
+			if (auto it = map.find(capturedIndex); it != map.end())
+			{
+				return it->second;
+			}
+			return 0;
+		}
+
+		void ResetMaps()
+		{
+			textures_.clear();
+			buffers_.clear();
+			shaders_.clear();
+			pipelines_.clear();
+			framebuffers_.clear();
+			layouts_.clear();
+			fences_.clear();
+			descriptors_.clear();
+			timelineValues_.clear();
+		}
+
+		// Decodes a captured stream and re-encodes it into replayList_ with handles translated to the target device.
+		CaptureSubmitStats ReplayCommandStream(
+			std::span<const std::byte> recordBytes,
+			IRHISwapChain& swapChain,
+			CaptureReplayStats& stats,
+			const CaptureReplayOptions& options)
+		{
+			// Copy into an arena so payloads get the alignment they were recorded with.
+			streamArena_.Reset();
+			std::byte* records = streamArena_.Allocate(recordBytes.size());
+			if (!recordBytes.empty())
+			{
+				std::memcpy(records, recordBytes.data(), recordBytes.size());
+			}
+			ValidateRecords(records, recordBytes.size());
+
+			replayList_.Reset();
+			CaptureSubmitStats submit{};
+
+			const CommandIterator end(records + recordBytes.size());
+			for (CommandIterator it(records); it != end; ++it)
+			{
+				const CommandRecord record = *it;
+				const auto typeIndex = static_cast<std::size_t>(record.Type());
+				if (options.onCommand)
+				{
+					options.onCommand(record);
+				}
+				const auto start = options.timeCommandTypes ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+				VisitCommand(record, [&]<typename T>(const T& cmd)
+					{
+						ReEmit(cmd, swapChain, submit);
+					});
+
+				if (options.timeCommandTypes)
+				{
+					const auto elapsed = std::chrono::steady_clock::now() - start;
+					stats.commandNanoseconds[typeIndex] += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+				}
+				++stats.commandCounts[typeIndex];
+				++submit.commands;
+			}
+
+			stats.commands += submit.commands;
+			stats.draws += submit.draws;
+			stats.instances += submit.instances;
+			return submit;
+		}
+
+		// Submits `list` as consecutive runs of one command type and charges each run's submit time to its type.
+		void SubmitPerCommandType(IRHIDevice& target, const CommandList& list, CaptureReplayStats& stats, CaptureSubmitStats& submit)
+		{
+			const auto SubmitRun = [&](CommandType type)
+				{
+					const auto start = std::chrono::steady_clock::now();
+					target.SubmitCommandList(std::move(runList_));
+					const auto elapsed = std::chrono::steady_clock::now() - start;
+					stats.targetCommandNanoseconds[static_cast<std::size_t>(type)] += static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+					submit.submitMs += std::chrono::duration<double, std::milli>(elapsed).count();
+					++submit.targetRuns;
+					runList_.Reset();
+				};
+
+			runList_.Reset();
+			CommandType runType{};
+			for (const CommandRecord& record : list)
+			{
+				if (!runList_.Empty() && record.Type() != runType)
+				{
+					SubmitRun(runType);
+				}
+				runType = record.Type();
+				runList_.AppendRecord(record);
+			}
+			if (!runList_.Empty())
+			{
+				SubmitRun(runType);
+			}
+		}
+
+		// Replay reads payloads and tails in place, so every record must hold its fixed payload, and
+		// SetConstants / TransitionTextures the tail their count claims, before anything is decoded.
+		static void ValidateRecords(const std::byte* records, std::size_t size)
+		{
+			std::size_t offset = 0;
+			while (offset < size)
+			{
+				if (size - offset < sizeof(CommandHeader))
+				{
+					throw std::runtime_error("RHI capture: truncated command record");
+				}
+				CommandHeader header{};
+				std::memcpy(&header, records + offset, sizeof(header));
+				if (header.type >= CommandType::Count || header.sizeBytes < sizeof(CommandHeader) || header.sizeBytes > size - offset
+					|| header.sizeBytes % kCommandRecordAlignment != 0 || header.payloadOffset < sizeof(CommandHeader))
+				{
+					throw std::runtime_error("RHI capture: corrupt command record");
+				}
+				ValidatePayload(records + offset, header);
+				offset += header.sizeBytes;
+			}
+		}
+
+		// Returns the bytes left after the fixed payload `T` of a record.
+		template <typename T>
+		static std::size_t CheckPayload(const CommandHeader& header)
+		{
+			if (header.payloadOffset % alignof(T) != 0 || std::size_t{ header.payloadOffset } + sizeof(T) > header.sizeBytes)
+			{
+				throw std::runtime_error("RHI capture: command payload out of bounds");
+			}
+			return header.sizeBytes - header.payloadOffset - sizeof(T);
+		}
+
+		static void ValidatePayload(const std::byte* record, const CommandHeader& header)
+		{
+			switch (header.type)
+			{
+			case CommandType::BeginPass: CheckPayload<CommandBeginPass>(header); break;
+			case CommandType::EndPass: CheckPayload<CommandEndPass>(header); break;
+			case CommandType::SetViewport: CheckPayload<CommandSetViewport>(header); break;
+			case CommandType::SetState: CheckPayload<CommandSetState>(header); break;
+			case CommandType::SetStencilRef: CheckPayload<CommandSetStencilRef>(header); break;
+			case CommandType::SetPrimitiveTopology: CheckPayload<CommandSetPrimitiveTopology>(header); break;
+			case CommandType::BindPipeline: CheckPayload<CommandBindPipeline>(header); break;
+			case CommandType::BindInputLayout: CheckPayload<CommandBindInputLayout>(header); break;
+			case CommandType::BindVertexBuffer: CheckPayload<CommandBindVertexBuffer>(header); break;
+			case CommandType::BindIndexBuffer: CheckPayload<CommandBindIndexBuffer>(header); break;
+			case CommandType::BindTexture2D: CheckPayload<CommnadBindTexture2D>(header); break;
+			case CommandType::BindTextureCube: CheckPayload<CommandBindTextureCube>(header); break;
+			case CommandType::BindTextureDesc: CheckPayload<CommandTextureDesc>(header); break;
+			case CommandType::BindStructuredBufferSRV: CheckPayload<CommandBindStructuredBufferSRV>(header); break;
+			case CommandType::SetUniformInt: CheckPayload<CommandSetUniformInt>(header); break;
+			case CommandType::SetUniformFloat4: CheckPayload<CommandUniformFloat4>(header); break;
+			case CommandType::SetUniformMat4: CheckPayload<CommandUniformMat4>(header); break;
+			case CommandType::DX12ImGuiRender: CheckPayload<CommandDX12ImGuiRender>(header); break;
+			case CommandType::DrawIndexed: CheckPayload<CommandDrawIndexed>(header); break;
+			case CommandType::Draw: CheckPayload<CommandDraw>(header); break;
+			case CommandType::DrawIndexedIndirect: CheckPayload<CommandDrawIndexedIndirect>(header); break;
+			case CommandType::BindTexture2DArray: CheckPayload<CommandBindTexture2DArray>(header); break;
+			case CommandType::SetConstants:
+			{
+				const std::size_t tailBytes = CheckPayload<detail::SetConstantsRecord>(header);
+				detail::SetConstantsRecord rec{};
+				std::memcpy(&rec, record + header.payloadOffset, sizeof(rec));
+				if (rec.size > CommandList::kMaxConstantsBytes || rec.size > tailBytes)
+				{
+					throw std::runtime_error("RHI capture: corrupt SetConstants record");
+				}
+				break;
+			}
+			case CommandType::TransitionTextures:
+			{
+				const std::size_t tailBytes = CheckPayload<detail::TransitionTexturesRecord>(header);
+				detail::TransitionTexturesRecord rec{};
+				std::memcpy(&rec, record + header.payloadOffset, sizeof(rec));
+				const std::size_t barriersOffset = header.payloadOffset + sizeof(rec);
+				if (barriersOffset % alignof(TextureBarrier) != 0 || rec.count > tailBytes / sizeof(TextureBarrier))
+				{
+					throw std::runtime_error("RHI capture: corrupt TransitionTextures record");
+				}
+				break;
+			}
+			default:
+				throw std::runtime_error("RHI capture: corrupt command record");
+			}
+		}
+
+		template <typename T>
+		void ReEmit(const T& cmd, IRHISwapChain& swapChain, CaptureSubmitStats& submit)
+		{
+			CommandList& out = replayList_;
+			if constexpr (std::is_same_v<T, CommandBeginPass>)
+			{
+				BeginPassDesc desc = cmd.desc;
+				desc.frameBuffer = Map<FrameBufferHandle>(framebuffers_, cmd.desc.frameBuffer.id);
+				desc.swapChain = (cmd.desc.frameBuffer.id == 0) ? &swapChain : nullptr;
+				out.BeginPass(desc);
+			}
+			else if constexpr (std::is_same_v<T, CommandEndPass>) { out.EndPass(); }
+			else if constexpr (std::is_same_v<T, CommandSetViewport>) { out.SetViewport(cmd.x, cmd.y, cmd.width, cmd.height); }
+			else if constexpr (std::is_same_v<T, CommandSetState>) { out.SetState(cmd.state); }
+			else if constexpr (std::is_same_v<T, CommandSetStencilRef>) { out.SetStencilRef(cmd.ref); }
+			else if constexpr (std::is_same_v<T, CommandSetPrimitiveTopology>) { out.SetPrimitiveTopology(cmd.topology); }
+			else if constexpr (std::is_same_v<T, CommandBindPipeline>) { out.BindPipeline(Map<PipelineHandle>(pipelines_, cmd.pso.id)); }
+			else if constexpr (std::is_same_v<T, CommandBindInputLayout>) { out.BindInputLayout(Map<InputLayoutHandle>(layouts_, cmd.layout.id)); }
+			else if constexpr (std::is_same_v<T, CommandBindVertexBuffer>)
+			{
+				out.BindVertexBuffer(cmd.slot, Map<BufferHandle>(buffers_, cmd.buffer.id), cmd.strideBytes, cmd.offsetBytes);
+			}
+			else if constexpr (std::is_same_v<T, CommandBindIndexBuffer>)
+			{
+				out.BindIndexBuffer(Map<BufferHandle>(buffers_, cmd.buffer.id), cmd.indexType, cmd.offsetBytes);
+			}
+			else if constexpr (std::is_same_v<T, CommnadBindTexture2D>) { out.BindTexture2D(cmd.slot, Map<TextureHandle>(textures_, cmd.texture.id)); }
+			else if constexpr (std::is_same_v<T, CommandBindTextureCube>) { out.BindTextureCube(cmd.slot, Map<TextureHandle>(textures_, cmd.texture.id)); }
+			else if constexpr (std::is_same_v<T, CommandBindTexture2DArray>) { out.BindTexture2DArray(cmd.slot, Map<TextureHandle>(textures_, cmd.texture.id)); }
+			else if constexpr (std::is_same_v<T, CommandTextureDesc>) { out.BindTextureDesc(cmd.slot, MapIndex(descriptors_, cmd.texture)); }
+			else if constexpr (std::is_same_v<T, CommandBindStructuredBufferSRV>) { out.BindStructuredBufferSRV(cmd.slot, Map<BufferHandle>(buffers_, cmd.buffer.id)); }
+			else if constexpr (std::is_same_v<T, CommandSetUniformInt>) { out.SetUniformInt(cmd.id, cmd.value); }
+			else if constexpr (std::is_same_v<T, CommandUniformFloat4>) { out.SetUniformFloat4(cmd.id, cmd.value); }
+			else if constexpr (std::is_same_v<T, CommandUniformMat4>) { out.SetUniformMat4(cmd.id, cmd.value); }
+			else if constexpr (std::is_same_v<T, CommandSetConstants>) { out.SetConstants(cmd.slot, cmd.data); }
+			else if constexpr (std::is_same_v<T, CommandTransitionTextures>)
+			{
+				barrierScratch_.assign(cmd.barriers.begin(), cmd.barriers.end());
+				for (TextureBarrier& barrier : barrierScratch_)
+				{
+					barrier.texture = Map<TextureHandle>(textures_, barrier.texture.id);
+				}
+				out.TransitionTextures(barrierScratch_);
+			}
+			else if constexpr (std::is_same_v<T, CommandDrawIndexed>)
+			{
+				out.DrawIndexed(cmd.indexCount, cmd.indexType, cmd.firstIndex, cmd.baseVertex, cmd.instanceCount, cmd.firstInstance);
+				++submit.draws;
+				submit.instances += cmd.instanceCount;
+			}
+			else if constexpr (std::is_same_v<T, CommandDraw>)
+			{
+				out.Draw(cmd.vertexCount, cmd.firstVertex, cmd.instanceCount, cmd.firstInstance);
+				++submit.draws;
+				submit.instances += cmd.instanceCount;
+			}
+			else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+			{
+				// Instance counts live in the argument buffer; only the draw records are counted here.
+				out.MultiDrawIndexedIndirect(cmd.indexType, Map<BufferHandle>(buffers_, cmd.argsBuffer.id), cmd.drawCount, cmd.argsOffsetBytes, cmd.strideBytes);
+				submit.draws += cmd.drawCount;
+			}
+			else
+			{
+				// CommandDX12ImGuiRender: the captured ImDrawData pointer is meaningless after capture.
+			}
+		}
+
+		std::vector<std::byte> bytes_;
+
+		IdMap textures_;
+		IdMap buffers_;
+		IdMap shaders_;
+		IdMap pipelines_;
+		IdMap framebuffers_;
+		IdMap layouts_;
+		IdMap fences_;
+		IdMap descriptors_;
+		std::unordered_map<std::uint64_t, std::uint64_t> timelineValues_;
+
+		CommandArena streamArena_;
+		CommandList replayList_;
+		CommandList optimizedList_;
+		CommandList runList_;
+		std::vector<TextureBarrier> barrierScratch_;
+	};
+}
@@ -0,0 +1,771 @@
+module;
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+export module core:rhi_validation;
+
+import :rhi;
+
+// Validation layer for RHI traffic.
+//
+// ValidationDevice decorates any IRHIDevice, mirrors the lifetime of every object created through it and
+// walks each submitted command list once before forwarding it. Misuse that backends would turn into a
+// crash or silent misrendering (stale handles, unbalanced passes, draws without a pipeline/input layout,
+// index or vertex ranges past the end of their buffers, out-of-range buffer updates) throws
+// std::runtime_error naming the offending command. The same walk gathers per-frame and per-pass
+// statistics; a frame closes on SignalTimeline(), which FrameSync calls once per frame.
+//
+// The walk is a single linear pass over the arena plus hash lookups for bound handles, so the layer is
+// meant to stay enabled in staging builds. Objects created before the decorator was installed are unknown
+// to it and are reported as stale.
+
+export namespace rhi
+{
+	struct ValidationPassStats
+	{
+		FrameBufferHandle frameBuffer{}; // 0 = swapchain backbuffer
+		Extent2D extent{};
+		std::uint64_t draws{ 0 };
+		std::uint64_t instances{ 0 };
+		std::uint64_t triangles{ 0 };
+		std::uint64_t stateChanges{ 0 };
+	};
+
+	struct ValidationFrameStats
+	{
+		std::uint64_t frameIndex{ 0 };
+		std::uint64_t commandLists{ 0 };
+		std::uint64_t commands{ 0 };
+		std::uint64_t draws{ 0 };         // direct draws plus records consumed by indirect draws
+		std::uint64_t indirectDraws{ 0 }; // indirect records (their instances/triangles live on the GPU and are not counted)
+		std::uint64_t instances{ 0 };
+		std::uint64_t triangles{ 0 };
+		std::uint64_t stateChanges{ 0 };          // pipeline/state/layout/topology/stencil/viewport/VB/IB binds
+		std::uint64_t redundantStateChanges{ 0 }; // binds that did not change the bound value
+		std::uint64_t bytesUploaded{ 0 };         // UpdateBuffer / UpdateBufferInPlace
+		std::uint64_t constantBytes{ 0 };         // SetConstants payloads
+		std::uint64_t invalidDestroys{ 0 };       // Destroy* of unknown or already destroyed handles (not forwarded)
+		std::vector<ValidationPassStats> passes;
+	};
+
+	namespace detail
+	{
+		constexpr std::string_view CommandTypeName(CommandType type) noexcept
+		{
+			constexpr std::array<std::string_view, static_cast<std::size_t>(CommandType::Count)> kNames{
+				"BeginPass", "EndPass", "SetViewport", "SetState", "SetStencilRef", "SetPrimitiveTopology",
+				"BindPipeline", "BindInputLayout", "BindVertexBuffer", "BindIndexBuffer", "BindTexture2D",
+				"BindTextureCube", "BindTextureDesc", "BindStructuredBufferSRV", "SetUniformInt", "SetUniformFloat4",
+				"SetUniformMat4", "SetConstants", "DX12ImGuiRender", "DrawIndexed", "Draw", "BindTexture2DArray",
+				"TransitionTextures", "DrawIndexedIndirect" };
+			const auto index = static_cast<std::size_t>(type);
+			return index < kNames.size() ? kNames[index] : std::string_view{ "Unknown" };
+		}
+	}
+
+	class ValidationDevice final : public IRHIDevice
+	{
+	public:
+		explicit ValidationDevice(IRHIDevice& inner) : inner_(inner) {}
+
+		Backend GetBackend() const noexcept override { return inner_.GetBackend(); }
+		std::string_view GetName() const override { return "Validation RHI Device"; }
+		std::uint32_t GetFramesInFlight() const noexcept override { return inner_.GetFramesInFlight(); }
+
+		void InitImGui(void* hwnd, int framesInFlight, Format rtvFormat) override { inner_.InitImGui(hwnd, framesInFlight, rtvFormat); }
+		void ImGuiNewFrame() override { inner_.ImGuiNewFrame(); }
+		void ShutdownImGui() override { inner_.ShutdownImGui(); }
+		void WaitIdle() override { inner_.WaitIdle(); }
+
+		// Textures
+		TextureHandle CreateTexture2D(Extent2D extent, Format format) override
+		{
+			const TextureHandle texture = inner_.CreateTexture2D(extent, format);
+			textures_.insert(texture.id);
+			return texture;
+		}
+		TextureHandle CreateTextureCube(Extent2D extent, Format format) override
+		{
+			const TextureHandle texture = inner_.CreateTextureCube(extent, format);
+			textures_.insert(texture.id);
+			return texture;
+		}
+		void DestroyTexture(TextureHandle texture) noexcept override
+		{
+			if (Release(textures_, texture.id))
+			{
+				inner_.DestroyTexture(texture);
+			}
+		}
+
+		// Framebuffers
+		FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) override
+		{
+			RequireTexture(color, "CreateFramebuffer");
+			RequireTexture(depth, "CreateFramebuffer");
+			return TrackFramebuffer(inner_.CreateFramebuffer(color, depth));
+		}
+		FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth) override
+		{
+			for (const TextureHandle color : colors)
+			{
+				RequireTexture(color, "CreateFramebufferMRT");
+			}
+			RequireTexture(depth, "CreateFramebufferMRT");
+			return TrackFramebuffer(inner_.CreateFramebufferMRT(colors, depth));
+		}
+		FrameBufferHandle CreateFramebufferCubeFace(TextureHandle colorCube, std::uint32_t faceIndex, TextureHandle depth) override
+		{
+			RequireTexture(colorCube, "CreateFramebufferCubeFace");
+			RequireTexture(depth, "CreateFramebufferCubeFace");
+			if (faceIndex >= 6)
+			{
+				throw std::runtime_error("ValidationDevice: CreateFramebufferCubeFace: face index out of range");
+			}
+			return TrackFramebuffer(inner_.CreateFramebufferCubeFace(colorCube, faceIndex, depth));
+		}
+		FrameBufferHandle CreateFramebufferCubeFaceMip(TextureHandle colorCube, std::uint32_t faceIndex, std::uint32_t mipLevel, TextureHandle depth) override
+		{
+			RequireTexture(colorCube, "CreateFramebufferCubeFaceMip");
+			RequireTexture(depth, "CreateFramebufferCubeFaceMip");
+			if (faceIndex >= 6)
+			{
+				throw std::runtime_error("ValidationDevice: CreateFramebufferCubeFaceMip: face index out of range");
+			}
+			return TrackFramebuffer(inner_.CreateFramebufferCubeFaceMip(colorCube, faceIndex, mipLevel, depth));
+		}
+		FrameBufferHandle CreateFramebufferCube(TextureHandle colorCube, TextureHandle depthCube) override
+		{
+			RequireTexture(colorCube, "CreateFramebufferCube");
+			RequireTexture(depthCube, "CreateFramebufferCube");
+			return TrackFramebuffer(inner_.CreateFramebufferCube(colorCube, depthCube));
+		}
+		void DestroyFramebuffer(FrameBufferHandle frameBuffer) noexcept override
+		{
+			if (Release(frameBuffers_, frameBuffer.id))
+			{
+				inner_.DestroyFramebuffer(frameBuffer);
+			}
+		}
+
+		// Buffers
+		BufferHandle CreateBuffer(const BufferDesc& desc) override
+		{
+			const BufferHandle buffer = inner_.CreateBuffer(desc);
+			buffers_[buffer.id] = TrackedBuffer{ desc.bindFlag, desc.sizeInBytes };
+			indirectValidator_.OnCreateBuffer(buffer, desc);
+			return buffer;
+		}
+		void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+		{
+			ValidateUpdate(buffer, data, offsetBytes, "UpdateBuffer");
+			inner_.UpdateBuffer(buffer, data, offsetBytes);
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+			current_.bytesUploaded += data.size();
+		}
+		void UpdateBufferInPlace(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+		{
+			ValidateUpdate(buffer, data, offsetBytes, "UpdateBufferInPlace");
+			inner_.UpdateBufferInPlace(buffer, data, offsetBytes);
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+			current_.bytesUploaded += data.size();
+		}
+		void DestroyBuffer(BufferHandle buffer) noexcept override
+		{
+			if (buffers_.erase(buffer.id) == 0)
+			{
+				current_.invalidDestroys += buffer ? 1u : 0u;
+				return;
+			}
+			indirectValidator_.OnDestroyBuffer(buffer);
+			inner_.DestroyBuffer(buffer);
+		}
+
+		// Input layouts
+		InputLayoutHandle CreateInputLayout(const InputLayoutDesc& desc) override
+		{
+			const InputLayoutHandle layout = inner_.CreateInputLayout(desc);
+			layouts_.insert(layout.id);
+			return layout;
+		}
+		void DestroyInputLayout(InputLayoutHandle layout) noexcept override
+		{
+			if (Release(layouts_, layout.id))
+			{
+				inner_.DestroyInputLayout(layout);
+			}
+		}
+
+		// Shaders and pipelines
+		bool SupportsShaderModel6() const override { return inner_.SupportsShaderModel6(); }
+		bool SupportsViewInstancing() const override { return inner_.SupportsViewInstancing(); }
+		bool SupportsVPAndRTArrayIndexFromAnyShader() const override { return inner_.SupportsVPAndRTArrayIndexFromAnyShader(); }
+
+		ShaderHandle CreateShader(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode) override
+		{
+			const ShaderHandle shader = inner_.CreateShader(stage, debugName, sourceOrBytecode);
+			shaders_.insert(shader.id);
+			return shader;
+		}
+		ShaderHandle CreateShaderEx(ShaderStage stage, std::string_view debugName, std::string_view sourceOrBytecode, ShaderModel shaderModel) override
+		{
+			const ShaderHandle shader = inner_.CreateShaderEx(stage, debugName, sourceOrBytecode, shaderModel);
+			shaders_.insert(shader.id);
+			return shader;
+		}
+		void DestroyShader(ShaderHandle shader) noexcept override
+		{
+			if (Release(shaders_, shader.id))
+			{
+				inner_.DestroyShader(shader);
+			}
+		}
+
+		PipelineHandle CreatePipeline(std::string_view debugName, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType = PrimitiveTopologyType::Triangle) override
+		{
+			RequireShaders(vertexShader, pixelShader, "CreatePipeline");
+			const PipelineHandle pipeline = inner_.CreatePipeline(debugName, vertexShader, pixelShader, topologyType);
+			pipelines_.insert(pipeline.id);
+			return pipeline;
+		}
+		PipelineHandle CreatePipelineEx(
+			std::string_view debugName,
+			ShaderHandle vertexShader,
+			ShaderHandle pixelShader,
+			PrimitiveTopologyType topologyType,
+			std::uint32_t viewInstanceCount) override
+		{
+			RequireShaders(vertexShader, pixelShader, "CreatePipelineEx");
+			const PipelineHandle pipeline = inner_.CreatePipelineEx(debugName, vertexShader, pixelShader, topologyType, viewInstanceCount);
+			pipelines_.insert(pipeline.id);
+			return pipeline;
+		}
+		void DestroyPipeline(PipelineHandle pso) noexcept override
+		{
+			if (Release(pipelines_, pso.id))
+			{
+				inner_.DestroyPipeline(pso);
+			}
+		}
+		void SetPipelineCache(PipelineCache* cache) override
+		{
+			inner_.SetPipelineCache(cache);
+		}
+
+		// Submission
+		void SubmitCommandList(CommandList&& commandList) override
+		{
+			Validate(commandList);
+			indirectValidator_.Validate(commandList);
+			inner_.SubmitCommandList(std::move(commandList));
+		}
+
+		// Bindless-style descriptor indices
+		TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) override
+		{
+			RequireTexture(texture, "AllocateTextureDesctiptor");
+			const TextureDescIndex index = inner_.AllocateTextureDesctiptor(texture);
+			descriptors_.insert(index);
+			return index;
+		}
+		void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) override
+		{
+			RequireTexture(texture, "UpdateTextureDescriptor");
+			inner_.UpdateTextureDescriptor(index, texture);
+		}
+		void FreeTextureDescriptor(TextureDescIndex index) noexcept override
+		{
+			if (Release(descriptors_, index))
+			{
+				inner_.FreeTextureDescriptor(index);
+			}
+		}
+		TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+		{
+			const TextureDescIndex first = inner_.ReserveTextureDescriptorRange(count);
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				descriptors_.insert(first + i);
+			}
+			return first;
+		}
+		// Slots already freed on their own count as invalid frees and are not freed again.
+		void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+		{
+			bool allLive = true;
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				allLive = allLive && descriptors_.contains(first + i);
+			}
+			if (allLive)
+			{
+				for (std::uint32_t i = 0; i < count; ++i)
+				{
+					descriptors_.erase(first + i);
+				}
+				inner_.ReleaseTextureDescriptorRange(first, count);
+				return;
+			}
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				FreeTextureDescriptor(first + i);
+			}
+		}
+
+		// Synchronization
+		FenceHandle CreateFence(bool signaled = false) override
+		{
+			const FenceHandle fence = inner_.CreateFence(signaled);
+			fences_.insert(fence.id);
+			return fence;
+		}
+		void DestroyFence(FenceHandle fence) noexcept override
+		{
+			if (Release(fences_, fence.id))
+			{
+				inner_.DestroyFence(fence);
+			}
+		}
+		void SignalFence(FenceHandle fence) override
+		{
+			RequireFence(fence, "SignalFence");
+			inner_.SignalFence(fence);
+		}
+		void WaitFence(FenceHandle fence) override
+		{
+			RequireFence(fence, "WaitFence");
+			inner_.WaitFence(fence);
+		}
+		bool IsFenceSignaled(FenceHandle fence) override
+		{
+			RequireFence(fence, "IsFenceSignaled");
+			return inner_.IsFenceSignaled(fence);
+		}
+		std::uint64_t SignalTimeline() override
+		{
+			const std::uint64_t value = inner_.SignalTimeline();
+			EndFrame();
+			return value;
+		}
+		std::uint64_t GetCompletedTimelineValue() override
+		{
+			return inner_.GetCompletedTimelineValue();
+		}
+		void WaitTimelineValue(std::uint64_t value) override
+		{
+			inner_.WaitTimelineValue(value);
+		}
+
+		// Statistics of the frame being recorded and of the last frame closed by SignalTimeline()/EndFrame().
+		const ValidationFrameStats& GetCurrentFrameStats() const noexcept { return current_; }
+		const ValidationFrameStats& GetLastFrameStats() const noexcept { return last_; }
+		const IndirectDrawStats& GetIndirectDrawStats() const noexcept { return indirectValidator_.GetStats(); }
+
+		// Closes the current frame explicitly (for callers that do not go through FrameSync).
+		void EndFrame()
+		{
+			// Swap instead of copy so the pass vectors keep their capacity across frames.
+			std::swap(last_, current_);
+			const std::uint64_t next = last_.frameIndex + 1;
+			std::vector<ValidationPassStats> passes = std::move(current_.passes);
+			passes.clear();
+			current_ = ValidationFrameStats{};
+			current_.frameIndex = next;
+			current_.passes = std::move(passes);
+		}
+
+	private:
+		struct TrackedBuffer
+		{
+			BufferBindFlag bindFlag{ BufferBindFlag::VertexBuffer };
+			std::size_t sizeInBytes{ 0 };
+		};
+
+		// Bound state while walking one command list; every list starts from scratch like a native command list.
+		struct BoundState
+		{
+			bool inPass{ false };
+			PipelineHandle pipeline{};
+			InputLayoutHandle layout{};
+			std::uint32_t vertexStride{ 0 };
+			std::uint32_t vertexOffset{ 0 };
+			const TrackedBuffer* vertexBuffer{ nullptr };
+			CommandBindIndexBuffer indexBinding{};
+			const TrackedBuffer* indexBuffer{ nullptr };
+			PrimitiveTopology topology{ PrimitiveTopology::TriangleList };
+			bool hasState{ false };
+			GraphicsState state{};
+			bool hasStencilRef{ false };
+			std::uint32_t stencilRef{ 0 };
+			bool hasViewport{ false };
+			CommandSetViewport viewport{};
+		};
+
+		template <typename Set>
+		bool Release(Set& set, std::uint32_t id) noexcept
+		{
+			if (set.erase(id) != 0)
+			{
+				return true;
+			}
+			current_.invalidDestroys += id != 0 ? 1u : 0u;
+			return false;
+		}
+
+		FrameBufferHandle TrackFramebuffer(FrameBufferHandle frameBuffer)
+		{
+			frameBuffers_.insert(frameBuffer.id);
+			return frameBuffer;
+		}
+
+		[[noreturn]] static void Fail(std::string_view where, std::string_view what)
+		{
+			std::string message("ValidationDevice: ");
+			message.append(where).append(": ").append(what);
+			throw std::runtime_error(message);
+		}
+
+		// Null handles are allowed wherever the backends accept "no attachment"/"unbind".
+		void RequireTexture(TextureHandle texture, std::string_view where) const
+		{
+			if (texture && !textures_.contains(texture.id))
+			{
+				Fail(where, "texture handle is unknown or destroyed");
+			}
+		}
+
+		void RequireFence(FenceHandle fence, std::string_view where) const
+		{
+			if (!fences_.contains(fence.id))
+			{
+				Fail(where, "fence handle is unknown or destroyed");
+			}
+		}
+
+		void RequireShaders(ShaderHandle vertexShader, ShaderHandle pixelShader, std::string_view where) const
+		{
+			if (vertexShader && !shaders_.contains(vertexShader.id))
+			{
+				Fail(where, "vertex shader handle is unknown or destroyed");
+			}
+			if (pixelShader && !shaders_.contains(pixelShader.id))
+			{
+				Fail(where, "pixel shader handle is unknown or destroyed");
+			}
+		}
+
+		void ValidateUpdate(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes, std::string_view where) const
+		{
+			const auto it = buffers_.find(buffer.id);
+			if (it == buffers_.end())
+			{
+				Fail(where, "buffer handle is unknown or destroyed");
+			}
+			if (offsetBytes > it->second.sizeInBytes || data.size() > it->second.sizeInBytes - offsetBytes)
+			{
+				Fail(where, "update writes past the end of the buffer");
+			}
+		}
+
+		const TrackedBuffer* FindBuffer(BufferHandle buffer) const noexcept
+		{
+			const auto it = buffers_.find(buffer.id);
+			return it != buffers_.end() ? &it->second : nullptr;
+		}
+
+		void CountStateChange(bool changed) noexcept
+		{
+			++current_.stateChanges;
+			current_.redundantStateChanges += changed ? 0u : 1u;
+			if (!current_.passes.empty() && bound_.inPass)
+			{
+				++current_.passes.back().stateChanges;
+			}
+		}
+
+		void CountDraw(std::uint64_t elementCount, std::uint64_t instanceCount) noexcept
+		{
+			const std::uint64_t triangles = bound_.topology == PrimitiveTopology::TriangleList
+				? (elementCount / 3u) * instanceCount
+				: 0u;
+			++current_.draws;
+			current_.instances += instanceCount;
+			current_.triangles += triangles;
+			ValidationPassStats& pass = current_.passes.back();
+			++pass.draws;
+			pass.instances += instanceCount;
+			pass.triangles += triangles;
+		}
+
+		// Empty when a draw may be issued with the current bindings.
+		std::string_view DrawStateError() const noexcept
+		{
+			if (!bound_.inPass)
+			{
+				return "draw outside of BeginPass/EndPass";
+			}
+			if (!bound_.pipeline)
+			{
+				return "draw without a bound pipeline";
+			}
+			if (!bound_.layout)
+			{
+				return "draw without a bound input layout";
+			}
+			return {};
+		}
+
+		void RequireDrawState(const auto& fail) const
+		{
+			if (const std::string_view error = DrawStateError(); !error.empty())
+			{
+				fail(error);
+			}
+		}
+
+		void Validate(const CommandList& commandList)
+		{
+			bound_ = BoundState{};
+			++current_.commandLists;
+
+			std::size_t commandIndex = 0;
+			std::string where;
+			for (const CommandRecord& record : commandList)
+			{
+				// Names the failing command only on the error path; the success path never formats strings.
+				const auto fail = [&](std::string_view what)
+					{
+						where.assign("command #").append(std::to_string(commandIndex)).append(" (")
+							.append(detail::CommandTypeName(record.Type())).append(")");
+						Fail(where, what);
+					};
+
+				VisitCommand(record, [&]<typename T>(const T& cmd)
+					{
+						if constexpr (std::is_same_v<T, CommandBeginPass>)
+						{
+							if (bound_.inPass)
+							{
+								fail("BeginPass inside another pass (missing EndPass)");
+							}
+							if (cmd.desc.frameBuffer && !frameBuffers_.contains(cmd.desc.frameBuffer.id))
+							{
+								fail("framebuffer handle is unknown or destroyed");
+							}
+							bound_.inPass = true;
+							current_.passes.push_back(ValidationPassStats{ .frameBuffer = cmd.desc.frameBuffer, .extent = cmd.desc.extent });
+						}
+						else if constexpr (std::is_same_v<T, CommandEndPass>)
+						{
+							if (!bound_.inPass)
+							{
+								fail("EndPass without a matching BeginPass");
+							}
+							bound_.inPass = false;
+						}
+						else if constexpr (std::is_same_v<T, CommandSetViewport>)
+						{
+							const bool changed = !bound_.hasViewport || bound_.viewport.x != cmd.x || bound_.viewport.y != cmd.y
+								|| bound_.viewport.width != cmd.width || bound_.viewport.height != cmd.height;
+							bound_.hasViewport = true;
+							bound_.viewport = cmd;
+							CountStateChange(changed);
+						}
+						else if constexpr (std::is_same_v<T, CommandSetState>)
+						{
+							const bool changed = !bound_.hasState || !(bound_.state == cmd.state);
+							bound_.hasState = true;
+							bound_.state = cmd.state;
+							CountStateChange(changed);
+						}
+						else if constexpr (std::is_same_v<T, CommandSetStencilRef>)
+						{
+							const bool changed = !bound_.hasStencilRef || bound_.stencilRef != cmd.ref;
+							bound_.hasStencilRef = true;
+							bound_.stencilRef = cmd.ref;
+							CountStateChange(changed);
+						}
+						else if constexpr (std::is_same_v<T, CommandSetPrimitiveTopology>)
+						{
+							CountStateChange(bound_.topology != cmd.topology);
+							bound_.topology = cmd.topology;
+						}
+						else if constexpr (std::is_same_v<T, CommandBindPipeline>)
+						{
+							if (cmd.pso && !pipelines_.contains(cmd.pso.id))
+							{
+								fail("pipeline handle is unknown or destroyed");
+							}
+							CountStateChange(bound_.pipeline != cmd.pso);
+							bound_.pipeline = cmd.pso;
+						}
+						else if constexpr (std::is_same_v<T, CommandBindInputLayout>)
+						{
+							if (cmd.layout && !layouts_.contains(cmd.layout.id))
+							{
+								fail("input layout handle is unknown or destroyed");
+							}
+							CountStateChange(bound_.layout != cmd.layout);
+							bound_.layout = cmd.layout;
+						}
+						else if constexpr (std::is_same_v<T, CommandBindVertexBuffer>)
+						{
+							const TrackedBuffer* buffer = nullptr;
+							if (cmd.buffer)
+							{
+								buffer = FindBuffer(cmd.buffer);
+								if (buffer == nullptr)
+								{
+									fail("vertex buffer handle is unknown or destroyed");
+								}
+								if (cmd.offsetBytes > buffer->sizeInBytes)
+								{
+									fail("vertex buffer offset is past the end of the buffer");
+								}
+							}
+							// Only slot 0 carries per-vertex data; other slots feed per-instance streams.
+							if (cmd.slot == 0)
+							{
+								CountStateChange(buffer != bound_.vertexBuffer || cmd.strideBytes != bound_.vertexStride || cmd.offsetBytes != bound_.vertexOffset);
+								bound_.vertexBuffer = buffer;
+								bound_.vertexStride = cmd.strideBytes;
+								bound_.vertexOffset = cmd.offsetBytes;
+							}
+							else
+							{
+								CountStateChange(true);
+							}
+						}
+						else if constexpr (std::is_same_v<T, CommandBindIndexBuffer>)
+						{
+							const TrackedBuffer* buffer = nullptr;
+							if (cmd.buffer)
+							{
+								buffer = FindBuffer(cmd.buffer);
+								if (buffer == nullptr)
+								{
+									fail("index buffer handle is unknown or destroyed");
+								}
+								if (cmd.offsetBytes > buffer->sizeInBytes)
+								{
+									fail("index buffer offset is past the end of the buffer");
+								}
+							}
+							CountStateChange(buffer != bound_.indexBuffer || cmd.indexType != bound_.indexBinding.indexType || cmd.offsetBytes != bound_.indexBinding.offsetBytes);
+							bound_.indexBuffer = buffer;
+							bound_.indexBinding = cmd;
+						}
+						else if constexpr (std::is_same_v<T, CommnadBindTexture2D> || std::is_same_v<T, CommandBindTextureCube> || std::is_same_v<T, CommandBindTexture2DArray>)
+						{
+							if (cmd.texture && !textures_.contains(cmd.texture.id))
+							{
+								fail("texture handle is unknown or destroyed");
+							}
+						}
+						else if constexpr (std::is_same_v<T, CommandTextureDesc>)
+						{
+							if (cmd.texture != 0 && !descriptors_.contains(cmd.texture))
+							{
+								fail("texture descriptor index is unknown or freed");
+							}
+						}
+						else if constexpr (std::is_same_v<T, CommandBindStructuredBufferSRV>)
+						{
+							if (cmd.buffer && FindBuffer(cmd.buffer) == nullptr)
+							{
+								fail("structured buffer handle is unknown or destroyed");
+							}
+						}
+						else if constexpr (std::is_same_v<T, CommandSetConstants>)
+						{
+							current_.constantBytes += cmd.size;
+						}
+						else if constexpr (std::is_same_v<T, CommandTransitionTextures>)
+						{
+							for (const TextureBarrier& barrier : cmd.barriers)
+							{
+								if (!textures_.contains(barrier.texture.id))
+								{
+									fail("transition of an unknown or destroyed texture");
+								}
+							}
+						}
+						else if constexpr (std::is_same_v<T, CommandDraw>)
+						{
+							RequireDrawState(fail);
+							if (cmd.vertexCount != 0 && cmd.instanceCount != 0 && bound_.vertexBuffer != nullptr && bound_.vertexStride != 0)
+							{
+								const std::uint64_t end = (static_cast<std::uint64_t>(cmd.firstVertex) + cmd.vertexCount) * bound_.vertexStride + bound_.vertexOffset;
+								if (end > bound_.vertexBuffer->sizeInBytes)
+								{
+									fail("vertex range reads past the end of the bound vertex buffer");
+								}
+							}
+							CountDraw(cmd.vertexCount, cmd.instanceCount);
+						}
+						else if constexpr (std::is_same_v<T, CommandDrawIndexed>)
+						{
+							RequireDrawState(fail);
+							if (bound_.indexBuffer == nullptr)
+							{
+								fail("indexed draw without a bound index buffer");
+							}
+							if (cmd.indexType != bound_.indexBinding.indexType)
+							{
+								fail("index type differs from the bound index buffer");
+							}
+							const std::uint64_t indexSize = (cmd.indexType == IndexType::UINT16) ? 2u : 4u;
+							const std::uint64_t end = (static_cast<std::uint64_t>(cmd.firstIndex) + cmd.indexCount) * indexSize + bound_.indexBinding.offsetBytes;
+							if (cmd.indexCount != 0 && cmd.instanceCount != 0 && end > bound_.indexBuffer->sizeInBytes)
+							{
+								fail("index range reads past the end of the bound index buffer");
+							}
+							CountDraw(cmd.indexCount, cmd.instanceCount);
+						}
+						else if constexpr (std::is_same_v<T, CommandDrawIndexedIndirect>)
+						{
+							// Argument and index ranges are checked by IndirectDrawValidator, which keeps the argument bytes.
+							RequireDrawState(fail);
+							current_.draws += cmd.drawCount;
+							current_.indirectDraws += cmd.drawCount;
+							current_.passes.back().draws += cmd.drawCount;
+						}
+					});
+				++commandIndex;
+			}
+
+			if (bound_.inPass)
+			{
+				Fail("SubmitCommandList", "command list ends inside a pass (missing EndPass)");
+			}
+			current_.commands += commandIndex;
+		}
+
+		IRHIDevice& inner_;
+		IndirectDrawValidator indirectValidator_;
+
+		std::unordered_set<std::uint32_t> textures_;
+		std::unordered_set<std::uint32_t> frameBuffers_;
+		std::unordered_map<std::uint32_t, TrackedBuffer> buffers_;
+		std::unordered_set<std::uint32_t> layouts_;
+		std::unordered_set<std::uint32_t> shaders_;
+		std::unordered_set<std::uint32_t> pipelines_;
+		std::unordered_set<std::uint32_t> fences_;
+		std::unordered_set<TextureDescIndex> descriptors_;
+
+		BoundState bound_{};
+		ValidationFrameStats current_{};
+		ValidationFrameStats last_{};
+	};
+}
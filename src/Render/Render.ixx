@@ -1,13 +1,20 @@
 export module core:render;
 
 export import :rhi;
+export import :rhi_capture;
+export import :rhi_validation;
+export import :rhi_software;
 export import :render_core;
 export import :render_graph;
 export import :render_bindless;
 export import :render_gpu_memory;
 export import :render_renderer;
 export import :scene;
+export import :scene_bvh;
 export import :visibility;
+export import :shadow_caster_culling;
+export import :occlusion_culling;
+export import :clustered_lighting;
 export import :level;
 export import :level_ecs;
 export import :picking;
@@ -18,6 +25,8 @@ export import :editor_rotate_gizmo;
 export import :editor_scale_gizmo;
 export import :shader_system;
 export import :sync;
+export import :draw_queue;
+export import :instance_stream;
 export import :shader_files;
 export import :texture_decoder_stb;
 export import :file_system;
@@ -13,6 +13,9 @@ module;
 #include <condition_variable>
 #include <deque>
 #include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
 
 export module core:render_core;
 
@@ -168,6 +171,43 @@ export namespace rendern
 		std::unordered_map<std::string, rhi::PipelineHandle> psoCache_;
 	};
 
+	// Pipeline cache persistence. Both are best-effort: a missing, foreign or corrupt file is a cold start,
+	// and a failed write only costs the next launch its warm start.
+	bool LoadPipelineCacheFile(rhi::PipelineCache& cache, const std::filesystem::path& path)
+	{
+		std::error_code ec;
+		if (path.empty() || !std::filesystem::is_regular_file(path, ec))
+		{
+			return false;
+		}
+
+		std::ifstream file(path, std::ios::binary);
+		std::vector<std::byte> bytes(static_cast<std::size_t>(std::filesystem::file_size(path, ec)));
+		if (!file || ec || !file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+		{
+			return false;
+		}
+		return cache.Deserialize(bytes);
+	}
+
+	bool SavePipelineCacheFile(rhi::PipelineCache& cache, const std::filesystem::path& path)
+	{
+		if (path.empty() || !cache.IsDirty())
+		{
+			return false;
+		}
+
+		std::error_code ec;
+		if (path.has_parent_path())
+		{
+			std::filesystem::create_directories(path.parent_path(), ec);
+		}
+
+		const std::vector<std::byte> bytes = cache.Serialize();
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		return file && file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
 	class RenderQueueImmediate final : public IRenderQueue
 	{
 	public:
@@ -4,12 +4,23 @@ module;
 #include <string>
 #include <optional>
 #include <span>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <exception>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 export module core:render_graph;
 
 import :rhi;
+import :resource_manager_core;
 
 export namespace renderGraph
 {
@@ -63,6 +74,16 @@ struct RGTextureDesc
 		// If true, color cubemap is rendered as all faces (array layers) in a single pass (e.g. DX12 view-instancing).
 		bool colorCubeAllFaces{ false };
 		rhi::ClearDesc clearDesc{};
+
+		// Graph textures the callback samples through PassContext::resources. Attachments are the pass writes.
+		// Compile() only keeps a pass if something downstream reads what it writes, so every sampled
+		// graph texture must be listed here.
+		std::vector<RGTexture> reads;
+		// Keep the pass even if none of its outputs is consumed (readbacks, GPU timers, ...).
+		bool hasSideEffects{ false };
+		// The callback only records into ctx.commandList and reads state that does not change during
+		// Execute(), so it may run on a job-system worker concurrently with other such passes.
+		bool recordInParallel{ false };
 	};
 
 	class RenderGraphResources
@@ -104,6 +125,429 @@ struct RGTextureDesc
 		PassCallback execute;
 	};
 
+	inline constexpr std::uint32_t kInvalidPassIndex = std::numeric_limits<std::uint32_t>::max();
+
+	// First/last position in CompiledGraph::passOrder that touches a texture (read or attachment).
+	struct ResourceLifetime
+	{
+		std::uint32_t firstUse{ kInvalidPassIndex };
+		std::uint32_t lastUse{ kInvalidPassIndex };
+
+		bool IsUsed() const noexcept { return firstUse != kInvalidPassIndex; }
+	};
+
+	// Planned transition of one graph texture; resolved to an rhi::TextureBarrier at execution.
+	struct RGBarrier
+	{
+		RGTexture texture{};
+		rhi::ResourceState before{ rhi::ResourceState::Unknown };
+		rhi::ResourceState after{ rhi::ResourceState::Unknown };
+	};
+
+	struct CompiledGraph
+	{
+		// Surviving pass indices (into the declared pass list) in execution order.
+		std::vector<std::uint32_t> passOrder;
+		// Per declared pass: 1 if culled.
+		std::vector<std::uint8_t> passCulled;
+		// Per declared pass: passes whose output it consumes (DAG edges, producer -> consumer).
+		std::vector<std::vector<std::uint32_t>> passDependencies;
+		// Per texture, indexed by RGTexture::id.
+		std::vector<ResourceLifetime> textureLifetimes;
+		// Per declared pass: transitions recorded as one batch right before the pass begins.
+		std::vector<std::vector<RGBarrier>> passBarriers;
+
+		std::size_t CulledPassCount() const noexcept { return passCulled.size() - passOrder.size(); }
+
+		std::size_t BarrierCount() const noexcept
+		{
+			std::size_t count = 0;
+			for (const auto& batch : passBarriers)
+			{
+				count += batch.size();
+			}
+			return count;
+		}
+	};
+
+	struct TransientTextureKey
+	{
+		rhi::Extent2D extent{};
+		rhi::Format format{ rhi::Format::Unknown };
+		TextureType type{ TextureType::Tex2D };
+
+		friend bool operator==(const TransientTextureKey& lhs, const TransientTextureKey& rhs) noexcept
+		{
+			return lhs.extent.width == rhs.extent.width
+				&& lhs.extent.height == rhs.extent.height
+				&& lhs.format == rhs.format
+				&& lhs.type == rhs.type;
+		}
+	};
+
+	// Approximate GPU footprint (single mip, no padding); used for pool statistics only.
+	std::uint64_t EstimateTextureBytes(const TransientTextureKey& key) noexcept
+	{
+		std::uint64_t bytesPerPixel = 4;
+		switch (key.format)
+		{
+		case rhi::Format::RGBA16_FLOAT:
+			bytesPerPixel = 8;
+			break;
+		case rhi::Format::Unknown:
+			bytesPerPixel = 0;
+			break;
+		default:
+			break;
+		}
+		const std::uint64_t layers = (key.type == TextureType::Cube) ? 6u : 1u;
+		return static_cast<std::uint64_t>(key.extent.width) * key.extent.height * bytesPerPixel * layers;
+	}
+
+	struct TransientPoolStats
+	{
+		// Cumulative since the pool was created.
+		std::uint64_t requests{ 0 };      // graph textures that needed a physical texture
+		std::uint64_t poolHits{ 0 };      // served by a texture kept from an earlier frame
+		std::uint64_t aliasHits{ 0 };     // served by a texture already used earlier this frame
+		std::uint64_t texturesCreated{ 0 };
+		std::uint64_t texturesDestroyed{ 0 };
+
+		// Last frame / high-water marks.
+		std::uint32_t frameTextures{ 0 }; // distinct physical textures used by the last frame
+		std::uint64_t frameBytes{ 0 };
+		std::uint64_t peakFrameBytes{ 0 };
+		std::uint64_t pooledBytes{ 0 };   // everything the pool currently owns
+
+		double HitRate() const noexcept
+		{
+			return requests ? static_cast<double>(poolHits + aliasHits) / static_cast<double>(requests) : 0.0;
+		}
+	};
+
+	// Keeps render-graph transient textures alive across frames, keyed by (extent, format, type).
+	// Within a frame, graph textures whose lifetimes do not overlap share one physical texture.
+	// The RHI has no placed resources, so aliasing only happens between identical descriptors.
+	class TransientTexturePool
+	{
+	public:
+		// Textures not requested for this many frames are destroyed (e.g. after a resize).
+		static constexpr std::uint64_t kRetainFrames = 8;
+
+		void BeginFrame() noexcept
+		{
+			++frameIndex_;
+			for (Entry& entry : entries_)
+			{
+				entry.busyUntil = kInvalidPassIndex;
+			}
+			stats_.frameTextures = 0;
+			stats_.frameBytes = 0;
+		}
+
+		// `lifetime` is in execution-order positions; requests must arrive sorted by firstUse.
+		rhi::TextureHandle Acquire(rhi::IRHIDevice& device, const TransientTextureKey& key, ResourceLifetime lifetime)
+		{
+			++stats_.requests;
+
+			Entry* free = nullptr;
+			for (Entry& entry : entries_)
+			{
+				if (!(entry.key == key))
+				{
+					continue;
+				}
+				const bool usedThisFrame = entry.lastFrameUsed == frameIndex_;
+				if (!usedThisFrame)
+				{
+					free = free ? free : &entry;
+					continue;
+				}
+				if (entry.busyUntil < lifetime.firstUse)
+				{
+					// Prefer aliasing over waking up another pooled texture: keeps the frame footprint minimal.
+					++stats_.aliasHits;
+					entry.busyUntil = lifetime.lastUse;
+					return entry.texture;
+				}
+			}
+
+			if (free)
+			{
+				++stats_.poolHits;
+				MarkUsed(*free, lifetime);
+				return free->texture;
+			}
+
+			Entry entry{};
+			entry.key = key;
+			entry.bytes = EstimateTextureBytes(key);
+			entry.texture = (key.type == TextureType::Cube)
+				? device.CreateTextureCube(key.extent, key.format)
+				: device.CreateTexture2D(key.extent, key.format);
+			++stats_.texturesCreated;
+			stats_.pooledBytes += entry.bytes;
+			MarkUsed(entry, lifetime);
+			entries_.push_back(entry);
+			return entries_.back().texture;
+		}
+
+		// Destroys textures that have not been requested for kRetainFrames frames.
+		void EndFrame(rhi::IRHIDevice& device)
+		{
+			stats_.peakFrameBytes = std::max(stats_.peakFrameBytes, stats_.frameBytes);
+			std::erase_if(entries_, [this, &device](const Entry& entry)
+				{
+					if (frameIndex_ - entry.lastFrameUsed < kRetainFrames)
+					{
+						return false;
+					}
+					Destroy(device, entry);
+					return true;
+				});
+		}
+
+		void Release(rhi::IRHIDevice& device)
+		{
+			for (const Entry& entry : entries_)
+			{
+				Destroy(device, entry);
+			}
+			entries_.clear();
+		}
+
+		std::size_t Size() const noexcept { return entries_.size(); }
+		const TransientPoolStats& GetStats() const noexcept { return stats_; }
+
+		// Textures destroyed since the last call; framebuffers built on them must be dropped.
+		std::vector<rhi::TextureHandle> TakeDestroyedTextures() noexcept
+		{
+			return std::exchange(destroyedTextures_, {});
+		}
+
+	private:
+		struct Entry
+		{
+			TransientTextureKey key{};
+			rhi::TextureHandle texture{};
+			std::uint64_t bytes{ 0 };
+			std::uint64_t lastFrameUsed{ 0 };
+			std::uint32_t busyUntil{ kInvalidPassIndex };
+		};
+
+		void MarkUsed(Entry& entry, ResourceLifetime lifetime) noexcept
+		{
+			entry.lastFrameUsed = frameIndex_;
+			entry.busyUntil = lifetime.lastUse;
+			++stats_.frameTextures;
+			stats_.frameBytes += entry.bytes;
+		}
+
+		void Destroy(rhi::IRHIDevice& device, const Entry& entry) noexcept
+		{
+			device.DestroyTexture(entry.texture);
+			destroyedTextures_.push_back(entry.texture);
+			++stats_.texturesDestroyed;
+			stats_.pooledBytes -= entry.bytes;
+		}
+
+		std::vector<Entry> entries_;
+		std::vector<rhi::TextureHandle> destroyedTextures_;
+		std::uint64_t frameIndex_{ 0 };
+		TransientPoolStats stats_{};
+	};
+
+	enum class FramebufferKind : std::uint8_t
+	{
+		MRT,
+		CubeAllFaces,
+		CubeFace,
+		CubeFaceMip
+	};
+
+	// Identifies a framebuffer by the physical textures and cube subresource it binds.
+	struct FramebufferKey
+	{
+		static constexpr std::size_t kMaxColorAttachments = 8;
+
+		std::array<rhi::TextureHandle, kMaxColorAttachments> colors{};
+		std::uint32_t colorCount{ 0 };
+		rhi::TextureHandle depth{};
+		FramebufferKind kind{ FramebufferKind::MRT };
+		std::uint32_t cubeFace{ 0 };
+		std::uint32_t cubeMip{ 0 };
+
+		std::span<const rhi::TextureHandle> Colors() const noexcept
+		{
+			return { colors.data(), colorCount };
+		}
+
+		bool References(rhi::TextureHandle texture) const noexcept
+		{
+			return depth == texture || std::ranges::find(Colors(), texture) != Colors().end();
+		}
+
+		friend bool operator==(const FramebufferKey& lhs, const FramebufferKey& rhs) noexcept
+		{
+			return lhs.colorCount == rhs.colorCount
+				&& std::ranges::equal(lhs.Colors(), rhs.Colors())
+				&& lhs.depth == rhs.depth
+				&& lhs.kind == rhs.kind
+				&& lhs.cubeFace == rhs.cubeFace
+				&& lhs.cubeMip == rhs.cubeMip;
+		}
+	};
+
+	struct FramebufferKeyHash
+	{
+		static void Combine(std::size_t& seed, std::uint32_t value) noexcept
+		{
+			seed ^= std::hash<std::uint32_t>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+		}
+
+		std::size_t operator()(const FramebufferKey& key) const noexcept
+		{
+			std::size_t seed = std::hash<std::uint32_t>{}(key.depth.id);
+			for (const rhi::TextureHandle color : key.Colors())
+			{
+				Combine(seed, color.id);
+			}
+			Combine(seed, key.colorCount);
+			Combine(seed, static_cast<std::uint32_t>(key.kind));
+			Combine(seed, key.cubeFace);
+			Combine(seed, key.cubeMip);
+			return seed;
+		}
+	};
+
+	struct FramebufferCacheStats
+	{
+		// Cumulative since the cache was created.
+		std::uint64_t hits{ 0 };
+		std::uint64_t misses{ 0 };       // every miss creates one framebuffer
+		std::uint64_t destroyed{ 0 };
+		std::uint64_t invalidated{ 0 };  // destroyed because a referenced texture went away
+
+		// Last frame.
+		std::uint32_t frameCreated{ 0 };
+
+		double HitRate() const noexcept
+		{
+			const std::uint64_t lookups = hits + misses;
+			return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+		}
+	};
+
+	// Keeps framebuffers alive across frames so steady-state frames create none.
+	// Entries must be invalidated when a texture they reference is destroyed:
+	// GL reuses texture names, so a stale entry could otherwise bind the wrong attachment.
+	class FramebufferCache
+	{
+	public:
+		// Framebuffers not requested for this many frames are destroyed.
+		static constexpr std::uint64_t kRetainFrames = 8;
+
+		void BeginFrame() noexcept
+		{
+			++frameIndex_;
+			stats_.frameCreated = 0;
+		}
+
+		rhi::FrameBufferHandle Acquire(rhi::IRHIDevice& device, const FramebufferKey& key)
+		{
+			if (auto it = entries_.find(key); it != entries_.end())
+			{
+				++stats_.hits;
+				it->second.lastFrameUsed = frameIndex_;
+				return it->second.frameBuffer;
+			}
+
+			++stats_.misses;
+			++stats_.frameCreated;
+			const rhi::FrameBufferHandle frameBuffer = Create(device, key);
+			entries_.emplace(key, Entry{ .frameBuffer = frameBuffer, .lastFrameUsed = frameIndex_ });
+			return frameBuffer;
+		}
+
+		// Destroys framebuffers that have not been requested for kRetainFrames frames.
+		void EndFrame(rhi::IRHIDevice& device)
+		{
+			std::erase_if(entries_, [this, &device](const auto& item)
+				{
+					if (frameIndex_ - item.second.lastFrameUsed < kRetainFrames)
+					{
+						return false;
+					}
+					Destroy(device, item.second);
+					return true;
+				});
+		}
+
+		// Destroys every framebuffer that binds `texture`.
+		void InvalidateTexture(rhi::IRHIDevice& device, rhi::TextureHandle texture)
+		{
+			if (!texture)
+			{
+				return;
+			}
+			std::erase_if(entries_, [this, &device, texture](const auto& item)
+				{
+					if (!item.first.References(texture))
+					{
+						return false;
+					}
+					Destroy(device, item.second);
+					++stats_.invalidated;
+					return true;
+				});
+		}
+
+		void Release(rhi::IRHIDevice& device)
+		{
+			for (const auto& [key, entry] : entries_)
+			{
+				Destroy(device, entry);
+			}
+			entries_.clear();
+		}
+
+		std::size_t Size() const noexcept { return entries_.size(); }
+		const FramebufferCacheStats& GetStats() const noexcept { return stats_; }
+
+	private:
+		struct Entry
+		{
+			rhi::FrameBufferHandle frameBuffer{};
+			std::uint64_t lastFrameUsed{ 0 };
+		};
+
+		static rhi::FrameBufferHandle Create(rhi::IRHIDevice& device, const FramebufferKey& key)
+		{
+			switch (key.kind)
+			{
+			case FramebufferKind::CubeAllFaces:
+				return device.CreateFramebufferCube(key.colors[0], key.depth);
+			case FramebufferKind::CubeFace:
+				return device.CreateFramebufferCubeFace(key.colors[0], key.cubeFace, key.depth);
+			case FramebufferKind::CubeFaceMip:
+				return device.CreateFramebufferCubeFaceMip(key.colors[0], key.cubeFace, key.cubeMip, key.depth);
+			case FramebufferKind::MRT:
+			default:
+				return device.CreateFramebufferMRT(key.Colors(), key.depth);
+			}
+		}
+
+		void Destroy(rhi::IRHIDevice& device, const Entry& entry) noexcept
+		{
+			device.DestroyFramebuffer(entry.frameBuffer);
+			++stats_.destroyed;
+		}
+
+		std::unordered_map<FramebufferKey, Entry, FramebufferKeyHash> entries_;
+		std::uint64_t frameIndex_{ 0 };
+		FramebufferCacheStats stats_{};
+	};
+
 	class RenderGraph
 	{
 	public:
@@ -134,125 +578,549 @@ struct RGTextureDesc
 			passes_.emplace_back(PassNode{ .name = std::string(name), .attachments = std::move(attachments), .execute = std::move(callback) });
 		}
 
+		void AddSwapChainPass(std::string_view name, rhi::ClearDesc clearDesc, std::vector<RGTexture> reads, PassCallback callback, bool bindDepthStencil = true)
+		{
+			AddSwapChainPass(name, clearDesc, std::move(callback), bindDepthStencil);
+			passes_.back().attachments.reads = std::move(reads);
+		}
+
+		// Clears passes and resources. The command arena is kept so the next frame records without allocating.
 		void Reset()
 		{
 			passes_.clear();
 			textures_.clear();
 		}
 
+		// Builds the pass DAG and culls passes whose outputs never reach the swapchain, an imported
+		// texture or a side-effect pass.
+		//
+		// Each read or load-preserving attachment depends on the latest earlier writer of that texture, so
+		// edges always point backwards and declaration order stays a valid topological order; the
+		// execution order is the surviving passes in declaration order.
+		const CompiledGraph& Compile()
+		{
+			CompiledGraph& compiled = compiled_;
+			const std::size_t passCount = passes_.size();
+
+			compiled.passOrder.clear();
+			compiled.passCulled.assign(passCount, 1);
+			compiled.passDependencies.resize(passCount);
+			compiled.textureLifetimes.assign(textures_.size(), ResourceLifetime{});
+
+			std::vector<std::uint32_t> lastWriter(textures_.size(), kInvalidPassIndex);
+			std::vector<std::uint32_t> pending;
+			pending.reserve(passCount);
+
+			auto AddDependency = [this, &lastWriter](std::vector<std::uint32_t>& deps, RGTexture texture)
+				{
+					if (texture.id >= textures_.size())
+					{
+						return;
+					}
+					const std::uint32_t producer = lastWriter[texture.id];
+					if (producer != kInvalidPassIndex && std::find(deps.begin(), deps.end(), producer) == deps.end())
+					{
+						deps.push_back(producer);
+					}
+				};
+
+			for (std::uint32_t passIndex = 0; passIndex < passCount; ++passIndex)
+			{
+				const PassAttachments& attachments = passes_[passIndex].attachments;
+				std::vector<std::uint32_t>& deps = compiled.passDependencies[passIndex];
+				deps.clear();
+
+				for (const RGTexture& read : attachments.reads)
+				{
+					AddDependency(deps, read);
+				}
+
+				// A single cube face only overwrites part of the texture, so earlier faces stay live.
+				const bool partialWrite = attachments.colorCubeFace.has_value();
+				bool isRoot = attachments.useSwapChainBackbuffer || attachments.hasSideEffects;
+				bool writesAnything = attachments.useSwapChainBackbuffer;
+
+				auto Write = [&](RGTexture texture, bool preservesContents)
+					{
+						if (texture.id >= textures_.size())
+						{
+							return;
+						}
+						if (preservesContents || partialWrite)
+						{
+							AddDependency(deps, texture);
+						}
+						if (textures_[texture.id].externalTexture)
+						{
+							isRoot = true;
+						}
+						lastWriter[texture.id] = passIndex;
+						writesAnything = true;
+					};
+
+				if (!attachments.useSwapChainBackbuffer)
+				{
+					const rhi::ClearDesc& clear = attachments.clearDesc;
+					for (const RGTexture& color : attachments.colors)
+					{
+						Write(color, !clear.clearColor);
+					}
+					if (attachments.depth && attachments.depth->id < textures_.size())
+					{
+						const bool hasStencil = textures_[attachments.depth->id].format == rhi::Format::D24_UNORM_S8_UINT;
+						Write(*attachments.depth, !clear.clearDepth || (hasStencil && !clear.clearStencil));
+					}
+				}
+
+				if (isRoot || !writesAnything)
+				{
+					pending.push_back(passIndex);
+				}
+			}
+
+			// Walk producers back from the roots.
+			while (!pending.empty())
+			{
+				const std::uint32_t passIndex = pending.back();
+				pending.pop_back();
+				if (compiled.passCulled[passIndex] == 0)
+				{
+					continue;
+				}
+				compiled.passCulled[passIndex] = 0;
+				for (const std::uint32_t producer : compiled.passDependencies[passIndex])
+				{
+					pending.push_back(producer);
+				}
+			}
+
+			for (std::uint32_t passIndex = 0; passIndex < passCount; ++passIndex)
+			{
+				if (compiled.passCulled[passIndex] != 0)
+				{
+					continue;
+				}
+
+				const std::uint32_t orderIndex = static_cast<std::uint32_t>(compiled.passOrder.size());
+				compiled.passOrder.push_back(passIndex);
+
+				auto Touch = [&compiled, orderIndex](RGTexture texture)
+					{
+						if (texture.id >= compiled.textureLifetimes.size())
+						{
+							return;
+						}
+						ResourceLifetime& lifetime = compiled.textureLifetimes[texture.id];
+						if (!lifetime.IsUsed())
+						{
+							lifetime.firstUse = orderIndex;
+						}
+						lifetime.lastUse = orderIndex;
+					};
+
+				const PassAttachments& attachments = passes_[passIndex].attachments;
+				for (const RGTexture& read : attachments.reads)
+				{
+					Touch(read);
+				}
+				if (!attachments.useSwapChainBackbuffer)
+				{
+					for (const RGTexture& color : attachments.colors)
+					{
+						Touch(color);
+					}
+					if (attachments.depth)
+					{
+						Touch(*attachments.depth);
+					}
+				}
+			}
+
+			PlanBarriers(compiled);
+			return compiled;
+		}
+
+		const CompiledGraph& GetCompiled() const noexcept { return compiled_; }
+		const TransientPoolStats& GetTransientPoolStats() const noexcept { return transientPool_.GetStats(); }
+
+		const FramebufferCacheStats& GetFramebufferCacheStats() const noexcept { return framebufferCache_.GetStats(); }
+
+		// Filters redundant state/binding commands out of the frame list before submission (see rhi::OptimizeCommandList).
+		void SetOptimizeCommandLists(bool enable) noexcept { optimizeCommandLists_ = enable; }
+		// Last Execute(); all zero removals when optimization is off.
+		const rhi::CommandListOptimizeStats& GetCommandListOptimizeStats() const noexcept { return optimizeStats_; }
+
+		// Call before destroying an imported texture so cached framebuffers never outlive it.
+		void InvalidateTexture(rhi::IRHIDevice& device, rhi::TextureHandle texture)
+		{
+			framebufferCache_.InvalidateTexture(device, texture);
+		}
+
+		// Destroys cached framebuffers and pooled transient textures. Call before the device goes away.
+		void ReleaseTransientResources(rhi::IRHIDevice& device)
+		{
+			framebufferCache_.Release(device);
+			transientPool_.Release(device);
+			transientPool_.TakeDestroyedTextures();
+		}
+
 		void Execute(rhi::IRHIDevice& device, rhi::IRHISwapChain& swapChain)
 		{
-			std::vector<rhi::TextureHandle> allocatedTextures;
-			allocatedTextures.reserve(textures_.size());
-			std::vector<std::uint8_t> owned;
-			owned.reserve(textures_.size());
-			for (const auto& texDesc : textures_)
+			const CompiledGraph& compiled = Compile();
+
+			std::vector<rhi::TextureHandle> allocatedTextures(textures_.size());
+			std::vector<std::uint32_t> transientOrder;
+			transientOrder.reserve(textures_.size());
+			for (std::uint32_t textureIndex = 0; textureIndex < textures_.size(); ++textureIndex)
 			{
+				const auto& texDesc = textures_[textureIndex];
 				if (texDesc.externalTexture)
 				{
-					allocatedTextures.push_back(texDesc.externalTexture);
-					owned.push_back(0);
-					continue;
+					allocatedTextures[textureIndex] = texDesc.externalTexture;
+				}
+				// Textures only referenced by culled passes get no physical texture.
+				else if (compiled.textureLifetimes[textureIndex].IsUsed())
+				{
+					transientOrder.push_back(textureIndex);
 				}
+			}
 
-				rhi::TextureHandle texture = (texDesc.type == TextureType::Cube)
-					? device.CreateTextureCube(texDesc.extent, texDesc.format)
-					: device.CreateTexture2D(texDesc.extent, texDesc.format);
-				allocatedTextures.push_back(texture);
-				owned.push_back(1);
+			// The pool aliases greedily, which needs requests ordered by first use.
+			std::stable_sort(transientOrder.begin(), transientOrder.end(), [&compiled](std::uint32_t lhs, std::uint32_t rhs)
+				{
+					return compiled.textureLifetimes[lhs].firstUse < compiled.textureLifetimes[rhs].firstUse;
+				});
+
+			transientPool_.BeginFrame();
+			for (const std::uint32_t textureIndex : transientOrder)
+			{
+				const auto& texDesc = textures_[textureIndex];
+				const TransientTextureKey key{ .extent = texDesc.extent, .format = texDesc.format, .type = texDesc.type };
+				allocatedTextures[textureIndex] = transientPool_.Acquire(device, key, compiled.textureLifetimes[textureIndex]);
 			}
 
 			RenderGraphResources resources(allocatedTextures);
-			rhi::CommandList commandList;
+			rhi::CommandList& commandList = commandList_;
+			commandList.Reset();
+
+			// Framebuffers and barriers touch graph-owned caches, so they are resolved up front on this thread.
+			framebufferCache_.BeginFrame();
+			preparedPasses_.clear();
+			preparedBarriers_.clear();
+			std::size_t parallelPassCount = 0;
+			for (const std::uint32_t passIndex : compiled.passOrder)
+			{
+				preparedPasses_.push_back(PreparePass(device, swapChain, passIndex, resources));
+				parallelPassCount += passes_[passIndex].attachments.recordInParallel ? 1u : 0u;
+			}
+
+			if (jobs_ && maxRecordingJobs_ != 0 && parallelPassCount > 1)
+			{
+				RecordParallel(device, swapChain, resources, parallelPassCount);
+			}
+			else
+			{
+				for (std::size_t orderIndex = 0; orderIndex < preparedPasses_.size(); ++orderIndex)
+				{
+					RecordPass(commandList, device, swapChain, resources, orderIndex);
+				}
+			}
 
-			std::vector<rhi::FrameBufferHandle> transientFramebuffers;
-			transientFramebuffers.reserve(passes_.size());
+			// Backends only read the stream, so commandList_ keeps its arena capacity for the next frame.
+			if (optimizeCommandLists_)
+			{
+				optimizeStats_ = rhi::OptimizeCommandList(commandList, optimizedCommandList_);
+				device.SubmitCommandList(std::move(optimizedCommandList_));
+			}
+			else
+			{
+				optimizeStats_ = rhi::CommandListOptimizeStats{ .inputCommands = commandList.Size(), .outputCommands = commandList.Size() };
+				device.SubmitCommandList(std::move(commandList));
+			}
 
-			for (auto& pass : passes_)
+			framebufferCache_.EndFrame(device);
+			transientPool_.EndFrame(device);
+			for (const rhi::TextureHandle texture : transientPool_.TakeDestroyedTextures())
 			{
-				rhi::FrameBufferHandle frameBuffer{};
-				rhi::Extent2D passExtent{ 0, 0 };
+				framebufferCache_.InvalidateTexture(device, texture);
+			}
+		}
+		// Passes flagged recordInParallel are spread over `jobs` (at most `maxJobs` helper jobs per
+		// frame, plus the calling thread). Pass nullptr to record everything on the calling thread.
+		void SetJobSystem(IJobSystem* jobs, std::uint32_t maxJobs) noexcept
+		{
+			jobs_ = jobs;
+			maxRecordingJobs_ = maxJobs;
+		}
+
+	private:
+		struct PreparedPass
+		{
+			std::uint32_t passIndex{ 0 };
+			rhi::BeginPassDesc begin{};
+			std::uint32_t firstBarrier{ 0 };
+			std::uint32_t barrierCount{ 0 };
+		};
+
+		PreparedPass PreparePass(rhi::IRHIDevice& device, rhi::IRHISwapChain& swapChain, std::uint32_t passIndex, const RenderGraphResources& resources)
+		{
+			const PassNode& pass = passes_[passIndex];
+			PreparedPass prepared{};
+			prepared.passIndex = passIndex;
 
-				if (pass.attachments.useSwapChainBackbuffer)
+			prepared.firstBarrier = static_cast<std::uint32_t>(preparedBarriers_.size());
+			for (const RGBarrier& planned : compiled_.passBarriers[passIndex])
+			{
+				if (const rhi::TextureHandle texture = resources.GetTexture(planned.texture))
 				{
-					frameBuffer = swapChain.GetCurrentBackBuffer();
-					passExtent = swapChain.GetDesc().extent;
+					preparedBarriers_.push_back(rhi::TextureBarrier{ texture, planned.before, planned.after });
 				}
-				else
+			}
+			prepared.barrierCount = static_cast<std::uint32_t>(preparedBarriers_.size()) - prepared.firstBarrier;
+
+			rhi::FrameBufferHandle frameBuffer{};
+			rhi::Extent2D passExtent{ 0, 0 };
+			if (pass.attachments.useSwapChainBackbuffer)
+			{
+				frameBuffer = swapChain.GetCurrentBackBuffer();
+				passExtent = swapChain.GetDesc().extent;
+			}
+			else
+			{
+				if (pass.attachments.colors.size() > FramebufferKey::kMaxColorAttachments)
 				{
-					std::vector<rhi::TextureHandle> colors;
-					colors.reserve(pass.attachments.colors.size());
+					throw std::runtime_error("RenderGraph: pass '" + pass.name + "' exceeds the color attachment limit");
+				}
 
-					for (const auto& c : pass.attachments.colors)
-					{
-						colors.push_back(resources.GetTexture(c));
-					}
+				FramebufferKey key{};
+				for (const auto& c : pass.attachments.colors)
+				{
+					key.colors[key.colorCount++] = resources.GetTexture(c);
+				}
+				key.depth = pass.attachments.depth ? resources.GetTexture(*pass.attachments.depth) : rhi::TextureHandle();
 
-					const auto depth = pass.attachments.depth ? resources.GetTexture(*pass.attachments.depth) : rhi::TextureHandle();
+				if (!pass.attachments.colors.empty())
+				{
+					passExtent = textures_[pass.attachments.colors.front().id].extent;
+				}
+				else if (pass.attachments.depth)
+				{
+					passExtent = textures_[pass.attachments.depth->id].extent;
+				}
 
-					if (!pass.attachments.colors.empty())
+				// Cubemap rendering is only supported for a single color attachment.
+				if (key.colorCount == 1 && key.colors[0])
+				{
+					if (pass.attachments.colorCubeAllFaces)
 					{
-						passExtent = textures_[pass.attachments.colors.front().id].extent;
+						key.kind = FramebufferKind::CubeAllFaces;
 					}
-					else if (pass.attachments.depth)
+					else if (pass.attachments.colorCubeFace)
 					{
-						passExtent = textures_[pass.attachments.depth->id].extent;
+						key.kind = pass.attachments.colorCubeMip ? FramebufferKind::CubeFaceMip : FramebufferKind::CubeFace;
+						key.cubeFace = *pass.attachments.colorCubeFace;
+						key.cubeMip = pass.attachments.colorCubeMip.value_or(0u);
 					}
+				}
+				frameBuffer = framebufferCache_.Acquire(device, key);
+			}
 
-					// Cubemap rendering is only supported for a single color attachment.
-					if (pass.attachments.colorCubeAllFaces && colors.size() == 1 && colors[0].id != 0)
+			prepared.begin.frameBuffer = frameBuffer;
+			prepared.begin.extent = passExtent;
+			prepared.begin.clearDesc = pass.attachments.clearDesc;
+			prepared.begin.swapChain = pass.attachments.useSwapChainBackbuffer ? &swapChain : nullptr;
+			prepared.begin.bindDepthStencil = pass.attachments.bindDepthStencil;
+			return prepared;
+		}
+
+		// Safe to call concurrently for different passes: only reads prepared state and writes `commandList`.
+		void RecordPass(
+			rhi::CommandList& commandList,
+			rhi::IRHIDevice& device,
+			rhi::IRHISwapChain& swapChain,
+			const RenderGraphResources& resources,
+			std::size_t orderIndex)
+		{
+			const PreparedPass& prepared = preparedPasses_[orderIndex];
+			commandList.TransitionTextures(std::span<const rhi::TextureBarrier>(preparedBarriers_).subspan(prepared.firstBarrier, prepared.barrierCount));
+			commandList.BeginPass(prepared.begin);
+
+			PassContext ctx{ device, swapChain, commandList, resources, prepared.begin.extent };
+			passes_[prepared.passIndex].execute(ctx);
+
+			commandList.EndPass();
+		}
+
+		// Shared with helper jobs. A job that starts after all passes were claimed returns without
+		// touching `record`, so late jobs never see the (by then finished) frame.
+		struct ParallelRecording
+		{
+			std::function<void(std::size_t)> record;
+			std::size_t count{ 0 };
+			std::atomic<std::size_t> next{ 0 };
+			std::atomic<std::size_t> done{ 0 };
+			std::mutex errorMutex;
+			std::exception_ptr error;
+
+			void Drain()
+			{
+				for (std::size_t item = next.fetch_add(1); item < count; item = next.fetch_add(1))
+				{
+					try
 					{
-						frameBuffer = device.CreateFramebufferCube(colors[0], depth);
+						record(item);
 					}
-					else if (pass.attachments.colorCubeFace && colors.size() == 1 && colors[0].id != 0)
+					catch (...)
 					{
-						if (pass.attachments.colorCubeMip)
+						std::scoped_lock lock(errorMutex);
+						if (!error)
 						{
-							frameBuffer = device.CreateFramebufferCubeFaceMip(colors[0], *pass.attachments.colorCubeFace, *pass.attachments.colorCubeMip, depth);
-						}
-						else
-						{
-							frameBuffer = device.CreateFramebufferCubeFace(colors[0], *pass.attachments.colorCubeFace, depth);
+							error = std::current_exception();
 						}
 					}
-					else
+					if (done.fetch_add(1) + 1 == count)
 					{
-						frameBuffer = device.CreateFramebufferMRT(colors, depth);
+						done.notify_all();
 					}
-					transientFramebuffers.push_back(frameBuffer);
 				}
+			}
+		};
 
-				rhi::BeginPassDesc begin{};
-				begin.frameBuffer = frameBuffer;
-				begin.extent = passExtent;
-				begin.clearDesc = pass.attachments.clearDesc;
-				begin.swapChain = pass.attachments.useSwapChainBackbuffer ? &swapChain : nullptr;
-				begin.bindDepthStencil = pass.attachments.bindDepthStencil;
+		// Parallel passes record into their own lists on the job system while this thread helps;
+		// the remaining passes are recorded here afterwards, then everything is stitched in order.
+		void RecordParallel(
+			rhi::IRHIDevice& device,
+			rhi::IRHISwapChain& swapChain,
+			const RenderGraphResources& resources,
+			std::size_t parallelPassCount)
+		{
+			const std::size_t passCount = preparedPasses_.size();
+			if (passLists_.size() < passCount)
+			{
+				passLists_.resize(passCount);
+			}
 
-				commandList.BeginPass(begin);
+			parallelOrder_.clear();
+			for (std::size_t orderIndex = 0; orderIndex < passCount; ++orderIndex)
+			{
+				passLists_[orderIndex].Reset();
+				if (passes_[preparedPasses_[orderIndex].passIndex].attachments.recordInParallel)
+				{
+					parallelOrder_.push_back(orderIndex);
+				}
+			}
 
-				PassContext ctx{ device, swapChain, commandList, resources, passExtent };
-				pass.execute(ctx);
+			auto recording = std::make_shared<ParallelRecording>();
+			recording->count = parallelPassCount;
+			recording->record = [this, &device, &swapChain, &resources](std::size_t item)
+				{
+					const std::size_t orderIndex = parallelOrder_[item];
+					RecordPass(passLists_[orderIndex], device, swapChain, resources, orderIndex);
+				};
 
-				commandList.EndPass();
+			const std::size_t helperJobs = std::min<std::size_t>(maxRecordingJobs_, parallelPassCount - 1);
+			for (std::size_t job = 0; job < helperJobs; ++job)
+			{
+				jobs_->Enqueue([recording]() { recording->Drain(); });
 			}
+			recording->Drain();
 
-			device.SubmitCommandList(std::move(commandList));
+			// Waits for passes, not for the helper jobs: those may still be queued behind unrelated work.
+			for (std::size_t done = recording->done.load(); done < parallelPassCount; done = recording->done.load())
+			{
+				recording->done.wait(done);
+			}
+			if (recording->error)
+			{
+				std::rethrow_exception(recording->error);
+			}
 
-			for (auto frameBuffer : transientFramebuffers)
+			std::size_t totalBytes = 0;
+			for (std::size_t orderIndex = 0; orderIndex < passCount; ++orderIndex)
 			{
-				device.DestroyFramebuffer(frameBuffer);
+				if (!passes_[preparedPasses_[orderIndex].passIndex].attachments.recordInParallel)
+				{
+					RecordPass(passLists_[orderIndex], device, swapChain, resources, orderIndex);
+				}
+				totalBytes += passLists_[orderIndex].SizeBytes();
 			}
-			for (std::size_t i = 0; i < allocatedTextures.size(); ++i)
+
+			commandList_.Reserve(totalBytes);
+			for (std::size_t orderIndex = 0; orderIndex < passCount; ++orderIndex)
 			{
-				if (owned[i] != 0)
+				commandList_.Append(passLists_[orderIndex]);
+			}
+		}
+
+		// Walks the execution order tracking each texture's state; a texture only gets a barrier
+		// when the state a pass needs differs from the one it was left in. Every texture starts
+		// Unknown each frame, so backends transition from whatever state they tracked last.
+		void PlanBarriers(CompiledGraph& compiled) const
+		{
+			compiled.passBarriers.resize(passes_.size());
+			for (auto& batch : compiled.passBarriers)
+			{
+				batch.clear();
+			}
+
+			std::vector<rhi::ResourceState> states(textures_.size(), rhi::ResourceState::Unknown);
+			for (const std::uint32_t passIndex : compiled.passOrder)
+			{
+				const PassAttachments& attachments = passes_[passIndex].attachments;
+				std::vector<RGBarrier>& batch = compiled.passBarriers[passIndex];
+
+				auto Require = [&states, &batch](RGTexture texture, rhi::ResourceState state)
+					{
+						if (texture.id >= states.size())
+						{
+							return;
+						}
+						// Attachments are required first: a texture that is also sampled keeps its attachment state.
+						const bool alreadyInBatch = std::any_of(batch.begin(), batch.end(),
+							[texture](const RGBarrier& barrier) { return barrier.texture.id == texture.id; });
+						rhi::ResourceState& current = states[texture.id];
+						if (alreadyInBatch || current == state)
+						{
+							return;
+						}
+						batch.push_back(RGBarrier{ texture, current, state });
+						current = state;
+					};
+
+				if (!attachments.useSwapChainBackbuffer)
+				{
+					for (const RGTexture& color : attachments.colors)
+					{
+						Require(color, rhi::ResourceState::RenderTarget);
+					}
+					if (attachments.depth)
+					{
+						Require(*attachments.depth, rhi::ResourceState::DepthWrite);
+					}
+				}
+				for (const RGTexture& read : attachments.reads)
 				{
-					device.DestroyTexture(allocatedTextures[i]);
+					Require(read, rhi::ResourceState::ShaderRead);
 				}
 			}
 		}
-	private:
+
 		std::vector<PassNode> passes_;
 		std::vector<RGTextureDesc> textures_;
+		CompiledGraph compiled_;
+		TransientTexturePool transientPool_;
+		FramebufferCache framebufferCache_;
+		std::vector<PreparedPass> preparedPasses_;
+		std::vector<rhi::TextureBarrier> preparedBarriers_;
+		rhi::CommandList commandList_;
+		rhi::CommandList optimizedCommandList_;
+		bool optimizeCommandLists_{ false };
+		rhi::CommandListOptimizeStats optimizeStats_{};
+
+		IJobSystem* jobs_{ nullptr };
+		std::uint32_t maxRecordingJobs_{ 0 };
+		// Per execution-order position; only used when recording in parallel.
+		std::vector<rhi::CommandList> passLists_;
+		std::vector<std::size_t> parallelOrder_;
 	};
 }
@@ -1,5 +1,6 @@
 module;
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 
@@ -10,7 +11,9 @@ export module core:render_renderer;
 export import :renderer_settings;
 
 import :rhi;
+import :sync;
 import :scene;
+import :resource_manager_core;
 
 #if defined(CORE_USE_GL)
 import :renderer_mesh_gl;
@@ -33,6 +36,10 @@ namespace rendern
             virtual void RenderFrame(rhi::IRHISwapChain& swapChain, const Scene& scene, const void* imguiDrawData) = 0;
             virtual void SetSettings(const RendererSettings& settings) = 0;
             virtual void Shutdown() = 0;
+            // Backends without parallel pass recording ignore it.
+            virtual void SetJobSystem(IJobSystem*, std::uint32_t) {}
+            // nullptr when the backend does not pace frames with fences.
+            virtual const FrameSync* GetFrameSync() const noexcept { return nullptr; }
         };
 
         class NullRendererImpl final : public IRendererImpl
@@ -91,6 +98,16 @@ namespace rendern
                 impl_.SetSettings(settings);
             }
 
+            void SetJobSystem(IJobSystem* jobs, std::uint32_t workerCount) override
+            {
+                impl_.SetJobSystem(jobs, workerCount);
+            }
+
+            const FrameSync* GetFrameSync() const noexcept override
+            {
+                return &impl_.GetFrameSync();
+            }
+
             void Shutdown() override
             {
                 impl_.Shutdown();
@@ -148,6 +165,19 @@ namespace rendern
             impl_->SetSettings(settings);
         }
 
+        // Lets the renderer record independent graph passes on `jobs` (nullptr = calling thread only).
+        void SetJobSystem(IJobSystem* jobs, std::uint32_t workerCount)
+        {
+            impl_->SetJobSystem(jobs, workerCount);
+        }
+
+        // Frame fences of the backend renderer, for systems that recycle GPU-visible resources
+        // (see BindlessTable). nullptr when the backend needs no such pacing.
+        const FrameSync* GetFrameSync() const noexcept
+        {
+            return impl_->GetFrameSync();
+        }
+
         void Shutdown()
         {
             impl_->Shutdown();
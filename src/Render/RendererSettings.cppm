@@ -23,7 +23,15 @@ export namespace rendern
 		bool enableDepthPrepass{ false };
 		bool enableDeferred{ false }; // DX12-only (currently): GBuffer + fullscreen resolve
 		bool enableFrustumCulling{ true };
-		bool debugPrintDrawCalls{ false }; // prints MainPass draw-call count (DX12) once per ~60 frames
+		// CPU occlusion culling (DX12): the best occluders are rasterized into a 256x128 depth buffer and
+		// frustum-visible draws hidden behind them are skipped. Needs enableFrustumCulling.
+		bool enableOcclusionCulling{ false };
+		std::uint32_t occlusionMaxOccluders{ 32 };
+		// Clustered lighting (DX12 deferred resolve and camera forward passes): point/spot lights are binned into a 16x9x24 view-space grid on
+		// the CPU, so each pixel only evaluates the lights of its cluster instead of every light.
+		bool enableClusteredLighting{ true };
+		bool debugPrintDrawCalls{ false }; // prints MainPass draw-call count (DX12) once per ~60 frames, and pipeline cache stats on shutdown
+		bool optimizeCommandLists{ true }; // drop redundant state/binding commands before submission
 
 		// SSAO (DX12 deferred path). Applied as a multiplicative factor to AO/ambient.
 		bool enableSSAO{ true };
@@ -111,5 +119,8 @@ export namespace rendern
 
 		float reflectionCaptureFovPadDeg{ 0.0f };
 		std::filesystem::path modelPath = std::filesystem::path("models") / "cube.obj";
+
+		// Compiled pipeline blobs persisted between launches (DX12). Empty disables the file.
+		std::filesystem::path pipelineCachePath = std::filesystem::path("cache") / "pipelines.bin";
 	};
 }
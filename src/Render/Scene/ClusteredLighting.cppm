@@ -0,0 +1,544 @@
+module;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CORE_CLUSTER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+export module core:clustered_lighting;
+
+import :math_utils;
+import :scene_bvh;
+
+// CPU clustered light assignment.
+//
+// The camera frustum is split into a froxel grid: gridX x gridY screen tiles (tile row 0 at the top of
+// the screen) times gridZ depth slices spaced exponentially between the near and far distances. Point
+// and spot lights are tested against the view-space AABB of every cluster their bounds may reach, four
+// clusters of a tile row at a time. The result is one compact index list: lights that reach everything
+// (directional ones) first, then the list of each cluster, addressed by a per-cluster {offset, count}.
+//
+// A shader finds the cluster of a pixel from its screen UV and view depth:
+//   slice = clamp(floor(log2(viewDepth) * sliceScale + sliceBias), 0, gridZ - 1)
+//   cluster = (slice * gridY + tileY) * gridX + tileX
+
+export namespace rendern
+{
+	inline constexpr std::uint32_t kDefaultClusterGridX = 16;
+	inline constexpr std::uint32_t kDefaultClusterGridY = 9;
+	inline constexpr std::uint32_t kDefaultClusterGridZ = 24;
+
+	// Mirrors the uint2 the shaders read per cluster.
+	struct ClusterRange
+	{
+		std::uint32_t offset{ 0 };
+		std::uint32_t count{ 0 };
+	};
+	static_assert(sizeof(ClusterRange) == 8);
+
+	struct ClusteredLightingStats
+	{
+		std::uint32_t pointLights{ 0 };
+		std::uint32_t spotLights{ 0 };
+		std::uint32_t globalLights{ 0 };
+		std::uint32_t lightsOutsideGrid{ 0 };
+		std::uint64_t clusterTests{ 0 };
+		std::uint32_t clusterLightIndices{ 0 }; // excluding the global prefix
+		std::uint32_t occupiedClusters{ 0 };
+		std::uint32_t maxLightsPerCluster{ 0 };
+		double buildMs{ 0.0 };
+	};
+
+	// Which cluster test loop this build uses; benchmarks report it next to their timings.
+	constexpr std::string_view ClusterAssignSimdPath() noexcept
+	{
+#if defined(CORE_CLUSTER_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+	class ClusteredLightBuilder
+	{
+	public:
+		explicit ClusteredLightBuilder(
+			std::uint32_t gridX = kDefaultClusterGridX,
+			std::uint32_t gridY = kDefaultClusterGridY,
+			std::uint32_t gridZ = kDefaultClusterGridZ)
+		{
+			SetGrid(gridX, gridY, gridZ);
+		}
+
+		void SetGrid(std::uint32_t gridX, std::uint32_t gridY, std::uint32_t gridZ)
+		{
+			if (gridX == 0 || gridY == 0 || gridZ == 0)
+			{
+				throw std::runtime_error("ClusteredLightBuilder: cluster grid dimensions must be non-zero");
+			}
+			gridX_ = gridX;
+			gridY_ = gridY;
+			gridZ_ = gridZ;
+			ranges_.assign(GetClusterCount(), ClusterRange{});
+			boundsValid_ = false;
+		}
+
+		// Starts a frame. `view` maps world to RH view space (camera looking down -Z), `proj` is the
+		// matching perspective *RH_ZO projection, and [nearZ, farZ] the view depths the slices cover.
+		// Cluster bounds are only rebuilt when the projection or the depth range changes.
+		void BeginFrame(const mathUtils::Mat4& view, const mathUtils::Mat4& proj, float nearZ, float farZ)
+		{
+			if (!(nearZ > 0.0f) || !(farZ > nearZ))
+			{
+				throw std::runtime_error("ClusteredLightBuilder: depth range must satisfy 0 < nearZ < farZ");
+			}
+
+			const float projX = proj[0].x;
+			const float projY = proj[1].y;
+			const float offsetX = proj[2].x;
+			const float offsetY = proj[2].y;
+			if (!boundsValid_ || projX != projX_ || projY != projY_ || offsetX != offsetX_ || offsetY != offsetY_
+				|| nearZ != nearZ_ || farZ != farZ_)
+			{
+				projX_ = projX;
+				projY_ = projY;
+				offsetX_ = offsetX;
+				offsetY_ = offsetY;
+				nearZ_ = nearZ;
+				farZ_ = farZ;
+				sliceScale_ = static_cast<float>(gridZ_) / std::log2(farZ / nearZ);
+				sliceBias_ = -std::log2(nearZ) * sliceScale_;
+				RebuildClusterBounds();
+			}
+
+			view_ = view;
+			lights_.clear();
+			globalLights_.clear();
+			stats_ = {};
+		}
+
+		// Light indices are what the shaders index their light buffer with; they are stored as given.
+		void AddGlobalLight(std::uint32_t lightIndex)
+		{
+			globalLights_.push_back(lightIndex);
+			++stats_.globalLights;
+		}
+
+		void AddPointLight(std::uint32_t lightIndex, const mathUtils::Vec3& position, float range)
+		{
+			if (!(range > 0.0f))
+			{
+				return;
+			}
+			LocalLight light{};
+			light.index = lightIndex;
+			light.center = ToView(position, 1.0f);
+			light.radius = range;
+			lights_.push_back(light);
+			++stats_.pointLights;
+		}
+
+		// `direction` points away from the light; `cosOuter` is the cosine of the outer half angle.
+		void AddSpotLight(std::uint32_t lightIndex, const mathUtils::Vec3& position, const mathUtils::Vec3& direction, float range, float cosOuter)
+		{
+			if (!(range > 0.0f))
+			{
+				return;
+			}
+			const float dirLength = mathUtils::Length(direction);
+			if (cosOuter <= 0.0f || dirLength <= 1e-6f)
+			{
+				// Half angle of 90 degrees or more: the lit volume is not much smaller than the range sphere.
+				AddPointLight(lightIndex, position, range);
+				--stats_.pointLights;
+				++stats_.spotLights;
+				return;
+			}
+
+			const float cosAngle = std::min(cosOuter, 1.0f);
+			const float sinAngle = std::sqrt(std::max(1.0f - cosAngle * cosAngle, 0.0f));
+			const mathUtils::Vec3 axis = direction * (1.0f / dirLength);
+
+			// Smallest sphere around the cone capped by the range sphere.
+			float boundRadius = 0.0f;
+			float boundOffset = 0.0f;
+			if (cosAngle >= 0.70710678f)
+			{
+				boundRadius = range / (2.0f * cosAngle);
+				boundOffset = boundRadius;
+			}
+			else
+			{
+				boundRadius = range * sinAngle;
+				boundOffset = range * cosAngle;
+			}
+
+			LocalLight light{};
+			light.index = lightIndex;
+			light.center = ToView(position + axis * boundOffset, 1.0f);
+			light.radius = boundRadius;
+			light.spot = true;
+			light.apex = ToView(position, 1.0f);
+			light.axis = mathUtils::Normalize(ToView(axis, 0.0f));
+			light.range = range;
+			light.cosAngle = cosAngle;
+			light.sinAngle = sinAngle;
+			lights_.push_back(light);
+			++stats_.spotLights;
+		}
+
+		// Assigns the lights added since BeginFrame() to clusters and rebuilds the index list.
+		void Build()
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			hits_.clear();
+			std::vector<std::uint32_t>& counts = scratchCounts_;
+			counts.assign(GetClusterCount(), 0u);
+			for (std::uint32_t lightSlot = 0; lightSlot < static_cast<std::uint32_t>(lights_.size()); ++lightSlot)
+			{
+				AssignLight(lightSlot, counts);
+			}
+
+			// Counting sort: cluster lists follow the global prefix, lights keep the order they were added in.
+			const std::uint32_t globalCount = static_cast<std::uint32_t>(globalLights_.size());
+			std::uint32_t offset = globalCount;
+			for (std::size_t cluster = 0; cluster < ranges_.size(); ++cluster)
+			{
+				ranges_[cluster] = ClusterRange{ offset, counts[cluster] };
+				offset += counts[cluster];
+				stats_.occupiedClusters += counts[cluster] != 0u ? 1u : 0u;
+				stats_.maxLightsPerCluster = std::max(stats_.maxLightsPerCluster, counts[cluster]);
+			}
+
+			indices_.resize(offset);
+			std::copy(globalLights_.begin(), globalLights_.end(), indices_.begin());
+			std::fill(counts.begin(), counts.end(), 0u);
+			for (const Hit& hit : hits_)
+			{
+				indices_[ranges_[hit.cluster].offset + counts[hit.cluster]++] = lights_[hit.lightSlot].index;
+			}
+
+			stats_.clusterLightIndices = offset - globalCount;
+			stats_.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		std::uint32_t GetGridX() const noexcept { return gridX_; }
+		std::uint32_t GetGridY() const noexcept { return gridY_; }
+		std::uint32_t GetGridZ() const noexcept { return gridZ_; }
+		std::uint32_t GetClusterCount() const noexcept { return gridX_ * gridY_ * gridZ_; }
+
+		std::uint32_t ClusterIndex(std::uint32_t tileX, std::uint32_t tileY, std::uint32_t slice) const noexcept
+		{
+			return (slice * gridY_ + tileY) * gridX_ + tileX;
+		}
+
+		// Depth slice of a view depth (distance along the camera forward axis), clamped to the grid.
+		std::uint32_t DepthSlice(float viewDepth) const noexcept
+		{
+			if (!(viewDepth > nearZ_))
+			{
+				return 0;
+			}
+			const float slice = std::floor(std::log2(viewDepth) * sliceScale_ + sliceBias_);
+			return static_cast<std::uint32_t>(std::clamp(slice, 0.0f, static_cast<float>(gridZ_ - 1)));
+		}
+
+		float GetSliceScale() const noexcept { return sliceScale_; }
+		float GetSliceBias() const noexcept { return sliceBias_; }
+
+		// View-space bounds of a cluster (valid after BeginFrame()).
+		Aabb GetClusterBounds(std::uint32_t cluster) const
+		{
+			return Aabb{
+				mathUtils::Vec3{ minX_[cluster], minY_[cluster], minZ_[cluster] },
+				mathUtils::Vec3{ maxX_[cluster], maxY_[cluster], maxZ_[cluster] } };
+		}
+
+		std::span<const ClusterRange> GetClusterRanges() const noexcept { return ranges_; }
+		// Global lights first (GetGlobalLightCount() of them), then the per-cluster lists.
+		std::span<const std::uint32_t> GetLightIndices() const noexcept { return indices_; }
+		std::uint32_t GetGlobalLightCount() const noexcept { return static_cast<std::uint32_t>(globalLights_.size()); }
+		const ClusteredLightingStats& GetStats() const noexcept { return stats_; }
+
+	private:
+		struct LocalLight
+		{
+			std::uint32_t index{ 0 };
+			mathUtils::Vec3 center{};  // view-space bounding sphere
+			float radius{ 0.0f };
+			bool spot{ false };
+			mathUtils::Vec3 apex{};    // view space, spot lights only
+			mathUtils::Vec3 axis{};
+			float range{ 0.0f };
+			float cosAngle{ 0.0f };
+			float sinAngle{ 0.0f };
+		};
+
+		struct Hit
+		{
+			std::uint32_t cluster{ 0 };
+			std::uint32_t lightSlot{ 0 };
+		};
+
+		mathUtils::Vec3 ToView(const mathUtils::Vec3& v, float w) const noexcept
+		{
+			const mathUtils::Vec4 r = view_ * mathUtils::Vec4(v, w);
+			return mathUtils::Vec3{ r.x, r.y, r.z };
+		}
+
+		float SliceDepth(std::uint32_t slice) const noexcept
+		{
+			if (slice == 0)
+			{
+				return nearZ_;
+			}
+			if (slice >= gridZ_)
+			{
+				return farZ_;
+			}
+			return nearZ_ * std::pow(farZ_ / nearZ_, static_cast<float>(slice) / static_cast<float>(gridZ_));
+		}
+
+		// View-space x (or y) at depth d of the NDC coordinate `ndc`: inverts ndc = x * proj / d - offset.
+		static float ViewAt(float ndc, float d, float proj, float offset) noexcept
+		{
+			return d * (ndc + offset) / proj;
+		}
+
+		void RebuildClusterBounds()
+		{
+			const std::size_t count = GetClusterCount();
+			for (std::vector<float>* values : { &minX_, &minY_, &minZ_, &maxX_, &maxY_, &maxZ_, &centerX_, &centerY_, &centerZ_, &radius_ })
+			{
+				values->resize(count);
+			}
+
+			for (std::uint32_t slice = 0; slice < gridZ_; ++slice)
+			{
+				const float d0 = SliceDepth(slice);
+				const float d1 = SliceDepth(slice + 1);
+				for (std::uint32_t tileY = 0; tileY < gridY_; ++tileY)
+				{
+					// Tile row 0 is the top of the screen (NDC y = +1).
+					const float ndcTop = 1.0f - 2.0f * static_cast<float>(tileY) / static_cast<float>(gridY_);
+					const float ndcBottom = 1.0f - 2.0f * static_cast<float>(tileY + 1) / static_cast<float>(gridY_);
+					const float y0 = std::min({ ViewAt(ndcBottom, d0, projY_, offsetY_), ViewAt(ndcBottom, d1, projY_, offsetY_), ViewAt(ndcTop, d0, projY_, offsetY_), ViewAt(ndcTop, d1, projY_, offsetY_) });
+					const float y1 = std::max({ ViewAt(ndcBottom, d0, projY_, offsetY_), ViewAt(ndcBottom, d1, projY_, offsetY_), ViewAt(ndcTop, d0, projY_, offsetY_), ViewAt(ndcTop, d1, projY_, offsetY_) });
+					for (std::uint32_t tileX = 0; tileX < gridX_; ++tileX)
+					{
+						const float ndcLeft = -1.0f + 2.0f * static_cast<float>(tileX) / static_cast<float>(gridX_);
+						const float ndcRight = -1.0f + 2.0f * static_cast<float>(tileX + 1) / static_cast<float>(gridX_);
+						const float x0 = std::min({ ViewAt(ndcLeft, d0, projX_, offsetX_), ViewAt(ndcLeft, d1, projX_, offsetX_), ViewAt(ndcRight, d0, projX_, offsetX_), ViewAt(ndcRight, d1, projX_, offsetX_) });
+						const float x1 = std::max({ ViewAt(ndcLeft, d0, projX_, offsetX_), ViewAt(ndcLeft, d1, projX_, offsetX_), ViewAt(ndcRight, d0, projX_, offsetX_), ViewAt(ndcRight, d1, projX_, offsetX_) });
+
+						const std::uint32_t cluster = ClusterIndex(tileX, tileY, slice);
+						minX_[cluster] = x0;
+						minY_[cluster] = y0;
+						minZ_[cluster] = -d1;
+						maxX_[cluster] = x1;
+						maxY_[cluster] = y1;
+						maxZ_[cluster] = -d0;
+
+						const float hx = 0.5f * (x1 - x0);
+						const float hy = 0.5f * (y1 - y0);
+						const float hz = 0.5f * (d1 - d0);
+						centerX_[cluster] = x0 + hx;
+						centerY_[cluster] = y0 + hy;
+						centerZ_[cluster] = -d0 - hz;
+						radius_[cluster] = std::sqrt(hx * hx + hy * hy + hz * hz);
+					}
+				}
+			}
+			boundsValid_ = true;
+		}
+
+		// Tile index covering an NDC coordinate, clamped to [0, tiles - 1].
+		static std::int32_t TileOf(float t, std::uint32_t tiles) noexcept
+		{
+			const float tile = std::floor(t * static_cast<float>(tiles));
+			return static_cast<std::int32_t>(std::clamp(tile, -1.0f, static_cast<float>(tiles)));
+		}
+
+		void AssignLight(std::uint32_t lightSlot, std::vector<std::uint32_t>& counts)
+		{
+			const LocalLight& light = lights_[lightSlot];
+			const float depth = -light.center.z;
+			const float dMin = std::max(depth - light.radius, nearZ_);
+			const float dMax = std::min(depth + light.radius, farZ_);
+			if (dMin > dMax)
+			{
+				++stats_.lightsOutsideGrid;
+				return;
+			}
+
+			// Conservative tile rectangle: NDC = v * proj / d - offset is monotonic in v and in d > 0, so the
+			// corners of the sphere's box in (v, d) bound it.
+			auto NdcRange = [dMin, dMax](float lo, float hi, float proj, float offset, float& outMin, float& outMax)
+				{
+					const float a = lo * proj / dMin - offset;
+					const float b = lo * proj / dMax - offset;
+					const float c = hi * proj / dMin - offset;
+					const float e = hi * proj / dMax - offset;
+					outMin = std::min({ a, b, c, e });
+					outMax = std::max({ a, b, c, e });
+				};
+			float ndcMinX = 0.0f, ndcMaxX = 0.0f, ndcMinY = 0.0f, ndcMaxY = 0.0f;
+			NdcRange(light.center.x - light.radius, light.center.x + light.radius, projX_, offsetX_, ndcMinX, ndcMaxX);
+			NdcRange(light.center.y - light.radius, light.center.y + light.radius, projY_, offsetY_, ndcMinY, ndcMaxY);
+
+			const std::int32_t tileX0 = std::max(TileOf((ndcMinX + 1.0f) * 0.5f, gridX_), 0);
+			const std::int32_t tileX1 = std::min(TileOf((ndcMaxX + 1.0f) * 0.5f, gridX_), static_cast<std::int32_t>(gridX_) - 1);
+			const std::int32_t tileY0 = std::max(TileOf((1.0f - ndcMaxY) * 0.5f, gridY_), 0);
+			const std::int32_t tileY1 = std::min(TileOf((1.0f - ndcMinY) * 0.5f, gridY_), static_cast<std::int32_t>(gridY_) - 1);
+			if (tileX0 > tileX1 || tileY0 > tileY1)
+			{
+				++stats_.lightsOutsideGrid;
+				return;
+			}
+
+			const std::uint32_t slice0 = DepthSlice(dMin);
+			const std::uint32_t slice1 = DepthSlice(dMax);
+			for (std::uint32_t slice = slice0; slice <= slice1; ++slice)
+			{
+				for (std::int32_t tileY = tileY0; tileY <= tileY1; ++tileY)
+				{
+					const std::uint32_t rowFirst = ClusterIndex(static_cast<std::uint32_t>(tileX0), static_cast<std::uint32_t>(tileY), slice);
+					const std::uint32_t rowCount = static_cast<std::uint32_t>(tileX1 - tileX0 + 1);
+					TestRow(light, lightSlot, rowFirst, rowCount, counts);
+				}
+			}
+		}
+
+		void Accept(std::uint32_t cluster, std::uint32_t lightSlot, std::vector<std::uint32_t>& counts)
+		{
+			hits_.push_back(Hit{ cluster, lightSlot });
+			++counts[cluster];
+		}
+
+		bool TestCluster(const LocalLight& light, std::uint32_t cluster) const noexcept
+		{
+			const float dx = std::max({ minX_[cluster] - light.center.x, 0.0f, light.center.x - maxX_[cluster] });
+			const float dy = std::max({ minY_[cluster] - light.center.y, 0.0f, light.center.y - maxY_[cluster] });
+			const float dz = std::max({ minZ_[cluster] - light.center.z, 0.0f, light.center.z - maxZ_[cluster] });
+			if (dx * dx + dy * dy + dz * dz > light.radius * light.radius)
+			{
+				return false;
+			}
+			if (!light.spot)
+			{
+				return true;
+			}
+
+			// Cone against the cluster's bounding sphere.
+			const float vx = centerX_[cluster] - light.apex.x;
+			const float vy = centerY_[cluster] - light.apex.y;
+			const float vz = centerZ_[cluster] - light.apex.z;
+			const float lengthSq = vx * vx + vy * vy + vz * vz;
+			const float along = vx * light.axis.x + vy * light.axis.y + vz * light.axis.z;
+			const float across = std::sqrt(std::max(lengthSq - along * along, 0.0f));
+			const float distance = light.cosAngle * across - along * light.sinAngle;
+			const float r = radius_[cluster];
+			return !(distance > r || along > r + light.range || along < -r);
+		}
+
+		void TestRow(const LocalLight& light, std::uint32_t lightSlot, std::uint32_t first, std::uint32_t count, std::vector<std::uint32_t>& counts)
+		{
+			stats_.clusterTests += count;
+			std::uint32_t i = 0;
+#if defined(CORE_CLUSTER_SSE2)
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 cx = _mm_set1_ps(light.center.x);
+			const __m128 cy = _mm_set1_ps(light.center.y);
+			const __m128 cz = _mm_set1_ps(light.center.z);
+			const __m128 r2 = _mm_set1_ps(light.radius * light.radius);
+			const __m128 ax = _mm_set1_ps(light.apex.x);
+			const __m128 ay = _mm_set1_ps(light.apex.y);
+			const __m128 az = _mm_set1_ps(light.apex.z);
+			const __m128 nx = _mm_set1_ps(light.axis.x);
+			const __m128 ny = _mm_set1_ps(light.axis.y);
+			const __m128 nz = _mm_set1_ps(light.axis.z);
+			const __m128 cosA = _mm_set1_ps(light.cosAngle);
+			const __m128 sinA = _mm_set1_ps(light.sinAngle);
+			const __m128 range = _mm_set1_ps(light.range);
+			for (; i + 4 <= count; i += 4)
+			{
+				const std::uint32_t c = first + i;
+				const __m128 dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minX_[c]), cx), _mm_sub_ps(cx, _mm_loadu_ps(&maxX_[c]))), zero);
+				const __m128 dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minY_[c]), cy), _mm_sub_ps(cy, _mm_loadu_ps(&maxY_[c]))), zero);
+				const __m128 dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&minZ_[c]), cz), _mm_sub_ps(cz, _mm_loadu_ps(&maxZ_[c]))), zero);
+				const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+				__m128 pass = _mm_cmple_ps(distSq, r2);
+
+				if (light.spot && _mm_movemask_ps(pass) != 0)
+				{
+					const __m128 vx = _mm_sub_ps(_mm_loadu_ps(&centerX_[c]), ax);
+					const __m128 vy = _mm_sub_ps(_mm_loadu_ps(&centerY_[c]), ay);
+					const __m128 vz = _mm_sub_ps(_mm_loadu_ps(&centerZ_[c]), az);
+					const __m128 r = _mm_loadu_ps(&radius_[c]);
+					const __m128 lengthSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+					const __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, nx), _mm_mul_ps(vy, ny)), _mm_mul_ps(vz, nz));
+					const __m128 across = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSq, _mm_mul_ps(along, along)), zero));
+					const __m128 distance = _mm_sub_ps(_mm_mul_ps(cosA, across), _mm_mul_ps(along, sinA));
+					pass = _mm_and_ps(pass, _mm_cmple_ps(distance, r));
+					pass = _mm_and_ps(pass, _mm_cmple_ps(along, _mm_add_ps(r, range)));
+					pass = _mm_and_ps(pass, _mm_cmpge_ps(along, _mm_sub_ps(zero, r)));
+				}
+
+				const int mask = _mm_movemask_ps(pass);
+				for (int lane = 0; lane < 4; ++lane)
+				{
+					if ((mask >> lane) & 1)
+					{
+						Accept(c + static_cast<std::uint32_t>(lane), lightSlot, counts);
+					}
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				if (TestCluster(light, first + i))
+				{
+					Accept(first + i, lightSlot, counts);
+				}
+			}
+		}
+
+		std::uint32_t gridX_{ 0 };
+		std::uint32_t gridY_{ 0 };
+		std::uint32_t gridZ_{ 0 };
+
+		mathUtils::Mat4 view_{ 1.0f };
+		float projX_{ 0.0f };
+		float projY_{ 0.0f };
+		float offsetX_{ 0.0f };
+		float offsetY_{ 0.0f };
+		float nearZ_{ 0.0f };
+		float farZ_{ 0.0f };
+		float sliceScale_{ 0.0f };
+		float sliceBias_{ 0.0f };
+		bool boundsValid_{ false };
+
+		// Cluster AABBs and bounding spheres in view space, SoA, indexed by ClusterIndex().
+		std::vector<float> minX_, minY_, minZ_, maxX_, maxY_, maxZ_;
+		std::vector<float> centerX_, centerY_, centerZ_, radius_;
+
+		std::vector<LocalLight> lights_;
+		std::vector<std::uint32_t> globalLights_;
+		std::vector<Hit> hits_;
+		std::vector<std::uint32_t> scratchCounts_;
+		std::vector<ClusterRange> ranges_;
+		std::vector<std::uint32_t> indices_;
+		ClusteredLightingStats stats_{};
+	};
+}
@@ -4,6 +4,7 @@ module;
 #include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
 #include <optional>
 #include <array>
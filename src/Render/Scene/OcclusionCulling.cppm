@@ -0,0 +1,589 @@
+module;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CORE_OCCLUSION_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+export module core:occlusion_culling;
+
+import :math_utils;
+import :resource_manager_core;
+import :scene_bvh;
+
+// CPU occlusion culling against a coarse depth buffer.
+//
+// The best occluders of a frame (artist-flagged ones first, then by projected size) are rasterized into
+// a small depth buffer, one band of kOcclusionTileSize rows per job. Every covered pixel takes the farthest
+// depth of the triangle covering it, and the buffer keeps the smallest such value. Each 8x8 tile also
+// stores its farthest depth, so a world AABB is rejected tile by tile and only tiles that may show it are
+// checked per pixel. Depth is ZO (0 = near, 1 = far), as produced by *RH_ZO matrices.
+//
+// The buffer never reports an object hidden when the GPU would draw part of it, up to one coarse pixel
+// at occluder silhouettes: occluders write the farthest depth their triangle can have, only back-facing
+// triangles (culled by the GPU as well) are skipped, and occludee rectangles are grown by a pixel.
+
+export namespace rendern
+{
+	inline constexpr std::uint32_t kOcclusionTileSize = 8;
+
+	struct OcclusionCullingStats
+	{
+		std::uint32_t occluderCandidates{ 0 };
+		std::uint32_t occludersRasterized{ 0 };
+		std::uint64_t trianglesRasterized{ 0 };
+		std::uint32_t objectsTested{ 0 };
+		std::uint32_t objectsCulled{ 0 };
+		double rasterMs{ 0.0 };
+		double testMs{ 0.0 };
+	};
+
+	// Which rasterizer loop this build uses; benchmarks report it next to their timings.
+	constexpr std::string_view OcclusionRasterSimdPath() noexcept
+	{
+#if defined(CORE_OCCLUSION_SSE2)
+		return "SSE2";
+#else
+		return "Scalar";
+#endif
+	}
+
+	class SoftwareOcclusionCuller
+	{
+	public:
+		explicit SoftwareOcclusionCuller(std::uint32_t width = 256, std::uint32_t height = 128)
+		{
+			Resize(width, height);
+		}
+
+		void Resize(std::uint32_t width, std::uint32_t height)
+		{
+			if (width == 0 || height == 0)
+			{
+				throw std::runtime_error("SoftwareOcclusionCuller: depth buffer size must be non-zero");
+			}
+			width_ = width;
+			height_ = height;
+			tilesX_ = (width + kOcclusionTileSize - 1) / kOcclusionTileSize;
+			tilesY_ = (height + kOcclusionTileSize - 1) / kOcclusionTileSize;
+			depth_.assign(static_cast<std::size_t>(width_) * height_, 1.0f);
+			tileMaxDepth_.assign(static_cast<std::size_t>(tilesX_) * tilesY_, 1.0f);
+			bandTriangles_.assign(tilesY_, {});
+		}
+
+		// Bands and occludee chunks run on `jobs` (at most `maxJobs` helper jobs plus the calling thread);
+		// nullptr runs everything on the calling thread.
+		void SetJobSystem(IJobSystem* jobs, std::uint32_t maxJobs) noexcept
+		{
+			jobs_ = jobs;
+			maxJobs_ = maxJobs;
+		}
+
+		// Clears the depth buffer and the occluder list. `viewProj` maps world space to RH_ZO clip space.
+		void BeginFrame(const mathUtils::Mat4& viewProj)
+		{
+			viewProj_ = viewProj;
+			occluders_.clear();
+			stats_ = {};
+			std::fill(depth_.begin(), depth_.end(), 1.0f);
+			std::fill(tileMaxDepth_.begin(), tileMaxDepth_.end(), 1.0f);
+		}
+
+		// Registers an occluder candidate: a triangle list (three indices per triangle) in model space with
+		// its world bounding sphere. `positions` and `indices` must stay alive until RasterizeOccluders().
+		void AddOccluder(
+			std::span<const mathUtils::Vec3> positions,
+			std::span<const std::uint32_t> indices,
+			const mathUtils::Mat4& model,
+			const mathUtils::Vec3& worldCenter,
+			float worldRadius,
+			bool forced = false)
+		{
+			if (positions.empty() || indices.size() < 3)
+			{
+				return;
+			}
+
+			// Projected size ~ radius / view depth; a sphere around the eye covers the whole screen.
+			const mathUtils::Vec4 clipCenter = viewProj_ * mathUtils::Vec4(worldCenter, 1.0f);
+			const float score = (clipCenter.w <= worldRadius)
+				? std::numeric_limits<float>::infinity()
+				: worldRadius / clipCenter.w;
+
+			occluders_.push_back(Occluder{ positions, indices, model, score, forced });
+			++stats_.occluderCandidates;
+		}
+
+		// Rasterizes the `maxOccluders` best candidates: forced ones first, then the largest on screen.
+		void RasterizeOccluders(std::uint32_t maxOccluders)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			const std::size_t count = std::min<std::size_t>(maxOccluders, occluders_.size());
+			std::partial_sort(occluders_.begin(), occluders_.begin() + static_cast<std::ptrdiff_t>(count), occluders_.end(),
+				[](const Occluder& a, const Occluder& b)
+				{
+					if (a.forced != b.forced)
+					{
+						return a.forced;
+					}
+					return a.score > b.score;
+				});
+
+			triangles_.clear();
+			for (std::vector<std::uint32_t>& band : bandTriangles_)
+			{
+				band.clear();
+			}
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				SetupOccluder(occluders_[i]);
+			}
+
+			if (!triangles_.empty())
+			{
+				ParallelFor(tilesY_, [this](std::size_t band) { RasterBand(static_cast<std::uint32_t>(band)); });
+			}
+
+			stats_.occludersRasterized += static_cast<std::uint32_t>(count);
+			stats_.trianglesRasterized += triangles_.size();
+			stats_.rasterMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		// False when every pixel the box may cover is in front of it.
+		bool IsVisible(const Aabb& worldBox) const noexcept
+		{
+			float minX = std::numeric_limits<float>::max();
+			float minY = std::numeric_limits<float>::max();
+			float maxX = std::numeric_limits<float>::lowest();
+			float maxY = std::numeric_limits<float>::lowest();
+			float minZ = std::numeric_limits<float>::max();
+			// Corners as the min corner plus scaled matrix columns: one full transform per box.
+			const mathUtils::Vec4 base = viewProj_ * mathUtils::Vec4(worldBox.min, 1.0f);
+			const mathUtils::Vec4 extentX = viewProj_[0] * (worldBox.max.x - worldBox.min.x);
+			const mathUtils::Vec4 extentY = viewProj_[1] * (worldBox.max.y - worldBox.min.y);
+			const mathUtils::Vec4 extentZ = viewProj_[2] * (worldBox.max.z - worldBox.min.z);
+			for (std::uint32_t corner = 0; corner < 8; ++corner)
+			{
+				mathUtils::Vec4 clip = base;
+				if (corner & 1u) { clip = clip + extentX; }
+				if (corner & 2u) { clip = clip + extentY; }
+				if (corner & 4u) { clip = clip + extentZ; }
+				if (clip.z < 0.0f || clip.w <= kMinClipW)
+				{
+					// Crosses the near plane: treat as visible.
+					return true;
+				}
+				const float invW = 1.0f / clip.w;
+				const float sx = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+				const float sy = (0.5f - clip.y * invW * 0.5f) * static_cast<float>(height_);
+				minX = std::min(minX, sx);
+				maxX = std::max(maxX, sx);
+				minY = std::min(minY, sy);
+				maxY = std::max(maxY, sy);
+				minZ = std::min(minZ, clip.z * invW);
+			}
+
+			// Pixels whose centres lie within one pixel of the rectangle: occluder coverage is sampled at pixel
+			// centres, so a box peeking past a silhouette by less than a pixel still reaches an uncovered pixel.
+			const float w = static_cast<float>(width_);
+			const float h = static_cast<float>(height_);
+			const std::int32_t px0 = static_cast<std::int32_t>(std::ceil(std::clamp(minX - 1.5f, -1.0f, w)));
+			const std::int32_t px1 = static_cast<std::int32_t>(std::floor(std::clamp(maxX + 0.5f, -1.0f, w)));
+			const std::int32_t py0 = static_cast<std::int32_t>(std::ceil(std::clamp(minY - 1.5f, -1.0f, h)));
+			const std::int32_t py1 = static_cast<std::int32_t>(std::floor(std::clamp(maxY + 0.5f, -1.0f, h)));
+			const std::int32_t x0 = std::max(px0, 0);
+			const std::int32_t y0 = std::max(py0, 0);
+			const std::int32_t x1 = std::min(px1, static_cast<std::int32_t>(width_) - 1);
+			const std::int32_t y1 = std::min(py1, static_cast<std::int32_t>(height_) - 1);
+			if (x0 > x1 || y0 > y1)
+			{
+				return true;
+			}
+
+			const std::int32_t tile = static_cast<std::int32_t>(kOcclusionTileSize);
+			for (std::int32_t ty = y0 / tile; ty <= y1 / tile; ++ty)
+			{
+				for (std::int32_t tx = x0 / tile; tx <= x1 / tile; ++tx)
+				{
+					if (minZ > tileMaxDepth_[static_cast<std::size_t>(ty) * tilesX_ + static_cast<std::size_t>(tx)])
+					{
+						continue;
+					}
+
+					const std::int32_t rowBegin = std::max(y0, ty * tile);
+					const std::int32_t rowEnd = std::min(y1, ty * tile + tile - 1);
+					const std::int32_t colBegin = std::max(x0, tx * tile);
+					const std::int32_t colEnd = std::min(x1, tx * tile + tile - 1);
+					for (std::int32_t y = rowBegin; y <= rowEnd; ++y)
+					{
+						const float* row = depth_.data() + static_cast<std::size_t>(y) * width_;
+						for (std::int32_t x = colBegin; x <= colEnd; ++x)
+						{
+							if (minZ <= row[x])
+							{
+								return true;
+							}
+						}
+					}
+				}
+			}
+			return false;
+		}
+
+		// outVisible[i] = IsVisible(boxes[i]); chunks of boxes are tested in parallel.
+		void TestVisibility(std::span<const Aabb> boxes, std::span<std::uint8_t> outVisible)
+		{
+			if (outVisible.size() < boxes.size())
+			{
+				throw std::runtime_error("SoftwareOcclusionCuller: visibility span is smaller than the box count");
+			}
+
+			const auto start = std::chrono::steady_clock::now();
+			constexpr std::size_t kChunk = 256;
+			std::atomic<std::uint32_t> culled{ 0 };
+			ParallelFor((boxes.size() + kChunk - 1) / kChunk, [this, boxes, outVisible, &culled](std::size_t chunk)
+				{
+					const std::size_t begin = chunk * kChunk;
+					const std::size_t end = std::min(boxes.size(), begin + kChunk);
+					std::uint32_t chunkCulled = 0;
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						const bool visible = IsVisible(boxes[i]);
+						outVisible[i] = visible ? 1u : 0u;
+						chunkCulled += visible ? 0u : 1u;
+					}
+					culled.fetch_add(chunkCulled, std::memory_order_relaxed);
+				});
+
+			stats_.objectsTested += static_cast<std::uint32_t>(boxes.size());
+			stats_.objectsCulled += culled.load();
+			stats_.testMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		std::uint32_t GetWidth() const noexcept { return width_; }
+		std::uint32_t GetHeight() const noexcept { return height_; }
+		// Row-major, top row first.
+		std::span<const float> GetDepth() const noexcept { return depth_; }
+		const OcclusionCullingStats& GetStats() const noexcept { return stats_; }
+
+	private:
+		static constexpr float kMinClipW = 1e-6f;
+
+		struct Occluder
+		{
+			std::span<const mathUtils::Vec3> positions;
+			std::span<const std::uint32_t> indices;
+			mathUtils::Mat4 model{};
+			float score{ 0.0f };
+			bool forced{ false };
+		};
+
+		// Edge functions are >= 0 inside; depth is a plane in screen space, biased to the farthest value
+		// inside a pixel and clamped to the farthest vertex.
+		struct Triangle
+		{
+			std::array<float, 3> edgeA{};
+			std::array<float, 3> edgeB{};
+			std::array<float, 3> edgeC{};
+			float zA{ 0.0f };
+			float zB{ 0.0f };
+			float zC{ 0.0f };
+			float zMax{ 0.0f };
+			std::int32_t minX{ 0 };
+			std::int32_t maxX{ 0 };
+			std::int32_t minY{ 0 };
+			std::int32_t maxY{ 0 };
+		};
+
+		struct ScreenVertex
+		{
+			float x{ 0.0f };
+			float y{ 0.0f };
+			float z{ 0.0f };
+		};
+
+		// Same work-sharing scheme as the software rasterizer's tiles: helpers and the calling thread pull
+		// items from a counter; the calling thread waits for items, not for helper jobs.
+		struct ParallelWork
+		{
+			std::function<void(std::size_t)> run;
+			std::size_t count{ 0 };
+			std::atomic<std::size_t> next{ 0 };
+			std::atomic<std::size_t> done{ 0 };
+			std::mutex errorMutex;
+			std::exception_ptr error;
+
+			void Drain()
+			{
+				for (std::size_t item = next.fetch_add(1); item < count; item = next.fetch_add(1))
+				{
+					try
+					{
+						run(item);
+					}
+					catch (...)
+					{
+						std::scoped_lock lock(errorMutex);
+						if (!error)
+						{
+							error = std::current_exception();
+						}
+					}
+					if (done.fetch_add(1) + 1 == count)
+					{
+						done.notify_all();
+					}
+				}
+			}
+		};
+
+		void ParallelFor(std::size_t count, std::function<void(std::size_t)> run)
+		{
+			const std::size_t helperJobs = (jobs_ && count > 1) ? std::min<std::size_t>(maxJobs_, count - 1) : 0;
+			if (helperJobs == 0)
+			{
+				for (std::size_t item = 0; item < count; ++item)
+				{
+					run(item);
+				}
+				return;
+			}
+
+			auto work = std::make_shared<ParallelWork>();
+			work->run = std::move(run);
+			work->count = count;
+			for (std::size_t job = 0; job < helperJobs; ++job)
+			{
+				jobs_->Enqueue([work]() { work->Drain(); });
+			}
+			work->Drain();
+			for (std::size_t done = work->done.load(); done < work->count; done = work->done.load())
+			{
+				work->done.wait(done);
+			}
+			if (work->error)
+			{
+				std::rethrow_exception(work->error);
+			}
+		}
+
+		void SetupOccluder(const Occluder& occluder)
+		{
+			const mathUtils::Mat4 modelViewProj = viewProj_ * occluder.model;
+			clipScratch_.resize(occluder.positions.size());
+			for (std::size_t i = 0; i < occluder.positions.size(); ++i)
+			{
+				clipScratch_[i] = modelViewProj * mathUtils::Vec4(occluder.positions[i], 1.0f);
+			}
+
+			const std::size_t vertexCount = clipScratch_.size();
+			for (std::size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+			{
+				const std::uint32_t i0 = occluder.indices[i];
+				const std::uint32_t i1 = occluder.indices[i + 1];
+				const std::uint32_t i2 = occluder.indices[i + 2];
+				if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+				{
+					throw std::runtime_error("SoftwareOcclusionCuller: occluder index out of range");
+				}
+
+				// Clip against the ZO near plane (z >= 0); a triangle becomes at most a quad.
+				const std::array<mathUtils::Vec4, 3> in{ clipScratch_[i0], clipScratch_[i1], clipScratch_[i2] };
+				std::array<mathUtils::Vec4, 4> poly{};
+				std::size_t polyCount = 0;
+				for (std::size_t v = 0; v < 3; ++v)
+				{
+					const mathUtils::Vec4& a = in[v];
+					const mathUtils::Vec4& b = in[(v + 1) % 3];
+					if (a.z >= 0.0f)
+					{
+						poly[polyCount++] = a;
+					}
+					if ((a.z >= 0.0f) != (b.z >= 0.0f))
+					{
+						const float t = a.z / (a.z - b.z);
+						poly[polyCount++] = a + (b - a) * t;
+					}
+				}
+				if (polyCount < 3)
+				{
+					continue;
+				}
+
+				std::array<ScreenVertex, 4> screen{};
+				bool valid = true;
+				for (std::size_t v = 0; v < polyCount; ++v)
+				{
+					if (poly[v].w <= kMinClipW)
+					{
+						valid = false;
+						break;
+					}
+					const float invW = 1.0f / poly[v].w;
+					screen[v].x = (poly[v].x * invW * 0.5f + 0.5f) * static_cast<float>(width_);
+					screen[v].y = (0.5f - poly[v].y * invW * 0.5f) * static_cast<float>(height_);
+					screen[v].z = poly[v].z * invW;
+				}
+				if (!valid)
+				{
+					continue;
+				}
+
+				AddTriangle(screen[0], screen[1], screen[2]);
+				if (polyCount == 4)
+				{
+					AddTriangle(screen[0], screen[2], screen[3]);
+				}
+			}
+		}
+
+		void AddTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2)
+		{
+			// Y points down in screen space, so counter-clockwise (front-facing) in NDC has a negative area here.
+			const float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+			if (!(area < 0.0f))
+			{
+				return;
+			}
+
+			Triangle triangle{};
+			const std::array<const ScreenVertex*, 3> v{ &v0, &v1, &v2 };
+			for (std::size_t e = 0; e < 3; ++e)
+			{
+				const ScreenVertex& a = *v[e];
+				const ScreenVertex& b = *v[(e + 1) % 3];
+				triangle.edgeA[e] = b.y - a.y;
+				triangle.edgeB[e] = a.x - b.x;
+				triangle.edgeC[e] = -(triangle.edgeA[e] * a.x + triangle.edgeB[e] * a.y);
+			}
+
+			triangle.zA = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+			triangle.zB = ((v1.x - v0.x) * (v2.z - v0.z) - (v2.x - v0.x) * (v1.z - v0.z)) / area;
+			triangle.zC = v0.z - triangle.zA * v0.x - triangle.zB * v0.y + 0.5f * (std::abs(triangle.zA) + std::abs(triangle.zB));
+			triangle.zMax = std::max(v0.z, std::max(v1.z, v2.z));
+
+			// Pixels whose centres fall inside the bounding box.
+			const float w = static_cast<float>(width_);
+			const float h = static_cast<float>(height_);
+			triangle.minX = std::max(0, static_cast<std::int32_t>(std::ceil(std::clamp(std::min(v0.x, std::min(v1.x, v2.x)) - 0.5f, -1.0f, w))));
+			triangle.maxX = std::min(static_cast<std::int32_t>(width_) - 1, static_cast<std::int32_t>(std::floor(std::clamp(std::max(v0.x, std::max(v1.x, v2.x)) - 0.5f, -1.0f, w))));
+			triangle.minY = std::max(0, static_cast<std::int32_t>(std::ceil(std::clamp(std::min(v0.y, std::min(v1.y, v2.y)) - 0.5f, -1.0f, h))));
+			triangle.maxY = std::min(static_cast<std::int32_t>(height_) - 1, static_cast<std::int32_t>(std::floor(std::clamp(std::max(v0.y, std::max(v1.y, v2.y)) - 0.5f, -1.0f, h))));
+			if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+			{
+				return;
+			}
+
+			const std::uint32_t index = static_cast<std::uint32_t>(triangles_.size());
+			triangles_.push_back(triangle);
+			for (std::int32_t band = triangle.minY / static_cast<std::int32_t>(kOcclusionTileSize);
+				band <= triangle.maxY / static_cast<std::int32_t>(kOcclusionTileSize); ++band)
+			{
+				bandTriangles_[static_cast<std::size_t>(band)].push_back(index);
+			}
+		}
+
+		void RasterBand(std::uint32_t band)
+		{
+			const std::int32_t bandY0 = static_cast<std::int32_t>(band * kOcclusionTileSize);
+			const std::int32_t bandY1 = std::min(static_cast<std::int32_t>(height_), bandY0 + static_cast<std::int32_t>(kOcclusionTileSize)) - 1;
+
+			for (const std::uint32_t index : bandTriangles_[band])
+			{
+				const Triangle& t = triangles_[index];
+				const std::int32_t y0 = std::max(t.minY, bandY0);
+				const std::int32_t y1 = std::min(t.maxY, bandY1);
+				for (std::int32_t y = y0; y <= y1; ++y)
+				{
+					const float py = static_cast<float>(y) + 0.5f;
+					const float rowE0 = t.edgeB[0] * py + t.edgeC[0];
+					const float rowE1 = t.edgeB[1] * py + t.edgeC[1];
+					const float rowE2 = t.edgeB[2] * py + t.edgeC[2];
+					const float rowZ = t.zB * py + t.zC;
+					float* row = depth_.data() + static_cast<std::size_t>(y) * width_;
+
+					std::int32_t x = t.minX;
+#if defined(CORE_OCCLUSION_SSE2)
+					const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+					const __m128 zero = _mm_setzero_ps();
+					for (; x + 3 <= t.maxX; x += 4)
+					{
+						const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), laneOffsets);
+						const __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.edgeA[0]), px), _mm_set1_ps(rowE0));
+						const __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.edgeA[1]), px), _mm_set1_ps(rowE1));
+						const __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.edgeA[2]), px), _mm_set1_ps(rowE2));
+						const __m128 inside = _mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_and_ps(_mm_cmpge_ps(e1, zero), _mm_cmpge_ps(e2, zero)));
+						if (_mm_movemask_ps(inside) == 0)
+						{
+							continue;
+						}
+						const __m128 z = _mm_min_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(t.zA), px), _mm_set1_ps(rowZ)), _mm_set1_ps(t.zMax));
+						const __m128 old = _mm_loadu_ps(row + x);
+						const __m128 nearest = _mm_min_ps(old, z);
+						_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, old)));
+					}
+#endif
+					for (; x <= t.maxX; ++x)
+					{
+						const float px = static_cast<float>(x) + 0.5f;
+						if (t.edgeA[0] * px + rowE0 >= 0.0f && t.edgeA[1] * px + rowE1 >= 0.0f && t.edgeA[2] * px + rowE2 >= 0.0f)
+						{
+							row[x] = std::min(row[x], std::min(t.zA * px + rowZ, t.zMax));
+						}
+					}
+				}
+			}
+
+			// Farthest depth per tile of this band.
+			for (std::uint32_t tx = 0; tx < tilesX_; ++tx)
+			{
+				const std::uint32_t x0 = tx * kOcclusionTileSize;
+				const std::uint32_t x1 = std::min(width_, x0 + kOcclusionTileSize);
+				float farthest = 0.0f;
+				for (std::int32_t y = bandY0; y <= bandY1; ++y)
+				{
+					const float* row = depth_.data() + static_cast<std::size_t>(y) * width_;
+					for (std::uint32_t x = x0; x < x1; ++x)
+					{
+						farthest = std::max(farthest, row[x]);
+					}
+				}
+				tileMaxDepth_[static_cast<std::size_t>(band) * tilesX_ + tx] = farthest;
+			}
+		}
+
+		std::uint32_t width_{ 0 };
+		std::uint32_t height_{ 0 };
+		std::uint32_t tilesX_{ 0 };
+		std::uint32_t tilesY_{ 0 };
+		mathUtils::Mat4 viewProj_{ 1.0f };
+		IJobSystem* jobs_{ nullptr };
+		std::uint32_t maxJobs_{ 0 };
+
+		std::vector<float> depth_;
+		std::vector<float> tileMaxDepth_;
+		std::vector<Occluder> occluders_;
+		std::vector<mathUtils::Vec4> clipScratch_;
+		std::vector<Triangle> triangles_;
+		std::vector<std::vector<std::uint32_t>> bandTriangles_;
+		OcclusionCullingStats stats_{};
+	};
+}
@@ -12,76 +12,10 @@ import :level;
 import :level_ecs;
 import :math_utils;
 import :geometry;
+import :scene_bvh;
 
 namespace
 {
-    static void TransformAABB(const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, const mathUtils::Mat4& m,
-        mathUtils::Vec3& outMin, mathUtils::Vec3& outMax) noexcept
-    {
-        const mathUtils::Vec3 c[8] =
-        {
-            { bmin.x, bmin.y, bmin.z }, { bmax.x, bmin.y, bmin.z }, { bmin.x, bmax.y, bmin.z }, { bmax.x, bmax.y, bmin.z },
-            { bmin.x, bmin.y, bmax.z }, { bmax.x, bmin.y, bmax.z }, { bmin.x, bmax.y, bmax.z }, { bmax.x, bmax.y, bmax.z },
-        };
-
-        mathUtils::Vec3 wmin{ std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
-        mathUtils::Vec3 wmax{ -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
-
-        for (const auto& p : c)
-        {
-            const mathUtils::Vec3 wp = mathUtils::TransformPoint(m, p);
-            wmin = mathUtils::MinVec3(wmin, wp);
-            wmax = mathUtils::MaxVec3(wmax, wp);
-        }
-
-        outMin = wmin;
-        outMax = wmax;
-    }
-
-    static bool IntersectRayAABB(const geometry::Ray& ray, const mathUtils::Vec3& bmin, const mathUtils::Vec3& bmax, float& outT) noexcept
-    {
-        float tmin = 0.0f;
-        float tmax = std::numeric_limits<float>::infinity();
-
-        const float o[3] = { ray.origin.x, ray.origin.y, ray.origin.z };
-        const float d[3] = { ray.dir.x, ray.dir.y, ray.dir.z };
-        const float mn[3] = { bmin.x, bmin.y, bmin.z };
-        const float mx[3] = { bmax.x, bmax.y, bmax.z };
-
-        for (int axis = 0; axis < 3; ++axis)
-        {
-            const float dir = d[axis];
-            const float ori = o[axis];
-
-            if (std::abs(dir) < 1e-8f)
-            {
-                if (ori < mn[axis] || ori > mx[axis])
-                {
-                    return false;
-                }
-                continue;
-            }
-
-            const float invD = 1.0f / dir;
-            float t1 = (mn[axis] - ori) * invD;
-            float t2 = (mx[axis] - ori) * invD;
-            if (t1 > t2)
-            {
-                std::swap(t1, t2);
-            }
-
-            tmin = std::max(tmin, t1);
-            tmax = std::min(tmax, t2);
-            if (tmin > tmax)
-            {
-                return false;
-            }
-        }
-
-        outT = tmin;
-        return true;
-    }
-
     static bool IntersectRaySphere(const geometry::Ray& ray, const mathUtils::Vec3& center, float radius, float& outT) noexcept
     {
         const mathUtils::Vec3 oc = ray.origin - center;
@@ -109,6 +43,77 @@ namespace
     }
 }
 
+namespace rendern
+{
+    // Emitters and lights have no draw items; they are tested against pick spheres on top of the mesh hit.
+    void PickEmittersAndLights(
+        const rendern::Scene& scene,
+        const rendern::LevelInstance& levelInst,
+        const geometry::Ray& ray,
+        float& bestT,
+        int& bestNode,
+        int& bestEmitter,
+        int& bestLight) noexcept
+    {
+        for (std::size_t emitterIndex = 0; emitterIndex < levelInst.GetParticleEmitterCount(); ++emitterIndex)
+        {
+            const ParticleEmitter* emitter = levelInst.GetRuntimeParticleEmitter(scene, static_cast<int>(emitterIndex));
+            if (!emitter || !emitter->enabled)
+            {
+                continue;
+            }
+
+            const float jitterRadius = std::max(std::max(std::abs(emitter->positionJitter.x), std::abs(emitter->positionJitter.y)), std::abs(emitter->positionJitter.z));
+            const float velocityExtent = std::max(std::max(
+                std::max(std::abs(emitter->velocityMin.x), std::abs(emitter->velocityMax.x)),
+                std::max(std::abs(emitter->velocityMin.y), std::abs(emitter->velocityMax.y))),
+                std::max(std::abs(emitter->velocityMin.z), std::abs(emitter->velocityMax.z)));
+            const float maxLifetime = std::max(emitter->lifetimeMin, emitter->lifetimeMax);
+            const float radius = std::max(0.35f, jitterRadius + velocityExtent * std::max(0.25f, maxLifetime) + std::max(emitter->sizeBegin, emitter->sizeEnd));
+
+            float t = 0.0f;
+            if (!IntersectRaySphere(ray, emitter->position, radius, t))
+            {
+                continue;
+            }
+
+            if (t < bestT)
+            {
+                bestT = t;
+                bestNode = -1;
+                bestEmitter = static_cast<int>(emitterIndex);
+                bestLight = -1;
+            }
+        }
+
+        for (std::size_t lightIndex = 0; lightIndex < scene.lights.size(); ++lightIndex)
+        {
+            const Light& light = scene.lights[lightIndex];
+            if (light.type != LightType::Point && light.type != LightType::Spot)
+            {
+                continue;
+            }
+
+            const float distToCamera = mathUtils::Length(scene.camera.position - light.position);
+            const float pickRadius = std::clamp(distToCamera * 0.04f, 0.15f, 1.5f);
+
+            float t = 0.0f;
+            if (!IntersectRaySphere(ray, light.position, pickRadius, t))
+            {
+                continue;
+            }
+
+            if (t < bestT)
+            {
+                bestT = t;
+                bestNode = -1;
+                bestEmitter = -1;
+                bestLight = static_cast<int>(lightIndex);
+            }
+        }
+    }
+}
+
 export namespace rendern
 {
     struct PickResult
@@ -179,7 +184,7 @@ export namespace rendern
                     return;
                 }
 
-                mathUtils::Vec3 wmin{}, wmax{};
+                Aabb worldBox{};
                 if (renderable.isSkinned)
                 {
                     const SkinnedDrawItem* skinned = levelInst.GetSkinnedDrawItem(scene, renderable.skinnedDrawIndex);
@@ -192,7 +197,7 @@ export namespace rendern
                         (skinned->asset->mesh.bounds.maxAnimatedBounds.sphereRadius > 0.0f)
                         ? skinned->asset->mesh.bounds.maxAnimatedBounds
                         : skinned->asset->mesh.bounds.bindPoseBounds;
-                    TransformAABB(bounds.aabbMin, bounds.aabbMax, world.world, wmin, wmax);
+                    worldBox = TransformAabb(bounds.aabbMin, bounds.aabbMax, world.world);
                 }
                 else
                 {
@@ -202,11 +207,11 @@ export namespace rendern
                     }
 
                     const auto& meshBounds = renderable.mesh->GetBounds();
-                    TransformAABB(meshBounds.aabbMin, meshBounds.aabbMax, world.world, wmin, wmax);
+                    worldBox = TransformAabb(meshBounds.aabbMin, meshBounds.aabbMax, world.world);
                 }
 
                 float t = 0.0f;
-                if (!IntersectRayAABB(ray, wmin, wmax, t))
+                if (!IntersectRayAabb(ray, worldBox, std::numeric_limits<float>::infinity(), t))
                 {
                     return;
                 }
@@ -220,62 +225,54 @@ export namespace rendern
                 }
             });
 
-        for (std::size_t emitterIndex = 0; emitterIndex < levelInst.GetParticleEmitterCount(); ++emitterIndex)
-        {
-            const ParticleEmitter* emitter = levelInst.GetRuntimeParticleEmitter(scene, static_cast<int>(emitterIndex));
-            if (!emitter || !emitter->enabled)
-            {
-                continue;
-            }
-
-            const float jitterRadius = std::max(std::max(std::abs(emitter->positionJitter.x), std::abs(emitter->positionJitter.y)), std::abs(emitter->positionJitter.z));
-            const float velocityExtent = std::max(std::max(
-                std::max(std::abs(emitter->velocityMin.x), std::abs(emitter->velocityMax.x)),
-                std::max(std::abs(emitter->velocityMin.y), std::abs(emitter->velocityMax.y))),
-                std::max(std::abs(emitter->velocityMin.z), std::abs(emitter->velocityMax.z)));
-            const float maxLifetime = std::max(emitter->lifetimeMin, emitter->lifetimeMax);
-            const float radius = std::max(0.35f, jitterRadius + velocityExtent * std::max(0.25f, maxLifetime) + std::max(emitter->sizeBegin, emitter->sizeEnd));
+        PickEmittersAndLights(scene, levelInst, ray, bestT, bestNode, bestEmitter, bestLight);
 
-            float t = 0.0f;
-            if (!IntersectRaySphere(ray, emitter->position, radius, t))
-            {
-                continue;
-            }
+        out.nodeIndex = bestNode;
+        out.particleEmitterIndex = bestEmitter;
+        out.lightIndex = bestLight;
+        out.t = bestT;
+        return out;
+    }
 
-            if (t < bestT)
-            {
-                bestT = t;
-                bestNode = -1;
-                bestEmitter = static_cast<int>(emitterIndex);
-                bestLight = -1;
-            }
-        }
+    // Same as above, but mesh hits come from a closest-hit ray cast through a SceneBVH that was synced
+    // against `scene` this frame, instead of testing every renderable.
+    PickResult PickEditorObjectUnderScreenPoint(
+        const rendern::Scene& scene,
+        const rendern::LevelInstance& levelInst,
+        const rendern::SceneBVH& bvh,
+        float mouseX,
+        float mouseY,
+        float viewportW,
+        float viewportH) noexcept
+    {
+        PickResult out{};
 
-        for (std::size_t lightIndex = 0; lightIndex < scene.lights.size(); ++lightIndex)
-        {
-            const Light& light = scene.lights[lightIndex];
-            if (light.type != LightType::Point && light.type != LightType::Spot)
-            {
-                continue;
-            }
+        const geometry::Ray ray = BuildMouseRay(scene, mouseX, mouseY, viewportW, viewportH);
+        out.rayOrigin = ray.origin;
+        out.rayDir = ray.dir;
 
-            const float distToCamera = mathUtils::Length(scene.camera.position - light.position);
-            const float pickRadius = std::clamp(distToCamera * 0.04f, 0.15f, 1.5f);
+        float bestT = std::numeric_limits<float>::infinity();
+        int bestNode = -1;
+        int bestEmitter = -1;
+        int bestLight = -1;
 
-            float t = 0.0f;
-            if (!IntersectRaySphere(ray, light.position, pickRadius, t))
+        bvh.RayCast(ray, bestT, [&](SceneBVHItem item, float t)
             {
-                continue;
-            }
+                const int drawIndex = static_cast<int>(item.index);
+                const int nodeIndex = (item.kind == SceneBVHItemKind::DrawItem)
+                    ? levelInst.GetNodeIndexFromDrawIndex(drawIndex)
+                    : levelInst.GetNodeIndexFromSkinnedDrawIndex(drawIndex);
+                if (nodeIndex < 0 || t >= bestT)
+                {
+                    return bestT;
+                }
 
-            if (t < bestT)
-            {
                 bestT = t;
-                bestNode = -1;
-                bestEmitter = -1;
-                bestLight = static_cast<int>(lightIndex);
-            }
-        }
+                bestNode = nodeIndex;
+                return bestT;
+            });
+
+        PickEmittersAndLights(scene, levelInst, ray, bestT, bestNode, bestEmitter, bestLight);
 
         out.nodeIndex = bestNode;
         out.particleEmitterIndex = bestEmitter;
@@ -49,6 +49,8 @@ export namespace rendern
 			m = mathUtils::Scale(m, scale);
 			return m;
 		}
+
+		friend bool operator==(const Transform&, const Transform&) = default;
 	};
 
 	struct Camera
@@ -373,6 +375,8 @@ export namespace rendern
 		MeshHandle mesh{};
 		Transform transform{};
 		MaterialHandle material{};
+		// Artist-flagged occluder: rasterized by software occlusion culling before size-picked ones.
+		bool occluder{ false };
 	};
 
 	using SkinnedHandle = std::shared_ptr<SkinnedAssetBundle>;
@@ -0,0 +1,809 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+export module core:scene_bvh;
+
+import :math_utils;
+import :geometry;
+import :scene;
+
+// Bounding volume hierarchy for scene queries.
+//
+// DynamicAabbTree is an incrementally updated AABB tree: leaves store "fat" boxes (tight box + margin)
+// so small motions do not touch the tree, insertion picks the sibling by surface-area cost, and
+// AVL-style rotations keep the height logarithmic. SceneBVH keeps one leaf per draw item and skinned
+// draw item of a Scene and re-syncs only items whose transform or bounds changed, so a static level
+// costs one compare per item per frame and queries (frustum, ray, box, sphere) are sub-linear.
+
+export namespace rendern
+{
+	struct Aabb
+	{
+		mathUtils::Vec3 min{ 0.0f, 0.0f, 0.0f };
+		mathUtils::Vec3 max{ 0.0f, 0.0f, 0.0f };
+
+		bool Contains(const Aabb& other) const noexcept
+		{
+			return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z
+				&& other.max.x <= max.x && other.max.y <= max.y && other.max.z <= max.z;
+		}
+
+		bool Overlaps(const Aabb& other) const noexcept
+		{
+			return min.x <= other.max.x && other.min.x <= max.x
+				&& min.y <= other.max.y && other.min.y <= max.y
+				&& min.z <= other.max.z && other.min.z <= max.z;
+		}
+
+		// Half the surface area; only ratios matter for the insertion cost.
+		float HalfArea() const noexcept
+		{
+			const float dx = max.x - min.x;
+			const float dy = max.y - min.y;
+			const float dz = max.z - min.z;
+			return dx * dy + dy * dz + dz * dx;
+		}
+
+		Aabb Expanded(float margin) const noexcept
+		{
+			return Aabb{ { min.x - margin, min.y - margin, min.z - margin }, { max.x + margin, max.y + margin, max.z + margin } };
+		}
+
+		friend Aabb Union(const Aabb& a, const Aabb& b) noexcept
+		{
+			return Aabb{ mathUtils::MinVec3(a.min, b.min), mathUtils::MaxVec3(a.max, b.max) };
+		}
+	};
+
+	// World bounds of a local AABB under `model` (8 transformed corners).
+	Aabb TransformAabb(const mathUtils::Vec3& localMin, const mathUtils::Vec3& localMax, const mathUtils::Mat4& model) noexcept
+	{
+		const mathUtils::Vec3 corners[8] =
+		{
+			{ localMin.x, localMin.y, localMin.z }, { localMax.x, localMin.y, localMin.z }, { localMin.x, localMax.y, localMin.z }, { localMax.x, localMax.y, localMin.z },
+			{ localMin.x, localMin.y, localMax.z }, { localMax.x, localMin.y, localMax.z }, { localMin.x, localMax.y, localMax.z }, { localMax.x, localMax.y, localMax.z },
+		};
+
+		constexpr float inf = std::numeric_limits<float>::infinity();
+		Aabb out{ { inf, inf, inf }, { -inf, -inf, -inf } };
+		for (const mathUtils::Vec3& corner : corners)
+		{
+			const mathUtils::Vec3 world = mathUtils::TransformPoint(model, corner);
+			out.min = mathUtils::MinVec3(out.min, world);
+			out.max = mathUtils::MaxVec3(out.max, world);
+		}
+		return out;
+	}
+
+	enum class FrustumOverlap : std::uint8_t
+	{
+		Outside,
+		Intersecting,
+		Inside
+	};
+
+	FrustumOverlap ClassifyAabb(const mathUtils::Frustum& frustum, const Aabb& box) noexcept
+	{
+		const mathUtils::Vec3 center = (box.min + box.max) * 0.5f;
+		const mathUtils::Vec3 extent = (box.max - box.min) * 0.5f;
+		FrustumOverlap result = FrustumOverlap::Inside;
+		for (const mathUtils::Plane& plane : frustum.planes)
+		{
+			const float distance = mathUtils::Distance(plane, center);
+			const float radius = std::abs(plane.norm.x) * extent.x + std::abs(plane.norm.y) * extent.y + std::abs(plane.norm.z) * extent.z;
+			if (distance < -radius)
+			{
+				return FrustumOverlap::Outside;
+			}
+			if (distance < radius)
+			{
+				result = FrustumOverlap::Intersecting;
+			}
+		}
+		return result;
+	}
+
+	// Slab test; outEnter is clamped to 0 when the origin is inside the box.
+	bool IntersectRayAabb(const geometry::Ray& ray, const Aabb& box, float maxT, float& outEnter) noexcept
+	{
+		float tmin = 0.0f;
+		float tmax = maxT;
+		for (std::size_t axis = 0; axis < 3; ++axis)
+		{
+			const float origin = ray.origin[axis];
+			const float dir = ray.dir[axis];
+			if (std::abs(dir) < 1e-8f)
+			{
+				if (origin < box.min[axis] || origin > box.max[axis])
+				{
+					return false;
+				}
+				continue;
+			}
+			const float invDir = 1.0f / dir;
+			float t1 = (box.min[axis] - origin) * invDir;
+			float t2 = (box.max[axis] - origin) * invDir;
+			if (t1 > t2)
+			{
+				std::swap(t1, t2);
+			}
+			tmin = std::max(tmin, t1);
+			tmax = std::min(tmax, t2);
+			if (tmin > tmax)
+			{
+				return false;
+			}
+		}
+		outEnter = tmin;
+		return true;
+	}
+
+	class DynamicAabbTree
+	{
+	public:
+		static constexpr int kNullNode = -1;
+
+		explicit DynamicAabbTree(float fatMargin = 0.1f) : margin_(fatMargin) {}
+
+		int CreateProxy(const Aabb& box, std::uint64_t userData)
+		{
+			const int proxy = AllocateNode();
+			Node& node = nodes_[static_cast<std::size_t>(proxy)];
+			node.box = box.Expanded(margin_);
+			node.userData = userData;
+			node.height = 0;
+			InsertLeaf(proxy);
+			++proxyCount_;
+			return proxy;
+		}
+
+		void DestroyProxy(int proxy)
+		{
+			RemoveLeaf(proxy);
+			FreeNode(proxy);
+			--proxyCount_;
+		}
+
+		// Returns true when the leaf had to be re-inserted: the new box left the fat box, or the fat box
+		// became much larger than needed (the object shrank or stopped moving far away from it).
+		bool MoveProxy(int proxy, const Aabb& box)
+		{
+			Node& node = nodes_[static_cast<std::size_t>(proxy)];
+			const Aabb fat = box.Expanded(margin_);
+			if (node.box.Contains(box) && fat.Expanded(4.0f * margin_).Contains(node.box))
+			{
+				return false;
+			}
+			RemoveLeaf(proxy);
+			nodes_[static_cast<std::size_t>(proxy)].box = fat;
+			InsertLeaf(proxy);
+			return true;
+		}
+
+		std::uint64_t GetUserData(int proxy) const noexcept { return nodes_[static_cast<std::size_t>(proxy)].userData; }
+		const Aabb& GetFatAabb(int proxy) const noexcept { return nodes_[static_cast<std::size_t>(proxy)].box; }
+
+		std::size_t GetProxyCount() const noexcept { return proxyCount_; }
+		int GetHeight() const noexcept { return root_ == kNullNode ? 0 : nodes_[static_cast<std::size_t>(root_)].height; }
+
+		// fn(proxy) for every leaf whose fat box overlaps `box`.
+		template <typename Fn>
+		void QueryAabb(const Aabb& box, Fn&& fn) const
+		{
+			Traverse([&box](const Aabb& nodeBox) { return nodeBox.Overlaps(box); }, fn);
+		}
+
+		// fn(proxy) for every leaf whose fat box touches the sphere.
+		template <typename Fn>
+		void QuerySphere(const mathUtils::Vec3& center, float radius, Fn&& fn) const
+		{
+			const float radius2 = radius * radius;
+			Traverse([&center, radius2](const Aabb& nodeBox)
+				{
+					const mathUtils::Vec3 closest = mathUtils::MinVec3(mathUtils::MaxVec3(center, nodeBox.min), nodeBox.max);
+					const mathUtils::Vec3 delta = closest - center;
+					return mathUtils::Dot(delta, delta) <= radius2;
+				}, fn);
+		}
+
+		// fn(proxy) for every leaf whose fat box intersects the frustum. Subtrees fully inside are
+		// reported without further plane tests.
+		template <typename Fn>
+		void QueryFrustum(const mathUtils::Frustum& frustum, Fn&& fn) const
+		{
+			if (root_ == kNullNode)
+			{
+				return;
+			}
+			std::vector<std::pair<int, bool>> stack;
+			stack.reserve(64);
+			stack.emplace_back(root_, false);
+			while (!stack.empty())
+			{
+				const auto [index, inside] = stack.back();
+				stack.pop_back();
+				const Node& node = nodes_[static_cast<std::size_t>(index)];
+				bool childrenInside = inside;
+				if (!inside)
+				{
+					const FrustumOverlap overlap = ClassifyAabb(frustum, node.box);
+					if (overlap == FrustumOverlap::Outside)
+					{
+						continue;
+					}
+					childrenInside = overlap == FrustumOverlap::Inside;
+				}
+				if (node.IsLeaf())
+				{
+					fn(index);
+					continue;
+				}
+				stack.emplace_back(node.child1, childrenInside);
+				stack.emplace_back(node.child2, childrenInside);
+			}
+		}
+
+		// Visits leaves hit by the ray in roughly front-to-back order. fn(proxy, tEnter) returns the new
+		// maximum distance: return maxT to keep going, the hit distance for closest-hit queries, or 0 to stop.
+		template <typename Fn>
+		void RayCast(const geometry::Ray& ray, float maxT, Fn&& fn) const
+		{
+			if (root_ == kNullNode)
+			{
+				return;
+			}
+			std::vector<std::pair<int, float>> stack;
+			stack.reserve(64);
+			float enter = 0.0f;
+			if (!IntersectRayAabb(ray, nodes_[static_cast<std::size_t>(root_)].box, maxT, enter))
+			{
+				return;
+			}
+			stack.emplace_back(root_, enter);
+			while (!stack.empty() && maxT > 0.0f)
+			{
+				const auto [index, nodeEnter] = stack.back();
+				stack.pop_back();
+				if (nodeEnter > maxT)
+				{
+					continue;
+				}
+				const Node& node = nodes_[static_cast<std::size_t>(index)];
+				if (node.IsLeaf())
+				{
+					maxT = std::min(maxT, fn(index, nodeEnter));
+					continue;
+				}
+				float enter1 = 0.0f;
+				float enter2 = 0.0f;
+				const bool hit1 = IntersectRayAabb(ray, nodes_[static_cast<std::size_t>(node.child1)].box, maxT, enter1);
+				const bool hit2 = IntersectRayAabb(ray, nodes_[static_cast<std::size_t>(node.child2)].box, maxT, enter2);
+				// Push the far child first so the near one is visited next.
+				if (hit1 && hit2)
+				{
+					const bool firstNear = enter1 <= enter2;
+					stack.emplace_back(firstNear ? node.child2 : node.child1, firstNear ? enter2 : enter1);
+					stack.emplace_back(firstNear ? node.child1 : node.child2, firstNear ? enter1 : enter2);
+				}
+				else if (hit1)
+				{
+					stack.emplace_back(node.child1, enter1);
+				}
+				else if (hit2)
+				{
+					stack.emplace_back(node.child2, enter2);
+				}
+			}
+		}
+
+	private:
+		struct Node
+		{
+			Aabb box{};
+			std::uint64_t userData{ 0 };
+			int parent{ kNullNode }; // next free node while on the free list
+			int child1{ kNullNode };
+			int child2{ kNullNode };
+			int height{ -1 };        // 0 = leaf, -1 = free
+
+			bool IsLeaf() const noexcept { return child1 == kNullNode; }
+		};
+
+		template <typename Test, typename Fn>
+		void Traverse(Test&& test, Fn& fn) const
+		{
+			if (root_ == kNullNode)
+			{
+				return;
+			}
+			std::vector<int> stack;
+			stack.reserve(64);
+			stack.push_back(root_);
+			while (!stack.empty())
+			{
+				const int index = stack.back();
+				stack.pop_back();
+				const Node& node = nodes_[static_cast<std::size_t>(index)];
+				if (!test(node.box))
+				{
+					continue;
+				}
+				if (node.IsLeaf())
+				{
+					fn(index);
+					continue;
+				}
+				stack.push_back(node.child1);
+				stack.push_back(node.child2);
+			}
+		}
+
+		int AllocateNode()
+		{
+			if (freeList_ == kNullNode)
+			{
+				const int index = static_cast<int>(nodes_.size());
+				nodes_.emplace_back();
+				return index;
+			}
+			const int index = freeList_;
+			freeList_ = nodes_[static_cast<std::size_t>(index)].parent;
+			nodes_[static_cast<std::size_t>(index)] = Node{};
+			return index;
+		}
+
+		void FreeNode(int index) noexcept
+		{
+			Node& node = nodes_[static_cast<std::size_t>(index)];
+			node = Node{};
+			node.parent = freeList_;
+			freeList_ = index;
+		}
+
+		Node& At(int index) noexcept { return nodes_[static_cast<std::size_t>(index)]; }
+
+		void InsertLeaf(int leaf)
+		{
+			if (root_ == kNullNode)
+			{
+				root_ = leaf;
+				At(leaf).parent = kNullNode;
+				return;
+			}
+
+			// Descend towards the sibling with the lowest surface-area cost.
+			const Aabb leafBox = At(leaf).box;
+			int index = root_;
+			while (!At(index).IsLeaf())
+			{
+				const Node& node = At(index);
+				const float area = node.box.HalfArea();
+				const float combinedArea = Union(node.box, leafBox).HalfArea();
+				const float cost = 2.0f * combinedArea;
+				const float inheritanceCost = 2.0f * (combinedArea - area);
+
+				const auto descendCost = [&](int child)
+					{
+						const Node& c = At(child);
+						const float unionArea = Union(leafBox, c.box).HalfArea();
+						return (c.IsLeaf() ? unionArea : unionArea - c.box.HalfArea()) + inheritanceCost;
+					};
+				const float cost1 = descendCost(node.child1);
+				const float cost2 = descendCost(node.child2);
+				if (cost < cost1 && cost < cost2)
+				{
+					break;
+				}
+				index = cost1 < cost2 ? node.child1 : node.child2;
+			}
+
+			const int sibling = index;
+			const int oldParent = At(sibling).parent;
+			const int newParent = AllocateNode();
+			At(newParent).parent = oldParent;
+			At(newParent).box = Union(leafBox, At(sibling).box);
+			At(newParent).height = At(sibling).height + 1;
+			At(newParent).child1 = sibling;
+			At(newParent).child2 = leaf;
+			At(sibling).parent = newParent;
+			At(leaf).parent = newParent;
+			if (oldParent != kNullNode)
+			{
+				(At(oldParent).child1 == sibling ? At(oldParent).child1 : At(oldParent).child2) = newParent;
+			}
+			else
+			{
+				root_ = newParent;
+			}
+
+			RefitUpwards(At(leaf).parent);
+		}
+
+		void RemoveLeaf(int leaf)
+		{
+			if (leaf == root_)
+			{
+				root_ = kNullNode;
+				return;
+			}
+
+			const int parent = At(leaf).parent;
+			const int grandParent = At(parent).parent;
+			const int sibling = At(parent).child1 == leaf ? At(parent).child2 : At(parent).child1;
+			if (grandParent != kNullNode)
+			{
+				(At(grandParent).child1 == parent ? At(grandParent).child1 : At(grandParent).child2) = sibling;
+				At(sibling).parent = grandParent;
+				FreeNode(parent);
+				RefitUpwards(grandParent);
+			}
+			else
+			{
+				root_ = sibling;
+				At(sibling).parent = kNullNode;
+				FreeNode(parent);
+			}
+		}
+
+		void RefitUpwards(int index)
+		{
+			while (index != kNullNode)
+			{
+				index = Balance(index);
+				Node& node = At(index);
+				node.height = 1 + std::max(At(node.child1).height, At(node.child2).height);
+				node.box = Union(At(node.child1).box, At(node.child2).box);
+				index = node.parent;
+			}
+		}
+
+		// Rotates the taller grandchild up when the children's heights differ by more than one.
+		int Balance(int iA)
+		{
+			Node& A = At(iA);
+			if (A.IsLeaf() || A.height < 2)
+			{
+				return iA;
+			}
+
+			const int iB = A.child1;
+			const int iC = A.child2;
+			Node& B = At(iB);
+			Node& C = At(iC);
+			const int balance = C.height - B.height;
+
+			if (balance > 1)
+			{
+				const int iF = C.child1;
+				const int iG = C.child2;
+				Node& F = At(iF);
+				Node& G = At(iG);
+
+				C.child1 = iA;
+				C.parent = A.parent;
+				A.parent = iC;
+				ReplaceChild(C.parent, iA, iC);
+
+				if (F.height > G.height)
+				{
+					C.child2 = iF;
+					A.child2 = iG;
+					G.parent = iA;
+					A.box = Union(B.box, G.box);
+					C.box = Union(A.box, F.box);
+					A.height = 1 + std::max(B.height, G.height);
+					C.height = 1 + std::max(A.height, F.height);
+				}
+				else
+				{
+					C.child2 = iG;
+					A.child2 = iF;
+					F.parent = iA;
+					A.box = Union(B.box, F.box);
+					C.box = Union(A.box, G.box);
+					A.height = 1 + std::max(B.height, F.height);
+					C.height = 1 + std::max(A.height, G.height);
+				}
+				return iC;
+			}
+
+			if (balance < -1)
+			{
+				const int iD = B.child1;
+				const int iE = B.child2;
+				Node& D = At(iD);
+				Node& E = At(iE);
+
+				B.child1 = iA;
+				B.parent = A.parent;
+				A.parent = iB;
+				ReplaceChild(B.parent, iA, iB);
+
+				if (D.height > E.height)
+				{
+					B.child2 = iD;
+					A.child1 = iE;
+					E.parent = iA;
+					A.box = Union(C.box, E.box);
+					B.box = Union(A.box, D.box);
+					A.height = 1 + std::max(C.height, E.height);
+					B.height = 1 + std::max(A.height, D.height);
+				}
+				else
+				{
+					B.child2 = iE;
+					A.child1 = iD;
+					D.parent = iA;
+					A.box = Union(C.box, D.box);
+					B.box = Union(A.box, E.box);
+					A.height = 1 + std::max(C.height, D.height);
+					B.height = 1 + std::max(A.height, E.height);
+				}
+				return iB;
+			}
+
+			return iA;
+		}
+
+		void ReplaceChild(int parent, int oldChild, int newChild) noexcept
+		{
+			if (parent == kNullNode)
+			{
+				root_ = newChild;
+				return;
+			}
+			Node& node = At(parent);
+			(node.child1 == oldChild ? node.child1 : node.child2) = newChild;
+		}
+
+		std::vector<Node> nodes_;
+		int root_{ kNullNode };
+		int freeList_{ kNullNode };
+		std::size_t proxyCount_{ 0 };
+		float margin_{ 0.1f };
+	};
+
+	enum class SceneBVHItemKind : std::uint8_t
+	{
+		DrawItem,
+		SkinnedDrawItem
+	};
+
+	struct SceneBVHItem
+	{
+		SceneBVHItemKind kind{ SceneBVHItemKind::DrawItem };
+		std::uint32_t index{ 0 }; // into Scene::drawItems or Scene::GetSkinnedDrawItems()
+
+		friend bool operator==(const SceneBVHItem&, const SceneBVHItem&) noexcept = default;
+	};
+
+	struct SceneBVHSyncStats
+	{
+		std::uint32_t created{ 0 };
+		std::uint32_t destroyed{ 0 };
+		std::uint32_t refitted{ 0 };   // changed items whose new box still fit their fat box
+		std::uint32_t reinserted{ 0 }; // changed items that had to move in the tree
+		std::uint32_t unbounded{ 0 };  // items without bounds yet (mesh still loading); always reported by QueryFrustum
+	};
+
+	class SceneBVH
+	{
+	public:
+		explicit SceneBVH(float fatMargin = 0.1f) : tree_(fatMargin) {}
+
+		// Brings the tree in line with scene.drawItems and the skinned draw items. Items are matched by
+		// index; only items whose transform or local bounds changed since the last Sync touch the tree.
+		void Sync(const Scene& scene)
+		{
+			stats_ = {};
+			const std::vector<SkinnedDrawItem>& skinned = scene.GetSkinnedDrawItems();
+			Resize(drawEntries_, scene.drawItems.size());
+			Resize(skinnedEntries_, skinned.size());
+
+			for (std::size_t i = 0; i < scene.drawItems.size(); ++i)
+			{
+				const DrawItem& item = scene.drawItems[i];
+				if (!item.mesh)
+				{
+					SyncEntry(drawEntries_[i], SceneBVHItem{ SceneBVHItemKind::DrawItem, static_cast<std::uint32_t>(i) }, nullptr, nullptr, 0.0f, item.transform);
+					continue;
+				}
+				const auto& bounds = item.mesh->GetBounds();
+				SyncEntry(drawEntries_[i], SceneBVHItem{ SceneBVHItemKind::DrawItem, static_cast<std::uint32_t>(i) },
+					&bounds.aabbMin, &bounds.aabbMax, bounds.sphereRadius, item.transform);
+			}
+			for (std::size_t i = 0; i < skinned.size(); ++i)
+			{
+				const SkinnedDrawItem& item = skinned[i];
+				if (!item.asset)
+				{
+					SyncEntry(skinnedEntries_[i], SceneBVHItem{ SceneBVHItemKind::SkinnedDrawItem, static_cast<std::uint32_t>(i) }, nullptr, nullptr, 0.0f, item.transform);
+					continue;
+				}
+				const SkinnedBounds& bounds = (item.asset->mesh.bounds.maxAnimatedBounds.sphereRadius > 0.0f)
+					? item.asset->mesh.bounds.maxAnimatedBounds
+					: item.asset->mesh.bounds.bindPoseBounds;
+				SyncEntry(skinnedEntries_[i], SceneBVHItem{ SceneBVHItemKind::SkinnedDrawItem, static_cast<std::uint32_t>(i) },
+					&bounds.aabbMin, &bounds.aabbMax, bounds.sphereRadius, item.transform);
+			}
+		}
+
+		// fn(SceneBVHItem) for every item that may intersect the frustum, including unbounded items.
+		template <typename Fn>
+		void QueryFrustum(const mathUtils::Frustum& frustum, Fn&& fn) const
+		{
+			tree_.QueryFrustum(frustum, [&](int proxy) { fn(Decode(tree_.GetUserData(proxy))); });
+			ReportUnbounded(fn);
+		}
+
+		// fn(SceneBVHItem) for every bounded item whose world box overlaps `box`.
+		template <typename Fn>
+		void QueryAabb(const Aabb& box, Fn&& fn) const
+		{
+			tree_.QueryAabb(box, [&](int proxy)
+				{
+					const SceneBVHItem item = Decode(tree_.GetUserData(proxy));
+					if (EntryOf(item).world.Overlaps(box))
+					{
+						fn(item);
+					}
+				});
+		}
+
+		// fn(SceneBVHItem) for every bounded item whose fat box touches the sphere (conservative).
+		template <typename Fn>
+		void QuerySphere(const mathUtils::Vec3& center, float radius, Fn&& fn) const
+		{
+			tree_.QuerySphere(center, radius, [&](int proxy) { fn(Decode(tree_.GetUserData(proxy))); });
+		}
+
+		// Closest-hit friendly ray query against the tight world boxes: fn(SceneBVHItem, tEnter) returns the
+		// new maximum distance (see DynamicAabbTree::RayCast).
+		template <typename Fn>
+		void RayCast(const geometry::Ray& ray, float maxT, Fn&& fn) const
+		{
+			tree_.RayCast(ray, maxT, [&](int proxy, float fatEnter) -> float
+				{
+					const SceneBVHItem item = Decode(tree_.GetUserData(proxy));
+					float enter = fatEnter;
+					if (!IntersectRayAabb(ray, EntryOf(item).world, std::numeric_limits<float>::infinity(), enter))
+					{
+						return std::numeric_limits<float>::infinity();
+					}
+					return fn(item, enter);
+				});
+		}
+
+		// Tight world box of a bounded item (nullptr for unknown or unbounded items).
+		const Aabb* TryGetWorldBounds(SceneBVHItem item) const noexcept
+		{
+			const std::vector<Entry>& entries = item.kind == SceneBVHItemKind::DrawItem ? drawEntries_ : skinnedEntries_;
+			if (item.index >= entries.size() || entries[item.index].proxy == DynamicAabbTree::kNullNode)
+			{
+				return nullptr;
+			}
+			return &entries[item.index].world;
+		}
+
+		const DynamicAabbTree& GetTree() const noexcept { return tree_; }
+		const SceneBVHSyncStats& GetLastSyncStats() const noexcept { return stats_; }
+
+	private:
+		struct Entry
+		{
+			bool synced{ false };
+			int proxy{ DynamicAabbTree::kNullNode };
+			Transform transform{};
+			mathUtils::Vec3 localMin{};
+			mathUtils::Vec3 localMax{};
+			Aabb world{};
+		};
+
+		static std::uint64_t Encode(SceneBVHItem item) noexcept
+		{
+			return (static_cast<std::uint64_t>(item.kind) << 32u) | item.index;
+		}
+
+		static SceneBVHItem Decode(std::uint64_t userData) noexcept
+		{
+			return SceneBVHItem{ static_cast<SceneBVHItemKind>(userData >> 32u), static_cast<std::uint32_t>(userData) };
+		}
+
+		const Entry& EntryOf(SceneBVHItem item) const noexcept
+		{
+			return item.kind == SceneBVHItemKind::DrawItem ? drawEntries_[item.index] : skinnedEntries_[item.index];
+		}
+
+		void Resize(std::vector<Entry>& entries, std::size_t count)
+		{
+			for (std::size_t i = count; i < entries.size(); ++i)
+			{
+				if (entries[i].proxy != DynamicAabbTree::kNullNode)
+				{
+					tree_.DestroyProxy(entries[i].proxy);
+					++stats_.destroyed;
+				}
+			}
+			entries.resize(count);
+		}
+
+		void SyncEntry(Entry& entry, SceneBVHItem item, const mathUtils::Vec3* localMin, const mathUtils::Vec3* localMax, float sphereRadius, const Transform& transform)
+		{
+			// A zero radius means the mesh has no bounds yet; keep it out of the tree, visible everywhere.
+			const bool bounded = localMin != nullptr && sphereRadius > 0.0f;
+			if (!bounded)
+			{
+				if (entry.proxy != DynamicAabbTree::kNullNode)
+				{
+					tree_.DestroyProxy(entry.proxy);
+					++stats_.destroyed;
+				}
+				entry = Entry{};
+				entry.synced = true;
+				++stats_.unbounded;
+				return;
+			}
+
+			if (entry.synced && entry.proxy != DynamicAabbTree::kNullNode
+				&& entry.localMin == *localMin && entry.localMax == *localMax && entry.transform == transform)
+			{
+				return;
+			}
+
+			entry.synced = true;
+			entry.transform = transform;
+			entry.localMin = *localMin;
+			entry.localMax = *localMax;
+			entry.world = TransformAabb(*localMin, *localMax, transform.ToMatrix());
+			if (entry.proxy == DynamicAabbTree::kNullNode)
+			{
+				entry.proxy = tree_.CreateProxy(entry.world, Encode(item));
+				++stats_.created;
+			}
+			else if (tree_.MoveProxy(entry.proxy, entry.world))
+			{
+				++stats_.reinserted;
+			}
+			else
+			{
+				++stats_.refitted;
+			}
+		}
+
+		template <typename Fn>
+		void ReportUnbounded(Fn& fn) const
+		{
+			if (stats_.unbounded == 0)
+			{
+				return;
+			}
+			for (std::size_t i = 0; i < drawEntries_.size(); ++i)
+			{
+				if (drawEntries_[i].proxy == DynamicAabbTree::kNullNode)
+				{
+					fn(SceneBVHItem{ SceneBVHItemKind::DrawItem, static_cast<std::uint32_t>(i) });
+				}
+			}
+			for (std::size_t i = 0; i < skinnedEntries_.size(); ++i)
+			{
+				if (skinnedEntries_[i].proxy == DynamicAabbTree::kNullNode)
+				{
+					fn(SceneBVHItem{ SceneBVHItemKind::SkinnedDrawItem, static_cast<std::uint32_t>(i) });
+				}
+			}
+		}
+
+		DynamicAabbTree tree_;
+		std::vector<Entry> drawEntries_;
+		std::vector<Entry> skinnedEntries_;
+		SceneBVHSyncStats stats_{};
+	};
+}
@@ -70,6 +70,7 @@ struct LevelNode
 
 	bool visible{ true };
 	bool alive{ true }; // editor/runtime tombstone (keeps indices stable)
+	bool occluder{ false }; // always considered first by software occlusion culling
 
 	Transform transform{};
 
@@ -68,7 +68,15 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		}
 	}
 
-	// Meshes: request loads
+	// Meshes: request loads (meshes of occluder nodes keep their CPU triangles for occlusion culling)
+	std::unordered_set<std::string> occluderMeshes;
+	for (const LevelNode& n : asset.nodes)
+	{
+		if (n.occluder && !n.mesh.empty())
+		{
+			occluderMeshes.insert(n.mesh);
+		}
+	}
 	std::unordered_map<std::string, MeshHandle> meshHandles;
 	meshHandles.reserve(asset.meshes.size());
 	for (const auto& [id, md] : asset.meshes)
@@ -79,6 +87,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		p.flipUVs = md.flipUVs;
 		p.submeshIndex = md.submeshIndex;
 		p.bakeNodeTransforms = md.bakeNodeTransforms;
+		p.occluder = occluderMeshes.contains(id);
 		meshHandles.emplace(id, assets.LoadMeshAsync(id, std::move(p)));
 	}
 
@@ -171,6 +180,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 				p.debugName = modelIt->second.debugName.empty() ? sub.name : (modelIt->second.debugName + "_" + sub.name);
 				p.flipUVs = modelIt->second.flipUVs;
 				p.submeshIndex = sub.submeshIndex;
+				p.occluder = n.occluder;
 				const std::string meshKey = n.model + "#submesh=" + std::to_string(sub.submeshIndex);
 				MeshHandle mh = assets.LoadMeshAsync(meshKey, std::move(p));
 
@@ -192,6 +202,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 				DrawItem item{};
 				item.mesh = mh;
 				item.material = mat;
+				item.occluder = n.occluder;
 				item.transform.useMatrix = true;
 				item.transform.matrix = inst.world_[i];
 				const int drawIndex = static_cast<int>(scene.drawItems.size());
@@ -223,6 +234,7 @@ LevelInstance InstantiateLevel(Scene& scene, AssetManager& assets, BindlessTable
 		DrawItem item{};
 		item.mesh = meshIt->second;
 		item.material = mat;
+		item.occluder = n.occluder;
 		item.transform.useMatrix = true;
 		item.transform.matrix = inst.world_[i];
 
@@ -54,7 +54,7 @@ MaterialHandle GetMaterialHandle_(std::string_view materialId) const noexcept
 	return it->second;
 }
 
-MeshHandle GetOrLoadMeshHandle_(const LevelAsset& asset, AssetManager& assets, const std::string& meshId) const
+MeshHandle GetOrLoadMeshHandle_(const LevelAsset& asset, AssetManager& assets, const std::string& meshId, bool occluder) const
 {
 	auto it = asset.meshes.find(meshId);
 	if (it == asset.meshes.end())
@@ -68,6 +68,7 @@ MeshHandle GetOrLoadMeshHandle_(const LevelAsset& asset, AssetManager& assets, c
 	p.flipUVs = it->second.flipUVs;
 	p.submeshIndex = it->second.submeshIndex;
 	p.bakeNodeTransforms = it->second.bakeNodeTransforms;
+	p.occluder = occluder;
 	return assets.LoadMeshAsync(meshId, std::move(p));
 }
 
@@ -384,6 +385,7 @@ std::vector<int> MakeDrawsForModelNode_(const LevelAsset& asset, Scene& scene, A
 		p.debugName = md.debugName.empty() ? sub.name : (md.debugName + "_" + sub.name);
 		p.flipUVs = md.flipUVs;
 		p.submeshIndex = sub.submeshIndex;
+		p.occluder = node.occluder;
 		const std::string meshKey = node.model + "#submesh=" + std::to_string(sub.submeshIndex);
 		MeshHandle mesh = assets.LoadMeshAsync(meshKey, std::move(p));
 
@@ -396,6 +398,7 @@ std::vector<int> MakeDrawsForModelNode_(const LevelAsset& asset, Scene& scene, A
 		DrawItem item{};
 		item.mesh = mesh;
 		item.material = EnsureMaterial(asset, scene, materialId);
+		item.occluder = node.occluder;
 		item.transform.useMatrix = true;
 		item.transform.matrix = world_[static_cast<std::size_t>(nodeIndex)];
 		const int drawIndex = static_cast<int>(scene.drawItems.size());
@@ -593,8 +596,9 @@ void EnsureDrawForNode_(const LevelAsset& asset, Scene& scene, AssetManager& ass
 	}
 
 	DrawItem item{};
-	item.mesh = GetOrLoadMeshHandle_(asset, assets, node.mesh);
+	item.mesh = GetOrLoadMeshHandle_(asset, assets, node.mesh, node.occluder);
 	item.material = EnsureMaterial(asset, scene, node.material);
+	item.occluder = node.occluder;
 	item.transform.useMatrix = true;
 	item.transform.matrix = world_[i];
 
@@ -211,6 +211,7 @@ inline void ParseNodeSection_(LevelAsset& out, const JsonObject& jsonObject)
 			n.name = GetStringOpt(nd, "name");
 			n.parent = static_cast<int>(GetFloatOpt(nd, "parent", -1.0f));
 			n.visible = GetBoolOpt(nd, "visible", true);
+			n.occluder = GetBoolOpt(nd, "occluder", false);
 			n.alive = GetBoolOpt(nd, "alive", true);
 			if (auto* delV = TryGet(nd, "deleted"))
 			{
@@ -155,6 +155,10 @@ inline void WriteNodesSection_(std::ostringstream& ss, const LevelAsset& level,
 		ss << ", \"parent\": " << parent;
 		ss << ", \"visible\": ";
 		WriteJsonBool(ss, n.visible);
+		if (n.occluder)
+		{
+			ss << ", \"occluder\": true";
+		}
 
 		if (!n.model.empty())
 		{
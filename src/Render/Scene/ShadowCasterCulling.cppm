@@ -0,0 +1,207 @@
+module;
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+export module core:shadow_caster_culling;
+
+import :math_utils;
+import :visibility;
+
+// Shadow caster culling shared by the backends.
+//
+// Every shadow view (directional cascade, spot light, point light or one of its cube faces) gets a frustum;
+// caster bounding spheres are tested against all of them in one CullSpheres batch, and ShadowViewPacking
+// turns the resulting per-caster view masks into per-view, mesh-grouped caster ranges that a backend
+// can turn into instanced draws.
+
+export namespace rendern
+{
+	using ShadowViewMask = std::uint64_t;
+
+	inline constexpr std::size_t kMaxShadowCullViews = 64;
+
+	// Accepts everything (for views that must not cull).
+	mathUtils::Frustum UnboundedFrustum() noexcept
+	{
+		mathUtils::Frustum frustum{};
+		for (mathUtils::Plane& plane : frustum.planes)
+		{
+			plane = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, 0.0f, 0.0f }, 1.0f };
+		}
+		return frustum;
+	}
+
+	// Directional cascade caster volume: the cascade's light-space ortho box with its near plane removed,
+	// i.e. extruded towards the light, so casters between the light and the cascade still shadow it.
+	mathUtils::Frustum ExtrudedCascadeFrustum(const mathUtils::Mat4& lightViewProj) noexcept
+	{
+		mathUtils::Frustum frustum = mathUtils::ExtractFrustumRH_ZO(lightViewProj);
+		frustum.planes[static_cast<std::uint32_t>(mathUtils::FrustumPlane::Near)] = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, 0.0f, 0.0f }, 1.0f };
+		return frustum;
+	}
+
+	// Cube of half-size `range` around a point light: the union of its six 90-degree face frustums.
+	mathUtils::Frustum PointLightFrustum(const mathUtils::Vec3& position, float range) noexcept
+	{
+		mathUtils::Frustum frustum{};
+		frustum.planes[0] = mathUtils::Plane{ mathUtils::Vec3{ 1.0f, 0.0f, 0.0f }, range - position.x };
+		frustum.planes[1] = mathUtils::Plane{ mathUtils::Vec3{ -1.0f, 0.0f, 0.0f }, range + position.x };
+		frustum.planes[2] = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, 1.0f, 0.0f }, range - position.y };
+		frustum.planes[3] = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, -1.0f, 0.0f }, range + position.y };
+		frustum.planes[4] = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, 0.0f, 1.0f }, range - position.z };
+		frustum.planes[5] = mathUtils::Plane{ mathUtils::Vec3{ 0.0f, 0.0f, -1.0f }, range + position.z };
+		return frustum;
+	}
+
+	// Tests every caster sphere against up to kMaxShadowCullViews views; bit v of outMasks[i] is set when
+	// caster i may cast into view v. Runs CullSpheres in chunks of kMaxCullViews.
+	void CullShadowCasters(
+		const CullSpheresSoA& casters,
+		std::span<const mathUtils::Frustum> views,
+		std::span<ShadowViewMask> outMasks,
+		std::vector<std::uint32_t>& scratchMasks)
+	{
+		if (views.size() > kMaxShadowCullViews)
+		{
+			throw std::runtime_error("CullShadowCasters: too many views (" + std::to_string(views.size()) + ")");
+		}
+		if (outMasks.size() < casters.Size())
+		{
+			throw std::runtime_error("CullShadowCasters: mask span is smaller than the caster count");
+		}
+
+		std::fill_n(outMasks.begin(), casters.Size(), ShadowViewMask{ 0 });
+		scratchMasks.resize(casters.Size());
+		for (std::size_t firstView = 0; firstView < views.size(); firstView += kMaxCullViews)
+		{
+			const std::size_t chunk = std::min(kMaxCullViews, views.size() - firstView);
+			CullSpheres(casters, views.subspan(firstView, chunk), scratchMasks);
+			for (std::size_t i = 0; i < casters.Size(); ++i)
+			{
+				outMasks[i] |= static_cast<ShadowViewMask>(scratchMasks[i]) << firstView;
+			}
+		}
+	}
+
+	template <typename MeshKey>
+	struct ShadowViewBatch
+	{
+		MeshKey mesh{};
+		std::uint32_t first{ 0 }; // into ShadowViewPacking::Casters()
+		std::uint32_t count{ 0 };
+	};
+
+	struct ShadowViewRange
+	{
+		std::uint32_t firstBatch{ 0 };
+		std::uint32_t batchCount{ 0 };
+		std::uint32_t firstCaster{ 0 };
+		std::uint32_t casterCount{ 0 };
+	};
+
+	// Per-view caster lists grouped by mesh. Casters are laid out view after view; within a view they are
+	// ordered by mesh (then by caster index), so each batch is one contiguous instanced draw.
+	template <typename MeshKey>
+	class ShadowViewPacking
+	{
+	public:
+		// casterMeshes[i] and masks[i] describe caster i. Views outside `viewsToPack` stay empty.
+		void Build(std::span<const MeshKey> casterMeshes, std::span<const ShadowViewMask> masks, std::uint32_t viewCount, ShadowViewMask viewsToPack = ~ShadowViewMask{ 0 })
+		{
+			if (viewCount > kMaxShadowCullViews)
+			{
+				throw std::runtime_error("ShadowViewPacking: too many views (" + std::to_string(viewCount) + ")");
+			}
+			if (masks.size() != casterMeshes.size())
+			{
+				throw std::runtime_error("ShadowViewPacking: caster mesh and mask counts differ");
+			}
+
+			const ShadowViewMask viewBits = (viewCount == kMaxShadowCullViews) ? ~ShadowViewMask{ 0 } : ((ShadowViewMask{ 1 } << viewCount) - 1u);
+			const ShadowViewMask packBits = viewsToPack & viewBits;
+
+			order_.resize(casterMeshes.size());
+			std::iota(order_.begin(), order_.end(), 0u);
+			std::stable_sort(order_.begin(), order_.end(), [&casterMeshes](std::uint32_t a, std::uint32_t b)
+				{
+					return std::less<MeshKey>{}(casterMeshes[a], casterMeshes[b]);
+				});
+
+			views_.assign(viewCount, ShadowViewRange{});
+			for (const ShadowViewMask mask : masks)
+			{
+				for (ShadowViewMask bits = mask & packBits; bits != 0; bits &= bits - 1u)
+				{
+					++views_[static_cast<std::size_t>(std::countr_zero(bits))].casterCount;
+				}
+			}
+
+			std::uint32_t total = 0;
+			for (ShadowViewRange& view : views_)
+			{
+				view.firstCaster = total;
+				total += view.casterCount;
+			}
+			casters_.resize(total);
+
+			cursors_.resize(viewCount);
+			for (std::uint32_t view = 0; view < viewCount; ++view)
+			{
+				cursors_[view] = views_[view].firstCaster;
+			}
+			for (const std::uint32_t caster : order_)
+			{
+				for (ShadowViewMask bits = masks[caster] & packBits; bits != 0; bits &= bits - 1u)
+				{
+					casters_[cursors_[static_cast<std::size_t>(std::countr_zero(bits))]++] = caster;
+				}
+			}
+
+			batches_.clear();
+			for (ShadowViewRange& view : views_)
+			{
+				view.firstBatch = static_cast<std::uint32_t>(batches_.size());
+				const std::uint32_t end = view.firstCaster + view.casterCount;
+				for (std::uint32_t i = view.firstCaster; i < end; ++i)
+				{
+					const MeshKey& mesh = casterMeshes[casters_[i]];
+					if (batches_.size() > view.firstBatch && batches_.back().mesh == mesh)
+					{
+						++batches_.back().count;
+						continue;
+					}
+					batches_.push_back(ShadowViewBatch<MeshKey>{ mesh, i, 1u });
+				}
+				view.batchCount = static_cast<std::uint32_t>(batches_.size()) - view.firstBatch;
+			}
+		}
+
+		std::uint32_t GetViewCount() const noexcept { return static_cast<std::uint32_t>(views_.size()); }
+		const ShadowViewRange& GetView(std::uint32_t view) const noexcept { return views_[view]; }
+
+		std::span<const ShadowViewBatch<MeshKey>> GetBatches(std::uint32_t view) const noexcept
+		{
+			const ShadowViewRange& range = views_[view];
+			return std::span<const ShadowViewBatch<MeshKey>>{ batches_ }.subspan(range.firstBatch, range.batchCount);
+		}
+
+		// Caster indices of all views (see ShadowViewBatch::first).
+		std::span<const std::uint32_t> GetCasters() const noexcept { return casters_; }
+
+	private:
+		std::vector<std::uint32_t> order_;
+		std::vector<std::uint32_t> cursors_;
+		std::vector<std::uint32_t> casters_;
+		std::vector<ShadowViewBatch<MeshKey>> batches_;
+		std::vector<ShadowViewRange> views_;
+	};
+}
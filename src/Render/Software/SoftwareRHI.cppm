@@ -0,0 +1,1608 @@
+module;
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+export module core:rhi_software;
+
+import :rhi;
+import :resource_manager_core;
+
+// CPU reference backend: interprets rhi::CommandList with small C++ shaders and a tile-based rasterizer,
+// so render passes can be checked image by image on machines without a GPU.
+
+export namespace rhi
+{
+	inline constexpr std::uint32_t kSoftwareMaxVaryings = 12;
+	inline constexpr std::uint32_t kSoftwareMaxRenderTargets = 8;
+	inline constexpr std::uint32_t kSoftwareMaxResourceSlots = 16;
+	inline constexpr std::uint32_t kSoftwareMaxConstantSlots = 8;
+	inline constexpr std::uint32_t kSoftwareMaxVertexAttributes = 16;
+	inline constexpr std::uint32_t kSoftwareMaxVertexBuffers = 4;
+
+	using SoftwareFloat4 = std::array<float, 4>;
+
+	namespace detail
+	{
+		// Texels are kept as floats whatever the format; UNORM targets are quantized on write so
+		// readbacks match what an 8-bit render target would hold. Depth formats only keep depth.
+		struct SoftwareTexture
+		{
+			Extent2D extent{};
+			Format format{ Format::Unknown };
+			std::uint32_t faces{ 1 };
+			std::vector<SoftwareFloat4> color{};
+			std::vector<float> depth{};
+
+			std::size_t FaceTexels() const noexcept
+			{
+				return static_cast<std::size_t>(extent.width) * extent.height;
+			}
+		};
+
+		struct SoftwareUniform
+		{
+			UniformId id{};
+			int intValue{ 0 };
+			std::array<float, 16> value{};
+		};
+	}
+
+	// Per-vertex attributes fetched through the bound input layout. Slot 0 advances per vertex, other
+	// slots per instance (the same convention the DX12 backend uses for instance streams).
+	struct SoftwareVertexInput
+	{
+		std::span<const VertexAttributeDesc> layout{};
+		std::array<SoftwareFloat4, kSoftwareMaxVertexAttributes> values{};
+		std::uint32_t vertexId{ 0 };
+		std::uint32_t instanceId{ 0 };
+
+		// (0, 0, 0, 1) when the layout has no such attribute.
+		SoftwareFloat4 Attribute(VertexSemantic semantic, std::uint8_t semanticIndex = 0) const noexcept
+		{
+			for (std::size_t i = 0; i < layout.size() && i < values.size(); ++i)
+			{
+				if (layout[i].semantic == semantic && layout[i].semanticIndex == semanticIndex)
+				{
+					return values[i];
+				}
+			}
+			return SoftwareFloat4{ 0.0f, 0.0f, 0.0f, 1.0f };
+		}
+	};
+
+	struct SoftwareVertexOutput
+	{
+		SoftwareFloat4 position{};  // clip space, D3D conventions (0 <= z <= w, y up)
+		std::array<float, kSoftwareMaxVaryings> varyings{};
+	};
+
+	struct SoftwarePixelInput
+	{
+		std::array<float, kSoftwareMaxVaryings> varyings{};  // perspective-correct
+		float x{ 0.0f };      // pixel center in render-target coordinates
+		float y{ 0.0f };
+		float depth{ 0.0f };
+		bool frontFacing{ true };
+	};
+
+	struct SoftwarePixelOutput
+	{
+		std::array<SoftwareFloat4, kSoftwareMaxRenderTargets> colors{};
+		bool discard{ false };
+	};
+
+	// Bindings a draw was recorded with, as seen by its shaders. Pixel shaders run on tile workers
+	// after the pass was recorded, so they get a snapshot rather than the live device state.
+	class SoftwareShaderContext
+	{
+	public:
+		std::span<const std::byte> Constants(std::uint32_t slot) const noexcept
+		{
+			return slot < constants_.size() ? std::span<const std::byte>(constants_[slot]) : std::span<const std::byte>{};
+		}
+
+		// Missing trailing bytes read as zero.
+		template <typename T>
+		T ConstantsAs(std::uint32_t slot) const noexcept
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "constants are copied bytewise");
+			T value{};
+			const std::span<const std::byte> bytes = Constants(slot);
+			std::memcpy(&value, bytes.data(), std::min(bytes.size(), sizeof(T)));
+			return value;
+		}
+
+		int UniformInt(UniformId id) const noexcept
+		{
+			const detail::SoftwareUniform* uniform = FindUniform(id);
+			return uniform ? uniform->intValue : 0;
+		}
+		SoftwareFloat4 UniformFloat4(UniformId id) const noexcept
+		{
+			const detail::SoftwareUniform* uniform = FindUniform(id);
+			return uniform ? SoftwareFloat4{ uniform->value[0], uniform->value[1], uniform->value[2], uniform->value[3] } : SoftwareFloat4{};
+		}
+		std::array<float, 16> UniformMat4(UniformId id) const noexcept
+		{
+			const detail::SoftwareUniform* uniform = FindUniform(id);
+			return uniform ? uniform->value : std::array<float, 16>{};
+		}
+
+		// Structured buffer bound with BindStructuredBufferSRV.
+		std::span<const std::byte> Buffer(std::uint32_t slot) const noexcept
+		{
+			return slot < buffers_.size() ? buffers_[slot] : std::span<const std::byte>{};
+		}
+
+		// Nearest-texel fetch with wrap addressing from the texture bound to `slot` (first face of cube maps).
+		// Unbound slots sample opaque black.
+		SoftwareFloat4 Sample(std::uint32_t slot, float u, float v) const noexcept
+		{
+			const detail::SoftwareTexture* texture = slot < textures_.size() ? textures_[slot] : nullptr;
+			if (!texture || texture->color.empty() || texture->extent.width == 0 || texture->extent.height == 0)
+			{
+				return SoftwareFloat4{ 0.0f, 0.0f, 0.0f, 1.0f };
+			}
+			const auto Wrap = [](float coord, std::uint32_t size)
+				{
+					const float texel = std::floor((coord - std::floor(coord)) * static_cast<float>(size));
+					return std::min(static_cast<std::uint32_t>(std::max(texel, 0.0f)), size - 1);
+				};
+			const std::uint32_t x = Wrap(u, texture->extent.width);
+			const std::uint32_t y = Wrap(v, texture->extent.height);
+			return texture->color[static_cast<std::size_t>(y) * texture->extent.width + x];
+		}
+
+	private:
+		friend class SoftwareDevice;
+
+		const detail::SoftwareUniform* FindUniform(UniformId id) const noexcept
+		{
+			for (const detail::SoftwareUniform& uniform : uniforms_)
+			{
+				if (uniform.id == id)
+				{
+					return &uniform;
+				}
+			}
+			return nullptr;
+		}
+
+		detail::SoftwareUniform& UniformSlot(UniformId id)
+		{
+			for (detail::SoftwareUniform& uniform : uniforms_)
+			{
+				if (uniform.id == id)
+				{
+					return uniform;
+				}
+			}
+			return uniforms_.emplace_back(detail::SoftwareUniform{ id });
+		}
+
+		std::array<std::vector<std::byte>, kSoftwareMaxConstantSlots> constants_{};
+		std::vector<detail::SoftwareUniform> uniforms_{};
+		std::array<const detail::SoftwareTexture*, kSoftwareMaxResourceSlots> textures_{};
+		std::array<std::span<const std::byte>, kSoftwareMaxResourceSlots> buffers_{};
+	};
+
+	// Shaders must not keep mutable state: pixel shaders of one pass run concurrently on tile workers.
+	using SoftwareVertexShader = std::function<SoftwareVertexOutput(const SoftwareVertexInput&, const SoftwareShaderContext&)>;
+	using SoftwarePixelShader = std::function<SoftwarePixelOutput(const SoftwarePixelInput&, const SoftwareShaderContext&)>;
+
+	struct SoftwareDeviceDesc
+	{
+		// Tiles of a pass are rasterized on `jobs` (at most `maxJobs` helper jobs plus the submitting
+		// thread). nullptr rasterizes on the submitting thread; the image is identical either way.
+		IJobSystem* jobs{ nullptr };
+		std::uint32_t maxJobs{ 0 };
+		std::uint32_t tileSize{ 64 };  // pixels, power of two
+	};
+
+	struct SoftwareRasterStats
+	{
+		std::uint64_t passes{ 0 };
+		std::uint64_t draws{ 0 };
+		std::uint64_t skippedDraws{ 0 };          // outside a pass, without a pipeline, or not a triangle list
+		std::uint64_t verticesShaded{ 0 };
+		std::uint64_t trianglesSubmitted{ 0 };
+		std::uint64_t trianglesCulled{ 0 };       // back-facing, degenerate, outside the frustum or the viewport
+		std::uint64_t trianglesRasterized{ 0 };   // after near-plane clipping
+		std::uint64_t tileBinEntries{ 0 };        // triangle references summed over all tiles
+		std::uint64_t pixelsShaded{ 0 };
+		std::uint64_t pixelsDepthRejected{ 0 };
+		double submitMs{ 0.0 };                   // command decode, vertex shading, clipping and binning
+		double rasterMs{ 0.0 };                   // tile rasterization and pixel shading
+	};
+
+	class SoftwareDevice final : public IRHIDevice
+	{
+	public:
+		explicit SoftwareDevice(SoftwareDeviceDesc desc = {})
+			: desc_(desc)
+		{
+			if (desc_.tileSize == 0 || (desc_.tileSize & (desc_.tileSize - 1)) != 0)
+			{
+				throw std::runtime_error("SoftwareDevice: tileSize must be a power of two");
+			}
+		}
+
+		std::string_view GetName() const override
+		{
+			return "Software RHI Device";
+		}
+
+		Backend GetBackend() const noexcept override
+		{
+			return Backend::Software;
+		}
+
+		// CPU shaders are looked up by the debug name passed to CreateShader(). Unregistered vertex shaders
+		// pass the Position attribute through as clip space and forward Color (varyings 0-3) and TexCoord
+		// (4-5); unregistered pixel shaders write varyings 0-3 to every target.
+		void RegisterVertexShader(std::string name, SoftwareVertexShader shader)
+		{
+			vertexShaderRegistry_[std::move(name)] = std::move(shader);
+		}
+		void RegisterPixelShader(std::string name, SoftwarePixelShader shader)
+		{
+			pixelShaderRegistry_[std::move(name)] = std::move(shader);
+		}
+
+		TextureHandle CreateTexture2D(Extent2D extent, Format format) override
+		{
+			return textures_.Insert(MakeTexture(extent, format, 1));
+		}
+		TextureHandle CreateTextureCube(Extent2D extent, Format format) override
+		{
+			return textures_.Insert(MakeTexture(extent, format, 6));
+		}
+		void DestroyTexture(TextureHandle texture) noexcept override
+		{
+			textures_.Erase(texture);
+		}
+
+		// Texels are row-major, top row first.
+		void WriteTexture(TextureHandle texture, std::span<const SoftwareFloat4> texels, std::uint32_t face = 0)
+		{
+			detail::SoftwareTexture& target = TextureOrThrow(texture, face, "WriteTexture");
+			if (target.color.empty() || texels.size() != target.FaceTexels())
+			{
+				throw std::runtime_error("SoftwareDevice::WriteTexture: texel count does not match a color texture face");
+			}
+			std::copy(texels.begin(), texels.end(), target.color.begin() + face * target.FaceTexels());
+		}
+
+		std::vector<SoftwareFloat4> ReadTexture(TextureHandle texture, std::uint32_t face = 0)
+		{
+			const detail::SoftwareTexture& source = TextureOrThrow(texture, face, "ReadTexture");
+			const auto first = source.color.begin() + face * source.FaceTexels();
+			return source.color.empty() ? std::vector<SoftwareFloat4>{} : std::vector<SoftwareFloat4>(first, first + source.FaceTexels());
+		}
+
+		// One 0xAABBGGRR word per texel (R in the low byte), for image hashes and golden comparisons.
+		std::vector<std::uint32_t> ReadTextureRGBA8(TextureHandle texture, std::uint32_t face = 0)
+		{
+			const std::vector<SoftwareFloat4> texels = ReadTexture(texture, face);
+			std::vector<std::uint32_t> packed(texels.size());
+			for (std::size_t i = 0; i < texels.size(); ++i)
+			{
+				std::uint32_t word = 0;
+				for (std::uint32_t c = 0; c < 4; ++c)
+				{
+					const float unorm = std::clamp(texels[i][c], 0.0f, 1.0f);
+					word |= static_cast<std::uint32_t>(std::lround(unorm * 255.0f)) << (8u * c);
+				}
+				packed[i] = word;
+			}
+			return packed;
+		}
+
+		std::vector<float> ReadDepth(TextureHandle texture, std::uint32_t face = 0)
+		{
+			const detail::SoftwareTexture& source = TextureOrThrow(texture, face, "ReadDepth");
+			const auto first = source.depth.begin() + face * source.FaceTexels();
+			return source.depth.empty() ? std::vector<float>{} : std::vector<float>(first, first + source.FaceTexels());
+		}
+
+		FrameBufferHandle CreateFramebuffer(TextureHandle color, TextureHandle depth) override
+		{
+			return CreateFramebufferMRT(color ? std::span<const TextureHandle>(&color, 1) : std::span<const TextureHandle>{}, depth);
+		}
+		FrameBufferHandle CreateFramebufferMRT(std::span<const TextureHandle> colors, TextureHandle depth) override
+		{
+			if (colors.size() > kSoftwareMaxRenderTargets)
+			{
+				throw std::runtime_error("SoftwareDevice::CreateFramebufferMRT: too many color attachments");
+			}
+			Framebuffer framebuffer{};
+			for (const TextureHandle color : colors)
+			{
+				framebuffer.colors[framebuffer.colorCount++] = Attachment{ color, 0 };
+			}
+			framebuffer.depth = Attachment{ depth, 0 };
+			return framebuffers_.Insert(framebuffer);
+		}
+		FrameBufferHandle CreateFramebufferCubeFace(TextureHandle colorCube, std::uint32_t faceIndex, TextureHandle depth) override
+		{
+			Framebuffer framebuffer{};
+			if (colorCube)
+			{
+				framebuffer.colors[framebuffer.colorCount++] = Attachment{ colorCube, faceIndex };
+			}
+			framebuffer.depth = Attachment{ depth, 0 };
+			return framebuffers_.Insert(framebuffer);
+		}
+		void DestroyFramebuffer(FrameBufferHandle framebuffer) noexcept override
+		{
+			framebuffers_.Erase(framebuffer);
+		}
+
+		BufferHandle CreateBuffer(const BufferDesc& desc) override
+		{
+			const BufferHandle buffer = buffers_.Insert(std::vector<std::byte>(desc.sizeInBytes));
+			indirectValidator_.OnCreateBuffer(buffer, desc);
+			return buffer;
+		}
+		void UpdateBuffer(BufferHandle buffer, std::span<const std::byte> data, std::size_t offsetBytes = 0) override
+		{
+			indirectValidator_.OnUpdateBuffer(buffer, data, offsetBytes);
+			std::vector<std::byte>* bytes = buffers_.Find(buffer);
+			if (!bytes)
+			{
+				throw std::runtime_error("SoftwareDevice::UpdateBuffer: invalid buffer handle");
+			}
+			if (offsetBytes > bytes->size() || data.size() > bytes->size() - offsetBytes)
+			{
+				throw std::runtime_error("SoftwareDevice::UpdateBuffer: write past the end of the buffer");
+			}
+			std::copy(data.begin(), data.end(), bytes->begin() + static_cast<std::ptrdiff_t>(offsetBytes));
+		}
+		void DestroyBuffer(BufferHandle buffer) noexcept override
+		{
+			buffers_.Erase(buffer);
+			indirectValidator_.OnDestroyBuffer(buffer);
+		}
+
+		InputLayoutHandle CreateInputLayout(const InputLayoutDesc& desc) override
+		{
+			if (desc.attributes.size() > kSoftwareMaxVertexAttributes)
+			{
+				throw std::runtime_error("SoftwareDevice::CreateInputLayout: too many attributes");
+			}
+			return layouts_.Insert(desc);
+		}
+		void DestroyInputLayout(InputLayoutHandle layout) noexcept override
+		{
+			layouts_.Erase(layout);
+		}
+
+		ShaderHandle CreateShader(ShaderStage stage, std::string_view debugName, std::string_view) override
+		{
+			Shader shader{ stage };
+			const std::string name(debugName);
+			if (stage == ShaderStage::Vertex)
+			{
+				const auto it = vertexShaderRegistry_.find(name);
+				shader.vertex = it != vertexShaderRegistry_.end() ? it->second : SoftwareVertexShader(DefaultVertexShader);
+			}
+			else if (stage == ShaderStage::Pixel)
+			{
+				const auto it = pixelShaderRegistry_.find(name);
+				shader.pixel = it != pixelShaderRegistry_.end() ? it->second : SoftwarePixelShader(DefaultPixelShader);
+			}
+			return shaders_.Insert(std::move(shader));
+		}
+		void DestroyShader(ShaderHandle shader) noexcept override
+		{
+			shaders_.Erase(shader);
+		}
+
+		PipelineHandle CreatePipeline(std::string_view, ShaderHandle vertexShader, ShaderHandle pixelShader, PrimitiveTopologyType topologyType = PrimitiveTopologyType::Triangle) override
+		{
+			const Shader* vs = shaders_.Find(vertexShader);
+			const Shader* ps = shaders_.Find(pixelShader);
+			if (!vs || vs->stage != ShaderStage::Vertex || !ps || ps->stage != ShaderStage::Pixel)
+			{
+				throw std::runtime_error("SoftwareDevice::CreatePipeline: expected a vertex and a pixel shader");
+			}
+			return pipelines_.Insert(Pipeline{ vs->vertex, ps->pixel, topologyType });
+		}
+		void DestroyPipeline(PipelineHandle pipeline) noexcept override
+		{
+			pipelines_.Erase(pipeline);
+		}
+
+		// Executes the list before returning; passes are rasterized when they end.
+		void SubmitCommandList(CommandList&& commandList) override
+		{
+			indirectValidator_.Validate(commandList);
+
+			const auto start = std::chrono::steady_clock::now();
+			const double rasterBefore = stats_.rasterMs;
+			for (const CommandRecord& record : commandList)
+			{
+				VisitCommand(record, [this](const auto& cmd) { Execute(cmd); });
+			}
+			if (inPass_)
+			{
+				FlushPass();
+				inPass_ = false;
+			}
+			const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			stats_.submitMs += totalMs - (stats_.rasterMs - rasterBefore);
+		}
+
+		const SoftwareRasterStats& GetRasterStats() const noexcept
+		{
+			return stats_;
+		}
+		void ResetRasterStats() noexcept
+		{
+			stats_ = SoftwareRasterStats{};
+		}
+		const IndirectDrawStats& GetIndirectDrawStats() const noexcept
+		{
+			return indirectValidator_.GetStats();
+		}
+
+		TextureDescIndex AllocateTextureDesctiptor(TextureHandle texture) override
+		{
+			TextureDescIndex index = 0;
+			if (!freeDescIndices_.empty())
+			{
+				index = freeDescIndices_.back();
+				freeDescIndices_.pop_back();
+				descFreed_[index] = false;
+			}
+			else
+			{
+				index = static_cast<TextureDescIndex>(descToTex_.size());
+				descToTex_.emplace_back();
+			}
+			descToTex_[index] = texture;
+			return index;
+		}
+		void UpdateTextureDescriptor(TextureDescIndex index, TextureHandle texture) override
+		{
+			if (index != 0 && index < descToTex_.size())
+			{
+				descToTex_[index] = texture;
+			}
+		}
+		void FreeTextureDescriptor(TextureDescIndex index) noexcept override
+		{
+			// Freeing a slot twice would put it on the free list twice and hand it to two owners.
+			if (index != 0 && index < descToTex_.size() && !(index < descFreed_.size() && descFreed_[index]))
+			{
+				descToTex_[index] = {};
+				freeDescIndices_.push_back(index);
+				descFreed_.resize(std::max<std::size_t>(descFreed_.size(), index + 1u), false);
+				descFreed_[index] = true;
+			}
+		}
+		TextureDescIndex ReserveTextureDescriptorRange(std::uint32_t count) override
+		{
+			const TextureDescIndex first = static_cast<TextureDescIndex>(descToTex_.size());
+			descToTex_.resize(descToTex_.size() + count);
+			return first;
+		}
+		void ReleaseTextureDescriptorRange(TextureDescIndex first, std::uint32_t count) noexcept override
+		{
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				FreeTextureDescriptor(first + i);
+			}
+		}
+
+		// Work is finished when SubmitCommandList() returns, so fences and the timeline complete on signal.
+		FenceHandle CreateFence(bool signaled = false) override
+		{
+			return fences_.Insert(signaled);
+		}
+		void DestroyFence(FenceHandle fence) noexcept override
+		{
+			fences_.Erase(fence);
+		}
+		void SignalFence(FenceHandle fence) override
+		{
+			if (bool* signaled = fences_.Find(fence))
+			{
+				*signaled = true;
+			}
+		}
+		void WaitFence(FenceHandle) override {}
+		bool IsFenceSignaled(FenceHandle fence) override
+		{
+			const bool* signaled = fences_.Find(fence);
+			return signaled ? *signaled : true;
+		}
+		std::uint64_t SignalTimeline() override
+		{
+			return ++timeline_;
+		}
+		std::uint64_t GetCompletedTimelineValue() override
+		{
+			return timeline_;
+		}
+		void WaitTimelineValue(std::uint64_t) override {}
+
+	private:
+		struct Attachment
+		{
+			TextureHandle texture{};
+			std::uint32_t face{ 0 };
+		};
+
+		struct Framebuffer
+		{
+			std::array<Attachment, kSoftwareMaxRenderTargets> colors{};
+			std::uint32_t colorCount{ 0 };
+			Attachment depth{};
+		};
+
+		struct Shader
+		{
+			ShaderStage stage{ ShaderStage::Vertex };
+			SoftwareVertexShader vertex{};
+			SoftwarePixelShader pixel{};
+		};
+
+		struct Pipeline
+		{
+			SoftwareVertexShader vertex{};
+			SoftwarePixelShader pixel{};
+			PrimitiveTopologyType topology{ PrimitiveTopologyType::Triangle };
+		};
+
+		struct ColorTarget
+		{
+			SoftwareFloat4* texels{ nullptr };
+			Format format{ Format::Unknown };
+		};
+
+		struct Rect
+		{
+			std::int32_t minX{ 0 };
+			std::int32_t minY{ 0 };
+			std::int32_t maxX{ 0 };   // exclusive
+			std::int32_t maxY{ 0 };
+		};
+
+		// State shared by the triangles of one draw.
+		struct DrawBatch
+		{
+			const SoftwarePixelShader* pixel{ nullptr };
+			std::uint32_t context{ 0 };
+			GraphicsState state{};
+		};
+
+		// Screen-space triangle ready for the tile workers. Edge k is opposite vertex k; its function
+		// a*x + b*y + c is the (unnormalized) barycentric weight of vertex k and is >= 0 inside.
+		struct BinnedTriangle
+		{
+			std::array<float, 3> edgeA{};
+			std::array<float, 3> edgeB{};
+			std::array<float, 3> edgeC{};
+			std::array<bool, 3> inclusive{};   // top-left fill rule: pixels exactly on the edge belong to it
+			float invArea{ 0.0f };
+			std::array<float, 3> z{};
+			std::array<float, 3> invW{};
+			std::array<std::array<float, kSoftwareMaxVaryings>, 3> varyingsOverW{};
+			Rect bounds{};
+			std::uint32_t batch{ 0 };
+			bool frontFacing{ true };
+		};
+
+		struct VertexBinding
+		{
+			const std::vector<std::byte>* bytes{ nullptr };
+			std::uint32_t strideBytes{ 0 };
+			std::uint32_t offsetBytes{ 0 };
+		};
+
+		struct IndexBinding
+		{
+			const std::vector<std::byte>* bytes{ nullptr };
+			std::uint32_t offsetBytes{ 0 };
+		};
+
+		// Same work-sharing scheme as the render graph's parallel recording: helpers and the submitting
+		// thread pull tiles from a counter; the submitting thread waits for tiles, not for helper jobs.
+		struct TileWork
+		{
+			std::function<void(std::size_t)> raster;
+			std::size_t count{ 0 };
+			std::atomic<std::size_t> next{ 0 };
+			std::atomic<std::size_t> done{ 0 };
+			std::mutex errorMutex;
+			std::exception_ptr error;
+
+			void Drain()
+			{
+				for (std::size_t item = next.fetch_add(1); item < count; item = next.fetch_add(1))
+				{
+					try
+					{
+						raster(item);
+					}
+					catch (...)
+					{
+						std::scoped_lock lock(errorMutex);
+						if (!error)
+						{
+							error = std::current_exception();
+						}
+					}
+					if (done.fetch_add(1) + 1 == count)
+					{
+						done.notify_all();
+					}
+				}
+			}
+		};
+
+		static bool IsDepthFormat(Format format) noexcept
+		{
+			return format == Format::D32_FLOAT || format == Format::D24_UNORM_S8_UINT;
+		}
+
+		static detail::SoftwareTexture MakeTexture(Extent2D extent, Format format, std::uint32_t faces)
+		{
+			detail::SoftwareTexture texture{ extent, format, faces };
+			const std::size_t texels = texture.FaceTexels() * faces;
+			if (IsDepthFormat(format))
+			{
+				texture.depth.assign(texels, 1.0f);
+			}
+			else
+			{
+				texture.color.assign(texels, SoftwareFloat4{ 0.0f, 0.0f, 0.0f, 0.0f });
+			}
+			return texture;
+		}
+
+		detail::SoftwareTexture& TextureOrThrow(TextureHandle handle, std::uint32_t face, const char* what)
+		{
+			detail::SoftwareTexture* texture = textures_.Find(handle);
+			if (!texture || face >= texture->faces)
+			{
+				throw std::runtime_error(std::string("SoftwareDevice::") + what + ": invalid texture handle or face");
+			}
+			return *texture;
+		}
+
+		static SoftwareVertexOutput DefaultVertexShader(const SoftwareVertexInput& input, const SoftwareShaderContext&)
+		{
+			SoftwareVertexOutput out{};
+			const SoftwareFloat4 position = input.Attribute(VertexSemantic::Position);
+			out.position = { position[0], position[1], position[2], 1.0f };
+			const SoftwareFloat4 color = input.Attribute(VertexSemantic::Color);
+			const SoftwareFloat4 uv = input.Attribute(VertexSemantic::TexCoord);
+			std::copy(color.begin(), color.end(), out.varyings.begin());
+			out.varyings[4] = uv[0];
+			out.varyings[5] = uv[1];
+			return out;
+		}
+
+		static SoftwarePixelOutput DefaultPixelShader(const SoftwarePixelInput& input, const SoftwareShaderContext&)
+		{
+			SoftwarePixelOutput out{};
+			out.colors.fill(SoftwareFloat4{ input.varyings[0], input.varyings[1], input.varyings[2], input.varyings[3] });
+			return out;
+		}
+
+		static SoftwareFloat4 ToTargetFormat(Format format, SoftwareFloat4 value) noexcept
+		{
+			switch (format)
+			{
+			case Format::RGBA8_UNORM:
+			case Format::BGRA8_UNORM:
+				for (float& channel : value)
+				{
+					channel = std::round(std::clamp(channel, 0.0f, 1.0f) * 255.0f) / 255.0f;
+				}
+				return value;
+			case Format::R32_FLOAT:
+				return SoftwareFloat4{ value[0], 0.0f, 0.0f, 1.0f };
+			default:
+				return value;
+			}
+		}
+
+		static bool DepthPasses(CompareOp op, float incoming, float stored) noexcept
+		{
+			switch (op)
+			{
+			case CompareOp::Never: return false;
+			case CompareOp::Less: return incoming < stored;
+			case CompareOp::Equal: return incoming == stored;
+			case CompareOp::LessEqual: return incoming <= stored;
+			case CompareOp::Greater: return incoming > stored;
+			case CompareOp::NotEqual: return incoming != stored;
+			case CompareOp::GreaterEqual: return incoming >= stored;
+			case CompareOp::Always: return true;
+			}
+			return true;
+		}
+
+		static SoftwareFloat4 Blend(const BlendState& blend, const SoftwareFloat4& src, const SoftwareFloat4& dst) noexcept
+		{
+			if (!blend.enable)
+			{
+				return src;
+			}
+			const float alpha = src[3];
+			SoftwareFloat4 out{};
+			for (std::size_t c = 0; c < 3; ++c)
+			{
+				out[c] = blend.mode == BlendMode::Additive
+					? src[c] * alpha + dst[c]
+					: src[c] * alpha + dst[c] * (1.0f - alpha);
+			}
+			out[3] = blend.mode == BlendMode::Additive ? alpha + dst[3] : alpha + dst[3] * (1.0f - alpha);
+			return out;
+		}
+
+		static std::uint32_t VertexFormatBytes(VertexFormat format) noexcept
+		{
+			switch (format)
+			{
+			case VertexFormat::R32G32B32_FLOAT: return 12;
+			case VertexFormat::R32G32_FLOAT: return 8;
+			case VertexFormat::R32G32B32A32_FLOAT: return 16;
+			case VertexFormat::R8G8B8A8_UNORM: return 4;
+			case VertexFormat::R16G16B16A16_UINT: return 8;
+			case VertexFormat::R16G16B16A16_UNORM: return 8;
+			case VertexFormat::R32G32B32A32_UINT: return 16;
+			}
+			return 0;
+		}
+
+		static SoftwareFloat4 DecodeVertexFormat(VertexFormat format, const std::byte* src) noexcept
+		{
+			SoftwareFloat4 value{ 0.0f, 0.0f, 0.0f, 1.0f };
+			switch (format)
+			{
+			case VertexFormat::R32G32B32_FLOAT: std::memcpy(value.data(), src, 12); break;
+			case VertexFormat::R32G32_FLOAT: std::memcpy(value.data(), src, 8); break;
+			case VertexFormat::R32G32B32A32_FLOAT: std::memcpy(value.data(), src, 16); break;
+			case VertexFormat::R8G8B8A8_UNORM:
+				for (std::size_t c = 0; c < 4; ++c)
+				{
+					value[c] = static_cast<float>(std::to_integer<std::uint8_t>(src[c])) / 255.0f;
+				}
+				break;
+			case VertexFormat::R16G16B16A16_UINT:
+			case VertexFormat::R16G16B16A16_UNORM:
+			{
+				std::array<std::uint16_t, 4> raw{};
+				std::memcpy(raw.data(), src, sizeof(raw));
+				const float scale = format == VertexFormat::R16G16B16A16_UNORM ? 1.0f / 65535.0f : 1.0f;
+				for (std::size_t c = 0; c < 4; ++c)
+				{
+					value[c] = static_cast<float>(raw[c]) * scale;
+				}
+				break;
+			}
+			case VertexFormat::R32G32B32A32_UINT:
+			{
+				std::array<std::uint32_t, 4> raw{};
+				std::memcpy(raw.data(), src, sizeof(raw));
+				for (std::size_t c = 0; c < 4; ++c)
+				{
+					value[c] = static_cast<float>(raw[c]);
+				}
+				break;
+			}
+			}
+			return value;
+		}
+
+		// ---------------- Command execution ----------------
+
+		void Execute(const CommandBeginPass& cmd)
+		{
+			if (inPass_)
+			{
+				FlushPass();
+			}
+			inPass_ = true;
+			++stats_.passes;
+
+			FrameBufferHandle framebufferHandle = cmd.desc.frameBuffer;
+			if (!framebufferHandle && cmd.desc.swapChain)
+			{
+				framebufferHandle = cmd.desc.swapChain->GetCurrentBackBuffer();
+			}
+
+			colorTargets_.clear();
+			depthTarget_ = nullptr;
+			Extent2D extent = cmd.desc.extent;
+			if (const Framebuffer* framebuffer = framebuffers_.Find(framebufferHandle))
+			{
+				for (std::uint32_t i = 0; i < framebuffer->colorCount; ++i)
+				{
+					const Attachment& attachment = framebuffer->colors[i];
+					detail::SoftwareTexture& texture = TextureOrThrow(attachment.texture, attachment.face, "BeginPass");
+					if (texture.color.empty())
+					{
+						throw std::runtime_error("SoftwareDevice::BeginPass: color attachment has a depth format");
+					}
+					colorTargets_.push_back(ColorTarget{ texture.color.data() + attachment.face * texture.FaceTexels(), texture.format });
+					extent = texture.extent;
+				}
+				if (framebuffer->depth.texture && cmd.desc.bindDepthStencil)
+				{
+					detail::SoftwareTexture& texture = TextureOrThrow(framebuffer->depth.texture, framebuffer->depth.face, "BeginPass");
+					if (texture.depth.empty())
+					{
+						throw std::runtime_error("SoftwareDevice::BeginPass: depth attachment has a color format");
+					}
+					depthTarget_ = texture.depth.data() + framebuffer->depth.face * texture.FaceTexels();
+					extent = texture.extent;
+				}
+			}
+			targetExtent_ = extent;
+
+			const ClearDesc& clear = cmd.desc.clearDesc;
+			const std::size_t texels = static_cast<std::size_t>(extent.width) * extent.height;
+			if (clear.clearColor)
+			{
+				for (const ColorTarget& target : colorTargets_)
+				{
+					std::fill_n(target.texels, texels, ToTargetFormat(target.format, clear.color));
+				}
+			}
+			if (clear.clearDepth && depthTarget_)
+			{
+				std::fill_n(depthTarget_, texels, clear.depth);
+			}
+
+			viewport_ = Rect{ 0, 0, static_cast<std::int32_t>(extent.width), static_cast<std::int32_t>(extent.height) };
+			tileShift_ = static_cast<std::uint32_t>(std::countr_zero(desc_.tileSize));
+			tilesX_ = (extent.width + desc_.tileSize - 1) >> tileShift_;
+			tilesY_ = (extent.height + desc_.tileSize - 1) >> tileShift_;
+			bins_.resize(static_cast<std::size_t>(tilesX_) * tilesY_);
+			for (std::vector<std::uint32_t>& bin : bins_)
+			{
+				bin.clear();
+			}
+			triangles_.clear();
+			batches_.clear();
+			contexts_.clear();
+			contextDirty_ = true;
+		}
+
+		void Execute(const CommandEndPass&)
+		{
+			if (inPass_)
+			{
+				FlushPass();
+				inPass_ = false;
+			}
+		}
+
+		void Execute(const CommandSetViewport& cmd)
+		{
+			viewport_ = Rect{ cmd.x, cmd.y, cmd.x + cmd.width, cmd.y + cmd.height };
+		}
+		void Execute(const CommandSetState& cmd)
+		{
+			state_ = cmd.state;
+		}
+		void Execute(const CommandSetStencilRef&) {}
+		void Execute(const CommandSetPrimitiveTopology& cmd)
+		{
+			topology_ = cmd.topology;
+		}
+		void Execute(const CommandBindPipeline& cmd)
+		{
+			pipeline_ = pipelines_.Find(cmd.pso);
+		}
+		void Execute(const CommandBindInputLayout& cmd)
+		{
+			layout_ = layouts_.Find(cmd.layout);
+		}
+		void Execute(const CommandBindVertexBuffer& cmd)
+		{
+			if (cmd.slot >= kSoftwareMaxVertexBuffers)
+			{
+				throw std::runtime_error("SoftwareDevice: vertex buffer slot out of range");
+			}
+			vertexBuffers_[cmd.slot] = VertexBinding{ buffers_.Find(cmd.buffer), cmd.strideBytes, cmd.offsetBytes };
+		}
+		void Execute(const CommandBindIndexBuffer& cmd)
+		{
+			indexBuffer_ = IndexBinding{ buffers_.Find(cmd.buffer), cmd.offsetBytes };
+		}
+		void Execute(const CommnadBindTexture2D& cmd)
+		{
+			BindTexture(cmd.slot, cmd.texture);
+		}
+		void Execute(const CommandBindTextureCube& cmd)
+		{
+			BindTexture(cmd.slot, cmd.texture);
+		}
+		void Execute(const CommandBindTexture2DArray& cmd)
+		{
+			BindTexture(cmd.slot, cmd.texture);
+		}
+		void Execute(const CommandTextureDesc& cmd)
+		{
+			BindTexture(cmd.slot, cmd.texture < descToTex_.size() ? descToTex_[cmd.texture] : TextureHandle{});
+		}
+		void Execute(const CommandBindStructuredBufferSRV& cmd)
+		{
+			CheckResourceSlot(cmd.slot);
+			const std::vector<std::byte>* bytes = buffers_.Find(cmd.buffer);
+			current_.buffers_[cmd.slot] = bytes ? std::span<const std::byte>(*bytes) : std::span<const std::byte>{};
+			contextDirty_ = true;
+		}
+		void Execute(const CommandSetUniformInt& cmd)
+		{
+			current_.UniformSlot(cmd.id).intValue = cmd.value;
+			contextDirty_ = true;
+		}
+		void Execute(const CommandUniformFloat4& cmd)
+		{
+			std::copy(cmd.value.begin(), cmd.value.end(), current_.UniformSlot(cmd.id).value.begin());
+			contextDirty_ = true;
+		}
+		void Execute(const CommandUniformMat4& cmd)
+		{
+			current_.UniformSlot(cmd.id).value = cmd.value;
+			contextDirty_ = true;
+		}
+		void Execute(const CommandSetConstants& cmd)
+		{
+			if (cmd.slot >= kSoftwareMaxConstantSlots)
+			{
+				throw std::runtime_error("SoftwareDevice: constants slot out of range");
+			}
+			current_.constants_[cmd.slot].assign(cmd.data.begin(), cmd.data.end());
+			contextDirty_ = true;
+		}
+		void Execute(const CommandDX12ImGuiRender&) {}
+		void Execute(const CommandTransitionTextures&) {}
+
+		void Execute(const CommandDraw& cmd)
+		{
+			DrawPrimitives(false, cmd.vertexCount, cmd.firstVertex, 0, cmd.instanceCount, cmd.firstInstance, IndexType::UINT32);
+		}
+		void Execute(const CommandDrawIndexed& cmd)
+		{
+			DrawPrimitives(true, cmd.indexCount, cmd.firstIndex, cmd.baseVertex, cmd.instanceCount, cmd.firstInstance, cmd.indexType);
+		}
+		void Execute(const CommandDrawIndexedIndirect& cmd)
+		{
+			// The validator already checked the argument range at submit.
+			const std::vector<std::byte>* args = buffers_.Find(cmd.argsBuffer);
+			if (!args)
+			{
+				return;
+			}
+			for (std::uint32_t draw = 0; draw < cmd.drawCount; ++draw)
+			{
+				DrawIndexedIndirectArgs record{};
+				std::memcpy(&record, args->data() + cmd.argsOffsetBytes + static_cast<std::size_t>(draw) * cmd.strideBytes, sizeof(record));
+				DrawPrimitives(true, record.indexCount, record.firstIndex, record.baseVertex, record.instanceCount, record.firstInstance, cmd.indexType);
+			}
+		}
+
+		void CheckResourceSlot(std::uint32_t slot) const
+		{
+			if (slot >= kSoftwareMaxResourceSlots)
+			{
+				throw std::runtime_error("SoftwareDevice: resource slot out of range");
+			}
+		}
+
+		void BindTexture(std::uint32_t slot, TextureHandle texture)
+		{
+			CheckResourceSlot(slot);
+			current_.textures_[slot] = textures_.Find(texture);
+			contextDirty_ = true;
+		}
+
+		// ---------------- Geometry: vertex shading, clipping, setup, binning ----------------
+
+		std::uint32_t FetchIndex(IndexType indexType, std::uint32_t index) const
+		{
+			const std::size_t size = indexType == IndexType::UINT16 ? 2u : 4u;
+			const std::size_t offset = indexBuffer_.offsetBytes + static_cast<std::size_t>(index) * size;
+			if (!indexBuffer_.bytes || offset + size > indexBuffer_.bytes->size())
+			{
+				throw std::runtime_error("SoftwareDevice: index fetch outside the bound index buffer");
+			}
+			if (indexType == IndexType::UINT16)
+			{
+				std::uint16_t value = 0;
+				std::memcpy(&value, indexBuffer_.bytes->data() + offset, sizeof(value));
+				return value;
+			}
+			std::uint32_t value = 0;
+			std::memcpy(&value, indexBuffer_.bytes->data() + offset, sizeof(value));
+			return value;
+		}
+
+		SoftwareVertexOutput ShadeVertex(std::uint32_t vertexIndex, std::uint32_t instanceIndex, const SoftwareShaderContext& context)
+		{
+			SoftwareVertexInput input{};
+			input.vertexId = vertexIndex;
+			input.instanceId = instanceIndex;
+			if (layout_)
+			{
+				input.layout = layout_->attributes;
+				for (std::size_t i = 0; i < layout_->attributes.size(); ++i)
+				{
+					const VertexAttributeDesc& attribute = layout_->attributes[i];
+					if (attribute.inputSlot >= kSoftwareMaxVertexBuffers || !vertexBuffers_[attribute.inputSlot].bytes)
+					{
+						throw std::runtime_error("SoftwareDevice: input layout reads an unbound vertex buffer slot");
+					}
+					const VertexBinding& binding = vertexBuffers_[attribute.inputSlot];
+					const std::uint32_t stride = binding.strideBytes != 0 ? binding.strideBytes : layout_->strideBytes;
+					const std::uint32_t element = attribute.inputSlot == 0 ? vertexIndex : instanceIndex;
+					const std::size_t offset = binding.offsetBytes + static_cast<std::size_t>(element) * stride + attribute.offsetBytes;
+					if (offset + VertexFormatBytes(attribute.format) > binding.bytes->size())
+					{
+						throw std::runtime_error("SoftwareDevice: vertex fetch outside the bound vertex buffer");
+					}
+					input.values[i] = DecodeVertexFormat(attribute.format, binding.bytes->data() + offset);
+				}
+			}
+			++stats_.verticesShaded;
+			return pipeline_->vertex(input, context);
+		}
+
+		void DrawPrimitives(
+			bool indexed,
+			std::uint32_t count,
+			std::uint32_t first,
+			std::int32_t baseVertex,
+			std::uint32_t instanceCount,
+			std::uint32_t firstInstance,
+			IndexType indexType)
+		{
+			++stats_.draws;
+			if (!inPass_ || !pipeline_ || !pipeline_->vertex || !pipeline_->pixel ||
+				pipeline_->topology != PrimitiveTopologyType::Triangle || topology_ != PrimitiveTopology::TriangleList)
+			{
+				++stats_.skippedDraws;
+				return;
+			}
+
+			if (contextDirty_)
+			{
+				contexts_.push_back(current_);
+				contextDirty_ = false;
+			}
+			const std::uint32_t contextIndex = static_cast<std::uint32_t>(contexts_.size() - 1);
+			const SoftwareShaderContext& context = contexts_.back();
+			const std::uint32_t batchIndex = static_cast<std::uint32_t>(batches_.size());
+			batches_.push_back(DrawBatch{ &pipeline_->pixel, contextIndex, state_ });
+
+			const std::uint32_t triangleCount = count / 3;
+			const std::size_t firstSetup = triangles_.size();
+			for (std::uint32_t instance = 0; instance < instanceCount; ++instance)
+			{
+				// Post-transform cache: each vertex of the draw is shaded once per instance.
+				vertexCache_.clear();
+				vertexCacheSlot_.clear();
+				auto Vertex = [&](std::uint32_t element) -> const SoftwareVertexOutput&
+					{
+						const std::uint32_t vertexIndex = indexed
+							? static_cast<std::uint32_t>(static_cast<std::int64_t>(FetchIndex(indexType, first + element)) + baseVertex)
+							: first + element;
+						auto [it, inserted] = vertexCacheSlot_.try_emplace(vertexIndex, static_cast<std::uint32_t>(vertexCache_.size()));
+						if (inserted)
+						{
+							vertexCache_.push_back(ShadeVertex(vertexIndex, firstInstance + instance, context));
+						}
+						return vertexCache_[it->second];
+					};
+
+				for (std::uint32_t triangle = 0; triangle < triangleCount; ++triangle)
+				{
+					++stats_.trianglesSubmitted;
+					const SoftwareVertexOutput v0 = Vertex(triangle * 3 + 0);
+					const SoftwareVertexOutput v1 = Vertex(triangle * 3 + 1);
+					const SoftwareVertexOutput v2 = Vertex(triangle * 3 + 2);
+					ClipAndSetup(v0, v1, v2, batchIndex);
+				}
+			}
+			BinTriangles(firstSetup);
+		}
+
+		// Trivially rejects triangles outside one frustum plane, clips the rest against the near plane
+		// (z >= 0) and fans the result into setup triangles. Other planes are handled by the viewport
+		// bounds and the per-pixel depth clip.
+		void ClipAndSetup(const SoftwareVertexOutput& v0, const SoftwareVertexOutput& v1, const SoftwareVertexOutput& v2, std::uint32_t batch)
+		{
+			const std::array<const SoftwareVertexOutput*, 3> in{ &v0, &v1, &v2 };
+			const auto AllOutside = [&in](auto&& outside)
+				{
+					return outside(in[0]->position) && outside(in[1]->position) && outside(in[2]->position);
+				};
+			if (AllOutside([](const SoftwareFloat4& p) { return p[0] < -p[3]; }) ||
+				AllOutside([](const SoftwareFloat4& p) { return p[0] > p[3]; }) ||
+				AllOutside([](const SoftwareFloat4& p) { return p[1] < -p[3]; }) ||
+				AllOutside([](const SoftwareFloat4& p) { return p[1] > p[3]; }) ||
+				AllOutside([](const SoftwareFloat4& p) { return p[2] < 0.0f; }) ||
+				AllOutside([](const SoftwareFloat4& p) { return p[2] > p[3]; }))
+			{
+				++stats_.trianglesCulled;
+				return;
+			}
+
+			if (v0.position[2] >= 0.0f && v1.position[2] >= 0.0f && v2.position[2] >= 0.0f)
+			{
+				SetupTriangle(v0, v1, v2, batch);
+				return;
+			}
+
+			std::array<SoftwareVertexOutput, 4> clipped{};
+			std::size_t clippedCount = 0;
+			for (std::size_t i = 0; i < 3; ++i)
+			{
+				const SoftwareVertexOutput& a = *in[i];
+				const SoftwareVertexOutput& b = *in[(i + 1) % 3];
+				const float da = a.position[2];
+				const float db = b.position[2];
+				if (da >= 0.0f)
+				{
+					clipped[clippedCount++] = a;
+				}
+				if ((da >= 0.0f) != (db >= 0.0f))
+				{
+					const float t = da / (da - db);
+					SoftwareVertexOutput& out = clipped[clippedCount++];
+					for (std::size_t c = 0; c < 4; ++c)
+					{
+						out.position[c] = a.position[c] + (b.position[c] - a.position[c]) * t;
+					}
+					for (std::size_t c = 0; c < kSoftwareMaxVaryings; ++c)
+					{
+						out.varyings[c] = a.varyings[c] + (b.varyings[c] - a.varyings[c]) * t;
+					}
+				}
+			}
+			for (std::size_t i = 1; i + 1 < clippedCount; ++i)
+			{
+				SetupTriangle(clipped[0], clipped[i], clipped[i + 1], batch);
+			}
+		}
+
+		void SetupTriangle(const SoftwareVertexOutput& v0, const SoftwareVertexOutput& v1, const SoftwareVertexOutput& v2, std::uint32_t batch)
+		{
+			std::array<const SoftwareVertexOutput*, 3> v{ &v0, &v1, &v2 };
+			std::array<float, 3> x{};
+			std::array<float, 3> y{};
+			std::array<float, 3> invW{};
+			const float viewportWidth = static_cast<float>(viewport_.maxX - viewport_.minX);
+			const float viewportHeight = static_cast<float>(viewport_.maxY - viewport_.minY);
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				if (!(v[k]->position[3] > 0.0f))
+				{
+					++stats_.trianglesCulled;
+					return;
+				}
+				invW[k] = 1.0f / v[k]->position[3];
+				x[k] = static_cast<float>(viewport_.minX) + (v[k]->position[0] * invW[k] * 0.5f + 0.5f) * viewportWidth;
+				y[k] = static_cast<float>(viewport_.minY) + (0.5f - v[k]->position[1] * invW[k] * 0.5f) * viewportHeight;
+			}
+
+			float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+			// Y points down in screen space, so counter-clockwise in NDC has a negative area here.
+			const bool frontFacing = state_.rasterizer.frontFace == FrontFace::CounterClockwise ? area < 0.0f : area > 0.0f;
+			const CullMode cull = state_.rasterizer.cullMode;
+			if (!(std::abs(area) > 0.0f) || (cull == CullMode::Back && !frontFacing) || (cull == CullMode::Front && frontFacing))
+			{
+				++stats_.trianglesCulled;
+				return;
+			}
+			if (area < 0.0f)
+			{
+				std::swap(v[1], v[2]);
+				std::swap(x[1], x[2]);
+				std::swap(y[1], y[2]);
+				std::swap(invW[1], invW[2]);
+				area = -area;
+			}
+
+			Rect bounds{};
+			bounds.minX = std::max({ viewport_.minX, 0, static_cast<std::int32_t>(std::floor(std::min({ x[0], x[1], x[2] }))) });
+			bounds.minY = std::max({ viewport_.minY, 0, static_cast<std::int32_t>(std::floor(std::min({ y[0], y[1], y[2] }))) });
+			bounds.maxX = std::min({ viewport_.maxX, static_cast<std::int32_t>(targetExtent_.width), static_cast<std::int32_t>(std::ceil(std::max({ x[0], x[1], x[2] }))) + 1 });
+			bounds.maxY = std::min({ viewport_.maxY, static_cast<std::int32_t>(targetExtent_.height), static_cast<std::int32_t>(std::ceil(std::max({ y[0], y[1], y[2] }))) + 1 });
+			if (bounds.minX >= bounds.maxX || bounds.minY >= bounds.maxY)
+			{
+				++stats_.trianglesCulled;
+				return;
+			}
+
+			BinnedTriangle& setup = triangles_.emplace_back();
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				const std::size_t a = (k + 1) % 3;
+				const std::size_t b = (k + 2) % 3;
+				setup.edgeA[k] = y[a] - y[b];
+				setup.edgeB[k] = x[b] - x[a];
+				setup.edgeC[k] = -(setup.edgeA[k] * x[a] + setup.edgeB[k] * y[a]);
+				setup.inclusive[k] = setup.edgeA[k] > 0.0f || (setup.edgeA[k] == 0.0f && setup.edgeB[k] < 0.0f);
+				setup.z[k] = v[k]->position[2] * invW[k];
+				setup.invW[k] = invW[k];
+				for (std::size_t c = 0; c < kSoftwareMaxVaryings; ++c)
+				{
+					setup.varyingsOverW[k][c] = v[k]->varyings[c] * invW[k];
+				}
+			}
+			setup.invArea = 1.0f / area;
+			setup.bounds = bounds;
+			setup.batch = batch;
+			setup.frontFacing = frontFacing;
+			++stats_.trianglesRasterized;
+		}
+
+		// Tile ranges are computed for the whole draw in one branch-free pass over SoA arrays (which the
+		// compiler vectorizes), then triangle indices are appended to the bins in submission order so
+		// every tile replays its triangles in API order.
+		void BinTriangles(std::size_t firstSetup)
+		{
+			const std::size_t count = triangles_.size() - firstSetup;
+			binMinX_.resize(count);
+			binMinY_.resize(count);
+			binMaxX_.resize(count);
+			binMaxY_.resize(count);
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const Rect& bounds = triangles_[firstSetup + i].bounds;
+				binMinX_[i] = static_cast<std::uint32_t>(bounds.minX) >> tileShift_;
+				binMinY_[i] = static_cast<std::uint32_t>(bounds.minY) >> tileShift_;
+				binMaxX_[i] = static_cast<std::uint32_t>(bounds.maxX - 1) >> tileShift_;
+				binMaxY_[i] = static_cast<std::uint32_t>(bounds.maxY - 1) >> tileShift_;
+			}
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const std::uint32_t triangle = static_cast<std::uint32_t>(firstSetup + i);
+				for (std::uint32_t tileY = binMinY_[i]; tileY <= binMaxY_[i]; ++tileY)
+				{
+					for (std::uint32_t tileX = binMinX_[i]; tileX <= binMaxX_[i]; ++tileX)
+					{
+						bins_[static_cast<std::size_t>(tileY) * tilesX_ + tileX].push_back(triangle);
+					}
+				}
+				stats_.tileBinEntries += static_cast<std::uint64_t>(binMaxY_[i] - binMinY_[i] + 1) * (binMaxX_[i] - binMinX_[i] + 1);
+			}
+		}
+
+		// ---------------- Tile rasterization ----------------
+
+		struct TileCounters
+		{
+			std::uint64_t shaded{ 0 };
+			std::uint64_t depthRejected{ 0 };
+		};
+
+		void FlushPass()
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			activeTiles_.clear();
+			for (std::uint32_t tile = 0; tile < bins_.size(); ++tile)
+			{
+				if (!bins_[tile].empty())
+				{
+					activeTiles_.push_back(tile);
+				}
+			}
+
+			if (!activeTiles_.empty())
+			{
+				std::atomic<std::uint64_t> shaded{ 0 };
+				std::atomic<std::uint64_t> depthRejected{ 0 };
+				auto work = std::make_shared<TileWork>();
+				work->count = activeTiles_.size();
+				work->raster = [this, &shaded, &depthRejected](std::size_t item)
+					{
+						TileCounters counters{};
+						RasterTile(activeTiles_[item], counters);
+						shaded.fetch_add(counters.shaded, std::memory_order_relaxed);
+						depthRejected.fetch_add(counters.depthRejected, std::memory_order_relaxed);
+					};
+
+				const std::size_t helperJobs = desc_.jobs ? std::min<std::size_t>(desc_.maxJobs, activeTiles_.size() - 1) : 0;
+				for (std::size_t job = 0; job < helperJobs; ++job)
+				{
+					desc_.jobs->Enqueue([work]() { work->Drain(); });
+				}
+				work->Drain();
+				for (std::size_t done = work->done.load(); done < work->count; done = work->done.load())
+				{
+					work->done.wait(done);
+				}
+				if (work->error)
+				{
+					std::rethrow_exception(work->error);
+				}
+				stats_.pixelsShaded += shaded.load();
+				stats_.pixelsDepthRejected += depthRejected.load();
+			}
+
+			for (std::vector<std::uint32_t>& bin : bins_)
+			{
+				bin.clear();
+			}
+			triangles_.clear();
+			batches_.clear();
+			contexts_.clear();
+			contextDirty_ = true;
+
+			stats_.rasterMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		}
+
+		void RasterTile(std::uint32_t tile, TileCounters& counters) const
+		{
+			constexpr std::int32_t kLanes = 4;
+			const std::int32_t tileMinX = static_cast<std::int32_t>((tile % tilesX_) << tileShift_);
+			const std::int32_t tileMinY = static_cast<std::int32_t>((tile / tilesX_) << tileShift_);
+			const std::int32_t tileMaxX = tileMinX + static_cast<std::int32_t>(desc_.tileSize);
+			const std::int32_t tileMaxY = tileMinY + static_cast<std::int32_t>(desc_.tileSize);
+
+			for (const std::uint32_t triangleIndex : bins_[tile])
+			{
+				const BinnedTriangle& triangle = triangles_[triangleIndex];
+				const std::int32_t minX = std::max(triangle.bounds.minX, tileMinX);
+				const std::int32_t minY = std::max(triangle.bounds.minY, tileMinY);
+				const std::int32_t maxX = std::min(triangle.bounds.maxX, tileMaxX);
+				const std::int32_t maxY = std::min(triangle.bounds.maxY, tileMaxY);
+
+				for (std::int32_t py = minY; py < maxY; ++py)
+				{
+					const float sampleY = static_cast<float>(py) + 0.5f;
+					for (std::int32_t px = minX; px < maxX; px += kLanes)
+					{
+						// Four pixels of the row at once; the lane loops have no control flow so they vectorize.
+						std::array<float, kLanes> weights0{};
+						std::array<float, kLanes> weights1{};
+						std::array<float, kLanes> weights2{};
+						std::array<bool, kLanes> covered{};
+						for (std::int32_t lane = 0; lane < kLanes; ++lane)
+						{
+							const float sampleX = static_cast<float>(px + lane) + 0.5f;
+							weights0[lane] = triangle.edgeA[0] * sampleX + triangle.edgeB[0] * sampleY + triangle.edgeC[0];
+							weights1[lane] = triangle.edgeA[1] * sampleX + triangle.edgeB[1] * sampleY + triangle.edgeC[1];
+							weights2[lane] = triangle.edgeA[2] * sampleX + triangle.edgeB[2] * sampleY + triangle.edgeC[2];
+							covered[lane] = (px + lane < maxX)
+								& (weights0[lane] > 0.0f || (weights0[lane] == 0.0f && triangle.inclusive[0]))
+								& (weights1[lane] > 0.0f || (weights1[lane] == 0.0f && triangle.inclusive[1]))
+								& (weights2[lane] > 0.0f || (weights2[lane] == 0.0f && triangle.inclusive[2]));
+						}
+
+						for (std::int32_t lane = 0; lane < kLanes; ++lane)
+						{
+							if (covered[lane])
+							{
+								ShadePixel(triangle, px + lane, py,
+									{ weights0[lane] * triangle.invArea, weights1[lane] * triangle.invArea, weights2[lane] * triangle.invArea },
+									counters);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		void ShadePixel(const BinnedTriangle& triangle, std::int32_t px, std::int32_t py, const std::array<float, 3>& weights, TileCounters& counters) const
+		{
+			const DrawBatch& batch = batches_[triangle.batch];
+			const std::size_t texel = static_cast<std::size_t>(py) * targetExtent_.width + static_cast<std::size_t>(px);
+
+			const float depth = weights[0] * triangle.z[0] + weights[1] * triangle.z[1] + weights[2] * triangle.z[2];
+			if (depth < 0.0f || depth > 1.0f)
+			{
+				return;
+			}
+			const DepthState& depthState = batch.state.depth;
+			if (depthTarget_ && depthState.testEnable && !DepthPasses(depthState.depthCompareOp, depth, depthTarget_[texel]))
+			{
+				++counters.depthRejected;
+				return;
+			}
+
+			SoftwarePixelInput input{};
+			input.x = static_cast<float>(px) + 0.5f;
+			input.y = static_cast<float>(py) + 0.5f;
+			input.depth = depth;
+			input.frontFacing = triangle.frontFacing;
+			const float w = 1.0f / (weights[0] * triangle.invW[0] + weights[1] * triangle.invW[1] + weights[2] * triangle.invW[2]);
+			for (std::size_t c = 0; c < kSoftwareMaxVaryings; ++c)
+			{
+				input.varyings[c] = (weights[0] * triangle.varyingsOverW[0][c] +
+					weights[1] * triangle.varyingsOverW[1][c] +
+					weights[2] * triangle.varyingsOverW[2][c]) * w;
+			}
+
+			const SoftwarePixelOutput output = (*batch.pixel)(input, contexts_[batch.context]);
+			++counters.shaded;
+			if (output.discard)
+			{
+				return;
+			}
+
+			if (depthTarget_ && depthState.testEnable && depthState.writeEnable)
+			{
+				depthTarget_[texel] = depth;
+			}
+			for (std::size_t target = 0; target < colorTargets_.size(); ++target)
+			{
+				SoftwareFloat4& dst = colorTargets_[target].texels[texel];
+				dst = ToTargetFormat(colorTargets_[target].format, Blend(batch.state.blend, output.colors[target], dst));
+			}
+		}
+
+		SoftwareDeviceDesc desc_{};
+
+		HandlePool<TextureTag, detail::SoftwareTexture> textures_{};
+		HandlePool<BufferTag, std::vector<std::byte>> buffers_{};
+		HandlePool<ShaderTag, Shader> shaders_{};
+		HandlePool<PipelineTag, Pipeline> pipelines_{};
+		HandlePool<FrameBufferTag, Framebuffer> framebuffers_{};
+		HandlePool<InputLayoutTag, InputLayoutDesc> layouts_{};
+		HandlePool<FenceTag, bool> fences_{};
+		IndirectDrawValidator indirectValidator_{};
+
+		std::unordered_map<std::string, SoftwareVertexShader> vertexShaderRegistry_{};
+		std::unordered_map<std::string, SoftwarePixelShader> pixelShaderRegistry_{};
+
+		// Descriptor index -> texture (index 0 is the null descriptor).
+		std::vector<TextureHandle> descToTex_{ TextureHandle{} };
+		std::vector<TextureDescIndex> freeDescIndices_{};
+		std::vector<bool> descFreed_{};
+
+		std::uint64_t timeline_{ 0 };
+
+		// Recording state
+		bool inPass_{ false };
+		std::vector<ColorTarget> colorTargets_{};
+		float* depthTarget_{ nullptr };
+		Extent2D targetExtent_{};
+		Rect viewport_{};
+		GraphicsState state_{};
+		PrimitiveTopology topology_{ PrimitiveTopology::TriangleList };
+		const Pipeline* pipeline_{ nullptr };
+		const InputLayoutDesc* layout_{ nullptr };
+		std::array<VertexBinding, kSoftwareMaxVertexBuffers> vertexBuffers_{};
+		IndexBinding indexBuffer_{};
+		SoftwareShaderContext current_{};
+		bool contextDirty_{ true };
+
+		// Per-pass geometry, consumed by the tile workers when the pass ends
+		std::vector<SoftwareShaderContext> contexts_{};
+		std::vector<DrawBatch> batches_{};
+		std::vector<BinnedTriangle> triangles_{};
+		std::vector<std::vector<std::uint32_t>> bins_{};
+		std::vector<std::uint32_t> activeTiles_{};
+		std::uint32_t tileShift_{ 6 };
+		std::uint32_t tilesX_{ 0 };
+		std::uint32_t tilesY_{ 0 };
+
+		// Scratch
+		std::vector<SoftwareVertexOutput> vertexCache_{};
+		std::unordered_map<std::uint32_t, std::uint32_t> vertexCacheSlot_{};
+		std::vector<std::uint32_t> binMinX_{};
+		std::vector<std::uint32_t> binMinY_{};
+		std::vector<std::uint32_t> binMaxX_{};
+		std::vector<std::uint32_t> binMaxY_{};
+
+		SoftwareRasterStats stats_{};
+	};
+
+	// Back buffer (plus a D32 depth buffer) owned by a SoftwareDevice; read it back with
+	// SoftwareDevice::ReadTexture(GetColorTexture()).
+	class SoftwareSwapChain final : public IRHISwapChain
+	{
+	public:
+		SoftwareSwapChain(SoftwareDevice& device, SwapChainDesc desc)
+			: device_(device)
+			, desc_(std::move(desc))
+		{
+			CreateTargets();
+		}
+
+		~SoftwareSwapChain() override
+		{
+			DestroyTargets();
+		}
+
+		SoftwareSwapChain(const SoftwareSwapChain&) = delete;
+		SoftwareSwapChain& operator=(const SoftwareSwapChain&) = delete;
+
+		SwapChainDesc GetDesc() const override
+		{
+			return desc_;
+		}
+		FrameBufferHandle GetCurrentBackBuffer() const override
+		{
+			return framebuffer_;
+		}
+		TextureHandle GetDepthTexture() const override
+		{
+			return depth_;
+		}
+		TextureHandle GetColorTexture() const noexcept
+		{
+			return color_;
+		}
+		void Present() override
+		{
+			++presentCount_;
+		}
+		void Resize(Extent2D newExtent) override
+		{
+			DestroyTargets();
+			desc_.extent = newExtent;
+			CreateTargets();
+		}
+		std::uint64_t GetPresentCount() const noexcept
+		{
+			return presentCount_;
+		}
+
+	private:
+		void CreateTargets()
+		{
+			color_ = device_.CreateTexture2D(desc_.extent, desc_.backbufferFormat);
+			depth_ = device_.CreateTexture2D(desc_.extent, Format::D32_FLOAT);
+			framebuffer_ = device_.CreateFramebuffer(color_, depth_);
+		}
+
+		void DestroyTargets() noexcept
+		{
+			device_.DestroyFramebuffer(framebuffer_);
+			device_.DestroyTexture(depth_);
+			device_.DestroyTexture(color_);
+		}
+
+		SoftwareDevice& device_;
+		SwapChainDesc desc_{};
+		TextureHandle color_{};
+		TextureHandle depth_{};
+		FrameBufferHandle framebuffer_{};
+		std::uint64_t presentCount_{ 0 };
+	};
+
+	std::unique_ptr<SoftwareDevice> CreateSoftwareDevice(SoftwareDeviceDesc desc = {})
+	{
+		return std::make_unique<SoftwareDevice>(desc);
+	}
+
+	std::unique_ptr<SoftwareSwapChain> CreateSoftwareSwapChain(SoftwareDevice& device, SwapChainDesc desc)
+	{
+		return std::make_unique<SoftwareSwapChain>(device, std::move(desc));
+	}
+}
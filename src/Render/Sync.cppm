@@ -1,6 +1,16 @@
 module;
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
 #include <vector>
 
 export module core:sync;
@@ -11,28 +21,50 @@ export namespace rendern
 {
 	struct FrameSyncDesc
 	{
-		int framesInRuntime{ 2 };
+		// 0 = the device's GetFramesInFlight().
+		int framesInRuntime{ 0 };
 	};
 
+	struct FrameSyncStats
+	{
+		std::uint64_t lastSignaledValue{ 0 };
+		std::uint64_t completedValue{ 0 };   // as of the last query
+		std::uint64_t stalls{ 0 };           // WaitForValue() calls that found the GPU behind
+		double stallMs{ 0.0 };               // CPU time spent blocked in those waits
+		std::size_t pendingReleases{ 0 };
+		std::uint64_t retiredReleases{ 0 };
+	};
+
+	// Frame pacing on the device timeline. EndFrame() signals the next timeline value and remembers it for the
+	// frame's slot; BeginFrame() waits for the value of the frame that last used the slot, so at most
+	// GetFrameInRuntime() frames are in flight. Work outside the frame loop (uploads, async copies) can
+	// Signal() its own value and WaitForValue() on it.
+	//
+	// DeferRelease() replaces ad-hoc per-frame garbage lists: a callback deferred during a frame runs once that
+	// frame's value completes; one deferred with an explicit value runs once that value completes. Callbacks
+	// run from BeginFrame() and RetireCompleted() on the calling thread.
 	class FrameSync
 	{
 	public:
 		FrameSync(rhi::IRHIDevice& device, FrameSyncDesc desc = {})
 			: device_(device)
-			, frameInRuntime_(std::max(1, desc.framesInRuntime))
+			, frameInRuntime_(std::max(1, desc.framesInRuntime > 0 ? desc.framesInRuntime : static_cast<int>(device.GetFramesInFlight())))
+			, frameValues_(static_cast<std::size_t>(frameInRuntime_), 0u)
 		{
-			frameFences_.reserve(static_cast<std::size_t>(frameInRuntime_));
-			for (int i = 0; i < frameInRuntime_; ++i)
-			{
-				frameFences_.push_back(device_.CreateFence(true));
-			}
 		}
 
 		~FrameSync()
 		{
-			for (auto& fence : frameFences_)
+			// Owners release GPU objects in these callbacks; let the GPU finish with them first.
+			try
+			{
+				device_.WaitTimelineValue(lastSignaledValue_);
+				releases_.Seal(lastSignaledValue_);
+				releases_.Retire(std::numeric_limits<std::uint64_t>::max(), [](std::function<void()>& release) { release(); });
+			}
+			catch (...)
 			{
-				device_.DestroyFence(fence);
+				// Avoid exceptions from destructors.
 			}
 		}
 
@@ -44,27 +76,299 @@ export namespace rendern
 			return frameInRuntime_;
 		}
 
-		std::uint16_t BeginFrame() const
+		std::uint64_t GetCurrentFrame() const noexcept
+		{
+			return currentFrame_;
+		}
+
+		// Frames [0, GetCompletedFrameCount()) are finished on the GPU.
+		std::uint64_t GetCompletedFrameCount() const
+		{
+			const auto inFlight = static_cast<std::uint64_t>(frameInRuntime_);
+			// Older frames were waited for by BeginFrame() of a later frame.
+			std::uint64_t frame = currentFrame_ > inFlight ? currentFrame_ - inFlight : 0;
+			const std::uint64_t completed = GetCompletedValue();
+			while (frame < currentFrame_ && FrameValue(frame) <= completed)
+			{
+				++frame;
+			}
+			return frame;
+		}
+
+		std::uint64_t Signal()
+		{
+			lastSignaledValue_ = device_.SignalTimeline();
+			return lastSignaledValue_;
+		}
+
+		std::uint64_t GetLastSignaledValue() const noexcept
+		{
+			return lastSignaledValue_;
+		}
+
+		std::uint64_t GetCompletedValue() const
+		{
+			completedValue_ = std::max(completedValue_, device_.GetCompletedTimelineValue());
+			return completedValue_;
+		}
+
+		void WaitForValue(std::uint64_t value)
+		{
+			if (value <= GetCompletedValue())
+			{
+				return;
+			}
+
+			++stats_.stalls;
+			const auto start = std::chrono::steady_clock::now();
+			device_.WaitTimelineValue(value);
+			stats_.stallMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			completedValue_ = std::max(completedValue_, value);
+		}
+
+		// Runs after the GPU finishes the current frame (the value signaled by the next EndFrame()).
+		void DeferRelease(std::function<void()> release)
+		{
+			releases_.Defer(std::move(release));
+		}
+
+		// Runs after `value` completes.
+		void DeferRelease(std::uint64_t value, std::function<void()> release)
+		{
+			releases_.Defer(value, std::move(release));
+		}
+
+		// Runs every deferred release whose value has completed; returns how many ran.
+		std::size_t RetireCompleted()
+		{
+			const std::size_t retired = releases_.Retire(GetCompletedValue(), [](std::function<void()>& release) { release(); });
+			stats_.retiredReleases += retired;
+			return retired;
+		}
+
+		std::uint16_t BeginFrame()
 		{
 			const auto idx = currentFrame_;
-			auto fence = frameFences_[static_cast<std::size_t>(idx % static_cast<std::uint64_t>(frameInRuntime_))];
-			device_.WaitFence(fence);
+			WaitForValue(FrameValue(idx));
+			RetireCompleted();
 			return idx;
 		}
 
 		void EndFrame()
 		{
-			auto fence = frameFences_[static_cast<std::size_t>(currentFrame_ % static_cast<std::uint64_t>(frameInRuntime_))];
-			device_.SignalFence(fence);
+			const std::uint64_t value = Signal();
+			frameValues_[static_cast<std::size_t>(currentFrame_ % static_cast<std::uint64_t>(frameInRuntime_))] = value;
+			releases_.Seal(value);
 			++currentFrame_;
 		}
 
+		// Blocks until everything signaled so far has completed, then runs all deferred releases.
+		void WaitIdle()
+		{
+			releases_.Seal(Signal());
+			WaitForValue(lastSignaledValue_);
+			RetireCompleted();
+		}
+
+		FrameSyncStats GetStats() const noexcept
+		{
+			FrameSyncStats stats = stats_;
+			stats.lastSignaledValue = lastSignaledValue_;
+			stats.completedValue = completedValue_;
+			stats.pendingReleases = releases_.PendingCount();
+			return stats;
+		}
+
 	private:
+		// Value signaled at the end of `frame`, or 0 (always complete) if the slot was not used yet.
+		std::uint64_t FrameValue(std::uint64_t frame) const noexcept
+		{
+			return frameValues_[static_cast<std::size_t>(frame % static_cast<std::uint64_t>(frameInRuntime_))];
+		}
+
 		rhi::IRHIDevice& device_;
 		int frameInRuntime_{ 2 };
-		std::vector<rhi::FenceHandle> frameFences_;
+		std::vector<std::uint64_t> frameValues_;
 		std::uint64_t currentFrame_{ 0 };
+		std::uint64_t lastSignaledValue_{ 0 };
+		mutable std::uint64_t completedValue_{ 0 };
+		rhi::DeferredReleaseQueue<std::function<void()>> releases_;
+		FrameSyncStats stats_{};
+	};
+
+	struct FrameUploadRingDesc
+	{
+		std::size_t initialBytesPerFrame{ 1u << 20 };
+		std::size_t alignmentBytes{ 16 };
 	};
-}
 
+	struct FrameUploadStats
+	{
+		std::uint64_t frame{ 0 };
+		std::size_t usedBytes{ 0 };      // bytes handed out so far this frame (high-water mark of the slot)
+		std::size_t capacityBytes{ 0 };  // backing memory of the current slot
+		std::uint32_t uploadCount{ 0 };  // Upload() calls this frame
+		std::uint32_t growCount{ 0 };    // pages added this frame because the slot ran out
+	};
 
+	// Per-frame linear allocator for CPU -> GPU buffer updates. Callers write into the span returned by
+	// Allocate() and hand it to Upload(), which passes it to IRHIDevice::UpdateBufferInPlace(). Pages are host
+	// memory, not mapped GPU memory: the backend still copies the bytes once into its own upload heap when it
+	// records the update, but skips the staging copy UpdateBuffer() makes to own the data until then.
+	// There is one slot per frame in flight; a slot is rewound only in BeginFrame(), after
+	// FrameSync::BeginFrame() has waited for the fence of the frame that last used it. A slot that runs out
+	// chains another page instead of failing and is re-sized to its high-water mark the next time it is reused.
+	class FrameUploadRing
+	{
+	public:
+		FrameUploadRing(rhi::IRHIDevice& device, const FrameSync& sync, FrameUploadRingDesc desc = {})
+			: device_(device)
+			, sync_(sync)
+			, alignment_(std::bit_ceil(std::max<std::size_t>(1, desc.alignmentBytes)))
+			, slots_(static_cast<std::size_t>(sync.GetFrameInRuntime()))
+		{
+			for (Slot& slot : slots_)
+			{
+				slot.pages.push_back(MakePage(std::max<std::size_t>(alignment_, desc.initialBytesPerFrame)));
+			}
+		}
+
+		FrameUploadRing(const FrameUploadRing&) = delete;
+		FrameUploadRing& operator=(const FrameUploadRing&) = delete;
+
+		// Call after FrameSync::BeginFrame(). Calling it again within the same frame is a no-op.
+		void BeginFrame()
+		{
+			const std::uint64_t frame = sync_.GetCurrentFrame();
+			if (started_ && frame == stats_.frame)
+			{
+				return;
+			}
+
+			started_ = true;
+			if (stats_.usedBytes > peakBytes_)
+			{
+				peakBytes_ = stats_.usedBytes;
+			}
+
+			Slot& slot = slots_[static_cast<std::size_t>(frame % slots_.size())];
+			if (slot.pages.size() > 1)
+			{
+				// Coalesce the chain that overflowed last time into one page that fits the whole frame.
+				const std::size_t highWater = slot.highWaterBytes;
+				slot.pages.clear();
+				slot.pages.push_back(MakePage(std::bit_ceil(highWater)));
+			}
+			slot.pages.front().cursor = 0;
+			slot.highWaterBytes = 0;
+
+			active_ = &slot;
+			stats_ = FrameUploadStats{};
+			stats_.frame = frame;
+			stats_.capacityBytes = slot.pages.front().sizeBytes;
+		}
+
+		std::span<std::byte> AllocateBytes(std::size_t sizeBytes, std::size_t alignment = 0)
+		{
+			if (!active_)
+			{
+				BeginFrame();
+			}
+
+			const std::size_t align = std::max(alignment_, std::bit_ceil(std::max<std::size_t>(1, alignment)));
+			Page* page = &active_->pages.back();
+			std::size_t offset = AlignedOffset(*page, align);
+			if (offset + sizeBytes > page->sizeBytes)
+			{
+				active_->pages.push_back(MakePage(std::max(page->sizeBytes * 2, sizeBytes + align)));
+				page = &active_->pages.back();
+				offset = AlignedOffset(*page, align);
+				stats_.capacityBytes += page->sizeBytes;
+				++stats_.growCount;
+			}
+
+			const std::size_t padding = offset - page->cursor;
+			page->cursor = offset + sizeBytes;
+			active_->highWaterBytes += padding + sizeBytes;
+			stats_.usedBytes = active_->highWaterBytes;
+			return { page->memory.get() + offset, sizeBytes };
+		}
+
+		// Uninitialised storage for `count` objects of T; the caller is expected to overwrite all of it.
+		template <typename T>
+		std::span<T> Allocate(std::size_t count)
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "FrameUploadRing only holds trivially copyable data");
+			const std::span<std::byte> bytes = AllocateBytes(count * sizeof(T), alignof(T));
+			return { std::launder(reinterpret_cast<T*>(bytes.data())), count };
+		}
+
+		// `data` must come from Allocate() in the current frame.
+		template <typename T>
+		void Upload(rhi::BufferHandle buffer, std::span<const T> data, std::size_t dstOffsetBytes = 0)
+		{
+			if (data.empty())
+			{
+				return;
+			}
+			device_.UpdateBufferInPlace(buffer, std::as_bytes(data), dstOffsetBytes);
+			++stats_.uploadCount;
+		}
+
+		template <typename T>
+		void Upload(rhi::BufferHandle buffer, std::span<T> data, std::size_t dstOffsetBytes = 0)
+		{
+			Upload(buffer, std::span<const T>(data), dstOffsetBytes);
+		}
+
+		const FrameUploadStats& GetFrameStats() const noexcept
+		{
+			return stats_;
+		}
+
+		// Largest per-frame high-water mark seen by any completed frame.
+		std::size_t GetPeakBytes() const noexcept
+		{
+			return peakBytes_;
+		}
+
+	private:
+		struct Page
+		{
+			std::unique_ptr<std::byte[]> memory;
+			std::size_t sizeBytes{ 0 };
+			std::size_t cursor{ 0 };
+		};
+
+		struct Slot
+		{
+			std::vector<Page> pages;
+			std::size_t highWaterBytes{ 0 };
+		};
+
+		static Page MakePage(std::size_t sizeBytes)
+		{
+			Page page{};
+			page.memory = std::make_unique_for_overwrite<std::byte[]>(sizeBytes);
+			page.sizeBytes = sizeBytes;
+			return page;
+		}
+
+		static std::size_t AlignedOffset(const Page& page, std::size_t align) noexcept
+		{
+			// Align the address, not the offset: new[] only guarantees the default new alignment.
+			const auto base = reinterpret_cast<std::uintptr_t>(page.memory.get());
+			const std::uintptr_t address = (base + page.cursor + (align - 1)) & ~static_cast<std::uintptr_t>(align - 1);
+			return static_cast<std::size_t>(address - base);
+		}
+
+		rhi::IRHIDevice& device_;
+		const FrameSync& sync_;
+		std::size_t alignment_{ 16 };
+		std::vector<Slot> slots_;
+		Slot* active_{ nullptr };
+		bool started_{ false };
+		FrameUploadStats stats_{};
+		std::size_t peakBytes_{ 0 };
+	};
+}
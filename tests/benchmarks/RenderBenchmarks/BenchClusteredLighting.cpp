@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct BenchLight
+	{
+		mathUtils::Vec3 position{};
+		mathUtils::Vec3 direction{};
+		float range{ 0.0f };
+		float cosOuter{ -1.0f };
+	};
+
+	// Point and spot lights scattered through the first 150 units in front of the camera.
+	std::vector<BenchLight> BuildLights(std::size_t count)
+	{
+		std::mt19937 rng(29u);
+		std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+		std::uniform_real_distribution<float> depth(-150.0f, 0.0f);
+		std::uniform_real_distribution<float> range(2.0f, 15.0f);
+		std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+		std::vector<BenchLight> lights;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			BenchLight light{};
+			light.position = mathUtils::Vec3{ lateral(rng), lateral(rng) * 0.1f, depth(rng) };
+			light.range = range(rng);
+			if (i % 2 == 1)
+			{
+				light.direction = mathUtils::Normalize(mathUtils::Vec3{ unit(rng), -1.0f, unit(rng) });
+				light.cosOuter = std::cos(mathUtils::DegToRad(30.0f));
+			}
+			lights.push_back(light);
+		}
+		return lights;
+	}
+
+	// Arg 0 = lights. Reports the average list length of the clusters that have one.
+	void BM_ClusteredLighting_Build(benchmark::State& state)
+	{
+		const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 300.0f);
+		const mathUtils::Mat4 view = mathUtils::LookAt(mathUtils::Vec3{ 0.0f, 2.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 2.0f, -1.0f }, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f });
+		const std::vector<BenchLight> lights = BuildLights(static_cast<std::size_t>(state.range(0)));
+
+		rendern::ClusteredLightBuilder builder;
+		for (auto _ : state)
+		{
+			builder.BeginFrame(view, proj, 0.1f, 300.0f);
+			for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(lights.size()); ++i)
+			{
+				if (lights[i].cosOuter < 0.0f)
+				{
+					builder.AddPointLight(i, lights[i].position, lights[i].range);
+				}
+				else
+				{
+					builder.AddSpotLight(i, lights[i].position, lights[i].direction, lights[i].range, lights[i].cosOuter);
+				}
+			}
+			builder.Build();
+			benchmark::DoNotOptimize(builder.GetLightIndices().data());
+		}
+
+		const rendern::ClusteredLightingStats& stats = builder.GetStats();
+		state.counters["lightsPerCluster"] = stats.occupiedClusters == 0
+			? 0.0
+			: static_cast<double>(stats.clusterLightIndices) / static_cast<double>(stats.occupiedClusters);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetLabel(std::string(rendern::ClusterAssignSimdPath()));
+	}
+
+	BENCHMARK(BM_ClusteredLighting_Build)->Arg(64)->Arg(256)->Arg(1024)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,242 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr std::int64_t kDrawCount = 100'000;
+
+	struct alignas(16) PerDrawConstants
+	{
+		std::array<float, 16> model{};
+	};
+
+	// Reference copy of the previous `std::vector<std::variant<...>>` command list.
+	// Only the alternatives used by the benchmark are spelled out; the 512-byte constants block
+	// still dominates the element size exactly like it did in rhi::Command.
+	namespace legacy
+	{
+		struct CommandBindVertexBuffer
+		{
+			std::uint32_t slot{ 0 };
+			rhi::BufferHandle buffer{};
+			std::uint32_t strideBytes{ 0 };
+			std::uint32_t offsetBytes{ 0 };
+		};
+		struct CommandSetUniformInt
+		{
+			std::string name{};
+			int value{ 0 };
+		};
+		struct CommandSetConstants
+		{
+			std::uint32_t slot{ 0 };
+			std::uint32_t size{ 0 };
+			std::array<std::byte, 512> data{};
+		};
+		struct CommandDrawIndexed
+		{
+			std::uint32_t indexCount{ 0 };
+			rhi::IndexType indexType{ rhi::IndexType::UINT16 };
+			std::uint32_t firstIndex{ 0 };
+			int baseVertex{ 0 };
+			std::uint32_t instanceCount{ 1 };
+			std::uint32_t firstInstance{ 0 };
+		};
+
+		using Command = std::variant<
+			rhi::CommandBeginPass,
+			rhi::CommandEndPass,
+			CommandBindVertexBuffer,
+			CommandSetUniformInt,
+			CommandSetConstants,
+			CommandDrawIndexed>;
+
+		struct CommandList
+		{
+			std::vector<Command> commands;
+		};
+	}
+
+	struct ReplayCounters
+	{
+		std::uint64_t commands{ 0 };
+		std::uint64_t draws{ 0 };
+		std::uint64_t constantBytes{ 0 };
+	};
+
+	void RecordLegacy(legacy::CommandList& list, const PerDrawConstants& constants)
+	{
+		list.commands.emplace_back(rhi::CommandBeginPass{});
+		for (std::int64_t i = 0; i < kDrawCount; ++i)
+		{
+			const auto bytes = std::as_bytes(std::span{ &constants, 1 });
+
+			list.commands.emplace_back(legacy::CommandBindVertexBuffer{ 1, rhi::BufferHandle{ 7 }, 64, static_cast<std::uint32_t>(i) * 64u });
+
+			legacy::CommandSetConstants cmd{};
+			cmd.slot = 0;
+			cmd.size = static_cast<std::uint32_t>(bytes.size());
+			std::memcpy(cmd.data.data(), bytes.data(), bytes.size());
+			list.commands.emplace_back(std::move(cmd));
+
+			list.commands.emplace_back(legacy::CommandDrawIndexed{ 36, rhi::IndexType::UINT32, 0, 0, 1, 0 });
+		}
+		list.commands.emplace_back(rhi::CommandEndPass{});
+	}
+
+	void RecordArena(rhi::CommandList& list, const PerDrawConstants& constants)
+	{
+		list.BeginPass(rhi::BeginPassDesc{});
+		for (std::int64_t i = 0; i < kDrawCount; ++i)
+		{
+			list.BindVertexBuffer(1, rhi::BufferHandle{ 7 }, 64, static_cast<std::uint32_t>(i) * 64u);
+			list.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+			list.DrawIndexed(36, rhi::IndexType::UINT32, 0, 0, 1, 0);
+		}
+		list.EndPass();
+	}
+
+	// Same counting work for both storage formats, so the record/replay benchmarks only differ in the list.
+	struct CountingVisitor
+	{
+		ReplayCounters& counters;
+
+		template <typename T>
+		void operator()(const T& cmd) const
+		{
+			if constexpr (std::is_same_v<T, legacy::CommandDrawIndexed> || std::is_same_v<T, rhi::CommandDrawIndexed>)
+			{
+				++counters.draws;
+			}
+			else if constexpr (std::is_same_v<T, legacy::CommandSetConstants> || std::is_same_v<T, rhi::CommandSetConstants>)
+			{
+				counters.constantBytes += cmd.size;
+			}
+			++counters.commands;
+		}
+	};
+
+	void ReplayLegacy(const legacy::CommandList& list, ReplayCounters& counters)
+	{
+		for (const auto& command : list.commands)
+		{
+			std::visit(CountingVisitor{ counters }, command);
+		}
+	}
+
+	void ReplayArena(const rhi::CommandList& list, ReplayCounters& counters)
+	{
+		for (const rhi::CommandRecord& record : list)
+		{
+			rhi::VisitCommand(record, CountingVisitor{ counters });
+		}
+	}
+
+	// Records 100k draws into a freshly created variant list every frame (previous behaviour).
+	void BM_CommandList_VariantRecordReplay(benchmark::State& state)
+	{
+		const PerDrawConstants constants{};
+		ReplayCounters counters{};
+		std::size_t bytes = 0;
+
+		for (auto _ : state)
+		{
+			legacy::CommandList list{};
+			RecordLegacy(list, constants);
+			ReplayLegacy(list, counters);
+			bytes = list.commands.capacity() * sizeof(legacy::Command);
+			benchmark::DoNotOptimize(counters);
+		}
+
+		state.SetItemsProcessed(state.iterations() * kDrawCount);
+		state.counters["streamBytes"] = static_cast<double>(bytes);
+	}
+	BENCHMARK(BM_CommandList_VariantRecordReplay)->Unit(benchmark::kMillisecond);
+
+	// Records 100k draws into a reused arena list every frame and replays it through the same visitor.
+	void BM_CommandList_ArenaRecordReplay(benchmark::State& state)
+	{
+		const PerDrawConstants constants{};
+		rhi::CommandList list{};
+		ReplayCounters counters{};
+		std::size_t bytes = 0;
+
+		for (auto _ : state)
+		{
+			list.Reset();
+			RecordArena(list, constants);
+			ReplayArena(list, counters);
+			bytes = list.SizeBytes();
+			benchmark::DoNotOptimize(counters);
+		}
+
+		state.SetItemsProcessed(state.iterations() * kDrawCount);
+		state.counters["streamBytes"] = static_cast<double>(bytes);
+	}
+	BENCHMARK(BM_CommandList_ArenaRecordReplay)->Unit(benchmark::kMillisecond);
+
+	// Arena record plus a NullDevice submit (includes the device's own replay and indirect-draw validation).
+	void BM_CommandList_ArenaRecordSubmitNullDevice(benchmark::State& state)
+	{
+		const PerDrawConstants constants{};
+		std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+		rhi::CommandList list{};
+		std::size_t bytes = 0;
+
+		for (auto _ : state)
+		{
+			list.Reset();
+			RecordArena(list, constants);
+			bytes = list.SizeBytes();
+			device->SubmitCommandList(std::move(list));
+		}
+
+		state.SetItemsProcessed(state.iterations() * kDrawCount);
+		state.counters["streamBytes"] = static_cast<double>(bytes);
+	}
+	BENCHMARK(BM_CommandList_ArenaRecordSubmitNullDevice)->Unit(benchmark::kMillisecond);
+
+	// Name-based uniforms used to heap-allocate a std::string per command.
+	void BM_CommandList_VariantUniformRecord(benchmark::State& state)
+	{
+		for (auto _ : state)
+		{
+			legacy::CommandList list{};
+			for (std::int64_t i = 0; i < kDrawCount; ++i)
+			{
+				list.commands.emplace_back(legacy::CommandSetUniformInt{ std::string("uUseTextureAndShadowFlags"), static_cast<int>(i) });
+			}
+			benchmark::DoNotOptimize(list.commands.data());
+		}
+		state.SetItemsProcessed(state.iterations() * kDrawCount);
+	}
+	BENCHMARK(BM_CommandList_VariantUniformRecord)->Unit(benchmark::kMillisecond);
+
+	void BM_CommandList_ArenaUniformRecord(benchmark::State& state)
+	{
+		rhi::CommandList list{};
+		for (auto _ : state)
+		{
+			list.Reset();
+			for (std::int64_t i = 0; i < kDrawCount; ++i)
+			{
+				list.SetUniformInt("uUseTextureAndShadowFlags", static_cast<int>(i));
+			}
+			benchmark::DoNotOptimize(list);
+		}
+		state.SetItemsProcessed(state.iterations() * kDrawCount);
+	}
+	BENCHMARK(BM_CommandList_ArenaUniformRecord)->Unit(benchmark::kMillisecond);
+}
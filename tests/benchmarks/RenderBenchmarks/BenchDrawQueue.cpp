@@ -0,0 +1,157 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// Stand-in for the DX12 batch key: mesh pointer, permutation/probe bits and ~20 material fields.
+	struct FakeBatchKey
+	{
+		std::uintptr_t mesh{ 0 };
+		std::uint32_t permBits{ 0 };
+		int reflectionProbeIndex{ -1 };
+		std::array<std::uint32_t, 9> descIndices{};
+		std::array<float, 12> scalars{};
+
+		bool operator==(const FakeBatchKey&) const = default;
+	};
+
+	struct FakeBatchKeyHash
+	{
+		std::size_t operator()(const FakeBatchKey& key) const noexcept
+		{
+			std::size_t seed = std::hash<std::uintptr_t>{}(key.mesh);
+			hashUtils::HashCombine(seed, key.permBits);
+			hashUtils::HashCombine(seed, static_cast<std::uint32_t>(key.reflectionProbeIndex));
+			for (const std::uint32_t index : key.descIndices)
+			{
+				hashUtils::HashCombine(seed, index);
+			}
+			for (const float value : key.scalars)
+			{
+				hashUtils::HashCombine(seed, std::bit_cast<std::uint32_t>(value));
+			}
+			return seed;
+		}
+	};
+
+	struct FakeInstance
+	{
+		std::array<float, 16> model{};
+	};
+
+	struct FakeDraw
+	{
+		FakeBatchKey key;
+		std::uint32_t materialId{ 0 };
+		std::uint32_t meshId{ 0 };
+		float dist2{ 0.0f };
+		FakeInstance inst;
+	};
+
+	struct FakeBatch
+	{
+		std::uint32_t instanceOffset{ 0 };
+		std::uint32_t instanceCount{ 0 };
+	};
+
+	// A scene with 64 meshes x 32 materials in random order, like a level with heavy instancing.
+	std::vector<FakeDraw> MakeDraws(std::size_t count)
+	{
+		std::mt19937 rng{ 99u };
+		std::uniform_int_distribution<std::uint32_t> mesh(0, 63);
+		std::uniform_int_distribution<std::uint32_t> material(0, 31);
+		std::uniform_real_distribution<float> dist(1.0f, 10000.0f);
+		std::vector<FakeDraw> draws(count);
+		for (FakeDraw& draw : draws)
+		{
+			draw.meshId = mesh(rng);
+			draw.materialId = material(rng);
+			draw.dist2 = dist(rng);
+			draw.key.mesh = 0x10000u + draw.meshId * 256u;
+			draw.key.permBits = draw.materialId & 3u;
+			draw.key.descIndices.fill(draw.materialId);
+			draw.key.scalars.fill(static_cast<float>(draw.materialId));
+		}
+		return draws;
+	}
+
+	// Previous DX12 main-pass batching: hash map of per-key instance vectors, then a flatten pass.
+	void BM_Batching_HashMap(benchmark::State& state)
+	{
+		const std::vector<FakeDraw> draws = MakeDraws(static_cast<std::size_t>(state.range(0)));
+		std::vector<FakeInstance> instances;
+		std::vector<FakeBatch> batches;
+		for (auto _ : state)
+		{
+			std::unordered_map<FakeBatchKey, std::vector<FakeInstance>, FakeBatchKeyHash> buckets;
+			buckets.reserve(draws.size());
+			for (const FakeDraw& draw : draws)
+			{
+				buckets[draw.key].push_back(draw.inst);
+			}
+
+			instances.clear();
+			batches.clear();
+			for (const auto& [key, bucket] : buckets)
+			{
+				batches.push_back({ static_cast<std::uint32_t>(instances.size()), static_cast<std::uint32_t>(bucket.size()) });
+				instances.insert(instances.end(), bucket.begin(), bucket.end());
+			}
+			benchmark::DoNotOptimize(batches.data());
+			benchmark::DoNotOptimize(instances.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Batching_HashMap)->Arg(10'000)->Arg(100'000);
+
+	// Draw queue: packed 64-bit keys, radix sort, one linear walk comparing neighbours.
+	void BM_Batching_RadixDrawQueue(benchmark::State& state)
+	{
+		const std::vector<FakeDraw> draws = MakeDraws(static_cast<std::size_t>(state.range(0)));
+		rendern::DrawQueue queue;
+		std::vector<FakeInstance> instances;
+		std::vector<FakeBatch> batches;
+		for (auto _ : state)
+		{
+			queue.Clear();
+			queue.Reserve(draws.size());
+			for (std::uint32_t i = 0; i < draws.size(); ++i)
+			{
+				rendern::DrawKeyFields fields{};
+				fields.pipeline = draws[i].key.permBits;
+				fields.material = draws[i].materialId;
+				fields.mesh = draws[i].meshId;
+				fields.depth = draws[i].dist2;
+				queue.Push(rendern::drawKey::Opaque(fields), i);
+			}
+			queue.Sort();
+
+			instances.clear();
+			batches.clear();
+			const FakeBatchKey* batchKey = nullptr;
+			for (const rendern::DrawQueue::Item& item : queue.Items())
+			{
+				const FakeDraw& draw = draws[item.index];
+				if (!batchKey || !(*batchKey == draw.key))
+				{
+					batches.push_back({ static_cast<std::uint32_t>(instances.size()), 0u });
+					batchKey = &draw.key;
+				}
+				instances.push_back(draw.inst);
+				++batches.back().instanceCount;
+			}
+			benchmark::DoNotOptimize(batches.data());
+			benchmark::DoNotOptimize(instances.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+	BENCHMARK(BM_Batching_RadixDrawQueue)->Arg(10'000)->Arg(100'000);
+}
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct CullScene
+	{
+		std::vector<mathUtils::Mat4> models;
+		std::vector<float> radii;
+		std::vector<mathUtils::Frustum> frustums;
+	};
+
+	// Objects scattered around the camera; view 0 is the camera, the rest look along other axes
+	// (as cascades / cube faces would), so roughly a quarter of the objects survive each view.
+	CullScene BuildScene(std::size_t objectCount, std::size_t viewCount)
+	{
+		CullScene scene;
+		std::mt19937 rng(7u);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+		std::uniform_real_distribution<float> radius(0.5f, 3.0f);
+		scene.models.reserve(objectCount);
+		scene.radii.reserve(objectCount);
+		for (std::size_t i = 0; i < objectCount; ++i)
+		{
+			const mathUtils::Mat4 translate = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3{ position(rng), position(rng) * 0.1f, position(rng) });
+			scene.models.push_back(mathUtils::Scale(translate, mathUtils::Vec3{ scale(rng), scale(rng), scale(rng) }));
+			scene.radii.push_back(radius(rng));
+		}
+
+		const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, 0.1f, 400.0f);
+		const mathUtils::Vec3 eye{ 0.0f, 2.0f, 0.0f };
+		for (std::size_t view = 0; view < viewCount; ++view)
+		{
+			const float angle = mathUtils::TwoPi * static_cast<float>(view) / static_cast<float>(viewCount);
+			const mathUtils::Vec3 target{ eye.x + std::sin(angle), eye.y, eye.z - std::cos(angle) };
+			scene.frustums.push_back(mathUtils::ExtractFrustumRH_ZO(proj * mathUtils::LookAt(eye, target, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f })));
+		}
+		return scene;
+	}
+
+	const mathUtils::Vec3 kLocalCenter{ 0.0f, 0.5f, 0.0f };
+
+	// Arg 0 = objects, arg 1 = frustums. The per-item path is what the renderer did for every draw item.
+	void BM_FrustumCull_PerItem(benchmark::State& state)
+	{
+		const CullScene scene = BuildScene(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+		std::vector<std::uint32_t> masks(scene.models.size());
+		for (auto _ : state)
+		{
+			for (std::size_t i = 0; i < scene.models.size(); ++i)
+			{
+				std::uint32_t mask = 0;
+				for (std::size_t view = 0; view < scene.frustums.size(); ++view)
+				{
+					mask |= rendern::IsVisibleSphere(kLocalCenter, scene.radii[i], scene.models[i], scene.frustums[view], true) ? (1u << view) : 0u;
+				}
+				masks[i] = mask;
+			}
+			benchmark::DoNotOptimize(masks.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	// Per-frame cost for dynamic objects: gather world spheres into SoA, then cull all views at once.
+	void BM_FrustumCull_BatchWithGather(benchmark::State& state)
+	{
+		const CullScene scene = BuildScene(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+		rendern::CullSpheresSoA spheres;
+		std::vector<std::uint32_t> masks(scene.models.size());
+		for (auto _ : state)
+		{
+			spheres.Clear();
+			spheres.Reserve(scene.models.size());
+			for (std::size_t i = 0; i < scene.models.size(); ++i)
+			{
+				spheres.PushLocal(kLocalCenter, scene.radii[i], scene.models[i]);
+			}
+			rendern::CullSpheres(spheres, scene.frustums, masks);
+			benchmark::DoNotOptimize(masks.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetLabel(std::string(rendern::CullSpheresSimdPath()));
+	}
+
+	// Static objects: world spheres built once, only the frustum tests run per frame.
+	void BM_FrustumCull_BatchPrebuilt(benchmark::State& state)
+	{
+		const CullScene scene = BuildScene(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1)));
+		rendern::CullSpheresSoA spheres;
+		for (std::size_t i = 0; i < scene.models.size(); ++i)
+		{
+			spheres.PushLocal(kLocalCenter, scene.radii[i], scene.models[i]);
+		}
+		std::vector<std::uint32_t> masks(scene.models.size());
+		for (auto _ : state)
+		{
+			rendern::CullSpheres(spheres, scene.frustums, masks);
+			benchmark::DoNotOptimize(masks.data());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+		state.SetLabel(std::string(rendern::CullSpheresSimdPath()));
+	}
+
+	void CullArgs(benchmark::internal::Benchmark* bench)
+	{
+		for (const std::int64_t objects : { 10'000, 100'000, 1'000'000 })
+		{
+			for (const std::int64_t views : { 1, 6 })
+			{
+				bench->Args({ objects, views });
+			}
+		}
+	}
+
+	BENCHMARK(BM_FrustumCull_PerItem)->Apply(CullArgs)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_FrustumCull_BatchWithGather)->Apply(CullArgs)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_FrustumCull_BatchPrebuilt)->Apply(CullArgs)->Unit(benchmark::kMicrosecond);
+}
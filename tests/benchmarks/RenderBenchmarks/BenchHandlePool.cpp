@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr std::size_t kLookups = 100'000;
+
+	// Roughly the size of a backend texture entry (resource pointer, views, state, extent).
+	struct FakeTextureEntry
+	{
+		std::array<std::uint64_t, 10> payload{};
+		std::uint32_t state{ 0 };
+	};
+
+	// Bind-path access pattern: random handles out of the live set.
+	template <typename HandleT>
+	std::vector<HandleT> ShuffledLookups(const std::vector<HandleT>& live)
+	{
+		std::mt19937 rng{ 1234u };
+		std::uniform_int_distribution<std::size_t> pick(0, live.size() - 1u);
+		std::vector<HandleT> lookups(kLookups);
+		for (HandleT& handle : lookups)
+		{
+			handle = live[pick(rng)];
+		}
+		return lookups;
+	}
+
+	// Previous backend tables: `std::unordered_map<std::uint32_t, Entry>` keyed by a counter id.
+	void BM_HandleLookup_UnorderedMap(benchmark::State& state)
+	{
+		const auto objectCount = static_cast<std::uint32_t>(state.range(0));
+		std::unordered_map<std::uint32_t, FakeTextureEntry> table;
+		std::vector<rhi::TextureHandle> live;
+		for (std::uint32_t i = 0; i < objectCount; ++i)
+		{
+			const rhi::TextureHandle handle{ i + 1u };
+			table[handle.id] = FakeTextureEntry{};
+			live.push_back(handle);
+		}
+		const std::vector<rhi::TextureHandle> lookups = ShuffledLookups(live);
+
+		for (auto _ : state)
+		{
+			std::uint64_t sum = 0;
+			for (const rhi::TextureHandle handle : lookups)
+			{
+				auto it = table.find(handle.id);
+				if (it != table.end())
+				{
+					sum += it->second.state;
+				}
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * kLookups);
+	}
+	BENCHMARK(BM_HandleLookup_UnorderedMap)->Arg(1024)->Arg(65536);
+
+	void BM_HandleLookup_HandlePool(benchmark::State& state)
+	{
+		const auto objectCount = static_cast<std::uint32_t>(state.range(0));
+		rhi::HandlePool<rhi::TextureTag, FakeTextureEntry> pool;
+		std::vector<rhi::TextureHandle> live;
+		for (std::uint32_t i = 0; i < objectCount; ++i)
+		{
+			live.push_back(pool.Emplace());
+		}
+		const std::vector<rhi::TextureHandle> lookups = ShuffledLookups(live);
+
+		for (auto _ : state)
+		{
+			std::uint64_t sum = 0;
+			for (const rhi::TextureHandle handle : lookups)
+			{
+				if (const FakeTextureEntry* entry = pool.Find(handle))
+				{
+					sum += entry->state;
+				}
+			}
+			benchmark::DoNotOptimize(sum);
+		}
+		state.SetItemsProcessed(state.iterations() * kLookups);
+	}
+	BENCHMARK(BM_HandleLookup_HandlePool)->Arg(1024)->Arg(65536);
+}
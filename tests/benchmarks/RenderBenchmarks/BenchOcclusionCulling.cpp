@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// A corridor of walls seen from the origin, facing the camera, and boxes scattered behind them.
+	const std::array<mathUtils::Vec3, 4> kQuad{
+		mathUtils::Vec3{ -0.5f, -0.5f, 0.0f },
+		mathUtils::Vec3{ 0.5f, -0.5f, 0.0f },
+		mathUtils::Vec3{ 0.5f, 0.5f, 0.0f },
+		mathUtils::Vec3{ -0.5f, 0.5f, 0.0f } };
+	const std::array<std::uint32_t, 6> kQuadIndices{ 0, 1, 2, 0, 2, 3 };
+
+	const mathUtils::Mat4& CameraViewProj()
+	{
+		static const mathUtils::Mat4 viewProj =
+			mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+			* mathUtils::LookAt(mathUtils::Vec3{ 0.0f, 2.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 2.0f, -1.0f }, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f });
+		return viewProj;
+	}
+
+	std::vector<mathUtils::Mat4> BuildWalls(std::size_t count)
+	{
+		std::mt19937 rng(17u);
+		std::uniform_real_distribution<float> lateral(-40.0f, 40.0f);
+		std::uniform_real_distribution<float> depth(-60.0f, -8.0f);
+		std::vector<mathUtils::Mat4> walls;
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			mathUtils::Mat4 model{ 1.0f };
+			model[0].x = 12.0f;
+			model[1].y = 8.0f;
+			model[3] = mathUtils::Vec4(lateral(rng), 2.0f, depth(rng), 1.0f);
+			walls.push_back(model);
+		}
+		return walls;
+	}
+
+	std::vector<rendern::Aabb> BuildBoxes(std::size_t count)
+	{
+		std::mt19937 rng(23u);
+		std::uniform_real_distribution<float> lateral(-80.0f, 80.0f);
+		std::uniform_real_distribution<float> depth(-250.0f, -5.0f);
+		std::vector<rendern::Aabb> boxes;
+		boxes.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const mathUtils::Vec3 center{ lateral(rng), 1.0f + lateral(rng) * 0.02f, depth(rng) };
+			const mathUtils::Vec3 half{ 0.5f, 0.5f, 0.5f };
+			boxes.push_back(rendern::Aabb{ center - half, center + half });
+		}
+		return boxes;
+	}
+
+	void Rasterize(rendern::SoftwareOcclusionCuller& culler, const std::vector<mathUtils::Mat4>& walls)
+	{
+		culler.BeginFrame(CameraViewProj());
+		for (const mathUtils::Mat4& wall : walls)
+		{
+			const mathUtils::Vec3 center{ wall[3].x, wall[3].y, wall[3].z };
+			culler.AddOccluder(kQuad, kQuadIndices, wall, center, 7.5f);
+		}
+		culler.RasterizeOccluders(static_cast<std::uint32_t>(walls.size()));
+	}
+
+	// Arg 0 = occluders, arg 1 = jobs (0 rasterizes on the calling thread).
+	void BM_Occlusion_RasterizeOccluders(benchmark::State& state)
+	{
+		const auto workers = static_cast<std::uint32_t>(state.range(1));
+		rendern::JobSystemThreadPool jobs(workers == 0 ? 1u : workers);
+		rendern::SoftwareOcclusionCuller culler;
+		culler.SetJobSystem(workers == 0 ? nullptr : &jobs, workers);
+		const std::vector<mathUtils::Mat4> walls = BuildWalls(static_cast<std::size_t>(state.range(0)));
+		for (auto _ : state)
+		{
+			Rasterize(culler, walls);
+			benchmark::DoNotOptimize(culler.GetDepth().data());
+		}
+		state.SetLabel(std::string(rendern::OcclusionRasterSimdPath()));
+	}
+
+	// Arg 0 = boxes, arg 1 = jobs. Reports how many of them the 32 walls hide.
+	void BM_Occlusion_TestBoxes(benchmark::State& state)
+	{
+		const auto workers = static_cast<std::uint32_t>(state.range(1));
+		rendern::JobSystemThreadPool jobs(workers == 0 ? 1u : workers);
+		rendern::SoftwareOcclusionCuller culler;
+		culler.SetJobSystem(workers == 0 ? nullptr : &jobs, workers);
+		Rasterize(culler, BuildWalls(32));
+
+		const std::vector<rendern::Aabb> boxes = BuildBoxes(static_cast<std::size_t>(state.range(0)));
+		std::vector<std::uint8_t> visible(boxes.size());
+		std::uint32_t culled = 0;
+		for (auto _ : state)
+		{
+			const std::uint32_t before = culler.GetStats().objectsCulled;
+			culler.TestVisibility(boxes, visible);
+			culled = culler.GetStats().objectsCulled - before;
+			benchmark::DoNotOptimize(visible.data());
+		}
+		state.counters["culled"] = static_cast<double>(culled);
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	BENCHMARK(BM_Occlusion_RasterizeOccluders)->Args({ 32, 0 })->Args({ 32, 4 })->Args({ 128, 0 })->Args({ 128, 4 })->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_Occlusion_TestBoxes)->Args({ 10'000, 0 })->Args({ 10'000, 4 })->Args({ 100'000, 0 })->Args({ 100'000, 4 })->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+import core;
+
+namespace
+{
+	constexpr std::uint32_t kPassCount = 64;
+	constexpr std::uint32_t kDrawsPerPass = 2'000;
+
+	struct alignas(16) PerDrawConstants
+	{
+		std::array<float, 16> model{};
+	};
+
+	// 64 shadow-like passes, each writing its own depth target and recording 2000 draws.
+	void BuildLargeScene(renderGraph::RenderGraph& graph)
+	{
+		graph.Reset();
+		for (std::uint32_t pass = 0; pass < kPassCount; ++pass)
+		{
+			const auto depth = graph.CreateTexture(renderGraph::RGTextureDesc{
+				.extent = { 256, 256 },
+				.format = rhi::Format::D32_FLOAT,
+				.usage = renderGraph::ResourceUsage::DepthStencil,
+				.debugName = "BenchDepth"
+				});
+
+			renderGraph::PassAttachments att{};
+			att.depth = depth;
+			att.clearDesc.clearDepth = true;
+			att.hasSideEffects = true;
+			att.recordInParallel = true;
+
+			graph.AddPass("BenchPass" + std::to_string(pass), std::move(att), [pass](renderGraph::PassContext& ctx)
+				{
+					PerDrawConstants constants{};
+					constants.model[0] = static_cast<float>(pass);
+					for (std::uint32_t draw = 0; draw < kDrawsPerPass; ++draw)
+					{
+						constants.model[15] = static_cast<float>(draw);
+						ctx.commandList.BindVertexBuffer(0, rhi::BufferHandle{ 7 }, 64, draw * 64u);
+						ctx.commandList.SetConstants(0, std::as_bytes(std::span{ &constants, 1 }));
+						ctx.commandList.DrawIndexed(36, rhi::IndexType::UINT32);
+					}
+				});
+		}
+	}
+
+	// Arg = recording jobs (0 records serially on the calling thread).
+	void BM_RenderGraph_RecordLargeScene(benchmark::State& state)
+	{
+		const auto workers = static_cast<std::uint32_t>(state.range(0));
+		std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+		std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{});
+		rendern::JobSystemThreadPool jobs(workers == 0 ? 1u : workers);
+
+		renderGraph::RenderGraph graph;
+		graph.SetJobSystem(workers == 0 ? nullptr : &jobs, workers);
+
+		for (auto _ : state)
+		{
+			BuildLargeScene(graph);
+			graph.Execute(*device, *swapChain);
+		}
+
+		graph.ReleaseTransientResources(*device);
+		state.SetItemsProcessed(state.iterations() * kPassCount * kDrawsPerPass);
+	}
+	BENCHMARK(BM_RenderGraph_RecordLargeScene)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
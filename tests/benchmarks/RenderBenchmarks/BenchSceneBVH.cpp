@@ -0,0 +1,117 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::vector<rendern::Aabb> BuildBoxes(std::size_t count)
+	{
+		std::mt19937 rng(11u);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> extent(0.5f, 3.0f);
+		std::vector<rendern::Aabb> boxes;
+		boxes.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			const mathUtils::Vec3 center{ position(rng), position(rng) * 0.1f, position(rng) };
+			const mathUtils::Vec3 half{ extent(rng), extent(rng), extent(rng) };
+			boxes.push_back(rendern::Aabb{ center - half, center + half });
+		}
+		return boxes;
+	}
+
+	rendern::DynamicAabbTree BuildTree(const std::vector<rendern::Aabb>& boxes)
+	{
+		rendern::DynamicAabbTree tree;
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+		{
+			tree.CreateProxy(boxes[i], i);
+		}
+		return tree;
+	}
+
+	const mathUtils::Frustum& CameraFrustum()
+	{
+		static const mathUtils::Frustum frustum = mathUtils::ExtractFrustumRH_ZO(
+			mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(60.0f), 16.0f / 9.0f, 0.1f, 300.0f)
+			* mathUtils::LookAt(mathUtils::Vec3{ 0.0f, 2.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 2.0f, -1.0f }, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f }));
+		return frustum;
+	}
+
+	// Arg 0 = objects. Linear reference: one AABB/frustum test per object.
+	void BM_SceneBVH_FrustumLinear(benchmark::State& state)
+	{
+		const std::vector<rendern::Aabb> boxes = BuildBoxes(static_cast<std::size_t>(state.range(0)));
+		std::size_t visible = 0;
+		for (auto _ : state)
+		{
+			visible = 0;
+			for (const rendern::Aabb& box : boxes)
+			{
+				visible += rendern::ClassifyAabb(CameraFrustum(), box) != rendern::FrustumOverlap::Outside ? 1u : 0u;
+			}
+			benchmark::DoNotOptimize(visible);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_SceneBVH_FrustumQuery(benchmark::State& state)
+	{
+		const rendern::DynamicAabbTree tree = BuildTree(BuildBoxes(static_cast<std::size_t>(state.range(0))));
+		std::size_t visible = 0;
+		for (auto _ : state)
+		{
+			visible = 0;
+			tree.QueryFrustum(CameraFrustum(), [&visible](int) { ++visible; });
+			benchmark::DoNotOptimize(visible);
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0));
+	}
+
+	void BM_SceneBVH_RayCastClosest(benchmark::State& state)
+	{
+		const rendern::DynamicAabbTree tree = BuildTree(BuildBoxes(static_cast<std::size_t>(state.range(0))));
+		const geometry::Ray ray{ mathUtils::Vec3{ -400.0f, 0.0f, -3.0f }, mathUtils::Normalize(mathUtils::Vec3{ 1.0f, 0.0f, 0.01f }) };
+		for (auto _ : state)
+		{
+			float bestT = 2000.0f;
+			tree.RayCast(ray, bestT, [&bestT](int, float t) { bestT = t < bestT ? t : bestT; return bestT; });
+			benchmark::DoNotOptimize(bestT);
+		}
+	}
+
+	// Per-frame cost when 10% of the objects move a little (inside or just past the fat margin).
+	void BM_SceneBVH_MoveTenPercent(benchmark::State& state)
+	{
+		std::vector<rendern::Aabb> boxes = BuildBoxes(static_cast<std::size_t>(state.range(0)));
+		rendern::DynamicAabbTree tree;
+		std::vector<int> proxies;
+		proxies.reserve(boxes.size());
+		for (std::size_t i = 0; i < boxes.size(); ++i)
+		{
+			proxies.push_back(tree.CreateProxy(boxes[i], i));
+		}
+		float offset = 0.0f;
+		for (auto _ : state)
+		{
+			offset = offset > 1.0f ? 0.0f : offset + 0.05f;
+			for (std::size_t i = 0; i < boxes.size(); i += 10)
+			{
+				const mathUtils::Vec3 delta{ offset, 0.0f, 0.0f };
+				tree.MoveProxy(proxies[i], rendern::Aabb{ boxes[i].min + delta, boxes[i].max + delta });
+			}
+			benchmark::DoNotOptimize(tree.GetHeight());
+		}
+		state.SetItemsProcessed(state.iterations() * state.range(0) / 10);
+	}
+
+	BENCHMARK(BM_SceneBVH_FrustumLinear)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_SceneBVH_FrustumQuery)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_SceneBVH_RayCastClosest)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+	BENCHMARK(BM_SceneBVH_MoveTenPercent)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr rhi::Extent2D kExtent{ 1280, 720 };
+	constexpr std::uint32_t kFanTriangles = 12;
+
+	struct BenchVertex
+	{
+		std::array<float, 3> position{};
+		std::array<float, 4> color{};
+	};
+
+	// Per-draw placement, fed through SetConstants like the DX12 per-draw constant buffer.
+	struct DrawConstants
+	{
+		std::array<float, 4> offsetScaleDepth{};
+	};
+
+	std::vector<BenchVertex> BuildFan()
+	{
+		std::vector<BenchVertex> vertices;
+		for (std::uint32_t i = 0; i < kFanTriangles; ++i)
+		{
+			const float a0 = 6.2831853f * static_cast<float>(i) / kFanTriangles;
+			const float a1 = 6.2831853f * static_cast<float>(i + 1) / kFanTriangles;
+			const std::array<float, 4> color{ static_cast<float>(i) / kFanTriangles, 0.5f, 1.0f, 1.0f };
+			vertices.push_back(BenchVertex{ { 0.0f, 0.0f, 0.0f }, color });
+			vertices.push_back(BenchVertex{ { std::cos(a0), std::sin(a0), 0.0f }, color });
+			vertices.push_back(BenchVertex{ { std::cos(a1), std::sin(a1), 0.0f }, color });
+		}
+		return vertices;
+	}
+
+	// Arg 0 = draws per frame, arg 1 = raster jobs (0 rasterizes on the calling thread).
+	// Counters split each frame into submission (decode + vertex work + binning) and tile rasterization.
+	void BM_SoftwareRHI_RenderFrame(benchmark::State& state)
+	{
+		const auto drawCount = static_cast<std::uint32_t>(state.range(0));
+		const auto workers = static_cast<std::uint32_t>(state.range(1));
+		rendern::JobSystemThreadPool jobs(workers == 0 ? 1u : workers);
+		rhi::SoftwareDevice device(rhi::SoftwareDeviceDesc{ .jobs = workers == 0 ? nullptr : &jobs, .maxJobs = workers });
+
+		device.RegisterVertexShader("VS_Bench", [](const rhi::SoftwareVertexInput& input, const rhi::SoftwareShaderContext& context)
+			{
+				const DrawConstants constants = context.ConstantsAs<DrawConstants>(0);
+				const rhi::SoftwareFloat4 position = input.Attribute(rhi::VertexSemantic::Position);
+				const rhi::SoftwareFloat4 color = input.Attribute(rhi::VertexSemantic::Color);
+				rhi::SoftwareVertexOutput out{};
+				out.position = {
+					constants.offsetScaleDepth[0] + position[0] * constants.offsetScaleDepth[2],
+					constants.offsetScaleDepth[1] + position[1] * constants.offsetScaleDepth[2],
+					constants.offsetScaleDepth[3],
+					1.0f };
+				std::copy(color.begin(), color.end(), out.varyings.begin());
+				return out;
+			});
+
+		const rhi::TextureHandle color = device.CreateTexture2D(kExtent, rhi::Format::RGBA8_UNORM);
+		const rhi::TextureHandle depth = device.CreateTexture2D(kExtent, rhi::Format::D32_FLOAT);
+		const rhi::FrameBufferHandle framebuffer = device.CreateFramebuffer(color, depth);
+
+		rhi::InputLayoutDesc layoutDesc{};
+		layoutDesc.attributes = {
+			rhi::VertexAttributeDesc{ .semantic = rhi::VertexSemantic::Position, .format = rhi::VertexFormat::R32G32B32_FLOAT, .offsetBytes = 0 },
+			rhi::VertexAttributeDesc{ .semantic = rhi::VertexSemantic::Color, .format = rhi::VertexFormat::R32G32B32A32_FLOAT, .offsetBytes = 12 } };
+		layoutDesc.strideBytes = sizeof(BenchVertex);
+		const rhi::InputLayoutHandle layout = device.CreateInputLayout(layoutDesc);
+		const rhi::PipelineHandle pipeline = device.CreatePipeline("Bench",
+			device.CreateShader(rhi::ShaderStage::Vertex, "VS_Bench", ""),
+			device.CreateShader(rhi::ShaderStage::Pixel, "PS", ""));
+
+		const std::vector<BenchVertex> fan = BuildFan();
+		const rhi::BufferHandle vb = device.CreateBuffer(rhi::BufferDesc{ .sizeInBytes = fan.size() * sizeof(BenchVertex) });
+		device.UpdateBuffer(vb, std::as_bytes(std::span{ fan }));
+
+		std::vector<DrawConstants> draws(drawCount);
+		for (std::uint32_t i = 0; i < drawCount; ++i)
+		{
+			const float t = static_cast<float>(i) * 0.618034f;
+			draws[i].offsetScaleDepth = { std::fmod(t, 2.0f) - 1.0f, std::fmod(t * 1.7f, 2.0f) - 1.0f, 0.05f, static_cast<float>(i % 97) / 97.0f };
+		}
+
+		rhi::GraphicsState state3d{};
+		state3d.rasterizer.cullMode = rhi::CullMode::None;
+		device.ResetRasterStats();
+		for (auto _ : state)
+		{
+			rhi::CommandList list{};
+			rhi::BeginPassDesc pass{};
+			pass.frameBuffer = framebuffer;
+			pass.extent = kExtent;
+			pass.clearDesc.clearDepth = true;
+			list.BeginPass(pass);
+			list.SetState(state3d);
+			list.BindPipeline(pipeline);
+			list.BindInputLayout(layout);
+			list.BindVertexBuffer(0, vb, sizeof(BenchVertex), 0);
+			for (const DrawConstants& draw : draws)
+			{
+				list.SetConstants(0, std::as_bytes(std::span{ &draw, 1 }));
+				list.Draw(kFanTriangles * 3);
+			}
+			list.EndPass();
+			device.SubmitCommandList(std::move(list));
+		}
+
+		const rhi::SoftwareRasterStats& stats = device.GetRasterStats();
+		const double frames = static_cast<double>(state.iterations());
+		state.counters["submitMs"] = stats.submitMs / frames;
+		state.counters["rasterMs"] = stats.rasterMs / frames;
+		state.counters["pixels"] = static_cast<double>(stats.pixelsShaded) / frames;
+		state.SetItemsProcessed(state.iterations() * drawCount);
+	}
+	BENCHMARK(BM_SoftwareRHI_RenderFrame)
+		->Args({ 500, 0 })->Args({ 500, 4 })
+		->Args({ 5'000, 0 })->Args({ 5'000, 4 })
+		->UseRealTime()->Unit(benchmark::kMillisecond);
+}
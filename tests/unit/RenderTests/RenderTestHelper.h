@@ -0,0 +1,14 @@
+#pragma once
+
+import core;
+
+namespace RenderTestHelper
+{
+	// World-space frustum of a perspective camera looking from eye at target (y up, near plane 0.1).
+	inline mathUtils::Frustum CameraFrustum(const mathUtils::Vec3& eye, const mathUtils::Vec3& target, float fovYDeg, float farZ, float aspect = 16.0f / 9.0f)
+	{
+		const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(fovYDeg), aspect, 0.1f, farZ);
+		const mathUtils::Mat4 view = mathUtils::LookAt(eye, target, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f });
+		return mathUtils::ExtractFrustumRH_ZO(proj * view);
+	}
+}
@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+import core;
+
+TEST(Bindless, FreedSlotsWaitForTheirFrameThenGetReused)
+{
+	rendern::DescriptorIndexAllocator allocator(8);
+	const std::optional<std::uint32_t> a = allocator.Allocate();
+	const std::optional<std::uint32_t> b = allocator.Allocate();
+	ASSERT_TRUE(a && b);
+	const std::uint32_t generation = allocator.Generation(*a);
+	EXPECT_TRUE(allocator.IsLive(*a, generation));
+
+	allocator.Free(*a, /*frame=*/5);
+	allocator.Free(*a, /*frame=*/5); // double free is ignored
+	EXPECT_FALSE(allocator.IsLive(*a, generation));
+	EXPECT_EQ(allocator.GetStats().pendingFree, 1u);
+
+	// Frame 5 still in flight: the slot must not come back yet.
+	allocator.Retire(5);
+	EXPECT_NE(allocator.Allocate(), a);
+
+	allocator.Retire(6);
+	EXPECT_EQ(allocator.GetStats().pendingFree, 0u);
+	EXPECT_EQ(allocator.Allocate(), a);
+	EXPECT_NE(allocator.Generation(*a), generation);
+	EXPECT_EQ(allocator.GetStats().highWater, 3u);
+}
+
+TEST(Bindless, RangesAreContiguousAndFragmentationIsReported)
+{
+	rendern::DescriptorIndexAllocator allocator(16);
+	std::vector<std::uint32_t> slots;
+	for (int i = 0; i < 12; ++i)
+	{
+		slots.push_back(*allocator.Allocate());
+	}
+
+	// Free every other slot: 6 holes of 1 plus the 4-slot tail.
+	for (std::size_t i = 0; i < slots.size(); i += 2)
+	{
+		allocator.Free(slots[i], 0);
+	}
+	allocator.Retire(1);
+	rendern::DescriptorAllocatorStats stats = allocator.GetStats();
+	EXPECT_EQ(stats.live, 6u);
+	EXPECT_EQ(stats.largestFreeRun, 4u);
+	EXPECT_FLOAT_EQ(stats.occupancy, 6.0f / 16.0f);
+	EXPECT_FLOAT_EQ(stats.fragmentation, 1.0f - 4.0f / 10.0f);
+
+	// The tail is taken first; after that only the scattered holes remain.
+	const std::optional<rendern::DescriptorRange> tail = allocator.AllocateRange(4);
+	ASSERT_TRUE(tail);
+	EXPECT_EQ(tail->first, 12u);
+	EXPECT_FALSE(allocator.AllocateRange(2));
+
+	// Freeing a neighbour joins two holes into a run the next range can use.
+	allocator.Free(slots[1], 0);
+	allocator.Retire(1);
+	const std::optional<rendern::DescriptorRange> joined = allocator.AllocateRange(3);
+	ASSERT_TRUE(joined);
+	EXPECT_EQ(joined->first, slots[0]);
+
+	// Slots inside the range are no longer handed out individually.
+	for (std::optional<std::uint32_t> slot = allocator.Allocate(); slot; slot = allocator.Allocate())
+	{
+		EXPECT_TRUE(*slot < joined->first || *slot >= joined->first + joined->count);
+	}
+	EXPECT_EQ(allocator.GetStats().live, 16u);
+}
+
+TEST(Bindless, TableChurnDoesNotGrowTheDeviceHeap)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+	rendern::FrameSync sync(*device, rendern::FrameSyncDesc{ .framesInRuntime = 2 });
+	rendern::BindlessTable table(*device, &sync, rendern::BindlessTableDesc{ .capacity = 16 });
+
+	const rhi::TextureHandle texture = device->CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+	std::vector<rhi::TextureDescIndex> live;
+	for (int frame = 0; frame < 64; ++frame)
+	{
+		sync.BeginFrame();
+		// Streaming pattern: two textures in, two out, every frame.
+		live.push_back(table.RegisterTexture(texture));
+		live.push_back(table.RegisterTexture(texture));
+		if (live.size() > 4)
+		{
+			table.UnregisterTexture(live[0]);
+			table.UnregisterTexture(live[1]);
+			live.erase(live.begin(), live.begin() + 2);
+		}
+		sync.EndFrame();
+	}
+
+	// 4 live + 2 new + 2 frames of pending frees bounds the working set, however long the churn runs.
+	const rendern::DescriptorAllocatorStats stats = table.GetStats();
+	EXPECT_LE(stats.highWater, 10u);
+	EXPECT_EQ(stats.live, 4u);
+
+	// Indices of the table never collide with ones the device hands out directly.
+	const rhi::TextureDescIndex direct = device->AllocateTextureDesctiptor(texture);
+	for (const rhi::TextureDescIndex index : live)
+	{
+		EXPECT_NE(index, direct);
+		EXPECT_NE(index, 0u);
+		EXPECT_TRUE(table.IsLive(index, table.Generation(index)));
+	}
+	const rendern::DescriptorRange range = table.ReserveRange(2);
+	EXPECT_EQ(range.count, 2u);
+	EXPECT_NE(range.first, direct);
+}
+
+TEST(Bindless, DescriptorDoubleFreesAreIgnored)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	const rhi::TextureHandle texture = inner->CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+
+	// Backend guard: a slot freed twice is recycled once, so two allocations never share it.
+	const rhi::TextureDescIndex slot = inner->AllocateTextureDesctiptor(texture);
+	inner->FreeTextureDescriptor(slot);
+	inner->FreeTextureDescriptor(slot);
+	const rhi::TextureDescIndex first = inner->AllocateTextureDesctiptor(texture);
+	const rhi::TextureDescIndex second = inner->AllocateTextureDesctiptor(texture);
+	EXPECT_EQ(first, slot);
+	EXPECT_NE(second, slot);
+
+	// Validation layer: releasing a range whose slot was already freed on its own reports it.
+	rhi::ValidationDevice device(*inner);
+	const rhi::TextureHandle validated = device.CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+	const rhi::TextureDescIndex range = device.ReserveTextureDescriptorRange(4);
+	device.UpdateTextureDescriptor(range + 1, validated);
+	device.FreeTextureDescriptor(range + 1);
+	device.ReleaseTextureDescriptorRange(range, 4);
+	EXPECT_EQ(device.GetCurrentFrameStats().invalidDestroys, 1u);
+	device.FreeTextureDescriptor(range);
+	EXPECT_EQ(device.GetCurrentFrameStats().invalidDestroys, 2u);
+}
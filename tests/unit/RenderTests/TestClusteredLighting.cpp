@@ -0,0 +1,243 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+import core;
+
+namespace
+{
+	constexpr float kNear = 0.1f;
+	constexpr float kFar = 200.0f;
+
+	mathUtils::Mat4 CameraProj()
+	{
+		return mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(60.0f), 16.0f / 9.0f, kNear, kFar);
+	}
+
+	mathUtils::Mat4 CameraView()
+	{
+		return mathUtils::LookAt(mathUtils::Vec3{ 2.0f, 3.0f, 5.0f }, mathUtils::Vec3{ 2.0f, 1.0f, -20.0f }, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f });
+	}
+
+	// The cluster a shader would pick for a world position: screen tile from the projected UV (top-left
+	// origin), slice from the view depth. Returns false if the point is off screen.
+	bool ShaderCluster(const rendern::ClusteredLightBuilder& builder, const mathUtils::Vec3& world, std::uint32_t& cluster)
+	{
+		const mathUtils::Vec4 viewPos = CameraView() * mathUtils::Vec4(world, 1.0f);
+		const mathUtils::Vec4 clip = CameraProj() * viewPos;
+		if (clip.w <= kNear || clip.w >= kFar)
+		{
+			return false;
+		}
+		const float u = (clip.x / clip.w + 1.0f) * 0.5f;
+		const float v = (1.0f - clip.y / clip.w) * 0.5f;
+		if (u < 0.0f || u >= 1.0f || v < 0.0f || v >= 1.0f)
+		{
+			return false;
+		}
+		const auto tileX = static_cast<std::uint32_t>(u * static_cast<float>(builder.GetGridX()));
+		const auto tileY = static_cast<std::uint32_t>(v * static_cast<float>(builder.GetGridY()));
+		cluster = builder.ClusterIndex(tileX, tileY, builder.DepthSlice(-viewPos.z));
+		return true;
+	}
+
+	bool ClusterHasLight(const rendern::ClusteredLightBuilder& builder, std::uint32_t cluster, std::uint32_t light)
+	{
+		const rendern::ClusterRange range = builder.GetClusterRanges()[cluster];
+		const auto list = builder.GetLightIndices().subspan(range.offset, range.count);
+		return std::find(list.begin(), list.end(), light) != list.end();
+	}
+
+	struct TestLight
+	{
+		mathUtils::Vec3 position{};
+		mathUtils::Vec3 direction{};
+		float range{ 0.0f };
+		float cosOuter{ -1.0f }; // -1 = point light
+	};
+}
+
+TEST(ClusteredLighting, ClusterBoundsTileTheViewFrustum)
+{
+	rendern::ClusteredLightBuilder builder;
+	builder.BeginFrame(CameraView(), CameraProj(), kNear, kFar);
+	ASSERT_EQ(builder.GetClusterCount(), 16u * 9u * 24u);
+
+	EXPECT_EQ(builder.DepthSlice(kNear), 0u);
+	EXPECT_EQ(builder.DepthSlice(kFar * 2.0f), 23u);
+	EXPECT_EQ(builder.DepthSlice(std::sqrt(kNear * kFar) * 1.01f), 12u);
+
+	std::mt19937 rng(11u);
+	std::uniform_real_distribution<float> lateral(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> depth(-150.0f, 4.0f);
+	std::size_t onScreen = 0;
+	for (int i = 0; i < 5000; ++i)
+	{
+		const mathUtils::Vec3 world{ lateral(rng), lateral(rng) * 0.5f, depth(rng) };
+		std::uint32_t cluster = 0;
+		if (!ShaderCluster(builder, world, cluster))
+		{
+			continue;
+		}
+		// The cluster the shader picks holds the point (up to float slop at the boundaries).
+		const mathUtils::Vec4 viewPos = CameraView() * mathUtils::Vec4(world, 1.0f);
+		const rendern::Aabb box = builder.GetClusterBounds(cluster);
+		const float eps = 1e-3f * std::max(1.0f, -viewPos.z);
+		EXPECT_GE(viewPos.x, box.min.x - eps);
+		EXPECT_LE(viewPos.x, box.max.x + eps);
+		EXPECT_GE(viewPos.y, box.min.y - eps);
+		EXPECT_LE(viewPos.y, box.max.y + eps);
+		EXPECT_GE(viewPos.z, box.min.z - eps);
+		EXPECT_LE(viewPos.z, box.max.z + eps);
+		++onScreen;
+	}
+	EXPECT_GT(onScreen, 500u);
+}
+
+TEST(ClusteredLighting, EveryLitPointFindsItsLightInItsCluster)
+{
+	std::mt19937 rng(4u);
+	std::uniform_real_distribution<float> lateral(-40.0f, 40.0f);
+	std::uniform_real_distribution<float> depth(-120.0f, 8.0f);
+	std::uniform_real_distribution<float> range(1.0f, 12.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> angle(5.0f, 80.0f);
+
+	std::vector<TestLight> lights;
+	for (int i = 0; i < 64; ++i)
+	{
+		TestLight light{};
+		light.position = mathUtils::Vec3{ lateral(rng), lateral(rng) * 0.25f, depth(rng) };
+		light.range = range(rng);
+		if (i % 2 == 1)
+		{
+			light.direction = mathUtils::Normalize(mathUtils::Vec3{ unit(rng), unit(rng), unit(rng) } + mathUtils::Vec3{ 0.0f, 0.0f, 0.01f });
+			light.cosOuter = std::cos(mathUtils::DegToRad(angle(rng)));
+		}
+		lights.push_back(light);
+	}
+
+	rendern::ClusteredLightBuilder builder;
+	builder.BeginFrame(CameraView(), CameraProj(), kNear, kFar);
+	builder.AddGlobalLight(64);
+	for (std::uint32_t i = 0; i < lights.size(); ++i)
+	{
+		if (lights[i].cosOuter < 0.0f)
+		{
+			builder.AddPointLight(i, lights[i].position, lights[i].range);
+		}
+		else
+		{
+			builder.AddSpotLight(i, lights[i].position, lights[i].direction, lights[i].range, lights[i].cosOuter);
+		}
+	}
+	builder.Build();
+
+	// Points inside a light's volume (within range, and inside the cone for spots) must find the light.
+	std::size_t litSamples = 0;
+	for (std::uint32_t i = 0; i < lights.size(); ++i)
+	{
+		const TestLight& light = lights[i];
+		for (int sample = 0; sample < 200; ++sample)
+		{
+			const mathUtils::Vec3 offset = mathUtils::Vec3{ unit(rng), unit(rng), unit(rng) } * light.range;
+			const float distance = mathUtils::Length(offset);
+			if (distance >= light.range || distance < 1e-3f)
+			{
+				continue;
+			}
+			if (light.cosOuter >= 0.0f && mathUtils::Dot(offset * (1.0f / distance), light.direction) < light.cosOuter)
+			{
+				continue;
+			}
+			std::uint32_t cluster = 0;
+			if (!ShaderCluster(builder, light.position + offset, cluster))
+			{
+				continue;
+			}
+			EXPECT_TRUE(ClusterHasLight(builder, cluster, i)) << "light " << i << " cluster " << cluster;
+			++litSamples;
+		}
+	}
+	EXPECT_GT(litSamples, 1000u);
+
+	// The global light leads the index list; cluster lists follow it back to back, in ascending light order.
+	ASSERT_EQ(builder.GetGlobalLightCount(), 1u);
+	EXPECT_EQ(builder.GetLightIndices()[0], 64u);
+	std::uint32_t expectedOffset = 1;
+	for (const rendern::ClusterRange& range : builder.GetClusterRanges())
+	{
+		EXPECT_EQ(range.offset, expectedOffset);
+		const auto list = builder.GetLightIndices().subspan(range.offset, range.count);
+		EXPECT_TRUE(std::is_sorted(list.begin(), list.end()));
+		expectedOffset += range.count;
+	}
+	EXPECT_EQ(expectedOffset, builder.GetLightIndices().size());
+
+	// Local lights only touch a small part of the grid.
+	const rendern::ClusteredLightingStats& stats = builder.GetStats();
+	EXPECT_EQ(stats.pointLights, 32u);
+	EXPECT_EQ(stats.spotLights, 32u);
+	EXPECT_EQ(stats.globalLights, 1u);
+	EXPECT_EQ(stats.clusterLightIndices + 1u, builder.GetLightIndices().size());
+	EXPECT_LT(stats.clusterLightIndices, builder.GetClusterCount() * 8u);
+	EXPECT_LE(stats.maxLightsPerCluster, 64u);
+}
+
+TEST(ClusteredLighting, SpotConesSkipClustersBehindAndBesideThem)
+{
+	rendern::ClusteredLightBuilder builder;
+	builder.BeginFrame(CameraView(), CameraProj(), kNear, kFar);
+	// A narrow spot pointing away from the camera and a point light of the same range at the same place.
+	const mathUtils::Vec3 position{ 2.0f, 1.0f, -20.0f };
+	builder.AddSpotLight(0, position, mathUtils::Vec3{ 0.0f, 0.0f, -1.0f }, 10.0f, std::cos(mathUtils::DegToRad(10.0f)));
+	builder.AddPointLight(1, position, 10.0f);
+	builder.Build();
+
+	std::uint32_t spotClusters = 0;
+	std::uint32_t pointClusters = 0;
+	for (std::uint32_t cluster = 0; cluster < builder.GetClusterCount(); ++cluster)
+	{
+		spotClusters += ClusterHasLight(builder, cluster, 0) ? 1u : 0u;
+		pointClusters += ClusterHasLight(builder, cluster, 1) ? 1u : 0u;
+	}
+	EXPECT_GT(spotClusters, 0u);
+	EXPECT_LT(spotClusters * 2u, pointClusters);
+
+	// Between the camera and the spot: lit by the point light only.
+	std::uint32_t cluster = 0;
+	ASSERT_TRUE(ShaderCluster(builder, position + mathUtils::Vec3{ 0.0f, 0.0f, 6.0f }, cluster));
+	EXPECT_FALSE(ClusterHasLight(builder, cluster, 0));
+	EXPECT_TRUE(ClusterHasLight(builder, cluster, 1));
+}
+
+TEST(ClusteredLighting, LightsOutsideTheGridAndBadInput)
+{
+	rendern::ClusteredLightBuilder builder(8, 4, 6);
+	builder.BeginFrame(CameraView(), CameraProj(), kNear, kFar);
+	builder.AddPointLight(0, mathUtils::Vec3{ 2.0f, 3.0f, 30.0f }, 5.0f);   // behind the camera
+	builder.AddPointLight(1, mathUtils::Vec3{ 2.0f, 3.0f, -400.0f }, 5.0f); // past the far distance
+	builder.AddPointLight(2, mathUtils::Vec3{ 300.0f, 3.0f, -20.0f }, 5.0f); // off to the side
+	builder.AddPointLight(3, mathUtils::Vec3{ 2.0f, 2.0f, -10.0f }, 0.0f);  // no range
+	builder.Build();
+
+	EXPECT_EQ(builder.GetStats().pointLights, 3u);
+	EXPECT_EQ(builder.GetStats().lightsOutsideGrid, 3u);
+	EXPECT_TRUE(builder.GetLightIndices().empty());
+	EXPECT_EQ(builder.GetClusterRanges().size(), 8u * 4u * 6u);
+	for (const rendern::ClusterRange& range : builder.GetClusterRanges())
+	{
+		EXPECT_EQ(range.count, 0u);
+	}
+
+	EXPECT_THROW(builder.BeginFrame(CameraView(), CameraProj(), 0.0f, kFar), std::runtime_error);
+	EXPECT_THROW(builder.BeginFrame(CameraView(), CameraProj(), 10.0f, 5.0f), std::runtime_error);
+	EXPECT_THROW(rendern::ClusteredLightBuilder(16, 0, 24), std::runtime_error);
+}
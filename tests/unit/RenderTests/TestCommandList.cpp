@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+import core;
+
+TEST(CommandList, RecordsAndReplaysInOrder)
+{
+	rhi::CommandList list{};
+
+	rhi::BeginPassDesc begin{};
+	begin.extent = { 640, 480 };
+	list.BeginPass(begin);
+	list.BindPipeline(rhi::PipelineHandle{ 3 });
+	list.DrawIndexed(36, rhi::IndexType::UINT32, 0, 0, 4, 1);
+	list.EndPass();
+
+	ASSERT_EQ(list.Size(), 4u);
+
+	std::vector<rhi::CommandType> types{};
+	for (const rhi::CommandRecord& record : list)
+	{
+		types.push_back(record.Type());
+		rhi::VisitCommand(record, []<typename T>(const T& cmd)
+			{
+				if constexpr (std::is_same_v<T, rhi::CommandBeginPass>)
+				{
+					EXPECT_EQ(cmd.desc.extent.width, 640u);
+				}
+				else if constexpr (std::is_same_v<T, rhi::CommandBindPipeline>)
+				{
+					EXPECT_EQ(cmd.pso.id, 3u);
+				}
+				else if constexpr (std::is_same_v<T, rhi::CommandDrawIndexed>)
+				{
+					EXPECT_EQ(cmd.indexCount, 36u);
+					EXPECT_EQ(cmd.instanceCount, 4u);
+					EXPECT_EQ(cmd.firstInstance, 1u);
+				}
+			});
+	}
+
+	const std::vector<rhi::CommandType> expected{
+		rhi::CommandType::BeginPass,
+		rhi::CommandType::BindPipeline,
+		rhi::CommandType::DrawIndexed,
+		rhi::CommandType::EndPass };
+	EXPECT_EQ(types, expected);
+}
+
+TEST(CommandList, StoresOnlyUsedConstantBytesAndUniformIds)
+{
+	rhi::CommandList list{};
+
+	const std::array<float, 4> color{ 0.25f, 0.5f, 0.75f, 1.0f };
+	list.SetConstants(2, std::as_bytes(std::span{ color }));
+	list.SetUniformInt("uUseTex", 1);
+
+	// Far below the 512-byte inline array the variant-based list paid for every command.
+	EXPECT_LT(list.SizeBytes(), 64u);
+	EXPECT_EQ(sizeof(rhi::CommandSetUniformInt), 16u);
+
+	int visited = 0;
+	for (const rhi::CommandRecord& record : list)
+	{
+		rhi::VisitCommand(record, [&visited]<typename T>(const T& cmd)
+			{
+				if constexpr (std::is_same_v<T, rhi::CommandSetConstants>)
+				{
+					ASSERT_EQ(cmd.size, sizeof(color));
+					std::array<float, 4> decoded{};
+					std::memcpy(decoded.data(), cmd.data.data(), cmd.size);
+					EXPECT_FLOAT_EQ(decoded[2], 0.75f);
+					++visited;
+				}
+				else if constexpr (std::is_same_v<T, rhi::CommandSetUniformInt>)
+				{
+					EXPECT_EQ(cmd.id, rhi::UniformId("uUseTex"));
+					EXPECT_EQ(cmd.value, 1);
+					++visited;
+				}
+			});
+	}
+	EXPECT_EQ(visited, 2);
+}
+
+TEST(CommandList, UniformIdsHashLiteralsAtCompileTime)
+{
+	constexpr rhi::UniformId literal = "uMVP";
+	static_assert(literal == rhi::UniformId::FromName("uMVP"));
+	static_assert(literal != rhi::UniformId("uVP"));
+	static_assert(rhi::UniformId("").value == 14695981039346656037ull);
+
+	const std::string runtimeName = std::string("uM") + "VP";
+	EXPECT_EQ(rhi::UniformId::FromName(runtimeName), literal);
+	EXPECT_TRUE(literal);
+	EXPECT_FALSE(rhi::UniformId{});
+}
+
+TEST(CommandList, ResetKeepsArenaCapacity)
+{
+	rhi::CommandList list{};
+	for (int i = 0; i < 10000; ++i)
+	{
+		list.Draw(3);
+	}
+	const std::size_t capacity = list.CapacityBytes();
+	EXPECT_GE(capacity, list.SizeBytes());
+
+	list.Reset();
+	EXPECT_TRUE(list.Empty());
+	EXPECT_EQ(list.SizeBytes(), 0u);
+	EXPECT_EQ(list.CapacityBytes(), capacity);
+	EXPECT_EQ(list.begin(), list.end());
+}
+
+TEST(CommandList, RejectsOversizedConstants)
+{
+	rhi::CommandList list{};
+	std::array<std::byte, rhi::CommandList::kMaxConstantsBytes + 1> tooLarge{};
+	EXPECT_THROW(list.SetConstants(0, tooLarge), std::runtime_error);
+}
+
+TEST(CommandList, OptimizerDropsRebindsWithinAPass)
+{
+	rhi::CommandList list{};
+	rhi::GraphicsState state{};
+	const rhi::BufferHandle vb{ 7 };
+
+	list.BeginPass(rhi::BeginPassDesc{});
+	for (int draw = 0; draw < 3; ++draw)
+	{
+		list.SetState(state);
+		list.BindPipeline(rhi::PipelineHandle{ 3 });
+		list.BindInputLayout(rhi::InputLayoutHandle{ 2 });
+		list.BindVertexBuffer(0, vb, 32, 0);
+		list.BindTextureDesc(0, 5);
+		list.DrawIndexed(36, rhi::IndexType::UINT32);
+	}
+	list.BindVertexBuffer(0, vb, 32, 64); // new offset: kept
+	list.DrawIndexed(36, rhi::IndexType::UINT32);
+	list.EndPass();
+
+	// Binding state is forgotten at pass boundaries, so the next pass re-binds everything.
+	list.BeginPass(rhi::BeginPassDesc{});
+	list.BindPipeline(rhi::PipelineHandle{ 3 });
+	list.Draw(3);
+	list.EndPass();
+
+	rhi::CommandList optimized{};
+	const rhi::CommandListOptimizeStats stats = rhi::OptimizeCommandList(list, optimized);
+
+	EXPECT_EQ(stats.inputCommands, list.Size());
+	EXPECT_EQ(stats.redundantState, 2u);
+	EXPECT_EQ(stats.redundantBindings, 8u);
+	EXPECT_EQ(stats.RemovedCommands(), 10u);
+	EXPECT_EQ(optimized.Size(), list.Size() - 10u);
+
+	std::size_t pipelineBinds = 0;
+	std::size_t draws = 0;
+	for (const rhi::CommandRecord& record : optimized)
+	{
+		pipelineBinds += record.Type() == rhi::CommandType::BindPipeline ? 1u : 0u;
+		draws += (record.Type() == rhi::CommandType::DrawIndexed || record.Type() == rhi::CommandType::Draw) ? 1u : 0u;
+	}
+	EXPECT_EQ(pipelineBinds, 2u);
+	EXPECT_EQ(draws, 5u);
+}
+
+TEST(CommandList, OptimizerMergesConstantsNoDrawObserved)
+{
+	const std::array<float, 4> a{ 1.0f, 2.0f, 3.0f, 4.0f };
+	const std::array<float, 4> b{ 5.0f, 6.0f, 7.0f, 8.0f };
+
+	rhi::CommandList list{};
+	list.BeginPass(rhi::BeginPassDesc{});
+	list.SetConstants(0, std::as_bytes(std::span{ a }));
+	list.SetConstants(0, std::as_bytes(std::span{ b })); // overwrites `a` before any draw
+	list.Draw(3);
+	list.SetConstants(0, std::as_bytes(std::span{ b })); // same bytes as already set
+	list.Draw(3);
+	list.SetConstants(0, std::as_bytes(std::span{ a }));
+	list.Draw(3);
+	list.EndPass();
+
+	rhi::CommandList optimized{};
+	const rhi::CommandListOptimizeStats stats = rhi::OptimizeCommandList(list, optimized);
+	EXPECT_EQ(stats.mergedConstants, 1u);
+	EXPECT_EQ(stats.redundantConstants, 1u);
+
+	std::vector<float> firstFloats{};
+	for (const rhi::CommandRecord& record : optimized)
+	{
+		rhi::VisitCommand(record, [&firstFloats]<typename T>(const T& cmd)
+			{
+				if constexpr (std::is_same_v<T, rhi::CommandSetConstants>)
+				{
+					float first = 0.0f;
+					std::memcpy(&first, cmd.data.data(), sizeof(first));
+					firstFloats.push_back(first);
+				}
+			});
+	}
+	const std::vector<float> expected{ 5.0f, 1.0f };
+	EXPECT_EQ(firstFloats, expected);
+}
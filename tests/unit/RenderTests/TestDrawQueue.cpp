@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rendern::DrawKeyFields Fields(std::uint32_t pipeline, std::uint32_t material, std::uint32_t mesh, float depth)
+	{
+		rendern::DrawKeyFields fields{};
+		fields.pipeline = pipeline;
+		fields.material = material;
+		fields.mesh = mesh;
+		fields.depth = depth;
+		return fields;
+	}
+}
+
+TEST(DrawQueue, RadixSortMatchesStableSort)
+{
+	std::mt19937_64 rng{ 7u };
+	rendern::DrawQueue queue;
+	std::vector<rendern::DrawQueue::Item> expected;
+	for (std::uint32_t i = 0; i < 5000; ++i)
+	{
+		// Narrow keys repeat often, which exercises stability and the skipped-digit path.
+		const std::uint64_t key = (i % 3u == 0u) ? (rng() & 0xFFFFu) : rng();
+		queue.Push(key, i);
+		expected.push_back({ key, i });
+	}
+
+	queue.Sort();
+	std::stable_sort(expected.begin(), expected.end(),
+		[](const rendern::DrawQueue::Item& a, const rendern::DrawQueue::Item& b) { return a.key < b.key; });
+
+	ASSERT_EQ(queue.Size(), expected.size());
+	for (std::size_t i = 0; i < expected.size(); ++i)
+	{
+		ASSERT_EQ(queue.Items()[i].key, expected[i].key);
+		ASSERT_EQ(queue.Items()[i].index, expected[i].index);
+	}
+}
+
+TEST(DrawQueue, OpaqueGroupsByStateThenFrontToBack)
+{
+	rendern::DrawQueue queue;
+	queue.Push(rendern::drawKey::Opaque(Fields(1, 2, 3, 50.0f)), 0);
+	queue.Push(rendern::drawKey::Opaque(Fields(0, 9, 9, 900.0f)), 1);
+	queue.Push(rendern::drawKey::Opaque(Fields(1, 2, 3, 5.0f)), 2);
+	queue.Push(rendern::drawKey::Opaque(Fields(1, 1, 3, 1.0f)), 3);
+	queue.Push(rendern::drawKey::Opaque(Fields(1, 2, 3, 0.5f)), 4);
+	queue.Sort();
+
+	std::vector<std::uint32_t> order;
+	for (const rendern::DrawQueue::Item& item : queue.Items())
+	{
+		order.push_back(item.index);
+	}
+	// Pipeline first, then material; equal state stays contiguous and runs near to far.
+	EXPECT_EQ(order, (std::vector<std::uint32_t>{ 1, 3, 4, 2, 0 }));
+}
+
+TEST(DrawQueue, TranslucentSortsAfterOpaqueAndBackToFront)
+{
+	rendern::DrawQueue queue;
+	queue.Push(rendern::drawKey::Translucent(Fields(0, 1, 1, 10.0f)), 0);
+	queue.Push(rendern::drawKey::Opaque(Fields(4095, 65535, 1, 1.0e30f)), 1);
+	queue.Push(rendern::drawKey::Translucent(Fields(7, 3, 2, 1000.0f)), 2);
+	queue.Push(rendern::drawKey::Translucent(Fields(0, 1, 1, 10.5f)), 3);
+	queue.Sort();
+
+	std::vector<std::uint32_t> order;
+	for (const rendern::DrawQueue::Item& item : queue.Items())
+	{
+		order.push_back(item.index);
+	}
+	EXPECT_EQ(order, (std::vector<std::uint32_t>{ 1, 2, 3, 0 }));
+	EXPECT_FALSE(rendern::drawKey::IsTranslucent(queue.Items()[0].key));
+	EXPECT_TRUE(rendern::drawKey::IsTranslucent(queue.Items()[1].key));
+
+	// A later pass sorts after every draw of an earlier pass, translucent or not.
+	rendern::DrawKeyFields later = Fields(0, 0, 0, 0.0f);
+	later.pass = 1;
+	EXPECT_GT(rendern::drawKey::Opaque(later), queue.Items().back().key);
+	EXPECT_EQ(rendern::drawKey::Pass(rendern::drawKey::Opaque(later)), 1u);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+import core;
+
+namespace
+{
+	std::uint64_t RunFrames(std::uint32_t gpuLatencySignals, int framesInRuntime, int frameCount)
+	{
+		std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice(rhi::NullDeviceDesc{ .gpuLatencySignals = gpuLatencySignals });
+		rendern::FrameSync sync(*device, rendern::FrameSyncDesc{ .framesInRuntime = framesInRuntime });
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			sync.BeginFrame();
+			sync.EndFrame();
+		}
+		return sync.GetStats().stalls;
+	}
+}
+
+TEST(FrameSync, StallsOnlyWhenTheGpuFallsBehindTheFramesInFlight)
+{
+	// The GPU trails the CPU by one frame: two frames in flight hide it completely.
+	EXPECT_EQ(RunFrames(1, 2, 10), 0u);
+	// Three frames behind: every frame after the first two has to wait for the GPU...
+	EXPECT_EQ(RunFrames(3, 2, 10), 8u);
+	// ...unless enough frames may be in flight to cover the latency.
+	EXPECT_EQ(RunFrames(3, 4, 10), 0u);
+}
+
+TEST(FrameSync, DefaultsToTheDeviceFramesInFlight)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice(rhi::NullDeviceDesc{ .framesInFlight = 3 });
+	rendern::FrameSync sync(*device);
+	EXPECT_EQ(sync.GetFrameInRuntime(), 3);
+
+	// Wrappers report what the device underneath keeps in flight.
+	rhi::RecordingDevice recorder(*device);
+	EXPECT_EQ(recorder.GetFramesInFlight(), 3u);
+	EXPECT_EQ(rendern::FrameSync(recorder).GetFrameInRuntime(), 3);
+	// An explicit count still wins.
+	EXPECT_EQ(rendern::FrameSync(recorder, rendern::FrameSyncDesc{ .framesInRuntime = 1 }).GetFrameInRuntime(), 1);
+}
+
+TEST(FrameSync, DeferredReleasesRunWhenTheirValueCompletes)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice(rhi::NullDeviceDesc{ .gpuLatencySignals = 1 });
+	rendern::FrameSync sync(*device, rendern::FrameSyncDesc{ .framesInRuntime = 2 });
+	std::vector<int> released;
+
+	sync.BeginFrame();
+	sync.DeferRelease([&] { released.push_back(0); });
+	sync.EndFrame();
+	EXPECT_EQ(sync.GetCompletedFrameCount(), 0u);
+
+	sync.BeginFrame();
+	EXPECT_TRUE(released.empty()); // frame 0 is still on the simulated GPU
+	sync.EndFrame();
+	EXPECT_EQ(sync.GetCompletedFrameCount(), 1u);
+
+	sync.BeginFrame();
+	EXPECT_EQ(released, (std::vector<int>{ 0 }));
+
+	// Async work with its own values; releases run in value order, not submission order.
+	const std::uint64_t upload = sync.Signal();
+	const std::uint64_t later = sync.Signal();
+	sync.DeferRelease(later, [&] { released.push_back(2); });
+	sync.DeferRelease(upload, [&] { released.push_back(1); });
+	EXPECT_EQ(sync.GetStats().pendingReleases, 2u);
+
+	sync.WaitForValue(upload);
+	sync.RetireCompleted();
+	EXPECT_EQ(released, (std::vector<int>{ 0, 1 }));
+
+	sync.WaitIdle();
+	EXPECT_EQ(released, (std::vector<int>{ 0, 1, 2 }));
+	EXPECT_EQ(sync.GetStats().pendingReleases, 0u);
+	EXPECT_EQ(sync.GetStats().retiredReleases, 3u);
+	EXPECT_EQ(sync.GetCompletedValue(), sync.GetLastSignaledValue());
+}
+
+TEST(FrameSync, TimelineSurvivesCaptureReplay)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice(rhi::NullDeviceDesc{ .gpuLatencySignals = 2 });
+	rhi::RecordingDevice recorder(*inner);
+	{
+		rendern::FrameSync sync(recorder, rendern::FrameSyncDesc{ .framesInRuntime = 1 });
+		for (int frame = 0; frame < 4; ++frame)
+		{
+			sync.BeginFrame();
+			sync.EndFrame();
+		}
+	}
+
+	// Replay onto a device that already used its timeline: waits must target the replay's own values.
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice(rhi::NullDeviceDesc{ .gpuLatencySignals = 8 });
+	target->SignalTimeline();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	replayer.Replay(*target, *swapChain);
+	EXPECT_EQ(target->GetCompletedTimelineValue(), 5u);
+}
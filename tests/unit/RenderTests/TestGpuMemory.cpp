@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rhi::BufferDesc GeometryDesc(std::size_t sizeInBytes, rhi::BufferBindFlag bind = rhi::BufferBindFlag::VertexBuffer)
+	{
+		rhi::BufferDesc desc{};
+		desc.bindFlag = bind;
+		desc.usageFlag = rhi::BufferUsageFlag::Static;
+		desc.sizeInBytes = sizeInBytes;
+		return desc;
+	}
+}
+
+TEST(TlsfRangeAllocator, AlignsAndMergesFreedRanges)
+{
+	renderer::TlsfRangeAllocator ranges(64 * 1024, 256);
+
+	const std::optional<std::size_t> a = ranges.Allocate(100);
+	const std::optional<std::size_t> b = ranges.Allocate(300, 4096);
+	const std::optional<std::size_t> c = ranges.Allocate(1000);
+	ASSERT_TRUE(a && b && c);
+	EXPECT_EQ(*a % 256, 0u);
+	EXPECT_EQ(*b % 4096, 0u);
+	EXPECT_EQ(*c % 256, 0u);
+	EXPECT_EQ(ranges.AllocationCount(), 3u);
+	EXPECT_EQ(ranges.UsedBytes(), 256u + 512u + 1024u);
+
+	EXPECT_TRUE(ranges.Free(*a));
+	EXPECT_TRUE(ranges.Free(*c));
+	EXPECT_TRUE(ranges.Free(*b));
+	EXPECT_FALSE(ranges.Free(*b));
+
+	// Everything coalesces back into one range covering the whole capacity.
+	EXPECT_TRUE(ranges.Empty());
+	EXPECT_EQ(ranges.FreeRangeCount(), 1u);
+	EXPECT_EQ(ranges.LargestFreeRangeBytes(), 64u * 1024u);
+}
+
+TEST(TlsfRangeAllocator, SurvivesRandomChurnWithoutOverlap)
+{
+	constexpr std::size_t kCapacity = 1024 * 1024;
+	renderer::TlsfRangeAllocator ranges(kCapacity, 16);
+	std::mt19937 rng{ 42u };
+	std::uniform_int_distribution<std::size_t> sizeDist(1, 8192);
+
+	struct Live { std::size_t offset; std::size_t size; };
+	std::vector<Live> live;
+	for (int step = 0; step < 4000; ++step)
+	{
+		if (!live.empty() && (rng() % 3u) == 0u)
+		{
+			const std::size_t victim = rng() % live.size();
+			ASSERT_TRUE(ranges.Free(live[victim].offset));
+			live[victim] = live.back();
+			live.pop_back();
+			continue;
+		}
+
+		const std::size_t size = sizeDist(rng);
+		if (const std::optional<std::size_t> offset = ranges.Allocate(size))
+		{
+			ASSERT_LE(*offset + size, kCapacity);
+			for (const Live& other : live)
+			{
+				ASSERT_TRUE(*offset + size <= other.offset || other.offset + other.size <= *offset);
+			}
+			live.push_back({ *offset, size });
+		}
+	}
+
+	for (const Live& range : live)
+	{
+		ASSERT_TRUE(ranges.Free(range.offset));
+	}
+	EXPECT_EQ(ranges.FreeRangeCount(), 1u);
+	EXPECT_EQ(ranges.FreeBytes(), kCapacity);
+}
+
+TEST(GpuMemory, SubAllocatesGeometryFromSharedBlocks)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+	renderer::SubAllocatingGPUMemoryAllocator allocator(*device, renderer::SubAllocatorDesc{ .blockSizeBytes = 64 * 1024, .alignmentBytes = 256 });
+
+	const renderer::BufferAllocation vb0 = allocator.AllocateBuffer(GeometryDesc(1000));
+	const renderer::BufferAllocation vb1 = allocator.AllocateBuffer(GeometryDesc(3000));
+	const renderer::BufferAllocation ib0 = allocator.AllocateBuffer(GeometryDesc(600, rhi::BufferBindFlag::IndexBuffer));
+
+	EXPECT_EQ(vb0.buffer, vb1.buffer);
+	EXPECT_NE(vb0.offsetBytes, vb1.offsetBytes);
+	EXPECT_EQ(vb1.offsetBytes % 256, 0u);
+	EXPECT_NE(ib0.buffer, vb0.buffer);
+
+	renderer::GPUMemoryStats stats = allocator.GetStats();
+	EXPECT_EQ(stats.blockCount, 2u);
+	EXPECT_EQ(stats.allocationCount, 3u);
+	EXPECT_EQ(stats.reservedBytes, 2u * 64u * 1024u);
+	EXPECT_EQ(stats.usedBytes, 1024u + 3072u + 768u);
+	EXPECT_GT(stats.Utilization(), 0.0);
+
+	// Freeing the first range leaves a hole in front of vb1: free space is now split.
+	allocator.FreeBuffer(vb0);
+	stats = allocator.GetStats();
+	EXPECT_GT(stats.Fragmentation(), 0.0);
+
+	allocator.FreeBuffer(vb1);
+	allocator.FreeBuffer(ib0);
+	stats = allocator.GetStats();
+	EXPECT_EQ(stats.allocationCount, 0u);
+	EXPECT_DOUBLE_EQ(stats.Fragmentation(), 0.0);
+	EXPECT_EQ(allocator.ReleaseEmptyBlocks(), 2u);
+	EXPECT_EQ(allocator.GetStats().blockCount, 0u);
+}
+
+TEST(GpuMemory, GivesOversizedAndStructuredBuffersDedicatedStorage)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+	renderer::SubAllocatingGPUMemoryAllocator allocator(*device, renderer::SubAllocatorDesc{ .blockSizeBytes = 4096, .alignmentBytes = 256 });
+
+	const renderer::BufferAllocation big = allocator.AllocateBuffer(GeometryDesc(8192));
+	rhi::BufferDesc structured = GeometryDesc(512, rhi::BufferBindFlag::StructuredBuffer);
+	structured.structuredStrideBytes = 64;
+	const renderer::BufferAllocation instances = allocator.AllocateBuffer(structured);
+
+	EXPECT_EQ(big.offsetBytes, 0u);
+	EXPECT_EQ(instances.offsetBytes, 0u);
+	renderer::GPUMemoryStats stats = allocator.GetStats();
+	EXPECT_EQ(stats.blockCount, 0u);
+	EXPECT_EQ(stats.dedicatedCount, 2u);
+	EXPECT_EQ(stats.dedicatedBytes, 8192u + 512u);
+
+	allocator.FreeBuffer(big);
+	allocator.FreeBuffer(instances);
+	EXPECT_EQ(allocator.GetStats().dedicatedCount, 0u);
+}
+
+TEST(GpuMemory, BlockSizeIsRoundedToUsableCapacity)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+	// 4096 + 100 bytes: only 16 whole 256-byte units fit in a block.
+	renderer::SubAllocatingGPUMemoryAllocator allocator(*device, renderer::SubAllocatorDesc{ .blockSizeBytes = 4096 + 100, .alignmentBytes = 256 });
+	EXPECT_EQ(allocator.GetDesc().blockSizeBytes, 4096u);
+
+	// A request the raw block size would have accepted no longer gets an offset the block cannot back.
+	const renderer::BufferAllocation tail = allocator.AllocateBuffer(GeometryDesc(4096 + 50));
+	EXPECT_EQ(tail.offsetBytes, 0u);
+	EXPECT_EQ(allocator.GetStats().dedicatedCount, 1u);
+	EXPECT_EQ(allocator.GetStats().blockCount, 0u);
+
+	// A request of exactly the usable capacity fills one block...
+	const renderer::BufferAllocation whole = allocator.AllocateBuffer(GeometryDesc(4096));
+	const renderer::GPUMemoryStats stats = allocator.GetStats();
+	EXPECT_EQ(stats.blockCount, 1u);
+	EXPECT_EQ(stats.usedBytes, 4096u);
+	EXPECT_EQ(whole.offsetBytes, 0u);
+
+	allocator.FreeBuffer(whole);
+	allocator.FreeBuffer(tail);
+	EXPECT_EQ(allocator.GetStats().dedicatedCount, 0u);
+	EXPECT_EQ(allocator.ReleaseEmptyBlocks(), 1u);
+
+	// ...also when the capacity is not a size-class boundary and good-fit rounding would skip its range.
+	renderer::TlsfRangeAllocator ranges(101 * 256, 256);
+	EXPECT_EQ(ranges.Allocate(101 * 256), std::optional<std::size_t>{ 0 });
+	EXPECT_FALSE(ranges.Allocate(1).has_value());
+}
@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct TestTag {};
+	using TestHandle = rhi::Handle<TestTag>;
+	using TestPool = rhi::HandlePool<TestTag, std::string>;
+}
+
+TEST(HandlePool, FindsLiveObjects)
+{
+	TestPool pool;
+	const TestHandle a = pool.Emplace("a");
+	const TestHandle b = pool.Insert("b");
+
+	ASSERT_TRUE(a);
+	ASSERT_TRUE(b);
+	EXPECT_NE(a, b);
+	ASSERT_NE(pool.Find(a), nullptr);
+	EXPECT_EQ(*pool.Find(a), "a");
+	EXPECT_EQ(*pool.Find(b), "b");
+	EXPECT_EQ(pool.Size(), 2u);
+	EXPECT_EQ(pool.Find(TestHandle{}), nullptr);
+}
+
+TEST(HandlePool, RejectsHandlesAfterDestroy)
+{
+	TestPool pool;
+	const TestHandle stale = pool.Emplace("old");
+	EXPECT_TRUE(pool.Erase(stale));
+	EXPECT_FALSE(pool.Erase(stale));
+	EXPECT_EQ(pool.Find(stale), nullptr);
+
+	// The slot is reused, but the generation differs, so the stale handle keeps missing.
+	const TestHandle fresh = pool.Emplace("new");
+	EXPECT_EQ(TestPool::IndexOf(fresh), TestPool::IndexOf(stale));
+	EXPECT_NE(fresh, stale);
+	EXPECT_EQ(pool.Find(stale), nullptr);
+	EXPECT_EQ(*pool.Find(fresh), "new");
+	EXPECT_EQ(pool.Size(), 1u);
+}
+
+TEST(HandlePool, ClearKeepsHandlesStale)
+{
+	TestPool pool;
+	const TestHandle a = pool.Emplace("a");
+	const TestHandle b = pool.Emplace("b");
+	pool.Erase(b);
+
+	pool.Clear();
+	EXPECT_TRUE(pool.Empty());
+	EXPECT_EQ(pool.Find(a), nullptr);
+
+	// The slots come back, but with new generations: nothing issued before Clear() resolves again.
+	const TestHandle c = pool.Emplace("c");
+	const TestHandle d = pool.Emplace("d");
+	EXPECT_EQ(TestPool::IndexOf(c), TestPool::IndexOf(a));
+	EXPECT_EQ(TestPool::IndexOf(d), TestPool::IndexOf(b));
+	EXPECT_NE(c, a);
+	EXPECT_NE(d, b);
+	EXPECT_EQ(pool.Find(a), nullptr);
+	EXPECT_EQ(pool.Find(b), nullptr);
+	EXPECT_EQ(*pool.Find(c), "c");
+}
+
+TEST(HandlePool, RetiresSlotsInsteadOfWrappingTheGeneration)
+{
+	TestPool pool;
+	const TestHandle first = pool.Emplace("first");
+	TestHandle current = first;
+	std::uint32_t reuses = 0;
+	while (TestPool::IndexOf(current) == TestPool::IndexOf(first))
+	{
+		EXPECT_TRUE(pool.Erase(current));
+		current = pool.Emplace("again");
+		++reuses;
+		ASSERT_LE(reuses, TestPool::kGenerationMask);
+	}
+
+	// Every generation of slot 0 was used once; then the slot was retired and a new one taken.
+	EXPECT_EQ(reuses, TestPool::kGenerationMask);
+	EXPECT_EQ(pool.RetiredSlots(), 1u);
+	EXPECT_EQ(pool.Find(first), nullptr);
+	EXPECT_EQ(*pool.Find(current), "again");
+
+	// A retired slot stays retired across Clear().
+	pool.Clear();
+	EXPECT_NE(TestPool::IndexOf(pool.Emplace("after clear")), TestPool::IndexOf(first));
+}
+
+TEST(HandlePool, KeepsReferencesStableWhileGrowing)
+{
+	TestPool pool;
+	const TestHandle first = pool.Emplace("first");
+	const std::string* firstAddress = pool.Find(first);
+
+	std::vector<TestHandle> handles;
+	for (int i = 0; i < 2000; ++i)
+	{
+		handles.push_back(pool.Emplace(std::to_string(i)));
+	}
+
+	EXPECT_EQ(pool.Find(first), firstAddress);
+	EXPECT_EQ(*pool.Find(handles[1234]), "1234");
+
+	std::size_t visited = 0;
+	pool.ForEach([&visited](TestHandle, std::string&) { ++visited; });
+	EXPECT_EQ(visited, 2001u);
+}
+
+TEST(HandlePool, NullDeviceRejectsDestroyedFences)
+{
+	std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+	const rhi::FenceHandle fence = device->CreateFence(false);
+	EXPECT_FALSE(device->IsFenceSignaled(fence));
+	device->SignalFence(fence);
+	EXPECT_TRUE(device->IsFenceSignaled(fence));
+
+	device->DestroyFence(fence);
+	const rhi::FenceHandle reused = device->CreateFence(false);
+	EXPECT_NE(reused, fence);
+	EXPECT_FALSE(device->IsFenceSignaled(reused));
+
+	// Signalling the stale handle must not touch the fence that reuses its slot.
+	device->SignalFence(fence);
+	EXPECT_FALSE(device->IsFenceSignaled(reused));
+}
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+import core;
+
+namespace
+{
+	rhi::BufferHandle CreateBuffer(rhi::IRHIDevice& device, rhi::BufferBindFlag bindFlag, std::size_t sizeInBytes)
+	{
+		rhi::BufferDesc desc{};
+		desc.bindFlag = bindFlag;
+		desc.sizeInBytes = sizeInBytes;
+		return device.CreateBuffer(desc);
+	}
+
+	// Sorted batches as a renderer would produce them: two meshes that live in one shared buffer (state 1)
+	// and one that needs its own bindings (state 2).
+	rhi::IndirectDrawBuilder BuildSortedBatches()
+	{
+		rhi::IndirectDrawBuilder builder;
+		builder.Add(1, rhi::DrawIndexedIndirectArgs{ .indexCount = 36, .instanceCount = 4, .firstIndex = 0, .baseVertex = 0, .firstInstance = 0 });
+		builder.Add(1, rhi::DrawIndexedIndirectArgs{ .indexCount = 36, .instanceCount = 2, .firstIndex = 0, .baseVertex = 0, .firstInstance = 4 });
+		builder.Add(1, rhi::DrawIndexedIndirectArgs{ .indexCount = 60, .instanceCount = 1, .firstIndex = 36, .baseVertex = 24, .firstInstance = 6 });
+		builder.Add(1, rhi::DrawIndexedIndirectArgs{ .indexCount = 0, .instanceCount = 5 });
+		builder.Add(2, rhi::DrawIndexedIndirectArgs{ .indexCount = 6, .instanceCount = 3, .firstIndex = 0, .baseVertex = 0, .firstInstance = 7 });
+		return builder;
+	}
+}
+
+TEST(IndirectDraw, BuilderCollapsesSortedBatchesIntoRuns)
+{
+	const rhi::IndirectDrawBuilder builder = BuildSortedBatches();
+
+	// The second batch continues the first one's instances and is folded into it; the empty one is dropped.
+	ASSERT_EQ(builder.Args().size(), 3u);
+	EXPECT_EQ(builder.Args()[0].instanceCount, 6u);
+	EXPECT_EQ(builder.MergedDraws(), 1u);
+	EXPECT_EQ(builder.Bytes().size(), 3u * sizeof(rhi::DrawIndexedIndirectArgs));
+
+	ASSERT_EQ(builder.Runs().size(), 2u);
+	EXPECT_EQ(builder.Runs()[0].firstDraw, 0u);
+	EXPECT_EQ(builder.Runs()[0].drawCount, 2u);
+	EXPECT_EQ(builder.Runs()[1].stateKey, 2u);
+	EXPECT_EQ(builder.Runs()[1].firstDraw, 2u);
+
+	rhi::CommandList list;
+	const rhi::BufferHandle args{ 7 };
+	for (const rhi::IndirectDrawRun& run : builder.Runs())
+	{
+		builder.RecordRun(list, run, rhi::IndexType::UINT32, args, 64);
+	}
+	std::vector<rhi::CommandDrawIndexedIndirect> recorded;
+	for (const rhi::CommandRecord& record : list)
+	{
+		rhi::VisitCommand(record, [&recorded]<typename T>(const T& cmd)
+			{
+				if constexpr (std::is_same_v<T, rhi::CommandDrawIndexedIndirect>)
+				{
+					recorded.push_back(cmd);
+				}
+			});
+	}
+	ASSERT_EQ(recorded.size(), 2u);
+	EXPECT_EQ(recorded[0].drawCount, 2u);
+	EXPECT_EQ(recorded[0].argsOffsetBytes, 64u);
+	EXPECT_EQ(recorded[1].argsOffsetBytes, 64u + 2u * sizeof(rhi::DrawIndexedIndirectArgs));
+	EXPECT_EQ(recorded[1].argsBuffer, args);
+
+	// Indirect draws read the constants that precede them, so the optimizer must keep those.
+	rhi::CommandList withConstants;
+	const std::uint32_t value = 5;
+	withConstants.SetConstants(0, std::as_bytes(std::span{ &value, 1 }));
+	withConstants.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, args, 2);
+	withConstants.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, args, 0);
+	rhi::CommandList optimized;
+	const rhi::CommandListOptimizeStats stats = rhi::OptimizeCommandList(withConstants, optimized);
+	EXPECT_EQ(stats.inputCommands, 2u);
+	EXPECT_EQ(stats.outputCommands, 2u);
+}
+
+TEST(IndirectDraw, NullDeviceValidatesArgumentBuffers)
+{
+	rhi::NullDevice device;
+	const rhi::IndirectDrawBuilder builder = BuildSortedBatches();
+	const rhi::BufferHandle indices = CreateBuffer(device, rhi::BufferBindFlag::IndexBuffer, 96 * sizeof(std::uint32_t));
+	const rhi::BufferHandle args = CreateBuffer(device, rhi::BufferBindFlag::IndirectArgs, builder.Bytes().size());
+	const rhi::BufferHandle vertices = CreateBuffer(device, rhi::BufferBindFlag::VertexBuffer, 1024);
+	device.UpdateBuffer(args, builder.Bytes());
+
+	const auto Submit = [&device, indices](auto&& recordDraws, rhi::IndexType indexType = rhi::IndexType::UINT32, std::uint32_t ibOffset = 0)
+		{
+			rhi::CommandList list;
+			list.BindIndexBuffer(indices, indexType, ibOffset);
+			recordDraws(list);
+			device.SubmitCommandList(std::move(list));
+		};
+
+	Submit([&](rhi::CommandList& list) { builder.RecordRun(list, builder.Runs()[0], rhi::IndexType::UINT32, args); });
+	Submit([&](rhi::CommandList& list) { list.DrawIndexedIndirect(rhi::IndexType::UINT32, args, 2 * sizeof(rhi::DrawIndexedIndirectArgs)); });
+	EXPECT_EQ(device.GetIndirectDrawStats().commands, 2u);
+	EXPECT_EQ(device.GetIndirectDrawStats().draws, 3u);
+
+	// Reads past the end of the argument buffer.
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, args, 4); }), std::runtime_error);
+	// Misaligned offset / stride smaller than a record.
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.DrawIndexedIndirect(rhi::IndexType::UINT32, args, 2); }), std::runtime_error);
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, args, 2, 0, 16); }), std::runtime_error);
+	// Not an IndirectArgs buffer, or destroyed.
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.DrawIndexedIndirect(rhi::IndexType::UINT32, vertices); }), std::runtime_error);
+	// Index type differs from the bound index buffer.
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.DrawIndexedIndirect(rhi::IndexType::UINT16, args); }, rhi::IndexType::UINT32), std::runtime_error);
+	// A record whose index range runs past the bound index buffer (offset eats 8 of the 96 indices).
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, args, 2); }, rhi::IndexType::UINT32, 8 * sizeof(std::uint32_t)),
+		std::runtime_error);
+	// No index buffer at all.
+	{
+		rhi::CommandList list;
+		list.DrawIndexedIndirect(rhi::IndexType::UINT32, args);
+		EXPECT_THROW(device.SubmitCommandList(std::move(list)), std::runtime_error);
+	}
+	EXPECT_THROW(device.UpdateBuffer(args, builder.Bytes(), sizeof(rhi::DrawIndexedIndirectArgs)), std::runtime_error);
+
+	device.DestroyBuffer(args);
+	EXPECT_THROW(Submit([&](rhi::CommandList& list) { list.DrawIndexedIndirect(rhi::IndexType::UINT32, args); }), std::runtime_error);
+	EXPECT_EQ(device.GetIndirectDrawStats().commands, 2u);
+}
+
+TEST(IndirectDraw, CaptureReplaysIndirectDrawsAgainstRemappedBuffers)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+
+	// Shift the recorded buffer ids so the replay target hands out different ones.
+	rhi::NullDevice target;
+	CreateBuffer(target, rhi::BufferBindFlag::VertexBuffer, 16);
+	CreateBuffer(target, rhi::BufferBindFlag::VertexBuffer, 16);
+
+	const rhi::IndirectDrawBuilder builder = BuildSortedBatches();
+	const rhi::BufferHandle indices = CreateBuffer(recorder, rhi::BufferBindFlag::IndexBuffer, 96 * sizeof(std::uint32_t));
+	const rhi::BufferHandle args = CreateBuffer(recorder, rhi::BufferBindFlag::IndirectArgs, builder.Bytes().size());
+	recorder.UpdateBuffer(args, builder.Bytes());
+
+	rhi::CommandList list;
+	list.BindIndexBuffer(indices, rhi::IndexType::UINT32);
+	for (const rhi::IndirectDrawRun& run : builder.Runs())
+	{
+		builder.RecordRun(list, run, rhi::IndexType::UINT32, args);
+	}
+	recorder.SubmitCommandList(std::move(list));
+	EXPECT_EQ(recorder.GetIndirectDrawStats().draws, 3u);
+
+	// The recording device refuses to capture an indirect draw it could not replay.
+	rhi::CommandList invalid;
+	invalid.BindIndexBuffer(indices, rhi::IndexType::UINT32);
+	invalid.MultiDrawIndexedIndirect(rhi::IndexType::UINT32, indices, 1);
+	EXPECT_THROW(recorder.SubmitCommandList(std::move(invalid)), std::runtime_error);
+
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(target, rhi::SwapChainDesc{});
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(target, *swapChain);
+	EXPECT_EQ(stats.submits, 1u);
+	EXPECT_EQ(stats.draws, 3u);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::DrawIndexedIndirect), 2u);
+	EXPECT_EQ(target.GetIndirectDrawStats().commands, 2u);
+	EXPECT_EQ(target.GetIndirectDrawStats().draws, 3u);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct Row
+	{
+		float value[4]{};
+	};
+
+	Row MakeRow(float v)
+	{
+		return Row{ { v, v, v, v } };
+	}
+
+	std::span<const rendern::InstanceRange> Pack(rendern::PersistentInstanceStream<Row>& stream, const std::vector<float>& values)
+	{
+		const std::span<Row> rows = stream.BeginFrame(values.size());
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			rows[i] = MakeRow(values[i]);
+		}
+		return stream.Commit();
+	}
+}
+
+TEST(InstanceStream, StaticFramesUploadNothingAfterTheFirst)
+{
+	rendern::PersistentInstanceStream<Row> stream;
+	const std::vector<float> level{ 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	const auto first = Pack(stream, level);
+	ASSERT_EQ(first.size(), 1u);
+	EXPECT_EQ(first[0].first, 0u);
+	EXPECT_EQ(first[0].count, 8u);
+
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		EXPECT_TRUE(Pack(stream, level).empty());
+		EXPECT_EQ(stream.GetStats().uploadedBytes, 0u);
+		EXPECT_EQ(stream.GetStats().skippedBytes, 8u * sizeof(Row));
+	}
+
+	// A recreated GPU buffer has no valid contents: everything goes up again.
+	stream.Invalidate();
+	EXPECT_EQ(Pack(stream, level).size(), 1u);
+	EXPECT_EQ(stream.GetStats().dirtyRows, 8u);
+}
+
+TEST(InstanceStream, DirtyRowsCoalesceIntoFewRanges)
+{
+	rendern::PersistentInstanceStream<Row> stream(rendern::PersistentInstanceStreamDesc{ .mergeGapRows = 2, .maxRanges = 3 });
+	std::vector<float> values(32, 1.0f);
+	Pack(stream, values);
+
+	// Rows 3 and 5 are two apart: one range. Row 20 stands alone. Growing to 34 rows adds a tail range.
+	values[3] = 2.0f;
+	values[5] = 2.0f;
+	values[20] = 2.0f;
+	values.push_back(3.0f);
+	values.push_back(3.0f);
+	const auto ranges = Pack(stream, values);
+	ASSERT_EQ(ranges.size(), 3u);
+	EXPECT_EQ(ranges[0].first, 3u);
+	EXPECT_EQ(ranges[0].count, 3u);
+	EXPECT_EQ(ranges[1].first, 20u);
+	EXPECT_EQ(ranges[1].count, 1u);
+	EXPECT_EQ(ranges[2].first, 32u);
+	EXPECT_EQ(ranges[2].count, 2u);
+	EXPECT_EQ(stream.GetStats().dirtyRows, 5u);
+	EXPECT_EQ(stream.GetStats().uploadedBytes, 6u * sizeof(Row));
+	EXPECT_EQ(stream.Rows()[4].value[0], 1.0f);
+	EXPECT_EQ(stream.Rows()[33].value[0], 3.0f);
+
+	// Past maxRanges the ranges collapse into one copy spanning all of them.
+	for (std::size_t i = 0; i < values.size(); i += 8)
+	{
+		values[i] = 4.0f;
+	}
+	const auto collapsed = Pack(stream, values);
+	ASSERT_EQ(collapsed.size(), 1u);
+	EXPECT_EQ(collapsed[0].first, 0u);
+	EXPECT_EQ(collapsed[0].count, 33u);
+
+	// Shrinking uploads nothing: rows past the new count are simply no longer drawn.
+	values.resize(16);
+	EXPECT_TRUE(Pack(stream, values).empty());
+	EXPECT_EQ(stream.Rows().size(), 16u);
+}
+
+TEST(InstanceStream, SlotCacheRebuildsOnlyChangedKeys)
+{
+	rendern::InstanceSlotCache<rendern::Transform, mathUtils::Mat4> cache;
+	std::vector<rendern::Transform> transforms(4);
+	for (std::size_t i = 0; i < transforms.size(); ++i)
+	{
+		transforms[i].position = mathUtils::Vec3(static_cast<float>(i), 0.0f, 0.0f);
+	}
+
+	int builds = 0;
+	auto Frame = [&]()
+		{
+			cache.BeginFrame(transforms.size());
+			for (std::size_t i = 0; i < transforms.size(); ++i)
+			{
+				const mathUtils::Mat4& model = cache.Get(i, transforms[i], [&] { ++builds; return transforms[i].ToMatrix(); });
+				EXPECT_EQ(model, transforms[i].ToMatrix());
+			}
+		};
+
+	Frame();
+	EXPECT_EQ(builds, 4);
+	Frame();
+	EXPECT_EQ(builds, 4);
+	EXPECT_EQ(cache.GetStats().reused, 4u);
+
+	transforms[2].rotationDegrees.y = 45.0f;
+	Frame();
+	EXPECT_EQ(builds, 5);
+	EXPECT_EQ(cache.GetStats().rebuilt, 1u);
+	EXPECT_EQ(cache.GetStats().reused, 3u);
+
+	cache.Invalidate();
+	Frame();
+	EXPECT_EQ(builds, 9);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// Camera at the origin looking down -Z; 256x128 buffer, so a 2:1 aspect.
+	mathUtils::Mat4 CameraViewProj()
+	{
+		const mathUtils::Mat4 proj = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(60.0f), 2.0f, 0.1f, 200.0f);
+		const mathUtils::Mat4 view = mathUtils::LookAt(mathUtils::Vec3{ 0.0f, 0.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 0.0f, -1.0f }, mathUtils::Vec3{ 0.0f, 1.0f, 0.0f });
+		return proj * view;
+	}
+
+	// Unit quad in the XY plane, counter-clockwise when seen from +Z.
+	const std::array<mathUtils::Vec3, 4> kQuad{
+		mathUtils::Vec3{ -0.5f, -0.5f, 0.0f },
+		mathUtils::Vec3{ 0.5f, -0.5f, 0.0f },
+		mathUtils::Vec3{ 0.5f, 0.5f, 0.0f },
+		mathUtils::Vec3{ -0.5f, 0.5f, 0.0f } };
+	const std::array<std::uint32_t, 6> kQuadFront{ 0, 1, 2, 0, 2, 3 };
+	const std::array<std::uint32_t, 6> kQuadBack{ 0, 2, 1, 0, 3, 2 };
+
+	mathUtils::Mat4 WallModel(const mathUtils::Vec3& center, float width, float height)
+	{
+		mathUtils::Mat4 model{ 1.0f };
+		model[0].x = width;
+		model[1].y = height;
+		model[3] = mathUtils::Vec4(center, 1.0f);
+		return model;
+	}
+
+	rendern::Aabb Box(const mathUtils::Vec3& center, float halfExtent)
+	{
+		const mathUtils::Vec3 half{ halfExtent, halfExtent, halfExtent };
+		return rendern::Aabb{ center - half, center + half };
+	}
+}
+
+TEST(OcclusionCulling, WallHidesBoxesBehindIt)
+{
+	rendern::SoftwareOcclusionCuller culler;
+	culler.BeginFrame(CameraViewProj());
+	culler.AddOccluder(kQuad, kQuadFront, WallModel({ 0.0f, 0.0f, -10.0f }, 10.0f, 6.0f), { 0.0f, 0.0f, -10.0f }, 6.0f);
+	culler.RasterizeOccluders(8);
+
+	EXPECT_FALSE(culler.IsVisible(Box({ 0.0f, 0.0f, -20.0f }, 1.0f)));
+	EXPECT_FALSE(culler.IsVisible(Box({ 7.0f, 3.0f, -30.0f }, 1.0f)));
+	// In front of the wall, straddling the near plane, or peeking past its edge.
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, 0.0f, -5.0f }, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, 0.0f, 0.0f }, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box({ 11.0f, 0.0f, -20.0f }, 1.0f)));
+	// Poking through the wall from behind.
+	EXPECT_TRUE(culler.IsVisible(rendern::Aabb{ { -1.0f, -1.0f, -12.0f }, { 1.0f, 1.0f, -9.9f } }));
+
+	const rendern::OcclusionCullingStats& stats = culler.GetStats();
+	EXPECT_EQ(stats.occluderCandidates, 1u);
+	EXPECT_EQ(stats.occludersRasterized, 1u);
+	EXPECT_EQ(stats.trianglesRasterized, 2u);
+}
+
+TEST(OcclusionCulling, BackFacesAndUnselectedOccludersDoNotOcclude)
+{
+	rendern::SoftwareOcclusionCuller culler;
+	culler.BeginFrame(CameraViewProj());
+	culler.AddOccluder(kQuad, kQuadBack, WallModel({ 0.0f, 0.0f, -10.0f }, 10.0f, 6.0f), { 0.0f, 0.0f, -10.0f }, 6.0f);
+	culler.RasterizeOccluders(8);
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, 0.0f, -20.0f }, 1.0f)));
+
+	// Only one occluder fits: the forced small one wins over the large unflagged one.
+	culler.BeginFrame(CameraViewProj());
+	culler.AddOccluder(kQuad, kQuadFront, WallModel({ 0.0f, 0.0f, -10.0f }, 40.0f, 20.0f), { 0.0f, 0.0f, -10.0f }, 22.0f);
+	culler.AddOccluder(kQuad, kQuadFront, WallModel({ 20.0f, 0.0f, -40.0f }, 4.0f, 4.0f), { 20.0f, 0.0f, -40.0f }, 3.0f, true);
+	culler.RasterizeOccluders(1);
+	EXPECT_EQ(culler.GetStats().occluderCandidates, 2u);
+	EXPECT_EQ(culler.GetStats().occludersRasterized, 1u);
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, 0.0f, -20.0f }, 1.0f)));
+	EXPECT_FALSE(culler.IsVisible(Box({ 30.0f, 0.0f, -60.0f }, 0.5f)));
+}
+
+TEST(OcclusionCulling, ClipsOccludersAtTheNearPlane)
+{
+	// Floor from behind the camera to far ahead, one unit below the eye, facing up.
+	const std::array<mathUtils::Vec3, 4> floor{
+		mathUtils::Vec3{ -100.0f, -1.0f, 10.0f },
+		mathUtils::Vec3{ 100.0f, -1.0f, 10.0f },
+		mathUtils::Vec3{ 100.0f, -1.0f, -150.0f },
+		mathUtils::Vec3{ -100.0f, -1.0f, -150.0f } };
+
+	rendern::SoftwareOcclusionCuller culler;
+	culler.BeginFrame(CameraViewProj());
+	culler.AddOccluder(floor, kQuadFront, mathUtils::Mat4{ 1.0f }, { 0.0f, -1.0f, -70.0f }, 130.0f);
+	culler.RasterizeOccluders(8);
+
+	EXPECT_GT(culler.GetStats().trianglesRasterized, 2u);
+	EXPECT_FALSE(culler.IsVisible(Box({ 0.0f, -4.0f, -20.0f }, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, 1.0f, -20.0f }, 1.0f)));
+	EXPECT_TRUE(culler.IsVisible(Box({ 0.0f, -1.0f, -20.0f }, 1.0f)));
+}
+
+TEST(OcclusionCulling, ParallelTestingMatchesSerialQueries)
+{
+	rendern::SoftwareOcclusionCuller culler;
+	rendern::JobSystemThreadPool jobs(3);
+	culler.SetJobSystem(&jobs, 3);
+	culler.BeginFrame(CameraViewProj());
+	for (int i = 0; i < 6; ++i)
+	{
+		const mathUtils::Vec3 center{ -15.0f + 6.0f * static_cast<float>(i), 0.0f, -12.0f - 2.0f * static_cast<float>(i) };
+		culler.AddOccluder(kQuad, kQuadFront, WallModel(center, 5.0f, 8.0f), center, 5.0f);
+	}
+	culler.RasterizeOccluders(6);
+
+	std::mt19937 rng(3u);
+	std::uniform_real_distribution<float> lateral(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> depth(-60.0f, -2.0f);
+	std::vector<rendern::Aabb> boxes;
+	for (int i = 0; i < 1000; ++i)
+	{
+		boxes.push_back(Box({ lateral(rng), lateral(rng) * 0.3f, depth(rng) }, 0.5f));
+	}
+
+	std::vector<std::uint8_t> visible(boxes.size());
+	culler.TestVisibility(boxes, visible);
+
+	std::uint32_t culled = 0;
+	for (std::size_t i = 0; i < boxes.size(); ++i)
+	{
+		EXPECT_EQ(visible[i] != 0u, culler.IsVisible(boxes[i]));
+		culled += visible[i] ? 0u : 1u;
+	}
+	EXPECT_GT(culled, 0u);
+	EXPECT_LT(culled, boxes.size());
+	EXPECT_EQ(culler.GetStats().objectsTested, boxes.size());
+	EXPECT_EQ(culler.GetStats().objectsCulled, culled);
+
+	std::vector<std::uint8_t> small(1);
+	EXPECT_THROW(culler.TestVisibility(boxes, small), std::runtime_error);
+	EXPECT_THROW(rendern::SoftwareOcclusionCuller(0, 64), std::runtime_error);
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// Startup-shaped workload: a handful of shader pairs, one pipeline each.
+	void CreatePipelines(rhi::IRHIDevice& device, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			const std::string index = std::to_string(i);
+			const rhi::ShaderHandle vs = device.CreateShader(rhi::ShaderStage::Vertex, "VS_" + index, "float4 main() : SV_Position { return " + index + "; }");
+			const rhi::ShaderHandle ps = device.CreateShader(rhi::ShaderStage::Pixel, "PS_" + index, "float4 main() : SV_Target { return " + index + "; }");
+			device.CreatePipeline("PSO_" + index, vs, ps);
+		}
+	}
+}
+
+TEST(PipelineCache, KeysFollowContentNotIdentity)
+{
+	rhi::GraphicsState opaque{};
+	rhi::GraphicsState blended{};
+	blended.blend.enable = true;
+
+	const auto Key = [](const rhi::GraphicsState& state)
+		{
+			return rhi::PipelineKeyHasher{}.Add(std::string_view("bytecode")).Add(state).Value();
+		};
+	EXPECT_EQ(Key(opaque), Key(rhi::GraphicsState{}));
+	EXPECT_NE(Key(opaque), Key(blended));
+
+	rhi::InputLayoutDesc layout{};
+	layout.strideBytes = 32;
+	layout.attributes.push_back({ rhi::VertexSemantic::Position, 0, rhi::VertexFormat::R32G32B32_FLOAT, 0, 0, false });
+	rhi::InputLayoutDesc renamed = layout;
+	renamed.debugName = "OnlyTheNameDiffers";
+	rhi::InputLayoutDesc wider = layout;
+	wider.strideBytes = 48;
+	EXPECT_EQ(rhi::PipelineKeyHasher{}.Add(layout).Value(), rhi::PipelineKeyHasher{}.Add(renamed).Value());
+	EXPECT_NE(rhi::PipelineKeyHasher{}.Add(layout).Value(), rhi::PipelineKeyHasher{}.Add(wider).Value());
+}
+
+TEST(PipelineCache, SerializedCacheRoundTripsAndRejectsForeignData)
+{
+	rhi::PipelineCache cache(rhi::Backend::DirectX12);
+	const std::array<std::byte, 3> blob{ std::byte{ 1 }, std::byte{ 2 }, std::byte{ 3 } };
+	cache.Store(42, blob);
+	cache.Store(7, std::span<const std::byte>{});
+	EXPECT_TRUE(cache.IsDirty());
+
+	const std::vector<std::byte> bytes = cache.Serialize();
+	EXPECT_FALSE(cache.IsDirty());
+
+	rhi::PipelineCache loaded(rhi::Backend::DirectX12);
+	ASSERT_TRUE(loaded.Deserialize(bytes));
+	EXPECT_EQ(loaded.GetStats().loadedEntries, 2u);
+	EXPECT_EQ(loaded.GetStats().blobBytes, 3u);
+	const std::vector<std::byte>* found = loaded.Find(42);
+	ASSERT_NE(found, nullptr);
+	EXPECT_EQ(found->size(), 3u);
+	EXPECT_EQ((*found)[2], std::byte{ 3 });
+	EXPECT_EQ(loaded.Find(1234), nullptr);
+	EXPECT_EQ(loaded.GetStats().hits, 1u);
+	EXPECT_EQ(loaded.GetStats().misses, 1u);
+
+	loaded.Reject(42);
+	EXPECT_EQ(loaded.Find(42), nullptr);
+	EXPECT_EQ(loaded.GetStats().rejected, 1u);
+	EXPECT_TRUE(loaded.IsDirty());
+
+	// Another backend's file or a truncated one is a cold start, never a partial load.
+	rhi::PipelineCache otherBackend(rhi::Backend::OpenGL);
+	EXPECT_FALSE(otherBackend.Deserialize(bytes));
+	EXPECT_EQ(otherBackend.GetStats().entries, 0u);
+
+	rhi::PipelineCache truncated(rhi::Backend::DirectX12);
+	EXPECT_FALSE(truncated.Deserialize(std::span(bytes).first(bytes.size() - 1)));
+	EXPECT_EQ(truncated.GetStats().entries, 0u);
+}
+
+TEST(PipelineCache, WarmReplaySkipsEveryCompile)
+{
+	constexpr int kPipelines = 6;
+
+	// Cold launch, recorded.
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	rhi::PipelineCache coldCache(rhi::Backend::Null);
+	recorder.SetPipelineCache(&coldCache);
+	CreatePipelines(recorder, kPipelines);
+	EXPECT_EQ(coldCache.GetStats().misses, static_cast<std::uint64_t>(kPipelines));
+	EXPECT_EQ(coldCache.GetStats().hits, 0u);
+	EXPECT_EQ(coldCache.GetStats().entries, static_cast<std::size_t>(kPipelines));
+
+	// Second launch: same startup replayed against a device whose cache came from disk.
+	rhi::PipelineCache warmCache(rhi::Backend::Null);
+	ASSERT_TRUE(warmCache.Deserialize(coldCache.Serialize()));
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+	target->SetPipelineCache(&warmCache);
+
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *swapChain);
+	EXPECT_EQ(stats.resourcesCreated, static_cast<std::uint64_t>(kPipelines * 3));
+	EXPECT_GE(stats.pipelineCreateMs, 0.0);
+	EXPECT_EQ(warmCache.GetStats().hits, static_cast<std::uint64_t>(kPipelines));
+	EXPECT_EQ(warmCache.GetStats().misses, 0u);
+	EXPECT_FALSE(warmCache.IsDirty());
+}
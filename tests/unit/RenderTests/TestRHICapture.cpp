@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+import core;
+
+namespace
+{
+	// Records one frame: a vertex buffer upload and three draws into the backbuffer.
+	void RecordFrame(rhi::IRHIDevice& device)
+	{
+		rhi::BufferDesc desc{};
+		desc.bindFlag = rhi::BufferBindFlag::VertexBuffer;
+		desc.sizeInBytes = 256;
+		desc.debugName = "CaptureVB";
+		const rhi::BufferHandle vb = device.CreateBuffer(desc);
+
+		const std::array<float, 12> vertices{};
+		device.UpdateBuffer(vb, std::as_bytes(std::span{ vertices }));
+
+		const rhi::TextureHandle albedo = device.CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+
+		rhi::CommandList list{};
+		list.BeginPass(rhi::BeginPassDesc{});
+		list.BindVertexBuffer(0, vb, 12);
+		list.BindTexture2D(0, albedo);
+		list.SetUniformInt("uFlags", 3);
+		const std::array<float, 4> constants{ 1.0f, 2.0f, 3.0f, 4.0f };
+		list.SetConstants(0, std::as_bytes(std::span{ constants }));
+		list.Draw(3);
+		list.Draw(3, 0, 2);
+		list.DrawIndexed(6, rhi::IndexType::UINT16);
+		list.EndPass();
+		device.SubmitCommandList(std::move(list));
+	}
+}
+
+TEST(RHICapture, ReplayReportsCountsAndUploads)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	RecordFrame(recorder);
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *swapChain);
+
+	EXPECT_EQ(stats.resourcesCreated, 2u);
+	EXPECT_EQ(stats.bufferUpdates, 1u);
+	EXPECT_EQ(stats.uploadBytes, sizeof(float) * 12);
+	EXPECT_EQ(stats.submits, 1u);
+	EXPECT_EQ(stats.commands, 9u);
+	EXPECT_EQ(stats.draws, 3u);
+	EXPECT_EQ(stats.instances, 4u);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::Draw), 2u);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::DrawIndexed), 1u);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::SetConstants), 1u);
+
+	ASSERT_EQ(stats.perSubmit.size(), 1u);
+	EXPECT_EQ(stats.perSubmit[0].draws, 3u);
+	EXPECT_EQ(stats.perSubmit[0].uploadBytes, sizeof(float) * 12);
+}
+
+TEST(RHICapture, TargetTimeIsSplitByCommandType)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	RecordFrame(recorder);
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *swapChain, rhi::CaptureReplayOptions{ .timeTargetCommandTypes = true });
+
+	// 9 commands; the two back-to-back Draws share one run.
+	ASSERT_EQ(stats.perSubmit.size(), 1u);
+	EXPECT_EQ(stats.perSubmit[0].targetRuns, 8u);
+	EXPECT_EQ(stats.commands, 9u);
+	EXPECT_EQ(stats.draws, 3u);
+
+	std::uint64_t targetNanoseconds = 0;
+	for (std::size_t type = 0; type < stats.targetCommandNanoseconds.size(); ++type)
+	{
+		targetNanoseconds += stats.targetCommandNanoseconds[type];
+		if (stats.commandCounts[type] == 0)
+		{
+			EXPECT_EQ(stats.targetCommandNanoseconds[type], 0u);
+		}
+	}
+	EXPECT_GT(targetNanoseconds, 0u);
+	EXPECT_GT(stats.perSubmit[0].submitMs, 0.0);
+}
+
+TEST(RHICapture, FileRoundTripReplaysIdentically)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	RecordFrame(recorder);
+	RecordFrame(recorder);
+
+	const std::filesystem::path path = std::filesystem::temp_directory_path() / "CoreEngineModule_TestRHICapture.rhicap";
+	recorder.SaveCapture(path);
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+
+	rhi::CaptureReplayer replayer = rhi::CaptureReplayer::FromFile(path);
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *swapChain);
+	std::filesystem::remove(path);
+
+	EXPECT_EQ(stats.submits, 2u);
+	EXPECT_EQ(stats.draws, 6u);
+	EXPECT_EQ(stats.resourcesCreated, 4u);
+}
+
+TEST(RHICapture, RejectsForeignData)
+{
+	std::vector<std::byte> garbage(64, std::byte{ 0x5A });
+	EXPECT_THROW(rhi::CaptureReplayer{ garbage }, std::runtime_error);
+}
+
+TEST(RHICapture, RejectsCorruptOrTruncatedCommandStreams)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	RecordFrame(recorder);
+	const std::vector<std::byte>& bytes = recorder.GetCaptureBytes();
+
+	// The SetConstants tail (four floats) directly follows its { slot, size } record.
+	const std::array<float, 4> constants{ 1.0f, 2.0f, 3.0f, 4.0f };
+	const auto pattern = std::as_bytes(std::span{ constants });
+	const auto tail = std::search(bytes.begin(), bytes.end(), pattern.begin(), pattern.end());
+	ASSERT_NE(tail, bytes.end());
+	const std::size_t sizeField = static_cast<std::size_t>(tail - bytes.begin()) - sizeof(std::uint32_t);
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+	auto ReplayWithConstantsSize = [&](std::uint32_t size)
+		{
+			std::vector<std::byte> corrupt = bytes;
+			std::memcpy(corrupt.data() + sizeField, &size, sizeof(size));
+			rhi::CaptureReplayer replayer(std::move(corrupt));
+			replayer.Replay(*target, *swapChain);
+		};
+	EXPECT_NO_THROW(ReplayWithConstantsSize(16));
+	// Larger than any constant block, and larger than the bytes the record actually carries.
+	EXPECT_THROW(ReplayWithConstantsSize(4096), std::runtime_error);
+	EXPECT_THROW(ReplayWithConstantsSize(64), std::runtime_error);
+
+	// Cut inside the command stream.
+	std::vector<std::byte> truncated(bytes.begin(), tail);
+	rhi::CaptureReplayer replayer(std::move(truncated));
+	EXPECT_THROW(replayer.Replay(*target, *swapChain), std::runtime_error);
+}
+
+TEST(RHICapture, OptimizedReplayDropsRedundantCommands)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::RecordingDevice recorder(*inner);
+	RecordFrame(recorder);
+
+	// A typical per-draw loop that re-binds the same material every time.
+	const rhi::PipelineHandle pso = recorder.CreatePipeline("Redundant", rhi::ShaderHandle{}, rhi::ShaderHandle{});
+	rhi::CommandList list{};
+	list.BeginPass(rhi::BeginPassDesc{});
+	for (int draw = 0; draw < 4; ++draw)
+	{
+		list.SetState(rhi::GraphicsState{});
+		list.BindPipeline(pso);
+		list.DrawIndexed(6, rhi::IndexType::UINT16);
+	}
+	list.EndPass();
+	recorder.SubmitCommandList(std::move(list));
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*target, rhi::SwapChainDesc{});
+
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *swapChain, rhi::CaptureReplayOptions{ .optimizeCommandLists = true });
+
+	ASSERT_EQ(stats.perSubmit.size(), 2u);
+	EXPECT_EQ(stats.perSubmit[0].removedCommands, 0u);
+	EXPECT_EQ(stats.perSubmit[1].removedCommands, 6u);
+	EXPECT_EQ(stats.removedCommands, 6u);
+	EXPECT_EQ(stats.draws, 7u);
+}
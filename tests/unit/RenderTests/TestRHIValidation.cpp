@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+
+import core;
+
+namespace
+{
+	// Minimal mesh + pipeline set up through the validating device.
+	struct Scene
+	{
+		rhi::PipelineHandle pipeline{};
+		rhi::InputLayoutHandle layout{};
+		rhi::BufferHandle vb{};
+		rhi::BufferHandle ib{};
+	};
+
+	Scene CreateScene(rhi::IRHIDevice& device)
+	{
+		Scene scene{};
+		const rhi::ShaderHandle vs = device.CreateShader(rhi::ShaderStage::Vertex, "VS", "");
+		const rhi::ShaderHandle ps = device.CreateShader(rhi::ShaderStage::Pixel, "PS", "");
+		scene.pipeline = device.CreatePipeline("Validation", vs, ps);
+
+		rhi::InputLayoutDesc layoutDesc{};
+		layoutDesc.attributes = { rhi::VertexAttributeDesc{ .semantic = rhi::VertexSemantic::Position, .format = rhi::VertexFormat::R32G32B32_FLOAT } };
+		layoutDesc.strideBytes = 12;
+		scene.layout = device.CreateInputLayout(layoutDesc);
+
+		scene.vb = device.CreateBuffer(rhi::BufferDesc{ .bindFlag = rhi::BufferBindFlag::VertexBuffer, .sizeInBytes = 4 * 12 });
+		scene.ib = device.CreateBuffer(rhi::BufferDesc{ .bindFlag = rhi::BufferBindFlag::IndexBuffer, .sizeInBytes = 6 * sizeof(std::uint16_t) });
+		const std::array<std::uint16_t, 6> indices{ 0, 1, 2, 2, 1, 3 };
+		device.UpdateBuffer(scene.ib, std::as_bytes(std::span{ indices }));
+		return scene;
+	}
+
+	void BindMesh(rhi::CommandList& list, const Scene& scene)
+	{
+		list.BindPipeline(scene.pipeline);
+		list.BindInputLayout(scene.layout);
+		list.BindVertexBuffer(0, scene.vb, 12);
+		list.BindIndexBuffer(scene.ib, rhi::IndexType::UINT16);
+	}
+}
+
+TEST(RHIValidation, CollectsPerFrameAndPerPassStats)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+	const Scene scene = CreateScene(device);
+	const rhi::TextureHandle color = device.CreateTexture2D({ 8, 8 }, rhi::Format::RGBA8_UNORM);
+	const rhi::FrameBufferHandle frameBuffer = device.CreateFramebuffer(color, rhi::TextureHandle{});
+
+	rhi::CommandList list{};
+	rhi::BeginPassDesc offscreen{};
+	offscreen.frameBuffer = frameBuffer;
+	offscreen.extent = { 8, 8 };
+	list.BeginPass(offscreen);
+	BindMesh(list, scene);
+	list.DrawIndexed(6, rhi::IndexType::UINT16, 0, 0, 3);
+	list.BindPipeline(scene.pipeline); // redundant
+	list.Draw(3);
+	list.EndPass();
+
+	list.BeginPass(rhi::BeginPassDesc{});
+	BindMesh(list, scene);
+	const std::array<float, 4> constants{};
+	list.SetConstants(0, std::as_bytes(std::span{ constants }));
+	list.Draw(4);
+	list.EndPass();
+	device.SubmitCommandList(std::move(list));
+
+	const rhi::ValidationFrameStats& frame = device.GetCurrentFrameStats();
+	EXPECT_EQ(frame.commandLists, 1u);
+	EXPECT_EQ(frame.draws, 3u);
+	EXPECT_EQ(frame.instances, 5u);
+	EXPECT_EQ(frame.triangles, 2u * 3u + 1u + 1u);
+	EXPECT_EQ(frame.stateChanges, 9u);
+	EXPECT_EQ(frame.redundantStateChanges, 5u); // bindings persist across passes of one list
+	EXPECT_EQ(frame.bytesUploaded, 6u * sizeof(std::uint16_t));
+	EXPECT_EQ(frame.constantBytes, sizeof(constants));
+	ASSERT_EQ(frame.passes.size(), 2u);
+	EXPECT_EQ(frame.passes[0].frameBuffer, frameBuffer);
+	EXPECT_EQ(frame.passes[0].draws, 2u);
+	EXPECT_EQ(frame.passes[0].instances, 4u);
+	EXPECT_EQ(frame.passes[0].stateChanges, 5u);
+	EXPECT_EQ(frame.passes[1].draws, 1u);
+	EXPECT_EQ(frame.passes[1].triangles, 1u);
+
+	// SignalTimeline closes the frame; the next one starts empty.
+	device.SignalTimeline();
+	EXPECT_EQ(device.GetLastFrameStats().draws, 3u);
+	EXPECT_EQ(device.GetLastFrameStats().passes.size(), 2u);
+	EXPECT_EQ(device.GetCurrentFrameStats().draws, 0u);
+	EXPECT_TRUE(device.GetCurrentFrameStats().passes.empty());
+	EXPECT_EQ(device.GetCurrentFrameStats().frameIndex, device.GetLastFrameStats().frameIndex + 1);
+}
+
+TEST(RHIValidation, RejectsUnbalancedPasses)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+
+	rhi::CommandList endWithoutBegin{};
+	endWithoutBegin.EndPass();
+	EXPECT_THROW(device.SubmitCommandList(std::move(endWithoutBegin)), std::runtime_error);
+
+	rhi::CommandList nested{};
+	nested.BeginPass(rhi::BeginPassDesc{});
+	nested.BeginPass(rhi::BeginPassDesc{});
+	EXPECT_THROW(device.SubmitCommandList(std::move(nested)), std::runtime_error);
+
+	rhi::CommandList unterminated{};
+	unterminated.BeginPass(rhi::BeginPassDesc{});
+	EXPECT_THROW(device.SubmitCommandList(std::move(unterminated)), std::runtime_error);
+}
+
+TEST(RHIValidation, RejectsDrawsWithoutPipelineOrLayout)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+	const Scene scene = CreateScene(device);
+
+	rhi::CommandList outsidePass{};
+	BindMesh(outsidePass, scene);
+	outsidePass.Draw(3);
+	EXPECT_THROW(device.SubmitCommandList(std::move(outsidePass)), std::runtime_error);
+
+	rhi::CommandList noPipeline{};
+	noPipeline.BeginPass(rhi::BeginPassDesc{});
+	noPipeline.BindInputLayout(scene.layout);
+	noPipeline.Draw(3);
+	noPipeline.EndPass();
+	EXPECT_THROW(device.SubmitCommandList(std::move(noPipeline)), std::runtime_error);
+
+	rhi::CommandList noLayout{};
+	noLayout.BeginPass(rhi::BeginPassDesc{});
+	noLayout.BindPipeline(scene.pipeline);
+	noLayout.Draw(3);
+	noLayout.EndPass();
+	EXPECT_THROW(device.SubmitCommandList(std::move(noLayout)), std::runtime_error);
+
+	// Bindings do not carry over from a previous submission.
+	rhi::CommandList valid{};
+	valid.BeginPass(rhi::BeginPassDesc{});
+	BindMesh(valid, scene);
+	valid.Draw(3);
+	valid.EndPass();
+	EXPECT_NO_THROW(device.SubmitCommandList(std::move(valid)));
+
+	rhi::CommandList fresh{};
+	fresh.BeginPass(rhi::BeginPassDesc{});
+	fresh.Draw(3);
+	fresh.EndPass();
+	EXPECT_THROW(device.SubmitCommandList(std::move(fresh)), std::runtime_error);
+}
+
+TEST(RHIValidation, RejectsIndexAndVertexRangesPastTheBuffer)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+	const Scene scene = CreateScene(device);
+
+	const auto submitDraw = [&](auto&& draw)
+		{
+			rhi::CommandList list{};
+			list.BeginPass(rhi::BeginPassDesc{});
+			BindMesh(list, scene);
+			draw(list);
+			list.EndPass();
+			device.SubmitCommandList(std::move(list));
+		};
+
+	EXPECT_NO_THROW(submitDraw([](rhi::CommandList& list) { list.DrawIndexed(6, rhi::IndexType::UINT16); }));
+	EXPECT_NO_THROW(submitDraw([](rhi::CommandList& list) { list.DrawIndexed(3, rhi::IndexType::UINT16, 3); }));
+	EXPECT_THROW(submitDraw([](rhi::CommandList& list) { list.DrawIndexed(6, rhi::IndexType::UINT16, 1); }), std::runtime_error);
+	EXPECT_THROW(submitDraw([](rhi::CommandList& list) { list.DrawIndexed(6, rhi::IndexType::UINT32); }), std::runtime_error);
+	EXPECT_NO_THROW(submitDraw([](rhi::CommandList& list) { list.Draw(4); }));
+	EXPECT_THROW(submitDraw([](rhi::CommandList& list) { list.Draw(3, 2); }), std::runtime_error);
+
+	// Index buffer offset is part of the range.
+	EXPECT_THROW(submitDraw([&](rhi::CommandList& list)
+		{
+			list.BindIndexBuffer(scene.ib, rhi::IndexType::UINT16, 4);
+			list.DrawIndexed(6, rhi::IndexType::UINT16);
+		}), std::runtime_error);
+
+	const std::array<std::byte, 16> bytes{};
+	EXPECT_THROW(device.UpdateBuffer(scene.ib, std::span{ bytes }), std::runtime_error);
+	EXPECT_THROW(device.UpdateBuffer(scene.vb, std::span{ bytes }, 40), std::runtime_error);
+}
+
+TEST(RHIValidation, RejectsStaleHandles)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+	const Scene scene = CreateScene(device);
+	const rhi::TextureHandle texture = device.CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+
+	device.DestroyTexture(texture);
+	device.DestroyTexture(texture);
+	EXPECT_EQ(device.GetCurrentFrameStats().invalidDestroys, 1u);
+	EXPECT_THROW(device.CreateFramebuffer(texture, rhi::TextureHandle{}), std::runtime_error);
+
+	rhi::CommandList staleTexture{};
+	staleTexture.BindTexture2D(0, texture);
+	EXPECT_THROW(device.SubmitCommandList(std::move(staleTexture)), std::runtime_error);
+
+	device.DestroyBuffer(scene.vb);
+	rhi::CommandList staleBuffer{};
+	staleBuffer.BindVertexBuffer(0, scene.vb, 12);
+	EXPECT_THROW(device.SubmitCommandList(std::move(staleBuffer)), std::runtime_error);
+	const std::array<std::byte, 4> bytes{};
+	EXPECT_THROW(device.UpdateBuffer(scene.vb, std::span{ bytes }), std::runtime_error);
+
+	device.DestroyPipeline(scene.pipeline);
+	rhi::CommandList stalePipeline{};
+	stalePipeline.BindPipeline(scene.pipeline);
+	EXPECT_THROW(device.SubmitCommandList(std::move(stalePipeline)), std::runtime_error);
+
+	// Handles created behind the decorator's back are unknown to it.
+	const rhi::InputLayoutHandle foreign = inner->CreateInputLayout(rhi::InputLayoutDesc{});
+	rhi::CommandList foreignLayout{};
+	foreignLayout.BindInputLayout(foreign);
+	EXPECT_THROW(device.SubmitCommandList(std::move(foreignLayout)), std::runtime_error);
+}
+
+TEST(RHIValidation, RejectsFreedTextureDescriptors)
+{
+	std::unique_ptr<rhi::IRHIDevice> inner = rhi::CreateNullDevice();
+	rhi::ValidationDevice device(*inner);
+	const rhi::TextureHandle texture = device.CreateTexture2D({ 4, 4 }, rhi::Format::RGBA8_UNORM);
+	const rhi::TextureDescIndex live = device.AllocateTextureDesctiptor(texture);
+	const rhi::TextureDescIndex freed = device.AllocateTextureDesctiptor(texture);
+	ASSERT_NE(freed, 0u);
+	device.FreeTextureDescriptor(freed);
+
+	rhi::CommandList liveList{};
+	liveList.BindTextureDesc(0, live);
+	liveList.BindTextureDesc(1, 0); // index 0 means "nothing bound"
+	EXPECT_NO_THROW(device.SubmitCommandList(std::move(liveList)));
+
+	rhi::CommandList freedList{};
+	freedList.BindTextureDesc(0, freed);
+	EXPECT_THROW(device.SubmitCommandList(std::move(freedList)), std::runtime_error);
+
+	// Indices allocated behind the decorator's back are unknown to it.
+	const rhi::TextureDescIndex foreign = inner->AllocateTextureDesctiptor(texture);
+	rhi::CommandList foreignList{};
+	foreignList.BindTextureDesc(0, foreign);
+	EXPECT_THROW(device.SubmitCommandList(std::move(foreignList)), std::runtime_error);
+}
@@ -0,0 +1,542 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+import core;
+
+namespace
+{
+	renderGraph::RGTextureDesc ColorDesc(const char* name)
+	{
+		return renderGraph::RGTextureDesc{
+			.extent = { 64, 64 },
+			.format = rhi::Format::RGBA8_UNORM,
+			.usage = renderGraph::ResourceUsage::RenderTarget,
+			.debugName = name
+		};
+	}
+
+	renderGraph::PassAttachments WriteColor(renderGraph::RGTexture target, bool clear = true)
+	{
+		renderGraph::PassAttachments att{};
+		att.colors = { target };
+		att.clearDesc.clearColor = clear;
+		return att;
+	}
+
+	struct GraphFixture
+	{
+		std::unique_ptr<rhi::IRHIDevice> device = rhi::CreateNullDevice();
+		std::unique_ptr<rhi::IRHISwapChain> swapChain = rhi::CreateNullSwapChain(*device, rhi::SwapChainDesc{ .extent = { 64, 64 } });
+		renderGraph::RenderGraph graph;
+		std::vector<std::string> executed;
+
+		renderGraph::PassCallback Track(std::string name)
+		{
+			return [this, name](renderGraph::PassContext&) { executed.push_back(name); };
+		}
+	};
+}
+
+TEST(RenderGraph, CullsPassesThatDoNotReachAnOutput)
+{
+	GraphFixture f;
+	const rhi::TextureHandle probe = f.device->CreateTexture2D({ 64, 64 }, rhi::Format::RGBA8_UNORM);
+
+	const auto sceneColor = f.graph.CreateTexture(ColorDesc("SceneColor"));
+	const auto bloom = f.graph.CreateTexture(ColorDesc("Bloom"));
+	const auto probeRG = f.graph.ImportTexture(probe, ColorDesc("Probe"));
+
+	f.graph.AddPass("Scene", WriteColor(sceneColor), f.Track("Scene"));
+
+	auto bloomAtt = WriteColor(bloom);
+	bloomAtt.reads = { sceneColor };
+	f.graph.AddPass("Bloom", std::move(bloomAtt), f.Track("Bloom"));
+
+	f.graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { sceneColor }, f.Track("Present"));
+	f.graph.AddPass("Probe", WriteColor(probeRG), f.Track("Probe"));
+
+	const renderGraph::CompiledGraph& compiled = f.graph.Compile();
+	EXPECT_EQ(compiled.passOrder, (std::vector<std::uint32_t>{ 0, 2, 3 }));
+	EXPECT_EQ(compiled.CulledPassCount(), 1u);
+	EXPECT_EQ(compiled.passCulled[1], 1u);
+	EXPECT_EQ(compiled.passDependencies[2], (std::vector<std::uint32_t>{ 0 }));
+
+	EXPECT_EQ(compiled.textureLifetimes[sceneColor.id].firstUse, 0u);
+	EXPECT_EQ(compiled.textureLifetimes[sceneColor.id].lastUse, 1u);
+	EXPECT_FALSE(compiled.textureLifetimes[bloom.id].IsUsed());
+	EXPECT_EQ(compiled.textureLifetimes[probeRG.id].firstUse, 2u);
+
+	f.graph.Execute(*f.device, *f.swapChain);
+	EXPECT_EQ(f.executed, (std::vector<std::string>{ "Scene", "Present", "Probe" }));
+}
+
+TEST(RenderGraph, SkipsTexturesOnlyUsedByCulledPasses)
+{
+	GraphFixture f;
+	rhi::RecordingDevice recorder(*f.device);
+
+	const auto sceneColor = f.graph.CreateTexture(ColorDesc("SceneColor"));
+	const auto unused = f.graph.CreateTexture(ColorDesc("Unused"));
+
+	f.graph.AddPass("Scene", WriteColor(sceneColor), f.Track("Scene"));
+	f.graph.AddPass("Dead", WriteColor(unused), f.Track("Dead"));
+	f.graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { sceneColor }, f.Track("Present"));
+	f.graph.Execute(recorder, *f.swapChain);
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *f.swapChain);
+
+	// SceneColor + its framebuffer; "Unused" and the dead pass framebuffer are never created.
+	EXPECT_EQ(stats.resourcesCreated, 2u);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::BeginPass), 2u);
+}
+
+TEST(RenderGraph, LoadedAttachmentsDependOnPreviousWriter)
+{
+	GraphFixture f;
+	const auto sceneColor = f.graph.CreateTexture(ColorDesc("SceneColor"));
+
+	f.graph.AddPass("Opaque", WriteColor(sceneColor), f.Track("Opaque"));
+	f.graph.AddPass("Transparent", WriteColor(sceneColor, false), f.Track("Transparent"));
+	// Clearing overwrites everything before it, so "Overwritten" has no consumer.
+	f.graph.AddPass("Overwritten", WriteColor(sceneColor, false), f.Track("Overwritten"));
+	f.graph.AddPass("Final", WriteColor(sceneColor, true), f.Track("Final"));
+	f.graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { sceneColor }, f.Track("Present"));
+
+	const renderGraph::CompiledGraph& compiled = f.graph.Compile();
+	EXPECT_EQ(compiled.passOrder, (std::vector<std::uint32_t>{ 3, 4 }));
+	EXPECT_EQ(compiled.passDependencies[1], (std::vector<std::uint32_t>{ 0 }));
+	EXPECT_EQ(compiled.passDependencies[4], (std::vector<std::uint32_t>{ 3 }));
+}
+
+TEST(RenderGraph, KeepsCubeFaceWritesAndSideEffectPasses)
+{
+	GraphFixture f;
+	auto cubeDesc = ColorDesc("Cube");
+	cubeDesc.type = renderGraph::TextureType::Cube;
+	const auto cube = f.graph.CreateTexture(cubeDesc);
+	const auto scratch = f.graph.CreateTexture(ColorDesc("Scratch"));
+
+	for (std::uint32_t face = 0; face < 6u; ++face)
+	{
+		auto att = WriteColor(cube);
+		att.colorCubeFace = face;
+		f.graph.AddPass("Face" + std::to_string(face), std::move(att), f.Track("Face"));
+	}
+	f.graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { cube }, f.Track("Present"));
+
+	auto readback = WriteColor(scratch);
+	readback.hasSideEffects = true;
+	f.graph.AddPass("Readback", std::move(readback), f.Track("Readback"));
+
+	const renderGraph::CompiledGraph& compiled = f.graph.Compile();
+	EXPECT_EQ(compiled.CulledPassCount(), 0u);
+	EXPECT_EQ(compiled.textureLifetimes[cube.id].firstUse, 0u);
+	EXPECT_EQ(compiled.textureLifetimes[cube.id].lastUse, 6u);
+
+	f.graph.Execute(*f.device, *f.swapChain);
+	EXPECT_EQ(f.executed.size(), 8u);
+}
+
+namespace
+{
+	// SceneColor -> BloomA -> BloomB -> BloomC -> swapchain, all with the same descriptor.
+	void BuildBloomChain(renderGraph::RenderGraph& graph)
+	{
+		graph.Reset();
+		const auto sceneColor = graph.CreateTexture(ColorDesc("SceneColor"));
+		const auto bloomA = graph.CreateTexture(ColorDesc("BloomA"));
+		const auto bloomB = graph.CreateTexture(ColorDesc("BloomB"));
+		const auto bloomC = graph.CreateTexture(ColorDesc("BloomC"));
+
+		graph.AddPass("Scene", WriteColor(sceneColor), [](renderGraph::PassContext&) {});
+
+		auto extract = WriteColor(bloomA);
+		extract.reads = { sceneColor };
+		graph.AddPass("Extract", std::move(extract), [](renderGraph::PassContext&) {});
+
+		auto blur = WriteColor(bloomB);
+		blur.reads = { bloomA };
+		graph.AddPass("Blur", std::move(blur), [](renderGraph::PassContext&) {});
+
+		auto blur2 = WriteColor(bloomC);
+		blur2.reads = { bloomB };
+		graph.AddPass("Blur2", std::move(blur2), [](renderGraph::PassContext&) {});
+
+		graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { bloomC }, [](renderGraph::PassContext&) {});
+	}
+}
+
+TEST(RenderGraph, AliasesTexturesWithDisjointLifetimes)
+{
+	GraphFixture f;
+	BuildBloomChain(f.graph);
+	f.graph.Execute(*f.device, *f.swapChain);
+
+	// Lifetimes: SceneColor [0,1], BloomA [1,2], BloomB [2,3], BloomC [3,4].
+	// SceneColor/BloomB and BloomA/BloomC never overlap, so two textures cover all four.
+	const renderGraph::TransientPoolStats& stats = f.graph.GetTransientPoolStats();
+	EXPECT_EQ(stats.requests, 4u);
+	EXPECT_EQ(stats.texturesCreated, 2u);
+	EXPECT_EQ(stats.aliasHits, 2u);
+	EXPECT_EQ(stats.frameTextures, 2u);
+	EXPECT_EQ(stats.frameBytes, 2u * 64u * 64u * 4u);
+}
+
+TEST(RenderGraph, ReusesPooledTexturesAcrossFrames)
+{
+	GraphFixture f;
+	for (int frame = 0; frame < 3; ++frame)
+	{
+		BuildBloomChain(f.graph);
+		f.graph.Execute(*f.device, *f.swapChain);
+	}
+
+	const renderGraph::TransientPoolStats& stats = f.graph.GetTransientPoolStats();
+	EXPECT_EQ(stats.texturesCreated, 2u);
+	EXPECT_EQ(stats.texturesDestroyed, 0u);
+	EXPECT_EQ(stats.poolHits, 4u);
+	EXPECT_DOUBLE_EQ(stats.HitRate(), 10.0 / 12.0);
+
+	// An empty frame stream eventually evicts the idle textures.
+	for (std::uint64_t frame = 0; frame < renderGraph::TransientTexturePool::kRetainFrames; ++frame)
+	{
+		f.graph.Reset();
+		f.graph.Execute(*f.device, *f.swapChain);
+	}
+	EXPECT_EQ(f.graph.GetTransientPoolStats().texturesDestroyed, 2u);
+	EXPECT_EQ(f.graph.GetTransientPoolStats().pooledBytes, 0u);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().destroyed, 2u);
+
+	f.graph.ReleaseTransientResources(*f.device);
+}
+
+TEST(RenderGraph, SteadyStateFramesCreateNoFramebuffers)
+{
+	GraphFixture f;
+	BuildBloomChain(f.graph);
+	f.graph.Execute(*f.device, *f.swapChain);
+
+	// Aliasing leaves two physical targets, so the four offscreen passes need two framebuffers.
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().frameCreated, 2u);
+
+	for (int frame = 0; frame < 2; ++frame)
+	{
+		BuildBloomChain(f.graph);
+		f.graph.Execute(*f.device, *f.swapChain);
+		EXPECT_EQ(f.graph.GetFramebufferCacheStats().frameCreated, 0u);
+	}
+
+	const renderGraph::FramebufferCacheStats& stats = f.graph.GetFramebufferCacheStats();
+	EXPECT_EQ(stats.misses, 2u);
+	EXPECT_EQ(stats.hits, 10u);
+	EXPECT_EQ(stats.destroyed, 0u);
+
+	f.graph.ReleaseTransientResources(*f.device);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().destroyed, 2u);
+}
+
+TEST(RenderGraph, InvalidatesFramebuffersOfDestroyedTextures)
+{
+	GraphFixture f;
+	rhi::TextureHandle probe = f.device->CreateTextureCube({ 64, 64 }, rhi::Format::RGBA8_UNORM);
+
+	const auto buildProbeFaces = [&f, &probe]()
+		{
+			f.graph.Reset();
+			auto cubeDesc = ColorDesc("Probe");
+			cubeDesc.type = renderGraph::TextureType::Cube;
+			const auto probeRG = f.graph.ImportTexture(probe, cubeDesc);
+			for (std::uint32_t face = 0; face < 6u; ++face)
+			{
+				auto att = WriteColor(probeRG);
+				att.colorCubeFace = face;
+				f.graph.AddPass("ProbeFace", std::move(att), [](renderGraph::PassContext&) {});
+			}
+		};
+
+	buildProbeFaces();
+	f.graph.Execute(*f.device, *f.swapChain);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().misses, 6u);
+
+	f.graph.InvalidateTexture(*f.device, probe);
+	f.device->DestroyTexture(probe);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().invalidated, 6u);
+
+	probe = f.device->CreateTextureCube({ 64, 64 }, rhi::Format::RGBA8_UNORM);
+	buildProbeFaces();
+	f.graph.Execute(*f.device, *f.swapChain);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().misses, 12u);
+	EXPECT_EQ(f.graph.GetFramebufferCacheStats().hits, 0u);
+
+	f.graph.ReleaseTransientResources(*f.device);
+	f.device->DestroyTexture(probe);
+}
+
+namespace
+{
+	struct DeferredGraph
+	{
+		renderGraph::RGTexture gbuf[4];
+		renderGraph::RGTexture depth;
+		renderGraph::RGTexture ssaoRaw;
+		renderGraph::RGTexture ssaoBlur;
+		renderGraph::RGTexture sceneColor;
+		renderGraph::RGTexture bloomExtract;
+		renderGraph::RGTexture bloomBlurX;
+		renderGraph::RGTexture bloomBlurY;
+		renderGraph::RGTexture composite;
+	};
+
+	// Mirrors the DX12 deferred path: GBuffer -> SSAO -> lighting -> bloom -> present.
+	DeferredGraph BuildDeferredGraph(renderGraph::RenderGraph& graph, renderGraph::PassCallback present)
+	{
+		DeferredGraph g{};
+		for (int i = 0; i < 4; ++i)
+		{
+			g.gbuf[i] = graph.CreateTexture(ColorDesc("GBuffer"));
+		}
+		auto depthDesc = ColorDesc("Depth");
+		depthDesc.format = rhi::Format::D32_FLOAT;
+		depthDesc.usage = renderGraph::ResourceUsage::DepthStencil;
+		g.depth = graph.CreateTexture(depthDesc);
+		g.ssaoRaw = graph.CreateTexture(ColorDesc("SSAO_Raw"));
+		g.ssaoBlur = graph.CreateTexture(ColorDesc("SSAO_Blur"));
+		g.sceneColor = graph.CreateTexture(ColorDesc("SceneColor"));
+		g.bloomExtract = graph.CreateTexture(ColorDesc("BloomExtract"));
+		g.bloomBlurX = graph.CreateTexture(ColorDesc("BloomBlurX"));
+		g.bloomBlurY = graph.CreateTexture(ColorDesc("BloomBlurY"));
+		g.composite = graph.CreateTexture(ColorDesc("Composite"));
+
+		const auto noop = [](renderGraph::PassContext&) {};
+
+		renderGraph::PassAttachments gbufferAtt{};
+		gbufferAtt.colors = { g.gbuf[0], g.gbuf[1], g.gbuf[2], g.gbuf[3] };
+		gbufferAtt.depth = g.depth;
+		gbufferAtt.clearDesc.clearColor = true;
+		gbufferAtt.clearDesc.clearDepth = true;
+		graph.AddPass("GBuffer", std::move(gbufferAtt), noop);
+
+		auto ssaoAtt = WriteColor(g.ssaoRaw);
+		ssaoAtt.reads = { g.gbuf[1], g.depth };
+		graph.AddPass("SSAO", std::move(ssaoAtt), noop);
+
+		auto blurAtt = WriteColor(g.ssaoBlur);
+		blurAtt.reads = { g.ssaoRaw, g.depth };
+		graph.AddPass("SSAOBlur", std::move(blurAtt), noop);
+
+		auto lightingAtt = WriteColor(g.sceneColor);
+		lightingAtt.reads = { g.gbuf[0], g.gbuf[1], g.gbuf[2], g.gbuf[3], g.depth, g.ssaoBlur };
+		graph.AddPass("DeferredLighting", std::move(lightingAtt), noop);
+
+		auto extractAtt = WriteColor(g.bloomExtract);
+		extractAtt.reads = { g.sceneColor };
+		graph.AddPass("BloomExtract", std::move(extractAtt), noop);
+
+		auto blurXAtt = WriteColor(g.bloomBlurX);
+		blurXAtt.reads = { g.bloomExtract };
+		graph.AddPass("BloomBlurX", std::move(blurXAtt), noop);
+
+		auto blurYAtt = WriteColor(g.bloomBlurY);
+		blurYAtt.reads = { g.bloomBlurX };
+		graph.AddPass("BloomBlurY", std::move(blurYAtt), noop);
+
+		auto compositeAtt = WriteColor(g.composite);
+		compositeAtt.reads = { g.sceneColor, g.bloomBlurY };
+		graph.AddPass("BloomComposite", std::move(compositeAtt), noop);
+
+		graph.AddSwapChainPass("Present", rhi::ClearDesc{}, { g.composite }, std::move(present));
+		return g;
+	}
+
+	std::string DescribeBarrier(std::uint32_t texture, rhi::ResourceState before, rhi::ResourceState after)
+	{
+		constexpr const char* kNames[] = { "Unknown", "RenderTarget", "DepthWrite", "ShaderRead" };
+		return std::to_string(texture) + ":" + kNames[static_cast<int>(before)] + "->" + kNames[static_cast<int>(after)];
+	}
+}
+
+TEST(RenderGraph, PlansMinimalBarriersForDeferredFrame)
+{
+	using enum rhi::ResourceState;
+	GraphFixture f;
+	const DeferredGraph g = BuildDeferredGraph(f.graph, [](renderGraph::PassContext&) {});
+	const renderGraph::CompiledGraph& compiled = f.graph.Compile();
+
+	std::vector<std::vector<std::string>> plan;
+	for (const auto& batch : compiled.passBarriers)
+	{
+		plan.emplace_back();
+		for (const renderGraph::RGBarrier& barrier : batch)
+		{
+			plan.back().push_back(DescribeBarrier(barrier.texture.id, barrier.before, barrier.after));
+		}
+	}
+
+	const auto B = [](renderGraph::RGTexture texture, rhi::ResourceState before, rhi::ResourceState after)
+		{
+			return DescribeBarrier(texture.id, before, after);
+		};
+	const std::vector<std::vector<std::string>> expected{
+		{ B(g.gbuf[0], Unknown, RenderTarget), B(g.gbuf[1], Unknown, RenderTarget), B(g.gbuf[2], Unknown, RenderTarget),
+		  B(g.gbuf[3], Unknown, RenderTarget), B(g.depth, Unknown, DepthWrite) },
+		{ B(g.ssaoRaw, Unknown, RenderTarget), B(g.gbuf[1], RenderTarget, ShaderRead), B(g.depth, DepthWrite, ShaderRead) },
+		{ B(g.ssaoBlur, Unknown, RenderTarget), B(g.ssaoRaw, RenderTarget, ShaderRead) },
+		{ B(g.sceneColor, Unknown, RenderTarget), B(g.gbuf[0], RenderTarget, ShaderRead), B(g.gbuf[2], RenderTarget, ShaderRead),
+		  B(g.gbuf[3], RenderTarget, ShaderRead), B(g.ssaoBlur, RenderTarget, ShaderRead) },
+		{ B(g.bloomExtract, Unknown, RenderTarget), B(g.sceneColor, RenderTarget, ShaderRead) },
+		{ B(g.bloomBlurX, Unknown, RenderTarget), B(g.bloomExtract, RenderTarget, ShaderRead) },
+		{ B(g.bloomBlurY, Unknown, RenderTarget), B(g.bloomBlurX, RenderTarget, ShaderRead) },
+		{ B(g.composite, Unknown, RenderTarget), B(g.bloomBlurY, RenderTarget, ShaderRead) },
+		{ B(g.composite, RenderTarget, ShaderRead) },
+	};
+	EXPECT_EQ(plan, expected);
+	EXPECT_EQ(compiled.BarrierCount(), 24u);
+}
+
+TEST(RenderGraph, RecordsPlannedBarriersBeforeEachPass)
+{
+	GraphFixture f;
+	rhi::RecordingDevice recorder(*f.device);
+
+	std::vector<rhi::TextureHandle> physical;
+	BuildDeferredGraph(f.graph, [&physical](renderGraph::PassContext& ctx)
+		{
+			for (std::uint32_t id = 0; id < 12u; ++id)
+			{
+				physical.push_back(ctx.resources.GetTexture(renderGraph::RGTexture{ id }));
+			}
+		});
+	f.graph.Execute(recorder, *f.swapChain);
+	ASSERT_EQ(physical.size(), 12u);
+
+	std::vector<std::vector<rhi::TextureBarrier>> expected;
+	for (const std::uint32_t passIndex : f.graph.GetCompiled().passOrder)
+	{
+		expected.emplace_back();
+		for (const renderGraph::RGBarrier& barrier : f.graph.GetCompiled().passBarriers[passIndex])
+		{
+			expected.back().push_back(rhi::TextureBarrier{ physical[barrier.texture.id], barrier.before, barrier.after });
+		}
+	}
+
+	// Every pass is preceded by exactly one batch, recorded outside BeginPass/EndPass.
+	std::vector<std::vector<rhi::TextureBarrier>> recorded;
+	bool insidePass = false;
+	bool batchPending = false;
+	bool batchesOutsidePasses = true;
+	rhi::CaptureReplayOptions options{};
+	options.onCommand = [&](const rhi::CommandRecord& record)
+		{
+			rhi::VisitCommand(record, [&]<typename T>(const T& cmd)
+				{
+					if constexpr (std::is_same_v<T, rhi::CommandTransitionTextures>)
+					{
+						batchesOutsidePasses = batchesOutsidePasses && !insidePass && !batchPending;
+						recorded.emplace_back(cmd.barriers.begin(), cmd.barriers.end());
+						batchPending = true;
+					}
+					else if constexpr (std::is_same_v<T, rhi::CommandBeginPass>)
+					{
+						if (!batchPending)
+						{
+							recorded.emplace_back();
+						}
+						batchPending = false;
+						insidePass = true;
+					}
+					else if constexpr (std::is_same_v<T, rhi::CommandEndPass>)
+					{
+						insidePass = false;
+					}
+				});
+		};
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *f.swapChain, options);
+
+	EXPECT_TRUE(batchesOutsidePasses);
+	EXPECT_EQ(recorded, expected);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::TransitionTextures), 9u);
+}
+
+namespace
+{
+	// `count` side-effect passes; every third one records serially. Pass i draws i + 1 vertices 16 times.
+	void BuildIndependentPasses(renderGraph::RenderGraph& graph, std::uint32_t count)
+	{
+		for (std::uint32_t i = 0; i < count; ++i)
+		{
+			auto att = WriteColor(graph.CreateTexture(ColorDesc("Independent")));
+			att.hasSideEffects = true;
+			att.recordInParallel = (i % 3u) != 0u;
+			graph.AddPass("Independent" + std::to_string(i), std::move(att), [i](renderGraph::PassContext& ctx)
+				{
+					for (int draw = 0; draw < 16; ++draw)
+					{
+						ctx.commandList.Draw(i + 1u);
+					}
+				});
+		}
+	}
+}
+
+TEST(RenderGraph, StitchesParallelPassesInExecutionOrder)
+{
+	GraphFixture f;
+	rendern::JobSystemThreadPool jobs(4);
+	rhi::RecordingDevice recorder(*f.device);
+	f.graph.SetJobSystem(&jobs, 4);
+
+	constexpr std::uint32_t kPasses = 24;
+	BuildIndependentPasses(f.graph, kPasses);
+	f.graph.Execute(recorder, *f.swapChain);
+
+	std::vector<std::uint32_t> vertexCounts;
+	rhi::CaptureReplayOptions options{};
+	options.onCommand = [&vertexCounts](const rhi::CommandRecord& record)
+		{
+			rhi::VisitCommand(record, [&vertexCounts]<typename T>(const T& cmd)
+				{
+					if constexpr (std::is_same_v<T, rhi::CommandDraw>)
+					{
+						vertexCounts.push_back(cmd.vertexCount);
+					}
+				});
+		};
+
+	std::unique_ptr<rhi::IRHIDevice> target = rhi::CreateNullDevice();
+	rhi::CaptureReplayer replayer(recorder.GetCaptureBytes());
+	const rhi::CaptureReplayStats stats = replayer.Replay(*target, *f.swapChain, options);
+
+	std::vector<std::uint32_t> expected;
+	for (std::uint32_t i = 0; i < kPasses; ++i)
+	{
+		expected.insert(expected.end(), 16, i + 1u);
+	}
+	EXPECT_EQ(vertexCounts, expected);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::BeginPass), kPasses);
+	EXPECT_EQ(stats.CountOf(rhi::CommandType::TransitionTextures), kPasses);
+}
+
+TEST(RenderGraph, RethrowsExceptionsFromParallelPasses)
+{
+	GraphFixture f;
+	rendern::JobSystemThreadPool jobs(2);
+	f.graph.SetJobSystem(&jobs, 2);
+
+	BuildIndependentPasses(f.graph, 6);
+	auto att = WriteColor(f.graph.CreateTexture(ColorDesc("Failing")));
+	att.hasSideEffects = true;
+	att.recordInParallel = true;
+	f.graph.AddPass("Failing", std::move(att), [](renderGraph::PassContext&) { throw std::runtime_error("record failed"); });
+
+	EXPECT_THROW(f.graph.Execute(*f.device, *f.swapChain), std::runtime_error);
+}
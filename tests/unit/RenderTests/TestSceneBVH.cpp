@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "RenderTestHelper.h"
+
+import core;
+
+using namespace RenderTestHelper;
+
+namespace
+{
+	rendern::Aabb RandomBox(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position(-200.0f, 200.0f);
+		std::uniform_real_distribution<float> extent(0.1f, 4.0f);
+		const mathUtils::Vec3 center{ position(rng), position(rng) * 0.25f, position(rng) };
+		const mathUtils::Vec3 half{ extent(rng), extent(rng), extent(rng) };
+		return rendern::Aabb{ center - half, center + half };
+	}
+
+	// Height bound for an AVL-balanced binary tree with `leaves` leaves, plus slack for the SAH descent.
+	int MaxBalancedHeight(std::size_t leaves)
+	{
+		return 2 * static_cast<int>(std::ceil(std::log2(static_cast<double>(std::max<std::size_t>(leaves, 2))))) + 2;
+	}
+
+	std::vector<int> Sorted(std::vector<int> values)
+	{
+		std::sort(values.begin(), values.end());
+		return values;
+	}
+}
+
+TEST(SceneBVH, TreeQueriesMatchBruteForceAfterInsertMoveRemove)
+{
+	std::mt19937 rng(42u);
+	rendern::DynamicAabbTree tree(0.0f); // no fat margin: queries are exact against the stored boxes
+	std::vector<int> proxies;
+	std::vector<rendern::Aabb> boxes;
+	std::vector<bool> alive;
+
+	constexpr std::size_t kCount = 2000;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		boxes.push_back(RandomBox(rng));
+		proxies.push_back(tree.CreateProxy(boxes.back(), i));
+		alive.push_back(true);
+	}
+	for (std::size_t i = 0; i < kCount; i += 3)
+	{
+		boxes[i] = RandomBox(rng);
+		tree.MoveProxy(proxies[i], boxes[i]);
+	}
+	for (std::size_t i = 1; i < kCount; i += 7)
+	{
+		tree.DestroyProxy(proxies[i]);
+		alive[i] = false;
+	}
+
+	std::size_t aliveCount = 0;
+	for (const bool a : alive)
+	{
+		aliveCount += a ? 1u : 0u;
+	}
+	ASSERT_EQ(tree.GetProxyCount(), aliveCount);
+	EXPECT_LE(tree.GetHeight(), MaxBalancedHeight(aliveCount));
+
+	const rendern::Aabb queryBox{ { -40.0f, -10.0f, -40.0f }, { 60.0f, 10.0f, 30.0f } };
+	const mathUtils::Vec3 sphereCenter{ 20.0f, 0.0f, -15.0f };
+	const float sphereRadius = 45.0f;
+	const mathUtils::Frustum frustum = CameraFrustum({ 0.0f, 5.0f, 0.0f }, { 1.0f, 5.0f, -1.0f }, 60.0f, 150.0f);
+
+	std::vector<int> expectedBox, expectedSphere, expectedFrustum;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		if (!alive[i])
+		{
+			continue;
+		}
+		const int id = static_cast<int>(i);
+		if (boxes[i].Overlaps(queryBox))
+		{
+			expectedBox.push_back(id);
+		}
+		const mathUtils::Vec3 closest = mathUtils::MinVec3(mathUtils::MaxVec3(sphereCenter, boxes[i].min), boxes[i].max);
+		const mathUtils::Vec3 delta = closest - sphereCenter;
+		if (mathUtils::Dot(delta, delta) <= sphereRadius * sphereRadius)
+		{
+			expectedSphere.push_back(id);
+		}
+		if (rendern::ClassifyAabb(frustum, boxes[i]) != rendern::FrustumOverlap::Outside)
+		{
+			expectedFrustum.push_back(id);
+		}
+	}
+
+	std::vector<int> gotBox, gotSphere, gotFrustum;
+	tree.QueryAabb(queryBox, [&](int proxy) { gotBox.push_back(static_cast<int>(tree.GetUserData(proxy))); });
+	tree.QuerySphere(sphereCenter, sphereRadius, [&](int proxy) { gotSphere.push_back(static_cast<int>(tree.GetUserData(proxy))); });
+	tree.QueryFrustum(frustum, [&](int proxy) { gotFrustum.push_back(static_cast<int>(tree.GetUserData(proxy))); });
+
+	EXPECT_FALSE(expectedBox.empty());
+	EXPECT_FALSE(expectedFrustum.empty());
+	EXPECT_LT(expectedFrustum.size(), aliveCount);
+	EXPECT_EQ(Sorted(gotBox), expectedBox);
+	EXPECT_EQ(Sorted(gotSphere), expectedSphere);
+	EXPECT_EQ(Sorted(gotFrustum), expectedFrustum);
+}
+
+TEST(SceneBVH, TreeStaysBalancedForSortedInsertsAndSmallMovesKeepTheLeaf)
+{
+	// Inserting along a line is the worst case for an unbalanced tree.
+	rendern::DynamicAabbTree tree(0.5f);
+	std::vector<int> proxies;
+	constexpr std::size_t kCount = 4096;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		const float x = static_cast<float>(i) * 2.0f;
+		proxies.push_back(tree.CreateProxy(rendern::Aabb{ { x, 0.0f, 0.0f }, { x + 1.0f, 1.0f, 1.0f } }, i));
+	}
+	EXPECT_LE(tree.GetHeight(), MaxBalancedHeight(kCount));
+
+	// Within the fat margin: no re-insertion.
+	EXPECT_FALSE(tree.MoveProxy(proxies[10], rendern::Aabb{ { 20.2f, 0.1f, 0.0f }, { 21.2f, 1.1f, 1.0f } }));
+	// Leaving it: re-inserted, and the fat box now contains the new bounds.
+	const rendern::Aabb moved{ { 500.0f, 50.0f, 0.0f }, { 501.0f, 51.0f, 1.0f } };
+	EXPECT_TRUE(tree.MoveProxy(proxies[10], moved));
+	EXPECT_TRUE(tree.GetFatAabb(proxies[10]).Contains(moved));
+
+	for (std::size_t i = 0; i < kCount; i += 2)
+	{
+		tree.DestroyProxy(proxies[i]);
+	}
+	EXPECT_EQ(tree.GetProxyCount(), kCount / 2);
+	EXPECT_LE(tree.GetHeight(), MaxBalancedHeight(kCount / 2));
+
+	// Freed nodes are reused.
+	const int reused = tree.CreateProxy(rendern::Aabb{ { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } }, 12345u);
+	EXPECT_EQ(tree.GetUserData(reused), 12345u);
+}
+
+TEST(SceneBVH, RayCastFindsClosestHitAndCanStopEarly)
+{
+	rendern::DynamicAabbTree tree(0.0f);
+	// A row of unit boxes along -Z, plus distractors off the ray.
+	for (int i = 0; i < 64; ++i)
+	{
+		const float z = -5.0f - static_cast<float>(i) * 3.0f;
+		tree.CreateProxy(rendern::Aabb{ { -0.5f, -0.5f, z - 0.5f }, { 0.5f, 0.5f, z + 0.5f } }, static_cast<std::uint64_t>(i));
+		tree.CreateProxy(rendern::Aabb{ { 10.0f, -0.5f, z - 0.5f }, { 11.0f, 0.5f, z + 0.5f } }, 1000u + static_cast<std::uint64_t>(i));
+	}
+
+	const geometry::Ray ray{ { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } };
+	float bestT = std::numeric_limits<float>::infinity();
+	std::uint64_t best = ~0ull;
+	std::size_t visited = 0;
+	tree.RayCast(ray, bestT, [&](int proxy, float t)
+		{
+			++visited;
+			if (t < bestT)
+			{
+				bestT = t;
+				best = tree.GetUserData(proxy);
+			}
+			return bestT;
+		});
+	EXPECT_EQ(best, 0u);
+	EXPECT_FLOAT_EQ(bestT, 4.5f);
+	EXPECT_LT(visited, 64u); // near-first traversal prunes boxes behind the hit
+
+	std::size_t anyHits = 0;
+	tree.RayCast(ray, 100.0f, [&](int, float) { ++anyHits; return 0.0f; });
+	EXPECT_EQ(anyHits, 1u);
+
+	std::size_t missHits = 0;
+	tree.RayCast(geometry::Ray{ { 0.0f, 20.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } }, 1000.0f, [&](int, float t) { ++missHits; return t; });
+	EXPECT_EQ(missHits, 0u);
+}
+
+TEST(SceneBVH, SyncTracksSceneItemsIncrementally)
+{
+	auto mesh = std::make_shared<rendern::MeshResource>();
+	rendern::MeshBounds bounds{};
+	bounds.aabbMin = { -1.0f, -1.0f, -1.0f };
+	bounds.aabbMax = { 1.0f, 1.0f, 1.0f };
+	bounds.sphereRadius = std::sqrt(3.0f);
+	mesh->SetBounds(bounds);
+
+	rendern::Scene scene;
+	for (int i = 0; i < 10; ++i)
+	{
+		rendern::DrawItem item{};
+		item.mesh = mesh;
+		item.transform.position = { static_cast<float>(i) * 10.0f, 0.0f, 0.0f };
+		scene.drawItems.push_back(item);
+	}
+	scene.drawItems.push_back(rendern::DrawItem{}); // no mesh: unbounded
+
+	rendern::SceneBVH bvh;
+	bvh.Sync(scene);
+	EXPECT_EQ(bvh.GetLastSyncStats().created, 10u);
+	EXPECT_EQ(bvh.GetLastSyncStats().unbounded, 1u);
+	EXPECT_EQ(bvh.GetTree().GetProxyCount(), 10u);
+
+	bvh.Sync(scene);
+	EXPECT_EQ(bvh.GetLastSyncStats().created, 0u);
+	EXPECT_EQ(bvh.GetLastSyncStats().refitted + bvh.GetLastSyncStats().reinserted, 0u);
+
+	scene.drawItems[3].transform.position = { 0.0f, 0.0f, 500.0f };
+	bvh.Sync(scene);
+	EXPECT_EQ(bvh.GetLastSyncStats().reinserted, 1u);
+	const rendern::Aabb* moved = bvh.TryGetWorldBounds({ rendern::SceneBVHItemKind::DrawItem, 3u });
+	ASSERT_NE(moved, nullptr);
+	EXPECT_FLOAT_EQ(moved->min.z, 499.0f);
+	EXPECT_EQ(bvh.TryGetWorldBounds({ rendern::SceneBVHItemKind::DrawItem, 10u }), nullptr);
+
+	// Ray along +X hits item 0 first (item 3 moved away).
+	std::vector<std::uint32_t> hits;
+	bvh.RayCast(geometry::Ray{ { -20.0f, 0.0f, 0.0f }, { 1.0f, 0.0f, 0.0f } }, 1000.0f, [&](rendern::SceneBVHItem item, float t)
+		{
+			hits.push_back(item.index);
+			return t;
+		});
+	ASSERT_FALSE(hits.empty());
+	EXPECT_EQ(hits.back(), 0u);
+
+	// Frustum looking down -Z from the origin row: sees nothing bounded near z=500 behind it, but always
+	// reports the unbounded item.
+	std::vector<rendern::SceneBVHItem> visible;
+	bvh.QueryFrustum(CameraFrustum({ 45.0f, 0.0f, 30.0f }, { 45.0f, 0.0f, 0.0f }, 90.0f, 100.0f), [&](rendern::SceneBVHItem item) { visible.push_back(item); });
+	EXPECT_NE(std::find(visible.begin(), visible.end(), rendern::SceneBVHItem{ rendern::SceneBVHItemKind::DrawItem, 10u }), visible.end());
+	EXPECT_NE(std::find(visible.begin(), visible.end(), rendern::SceneBVHItem{ rendern::SceneBVHItemKind::DrawItem, 4u }), visible.end());
+	EXPECT_EQ(std::find(visible.begin(), visible.end(), rendern::SceneBVHItem{ rendern::SceneBVHItemKind::DrawItem, 3u }), visible.end());
+
+	scene.drawItems.resize(5);
+	bvh.Sync(scene);
+	EXPECT_EQ(bvh.GetLastSyncStats().destroyed, 5u);
+	EXPECT_EQ(bvh.GetTree().GetProxyCount(), 5u);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "RenderTestHelper.h"
+
+import core;
+
+using namespace RenderTestHelper;
+
+namespace
+{
+	// Directional light shining straight down onto a 20x20 area around the origin, depth range [5, 40]
+	// below a light placed at y = 30.
+	mathUtils::Mat4 CascadeViewProj()
+	{
+		const mathUtils::Mat4 view = mathUtils::LookAt(mathUtils::Vec3{ 0.0f, 30.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 0.0f, 0.0f }, mathUtils::Vec3{ 0.0f, 0.0f, -1.0f });
+		return mathUtils::OrthoRH_ZO(-10.0f, 10.0f, -10.0f, 10.0f, 5.0f, 40.0f) * view;
+	}
+
+	// Same face order as the DX12 point shadow cube: +X, -X, +Y, -Y, +Z, -Z.
+	mathUtils::Mat4 CubeFaceView(const mathUtils::Vec3& pos, int face)
+	{
+		static const mathUtils::Vec3 kDirs[6] = { { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+		static const mathUtils::Vec3 kUps[6] = { { 0, 1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }, { 0, 1, 0 }, { 0, 1, 0 } };
+		return mathUtils::LookAtRH(pos, pos + kDirs[face], kUps[face]);
+	}
+}
+
+TEST(ShadowCasterCulling, CascadeVolumeIsExtrudedTowardsTheLight)
+{
+	const mathUtils::Mat4 cascadeVP = CascadeViewProj();
+	const mathUtils::Frustum plain = mathUtils::ExtractFrustumRH_ZO(cascadeVP);
+	const mathUtils::Frustum extruded = rendern::ExtrudedCascadeFrustum(cascadeVP);
+
+	// Inside the ortho box.
+	EXPECT_TRUE(mathUtils::IntersectsSphere(extruded, mathUtils::Vec3{ 0.0f, 10.0f, 0.0f }, 1.0f));
+	// Between the light and the cascade (above its near plane): a caster, so it must be kept.
+	EXPECT_FALSE(mathUtils::IntersectsSphere(plain, mathUtils::Vec3{ 2.0f, 100.0f, 2.0f }, 1.0f));
+	EXPECT_TRUE(mathUtils::IntersectsSphere(extruded, mathUtils::Vec3{ 2.0f, 100.0f, 2.0f }, 1.0f));
+	// Beyond the far plane or beside the box: still culled.
+	EXPECT_FALSE(mathUtils::IntersectsSphere(extruded, mathUtils::Vec3{ 0.0f, -30.0f, 0.0f }, 1.0f));
+	EXPECT_FALSE(mathUtils::IntersectsSphere(extruded, mathUtils::Vec3{ 30.0f, 10.0f, 0.0f }, 1.0f));
+	EXPECT_FALSE(mathUtils::IntersectsSphere(extruded, mathUtils::Vec3{ 30.0f, 100.0f, 0.0f }, 1.0f));
+
+	const mathUtils::Frustum all = rendern::UnboundedFrustum();
+	EXPECT_TRUE(mathUtils::IntersectsSphere(all, mathUtils::Vec3{ 1e6f, -1e6f, 1e6f }, 0.1f));
+}
+
+TEST(ShadowCasterCulling, PointLightVolumeCoversEveryCubeFace)
+{
+	const mathUtils::Vec3 lightPos{ 3.0f, 2.0f, -4.0f };
+	const float range = 12.0f;
+	const mathUtils::Frustum cube = rendern::PointLightFrustum(lightPos, range);
+	const mathUtils::Mat4 proj90 = mathUtils::PerspectiveRH_ZO(mathUtils::DegToRad(90.0f), 1.0f, 0.01f, range);
+
+	std::array<mathUtils::Frustum, 6> faces{};
+	for (int face = 0; face < 6; ++face)
+	{
+		faces[static_cast<std::size_t>(face)] = mathUtils::ExtractFrustumRH_ZO(proj90 * CubeFaceView(lightPos, face));
+	}
+
+	std::mt19937 rng(5u);
+	std::uniform_real_distribution<float> offset(-30.0f, 30.0f);
+	std::uniform_real_distribution<float> radius(0.1f, 2.0f);
+	std::size_t inside = 0;
+	for (int i = 0; i < 2000; ++i)
+	{
+		const mathUtils::Vec3 d{ offset(rng), offset(rng), offset(rng) };
+		const mathUtils::Vec3 center = lightPos + d;
+		const float r = radius(rng);
+
+		const bool inCube = mathUtils::IntersectsSphere(cube, center, r);
+		if (std::abs(d.x) <= range && std::abs(d.y) <= range && std::abs(d.z) <= range)
+		{
+			// Centre inside the cube: some face sees it, and so does the combined view.
+			bool anyFace = false;
+			for (const mathUtils::Frustum& face : faces)
+			{
+				anyFace = anyFace || mathUtils::IntersectsSphere(face, center, r);
+			}
+			EXPECT_TRUE(anyFace);
+			EXPECT_TRUE(inCube);
+		}
+		if (!inCube)
+		{
+			// Rejected spheres really are clear of the cube.
+			const float ex = std::max(std::abs(d.x) - range, 0.0f);
+			const float ey = std::max(std::abs(d.y) - range, 0.0f);
+			const float ez = std::max(std::abs(d.z) - range, 0.0f);
+			EXPECT_GT(ex * ex + ey * ey + ez * ez, r * r);
+		}
+		inside += inCube ? 1u : 0u;
+	}
+	EXPECT_GT(inside, 0u);
+	EXPECT_LT(inside, 2000u);
+}
+
+TEST(ShadowCasterCulling, CullsAgainstMoreThanThirtyTwoViews)
+{
+	std::vector<mathUtils::Frustum> views;
+	for (int i = 0; i < 40; ++i)
+	{
+		const float angle = 6.2831853f * static_cast<float>(i) / 40.0f;
+		views.push_back(CameraFrustum(mathUtils::Vec3{ 0.0f, 1.0f, 0.0f }, mathUtils::Vec3{ std::sin(angle), 1.0f, -std::cos(angle) }, 30.0f, 50.0f, 1.0f));
+	}
+
+	std::mt19937 rng(9u);
+	std::uniform_real_distribution<float> position(-60.0f, 60.0f);
+	std::uniform_real_distribution<float> radius(0.2f, 3.0f);
+	rendern::CullSpheresSoA casters;
+	std::vector<std::pair<mathUtils::Vec3, float>> spheres;
+	for (int i = 0; i < 301; ++i)
+	{
+		spheres.emplace_back(mathUtils::Vec3{ position(rng), position(rng) * 0.1f, position(rng) }, radius(rng));
+		casters.Push(spheres.back().first, spheres.back().second);
+	}
+
+	std::vector<rendern::ShadowViewMask> masks(casters.Size());
+	std::vector<std::uint32_t> scratch;
+	rendern::CullShadowCasters(casters, views, masks, scratch);
+
+	std::size_t setBits = 0;
+	for (std::size_t i = 0; i < spheres.size(); ++i)
+	{
+		for (std::size_t view = 0; view < views.size(); ++view)
+		{
+			const bool expected = mathUtils::IntersectsSphere(views[view], spheres[i].first, spheres[i].second);
+			EXPECT_EQ(((masks[i] >> view) & 1u) != 0u, expected);
+			setBits += expected ? 1u : 0u;
+		}
+		EXPECT_EQ(masks[i] >> views.size(), 0u);
+	}
+	EXPECT_GT(setBits, 0u);
+
+	const std::vector<mathUtils::Frustum> tooMany(rendern::kMaxShadowCullViews + 1);
+	EXPECT_THROW(rendern::CullShadowCasters(casters, tooMany, masks, scratch), std::runtime_error);
+	std::vector<rendern::ShadowViewMask> small(1);
+	EXPECT_THROW(rendern::CullShadowCasters(casters, views, small, scratch), std::runtime_error);
+}
+
+TEST(ShadowCasterCulling, PacksPerViewRangesGroupedByMesh)
+{
+	// Caster meshes and which of three views they reach.
+	const std::array<int, 6> meshes{ 7, 3, 7, 3, 9, 7 };
+	const std::array<rendern::ShadowViewMask, 6> masks{ 0b011, 0b001, 0b110, 0b000, 0b101, 0b111 };
+
+	rendern::ShadowViewPacking<int> packing;
+	packing.Build(meshes, masks, 3);
+	ASSERT_EQ(packing.GetViewCount(), 3u);
+
+	// View 0: casters 1 (mesh 3), 0, 5 (mesh 7), 4 (mesh 9).
+	const auto view0 = packing.GetBatches(0);
+	ASSERT_EQ(view0.size(), 3u);
+	EXPECT_EQ(view0[0].mesh, 3);
+	EXPECT_EQ(view0[0].count, 1u);
+	EXPECT_EQ(view0[1].mesh, 7);
+	EXPECT_EQ(view0[1].count, 2u);
+	EXPECT_EQ(view0[2].mesh, 9);
+	EXPECT_EQ(packing.GetCasters()[view0[1].first], 0u);
+	EXPECT_EQ(packing.GetCasters()[view0[1].first + 1], 5u);
+
+	// View 1: casters 0, 2, 5, all mesh 7: a single instanced draw.
+	const auto view1 = packing.GetBatches(1);
+	ASSERT_EQ(view1.size(), 1u);
+	EXPECT_EQ(view1[0].mesh, 7);
+	EXPECT_EQ(view1[0].count, 3u);
+	EXPECT_EQ(view1[0].first, packing.GetView(1).firstCaster);
+
+	// View ranges are contiguous and cover every emitted caster once.
+	std::uint32_t expectedFirst = 0;
+	for (std::uint32_t view = 0; view < packing.GetViewCount(); ++view)
+	{
+		EXPECT_EQ(packing.GetView(view).firstCaster, expectedFirst);
+		expectedFirst += packing.GetView(view).casterCount;
+	}
+	EXPECT_EQ(expectedFirst, packing.GetCasters().size());
+	EXPECT_EQ(packing.GetCasters().size(), 4u + 3u + 3u);
+
+	// Unrequested views stay empty.
+	packing.Build(meshes, masks, 3, 0b100);
+	EXPECT_TRUE(packing.GetBatches(0).empty());
+	EXPECT_TRUE(packing.GetBatches(1).empty());
+	EXPECT_EQ(packing.GetView(2).casterCount, 3u);
+	EXPECT_EQ(packing.GetCasters().size(), 3u);
+
+	const std::array<rendern::ShadowViewMask, 2> wrongSize{};
+	EXPECT_THROW(packing.Build(meshes, wrongSize, 3), std::runtime_error);
+	EXPECT_THROW(packing.Build(meshes, masks, 65), std::runtime_error);
+}
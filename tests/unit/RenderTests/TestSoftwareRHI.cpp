@@ -0,0 +1,286 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+import core;
+
+namespace
+{
+	struct ColoredVertex
+	{
+		std::array<float, 3> position{};
+		std::array<float, 4> color{};
+	};
+
+	constexpr std::array<float, 4> kRed{ 1.0f, 0.0f, 0.0f, 1.0f };
+	constexpr std::array<float, 4> kBlue{ 0.0f, 0.0f, 1.0f, 1.0f };
+
+	// Color + depth target, a pipeline and a vertex layout matching ColoredVertex.
+	struct SoftwareScene
+	{
+		explicit SoftwareScene(rhi::SoftwareDevice& dev, rhi::Extent2D size, const char* vsName = "VS", const char* psName = "PS")
+			: device(dev)
+			, extent(size)
+		{
+			color = device.CreateTexture2D(extent, rhi::Format::RGBA8_UNORM);
+			depth = device.CreateTexture2D(extent, rhi::Format::D32_FLOAT);
+			framebuffer = device.CreateFramebuffer(color, depth);
+
+			rhi::InputLayoutDesc layoutDesc{};
+			layoutDesc.attributes = {
+				rhi::VertexAttributeDesc{ .semantic = rhi::VertexSemantic::Position, .format = rhi::VertexFormat::R32G32B32_FLOAT, .offsetBytes = 0 },
+				rhi::VertexAttributeDesc{ .semantic = rhi::VertexSemantic::Color, .format = rhi::VertexFormat::R32G32B32A32_FLOAT, .offsetBytes = 12 } };
+			layoutDesc.strideBytes = sizeof(ColoredVertex);
+			layout = device.CreateInputLayout(layoutDesc);
+
+			const rhi::ShaderHandle vs = device.CreateShader(rhi::ShaderStage::Vertex, vsName, "");
+			const rhi::ShaderHandle ps = device.CreateShader(rhi::ShaderStage::Pixel, psName, "");
+			pipeline = device.CreatePipeline("Test", vs, ps);
+		}
+
+		rhi::BufferHandle Upload(std::span<const ColoredVertex> vertices)
+		{
+			const rhi::BufferHandle buffer = device.CreateBuffer(rhi::BufferDesc{ .sizeInBytes = vertices.size_bytes() });
+			device.UpdateBuffer(buffer, std::as_bytes(vertices));
+			return buffer;
+		}
+
+		void Begin(rhi::CommandList& list, std::array<float, 4> clearColor = kBlue)
+		{
+			rhi::BeginPassDesc pass{};
+			pass.frameBuffer = framebuffer;
+			pass.extent = extent;
+			pass.clearDesc.color = clearColor;
+			pass.clearDesc.clearDepth = true;
+			list.BeginPass(pass);
+			list.BindPipeline(pipeline);
+			list.BindInputLayout(layout);
+		}
+
+		std::uint32_t Pixel(std::uint32_t x, std::uint32_t y)
+		{
+			return device.ReadTextureRGBA8(color)[static_cast<std::size_t>(y) * extent.width + x];
+		}
+
+		rhi::SoftwareDevice& device;
+		rhi::Extent2D extent{};
+		rhi::TextureHandle color{};
+		rhi::TextureHandle depth{};
+		rhi::FrameBufferHandle framebuffer{};
+		rhi::InputLayoutHandle layout{};
+		rhi::PipelineHandle pipeline{};
+	};
+
+	constexpr std::uint32_t kRedRGBA8 = 0xFF0000FFu;
+	constexpr std::uint32_t kBlueRGBA8 = 0xFFFF0000u;
+}
+
+TEST(SoftwareRHI, RasterizesVertexColoredTriangleAndCullsBackFaces)
+{
+	rhi::SoftwareDevice device{};
+	SoftwareScene scene(device, { 16, 16 });
+
+	// Counter-clockwise in NDC: the lower-left half of the target.
+	const std::array<ColoredVertex, 6> vertices{ {
+		{ { -1.0f, -1.0f, 0.5f }, kRed }, { { 1.0f, -1.0f, 0.5f }, kRed }, { { -1.0f, 1.0f, 0.5f }, kRed },
+		{ { -1.0f, -1.0f, 0.5f }, kRed }, { { -1.0f, 1.0f, 0.5f }, kRed }, { { 1.0f, -1.0f, 0.5f }, kRed } } };
+	const rhi::BufferHandle vb = scene.Upload(vertices);
+
+	rhi::CommandList list{};
+	scene.Begin(list);
+	list.BindVertexBuffer(0, vb, sizeof(ColoredVertex), 0);
+	list.Draw(6);
+	list.EndPass();
+	device.SubmitCommandList(std::move(list));
+
+	EXPECT_EQ(scene.Pixel(1, 14), kRedRGBA8);
+	EXPECT_EQ(scene.Pixel(14, 1), kBlueRGBA8);
+
+	const rhi::SoftwareRasterStats& stats = device.GetRasterStats();
+	EXPECT_EQ(stats.trianglesSubmitted, 2u);
+	EXPECT_EQ(stats.trianglesCulled, 1u);  // the clockwise copy
+	EXPECT_EQ(stats.trianglesRasterized, 1u);
+	EXPECT_EQ(stats.pixelsShaded, 120u);  // the diagonal is a right edge here, so the top-left rule leaves it out
+}
+
+TEST(SoftwareRHI, SharedEdgeIsCoveredExactlyOnce)
+{
+	rhi::SoftwareDevice device(rhi::SoftwareDeviceDesc{ .tileSize = 8 });
+	SoftwareScene scene(device, { 16, 16 });
+
+	// Full-target quad; the diagonal passes through pixel centers, so a wrong fill rule double-blends it.
+	constexpr std::array<float, 4> quarter{ 0.25f, 0.25f, 0.25f, 1.0f };
+	const std::array<ColoredVertex, 6> vertices{ {
+		{ { -1.0f, -1.0f, 0.5f }, quarter }, { { 1.0f, -1.0f, 0.5f }, quarter }, { { 1.0f, 1.0f, 0.5f }, quarter },
+		{ { -1.0f, -1.0f, 0.5f }, quarter }, { { 1.0f, 1.0f, 0.5f }, quarter }, { { -1.0f, 1.0f, 0.5f }, quarter } } };
+	const rhi::BufferHandle vb = scene.Upload(vertices);
+
+	rhi::GraphicsState additive{};
+	additive.depth.testEnable = false;
+	additive.blend.enable = true;
+	additive.blend.mode = rhi::BlendMode::Additive;
+
+	rhi::CommandList list{};
+	scene.Begin(list, { 0.0f, 0.0f, 0.0f, 0.0f });
+	list.SetState(additive);
+	list.BindVertexBuffer(0, vb, sizeof(ColoredVertex), 0);
+	list.Draw(6);
+	list.EndPass();
+	device.SubmitCommandList(std::move(list));
+
+	const std::vector<std::uint32_t> pixels = device.ReadTextureRGBA8(scene.color);
+	for (std::size_t i = 0; i < pixels.size(); ++i)
+	{
+		ASSERT_EQ(pixels[i] & 0xFFu, 64u);
+	}
+	EXPECT_EQ(device.GetRasterStats().pixelsShaded, 256u);
+}
+
+TEST(SoftwareRHI, DepthTestAndMultipleRenderTargetsWithCpuShaders)
+{
+	rhi::SoftwareDevice device{};
+	device.RegisterVertexShader("VS_Depth", [](const rhi::SoftwareVertexInput& input, const rhi::SoftwareShaderContext& context)
+		{
+			// Per-draw depth comes from the constants block, like the DX12 per-draw constant buffer.
+			const auto constants = context.ConstantsAs<std::array<float, 4>>(0);
+			const rhi::SoftwareFloat4 position = input.Attribute(rhi::VertexSemantic::Position);
+			rhi::SoftwareVertexOutput out{};
+			out.position = { position[0], position[1], constants[0], 1.0f };
+			return out;
+		});
+	device.RegisterPixelShader("PS_GBuffer", [](const rhi::SoftwarePixelInput& input, const rhi::SoftwareShaderContext& context)
+		{
+			rhi::SoftwarePixelOutput out{};
+			out.colors[0] = context.UniformFloat4("uColor");
+			out.colors[1] = { input.depth, input.frontFacing ? 1.0f : 0.0f, 0.0f, 1.0f };
+			return out;
+		});
+
+	SoftwareScene scene(device, { 8, 8 }, "VS_Depth", "PS_GBuffer");
+	const rhi::TextureHandle albedo = device.CreateTexture2D({ 8, 8 }, rhi::Format::RGBA8_UNORM);
+	const rhi::TextureHandle data = device.CreateTexture2D({ 8, 8 }, rhi::Format::RGBA16_FLOAT);
+	const std::array<rhi::TextureHandle, 2> targets{ albedo, data };
+	scene.framebuffer = device.CreateFramebufferMRT(targets, scene.depth);
+
+	const std::array<ColoredVertex, 6> quad{ {
+		{ { -1.0f, -1.0f, 0.0f } }, { { 1.0f, -1.0f, 0.0f } }, { { 1.0f, 1.0f, 0.0f } },
+		{ { -1.0f, -1.0f, 0.0f } }, { { 1.0f, 1.0f, 0.0f } }, { { -1.0f, 1.0f, 0.0f } } } };
+	const rhi::BufferHandle vb = scene.Upload(quad);
+
+	const std::array<float, 4> nearDepth{ 0.25f };
+	const std::array<float, 4> farDepth{ 0.75f };
+	rhi::CommandList list{};
+	scene.Begin(list);
+	list.BindVertexBuffer(0, vb, sizeof(ColoredVertex), 0);
+	list.SetConstants(0, std::as_bytes(std::span{ nearDepth }));
+	list.SetUniformFloat4("uColor", kRed);
+	list.Draw(6);
+	// Drawn later but further away: must lose the depth test everywhere.
+	list.SetConstants(0, std::as_bytes(std::span{ farDepth }));
+	list.SetUniformFloat4("uColor", { 0.0f, 1.0f, 0.0f, 1.0f });
+	list.Draw(6);
+	list.EndPass();
+	device.SubmitCommandList(std::move(list));
+
+	for (const std::uint32_t pixel : device.ReadTextureRGBA8(albedo))
+	{
+		ASSERT_EQ(pixel, kRedRGBA8);
+	}
+	const std::vector<rhi::SoftwareFloat4> written = device.ReadTexture(data);
+	EXPECT_FLOAT_EQ(written[27][0], 0.25f);
+	EXPECT_FLOAT_EQ(written[27][1], 1.0f);
+	EXPECT_FLOAT_EQ(device.ReadDepth(scene.depth)[27], 0.25f);
+	EXPECT_EQ(device.GetRasterStats().pixelsDepthRejected, 64u);
+}
+
+TEST(SoftwareRHI, ClipsTrianglesCrossingTheNearPlane)
+{
+	rhi::SoftwareDevice device{};
+	SoftwareScene scene(device, { 16, 16 });
+
+	// The bottom-left vertex lies behind the near plane (z < 0), so that corner is clipped away.
+	const std::array<ColoredVertex, 3> vertices{ {
+		{ { -1.0f, -1.0f, -1.0f }, kRed }, { { 1.0f, -1.0f, 1.0f }, kRed }, { { -1.0f, 1.0f, 1.0f }, kRed } } };
+	const rhi::BufferHandle vb = scene.Upload(vertices);
+
+	rhi::GraphicsState noDepth{};
+	noDepth.depth.testEnable = false;
+
+	rhi::CommandList list{};
+	scene.Begin(list);
+	list.SetState(noDepth);
+	list.BindVertexBuffer(0, vb, sizeof(ColoredVertex), 0);
+	list.Draw(3);
+	list.EndPass();
+	device.SubmitCommandList(std::move(list));
+
+	EXPECT_EQ(device.GetRasterStats().trianglesRasterized, 2u);  // the clipped quad, fanned
+	EXPECT_EQ(scene.Pixel(0, 15), kBlueRGBA8);
+	EXPECT_EQ(scene.Pixel(14, 15), kRedRGBA8);
+	EXPECT_EQ(scene.Pixel(0, 1), kRedRGBA8);
+}
+
+TEST(SoftwareRHI, ParallelTilesMatchSingleThreadedImage)
+{
+	// Overlapping, depth-tested triangles from indexed and indirect draws, rendered twice.
+	std::vector<ColoredVertex> vertices;
+	std::vector<std::uint16_t> indices;
+	std::uint32_t seed = 12345u;
+	const auto Random = [&seed]()
+		{
+			seed = seed * 1664525u + 1013904223u;
+			return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+		};
+	for (std::uint16_t triangle = 0; triangle < 200; ++triangle)
+	{
+		const float z = Random();
+		const std::array<float, 4> color{ Random(), Random(), Random(), 1.0f };
+		const float cx = Random() * 2.0f - 1.0f;
+		const float cy = Random() * 2.0f - 1.0f;
+		for (int corner = 0; corner < 3; ++corner)
+		{
+			vertices.push_back(ColoredVertex{ { cx + Random() - 0.5f, cy + Random() - 0.5f, z }, color });
+			indices.push_back(static_cast<std::uint16_t>(vertices.size() - 1));
+		}
+	}
+	const rhi::DrawIndexedIndirectArgs args{ .indexCount = 300, .firstIndex = 300 };
+
+	const auto Render = [&](rhi::SoftwareDeviceDesc desc)
+		{
+			rhi::SoftwareDevice device(desc);
+			SoftwareScene scene(device, { 96, 80 });
+			const rhi::BufferHandle vb = scene.Upload(vertices);
+			const rhi::BufferHandle ib = device.CreateBuffer(rhi::BufferDesc{ .bindFlag = rhi::BufferBindFlag::IndexBuffer, .sizeInBytes = indices.size() * sizeof(std::uint16_t) });
+			device.UpdateBuffer(ib, std::as_bytes(std::span{ indices }));
+			const rhi::BufferHandle argsBuffer = device.CreateBuffer(rhi::BufferDesc{ .bindFlag = rhi::BufferBindFlag::IndirectArgs, .sizeInBytes = sizeof(args) });
+			device.UpdateBuffer(argsBuffer, std::as_bytes(std::span{ &args, 1 }));
+
+			rhi::GraphicsState noCull{};
+			noCull.rasterizer.cullMode = rhi::CullMode::None;
+
+			rhi::CommandList list{};
+			scene.Begin(list);
+			list.SetState(noCull);
+			list.BindVertexBuffer(0, vb, sizeof(ColoredVertex), 0);
+			list.BindIndexBuffer(ib, rhi::IndexType::UINT16, 0);
+			list.DrawIndexed(300, rhi::IndexType::UINT16, 0, 0);
+			list.DrawIndexedIndirect(rhi::IndexType::UINT16, argsBuffer);
+			list.EndPass();
+			device.SubmitCommandList(std::move(list));
+
+			EXPECT_EQ(device.GetRasterStats().trianglesSubmitted, 200u);
+			return device.ReadTextureRGBA8(scene.color);
+		};
+
+	const std::vector<std::uint32_t> serial = Render(rhi::SoftwareDeviceDesc{ .tileSize = 16 });
+	rendern::JobSystemThreadPool jobs(4);
+	const std::vector<std::uint32_t> parallel = Render(rhi::SoftwareDeviceDesc{ .jobs = &jobs, .maxJobs = 4, .tileSize = 16 });
+	EXPECT_EQ(serial, parallel);
+	EXPECT_NE(std::count(serial.begin(), serial.end(), kBlueRGBA8), static_cast<std::ptrdiff_t>(serial.size()));
+}
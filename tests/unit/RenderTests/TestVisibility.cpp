@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "RenderTestHelper.h"
+
+import core;
+
+using namespace RenderTestHelper;
+
+namespace
+{
+	mathUtils::Mat4 RandomModel(std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position(-150.0f, 150.0f);
+		std::uniform_real_distribution<float> scale(0.25f, 4.0f);
+		std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+		const mathUtils::Mat4 translate = mathUtils::Translate(mathUtils::Mat4(1.0f), mathUtils::Vec3{ position(rng), position(rng) * 0.2f, position(rng) });
+		const mathUtils::Mat4 rotate = mathUtils::Rotate(mathUtils::Mat4(1.0f), angle(rng), mathUtils::Normalize(mathUtils::Vec3{ 0.3f, 1.0f, 0.2f }));
+		return mathUtils::Scale(translate * rotate, mathUtils::Vec3{ scale(rng), scale(rng), scale(rng) });
+	}
+}
+
+TEST(Visibility, BatchCullingMatchesPerItemPathAcrossViews)
+{
+	const std::array<mathUtils::Frustum, 3> frustums{
+		CameraFrustum({ 0.0f, 2.0f, 0.0f }, { 0.0f, 2.0f, -1.0f }, 60.0f, 200.0f),
+		CameraFrustum({ 0.0f, 2.0f, 0.0f }, { 1.0f, 2.0f, 0.0f }, 90.0f, 60.0f),
+		CameraFrustum({ 50.0f, 40.0f, 50.0f }, { 0.0f, 0.0f, 0.0f }, 30.0f, 400.0f) };
+
+	std::mt19937 rng(1234u);
+	std::uniform_real_distribution<float> radius(0.1f, 5.0f);
+	const mathUtils::Vec3 localCenter{ 0.5f, -0.25f, 0.1f };
+
+	// 1003 spheres: exercises the SIMD body and the scalar tail.
+	constexpr std::size_t kCount = 1003;
+	rendern::CullSpheresSoA spheres;
+	std::vector<mathUtils::Mat4> models;
+	std::vector<float> radii;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		models.push_back(RandomModel(rng));
+		radii.push_back(i % 97 == 0 ? 0.0f : radius(rng)); // some items have no bounds
+		spheres.PushLocal(localCenter, radii.back(), models.back());
+	}
+	ASSERT_EQ(spheres.Size(), kCount);
+
+	std::vector<std::uint32_t> masks(kCount, 0xDEADBEEFu);
+	std::vector<std::uint32_t> scalarMasks(kCount, 0u);
+	rendern::CullSpheres(spheres, frustums, masks);
+	rendern::CullSpheresScalar(spheres, frustums, scalarMasks);
+
+	std::size_t visibleInCamera = 0;
+	for (std::size_t i = 0; i < kCount; ++i)
+	{
+		std::uint32_t expected = 0;
+		for (std::size_t view = 0; view < frustums.size(); ++view)
+		{
+			if (rendern::IsVisibleSphere(localCenter, radii[i], models[i], frustums[view], true))
+			{
+				expected |= 1u << view;
+			}
+		}
+		EXPECT_EQ(masks[i], expected);
+		EXPECT_EQ(scalarMasks[i], expected);
+		visibleInCamera += (masks[i] & 1u) != 0u ? 1u : 0u;
+	}
+	// The scene straddles the camera frustum, so both outcomes are exercised.
+	EXPECT_GT(visibleInCamera, 0u);
+	EXPECT_LT(visibleInCamera, kCount);
+}
+
+TEST(Visibility, UnboundedSpheresAreVisibleInEveryView)
+{
+	const std::array<mathUtils::Frustum, 2> frustums{
+		CameraFrustum({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, -1.0f }, 60.0f, 10.0f),
+		CameraFrustum({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, 60.0f, 10.0f) };
+
+	rendern::CullSpheresSoA spheres;
+	for (int i = 0; i < 9; ++i)
+	{
+		spheres.Push(mathUtils::Vec3{ 1000.0f, 1000.0f, 1000.0f }, 0.0f);
+	}
+	spheres.Push(mathUtils::Vec3{ 0.0f, 0.0f, -5.0f }, 1.0f);
+	spheres.Push(mathUtils::Vec3{ 1000.0f, 0.0f, 0.0f }, 1.0f);
+
+	std::vector<std::uint32_t> masks(spheres.Size());
+	rendern::CullSpheres(spheres, frustums, masks);
+	for (int i = 0; i < 9; ++i)
+	{
+		EXPECT_EQ(masks[static_cast<std::size_t>(i)], 0b11u);
+	}
+	EXPECT_EQ(masks[9], 0b01u);
+	EXPECT_EQ(masks[10], 0u);
+}
+
+TEST(Visibility, BatchCullingRejectsBadArguments)
+{
+	rendern::CullSpheresSoA spheres;
+	spheres.Push(mathUtils::Vec3{}, 1.0f);
+	spheres.Push(mathUtils::Vec3{}, 1.0f);
+
+	const std::vector<mathUtils::Frustum> tooMany(rendern::kMaxCullViews + 1);
+	std::vector<std::uint32_t> masks(2);
+	EXPECT_THROW(rendern::CullSpheres(spheres, tooMany, masks), std::runtime_error);
+
+	const std::array<mathUtils::Frustum, 1> one{};
+	std::vector<std::uint32_t> small(1);
+	EXPECT_THROW(rendern::CullSpheres(spheres, one, small), std::runtime_error);
+}